@@ -94,6 +94,88 @@ vx_node vxTilingGaussianNode(vx_graph graph, vx_image in, vx_image out)
                                     dimof(params));
 }
 
+/*! \brief Runs Gaussian, Box, Alpha and Add once through virtual images, so
+ * that the implementation may run them depth first, and once through real
+ * images, then compares the results away from the undefined borders.
+ */
+vx_status vxTilingChainCheck(vx_context context, vx_image input, vx_scalar alpha)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 i, x, y, w = 512, h = 512, border = 4;
+    vx_graph graph = vxCreateGraph(context);
+    vx_image outputs[] = {
+        vxCreateImage(context, w, h, FOURCC_S16), // 0:depth first
+        vxCreateImage(context, w, h, FOURCC_S16), // 1:frame by frame
+    };
+    vx_image images[] = {
+        vxCreateVirtualImageWithFormat(context, FOURCC_U8), // 0:gaussian
+        vxCreateVirtualImageWithFormat(context, FOURCC_U8), // 1:box
+        vxCreateVirtualImageWithFormat(context, FOURCC_U8), // 2:alpha
+        vxCreateImage(context, w, h, FOURCC_U8),          // 3:gaussian
+        vxCreateImage(context, w, h, FOURCC_U8),          // 4:box
+        vxCreateImage(context, w, h, FOURCC_U8),          // 5:alpha
+    };
+    vx_node nodes[] = {
+        vxTilingGaussianNode(graph, input, images[0]),
+        vxTilingBoxNode(graph, images[0], images[1], 3, 3),
+        vxTilingAlphaNode(graph, images[1], alpha, images[2]),
+        vxTilingAddNode(graph, input, images[2], outputs[0]),
+        vxTilingGaussianNode(graph, input, images[3]),
+        vxTilingBoxNode(graph, images[3], images[4], 3, 3),
+        vxTilingAlphaNode(graph, images[4], alpha, images[5]),
+        vxTilingAddNode(graph, input, images[5], outputs[1]),
+    };
+    for (i = 0; i < dimof(nodes); i++)
+    {
+        if (nodes[i] == 0)
+        {
+            printf("Failed to create chain node[%u]\n", i);
+            status = VX_ERROR_INVALID_NODE;
+        }
+    }
+    if (status == VX_SUCCESS)
+        status = vxProcessGraph(graph);
+    if (status == VX_SUCCESS)
+    {
+        vx_rectangle rect = vxCreateRectangle(context, 0, 0, w, h);
+        vx_imagepatch_addressing_t addr[2];
+        void *base[2] = {NULL, NULL};
+        status |= vxAccessImagePatch(outputs[0], rect, 0, &addr[0], &base[0]);
+        status |= vxAccessImagePatch(outputs[1], rect, 0, &addr[1], &base[1]);
+        for (y = border; (y < h - border) && (status == VX_SUCCESS); y++)
+        {
+            for (x = border; x < w - border; x++)
+            {
+                vx_int16 *a = vxFormatImagePatchAddress2d(base[0], x, y, &addr[0]);
+                vx_int16 *b = vxFormatImagePatchAddress2d(base[1], x, y, &addr[1]);
+                if (*a != *b)
+                {
+                    printf("Chain differs at {%u,%u}: %d != %d\n", x, y, *a, *b);
+                    status = VX_FAILURE;
+                    break;
+                }
+            }
+        }
+        vxCommitImagePatch(outputs[0], 0, 0, &addr[0], base[0]);
+        vxCommitImagePatch(outputs[1], 0, 0, &addr[1], base[1]);
+        vxReleaseRectangle(&rect);
+    }
+    for (i = 0; i < dimof(nodes); i++)
+    {
+        vxReleaseNode(&nodes[i]);
+    }
+    for (i = 0; i < dimof(images); i++)
+    {
+        vxReleaseImage(&images[i]);
+    }
+    for (i = 0; i < dimof(outputs); i++)
+    {
+        vxReleaseImage(&outputs[i]);
+    }
+    vxReleaseGraph(&graph);
+    return status;
+}
+
 int main(int argc, char *argv[])
 {
     vx_status status = VX_SUCCESS;
@@ -146,6 +228,10 @@ int main(int argc, char *argv[])
                     {
                         status = vxProcessGraph(graph);
                     }
+                    if (status == VX_SUCCESS)
+                    {
+                        status = vxTilingChainCheck(context, images[1], alpha);
+                    }
                 }
                 for (i = 0; i < dimof(nodes); i++)
                 {
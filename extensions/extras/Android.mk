@@ -29,7 +29,8 @@ LOCAL_CFLAGS := $(OPENVX_DEFS)
 LOCAL_SRC_FILES := vx_extras_module.c \
 	vx_filter.c \
 	vx_gradients.c \
-	vx_nonmax.c
+	vx_nonmax.c \
+	vx_rankfilters.c
 LOCAL_C_INCLUDES := $(OPENVX_INC)
 LOCAL_SHARED_LIBRARIES := libdl libutils libcutils libbinder libhardware libion libgui libui libopenvx
 LOCAL_MODULE := libopenvx-extras
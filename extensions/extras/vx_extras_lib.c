@@ -304,3 +304,114 @@ vx_status vxuImageLister(vx_image input,
     vxClearLog(context);
     return status;
 }
+
+vx_node vxMedianMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_parameter_item_t params[] = {
+        {VX_INPUT, input},
+        {VX_INPUT, columns},
+        {VX_INPUT, rows},
+        {VX_OUTPUT, output},
+    };
+    return vxCreateNodeByStructure(graph,
+                                   VX_KERNEL_EXTRAS_MEDIAN_MxN,
+                                   params,
+                                   dimof(params));
+}
+
+vx_status vxuMedianMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_context context = vxGetContext(input);
+    vx_status status = VX_FAILURE;
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_node node = vxMedianMxNNode(graph, input, columns, rows, output);
+        if (node)
+        {
+            status = vxVerifyGraph(graph);
+            if (status == VX_SUCCESS)
+            {
+                status = vxProcessGraph(graph);
+            }
+            vxReleaseNode(&node);
+        }
+        vxReleaseGraph(&graph);
+    }
+    vxClearLog(context);
+    return status;
+}
+
+vx_node vxErodeMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_parameter_item_t params[] = {
+        {VX_INPUT, input},
+        {VX_INPUT, columns},
+        {VX_INPUT, rows},
+        {VX_OUTPUT, output},
+    };
+    return vxCreateNodeByStructure(graph,
+                                   VX_KERNEL_EXTRAS_ERODE_MxN,
+                                   params,
+                                   dimof(params));
+}
+
+vx_status vxuErodeMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_context context = vxGetContext(input);
+    vx_status status = VX_FAILURE;
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_node node = vxErodeMxNNode(graph, input, columns, rows, output);
+        if (node)
+        {
+            status = vxVerifyGraph(graph);
+            if (status == VX_SUCCESS)
+            {
+                status = vxProcessGraph(graph);
+            }
+            vxReleaseNode(&node);
+        }
+        vxReleaseGraph(&graph);
+    }
+    vxClearLog(context);
+    return status;
+}
+
+vx_node vxDilateMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_parameter_item_t params[] = {
+        {VX_INPUT, input},
+        {VX_INPUT, columns},
+        {VX_INPUT, rows},
+        {VX_OUTPUT, output},
+    };
+    return vxCreateNodeByStructure(graph,
+                                   VX_KERNEL_EXTRAS_DILATE_MxN,
+                                   params,
+                                   dimof(params));
+}
+
+vx_status vxuDilateMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output)
+{
+    vx_context context = vxGetContext(input);
+    vx_status status = VX_FAILURE;
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_node node = vxDilateMxNNode(graph, input, columns, rows, output);
+        if (node)
+        {
+            status = vxVerifyGraph(graph);
+            if (status == VX_SUCCESS)
+            {
+                status = vxProcessGraph(graph);
+            }
+            vxReleaseNode(&node);
+        }
+        vxReleaseGraph(&graph);
+    }
+    vxClearLog(context);
+    return status;
+}
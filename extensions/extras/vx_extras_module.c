@@ -44,6 +44,9 @@ static vx_kernel_description_t *kernels[] = {
     &euclidian_nonmax_kernel,
     &sobelMxN_kernel,
     &lister_kernel,
+    &medianMxN_kernel,
+    &erodeMxN_kernel,
+    &dilateMxN_kernel,
 };
 
 /*! \brief Declares the number of base supported kernels.
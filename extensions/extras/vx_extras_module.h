@@ -41,6 +41,9 @@ extern vx_kernel_description_t harris_score_kernel;
 extern vx_kernel_description_t sobelMxN_kernel;
 extern vx_kernel_description_t euclidian_nonmax_kernel;
 extern vx_kernel_description_t lister_kernel;
+extern vx_kernel_description_t medianMxN_kernel;
+extern vx_kernel_description_t erodeMxN_kernel;
+extern vx_kernel_description_t dilateMxN_kernel;
 
 
 #ifdef	__cplusplus
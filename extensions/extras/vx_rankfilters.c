@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The MxN Median, Erode and Dilate Kernels (Extras)
+ * \details The median keeps a histogram per image column plus one for the
+ * window (Perreault & Hebert, "Median Filtering in Constant Time"), so each
+ * output pixel costs a fixed number of histogram updates whatever the window
+ * size. Erode and dilate are separable running min/max filters computed with
+ * the van Herk/Gil-Werman block scheme, about 3 comparisons per pixel in each
+ * direction.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <VX/vx.h>
+#include <VX/vx_ext_extras.h>
+#include <VX/vx_helper.h>
+
+/*! \brief The smallest window side accepted by the MxN rank filters. */
+#define VX_RANK_MIN_WINDOW  (3)
+
+/*! \brief The largest window side accepted by the MxN rank filters. */
+#define VX_RANK_MAX_WINDOW  (15)
+
+/*! \brief The number of bins in each level of the two-level histogram. */
+#define VX_RANK_BINS        (16)
+
+/*! \brief The window histogram of the median filter.
+ * \details The fine histograms of each coarse bin are only brought up to
+ * date when the median falls in that bin; <tt>fresh</tt> records the column at
+ * which each one was last current.
+ */
+typedef struct _vx_rank_histogram_t {
+    vx_uint16 coarse[VX_RANK_BINS];
+    vx_uint16 fine[VX_RANK_BINS][VX_RANK_BINS];
+    vx_int32 fresh[VX_RANK_BINS];
+} vx_rank_histogram_t;
+
+static void vxRankAdd(vx_uint16 *dst, const vx_uint16 *src)
+{
+    vx_uint32 b;
+    for (b = 0; b < VX_RANK_BINS; b++)
+        dst[b] += src[b];
+}
+
+static void vxRankSub(vx_uint16 *dst, const vx_uint16 *src)
+{
+    vx_uint32 b;
+    for (b = 0; b < VX_RANK_BINS; b++)
+        dst[b] -= src[b];
+}
+
+/*! \brief Moves the column histograms down the image by one row.
+ * \param [in] coarse The coarse column histograms, VX_RANK_BINS per column.
+ * \param [in] fine The fine column histograms, laid out as [coarse bin][column][VX_RANK_BINS].
+ * \param [in] out The row leaving the window (or NULL).
+ * \param [in] in The row entering the window.
+ */
+static void vxRankSlideColumns(vx_uint16 *coarse, vx_uint16 *fine, vx_uint32 width,
+                               const vx_uint8 *out, const vx_uint8 *in)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        if (out)
+        {
+            coarse[x * VX_RANK_BINS + (out[x] >> 4)]--;
+            fine[((out[x] >> 4) * width + x) * VX_RANK_BINS + (out[x] & 0xF)]--;
+        }
+        coarse[x * VX_RANK_BINS + (in[x] >> 4)]++;
+        fine[((in[x] >> 4) * width + x) * VX_RANK_BINS + (in[x] & 0xF)]++;
+    }
+}
+
+/*! \brief Computes one row of the median from the column histograms.
+ * \param [in] cx The half width of the window.
+ * \param [in] rank The 0-based rank of the median within the window.
+ */
+static void vxMedianRow(const vx_uint16 *coarse, const vx_uint16 *fine, vx_uint32 width,
+                        vx_int32 cx, vx_uint32 rank, vx_rank_histogram_t *h, vx_uint8 *dst)
+{
+    vx_int32 x, j, cols = 2 * cx + 1;
+    vx_uint32 b;
+
+    memset(h, 0, sizeof(*h));
+    for (b = 0; b < VX_RANK_BINS; b++)
+        h->fresh[b] = -cols - 1;
+    for (j = 0; j < cols; j++)
+        vxRankAdd(h->coarse, &coarse[j * VX_RANK_BINS]);
+
+    for (x = cx; x < (vx_int32)width - cx; x++)
+    {
+        vx_uint32 sum = 0, k = 0, v = 0;
+        vx_uint16 *hf;
+
+        if (x > cx)
+        {
+            vxRankAdd(h->coarse, &coarse[(x + cx) * VX_RANK_BINS]);
+            vxRankSub(h->coarse, &coarse[(x - cx - 1) * VX_RANK_BINS]);
+        }
+        while (sum + h->coarse[k] <= rank)
+            sum += h->coarse[k++];
+
+        /* bring the fine histogram of bin k up to column x */
+        hf = h->fine[k];
+        if (x - h->fresh[k] >= cols)
+        {
+            memset(hf, 0, sizeof(h->fine[k]));
+            for (j = x - cx; j <= x + cx; j++)
+                vxRankAdd(hf, &fine[(k * width + j) * VX_RANK_BINS]);
+        }
+        else
+        {
+            for (j = h->fresh[k] + 1; j <= x; j++)
+            {
+                vxRankAdd(hf, &fine[(k * width + j + cx) * VX_RANK_BINS]);
+                vxRankSub(hf, &fine[(k * width + j - cx - 1) * VX_RANK_BINS]);
+            }
+        }
+        h->fresh[k] = x;
+
+        while (sum + hf[v] <= rank)
+            sum += hf[v++];
+        dst[x] = (vx_uint8)((k << 4) | v);
+    }
+}
+
+/*! \brief Reads the window dimensions from the node parameters. */
+static void vxRankWindow(vx_scalar columns, vx_scalar rows, vx_int32 *cx, vx_int32 *cy)
+{
+    vx_uint32 c = 0, r = 0;
+    vxAccessScalarValue(columns, &c);
+    vxAccessScalarValue(rows, &r);
+    *cx = (vx_int32)c / 2;
+    *cy = (vx_int32)r / 2;
+}
+
+static vx_status vxMedianMxNKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 4)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[3];
+        vx_int32 cx = 0, cy = 0, y;
+        vx_uint8 *src_base = NULL, *dst_base = NULL;
+        vx_imagepatch_addressing_t src_addr, dst_addr;
+        vx_rectangle rect;
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+
+        vxRankWindow((vx_scalar)parameters[1], (vx_scalar)parameters[2], &cx, &cy);
+        rect = vxGetValidRegionImage(src);
+        status = vxAccessImagePatch(src, rect, 0, &src_addr, (void **)&src_base);
+        status |= vxAccessImagePatch(dst, rect, 0, &dst_addr, (void **)&dst_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        /*! \todo Implement other border modes */
+        if (status == VX_SUCCESS && borders.mode == VX_BORDER_MODE_UNDEFINED)
+        {
+            vx_uint32 width = src_addr.dim_x;
+            vx_uint32 rank = ((2 * cx + 1) * (2 * cy + 1)) / 2;
+            vx_uint16 *coarse = calloc(width, VX_RANK_BINS * sizeof(vx_uint16));
+            vx_uint16 *fine = calloc(width * VX_RANK_BINS, VX_RANK_BINS * sizeof(vx_uint16));
+            vx_rank_histogram_t *h = calloc(1, sizeof(vx_rank_histogram_t));
+
+            if (coarse && fine && h)
+            {
+                vxAlterRectangle(rect, cx, cy, -cx, -cy);
+                for (y = 0; y < 2 * cy; y++)
+                {
+                    vx_uint8 *in = vxFormatImagePatchAddress2d(src_base, 0, y, &src_addr);
+                    vxRankSlideColumns(coarse, fine, width, NULL, in);
+                }
+                for (y = cy; y < (vx_int32)src_addr.dim_y - cy; y++)
+                {
+                    vx_uint8 *out = NULL;
+                    vx_uint8 *in = vxFormatImagePatchAddress2d(src_base, 0, y + cy, &src_addr);
+                    if (y > cy)
+                        out = vxFormatImagePatchAddress2d(src_base, 0, y - cy - 1, &src_addr);
+                    vxRankSlideColumns(coarse, fine, width, out, in);
+                    vxMedianRow(coarse, fine, width, cx, rank, h,
+                                vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr));
+                }
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+            free(coarse);
+            free(fine);
+            free(h);
+        }
+        else if (status == VX_SUCCESS)
+        {
+            status = VX_ERROR_NOT_IMPLEMENTED;
+        }
+        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+/*! \brief Generates a van Herk/Gil-Werman min or max filter.
+ * \details The line is cut into blocks as long as the window. Within each
+ * block a forward running extremum (g) and a backward one (h) are kept, and
+ * any window of that length spans at most two blocks, so its extremum is
+ * OP(h[first], g[last]).
+ */
+#define VX_VAN_HERK(name, OP) \
+static void vxVanHerk##name##Line(const vx_uint8 *src, vx_uint8 *dst, vx_uint32 n, vx_uint32 k, \
+                                  vx_uint8 *g, vx_uint8 *h) \
+{ \
+    vx_uint32 i, b; \
+    for (b = 0; b < n; b += k) \
+    { \
+        vx_uint32 e = (b + k < n ? b + k : n) - 1; \
+        g[b] = src[b]; \
+        for (i = b + 1; i <= e; i++) \
+            g[i] = OP(g[i - 1], src[i]); \
+        h[e] = src[e]; \
+        for (i = e; i > b; i--) \
+            h[i - 1] = OP(h[i], src[i - 1]); \
+    } \
+    for (i = 0; i + k <= n; i++) \
+        dst[i] = OP(h[i], g[i + k - 1]); \
+} \
+\
+static void vxVanHerk##name##Rows(vx_uint8 **rows, vx_uint8 **g, vx_uint8 *dst, vx_uint32 x0, \
+                                  vx_uint32 x1, vx_uint32 y, vx_uint32 k) \
+{ \
+    vx_uint32 x; \
+    for (x = x0; x < x1; x++) \
+        dst[x] = OP(rows[y][x], g[y + k - 1][x]); \
+} \
+\
+static void vxVanHerk##name##Block(vx_uint8 **rows, vx_uint8 **g, vx_uint32 b, vx_uint32 e, \
+                                   vx_uint32 x0, vx_uint32 x1) \
+{ \
+    vx_uint32 x, i; \
+    for (x = x0; x < x1; x++) \
+        g[b][x] = rows[b][x]; \
+    for (i = b + 1; i <= e; i++) \
+        for (x = x0; x < x1; x++) \
+            g[i][x] = OP(g[i - 1][x], rows[i][x]); \
+    for (i = e; i > b; i--) \
+        for (x = x0; x < x1; x++) \
+            rows[i - 1][x] = OP(rows[i][x], rows[i - 1][x]); \
+}
+
+#define VX_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define VX_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+VX_VAN_HERK(Min, VX_MIN)
+VX_VAN_HERK(Max, VX_MAX)
+
+static vx_status vxMorphologyMxN(vx_node node, vx_reference *parameters, vx_uint32 num, vx_bool dilate)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 4)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[3];
+        vx_int32 cx = 0, cy = 0;
+        vx_uint8 *src_base = NULL, *dst_base = NULL;
+        vx_imagepatch_addressing_t src_addr, dst_addr;
+        vx_rectangle rect;
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+
+        vxRankWindow((vx_scalar)parameters[1], (vx_scalar)parameters[2], &cx, &cy);
+        rect = vxGetValidRegionImage(src);
+        status = vxAccessImagePatch(src, rect, 0, &src_addr, (void **)&src_base);
+        status |= vxAccessImagePatch(dst, rect, 0, &dst_addr, (void **)&dst_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        /*! \todo Implement other border modes */
+        if (status == VX_SUCCESS && borders.mode == VX_BORDER_MODE_UNDEFINED)
+        {
+            vx_uint32 width = src_addr.dim_x, height = src_addr.dim_y;
+            vx_uint32 kx = 2 * cx + 1, ky = 2 * cy + 1;
+            vx_uint32 x0 = cx, x1 = width - cx, y;
+            vx_uint8 *plane = malloc(2 * width * height + 2 * width);
+            vx_uint8 **rows = malloc(2 * height * sizeof(vx_uint8 *));
+
+            if (plane && rows)
+            {
+                vx_uint8 **g = &rows[height];
+                vx_uint8 *lg = &plane[2 * width * height];
+                vx_uint8 *lh = &lg[width];
+
+                vxAlterRectangle(rect, cx, cy, -cx, -cy);
+                for (y = 0; y < height; y++)
+                {
+                    vx_uint8 *in = vxFormatImagePatchAddress2d(src_base, 0, y, &src_addr);
+                    rows[y] = &plane[y * width];
+                    g[y] = &plane[(height + y) * width];
+                    /* the line filter writes at the window's left edge, so shift it to the centre */
+                    if (dilate)
+                        vxVanHerkMaxLine(in, &rows[y][cx], width, kx, lg, lh);
+                    else
+                        vxVanHerkMinLine(in, &rows[y][cx], width, kx, lg, lh);
+                }
+                /* the vertical pass runs on whole rows: rows[] becomes the backward extremum */
+                for (y = 0; y < height; y += ky)
+                {
+                    vx_uint32 e = (y + ky < height ? y + ky : height) - 1;
+                    if (dilate)
+                        vxVanHerkMaxBlock(rows, g, y, e, x0, x1);
+                    else
+                        vxVanHerkMinBlock(rows, g, y, e, x0, x1);
+                }
+                for (y = 0; y + ky <= height; y++)
+                {
+                    vx_uint8 *out = vxFormatImagePatchAddress2d(dst_base, 0, y + cy, &dst_addr);
+                    if (dilate)
+                        vxVanHerkMaxRows(rows, g, out, x0, x1, y, ky);
+                    else
+                        vxVanHerkMinRows(rows, g, out, x0, x1, y, ky);
+                }
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+            free(rows);
+            free(plane);
+        }
+        else if (status == VX_SUCCESS)
+        {
+            status = VX_ERROR_NOT_IMPLEMENTED;
+        }
+        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+static vx_status vxErodeMxNKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxMorphologyMxN(node, parameters, num, vx_false_e);
+}
+
+static vx_status vxDilateMxNKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxMorphologyMxN(node, parameters, num, vx_true_e);
+}
+
+static vx_status vxRankFilterInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_uint32 width = 0, height = 0;
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (width >= VX_RANK_MAX_WINDOW && height >= VX_RANK_MAX_WINDOW && format == FOURCC_U8)
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 1 || index == 2)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar win = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &win, sizeof(win));
+            if (win)
+            {
+                vx_enum type = 0;
+                vxQueryScalar(win, VX_SCALAR_ATTRIBUTE_TYPE, &type, sizeof(type));
+                if (type == VX_TYPE_UINT32)
+                {
+                    vx_uint32 ws = 0;
+                    vxAccessScalarValue(win, &ws);
+                    if ((ws & 1) && ws >= VX_RANK_MIN_WINDOW && ws <= VX_RANK_MAX_WINDOW)
+                    {
+                        status = VX_SUCCESS;
+                    }
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_status vxRankFilterOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 3)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, 0); /* we reference the input image */
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_uint32 width = 0, height = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            ptr->type = VX_TYPE_IMAGE;
+            ptr->dim.image.format = FOURCC_U8;
+            ptr->dim.image.width = width;
+            ptr->dim.image.height = height;
+            status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+static vx_param_description_t rank_filter_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t medianMxN_kernel = {
+    VX_KERNEL_EXTRAS_MEDIAN_MxN,
+    "org.khronos.extras.medianMxN",
+    vxMedianMxNKernel,
+    rank_filter_kernel_params, dimof(rank_filter_kernel_params),
+    vxRankFilterInputValidator,
+    vxRankFilterOutputValidator,
+    NULL,
+    NULL,
+};
+
+vx_kernel_description_t erodeMxN_kernel = {
+    VX_KERNEL_EXTRAS_ERODE_MxN,
+    "org.khronos.extras.erodeMxN",
+    vxErodeMxNKernel,
+    rank_filter_kernel_params, dimof(rank_filter_kernel_params),
+    vxRankFilterInputValidator,
+    vxRankFilterOutputValidator,
+    NULL,
+    NULL,
+};
+
+vx_kernel_description_t dilateMxN_kernel = {
+    VX_KERNEL_EXTRAS_DILATE_MxN,
+    "org.khronos.extras.dilateMxN",
+    vxDilateMxNKernel,
+    rank_filter_kernel_params, dimof(rank_filter_kernel_params),
+    vxRankFilterInputValidator,
+    vxRankFilterOutputValidator,
+    NULL,
+    NULL,
+};
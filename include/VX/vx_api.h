@@ -265,6 +265,22 @@ vx_context vxGetContext(vx_reference reference);
  */
 vx_status vxQueryContext(vx_context context, vx_enum attr, void *ptr, vx_size size);
 
+/*! \brief Sets an attribute on the context.
+ * \param [in] context The reference to the context.
+ * \param [in] attr The attribute to set. Use a <tt>\ref vx_context_attribute_e</tt>.
+ * \param [in] ptr The pointer to the value of the attribute.
+ * \param [in] size The size of the object pointed to by ptr.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS No errors
+ * \retval VX_ERROR_INVALID_REFERENCE if the context is not a <tt>\ref vx_context</tt>.
+ * \retval VX_ERROR_INVALID_PARAMETERS if any of the other parameters are incorrect.
+ * \retval VX_ERROR_NOT_SUPPORTED if the attribute is read-only or not supported on this implementation,
+ * or can not be changed while a graph is scheduled or executing.
+ * \ingroup group_context
+ * \pre <tt>\ref vxCreateContext</tt>
+ */
+vx_status vxSetContextAttribute(vx_context context, vx_enum attr, void *ptr, vx_size size);
+
 /*! \brief Creates an opaque reference to an image buffer.
  * \details Not guaranteed to exist until the <tt>\ref vx_graph</tt> containing it has been verified
  * \param [in] context The reference to the implementation context.
@@ -648,6 +664,44 @@ vx_status vxWaitGraph(vx_graph graph);
  */
 vx_status vxQueryGraph(vx_graph graph, vx_enum attribute, void *ptr, vx_size size);
 
+/*! \brief Allows the user to set attributes on the graph.
+ * \param [in] graph The reference to the graph.
+ * \param [in] attribute The <tt>\ref vx_graph_attribute_e</tt> type needed.
+ * \param [in] ptr The location from which to read the value.
+ * \param [in] size The size of the object pointed to by \a ptr.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS The attribute was set.
+ * \retval VX_ERROR_INVALID_REFERENCE The graph is not a valid reference.
+ * \retval VX_ERROR_INVALID_PARAMETERS The value is out of range.
+ * \retval VX_ERROR_GRAPH_SCHEDULED The graph has outstanding executions.
+ * \retval VX_ERROR_NOT_SUPPORTED The attribute can not be set.
+ * \pre <tt>\ref vxCreateGraph</tt>
+ * \ingroup group_graph
+ */
+vx_status vxSetGraphAttribute(vx_graph graph, vx_enum attribute, void *ptr, vx_size size);
+
+/*! \brief Takes a snapshot of the latency distributions of a graph and its nodes.
+ * \param [in] graph The reference to the graph.
+ * \param [out] stats The end-to-end statistics of the graph. May be NULL.
+ * \param [out] nodes The statistics of each node, in the order the nodes were created. May be NULL.
+ * \param [in] numNodes The number of entries in \a nodes. Entries beyond the number
+ * of nodes in the graph are zeroed.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS The snapshot was taken.
+ * \retval VX_ERROR_INVALID_REFERENCE The graph is not a valid reference.
+ * \ingroup group_graph
+ */
+vx_status vxGetGraphPerformanceStats(vx_graph graph, vx_perf_stats_t *stats, vx_perf_stats_t nodes[], vx_uint32 numNodes);
+
+/*! \brief Clears the performance measurements of a graph and of all its nodes.
+ * \param [in] graph The reference to the graph.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS The measurements were cleared.
+ * \retval VX_ERROR_INVALID_REFERENCE The graph is not a valid reference.
+ * \ingroup group_graph
+ */
+vx_status vxResetGraphPerformance(vx_graph graph);
+
 /*! \brief Creates a reference to a node object.
  * \param [in] graph The reference to the graph in which this node will exist.
  * \param [in] kernel The kernel reference which will be associated with this new node.
@@ -1967,6 +2021,45 @@ vx_status vxGetRemapPoint(vx_remap table,
                           vx_uint32 dst_x, vx_uint32 dst_y,
                           vx_float32 *src_x, vx_float32 *src_y);
 
+/*! \brief Accesses a rectangular patch of the remap table in bulk.
+ * \details Each element is a pair of <tt>\ref vx_float32</tt> holding the source x
+ * then the source y coordinate of one destination pixel, so <tt>stride_x</tt> is 8.
+ * \param [in] table The remap table reference.
+ * \param [in] rect The destination coordinates of the patch. Must be 0 <= start < end <= dimension.
+ * \param [out] addr The addressing information for the patch will be written into the data structure.
+ * \param [in,out] ptr The pointer to a pointer of a location to store the data.
+ * If the user passes in NULL, the function will map the table and return it.
+ * If the user passes in an non-NULL pointer, the function will copy the
+ * patch into the location provided by the user with packed rows.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_ERROR_INVALID_PARAMETERS The rectangle, addr or ptr was incorrect.
+ * \retval VX_ERROR_INVALID_REFERENCE The table reference was not actually a remap reference.
+ * \ingroup group_remap
+ */
+vx_status vxAccessRemapPatch(vx_remap table,
+                             vx_rectangle rect,
+                             vx_imagepatch_addressing_t *addr,
+                             void **ptr);
+
+/*! \brief Commits a rectangular patch of the remap table in bulk.
+ * \param [in] table The remap table reference.
+ * \param [in] rect The destination coordinates to set the patch to.
+ * This may be 0 or a rectangle of zero area in order to indicate that the commit
+ * should only decrement the reference count.
+ * \param [in] addr The addressing information returned by <tt>\ref vxAccessRemapPatch</tt>.
+ * \param [in] ptr The pointer of a location to read the data from. If the
+ * pointer was set by <tt>\ref vxAccessRemapPatch</tt>, the user may not access
+ * the pointer after this call is complete.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_ERROR_INVALID_PARAMETERS The rectangle, addr or ptr was incorrect.
+ * \retval VX_ERROR_INVALID_REFERENCE The table reference was not actually a remap reference.
+ * \ingroup group_remap
+ */
+vx_status vxCommitRemapPatch(vx_remap table,
+                             vx_rectangle rect,
+                             vx_imagepatch_addressing_t *addr,
+                             void *ptr);
+
 /*! \brief Queries attributes from a Remap table.
  * \param [in] r The remap to query.
  * \param [in] attribute The attribute to query. Use a <tt>\ref vx_remap_attribute_e</tt> enumeration.
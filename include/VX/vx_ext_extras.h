@@ -64,6 +64,12 @@
 
     \f]
  *
+ * \defgroup group_kernel_rankmxn Kernel: MxN Median, Erode and Dilate
+ * \brief Rank filters over a rectangular window of odd size from 3x3 to 15x15.
+ * \details The cost per pixel does not grow with the window. Only
+ * \ref VX_BORDER_MODE_UNDEFINED is supported, so the valid region of the output
+ * shrinks by half the window on each side. The input must be at least 15x15.
+ *
  */
 
 /*! \brief The Khronos Extras Library
@@ -133,6 +139,36 @@ enum vx_kernel_extras_ext_e {
      * \param [out] vx_image The FOURCC_S32 image.
      */
     VX_KERNEL_EXTRAS_EUCLIDEAN_NONMAXSUPPRESSION = VX_KERNEL_BASE(VX_ID_KHRONOS, VX_LIBRARY_KHR_EXTRAS) + 0x6,
+
+    /*! \brief The MxN Median Filter Kernel.
+     * \note Use "org.khronos.extras.medianMxN" to \ref vxGetKernelByName.
+     * \param [in] vx_image The FOURCC_U8 input image.
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window width (odd, 3 to 15).
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window height (odd, 3 to 15).
+     * \param [out] vx_image The FOURCC_U8 output image.
+     * \see group_kernel_rankmxn
+     */
+    VX_KERNEL_EXTRAS_MEDIAN_MxN = VX_KERNEL_BASE(VX_ID_KHRONOS, VX_LIBRARY_KHR_EXTRAS) + 0x7,
+
+    /*! \brief The MxN Erode Kernel.
+     * \note Use "org.khronos.extras.erodeMxN" to \ref vxGetKernelByName.
+     * \param [in] vx_image The FOURCC_U8 input image.
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window width (odd, 3 to 15).
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window height (odd, 3 to 15).
+     * \param [out] vx_image The FOURCC_U8 output image.
+     * \see group_kernel_rankmxn
+     */
+    VX_KERNEL_EXTRAS_ERODE_MxN = VX_KERNEL_BASE(VX_ID_KHRONOS, VX_LIBRARY_KHR_EXTRAS) + 0x8,
+
+    /*! \brief The MxN Dilate Kernel.
+     * \note Use "org.khronos.extras.dilateMxN" to \ref vxGetKernelByName.
+     * \param [in] vx_image The FOURCC_U8 input image.
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window width (odd, 3 to 15).
+     * \param [in] vx_scalar The VX_TYPE_UINT32 window height (odd, 3 to 15).
+     * \param [out] vx_image The FOURCC_U8 output image.
+     * \see group_kernel_rankmxn
+     */
+    VX_KERNEL_EXTRAS_DILATE_MxN = VX_KERNEL_BASE(VX_ID_KHRONOS, VX_LIBRARY_KHR_EXTRAS) + 0x9,
 };
 
 #ifdef	__cplusplus
@@ -218,6 +254,63 @@ vx_node vxImageListerNode(vx_graph graph, vx_image input, vx_list list);
 vx_status vxuImageLister(vx_image input,
                          vx_list list);
 
+/*! \brief [Graph] Creates an MxN Median Filter Node.
+ * \param [in] graph The handle to the graph.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_node vxMedianMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
+/*! \brief [Immediate] Computes a median filter on the image by an MxN window.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_status vxuMedianMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
+/*! \brief [Graph] Creates an MxN Erode Node.
+ * \param [in] graph The handle to the graph.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_node vxErodeMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
+/*! \brief [Immediate] Erodes the image by an MxN rectangle.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_status vxuErodeMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
+/*! \brief [Graph] Creates an MxN Dilate Node.
+ * \param [in] graph The handle to the graph.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_node vxDilateMxNNode(vx_graph graph, vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
+/*! \brief [Immediate] Dilates the image by an MxN rectangle.
+ * \param [in] input The input image in FOURCC_U8 format.
+ * \param [in] columns The VX_TYPE_UINT32 window width.
+ * \param [in] rows The VX_TYPE_UINT32 window height.
+ * \param [out] output The output image in FOURCC_U8 format.
+ * \ingroup group_kernel_rankmxn
+ */
+vx_status vxuDilateMxN(vx_image input, vx_scalar columns, vx_scalar rows, vx_image output);
+
 #ifdef	__cplusplus
 }
 #endif
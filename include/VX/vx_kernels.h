@@ -399,6 +399,15 @@ enum vx_kernel_e {
      */
     VX_KERNEL_OPTICAL_FLOW_PYR_LK,
 
+    /*! \brief The Remap Kernel.
+     * \param [in] vx_image The input image.
+     * \param [in] vx_remap The remap table.
+     * \param [in] vx_enum The Interpolation type from \ref vx_interpolation_type_e.
+     * \param [out] vx_image The output image.
+     * \see group_kernel_remap
+     */
+    VX_KERNEL_REMAP,
+
     /* insert new kernels here */
 
     VX_KERNEL_MAX_1_0, /*!< \internal Used for bounds checking in the conformance test. */
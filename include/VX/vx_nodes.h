@@ -1295,10 +1295,10 @@ vx_node vxFastCornersNode(vx_graph graph, vx_image input, vx_scalar strength_thr
  *  defined at the new_images high resolution pyramid
  * \param [in] termination termination can be <tt>\ref VX_TERM_CRITERIA_ITERATIONS</tt> or <tt>\ref VX_TERM_CRITERIA_EPSILON</tt> or
  * <tt>\ref VX_TERM_CRITERIA_BOTH</tt>
- * \param [in] epsilon is the vx_uint32 error for terminating the algorithm
- * \param [in] num_iterations is the number of iterations
+ * \param [in] epsilon is the vx_float32 error for terminating the algorithm
+ * \param [in] num_iterations is the vx_uint32 number of iterations
  * \param [in] use_initial_estimate Can be set to either vx_false_e or vx_true_e.
- * \param [in] window_dimension is the window on which to perform the algorithm.
+ * \param [in] window_dimension is the window on which to perform the algorithm, an odd size from 3 to 31.
  *
  * \ingroup group_kernel_opticalflowpyrlk
  * \return vx_node
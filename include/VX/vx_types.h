@@ -716,6 +716,35 @@ enum vx_context_attribute_e {
      * larger than the value returned by this attribute.
      */
     VX_CONTEXT_ATTRIBUTE_CONVOLUTION_MAXIMUM_DIMENSION = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_CONTEXT) + 0x9,
+    /*! \brief The number of worker threads the context uses to execute independent
+     * nodes of a graph concurrently. Use a <tt>\ref vx_uint32</tt> parameter.
+     * Zero executes all nodes on the thread which processes the graph. This
+     * attribute may also be set with <tt>\ref vxSetContextAttribute</tt> while
+     * no graph is scheduled or executing.
+     */
+    VX_CONTEXT_ATTRIBUTE_NUM_WORKERS = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_CONTEXT) + 0xA,
+    /*! \brief The number of threads which execute graphs scheduled with
+     * <tt>\ref vxScheduleGraph</tt>, so that independent graphs run concurrently.
+     * Use a <tt>\ref vx_uint32</tt> parameter. This attribute may also be set with
+     * <tt>\ref vxSetContextAttribute</tt> while no graph is scheduled.
+     */
+    VX_CONTEXT_ATTRIBUTE_NUM_EXECUTORS = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_CONTEXT) + 0xB,
+    /*! \brief The number of graphs which may be scheduled and not yet started before
+     * <tt>\ref vxScheduleGraph</tt> returns <tt>\ref VX_ERROR_NO_RESOURCES</tt>. Use a
+     * <tt>\ref vx_size</tt> parameter. Set values are rounded up to a power of two.
+     * This attribute may also be set with <tt>\ref vxSetContextAttribute</tt> while
+     * no graph is scheduled.
+     */
+    VX_CONTEXT_ATTRIBUTE_GRAPH_QUEUE_DEPTH = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_CONTEXT) + 0xC,
+    /*! \brief The file to which a timeline of graph, node and tile executions is
+     * written in the Chrome trace JSON format, which Perfetto also reads. Use a
+     * <tt>\ref vx_char</tt> array of at most 256 characters. Setting a file name with
+     * <tt>\ref vxSetContextAttribute</tt> starts recording, setting an empty string
+     * stops recording and writes the file, which also happens when the context is
+     * released. No graph may be executing while the attribute is set. The
+     * <tt>VX_TRACE_FILE</tt> environment variable starts a trace with the context.
+     */
+    VX_CONTEXT_ATTRIBUTE_TRACE_FILE = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_CONTEXT) + 0xD,
 };
 
 /*! \brief The kernel attributes list
@@ -766,6 +795,10 @@ enum vx_node_attribute_e {
      * Use a void * parameter.
      */
     VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_NODE) + 0x4,
+    /*! \brief Used to query the latency distribution of the node execution.
+     * Use a <tt>\ref vx_perf_stats_t</tt> parameter.
+     */
+    VX_NODE_ATTRIBUTE_PERFORMANCE_STATS = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_NODE) + 0xE,
 };
 
 /*! \brief The parameter attributes list
@@ -836,6 +869,21 @@ enum vx_graph_attribute_e {
     VX_GRAPH_ATTRIBUTE_PERFORMANCE = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x2,
     /*! \brief Returns the number of explicitly declared parameters on the graph. Use a <tt>\ref vx_uint32</tt> parameter. */
     VX_GRAPH_ATTRIBUTE_NUMPARAMETERS = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x3,
+    /*! \brief The number of frames of the graph which may execute concurrently. Use a
+     * <tt>\ref vx_uint32</tt> parameter. When greater than one, each call to
+     * <tt>\ref vxScheduleGraph</tt> starts a new frame while earlier frames are still
+     * executing, each frame using its own copies of the virtual images and the graph
+     * parameter values set before it was scheduled. <tt>\ref vxWaitGraph</tt> waits
+     * for the oldest outstanding frame, so frames complete in the order they were
+     * scheduled. This attribute may be set with <tt>\ref vxSetGraphAttribute</tt>
+     * while no frame is outstanding.
+     */
+    VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x4,
+    /*! \brief Returns the distribution of the end-to-end latency of the graph.
+     * For a pipelined graph this is the time from scheduling a frame to its
+     * completion. Use a <tt>\ref vx_perf_stats_t</tt> parameter.
+     */
+    VX_GRAPH_ATTRIBUTE_PERFORMANCE_STATS = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x5,
 };
 
 /*! \brief The target attributes list
@@ -1394,6 +1442,25 @@ typedef struct _vx_perf_t {
  */
 #define VX_PERF_INIT    {0ul, 0ul, 0ul, 0ul, 0ul, 0ul}
 
+/*! \brief The latency distribution of a node or graph, in the same units as
+ * <tt>\ref vx_perf_t</tt>. Percentiles are accurate to within 1/8th of their value.
+ * \ingroup group_performance
+ */
+typedef struct _vx_perf_stats_t {
+    vx_uint64 num;          /*!< \brief The number of measured executions. */
+    vx_uint64 min;          /*!< \brief The shortest execution. */
+    vx_uint64 avg;          /*!< \brief The mean execution time. */
+    vx_uint64 p50;          /*!< \brief The median execution time. */
+    vx_uint64 p95;          /*!< \brief The 95th percentile execution time. */
+    vx_uint64 p99;          /*!< \brief The 99th percentile execution time. */
+    vx_uint64 max;          /*!< \brief The longest execution. */
+    vx_uint64 wait_num;     /*!< \brief The number of measured queue waits. */
+    vx_uint64 wait_avg;     /*!< \brief The mean time a ready node waited for a worker. */
+    vx_uint64 wait_p99;     /*!< \brief The 99th percentile time a ready node waited for a worker. */
+    vx_uint64 wait_max;     /*!< \brief The longest time a ready node waited for a worker. */
+    vx_uint64 bytes;        /*!< \brief The bytes of data objects read and written by one execution. */
+} vx_perf_stats_t;
+
 /*! \brief The target to kernel correlation table entry definition.
  * \ingroup group_target
  */
@@ -27,6 +27,7 @@ const vx_char implementation[VX_MAX_IMPLEMENTATION_NAME] = "khronos.sample";
 
 vx_char targetModules[][VX_MAX_TARGET_NAME] = {
     "openvx-c_model",
+    "openvx-simd",
 #if defined(OPENVX_USE_OPENCL)
     "openvx-opencl",
 #endif
@@ -50,28 +51,64 @@ static vx_value_t threadGraphExec(void *arg)
 {
     vx_processor_t *proc = (vx_processor_t *)arg;
     VX_PRINT(VX_ZONE_CONTEXT, "Starting thread!\n");
-    while (proc->running == vx_true_e)
+    while (vxSemWait(&proc->count) == vx_true_e && proc->running == vx_true_e)
     {
-        vx_graph g = 0;
-        vx_status s = VX_FAILURE;
-        vx_value_t v1, v2;
-        if (vxReadQueue(&proc->input,&v1,&v2) == vx_true_e)
+        vx_value_t v = 0;
+        if (vxTryReadMPMCQueue(&proc->input, &v) == vx_true_e)
         {
-            g = (vx_graph)v1;
-            // s = (vx_status)v2;
-            VX_PRINT(VX_ZONE_CONTEXT, "Read graph=" VX_FMT_REF ", status=%d\n",g,s);
-            s = vxProcessGraph(g);
-            VX_PRINT(VX_ZONE_CONTEXT, "Writing graph=" VX_FMT_REF ", status=%d\n",g,s);
-            v1 = (vx_value_t)g;
-            v2 = (vx_status)s;
-            if (vxWriteQueue(&proc->output, v1, v2) == vx_false_e)
-                VX_PRINT(VX_ZONE_ERROR, "Failed to write graph=" VX_FMT_REF " status=%d\n", g, s);
+            vx_graph_t *graph = (vx_graph_t *)v;
+            VX_PRINT(VX_ZONE_CONTEXT, "Read graph=" VX_FMT_REF "\n", graph);
+            VX_TRACE_ASYNC('e', "graph", "queued", graph);
+            graph->scheduledStatus = vxProcessGraph((vx_graph)graph);
+            VX_PRINT(VX_ZONE_CONTEXT, "Finished graph=" VX_FMT_REF ", status=%d\n", graph, graph->scheduledStatus);
+            vxAtomicAdd(&proc->numScheduled, (vx_uint32)-1);
+            vxSetEvent(&graph->finished);
         }
     }
     VX_PRINT(VX_ZONE_CONTEXT,"Stopping thread!\n");
     return 0;
 }
 
+/*! \brief Creates the queue of scheduled graphs and the threads which execute them. */
+static vx_bool vxStartExecutors(vx_processor_t *proc, vx_uint32 numThreads, vx_size depth)
+{
+    vx_uint32 t;
+    if (vxCreateMPMCQueue(&proc->input, depth) == vx_false_e)
+        return vx_false_e;
+    vxCreateSem(&proc->count, 0);
+    proc->running = vx_true_e;
+    for (t = 0; t < numThreads; t++)
+        proc->threads[t] = vxCreateThread(threadGraphExec, proc);
+    proc->numThreads = numThreads;
+    return vx_true_e;
+}
+
+/*! \brief Stops and joins the executors. Graphs still in the queue are not
+ * executed, they are finished as abandoned so that waiting on them returns.
+ */
+static void vxStopExecutors(vx_processor_t *proc)
+{
+    vx_uint32 t;
+    vx_value_t v = 0;
+    proc->running = vx_false_e;
+    for (t = 0; t < proc->numThreads; t++)
+        vxSemPost(&proc->count);
+    for (t = 0; t < proc->numThreads; t++)
+        vxJoinThread(proc->threads[t], NULL);
+    proc->numThreads = 0;
+    while (vxTryReadMPMCQueue(&proc->input, &v) == vx_true_e)
+    {
+        vx_graph_t *graph = (vx_graph_t *)v;
+        VX_PRINT(VX_ZONE_WARNING, "Abandoning queued graph=" VX_FMT_REF "\n", graph);
+        VX_TRACE_ASYNC('e', "graph", "queued", graph);
+        graph->scheduledStatus = VX_ERROR_GRAPH_ABANDONED;
+        vxAtomicAdd(&proc->numScheduled, (vx_uint32)-1);
+        vxSetEvent(&graph->finished);
+    }
+    vxDestroySem(&proc->count);
+    vxDestroyMPMCQueue(&proc->input);
+}
+
 vx_bool vxIsValidType(vx_enum type)
 {
     vx_bool ret = vx_false_e;
@@ -158,6 +195,8 @@ vx_context vxCreateContext() {
     {
         /* read the variables for debugging flags */
         vx_set_debug_zone_from_env();
+        /* and whether to record a trace of the executions */
+        vx_set_trace_from_env();
 
         context = VX_CALLOC(vx_context_t); /* \todo get from allocator? */
         if (context)
@@ -223,11 +262,12 @@ vx_context vxCreateContext() {
                 }
             }
 
-            // create the internal thread which processes graphs for asynchronous mode.
-            vxInitQueue(&context->proc.input);
-            vxInitQueue(&context->proc.output);
-            context->proc.running = vx_true_e;
-            context->proc.thread = vxCreateThread(threadGraphExec, &context->proc);
+            /* create the workers which execute independent nodes concurrently,
+             * the thread processing a graph also runs nodes while it waits. */
+            vxCreateThreadpool(&context->pool, vxGetProcessorCount() - 1);
+
+            // create the internal threads which process graphs for asynchronous mode.
+            vxStartExecutors(&context->proc, VX_INT_DEFAULT_EXECUTORS, VX_INT_DEFAULT_GRAPH_QUEUE_DEPTH);
             single_context = context;
         }
     }
@@ -251,9 +291,10 @@ void vxReleaseContext(vx_context *c)
         vxDecrementReference(&context->base);
         if (vxTotalReferenceCount(&context->base) == 0)
         {
-            context->proc.running = vx_false_e;
-            vxPopQueue(&context->proc.input);
-            vxJoinThread(context->proc.thread, NULL);
+            vxStopExecutors(&context->proc);
+
+            /* the trace refers to the kernel names, write it while they exist */
+            vx_stop_trace();
 
             /* de-initialize each target */
             for (t = 0u; t < context->numTargets; t++)
@@ -503,6 +544,159 @@ vx_status vxQueryContext(vx_context c, vx_enum attribute, void *ptr, vx_size siz
                     status = VX_ERROR_INVALID_PARAMETERS;
                 }
                 break;
+            case VX_CONTEXT_ATTRIBUTE_NUM_WORKERS:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3))
+                {
+                    *(vx_uint32 *)ptr = context->pool.numWorkers;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_NUM_EXECUTORS:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3))
+                {
+                    *(vx_uint32 *)ptr = context->proc.numThreads;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_GRAPH_QUEUE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_size, 0x3))
+                {
+                    *(vx_size *)ptr = context->proc.input.mask + 1;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_TRACE_FILE:
+                if (size > 0 && size <= VX_INT_MAX_PATH && ptr)
+                {
+                    strncpy(ptr, vx_get_trace_file(), size);
+                    ((vx_char *)ptr)[size - 1] = '\0';
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            default:
+                status = VX_ERROR_NOT_SUPPORTED;
+                break;
+        }
+    }
+    return status;
+}
+
+vx_status vxSetContextAttribute(vx_context c, vx_enum attribute, void *ptr, vx_size size)
+{
+    vx_status status = VX_SUCCESS;
+    vx_context_t *context = (vx_context_t *)c;
+    if (vxIsValidContext(context) == vx_false_e)
+    {
+        status = VX_ERROR_INVALID_REFERENCE;
+    }
+    else
+    {
+        switch (attribute)
+        {
+            case VX_CONTEXT_ATTRIBUTE_NUM_WORKERS:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3) &&
+                    (*(vx_uint32 *)ptr <= VX_INT_MAX_WORKERS))
+                {
+                    /*! \internal The workers are replaced, so no graph may be
+                     * executing while the number of workers changes. */
+                    if ((context->numExecuting > 0) || (context->proc.numScheduled > 0))
+                    {
+                        status = VX_ERROR_NOT_SUPPORTED;
+                    }
+                    else if (vxResizeThreadpool(&context->pool, *(vx_uint32 *)ptr) == vx_false_e)
+                    {
+                        status = VX_ERROR_NO_RESOURCES;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_NUM_EXECUTORS:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3) &&
+                    (*(vx_uint32 *)ptr > 0) &&
+                    (*(vx_uint32 *)ptr <= VX_INT_MAX_EXECUTORS))
+                {
+                    /*! \internal The executors are replaced, so no graph may be
+                     * scheduled while the number of executors changes. */
+                    vx_size depth = context->proc.input.mask + 1;
+                    if (context->proc.numScheduled > 0)
+                    {
+                        status = VX_ERROR_NOT_SUPPORTED;
+                    }
+                    else
+                    {
+                        vxStopExecutors(&context->proc);
+                        if (vxStartExecutors(&context->proc, *(vx_uint32 *)ptr, depth) == vx_false_e)
+                        {
+                            status = VX_ERROR_NO_RESOURCES;
+                        }
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_GRAPH_QUEUE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_size, 0x3) &&
+                    (*(vx_size *)ptr > 0) &&
+                    (*(vx_size *)ptr <= VX_INT_MAX_GRAPH_QUEUE_DEPTH))
+                {
+                    /*! \internal The queue is replaced, so no graph may be
+                     * scheduled while its depth changes. */
+                    vx_uint32 numThreads = context->proc.numThreads;
+                    if (context->proc.numScheduled > 0)
+                    {
+                        status = VX_ERROR_NOT_SUPPORTED;
+                    }
+                    else
+                    {
+                        vxStopExecutors(&context->proc);
+                        if (vxStartExecutors(&context->proc, numThreads, *(vx_size *)ptr) == vx_false_e)
+                        {
+                            status = VX_ERROR_NO_RESOURCES;
+                        }
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_TRACE_FILE:
+                if (size <= VX_INT_MAX_PATH && ptr)
+                {
+                    vx_char path[VX_INT_MAX_PATH] = {0};
+                    strncpy(path, (vx_char *)ptr, size);
+                    path[VX_INT_MAX_PATH - 1] = '\0';
+                    if (path[0] == '\0')
+                    {
+                        vx_stop_trace();
+                    }
+                    else if (vx_start_trace(path) == vx_false_e)
+                    {
+                        status = VX_ERROR_NO_RESOURCES;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
             default:
                 status = VX_ERROR_NOT_SUPPORTED;
                 break;
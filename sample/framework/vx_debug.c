@@ -82,6 +82,169 @@ void vx_set_debug_zone_from_env(void)
     //printf("vx_zone_mask = 0x%08x\n", vx_zone_mask);
 }
 
+/*! \brief A trace event, the strings are not copied so they must outlive the trace. */
+typedef struct _vx_trace_event_t {
+    const vx_char *cat;
+    const vx_char *name;
+    const void *ref;
+    vx_int32 index;
+    vx_char phase;
+    vx_uint32 tid;
+    vx_uint64 beg;
+    vx_uint64 end;
+} vx_trace_event_t;
+
+volatile vx_bool vx_trace_enabled = vx_false_e;
+static vx_trace_event_t *vx_trace_events;
+static volatile vx_uint32 vx_trace_count;
+static volatile vx_uint32 vx_trace_dropped;
+static vx_uint64 vx_trace_origin;
+static vx_char vx_trace_path[VX_INT_MAX_PATH];
+
+/* the events are claimed with an atomic increment so the threads of the pool
+ * never serialize on a lock while tracing. */
+static vx_trace_event_t *vx_claim_trace_event(void)
+{
+    vx_uint32 e = VX_INT_MAX_TRACE_EVENTS;
+    if (vx_trace_count < VX_INT_MAX_TRACE_EVENTS)
+        e = vxAtomicAdd(&vx_trace_count, 1);
+    if (e < VX_INT_MAX_TRACE_EVENTS)
+        return &vx_trace_events[e];
+    vxAtomicAdd(&vx_trace_dropped, 1);
+    return NULL;
+}
+
+void vx_trace_complete(const vx_char *cat, const vx_char *name, const void *ref, vx_int32 index, vx_uint64 beg, vx_uint64 end)
+{
+    vx_trace_event_t *event = vx_claim_trace_event();
+    if (event)
+    {
+        event->cat = cat;
+        event->name = name;
+        event->ref = ref;
+        event->index = index;
+        event->phase = 'X';
+        event->tid = vxGetThreadId();
+        event->beg = beg;
+        event->end = end;
+    }
+}
+
+void vx_trace_async(vx_char phase, const vx_char *cat, const vx_char *name, const void *ref)
+{
+    vx_trace_event_t *event = vx_claim_trace_event();
+    if (event)
+    {
+        event->cat = cat;
+        event->name = name;
+        event->ref = ref;
+        event->index = -1;
+        event->phase = phase;
+        event->tid = vxGetThreadId();
+        event->beg = vxCaptureTime();
+        event->end = event->beg;
+    }
+}
+
+vx_bool vx_start_trace(const vx_char *path)
+{
+    vx_stop_trace();
+    vx_trace_events = (vx_trace_event_t *)calloc(VX_INT_MAX_TRACE_EVENTS, sizeof(vx_trace_event_t));
+    if (vx_trace_events == NULL)
+        return vx_false_e;
+    strncpy(vx_trace_path, path, sizeof(vx_trace_path) - 1);
+    vx_trace_count = 0;
+    vx_trace_dropped = 0;
+    vx_trace_origin = vxCaptureTime();
+    vx_trace_enabled = vx_true_e;
+    VX_PRINT(VX_ZONE_INFO, "Tracing to %s\n", vx_trace_path);
+    return vx_true_e;
+}
+
+/*! \brief Converts a captured time to microseconds since the trace started. */
+static vx_float64 vx_trace_time(vx_uint64 t, vx_float64 rate)
+{
+    return (vx_float64)(vx_int64)(t - vx_trace_origin) * 1000000.0 / rate;
+}
+
+/*! \brief Writes a string as a JSON string, escaping quotes, backslashes and control characters. */
+static void vx_trace_string(FILE *fp, const vx_char *str)
+{
+    fputc('"', fp);
+    for (; str && *str; str++)
+    {
+        if ((*str == '"') || (*str == '\\'))
+            fprintf(fp, "\\%c", *str);
+        else if ((vx_uint8)*str < 0x20)
+            fprintf(fp, "\\u%04x", (vx_uint8)*str);
+        else
+            fputc(*str, fp);
+    }
+    fputc('"', fp);
+}
+
+void vx_stop_trace(void)
+{
+    FILE *fp = NULL;
+    vx_uint32 e, num = vx_trace_count;
+    vx_float64 rate = (vx_float64)vxGetClockRate();
+
+    if (vx_trace_enabled == vx_false_e)
+        return;
+    vx_trace_enabled = vx_false_e;
+    if (num > VX_INT_MAX_TRACE_EVENTS)
+        num = VX_INT_MAX_TRACE_EVENTS;
+    fp = fopen(vx_trace_path, "w");
+    if (fp)
+    {
+        fprintf(fp, "{\"traceEvents\":[\n");
+        for (e = 0; e < num; e++)
+        {
+            vx_trace_event_t *event = &vx_trace_events[e];
+            fprintf(fp, "{\"name\":");
+            vx_trace_string(fp, event->name);
+            fprintf(fp, ",\"cat\":");
+            vx_trace_string(fp, event->cat);
+            fprintf(fp, ",\"ph\":\"%c\",\"pid\":0,\"tid\":%u,\"ts\":%.3f",
+                    event->phase, event->tid, vx_trace_time(event->beg, rate));
+            if (event->phase == 'X')
+                fprintf(fp, ",\"dur\":%.3f,\"args\":{\"ref\":\"%p\",\"index\":%d}}",
+                        vx_trace_time(event->end, rate) - vx_trace_time(event->beg, rate),
+                        event->ref, event->index);
+            else
+                fprintf(fp, ",\"id\":\"%p\"}", event->ref);
+            fprintf(fp, "%s\n", (e + 1 < num) ? "," : "");
+        }
+        fprintf(fp, "],\"displayTimeUnit\":\"ns\"}\n");
+        fclose(fp);
+    }
+    else
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Failed to open trace file %s\n", vx_trace_path);
+    }
+    if (vx_trace_dropped > 0)
+    {
+        VX_PRINT(VX_ZONE_WARNING, "Trace dropped %u events\n", vx_trace_dropped);
+    }
+    free(vx_trace_events);
+    vx_trace_events = NULL;
+    vx_trace_path[0] = '\0';
+}
+
+const vx_char *vx_get_trace_file(void)
+{
+    return vx_trace_path;
+}
+
+void vx_set_trace_from_env(void)
+{
+    char *str = getenv("VX_TRACE_FILE");
+    if (str && str[0] != '\0')
+    {
+        vx_start_trace(str);
+    }
+}
+
 #define _STR2(x) {#x, x}
 
 struct vx_string_and_enum_e {
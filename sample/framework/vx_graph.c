@@ -28,54 +28,632 @@ static vx_uint32 vxNextNode(vx_graph_t *graph, vx_uint32 index)
     return ((index + 1) % graph->numNodes);
 }
 
-/*! \brief This function starts on the next node in the list and loops until we
- * hit the original node again. Parse over the nodes in circular fashion.
+/*! \brief A reference written by a node, used to match producers to consumers. */
+typedef struct _vx_producer_t {
+    vx_reference_t *ref;
+    vx_uint32 node;
+} vx_producer_t;
+
+/*! \brief A dependency edge between two node indexes. */
+typedef struct _vx_edge_t {
+    vx_uint32 from;
+    vx_uint32 to;
+} vx_edge_t;
+
+static int vxCompareProducers(const void *a, const void *b)
+{
+    const vx_producer_t *pa = (const vx_producer_t *)a;
+    const vx_producer_t *pb = (const vx_producer_t *)b;
+    if (pa->ref < pb->ref)
+        return -1;
+    else if (pa->ref > pb->ref)
+        return 1;
+    else
+        return (int)pa->node - (int)pb->node;
+}
+
+static int vxCompareEdges(const void *a, const void *b)
+{
+    const vx_edge_t *ea = (const vx_edge_t *)a;
+    const vx_edge_t *eb = (const vx_edge_t *)b;
+    if (ea->from != eb->from)
+        return (ea->from < eb->from ? -1 : 1);
+    else if (ea->to != eb->to)
+        return (ea->to < eb->to ? -1 : 1);
+    else
+        return 0;
+}
+
+static void vxClearAdjacency(vx_graph_t *graph)
+{
+    if (graph->edges)
+    {
+        free(graph->edges);
+        graph->edges = NULL;
+    }
+    graph->numEdges = 0;
+    memset(graph->edgeStart, 0, sizeof(graph->edgeStart));
+    memset(graph->indegree, 0, sizeof(graph->indegree));
+}
+
+/*! \brief Builds the producer to consumer edges of the graph in compressed
+ * sparse row form. A node depends on every other node which writes (output or
+ * bidirectional) a reference it reads (input or bidirectional).
  */
-static vx_status vxFindNodesWithReference(vx_graph_t *graph,
-                                          vx_reference_t *ref,
-                                          vx_uint32 refnodes[],
-                                          vx_uint32 *count,
-                                          vx_enum reftype)
+static vx_status vxComputeAdjacency(vx_graph_t *graph)
 {
-    vx_uint32 n, p, nc = 0, max;
-    vx_status status = VX_ERROR_INVALID_LINK;
+    vx_status status = VX_SUCCESS;
+    vx_producer_t *producers = NULL;
+    vx_edge_t *pairs = NULL;
+    vx_uint32 n, p, e, pass, numProducers = 0, numPairs = 0, maxPairs = 0;
+
+    vxClearAdjacency(graph);
 
-    /* save the maximum number of nodes to find */
-    max = *count;
+    producers = (vx_producer_t *)calloc(graph->numNodes * VX_INT_MAX_PARAMS + 1, sizeof(vx_producer_t));
+    if (producers == NULL)
+    {
+        return VX_ERROR_NO_MEMORY;
+    }
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        for (p = 0; p < graph->nodes[n]->kernel->signature.numParams; p++)
+        {
+            vx_enum dir = graph->nodes[n]->kernel->signature.directions[p];
+            if (((dir == VX_OUTPUT) || (dir == VX_BIDIRECTIONAL)) && (graph->nodes[n]->parameters[p] != NULL))
+            {
+                producers[numProducers].ref = graph->nodes[n]->parameters[p];
+                producers[numProducers].node = n;
+                numProducers++;
+            }
+        }
+    }
+    qsort(producers, numProducers, sizeof(vx_producer_t), vxCompareProducers);
 
-    /* reset the current count to zero */
-    *count = 0;
+    /* first count, then collect the (producer, consumer) pairs of each read parameter */
+    for (pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            maxPairs = numPairs;
+            numPairs = 0;
+            pairs = (vx_edge_t *)calloc(maxPairs > 0 ? maxPairs : 1, sizeof(vx_edge_t));
+            if (pairs == NULL)
+            {
+                free(producers);
+                return VX_ERROR_NO_MEMORY;
+            }
+        }
+        for (n = 0; n < graph->numNodes; n++)
+        {
+            for (p = 0; p < graph->nodes[n]->kernel->signature.numParams; p++)
+            {
+                vx_enum dir = graph->nodes[n]->kernel->signature.directions[p];
+                vx_reference_t *ref = graph->nodes[n]->parameters[p];
+                if (((dir == VX_INPUT) || (dir == VX_BIDIRECTIONAL)) && (ref != NULL))
+                {
+                    /* binary search for the first producer of this reference */
+                    vx_uint32 lo = 0, hi = numProducers;
+                    while (lo < hi)
+                    {
+                        vx_uint32 mid = (lo + hi) / 2;
+                        if (producers[mid].ref < ref)
+                            lo = mid + 1;
+                        else
+                            hi = mid;
+                    }
+                    for (; lo < numProducers && producers[lo].ref == ref; lo++)
+                    {
+                        if (producers[lo].node == n)
+                            continue;
+                        if (pairs && numPairs < maxPairs)
+                        {
+                            pairs[numPairs].from = producers[lo].node;
+                            pairs[numPairs].to = n;
+                        }
+                        numPairs++;
+                    }
+                }
+            }
+        }
+    }
+    free(producers);
 
-    VX_PRINT(VX_ZONE_GRAPH,"Find nodes with reference "VX_FMT_REF" type %d over %u nodes upto %u finds\n", ref, reftype, graph->numNodes, max);
+    /* sort by producer then remove duplicate edges */
+    qsort(pairs, numPairs, sizeof(vx_edge_t), vxCompareEdges);
+    graph->edges = (vx_uint32 *)calloc(numPairs > 0 ? numPairs : 1, sizeof(vx_uint32));
+    if (graph->edges == NULL)
+    {
+        free(pairs);
+        return VX_ERROR_NO_MEMORY;
+    }
+    for (e = 0; e < numPairs; e++)
+    {
+        if ((e > 0) && (pairs[e].from == pairs[e-1].from) && (pairs[e].to == pairs[e-1].to))
+            continue;
+        graph->edgeStart[pairs[e].from + 1]++;
+        graph->indegree[pairs[e].to]++;
+        graph->edges[graph->numEdges++] = pairs[e].to;
+        VX_PRINT(VX_ZONE_GRAPH, "Edge node[%u] => node[%u]\n", pairs[e].from, pairs[e].to);
+    }
+    free(pairs);
+
+    /* convert the counts into offsets */
     for (n = 0; n < graph->numNodes; n++)
     {
+        graph->edgeStart[n + 1] += graph->edgeStart[n];
+    }
+    VX_PRINT(VX_ZONE_GRAPH, "Graph has %u nodes and %u edges\n", graph->numNodes, graph->numEdges);
+    return status;
+}
+
+/*! \brief Orders the nodes so that every node comes after all its predecessors,
+ * starting from the heads. Nodes which can not be ordered are part of (or
+ * depend on) a cycle.
+ * \return The number of nodes which were scheduled.
+ */
+static vx_uint32 vxComputeSchedule(vx_graph_t *graph)
+{
+    vx_uint32 n, e, first = 0, last = 0;
+    vx_uint32 remaining[VX_INT_MAX_REF];
+
+    memcpy(remaining, graph->indegree, graph->numNodes * sizeof(vx_uint32));
+    for (n = 0; n < graph->numHeads; n++)
+    {
+        graph->schedule[last++] = graph->heads[n];
+    }
+    while (first < last)
+    {
+        n = graph->schedule[first++];
+        graph->nodes[n]->visited = vx_true_e;
+        for (e = graph->edgeStart[n]; e < graph->edgeStart[n + 1]; e++)
+        {
+            vx_uint32 s = graph->edges[e];
+            if (--remaining[s] == 0)
+            {
+                graph->schedule[last++] = s;
+            }
+        }
+    }
+    return last;
+}
+
+/*! \brief Finds the node writing a reference and counts the nodes reading it.
+ * \return The index of the writing node, or numNodes if nothing writes it.
+ */
+static vx_uint32 vxFindWriter(vx_graph_t *graph, vx_reference_t *ref, vx_uint32 *numReaders)
+{
+    vx_uint32 n, p, writer = graph->numNodes;
+    *numReaders = 0;
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        vx_bool reads = vx_false_e;
         for (p = 0; p < graph->nodes[n]->kernel->signature.numParams; p++)
         {
             vx_enum dir = graph->nodes[n]->kernel->signature.directions[p];
-            vx_reference_t *thisref = graph->nodes[n]->parameters[p];
+            if (graph->nodes[n]->parameters[p] != ref)
+                continue;
+            if ((dir == VX_OUTPUT) || (dir == VX_BIDIRECTIONAL))
+                writer = n;
+            if ((dir == VX_INPUT) || (dir == VX_BIDIRECTIONAL))
+                reads = vx_true_e;
+        }
+        if (reads == vx_true_e)
+            (*numReaders)++;
+    }
+    return writer;
+}
+
+/*! \brief Groups nodes which their target can execute as a single pass.
+ * \details Walking the schedule, a node absorbs the group of a producer when
+ * the image between them is virtual, only the node reads it and the target
+ * accepts the combined group. The last node of a group executes all of its
+ * members, which themselves become empty steps in the schedule.
+ */
+static void vxFuseNodes(vx_graph_t *graph)
+{
+    vx_uint32 i, n, p, m, f;
 
-            /* VX_PRINT(VX_ZONE_GRAPH,"\tchecking node[%u].parameter[%u] dir = %d ref = "VX_FMT_REF" (=?%d:"VX_FMT_REF")\n", n, p, dir, thisref, reftype, ref); */
-            if (((dir == reftype) || (dir == VX_BIDIRECTIONAL)) && (thisref == ref))
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        graph->nodes[n]->fusedInto = NULL;
+        graph->nodes[n]->numFused = 0;
+    }
+    for (i = 0; i < graph->numNodes; i++)
+    {
+        vx_node_t *node = graph->nodes[graph->schedule[i]];
+        vx_target_t *target = &graph->base.context->targets[node->affinity];
+        vx_node_t *group[VX_INT_MAX_FUSED];
+        vx_uint32 numGroup = 0;
+
+        if (target->funcs.fuse == NULL)
+            continue;
+        for (p = 0; p < node->kernel->signature.numParams; p++)
+        {
+            vx_image_t *image = (vx_image_t *)node->parameters[p];
+            vx_node_t *producer = NULL;
+            vx_uint32 numReaders = 0;
+
+            if ((image == NULL) ||
+                (node->kernel->signature.directions[p] != VX_INPUT) ||
+                (vxIsSupportedFourcc(node->kernel->signature.types[p]) == vx_false_e) ||
+                (image->isVirtual == vx_false_e))
+            {
+                continue;
+            }
+            m = vxFindWriter(graph, &image->base, &numReaders);
+            if ((m == graph->numNodes) || (numReaders != 1))
+                continue;
+            producer = graph->nodes[m];
+            if ((producer->affinity != node->affinity) ||
+                (producer->fusedInto != NULL) ||
+                (producer->callback != NULL))
+            {
+                continue;
+            }
+            /* the same producer may feed several inputs of this node */
+            for (f = 0; f < numGroup; f++)
+            {
+                if (group[f] == producer)
+                    break;
+            }
+            if (f < numGroup)
+                continue;
+            if (producer->numFused > 0)
             {
-                if (nc < max)
+                vx_node_t *tentative[VX_INT_MAX_FUSED];
+                if (numGroup + producer->numFused + 1 > VX_INT_MAX_FUSED)
+                    continue;
+                memcpy(tentative, group, numGroup * sizeof(vx_node_t *));
+                memcpy(&tentative[numGroup], producer->fused, producer->numFused * sizeof(vx_node_t *));
+                tentative[numGroup + producer->numFused] = node;
+                if (target->funcs.fuse(target, tentative, numGroup + producer->numFused + 1) == VX_SUCCESS)
                 {
-                    VX_PRINT(VX_ZONE_GRAPH, "match at node[%u].parameter[%u]\n", n, p);
-                    refnodes[nc] = n;
-                    nc++;
-                    status = VX_SUCCESS;
+                    memcpy(&group[numGroup], producer->fused, producer->numFused * sizeof(vx_node_t *));
+                    numGroup += producer->numFused;
                 }
-                else
+            }
+            else
+            {
+                if (numGroup + 2 > VX_INT_MAX_FUSED)
+                    continue;
+                group[numGroup] = producer;
+                group[numGroup + 1] = node;
+                if (target->funcs.fuse(target, group, numGroup + 2) == VX_SUCCESS)
                 {
-                    VX_PRINT(VX_ZONE_ERROR, "ERROR: Overflow in refnodes[]\n");
+                    numGroup++;
                 }
             }
         }
+        if (numGroup > 0)
+        {
+            for (f = 0; f < numGroup; f++)
+            {
+                group[f]->fusedInto = node;
+                group[f]->numFused = 0;
+                node->fused[f] = group[f];
+            }
+            node->fused[numGroup] = node;
+            node->numFused = numGroup + 1;
+        }
+    }
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        vx_node_t *node = graph->nodes[n];
+        if ((node->numFused > 0) && (node->fusedInto == NULL))
+            VX_PRINT(VX_ZONE_GRAPH, "Node[%u] %s executes %u fused nodes\n", n, node->kernel->name, node->numFused);
     }
-    *count = nc;
-    VX_PRINT(VX_ZONE_GRAPH, "Found %u nodes with reference "VX_FMT_REF" status = %d\n", nc, ref, status);
-    return status;
 }
 
+/*! \brief The alignment of each plane placed in the virtual image arena. */
+#define VX_INT_ARENA_ALIGN  (64)
+
+/*! \brief The live range of a virtual image over the nodes of a graph. */
+typedef struct _vx_lifetime_t {
+    vx_image_t *image;
+    vx_uint32 writer;
+    vx_bool written;
+    vx_uint32 reader;
+    vx_uint32 numReaders;
+    vx_uint32 numWriters;
+    vx_bool shared;
+    vx_size size;
+    vx_uint32 slot;
+} vx_lifetime_t;
+
+/*! \brief Detaches the virtual images from the arena and frees it. */
+static void vxReleaseArena(vx_graph_t *graph)
+{
+    vx_uint32 i, p;
+    for (i = 0; i < graph->numAliases; i++)
+    {
+        vx_image_t *image = graph->aliases[i];
+        /* the image may have been given its own memory since it was placed here */
+        for (p = 0; (p < VX_PLANE_MAX) && (image->memory.allocated == vx_false_e); p++)
+        {
+            image->memory.ptrs[p] = NULL;
+        }
+        vxReleaseImageInt(image);
+        graph->aliases[i] = NULL;
+    }
+    graph->numAliases = 0;
+    free(graph->arena);
+    graph->arena = NULL;
+    graph->arenaSize = 0;
+}
+
+/*! \brief Determines whether any other graph or delay in the context refers
+ * to the image, in which case its memory can not be managed by this graph.
+ * \note The reference table has holes where references were removed, so all
+ * of it is scanned.
+ */
+static vx_bool vxIsSharedImage(vx_graph_t *graph, vx_image_t *image)
+{
+    vx_context_t *context = graph->base.context;
+    vx_bool shared = vx_false_e;
+    vx_uint32 r, n, p;
+    vxSemWait(&context->base.lock);
+    for (r = 0u; (r < VX_INT_MAX_REF) && (shared == vx_false_e); r++)
+    {
+        vx_reference_t *ref = context->reftable[r];
+        if ((ref == NULL) || (ref == &graph->base))
+            continue;
+        if (ref->type == VX_TYPE_GRAPH)
+        {
+            vx_graph_t *other = (vx_graph_t *)ref;
+            for (n = 0u; (n < other->numNodes) && (shared == vx_false_e); n++)
+            {
+                for (p = 0u; p < other->nodes[n]->kernel->signature.numParams; p++)
+                {
+                    if (other->nodes[n]->parameters[p] == &image->base)
+                    {
+                        shared = vx_true_e;
+                        break;
+                    }
+                }
+            }
+        }
+        else if (ref->type == VX_TYPE_DELAY)
+        {
+            vx_delay_t *delay = (vx_delay_t *)ref;
+            for (p = 0u; p < delay->count; p++)
+            {
+                if (delay->refs[p] == (vx_reference)image)
+                {
+                    shared = vx_true_e;
+                    break;
+                }
+            }
+        }
+    }
+    vxSemPost(&context->base.lock);
+    return shared;
+}
+
+/*! \brief Places the virtual images of a scheduled graph into a shared arena.
+ * \details An image which is read within the graph may reuse the memory of
+ * another image once every node using that image is an ancestor of the node
+ * writing the new one. That ordering holds no matter how the nodes are
+ * dispatched, so the aliasing stays valid for parallel execution. Virtual
+ * images which are never read within the graph are left as the results of
+ * the graph and get their own memory, as do images which keep state across
+ * nodes or graphs: those written more than once, read and written by the same
+ * node, or referenced by another graph or a delay.
+ */
+static vx_status vxAliasVirtualImages(vx_graph_t *graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 words = (graph->numNodes + 31) / 32;
+    vx_uint32 *ancestors = calloc((vx_size)graph->numNodes * words, sizeof(vx_uint32));
+    vx_uint32 *users = calloc((vx_size)VX_INT_MAX_REF * words, sizeof(vx_uint32));
+    vx_lifetime_t *lives = calloc(VX_INT_MAX_REF, sizeof(vx_lifetime_t));
+    vx_uint32 *slotLast = calloc(VX_INT_MAX_REF, sizeof(vx_uint32));
+    vx_size *slotSize = calloc(VX_INT_MAX_REF, sizeof(vx_size));
+    vx_size *slotOffset = calloc(VX_INT_MAX_REF, sizeof(vx_size));
+    vx_uint32 numLives = 0, numSlots = 0;
+    vx_uint32 i, e, w, v, p, k, u;
+    vx_size total = 0, unaliased = 0;
+
+    vxReleaseArena(graph);
+
+    if (!ancestors || !users || !lives || !slotLast || !slotSize || !slotOffset)
+    {
+        status = VX_ERROR_NO_MEMORY;
+        goto exit;
+    }
+
+    /* the schedule visits every predecessor of a node before the node itself */
+    for (i = 0; i < graph->numNodes; i++)
+    {
+        vx_uint32 m = graph->schedule[i];
+        for (e = graph->edgeStart[m]; e < graph->edgeStart[m + 1]; e++)
+        {
+            vx_uint32 s = graph->edges[e];
+            for (w = 0; w < words; w++)
+            {
+                ancestors[s * words + w] |= ancestors[m * words + w];
+            }
+            ancestors[s * words + (m / 32)] |= (1u << (m % 32));
+        }
+    }
+
+    /* gather the unallocated virtual images with their writer and users */
+    for (i = 0; i < graph->numNodes; i++)
+    {
+        vx_uint32 m = graph->schedule[i];
+        vx_node_t *node = graph->nodes[m];
+        for (p = 0; p < node->kernel->signature.numParams; p++)
+        {
+            vx_image_t *image = (vx_image_t *)node->parameters[p];
+            vx_enum dir = node->kernel->signature.directions[p];
+            if ((image == NULL) ||
+                (vxIsSupportedFourcc(node->kernel->signature.types[p]) == vx_false_e) ||
+                (image->isVirtual == vx_false_e) ||
+                (image->memory.allocated == vx_true_e))
+            {
+                continue;
+            }
+            for (v = 0; v < numLives; v++)
+            {
+                if (lives[v].image == image)
+                    break;
+            }
+            if (v == numLives)
+            {
+                if (numLives == VX_INT_MAX_REF)
+                {
+                    /* too many to track, just give it its own memory */
+                    if (vxAllocateImage(image) == vx_false_e)
+                    {
+                        status = VX_ERROR_NO_MEMORY;
+                        goto exit;
+                    }
+                    continue;
+                }
+                lives[numLives++].image = image;
+            }
+            /* the members of a fused group touch their images when the group runs */
+            u = (node->fusedInto != NULL) ? node->fusedInto->index : m;
+            users[v * words + (u / 32)] |= (1u << (u % 32));
+            if (dir == VX_BIDIRECTIONAL)
+            {
+                lives[v].shared = vx_true_e;
+            }
+            if ((dir == VX_OUTPUT) || (dir == VX_BIDIRECTIONAL))
+            {
+                if ((lives[v].numReaders > 0) && (lives[v].reader == m))
+                    lives[v].shared = vx_true_e;
+                lives[v].written = vx_true_e;
+                lives[v].writer = m;
+                lives[v].numWriters++;
+            }
+            if ((dir == VX_INPUT) || (dir == VX_BIDIRECTIONAL))
+            {
+                if ((lives[v].written == vx_true_e) && (lives[v].writer == m))
+                    lives[v].shared = vx_true_e;
+                lives[v].reader = m;
+                lives[v].numReaders++;
+            }
+        }
+    }
+
+    /* greedily assign each image to the best fitting slot which is free by then */
+    for (v = 0; v < numLives; v++)
+    {
+        vx_image_t *image = lives[v].image;
+        vx_uint32 best = numSlots;
+
+        if ((lives[v].numWriters > 1) || (lives[v].shared == vx_true_e) ||
+            (vxIsSharedImage(graph, image) == vx_true_e))
+        {
+            if (vxAllocateImage(image) == vx_false_e)
+            {
+                status = VX_ERROR_NO_MEMORY;
+                goto exit;
+            }
+            continue;
+        }
+        if ((lives[v].written == vx_true_e) &&
+            (graph->nodes[lives[v].writer]->fusedInto != NULL))
+        {
+            /* only ever exists within a fused pass */
+            continue;
+        }
+        if ((lives[v].written == vx_false_e) || (lives[v].numReaders == 0))
+        {
+            if (vxAllocateImage(image) == vx_false_e)
+            {
+                status = VX_ERROR_NO_MEMORY;
+                goto exit;
+            }
+            continue;
+        }
+        for (p = 0; p < image->memory.nptrs; p++)
+        {
+            vx_size size = vxComputeMemorySize(&image->memory, p);
+            lives[v].size += (size + VX_INT_ARENA_ALIGN - 1) & ~(vx_size)(VX_INT_ARENA_ALIGN - 1);
+        }
+        unaliased += lives[v].size;
+        for (k = 0; k < numSlots; k++)
+        {
+            vx_uint32 *used = &users[slotLast[k] * words];
+            vx_uint32 *before = &ancestors[lives[v].writer * words];
+            for (w = 0; w < words; w++)
+            {
+                if (used[w] & ~before[w])
+                    break;
+            }
+            if (w < words)
+                continue;
+            /* prefer the smallest slot which fits, otherwise the largest one */
+            if (best == numSlots)
+            {
+                best = k;
+            }
+            else if (slotSize[best] >= lives[v].size)
+            {
+                if ((slotSize[k] >= lives[v].size) && (slotSize[k] < slotSize[best]))
+                    best = k;
+            }
+            else if (slotSize[k] > slotSize[best])
+            {
+                best = k;
+            }
+        }
+        if (best == numSlots)
+        {
+            numSlots++;
+        }
+        if (slotSize[best] < lives[v].size)
+        {
+            slotSize[best] = lives[v].size;
+        }
+        slotLast[best] = v;
+        lives[v].slot = best;
+    }
+
+    for (k = 0; k < numSlots; k++)
+    {
+        slotOffset[k] = total;
+        total += slotSize[k];
+    }
+    if (total > 0)
+    {
+        vx_uint8 *base = NULL;
+        graph->arena = calloc(1, total + VX_INT_ARENA_ALIGN);
+        if (graph->arena == NULL)
+        {
+            status = VX_ERROR_NO_MEMORY;
+            goto exit;
+        }
+        graph->arenaSize = total;
+        base = (vx_uint8 *)(((vx_size)graph->arena + VX_INT_ARENA_ALIGN - 1) & ~(vx_size)(VX_INT_ARENA_ALIGN - 1));
+        for (v = 0; v < numLives; v++)
+        {
+            vx_image_t *image = lives[v].image;
+            vx_size offset = slotOffset[lives[v].slot];
+            if (lives[v].size == 0)
+                continue;
+            for (p = 0; p < image->memory.nptrs; p++)
+            {
+                vx_size size = vxComputeMemorySize(&image->memory, p);
+                image->memory.ptrs[p] = &base[offset];
+                offset += (size + VX_INT_ARENA_ALIGN - 1) & ~(vx_size)(VX_INT_ARENA_ALIGN - 1);
+            }
+            vxIncrementIntReference(&image->base);
+            graph->aliases[graph->numAliases++] = image;
+        }
+        VX_PRINT(VX_ZONE_GRAPH, "Aliased %u virtual images into %u slots, "VX_FMT_SIZE" bytes instead of "VX_FMT_SIZE"\n",
+                 graph->numAliases, numSlots, total, unaliased);
+    }
+exit:
+    free(ancestors);
+    free(users);
+    free(lives);
+    free(slotLast);
+    free(slotSize);
+    free(slotOffset);
+    return status;
+}
 
 void vxClearVisitation(vx_graph_t *graph)
 {
@@ -91,285 +669,724 @@ void vxClearExecution(vx_graph_t *graph)
         graph->nodes[n]->executed = vx_false_e;
 }
 
-vx_status vxTraverseGraph(vx_graph_t *graph,
-                          vx_uint32 parentIndex,
-                          vx_uint32 childIndex)
+void vxContaminateGraphs(vx_reference_t *ref)
 {
-    /* this is expensive, but needed in order to know who references a parameter */
-    static vx_uint32 refNodes[VX_INT_MAX_REF];
-    /* this keeps track of the available starting point in the static buffer */
-    static vx_uint32 refStart = 0;
-    /* this makes sure we don't have any odd conditions about infinite depth */
-    static vx_uint32 depth = 0;
-
-    vx_uint32 refCount = 0;
-    vx_uint32 refIndex = 0;
-    vx_uint32 thisIndex = 0;
-    vx_status status = VX_SUCCESS;
-    vx_uint32 p = 0;
+    /* virtual images are not accessible to the user, so any write comes from the graph itself */
+    if ((vxIsValidReference(ref) == vx_true_e) &&
+        ((ref->type != VX_TYPE_IMAGE) || (((vx_image_t *)ref)->isVirtual == vx_false_e)))
+    {
+        vx_uint32 r;
+        vx_context_t *context = ref->context;
+        /*! \internal Scan the entire context for graphs which may contain
+         * this reference and mark them as unverified. The table has holes
+         * where references were removed, so all of it is scanned.
+         */
+        vxSemWait(&context->base.lock);
+        for (r = 0u; r < VX_INT_MAX_REF; r++)
+        {
+            if (context->reftable[r] == NULL)
+                continue;
+            if (context->reftable[r]->type == VX_TYPE_GRAPH)
+            {
+                vx_uint32 n;
+                vx_bool found = vx_false_e;
+                vx_graph_t *graph = (vx_graph_t *)context->reftable[r];
+                for (n = 0u; n < (graph->numNodes) && (found == vx_false_e); n++)
+                {
+                    vx_uint32 p;
+                    for (p = 0u; p < graph->nodes[n]->kernel->signature.numParams; p++)
+                    {
+                        if (graph->nodes[n]->kernel->signature.directions[p] == VX_OUTPUT)
+                        {
+                            continue;
+                        }
+                        if (graph->nodes[n]->parameters[p] == ref)
+                        {
+                            found = vx_true_e;
+                            graph->verified = vx_false_e;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        vxSemPost(&context->base.lock);
+    }
+}
+
+/*! \brief Resets the unfinished predecessor count of each node from the
+ * adjacency computed at verification.
+ */
+static void vxPrepareExecution(vx_graph_t *graph)
+{
+    memcpy(graph->pending, graph->indegree, graph->numNodes * sizeof(vx_uint32));
+}
 
-    VX_PRINT(VX_ZONE_GRAPH, "refStart = %u\n", refStart);
+static void vxExecuteNodeWork(void *arg);
+
+static void vxDispatchNode(vx_graph_t *graph, vx_node_t *node)
+{
+    VX_PRINT(VX_ZONE_GRAPH, "Dispatching node[%u] %s\n", node->index, node->kernel->name);
+    node->readyTime = vxCaptureTime();
+    node->work.function = vxExecuteNodeWork;
+    node->work.arg = node;
+    vxSubmitWork(&graph->base.context->pool, &node->work);
+}
+
+/*! \brief Records the completion of a node and dispatches each successor whose
+ * last predecessor this was. Once a node has abandoned or restarted the graph,
+ * no further nodes are dispatched.
+ */
+static void vxRetireNode(vx_graph_t *graph, vx_node_t *node, vx_action action)
+{
+    vx_uint32 ready[VX_INT_MAX_REF];
+    vx_uint32 e, r, numReady = 0;
+    vx_bool done = vx_false_e;
 
-    if (parentIndex == childIndex && parentIndex != VX_INT_MAX_NODES)
+    vxSemWait(&graph->execlock);
+    if ((graph->action == VX_ACTION_CONTINUE) && (action != VX_ACTION_CONTINUE))
     {
-        VX_PRINT(VX_ZONE_ERROR, "################################\n");
-        VX_PRINT(VX_ZONE_ERROR, "ERROR: CYCLE DETECTED! node[%u]\n", parentIndex);
-        VX_PRINT(VX_ZONE_ERROR, "################################\n");
-        /* there's a cycle in the graph */
-        status = VX_ERROR_INVALID_GRAPH;
+        graph->action = action;
     }
-    else if (depth > graph->numNodes) /* should be impossible under normal circumstances */
+    if (graph->action == VX_ACTION_CONTINUE)
     {
-        /* there's a cycle in the graph */
-        status = VX_ERROR_INVALID_GRAPH;
+        vx_uint32 n = node->index;
+        for (e = graph->edgeStart[n]; e < graph->edgeStart[n + 1]; e++)
+        {
+            vx_uint32 s = graph->edges[e];
+            if (--graph->pending[s] == 0)
+            {
+                ready[numReady++] = s;
+            }
+        }
+    }
+    graph->inflight += numReady;
+    graph->inflight--;
+    if (graph->inflight == 0)
+        done = vx_true_e;
+    vxSemPost(&graph->execlock);
+
+    for (r = 0; r < numReady; r++)
+    {
+        vxDispatchNode(graph, graph->nodes[ready[r]]);
+    }
+    if (done == vx_true_e)
+    {
+        /* the graph may be gone once the event is set */
+        vx_threadpool_t *pool = &graph->base.context->pool;
+        vxSetEvent(&graph->complete);
+        vxWakeWaiters(pool);
+    }
+}
+
+/*! \brief Executes a node on its target. A node which is part of another
+ * node's fused pass has nothing left to do, while the last node of a fused
+ * group hands the whole group to the target.
+ */
+static vx_action vxProcessNode(vx_graph_t *graph, vx_node_t *node)
+{
+    vx_target_t *target = &graph->base.context->targets[node->affinity];
+    vx_action action = VX_ACTION_CONTINUE;
+    vx_perf_t perf = VX_PERF_INIT;
+
+    if (node->fusedInto != NULL)
+    {
+        VX_PRINT(VX_ZONE_TARGET, "Skipping %s:%s, fused into node[%u]\n", target->name, node->kernel->name, node->fusedInto->index);
+        return action;
+    }
+    vxStartCapture(&perf);
+    if (node->numFused > 0)
+    {
+        VX_PRINT(VX_ZONE_TARGET, "Calling %s:%s with %u fused nodes\n", target->name, node->kernel->name, node->numFused);
+        action = target->funcs.process(target, node->fused, 0, node->numFused);
     }
     else
     {
-        /* if the parent is an invalid index, then we assume we're processing a
-         * head of a graph which has no parent index.
-         */
-        if (parentIndex == VX_INT_MAX_NODES)
+        VX_PRINT(VX_ZONE_TARGET, "Calling %s:%s\n", target->name, node->kernel->name);
+        action = target->funcs.process(target, &node, 0, 1);
+    }
+    vxStopCapture(&perf);
+    vxAddToHistogram(&node->latency, perf.tmp);
+    if ((action == VX_ACTION_ABANDON) ||
+        (action == VX_ACTION_RESTART))
+    {
+        VX_PRINT(VX_ZONE_WARNING, "Node[%u] %s:%s returned action %d\n",
+                 node->index, target->name, node->kernel->name, action);
+    }
+    return action;
+}
+
+static void vxExecuteNodeWork(void *arg)
+{
+    vx_node_t *node = (vx_node_t *)arg;
+    vx_graph_t *graph = node->graph;
+    vxAddToHistogram(&node->wait, vxCaptureTime() - node->readyTime);
+    vxRetireNode(graph, node, vxProcessNode(graph, node));
+}
+
+/*! \brief Returns the index of an image in \ref vx_graph_t::virtuals, or numVirtuals. */
+static vx_uint32 vxFindVirtual(vx_graph_t *graph, vx_reference_t *ref)
+{
+    vx_uint32 v;
+    for (v = 0; v < graph->numVirtuals; v++)
+    {
+        if (&graph->virtuals[v]->base == ref)
+            break;
+    }
+    return v;
+}
+
+/*! \brief Frees the frames of a pipelined graph along with the copies of its
+ * virtual images. Graph parameter values set while pipelined move to their nodes.
+ */
+static void vxReleasePipeline(vx_graph_t *graph)
+{
+    vx_uint32 f, v, i;
+    for (i = 0; i < VX_INT_MAX_PARAMS; i++)
+    {
+        if (graph->staged[i])
         {
-            parentIndex = childIndex;
-            thisIndex = parentIndex;
-            VX_PRINT(VX_ZONE_GRAPH, "Starting head-first traverse of graph from node[%u]\n", thisIndex);
+            vx_node_t *node = graph->parameters[i].node;
+            vx_uint32 p = graph->parameters[i].index;
+            vxSetParameterByIndex((vx_node)node, p, node->kernel->signature.directions[p], (vx_reference)graph->staged[i]);
+            vxDecrementIntReference(graph->staged[i]);
+            graph->staged[i] = NULL;
         }
-        else
+    }
+    for (f = 0; f < VX_INT_MAX_PIPELINE_DEPTH; f++)
+    {
+        vx_frame_t *frame = &graph->frames[f];
+        if (frame->clones)
+        {
+            for (v = 0; (f > 0) && (v < graph->numVirtuals); v++)
+            {
+                vx_image image = (vx_image)frame->clones[v];
+                if (image)
+                    vxReleaseImage(&image);
+            }
+            free(frame->clones);
+            frame->clones = NULL;
+            vxDeinitEvent(&frame->done);
+        }
+        for (i = 0; i < VX_INT_MAX_PARAMS; i++)
         {
-            thisIndex = childIndex;
-            VX_PRINT(VX_ZONE_GRAPH, "continuing traverse of graph from node[%u] on node[%u] start=%u\n", parentIndex, thisIndex, refStart);
+            if (frame->held[i])
+                vxDecrementIntReference(frame->held[i]);
+            frame->held[i] = NULL;
         }
+        free(frame->params);
+        free(frame->pending);
+        frame->params = NULL;
+        frame->pending = NULL;
+    }
+    free(graph->bindings);
+    free(graph->virtuals);
+    free(graph->hazardStart);
+    free(graph->hazards);
+    free(graph->gateStart);
+    free(graph->gates);
+    graph->bindings = NULL;
+    graph->virtuals = NULL;
+    graph->numVirtuals = 0;
+    graph->hazardStart = graph->hazards = NULL;
+    graph->gateStart = graph->gates = NULL;
+    graph->firstFrame = graph->nextFrame = 0;
+}
 
-        for (p = 0; p < graph->nodes[thisIndex]->kernel->signature.numParams; p++)
+/*! \brief Returns the index of the node which executes a node, the node
+ * itself unless it is fused into another.
+ */
+static vx_uint32 vxExecutingIndex(vx_graph_t *graph, vx_uint32 n)
+{
+    vx_node_t *node = graph->nodes[n];
+    return (node->fusedInto != NULL) ? node->fusedInto->index : n;
+}
+
+/*! \brief Returns whether the reader takes as an input a reference which is
+ * written by the writer and shared by all frames.
+ */
+static vx_bool vxReadsSharedOutput(vx_graph_t *graph, vx_node_t *writer, vx_node_t *reader)
+{
+    vx_uint32 p, q;
+    if (writer == reader)
+        return vx_false_e;
+    for (p = 0; p < writer->kernel->signature.numParams; p++)
+    {
+        vx_reference_t *ref = writer->parameters[p];
+        if ((ref == NULL) ||
+            (writer->kernel->signature.directions[p] == VX_INPUT) ||
+            (vxFindVirtual(graph, ref) < graph->numVirtuals))
+            continue;
+        for (q = 0; q < reader->kernel->signature.numParams; q++)
+        {
+            if ((reader->parameters[q] == ref) &&
+                (reader->kernel->signature.directions[q] != VX_OUTPUT))
+                return vx_true_e;
+        }
+    }
+    return vx_false_e;
+}
+
+/*! \brief Prepares a verified graph to execute several frames concurrently.
+ * \details Every frame after the first gets its own copy of each virtual image.
+ * Any other reference written by one node and read by another is shared by
+ * all frames, so the writer may only start a frame once each reader has
+ * finished the previous one. Those hazards are recorded per writer, and their
+ * inverse per reader, to be checked as nodes finish.
+ */
+static vx_status vxSetupPipeline(vx_graph_t *graph)
+{
+    vx_uint32 n, p, m, q, w, f, v, count, numNodes = graph->numNodes;
+    vx_size slots = (vx_size)numNodes * VX_INT_MAX_PARAMS;
+    vx_bool *seen = NULL;
+
+    vxReleasePipeline(graph);
+    graph->bindings = calloc(slots, sizeof(vx_reference_t *));
+    graph->virtuals = calloc(VX_INT_MAX_REF, sizeof(vx_image_t *));
+    graph->hazardStart = calloc(numNodes + 1, sizeof(vx_uint32));
+    graph->gateStart = calloc(numNodes + 1, sizeof(vx_uint32));
+    if (!graph->bindings || !graph->virtuals || !graph->hazardStart || !graph->gateStart)
+        goto nomem;
+
+    for (n = 0; n < numNodes; n++)
+    {
+        vx_node_t *node = graph->nodes[n];
+        for (p = 0; p < node->kernel->signature.numParams; p++)
         {
-            vx_enum dir = graph->nodes[thisIndex]->kernel->signature.directions[p];
-            vx_reference_t *ref = graph->nodes[thisIndex]->parameters[p];
+            vx_reference_t *ref = node->parameters[p];
+            if (ref && (ref->type == VX_TYPE_IMAGE) &&
+                (((vx_image_t *)ref)->isVirtual == vx_true_e) &&
+                (vxFindVirtual(graph, ref) == graph->numVirtuals))
+            {
+                graph->virtuals[graph->numVirtuals++] = (vx_image_t *)ref;
+            }
+        }
+        node->framesDone = 0;
+        node->busy = vx_false_e;
+    }
 
-            if (dir != VX_INPUT && ref != NULL)
+    /* count, then fill, the readers of each node's shared outputs. A node
+     * fused into another only retires, so both the writer and the reader of a
+     * hazard are the nodes which execute them. */
+    seen = calloc(numNodes + 1, sizeof(vx_bool));
+    if (!seen)
+        goto nomem;
+    for (count = 0; count < 2; count++)
+    {
+        vx_uint32 total = 0;
+        for (n = 0; n < numNodes; n++)
+        {
+            graph->hazardStart[n] = total;
+            if (graph->nodes[n]->fusedInto != NULL)
+                continue;
+            memset(seen, 0, numNodes * sizeof(vx_bool));
+            for (m = 0; m < numNodes; m++)
             {
-                VX_PRINT(VX_ZONE_GRAPH, "[traverse] node[%u].parameter[%u] = "VX_FMT_REF"\n", thisIndex, p, ref);
-                /* send the maximum number of possible nodes to find */
-                refCount = dimof(refNodes) - refStart;
-                status = vxFindNodesWithReference(graph, ref, &refNodes[refStart], &refCount, VX_INPUT);
-                VX_PRINT(VX_ZONE_GRAPH, "status = %d at node[%u] start=%u count=%u\n", status, thisIndex, refStart, refCount);
-                if (status == VX_SUCCESS)
+                vx_uint32 e = vxExecutingIndex(graph, m);
+                if ((e == n) || (seen[e] == vx_true_e))
+                    continue;
+                for (w = 0; (w < numNodes) && (seen[e] == vx_false_e); w++)
                 {
-                    vx_uint32 refStop = refStart + refCount;
-                    VX_PRINT(VX_ZONE_GRAPH, "Looping from %u to %u\n", refStart, refStop);
-                    for (refIndex = refStart; refIndex < refStop; refIndex++)
-                    {
-                        VX_PRINT(VX_ZONE_GRAPH, "node[%u] => node[%u]\n", parentIndex, refNodes[refIndex]);
-                        refStart += refCount;
-                        depth++; /* go one more level in */
-                        status = vxTraverseGraph(graph, parentIndex, refNodes[refIndex]);
-                        depth--; /* pull out one level */
-                        refStart -= refCount;
-                        VX_PRINT(VX_ZONE_GRAPH, "status = %d at node[%u]\n", status, thisIndex);
-                    }
+                    if ((vxExecutingIndex(graph, w) == n) &&
+                        (vxReadsSharedOutput(graph, graph->nodes[w], graph->nodes[m]) == vx_true_e))
+                        seen[e] = vx_true_e;
                 }
-                if (status == VX_ERROR_INVALID_LINK) /* no links at all */
+                if (seen[e] == vx_true_e)
                 {
-                    VX_PRINT(VX_ZONE_GRAPH, "[Ok] No link found for node[%u].parameter[%u]\n", thisIndex, p);
-                    status = VX_SUCCESS;
+                    if (count == 1)
+                        graph->hazards[total] = e;
+                    total++;
                 }
             }
-            else
+        }
+        graph->hazardStart[numNodes] = total;
+        if (count == 0)
+        {
+            graph->hazards = calloc(total + 1, sizeof(vx_uint32));
+            graph->gates = calloc(total + 1, sizeof(vx_uint32));
+            if (!graph->hazards || !graph->gates)
+                goto nomem;
+        }
+    }
+    free(seen);
+    seen = NULL;
+    for (n = 0; n < numNodes; n++)
+    {
+        for (q = graph->hazardStart[n]; q < graph->hazardStart[n + 1]; q++)
+            graph->gateStart[graph->hazards[q] + 1]++;
+    }
+    for (n = 0; n < numNodes; n++)
+        graph->gateStart[n + 1] += graph->gateStart[n];
+    {
+        vx_uint32 *fill = calloc(numNodes + 1, sizeof(vx_uint32));
+        if (!fill)
+            goto nomem;
+        for (n = 0; n < numNodes; n++)
+        {
+            for (q = graph->hazardStart[n]; q < graph->hazardStart[n + 1]; q++)
             {
-                VX_PRINT(VX_ZONE_GRAPH, "[ ignore ] node[%u].parameter[%u] = "VX_FMT_REF" type %d\n", childIndex, p, ref, dir);
+                m = graph->hazards[q];
+                graph->gates[graph->gateStart[m] + fill[m]++] = n;
             }
-            if (status == VX_ERROR_INVALID_GRAPH)
-                break;
         }
+        free(fill);
+    }
 
-        if (status == VX_SUCCESS)
+    for (f = 0; f < graph->pipelineDepth; f++)
+    {
+        vx_frame_t *frame = &graph->frames[f];
+        frame->params = calloc(slots, sizeof(vx_reference_t *));
+        frame->pending = calloc(numNodes, sizeof(vx_uint32));
+        frame->clones = calloc(graph->numVirtuals + 1, sizeof(vx_image_t *));
+        if (!frame->params || !frame->pending || !frame->clones)
+            goto nomem;
+        vxInitEvent(&frame->done, vx_false_e);
+        for (v = 0; v < graph->numVirtuals; v++)
         {
-            /* mark it visited for the next check to pass */
-            graph->nodes[thisIndex]->visited = vx_true_e;
+            vx_image_t *image = graph->virtuals[v];
+            if (f == 0)
+            {
+                frame->clones[v] = image;
+                continue;
+            }
+            frame->clones[v] = (vx_image_t *)vxCreateImage((vx_context)graph->base.context,
+                                                           image->width, image->height, image->format);
+            if ((frame->clones[v] == NULL) || (vxAllocateImage(frame->clones[v]) == vx_false_e))
+                goto nomem;
         }
     }
-    VX_PRINT(VX_ZONE_GRAPH, "returning status %d\n", status);
-    return status;
+    VX_PRINT(VX_ZONE_GRAPH, "Pipelined graph with %u frames, %u virtual images and %u hazards\n",
+             graph->pipelineDepth, graph->numVirtuals, graph->hazardStart[numNodes]);
+    return VX_SUCCESS;
+nomem:
+    free(seen);
+    vxReleasePipeline(graph);
+    return VX_ERROR_NO_MEMORY;
 }
 
-void vxFindNextNodes(vx_graph_t *graph,
-                     vx_uint32 last_nodes[VX_INT_MAX_REF], vx_uint32 numLast,
-                     vx_uint32 next_nodes[VX_INT_MAX_REF], vx_uint32 *numNext,
-                     vx_uint32 left_nodes[VX_INT_MAX_REF], vx_uint32 *numLeft)
+/*! \brief Fills the parameter tables of every frame from the current node
+ * parameters. Only done while no frame is outstanding.
+ */
+static void vxBindPipeline(vx_graph_t *graph)
 {
-    vx_uint32 poss_next[VX_INT_MAX_REF];
-    vx_uint32 i,n,p,n1,numPoss = 0;
+    vx_uint32 n, p, f, v;
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        memcpy(&graph->bindings[n * VX_INT_MAX_PARAMS], graph->nodes[n]->parameters,
+               VX_INT_MAX_PARAMS * sizeof(vx_reference_t *));
+    }
+    for (f = 0; f < graph->pipelineDepth; f++)
+    {
+        vx_frame_t *frame = &graph->frames[f];
+        for (n = 0; n < graph->numNodes * VX_INT_MAX_PARAMS; n++)
+        {
+            vx_reference_t *ref = graph->bindings[n];
+            frame->params[n] = ref;
+            if (ref && (v = vxFindVirtual(graph, ref)) < graph->numVirtuals)
+                frame->params[n] = &frame->clones[v]->base;
+        }
+        for (p = 0; p < graph->numParams; p++)
+        {
+            if (graph->staged[p])
+            {
+                n = graph->parameters[p].node->index;
+                frame->params[n * VX_INT_MAX_PARAMS + graph->parameters[p].index] = graph->staged[p];
+            }
+        }
+    }
+}
+
+/*! \brief Returns whether a node may start the given frame. The caller holds
+ * \ref vx_graph_t::execlock.
+ */
+static vx_bool vxFrameNodeReady(vx_graph_t *graph, vx_uint32 n, vx_uint32 seq)
+{
+    vx_node_t *node = graph->nodes[n];
+    vx_uint32 h;
+    if ((seq >= graph->nextFrame) || (node->busy == vx_true_e) || (node->framesDone != seq) ||
+        (graph->frames[seq % graph->pipelineDepth].pending[n] != 0))
+        return vx_false_e;
+    for (h = graph->hazardStart[n]; h < graph->hazardStart[n + 1]; h++)
+    {
+        if (graph->nodes[graph->hazards[h]]->framesDone < seq)
+            return vx_false_e;
+    }
+    return vx_true_e;
+}
+
+static void vxExecuteFrameNodeWork(void *arg);
+
+/*! \brief Marks a node as started on a frame if it is ready, and adds it to
+ * the list of nodes to dispatch. The caller holds \ref vx_graph_t::execlock.
+ */
+static void vxClaimFrameNode(vx_graph_t *graph, vx_uint32 n, vx_uint32 seq, vx_node_t *ready[], vx_uint32 *numReady)
+{
+    if (vxFrameNodeReady(graph, n, seq) == vx_true_e)
+    {
+        vx_node_t *node = graph->nodes[n];
+        node->busy = vx_true_e;
+        node->frame = seq;
+        node->readyTime = vxCaptureTime();
+        node->work.function = vxExecuteFrameNodeWork;
+        node->work.arg = node;
+        ready[(*numReady)++] = node;
+    }
+}
 
-    VX_PRINT(VX_ZONE_GRAPH, "Entering with %u left nodes\n", *numLeft);
-    for (n = 0; n < *numLeft; n++)
+/*! \brief Records that a node finished a frame and dispatches what that
+ * unblocked: its successors in the same frame, itself in the next frame, and
+ * the writers which were waiting for it to finish reading.
+ */
+static void vxRetireFrameNode(vx_graph_t *graph, vx_node_t *node, vx_action action)
+{
+    vx_node_t *ready[VX_INT_MAX_REF];
+    vx_uint32 e, r, numReady = 0, n = node->index, seq = node->frame;
+    vx_frame_t *frame = &graph->frames[seq % graph->pipelineDepth];
+    vx_bool done = vx_false_e;
+
+    vxSemWait(&graph->execlock);
+    node->busy = vx_false_e;
+    node->framesDone++;
+    if ((frame->action == VX_ACTION_CONTINUE) && (action != VX_ACTION_CONTINUE))
+    {
+        frame->action = action;
+    }
+    for (e = graph->edgeStart[n]; e < graph->edgeStart[n + 1]; e++)
+    {
+        vx_uint32 s = graph->edges[e];
+        frame->pending[s]--;
+        vxClaimFrameNode(graph, s, seq, ready, &numReady);
+    }
+    vxClaimFrameNode(graph, n, seq + 1, ready, &numReady);
+    for (e = graph->gateStart[n]; e < graph->gateStart[n + 1]; e++)
+    {
+        vxClaimFrameNode(graph, graph->gates[e], seq + 1, ready, &numReady);
+    }
+    if (--frame->remaining == 0)
     {
-        VX_PRINT(VX_ZONE_GRAPH, "leftover: node[%u] = %s\n", left_nodes[n], graph->nodes[left_nodes[n]]->kernel->name);
+        vxAddToHistogram(&graph->latency, vxCaptureTime() - frame->startTime);
+        done = vx_true_e;
     }
+    vxSemPost(&graph->execlock);
 
-    numPoss = 0;
-    *numNext = 0;
-
-    /* for each last node, add all output to input nodes to the list of possible. */
-    for (i = 0; i < numLast; i++)
+    for (r = 0; r < numReady; r++)
     {
-        n = last_nodes[i];
-        for (p = 0; p < graph->nodes[n]->kernel->signature.numParams; p++)
-        {
-            vx_enum dir = graph->nodes[n]->kernel->signature.directions[p];
-            vx_reference_t *ref =  graph->nodes[n]->parameters[p];
-            if (((dir == VX_OUTPUT) || (dir == VX_BIDIRECTIONAL)) && (ref != NULL))
-            {
-                /* send the max possible nodes */
-                n1 = dimof(poss_next) - numPoss;
-                if (vxFindNodesWithReference(graph, ref, &poss_next[numPoss], &n1, VX_INPUT) == VX_SUCCESS)
-                {
-                    VX_PRINT(VX_ZONE_GRAPH, "Adding %u nodes to possible list\n", n1);
-                    numPoss += n1;
-                }
-            }
-        }
+        vxSubmitWork(&graph->base.context->pool, &ready[r]->work);
+    }
+    if (done == vx_true_e)
+    {
+        vx_threadpool_t *pool = &graph->base.context->pool;
+        vxSetEvent(&frame->done);
+        vxWakeWaiters(pool);
     }
+}
 
-    VX_PRINT(VX_ZONE_GRAPH, "There are %u possible nodes\n", numPoss);
+/*! \brief Executes a node on the parameters of its current frame. A frame
+ * which has been abandoned still passes through every node, without executing
+ * them, so that later frames keep their order.
+ */
+static void vxExecuteFrameNodeWork(void *arg)
+{
+    vx_node_t *node = (vx_node_t *)arg;
+    vx_graph_t *graph = node->graph;
+    vx_frame_t *frame = &graph->frames[node->frame % graph->pipelineDepth];
+    vx_action action = VX_ACTION_CONTINUE;
 
-    /* add back all the left over nodes (making sure to not include duplicates) */
-    for (i = 0; i < *numLeft; i++)
+    if (frame->action == VX_ACTION_CONTINUE)
     {
-        vx_uint32 j;
-        vx_bool match = vx_false_e;
-        for (j = 0; j < numPoss; j++)
+        if (node->fusedInto == NULL)
+            vxAddToHistogram(&node->wait, vxCaptureTime() - node->readyTime);
+        /* a fused node's parameters are only read by the node which executes its pass */
+        if (node->numFused > 0)
         {
-            if (left_nodes[i] == poss_next[j])
+            vx_uint32 i;
+            for (i = 0; i < node->numFused; i++)
             {
-                match = vx_true_e;
+                memcpy(node->fused[i]->parameters, &frame->params[node->fused[i]->index * VX_INT_MAX_PARAMS],
+                       VX_INT_MAX_PARAMS * sizeof(vx_reference_t *));
             }
         }
-        if (match == vx_false_e)
+        else if (node->fusedInto == NULL)
+        {
+            memcpy(node->parameters, &frame->params[node->index * VX_INT_MAX_PARAMS],
+                   VX_INT_MAX_PARAMS * sizeof(vx_reference_t *));
+        }
+        action = vxProcessNode(graph, node);
+        if (action == VX_ACTION_RESTART)
         {
-            VX_PRINT(VX_ZONE_GRAPH, "Adding back left over node[%u] %s\n", left_nodes[i], graph->nodes[left_nodes[i]]->kernel->name);
-            poss_next[numPoss++] = left_nodes[i];
+            /* a frame can not be restarted while later frames are running */
+            action = VX_ACTION_ABANDON;
         }
     }
-    *numLeft = 0;
+    vxRetireFrameNode(graph, node, action);
+}
 
-    /* now check all possible next nodes to see if the parent nodes are visited. */
-    for (i = 0; i < numPoss; i++)
-    {
-        vx_uint32 poss_params[VX_INT_MAX_PARAMS];
-        vx_uint32 pi, numPossParam = 0;
-        vx_bool ready = vx_true_e;
+/*! \brief Sets the value of a graph parameter for the frames scheduled from
+ * now on, leaving the node untouched since earlier frames may be using it.
+ * An image must match the dimensions and format the graph was verified with.
+ */
+static vx_status vxStageGraphParameter(vx_graph_t *graph, vx_uint32 index, vx_enum dir, vx_reference value)
+{
+    vx_node_t *node = graph->parameters[index].node;
+    vx_uint32 p = graph->parameters[index].index;
+    vx_reference_t *ref = (vx_reference_t *)value;
+    vx_reference_t *bound = graph->bindings[node->index * VX_INT_MAX_PARAMS + p];
+    vx_enum type = 0;
 
-        n = poss_next[i];
-        VX_PRINT(VX_ZONE_GRAPH, "possible: node[%u] = %s\n", n, graph->nodes[n]->kernel->name);
-        for (p = 0; p < graph->nodes[n]->kernel->signature.numParams; p++)
+    if (vxIsValidReference(ref) == vx_false_e)
+        return VX_ERROR_INVALID_REFERENCE;
+    vxQueryReference(value, VX_REF_ATTRIBUTE_TYPE, &type, sizeof(type));
+    if (vxIsValidTypeMatch(node->kernel->signature.types[p], type) == vx_false_e)
+        return VX_ERROR_INVALID_TYPE;
+    if (dir != node->kernel->signature.directions[p])
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (bound && (bound->type == VX_TYPE_IMAGE) && (type == VX_TYPE_IMAGE))
+    {
+        vx_image_t *a = (vx_image_t *)bound, *b = (vx_image_t *)ref;
+        if ((a->width != b->width) || (a->height != b->height) || (a->format != b->format))
         {
-            if (graph->nodes[n]->kernel->signature.directions[p] == VX_INPUT)
-            {
-                VX_PRINT(VX_ZONE_GRAPH,"nodes[%u].parameter[%u] predicate needs to be checked\n", n, p);
-                poss_params[numPossParam] = p;
-                numPossParam++;
-            }
+            VX_PRINT(VX_ZONE_ERROR, "Graph parameter %u does not match the verified image!\n", index);
+            return VX_ERROR_INVALID_PARAMETERS;
         }
+    }
+    vxIncrementIntReference(ref);
+    if (graph->staged[index])
+        vxDecrementIntReference(graph->staged[index]);
+    graph->staged[index] = ref;
+    return VX_SUCCESS;
+}
 
-        /* now check to make sure all possible input parameters have their */
-        /* parent nodes executed. */
-        for (pi = 0; pi < numPossParam; pi++)
-        {
-            vx_uint32 predicate_nodes[VX_INT_MAX_REF];
-            vx_uint32 predicate_count = 0;
-            vx_uint32 predicate_index = 0;
-            vx_reference_t *ref = 0;
+/*! \brief Starts the next frame of a pipelined graph. */
+static vx_status vxScheduleFrame(vx_graph_t *graph)
+{
+    vx_node_t *ready[VX_INT_MAX_REF];
+    vx_uint32 p, h, r, seq, numReady = 0;
+    vx_frame_t *frame;
+
+    if (graph->nextFrame - graph->firstFrame >= graph->pipelineDepth)
+        return VX_ERROR_GRAPH_SCHEDULED;
+    /* the frames in flight still use the current setup, so any verification
+     * is deferred until the pipeline has drained. */
+    if (((graph->verified == vx_false_e) && (graph->firstFrame == graph->nextFrame)) ||
+        (graph->bindings == NULL))
+    {
+        vx_status status = VX_SUCCESS;
+        if (graph->firstFrame != graph->nextFrame)
+            return VX_ERROR_GRAPH_SCHEDULED;
+        status = vxVerifyGraph((vx_graph)graph);
+        if (status != VX_SUCCESS)
+            return status;
+    }
+    if (graph->firstFrame == graph->nextFrame)
+        vxBindPipeline(graph);
 
-            p = poss_params[pi];
-            ref = graph->nodes[n]->parameters[p];
-            VX_PRINT(VX_ZONE_GRAPH, "checking node[%u].parameter[%u] = "VX_FMT_REF"\n", n, p, ref);
-            /* set the size of predicate nodes going in */
-            predicate_count = dimof(predicate_nodes);
-            if (vxFindNodesWithReference(graph, ref, predicate_nodes, &predicate_count, VX_OUTPUT) == VX_SUCCESS)
-            {
-                /* check to see of all of the predicate nodes are executed */
-                for (predicate_index = 0;
-                     predicate_index < predicate_count;
-                     predicate_index++)
-                {
-                    n1 = predicate_nodes[predicate_index];
-                    if (graph->nodes[n1]->executed == vx_false_e)
-                    {
-                        VX_PRINT(VX_ZONE_GRAPH, "predicated: node[%u] = %s\n", n1, graph->nodes[n1]->kernel->name);
-                        ready = vx_false_e;
-                        break;
-                    }
-                }
-            }
-        }
-        if (ready == vx_true_e)
-        {
-            /* make sure we don't schedule this node twice */
-            if (graph->nodes[n]->visited == vx_false_e)
-            {
-                next_nodes[(*numNext)++] = n;
-                graph->nodes[n]->visited = vx_true_e;
-            }
-        }
-        else
+    seq = graph->nextFrame;
+    frame = &graph->frames[seq % graph->pipelineDepth];
+    for (p = 0; p < graph->numParams; p++)
+    {
+        if (graph->staged[p])
         {
-            /* put the node back into the possible list for next time */
-            left_nodes[(*numLeft)++] = n;
-            VX_PRINT(VX_ZONE_GRAPH, "notready: node[%u] = %s\n", n, graph->nodes[n]->kernel->name);
+            vx_uint32 n = graph->parameters[p].node->index;
+            frame->params[n * VX_INT_MAX_PARAMS + graph->parameters[p].index] = graph->staged[p];
+            vxIncrementIntReference(graph->staged[p]);
+            frame->held[p] = graph->staged[p];
         }
     }
+    memcpy(frame->pending, graph->indegree, graph->numNodes * sizeof(vx_uint32));
+    frame->remaining = graph->numNodes;
+    frame->action = VX_ACTION_CONTINUE;
+    frame->startTime = vxCaptureTime();
+    vxResetEvent(&frame->done);
+    VX_PRINT(VX_ZONE_GRAPH, "Scheduling frame %u of graph "VX_FMT_REF"\n", seq, graph);
+
+    vxAtomicAdd(&graph->base.context->numExecuting, 1);
+    vxSemWait(&graph->execlock);
+    graph->nextFrame++;
+    for (h = 0; h < graph->numHeads; h++)
+    {
+        vxClaimFrameNode(graph, graph->heads[h], seq, ready, &numReady);
+    }
+    vxSemPost(&graph->execlock);
+    for (r = 0; r < numReady; r++)
+    {
+        vxSubmitWork(&graph->base.context->pool, &ready[r]->work);
+    }
+    return VX_SUCCESS;
+}
 
-    VX_PRINT(VX_ZONE_GRAPH, "%u Next Nodes\n", *numNext);
-    for (i = 0; i < *numNext; i++)
+/*! \brief Waits for the oldest outstanding frame of a pipelined graph. The
+ * waiting thread helps execute queued nodes.
+ */
+static vx_status vxWaitFrame(vx_graph_t *graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_threadpool_t *pool = &graph->base.context->pool;
+    vx_frame_t *frame;
+    vx_uint32 p;
+
+    if (graph->firstFrame == graph->nextFrame)
+        return VX_SUCCESS;
+    frame = &graph->frames[graph->firstFrame % graph->pipelineDepth];
+    vxWaitWork(pool, &frame->done);
+    if (frame->action == VX_ACTION_ABANDON)
+        status = VX_ERROR_GRAPH_ABANDONED;
+    for (p = 0; p < VX_INT_MAX_PARAMS; p++)
     {
-        n = next_nodes[i];
-        VX_PRINT(VX_ZONE_GRAPH, "next: node[%u] = %s\n", n, graph->nodes[n]->kernel->name);
+        if (frame->held[p])
+            vxDecrementIntReference(frame->held[p]);
+        frame->held[p] = NULL;
     }
-    VX_PRINT(VX_ZONE_GRAPH, "%u Left Nodes\n", *numLeft);
-    for (i = 0; i < *numLeft; i++)
+    vxSemWait(&graph->execlock);
+    graph->firstFrame++;
+    vxSemPost(&graph->execlock);
+    vxAtomicAdd(&graph->base.context->numExecuting, (vx_uint32)-1);
+    if (graph->firstFrame == graph->nextFrame)
     {
-        n = left_nodes[i];
-        VX_PRINT(VX_ZONE_GRAPH, "left: node[%u] = %s\n", n, graph->nodes[n]->kernel->name);
+        vx_uint32 n;
+        /* every frame is finished, so the nodes are idle */
+        for (n = 0; n < graph->numNodes; n++)
+        {
+            memcpy(graph->nodes[n]->parameters, &graph->bindings[n * VX_INT_MAX_PARAMS],
+                   VX_INT_MAX_PARAMS * sizeof(vx_reference_t *));
+        }
     }
+    VX_PRINT(VX_ZONE_GRAPH, "Frame %u of graph "VX_FMT_REF" returned %d\n", graph->firstFrame - 1, graph, status);
+    return status;
 }
 
-void vxContaminateGraphs(vx_reference_t *ref)
+/*! \brief Returns the bytes of image and buffer data a node reads or writes per execution. */
+static vx_size vxComputeNodeBytes(vx_node_t *node)
 {
-    if (vxIsValidReference(ref) == vx_true_e)
+    vx_size bytes = 0;
+    vx_uint32 p, pl;
+    for (p = 0; p < node->kernel->signature.numParams; p++)
     {
-        vx_uint32 r;
-        vx_context_t *context = ref->context;
-        /*! \internal Scan the entire context for graphs which may contain
-         * this reference and mark them as unverified.
-         */
-        for (r = 0u; r < context->numRefs; r++)
+        vx_reference_t *ref = node->parameters[p];
+        if (ref == NULL)
+            continue;
+        if (ref->type == VX_TYPE_IMAGE)
         {
-            if (context->reftable[r] == NULL)
-                continue;
-            if (context->reftable[r]->type == VX_TYPE_GRAPH)
-            {
-                vx_uint32 n;
-                vx_bool found = vx_false_e;
-                vx_graph_t *graph = (vx_graph_t *)context->reftable[r];
-                for (n = 0u; n < (graph->numNodes) && (found == vx_false_e); n++)
-                {
-                    vx_uint32 p;
-                    for (p = 0u; p < graph->nodes[n]->kernel->signature.numParams; p++)
-                    {
-                        if (graph->nodes[n]->kernel->signature.directions[p] == VX_OUTPUT)
-                        {
-                            continue;
-                        }
-                        if (graph->nodes[n]->parameters[p] == ref)
-                        {
-                            found = vx_true_e;
-                            graph->verified = vx_false_e;
-                            break;
-                        }
-                    }
-                }
-            }
+            vx_image_t *image = (vx_image_t *)ref;
+            for (pl = 0; pl < image->planes; pl++)
+                bytes += (vx_size)image->memory.strides[pl][VX_DIM_Y] * image->memory.dims[pl][VX_DIM_Y];
+        }
+        else if (ref->type == VX_TYPE_BUFFER)
+        {
+            vx_buffer_t *buffer = (vx_buffer_t *)ref;
+            bytes += buffer->unitSize * buffer->numUnits;
         }
     }
+    return bytes;
+}
+
+/*! \brief Summarizes the end-to-end latency of a graph, counting the bytes of all its nodes. */
+static void vxComputeGraphStats(vx_graph_t *graph, vx_perf_stats_t *stats)
+{
+    vx_size bytes = 0;
+    vx_uint32 n;
+    for (n = 0; n < graph->numNodes; n++)
+        bytes += graph->nodes[n]->bytes;
+    vxComputePerfStats(stats, &graph->latency, NULL, bytes);
 }
 
 /******************************************************************************/
@@ -394,7 +1411,12 @@ vx_graph vxCreateGraph(vx_context c)
             vxIncrementReference(&graph->base);
             vxAddReference(context, (vx_reference_t *)graph);
             vxInitPerf(&graph->perf);
+            vxInitHistogram(&graph->latency);
             vxCreateSem(&graph->lock, 1);
+            vxCreateSem(&graph->execlock, 1);
+            vxInitEvent(&graph->complete, vx_false_e);
+            vxInitEvent(&graph->finished, vx_false_e);
+            graph->pipelineDepth = 1;
 
             VX_PRINT(VX_ZONE_GRAPH,"Created Graph %p\n", graph);
             vxPrintReference((vx_reference_t *)graph);
@@ -454,6 +1476,67 @@ vx_status vxQueryGraph(vx_graph g, vx_enum attribute, void *ptr, vx_size size)
                     status = VX_ERROR_INVALID_PARAMETERS;
                 }
                 break;
+            case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3))
+                {
+                    *(vx_uint32 *)ptr = graph->pipelineDepth;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_GRAPH_ATTRIBUTE_PERFORMANCE_STATS:
+                if (VX_CHECK_PARAM(ptr, size, vx_perf_stats_t, 0x3))
+                {
+                    vxComputeGraphStats(graph, (vx_perf_stats_t *)ptr);
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            default:
+                status = VX_ERROR_NOT_SUPPORTED;
+                break;
+        }
+    }
+    else
+    {
+        status = VX_ERROR_INVALID_REFERENCE;
+    }
+    return status;
+}
+
+vx_status vxSetGraphAttribute(vx_graph g, vx_enum attribute, void *ptr, vx_size size)
+{
+    vx_status status = VX_SUCCESS;
+    vx_graph_t *graph = (vx_graph_t *)g;
+    if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_true_e)
+    {
+        switch (attribute)
+        {
+            case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3) &&
+                    (*(vx_uint32 *)ptr > 0) &&
+                    (*(vx_uint32 *)ptr <= VX_INT_MAX_PIPELINE_DEPTH))
+                {
+                    if (graph->firstFrame != graph->nextFrame)
+                    {
+                        status = VX_ERROR_GRAPH_SCHEDULED;
+                    }
+                    else if (graph->pipelineDepth != *(vx_uint32 *)ptr)
+                    {
+                        /* the frames are created when the graph is verified again */
+                        graph->pipelineDepth = *(vx_uint32 *)ptr;
+                        graph->verified = vx_false_e;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
             default:
                 status = VX_ERROR_NOT_SUPPORTED;
                 break;
@@ -486,12 +1569,18 @@ void vxReleaseGraphInt(vx_graph_t *graph, vx_bool internal)
         if (vxTotalReferenceCount(&graph->base) == 0)
         {
             vx_uint32 n;
+            vxReleasePipeline(graph);
+            vxReleaseArena(graph);
             for (n = 0; n < graph->numNodes; n++)
             {
                 vxReleaseNodeInt(graph->nodes[n], vx_true_e);
             }
             vxRemoveReference(graph->base.context, (vx_reference_t *)graph);
+            vxClearAdjacency(graph);
             vxDestroySem(&graph->lock);
+            vxDestroySem(&graph->execlock);
+            vxDeinitEvent(&graph->complete);
+            vxDeinitEvent(&graph->finished);
             free(graph);
         }
     }
@@ -504,8 +1593,13 @@ vx_status vxVerifyGraph(vx_graph g)
 
     if (vxIsValidReference(&graph->base) == vx_true_e)
     {
-        vx_uint32 h,n,p;
-        vx_bool hasACycle = vx_false_e;
+        vx_uint32 n,p;
+
+        if (graph->firstFrame != graph->nextFrame)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Graph "VX_FMT_REF" has outstanding frames!\n", graph);
+            return VX_ERROR_GRAPH_SCHEDULED;
+        }
 
         /* lock the graph */
         vxSemWait(&graph->base.lock);
@@ -778,7 +1872,12 @@ vx_status vxVerifyGraph(vx_graph g)
 
                     if (vxIsSupportedFourcc(graph->nodes[n]->kernel->signature.types[p]) == vx_true_e)
                     {
-                        if (vxAllocateImage((vx_image_t *)graph->nodes[n]->parameters[p]) == vx_false_e)
+                        vx_image_t *img = (vx_image_t *)graph->nodes[n]->parameters[p];
+                        if ((img->isVirtual == vx_true_e) && (img->memory.allocated == vx_false_e))
+                        {
+                            /* virtual images are placed once the graph is scheduled */
+                        }
+                        else if (vxAllocateImage((vx_image_t *)graph->nodes[n]->parameters[p]) == vx_false_e)
                         {
                             vxAddLogEntry(g, VX_ERROR_NO_MEMORY, "Failed to allocate image at node[%u] %s parameter[%u]\n",
                                 n, graph->nodes[n]->kernel->name, p);
@@ -858,38 +1957,19 @@ vx_status vxVerifyGraph(vx_graph g)
         memset(graph->heads, 0, sizeof(graph->heads));
         graph->numHeads = 0;
 
-        /* now traverse the graph and put nodes with no predecessor in the head list */
-        for (n = 0; n < graph->numNodes && status == VX_SUCCESS; n++)
+        if (status == VX_SUCCESS)
         {
-            uint32_t n1,p1;
-            vx_bool isAHead = vx_true_e; /* assume every node is a head until proven otherwise */
-
-            for (p = 0; p < graph->nodes[n]->kernel->signature.numParams && isAHead == vx_true_e; p++)
+            status = vxComputeAdjacency(graph);
+            if (status != VX_SUCCESS)
             {
-                if (graph->nodes[n]->kernel->signature.directions[p] == VX_INPUT &&
-                    graph->nodes[n]->parameters[p] != NULL)
-                {
-                    /* ring loop over the node array, checking every node but this nth node. */
-                    for (n1 = vxNextNode(graph, n); n1 != n && isAHead == vx_true_e; n1 = vxNextNode(graph, n1))
-                    {
-                        for (p1 = 0; p1 < graph->nodes[n1]->kernel->signature.numParams && isAHead == vx_true_e; p1++)
-                        {
-                            if (graph->nodes[n1]->kernel->signature.directions[p1] != VX_INPUT)
-                            {
-                                VX_PRINT(VX_ZONE_GRAPH,"Checking input nodes[%u].parameter[%u] to nodes[%u].parameters[%u]\n", n, p, n1, p1);
-                                /* if the parameter is referenced elsewhere */
-                                if (graph->nodes[n1]->parameters[p1] == graph->nodes[n]->parameters[p])
-                                {
-                                    VX_PRINT(VX_ZONE_GRAPH,"\tnodes[%u].parameter[%u] referenced in nodes[%u].parameter[%u]\n", n,p,n1,p1);
-                                    isAHead = vx_false_e; /* this will cause all the loops to break too. */
-                                }
-                            }
-                        }
-                    }
-                }
+                vxAddLogEntry(g, status, "Failed to compute the adjacency of the graph!\n");
             }
+        }
 
-            if (isAHead == vx_true_e)
+        /* nodes with no predecessor are the heads of the graph */
+        for (n = 0; n < graph->numNodes && status == VX_SUCCESS; n++)
+        {
+            if (graph->indegree[n] == 0)
             {
                 VX_PRINT(VX_ZONE_GRAPH,"Found a head in node[%u] => %s\n", n, graph->nodes[n]->kernel->name);
                 graph->heads[graph->numHeads++] = n;
@@ -910,39 +1990,45 @@ vx_status vxVerifyGraph(vx_graph g)
 
         vxClearVisitation(graph);
 
-        /* cycle checking by traversal of the graph from heads to tails */
-        for (h = 0; h < graph->numHeads; h++)
+        /* a topological ordering reaches every node exactly when there is no cycle */
+        if ((status == VX_SUCCESS) && (vxComputeSchedule(graph) != graph->numNodes))
         {
-            status = vxTraverseGraph(graph, VX_INT_MAX_NODES, graph->heads[h]);
-            if (status != VX_SUCCESS)
+            for (n = 0; n < graph->numNodes; n++)
             {
-                VX_PRINT(VX_ZONE_ERROR,"Cycle found in graph!");
-                vxAddLogEntry(g, status, "Cycle: Graph has a cycle!\n");
-                goto exit;
+                if (graph->nodes[n]->visited == vx_false_e)
+                {
+                    VX_PRINT(VX_ZONE_ERROR, "UNVISITED: %s node[%u]\n", graph->nodes[n]->kernel->name, n);
+                    vxAddLogEntry(g, VX_ERROR_INVALID_GRAPH, "Node %s: unvisited!\n", graph->nodes[n]->kernel->name);
+                }
             }
+            status = VX_ERROR_INVALID_GRAPH;
+            VX_PRINT(VX_ZONE_ERROR,"Cycle found in graph!");
+            vxAddLogEntry(g, status, "Cycle: Graph has a cycle!\n");
         }
 
-        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
-        VX_PRINT(VX_ZONE_GRAPH,"Checking for Unvisited Nodes\n");
-        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
+        vxClearVisitation(graph);
 
-        for (n = 0; n < graph->numNodes && status == VX_SUCCESS; n++)
+        VX_PRINT(VX_ZONE_GRAPH,"###################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Node Fusion Phase!\n");
+        VX_PRINT(VX_ZONE_GRAPH,"###################\n");
+
+        if (status == VX_SUCCESS)
         {
-            if (graph->nodes[n]->visited == vx_false_e)
-            {
-                VX_PRINT(VX_ZONE_ERROR, "UNVISITED: %s node[%u]\n", graph->nodes[n]->kernel->name, n);
-                status = VX_ERROR_INVALID_GRAPH;
-                vxAddLogEntry(g, status, "Node %s: unvisited!\n", graph->nodes[n]->kernel->name);
-            }
+            vxFuseNodes(graph);
         }
 
-        vxClearVisitation(graph);
+        VX_PRINT(VX_ZONE_GRAPH,"################################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Virtual Image Allocation Phase!\n");
+        VX_PRINT(VX_ZONE_GRAPH,"################################\n");
 
-        if (hasACycle == vx_true_e)
+        if (status == VX_SUCCESS)
         {
-            status = VX_ERROR_INVALID_GRAPH;
-            vxAddLogEntry(g, status, "Cycle: Graph has a cycle!\n");
-            goto exit;
+            status = vxAliasVirtualImages(graph);
+            if (status != VX_SUCCESS)
+            {
+                vxAddLogEntry(g, status, "Failed to allocate the virtual images of the graph!\n");
+                VX_PRINT(VX_ZONE_ERROR, "See log\n");
+            }
         }
 
         VX_PRINT(VX_ZONE_GRAPH,"#########################\n");
@@ -992,14 +2078,28 @@ vx_status vxVerifyGraph(vx_graph g)
                         node->attributes.localDataPtr);
             }
 #ifdef OPENVX_KHR_TILING
-            /* if this is a tiling kernel, we can also have tile memory (the sample only makes 1 buffer) */
+            /* if this is a tiling kernel, we can also have tile memory, one buffer per thread which may run its tiles */
             if ((node->attributes.tileDataSize > 0) &&
                 (node->attributes.tileDataPtr == NULL))
             {
-                node->attributes.tileDataPtr = calloc(1, node->attributes.tileDataSize);
+                node->attributes.tileDataCount = graph->base.context->pool.numWorkers + 1;
+                node->attributes.tileDataPtr = calloc(node->attributes.tileDataCount, node->attributes.tileDataSize);
             }
 #endif
         }
+
+        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        {
+            graph->nodes[n]->bytes = vxComputeNodeBytes(graph->nodes[n]);
+        }
+
+        if (status == VX_SUCCESS)
+        {
+            if (graph->pipelineDepth > 1)
+                status = vxSetupPipeline(graph);
+            else
+                vxReleasePipeline(graph);
+        }
 exit:
         if (status == VX_SUCCESS)
         {
@@ -1029,10 +2129,8 @@ static vx_status vxExecuteGraph(vx_graph g)
     vx_status status = VX_SUCCESS;
     vx_action action = VX_ACTION_CONTINUE;
     vx_graph_t *graph = (vx_graph_t *)g;
-    vx_uint32 n, numLast, numNext, numLeft = 0;
-    vx_uint32 last_nodes[VX_INT_MAX_REF];
-    vx_uint32 next_nodes[VX_INT_MAX_REF];
-    vx_uint32 left_nodes[VX_INT_MAX_REF];
+    vx_threadpool_t *pool = NULL;
+    vx_uint32 n;
 
     if (vxIsValidReference(&graph->base) == vx_false_e)
     {
@@ -1046,65 +2144,50 @@ static vx_status vxExecuteGraph(vx_graph g)
             return status;
         }
     }
+    pool = &graph->base.context->pool;
+    vxAtomicAdd(&graph->base.context->numExecuting, 1);
+    vxStartCapture(&graph->perf);
 restart:
     VX_PRINT(VX_ZONE_GRAPH,"************************\n");
     VX_PRINT(VX_ZONE_GRAPH,"*** PROCESSING GRAPH ***\n");
     VX_PRINT(VX_ZONE_GRAPH,"************************\n");
 
-    vxClearVisitation(graph);
     vxClearExecution(graph);
+    action = VX_ACTION_CONTINUE;
 
-    /* initialize the next_nodes as the graph heads */
-    memcpy(next_nodes, graph->heads, graph->numHeads * sizeof(vx_uint32));
-    numNext = graph->numHeads;
-
-    do {
-        for (n = 0; n < numNext; n++)
-        {
-            vxPrintNode(graph->nodes[next_nodes[n]]);
-        }
-
-        /* execute the next nodes */
-        for (n = 0; n < numNext; n++)
+    if (pool->numWorkers == 0)
+    {
+        /* without workers, simply follow the schedule on this thread */
+        for (n = 0; n < graph->numNodes; n++)
         {
-            if (graph->nodes[next_nodes[n]]->executed == vx_false_e)
-            {
-                vx_uint32 t = graph->nodes[next_nodes[n]]->affinity;
-                vx_target_t *target = &graph->base.context->targets[t];
-                vx_node_t *node = graph->nodes[next_nodes[n]];
-                VX_PRINT(VX_ZONE_TARGET, "Calling %s:%s\n", target->name, node->kernel->name);
-                action = target->funcs.process(target, &node, 0, 1);
-                if ((action == VX_ACTION_ABANDON) ||
-                    (action == VX_ACTION_RESTART))
-                {
-                    VX_PRINT(VX_ZONE_WARNING, "Node[%u] %s:%s returned action %d\n",
-                             next_nodes[n],
-                             target->name, node->kernel->name,
-                             action);
-                    break;
-                }
-            }
-            else
+            vx_node_t *node = graph->nodes[graph->schedule[n]];
+            vxPrintNode(node);
+            action = vxProcessNode(graph, node);
+            if ((action == VX_ACTION_ABANDON) ||
+                (action == VX_ACTION_RESTART))
             {
-                VX_PRINT(VX_ZONE_ERROR, "Multiple executions attempted!\n");
                 break;
             }
         }
+    }
+    else if (graph->numHeads > 0)
+    {
+        vxPrepareExecution(graph);
+        graph->action = VX_ACTION_CONTINUE;
+        graph->inflight = graph->numHeads;
+        vxResetEvent(&graph->complete);
 
-        if ((action == VX_ACTION_ABANDON) ||
-            (action == VX_ACTION_RESTART))
+        for (n = 0; n < graph->numHeads; n++)
         {
-            break;
+            vxPrintNode(graph->nodes[graph->heads[n]]);
+            vxDispatchNode(graph, graph->nodes[graph->heads[n]]);
         }
 
-        /* copy next_nodes to last_nodes */
-        memcpy(last_nodes, next_nodes, numNext * sizeof(vx_uint32));
-        numLast = numNext;
-
-        /* determine the next nodes */
-        vxFindNextNodes(graph, last_nodes, numLast, next_nodes, &numNext, left_nodes, &numLeft);
-
-    } while (numNext > 0);
+        /* help execute queued nodes while waiting, this also allows child
+         * graphs to be processed from within a node running on a worker. */
+        vxWaitWork(pool, &graph->complete);
+        action = graph->action;
+    }
 
     if (action == VX_ACTION_RESTART)
     {
@@ -1114,18 +2197,24 @@ restart:
     {
         status = VX_ERROR_GRAPH_ABANDONED;
     }
-    vxClearVisitation(graph);
+    vxStopCapture(&graph->perf);
+    vxAddToHistogram(&graph->latency, graph->perf.tmp);
+    VX_TRACE_INTERVAL("graph", "graph", graph, -1, graph->perf.beg, graph->perf.end);
 
     VX_PRINT(VX_ZONE_GRAPH,"Process returned status %d\n", status);
     for (n = 0; n < graph->numNodes; n++)
     {
-        VX_PRINT(VX_ZONE_PERF,"nodes[%u] %s[%d] last:"VX_FMT_TIME" avg:"VX_FMT_TIME"\n",
+        VX_PRINT(VX_ZONE_PERF,"nodes[%u] %s[%d] last:"VX_FMT_TIME" avg:"VX_FMT_TIME" p50:"VX_FMT_TIME" p99:"VX_FMT_TIME" max:"VX_FMT_TIME"\n",
                  n,
                  graph->nodes[n]->kernel->name,
                  graph->nodes[n]->kernel->enumeration,
                  graph->nodes[n]->perf.tmp,
-                 graph->nodes[n]->perf.avg);
+                 graph->nodes[n]->perf.avg,
+                 vxHistogramPercentile(&graph->nodes[n]->latency, 500),
+                 vxHistogramPercentile(&graph->nodes[n]->latency, 990),
+                 graph->nodes[n]->latency.max);
     }
+    vxAtomicAdd(&graph->base.context->numExecuting, (vx_uint32)-1);
     return status;
 }
 
@@ -1136,16 +2225,29 @@ vx_status vxScheduleGraph(vx_graph g)
     if (vxIsValidReference(&graph->base) == vx_false_e)
         return VX_ERROR_INVALID_REFERENCE;
 
-    if (vxSemTryWait(&graph->lock) == vx_true_e)
+    if (graph->pipelineDepth > 1)
+    {
+        vxSemWait(&graph->lock);
+        status = vxScheduleFrame(graph);
+        vxSemPost(&graph->lock);
+    }
+    else if (vxSemTryWait(&graph->lock) == vx_true_e)
     {
-        /* now add the graph to the queue */
-        VX_PRINT(VX_ZONE_GRAPH,"Writing graph=" VX_FMT_REF ", status=%d\n",g, status);
-        if (vxWriteQueue(&graph->base.context->proc.input,
-                         (vx_value_t)g,
-                         (vx_value_t)status) == vx_true_e)
+        vx_processor_t *proc = &graph->base.context->proc;
+        /* the graph stays locked until it has been waited upon. */
+        vxResetEvent(&graph->finished);
+        VX_PRINT(VX_ZONE_GRAPH,"Writing graph=" VX_FMT_REF "\n", g);
+        VX_TRACE_ASYNC('b', "graph", "queued", graph);
+        vxAtomicAdd(&proc->numScheduled, 1);
+        if (vxTryWriteMPMCQueue(&proc->input, (vx_value_t)g) == vx_true_e)
+        {
+            vxSemPost(&proc->count);
             status = VX_SUCCESS;
+        }
         else
         {
+            vxAtomicAdd(&proc->numScheduled, (vx_uint32)-1);
+            VX_TRACE_ASYNC('e', "graph", "queued", graph);
             vxSemPost(&graph->lock);
             status = VX_ERROR_NO_RESOURCES;
         }
@@ -1163,36 +2265,20 @@ vx_status vxWaitGraph(vx_graph g)
     if (vxIsValidReference(&graph->base) == vx_false_e)
         return VX_ERROR_INVALID_REFERENCE;
 
-    if (vxSemTryWait(&graph->lock) == vx_false_e) // locked
+    if (graph->pipelineDepth > 1)
     {
-        vx_graph g2;
-        vx_bool ret = vx_true_e;
-        vx_value_t v1, v2;
-        do
-        {
-            ret = vxReadQueue(&graph->base.context->proc.output, &v1, &v2);
-            if (ret == vx_false_e)
-            {
-                /* graph was locked but the queue was empty... */
-                VX_PRINT(VX_ZONE_ERROR, "Queue was empty but graph was locked.\n");
-                status = VX_FAILURE;
-            }
-            else
-            {
-                g2 = (vx_graph)v1;
-                status = (vx_status)v2;
-                if (g2 == g) /* great, it's the graph we want. */
-                {
-                    vxSemPost(&graph->lock); /* unlock the graph. */
-                    break;
-                }
-                else
-                {
-                    /* not the right graph, put it back. */
-                    vxWriteQueue(&graph->base.context->proc.output, v1, v2);
-                }
-            }
-        } while (ret == vx_true_e);
+        vxSemWait(&graph->lock);
+        status = vxWaitFrame(graph);
+        vxSemPost(&graph->lock);
+    }
+    else if (vxSemTryWait(&graph->lock) == vx_false_e) // locked
+    {
+        /* only this graph's completion is waited upon, other graphs keep running. */
+        if (vxWaitEvent(&graph->finished, VX_INT_FOREVER) == vx_true_e)
+            status = graph->scheduledStatus;
+        else
+            status = VX_FAILURE;
+        vxSemPost(&graph->lock); /* unlock the graph. */
     }
     else
     {
@@ -1203,6 +2289,17 @@ vx_status vxWaitGraph(vx_graph g)
 
 vx_status vxProcessGraph(vx_graph g)
 {
+    vx_graph_t *graph = (vx_graph_t *)g;
+    if ((vxIsValidReference(&graph->base) == vx_true_e) && (graph->pipelineDepth > 1))
+    {
+        /* run one more frame and drain the pipeline */
+        vx_status status = vxScheduleGraph(g);
+        while ((status == VX_SUCCESS) && (graph->firstFrame != graph->nextFrame))
+        {
+            status = vxWaitGraph(g);
+        }
+        return status;
+    }
     return vxExecuteGraph(g);
 }
 
@@ -1232,7 +2329,11 @@ vx_status vxSetGraphParameterByIndex(vx_graph g, vx_uint32 index, vx_enum dir, v
     vx_status status = VX_ERROR_INVALID_REFERENCE;
     if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_true_e)
     {
-        if (index < VX_INT_MAX_PARAMS)
+        if ((index < graph->numParams) && (graph->bindings != NULL))
+        {
+            status = vxStageGraphParameter(graph, index, dir, value);
+        }
+        else if (index < VX_INT_MAX_PARAMS)
         {
             status = vxSetParameterByIndex((vx_node)graph->parameters[index].node,
                                            graph->parameters[index].index,
@@ -1267,6 +2368,41 @@ vx_parameter vxGetGraphParameterByIndex(vx_graph g, vx_uint32 index)
     return parameter;
 }
 
+vx_status vxGetGraphPerformanceStats(vx_graph g, vx_perf_stats_t *stats, vx_perf_stats_t nodes[], vx_uint32 numNodes)
+{
+    vx_graph_t *graph = (vx_graph_t *)g;
+    vx_uint32 n;
+    if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_false_e)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (stats)
+        vxComputeGraphStats(graph, stats);
+    for (n = 0; nodes && (n < numNodes); n++)
+    {
+        if (n < graph->numNodes)
+            vxComputePerfStats(&nodes[n], &graph->nodes[n]->latency, &graph->nodes[n]->wait, graph->nodes[n]->bytes);
+        else
+            memset(&nodes[n], 0, sizeof(vx_perf_stats_t));
+    }
+    return VX_SUCCESS;
+}
+
+vx_status vxResetGraphPerformance(vx_graph g)
+{
+    vx_graph_t *graph = (vx_graph_t *)g;
+    vx_uint32 n;
+    if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_false_e)
+        return VX_ERROR_INVALID_REFERENCE;
+    vxInitPerf(&graph->perf);
+    vxInitHistogram(&graph->latency);
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        vxInitPerf(&graph->nodes[n]->perf);
+        vxInitHistogram(&graph->nodes[n]->latency);
+        vxInitHistogram(&graph->nodes[n]->wait);
+    }
+    return VX_SUCCESS;
+}
+
 vx_bool vxIsGraphVerified(vx_graph graph)
 {
     vx_bool verified = vx_false_e;
@@ -474,12 +474,17 @@ vx_image vxCreateUniformImage(vx_context c, vx_uint32 width, vx_uint32 height, v
 
 vx_image vxCreateVirtualImage(vx_context c)
 {
-    return vxCreateImage(c, 0, 0, FOURCC_VIRT);
+    return vxCreateVirtualImageWithFormat(c, FOURCC_VIRT);
 }
 
 vx_image vxCreateVirtualImageWithFormat(vx_context c, vx_fourcc format)
 {
-    return vxCreateImage(c, 0, 0, format);
+    vx_image image = vxCreateImage(c, 0, 0, format);
+    if (image)
+    {
+        ((vx_image_t *)image)->isVirtual = vx_true_e;
+    }
+    return image;
 }
 
 vx_image vxCreateImageFromHandle(vx_context c, vx_fourcc color, vx_imagepatch_addressing_t addrs[], void *ptrs[], vx_enum type)
@@ -510,7 +515,12 @@ vx_image vxCreateImageFromHandle(vx_context c, vx_fourcc color, vx_imagepatch_ad
 
 vx_image vxCreateVirtualImageWithDimension(vx_context c, vx_uint32 width, vx_uint32 height)
 {
-    return vxCreateImage(c, width, height, FOURCC_VIRT);
+    vx_image image = vxCreateImage(c, width, height, FOURCC_VIRT);
+    if (image)
+    {
+        ((vx_image_t *)image)->isVirtual = vx_true_e;
+    }
+    return image;
 }
 
 vx_status vxQueryImage(vx_image image, vx_enum attribute, void *ptr, vx_size size)
@@ -49,7 +49,7 @@ vx_kernel_t *vxAllocateKernel(vx_context_t *context,
         kernel->function = function;
         kernel->signature.numParams = numParams;
         kernel->attributes.borders.mode = VX_BORDER_MODE_UNDEFINED;
-        if (kernel->signature.numParams < VX_INT_MAX_PARAMS)
+        if (kernel->signature.numParams <= VX_INT_MAX_PARAMS)
         {
             vx_uint32 p = 0;
             if (parameters != NULL)
@@ -97,7 +97,7 @@ vx_status vxInitializeKernel(vx_context_t *context,
         kernel->deinitialize = deinitialize;
         kernel->attributes.borders.mode = VX_BORDER_MODE_UNDEFINED;
         kernel->attributes.borders.constant_value = 0;
-        if (kernel->signature.numParams < VX_INT_MAX_PARAMS)
+        if (kernel->signature.numParams <= VX_INT_MAX_PARAMS)
         {
             vx_uint32 p = 0;
             if (parameters != NULL)
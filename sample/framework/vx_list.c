@@ -573,3 +573,90 @@ vx_status vxEmptyList(vx_list list)
     }
     return status;
 }
+
+vx_status vxSetListKeypoints(vx_list listref, const vx_keypoint_t *points, vx_size count)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    vx_list_t *list = (vx_list_t *)listref;
+    if (vxIsValidList(list) == vx_true_e)
+    {
+        vx_item_t *item = NULL;
+        vx_size i = 0;
+
+        if (list->type != VX_TYPE_KEYPOINT)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "List does not hold keypoints!\n");
+            return VX_ERROR_INVALID_TYPE;
+        }
+        status = VX_SUCCESS;
+        vxSemWait(&list->base.lock);
+        item = list->head;
+        while (item)
+        {
+            vx_item_t *next = item->next;
+            vx_keypoint_int_t *ikp = (vx_keypoint_int_t *)item->ref;
+            /* only the keypoints which nobody else holds can be rewritten */
+            if ((i < count) && (vxTotalReferenceCount(&ikp->base) == 1))
+            {
+                memcpy(&ikp->data, &points[i++], sizeof(vx_keypoint_t));
+            }
+            else
+            {
+                vxFreeItem(list, NULL, item);
+            }
+            item = next;
+        }
+        for (; (i < count) && (status == VX_SUCCESS); i++)
+        {
+            vx_keypoint_int_t *ikp = (vx_keypoint_int_t *)vxCreateKeypoint((vx_context)list->base.context);
+            item = ikp ? vxAllocItem((vx_reference)ikp) : NULL;
+            if (item)
+            {
+                memcpy(&ikp->data, &points[i], sizeof(vx_keypoint_t));
+                item->prev = list->tail;
+                if (list->tail)
+                    list->tail->next = item;
+                else
+                    list->head = item;
+                list->tail = item;
+                list->count++;
+            }
+            else
+            {
+                if (ikp)
+                    vxReleaseKeypoint((vx_keypoint *)&ikp);
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+        vxSemPost(&list->base.lock);
+    }
+    return status;
+}
+
+vx_status vxGetListKeypoints(vx_list listref, vx_keypoint_t *points, vx_size *count)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    vx_list_t *list = (vx_list_t *)listref;
+    if (vxIsValidList(list) == vx_true_e)
+    {
+        vx_item_t *item = NULL;
+        vx_size i = 0;
+
+        if (list->type != VX_TYPE_KEYPOINT)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "List does not hold keypoints!\n");
+            return VX_ERROR_INVALID_TYPE;
+        }
+        if ((points == NULL) || (count == NULL))
+            return VX_ERROR_INVALID_PARAMETERS;
+        status = VX_SUCCESS;
+        vxSemWait(&list->base.lock);
+        for (item = list->head; item && (i < *count); item = item->next)
+        {
+            memcpy(&points[i++], &((vx_keypoint_int_t *)item->ref)->data, sizeof(vx_keypoint_t));
+        }
+        vxSemPost(&list->base.lock);
+        *count = i;
+    }
+    return status;
+}
@@ -44,21 +44,28 @@ vx_bool vxFreeMemory(vx_context_t *context, vx_memory_t *memory)
 }
 
 
+vx_size vxComputeMemorySize(vx_memory_t *memory, vx_int32 p)
+{
+    vx_size size = 1ul;
+    vx_int32 d = 0;
+    for (d = 0; d < memory->ndims; d++)
+    {
+        memory->strides[p][d] = (vx_int32)size;
+        size *= (vx_size)abs(memory->dims[p][d]);
+    }
+    return size;
+}
+
 vx_bool vxAllocateMemory(vx_context_t *context, vx_memory_t *memory)
 {
     if (memory->allocated == vx_false_e)
     {
-        vx_int32 d = 0, p = 0;
+        vx_int32 p = 0;
         VX_PRINT(VX_ZONE_INFO, "Allocating %u pointers of %u dimensions each.\n", memory->nptrs, memory->ndims);
         memory->allocated = vx_true_e;
         for (p = 0; p < memory->nptrs; p++)
         {
-            vx_size size = 1ul;
-            for (d = 0; d < memory->ndims; d++)
-            {
-                memory->strides[p][d] = (vx_int32)size;
-                size *= (vx_size)abs(memory->dims[p][d]);
-            }
+            vx_size size = vxComputeMemorySize(memory, p);
             memory->ptrs[p] = calloc(1ul, size);
             if (memory->ptrs[p] == NULL)
             {
@@ -68,11 +68,14 @@ vx_node vxCreateNode(vx_graph g, vx_kernel k)
                     graph->nodes[n] = node;
                     vxIncrementIntReference(&node->base); /* one for the graph */
                     node->graph = graph;
+                    node->index = n;
 
                     /* increase the count of nodes in the graph. */
                     graph->numNodes++;
 
                     vxInitPerf(&graph->nodes[n]->perf);
+                    vxInitHistogram(&graph->nodes[n]->latency);
+                    vxInitHistogram(&graph->nodes[n]->wait);
 
                     /* force a re-verify */
                     graph->verified = vx_false_e;
@@ -111,6 +114,16 @@ vx_status vxQueryNode(vx_node n, vx_enum attribute, void *ptr, vx_size size)
                     status = VX_ERROR_INVALID_PARAMETERS;
                 }
                 break;
+            case VX_NODE_ATTRIBUTE_PERFORMANCE_STATS:
+                if (VX_CHECK_PARAM(ptr, size, vx_perf_stats_t, 0x3))
+                {
+                    vxComputePerfStats((vx_perf_stats_t *)ptr, &node->latency, &node->wait, node->bytes);
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
             case VX_NODE_ATTRIBUTE_STATUS:
                 if (VX_CHECK_PARAM(ptr, size, vx_status, 0x3))
                 {
@@ -392,6 +405,13 @@ void vxReleaseNodeInt(vx_node_t *node, vx_bool internal)
                 free(node->attributes.localDataPtr);
                 node->attributes.localDataPtr = NULL;
             }
+#ifdef OPENVX_KHR_TILING
+            if (node->attributes.tileDataPtr)
+            {
+                free(node->attributes.tileDataPtr);
+                node->attributes.tileDataPtr = NULL;
+            }
+#endif
 
             /* de-initialize the kernel */
             if (node->kernel->deinitialize)
@@ -447,6 +467,89 @@ vx_nodecomplete_f vxRetrieveNodeCallback(vx_node n)
 }
 
 
+/*! \brief The fewest pixels worth giving a thread of their own. */
+#define VX_BAND_MIN_PIXELS  (64*1024)
+
+/*! \brief The state shared by all bands of one call to \ref vxRunBands. */
+typedef struct _vx_bands_t {
+    vx_band_f band;
+    void *arg;
+    vx_uint32 count;
+    vx_uint32 height;
+    vx_sem_t done;
+} vx_bands_t;
+
+/*! \brief One band of rows, queued on the pool. */
+typedef struct _vx_band_job_t {
+    vx_work_t work;
+    vx_bands_t *bands;
+    vx_uint32 index;
+} vx_band_job_t;
+
+static void vxBandJob(void *arg)
+{
+    vx_band_job_t *job = (vx_band_job_t *)arg;
+    vx_bands_t *bands = job->bands;
+    vx_uint32 y0 = (vx_uint32)(((vx_uint64)job->index * bands->height) / bands->count);
+    vx_uint32 y1 = (vx_uint32)(((vx_uint64)(job->index + 1) * bands->height) / bands->count);
+    bands->band(bands->arg, job->index, y0, y1);
+    if (job->index > 0)
+        vxSemPost(&bands->done);
+}
+
+vx_uint32 vxBandCount(vx_node node, vx_uint32 width, vx_uint32 height)
+{
+    vx_threadpool_t *pool = &((vx_node_t *)node)->base.context->pool;
+    vx_uint32 count = (vx_uint32)(((vx_uint64)width * height) / VX_BAND_MIN_PIXELS);
+    if (count > pool->numWorkers + 1)
+        count = pool->numWorkers + 1;
+    if (count > height)
+        count = height;
+    if (count < 1)
+        count = 1;
+    return count;
+}
+
+void vxRunBands(vx_node node, vx_uint32 count, vx_uint32 height, vx_band_f band, void *arg)
+{
+    vx_threadpool_t *pool = &((vx_node_t *)node)->base.context->pool;
+    vx_band_job_t jobs[VX_MAX_BANDS];
+    vx_bands_t bands;
+    vx_uint32 j;
+
+    bands.band = band;
+    bands.arg = arg;
+    bands.count = count;
+    bands.height = height;
+    vxCreateSem(&bands.done, 0);
+    for (j = 0u; j < count; j++)
+    {
+        jobs[j].bands = &bands;
+        jobs[j].index = j;
+        jobs[j].work.function = vxBandJob;
+        jobs[j].work.arg = &jobs[j];
+    }
+    for (j = 1u; j < count; j++)
+    {
+        vxSubmitWork(pool, &jobs[j].work);
+    }
+    /* as with tiling, the caller runs the first band and then helps with
+     * queued work, so a node on a pool worker cannot deadlock */
+    vxBandJob(&jobs[0]);
+    for (j = 1u; j < count; j++)
+    {
+        while (vxSemTryWait(&bands.done) == vx_false_e)
+        {
+            if (vxTryRunWork(pool) == vx_false_e)
+            {
+                vxSemWait(&bands.done);
+                break;
+            }
+        }
+    }
+    vxDestroySem(&bands.done);
+}
+
 // ![SAMPLE EXTENSION]
 vx_status vxSetChildGraphOfNode(vx_node n, vx_graph child)
 {
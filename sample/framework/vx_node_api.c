@@ -599,21 +599,48 @@ vx_node vxOpticalFlowPyrLKNode(vx_graph graph,
                                vx_scalar use_initial_estimate,
                                vx_size window_dimension)
 {
+    vx_scalar term = vxCreateScalar(vxGetContext(graph), VX_TYPE_ENUM, &termination);
+    vx_scalar winsize = vxCreateScalar(vxGetContext(graph), VX_TYPE_SIZE, &window_dimension);
     vx_parameter_item_t params[] = {
             {VX_INPUT, old_images},
             {VX_INPUT, new_images},
             {VX_INPUT, old_points},
             {VX_INPUT, new_points_estimates},
             {VX_OUTPUT, new_points},
-            {VX_INPUT, termination},
+            {VX_INPUT, term},
             {VX_INPUT, epsilon},
             {VX_INPUT, num_iterations},
             {VX_INPUT, use_initial_estimate},
-            {VX_INPUT, window_dimension},
+            {VX_INPUT, winsize},
     };
-    return vxCreateNodeByStructure(graph,
-                                    VX_KERNEL_OPTICAL_FLOW_PYR_LK,
-                                    params,
-                                    dimof(params));
+    vx_node node = vxCreateNodeByStructure(graph,
+                                           VX_KERNEL_OPTICAL_FLOW_PYR_LK,
+                                           params,
+                                           dimof(params));
+    vxReleaseScalar(&term);
+    vxReleaseScalar(&winsize);
+    return node;
+}
+
+vx_node vxRemapNode(vx_graph graph,
+                    vx_image input,
+                    vx_remap table,
+                    vx_enum policy,
+                    vx_image output)
+{
+    vx_context context = vxGetContext(graph);
+    vx_scalar spolicy = vxCreateScalar(context, VX_TYPE_ENUM, &policy);
+    vx_parameter_item_t params[] = {
+            {VX_INPUT, input},
+            {VX_INPUT, table},
+            {VX_INPUT, spolicy},
+            {VX_OUTPUT, output},
+    };
+    vx_node node = vxCreateNodeByStructure(graph,
+                                           VX_KERNEL_REMAP,
+                                           params,
+                                           dimof(params));
+    vxReleaseScalar(&spolicy);
+    return node;
 }
 
@@ -22,6 +22,12 @@
  */
 
 #include <vx_internal.h>
+#if defined(LINUX) || defined(ANDROID) || defined(__QNX__) || defined(CYGWIN) || defined(DARWIN)
+#include <unistd.h>
+#endif
+#if defined(LINUX) || defined(ANDROID)
+#include <sys/syscall.h>
+#endif
 
 #define BILLION (1000000000)
 
@@ -39,7 +45,7 @@ vx_bool vxCreateSem(vx_sem_t *sem, vx_uint32 count)
     VX_PRINT(VX_ZONE_OSAL, "sem_open(%s, %d[%d])=>%p (%p) errno=%d\n",name,count,SEM_VALUE_MAX,*sem,SEM_FAILED,errno);
     if (*sem != SEM_FAILED)
 #elif defined(WIN32) || defined(UNDER_CE)
-    *sem = CreateSemaphore(NULL, count, count, NULL);
+    *sem = CreateSemaphore(NULL, count, 0x7FFFFFFF, NULL);
     if (*sem)
 #endif
         return vx_true_e;
@@ -293,6 +299,228 @@ vx_thread_t vxCreateThread(vx_thread_f func, void *arg)
     return thread;
 }
 
+vx_uint32 vxGetProcessorCount()
+{
+    vx_uint32 count = 1;
+#if defined(LINUX) || defined(ANDROID) || defined(__QNX__) || defined(CYGWIN) || defined(DARWIN)
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online > 0)
+        count = (vx_uint32)online;
+#elif defined(WIN32) || defined(UNDER_CE)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    if (info.dwNumberOfProcessors > 0)
+        count = (vx_uint32)info.dwNumberOfProcessors;
+#endif
+    return count;
+}
+
+vx_uint32 vxGetThreadId()
+{
+#if defined(LINUX) || defined(ANDROID)
+    return (vx_uint32)syscall(SYS_gettid);
+#elif defined(WIN32) || defined(UNDER_CE)
+    return (vx_uint32)GetCurrentThreadId();
+#else
+    return (vx_uint32)(size_t)pthread_self();
+#endif
+}
+
+static vx_work_t *vxPopWork(vx_threadpool_t *pool)
+{
+    vx_work_t *work = NULL;
+    vxSemWait(&pool->lock);
+    work = pool->head;
+    if (work)
+    {
+        pool->head = work->next;
+        if (pool->head == NULL)
+            pool->tail = NULL;
+        work->next = NULL;
+    }
+    vxSemPost(&pool->lock);
+    return work;
+}
+
+static vx_value_t vxThreadpoolWorker(void *arg)
+{
+    vx_threadpool_t *pool = (vx_threadpool_t *)arg;
+    VX_PRINT(VX_ZONE_OSAL, "Starting worker on pool %p\n", pool);
+    while (vxSemWait(&pool->count) == vx_true_e)
+    {
+        vx_work_t *work = NULL;
+        if (pool->running == vx_false_e)
+            break;
+        work = vxPopWork(pool);
+        if (work)
+            work->function(work->arg);
+    }
+    VX_PRINT(VX_ZONE_OSAL, "Stopping worker on pool %p\n", pool);
+    return 0;
+}
+
+/*! \brief Adds workers to a running pool. */
+static vx_bool vxStartWorkers(vx_threadpool_t *pool, vx_uint32 numWorkers)
+{
+    vx_uint32 w;
+    if (numWorkers > VX_INT_MAX_WORKERS)
+        numWorkers = VX_INT_MAX_WORKERS;
+    for (w = 0; w < numWorkers; w++)
+    {
+        pool->workers[w] = vxCreateThread(vxThreadpoolWorker, pool);
+        if (pool->workers[w] == 0)
+        {
+            VX_PRINT(VX_ZONE_WARNING, "Only created %u of %u workers\n", w, numWorkers);
+            break;
+        }
+        pool->numWorkers++;
+    }
+    VX_PRINT(VX_ZONE_OSAL, "Created pool %p with %u workers\n", pool, pool->numWorkers);
+    return (pool->numWorkers == numWorkers) ? vx_true_e : vx_false_e;
+}
+
+/*! \brief Stops and joins the workers of an idle pool, keeping its queue. */
+static void vxStopWorkers(vx_threadpool_t *pool)
+{
+    vx_uint32 w;
+    /* wake every worker so that it sees the stop */
+    pool->running = vx_false_e;
+    for (w = 0; w < pool->numWorkers; w++)
+        vxSemPost(&pool->count);
+    for (w = 0; w < pool->numWorkers; w++)
+    {
+        vxJoinThread(pool->workers[w], NULL);
+        pool->workers[w] = 0;
+    }
+    pool->numWorkers = 0;
+}
+
+vx_bool vxCreateThreadpool(vx_threadpool_t *pool, vx_uint32 numWorkers)
+{
+    if (pool == NULL)
+        return vx_false_e;
+    pool->head = NULL;
+    pool->tail = NULL;
+    pool->numWorkers = 0;
+    pool->numWaiting = 0;
+    pool->running = vx_true_e;
+    if (vxCreateSem(&pool->lock, 1) == vx_false_e)
+        return vx_false_e;
+    if (vxCreateSem(&pool->count, 0) == vx_false_e)
+    {
+        vxDestroySem(&pool->lock);
+        return vx_false_e;
+    }
+    if (vxCreateSem(&pool->wake, 0) == vx_false_e)
+    {
+        vxDestroySem(&pool->count);
+        vxDestroySem(&pool->lock);
+        return vx_false_e;
+    }
+    vxStartWorkers(pool, numWorkers);
+    return vx_true_e;
+}
+
+vx_bool vxResizeThreadpool(vx_threadpool_t *pool, vx_uint32 numWorkers)
+{
+    if (pool == NULL)
+        return vx_false_e;
+    vxStopWorkers(pool);
+    pool->running = vx_true_e;
+    return vxStartWorkers(pool, numWorkers);
+}
+
+void vxDestroyThreadpool(vx_threadpool_t *pool)
+{
+    if (pool == NULL)
+        return;
+    /* the pool must be idle */
+    vxStopWorkers(pool);
+    pool->head = NULL;
+    pool->tail = NULL;
+    vxDestroySem(&pool->wake);
+    vxDestroySem(&pool->count);
+    vxDestroySem(&pool->lock);
+}
+
+/*! \brief Wakes every thread sleeping in \ref vxWaitWork, the pool lock must be held. */
+static void vxWakeWaitersLocked(vx_threadpool_t *pool)
+{
+    for (; pool->numWaiting > 0; pool->numWaiting--)
+        vxSemPost(&pool->wake);
+}
+
+void vxSubmitWork(vx_threadpool_t *pool, vx_work_t *work)
+{
+    work->next = NULL;
+    vxSemWait(&pool->lock);
+    if (pool->tail)
+        pool->tail->next = work;
+    else
+        pool->head = work;
+    pool->tail = work;
+    vxWakeWaitersLocked(pool);
+    vxSemPost(&pool->lock);
+    vxSemPost(&pool->count);
+}
+
+void vxWakeWaiters(vx_threadpool_t *pool)
+{
+    vxSemWait(&pool->lock);
+    vxWakeWaitersLocked(pool);
+    vxSemPost(&pool->lock);
+}
+
+void vxWaitWork(vx_threadpool_t *pool, vx_event_t *done)
+{
+    while (vxWaitEvent(done, 0) == vx_false_e)
+    {
+        vx_bool sleep = vx_false_e;
+        if (vxTryRunWork(pool) == vx_true_e)
+            continue;
+        /* register before looking at the event again, so that a wake for
+         * either new work or the event can not be missed */
+        vxSemWait(&pool->lock);
+        if (pool->head == NULL)
+        {
+            pool->numWaiting++;
+            sleep = vx_true_e;
+        }
+        vxSemPost(&pool->lock);
+        if (sleep == vx_false_e)
+            continue;
+        if (vxWaitEvent(done, 0) == vx_true_e)
+        {
+            /* withdraw, or take the wake which was already posted */
+            vxSemWait(&pool->lock);
+            if (pool->numWaiting > 0)
+            {
+                pool->numWaiting--;
+                sleep = vx_false_e;
+            }
+            vxSemPost(&pool->lock);
+            if (sleep == vx_false_e)
+                break;
+        }
+        vxSemWait(&pool->wake);
+    }
+}
+
+vx_bool vxTryRunWork(vx_threadpool_t *pool)
+{
+    vx_bool ran = vx_false_e;
+    if (vxSemTryWait(&pool->count) == vx_true_e)
+    {
+        vx_work_t *work = vxPopWork(pool);
+        if (work)
+        {
+            work->function(work->arg);
+            ran = vx_true_e;
+        }
+    }
+    return ran;
+}
+
 vx_uint64 vxCaptureTime()
 {
     vx_uint64 cap = 0;
@@ -357,6 +585,89 @@ void vxInitPerf(vx_perf_t *perf)
     memset(perf, 0, sizeof(vx_perf_t));
 }
 
+/* values below 1 << VX_INT_HISTOGRAM_SUB_BITS get a bucket each, above that
+ * the exponent selects a group of buckets and the bits below the leading one
+ * select the bucket within it. */
+static vx_uint32 vxHistogramBucket(vx_uint64 value)
+{
+    vx_uint32 e = VX_INT_HISTOGRAM_SUB_BITS;
+    if (value < (1ull << VX_INT_HISTOGRAM_SUB_BITS))
+        return (vx_uint32)value;
+    while ((e < 63) && (value >> (e + 1)))
+        e++;
+    return ((e - VX_INT_HISTOGRAM_SUB_BITS + 1) << VX_INT_HISTOGRAM_SUB_BITS) +
+           (vx_uint32)((value >> (e - VX_INT_HISTOGRAM_SUB_BITS)) & ((1u << VX_INT_HISTOGRAM_SUB_BITS) - 1));
+}
+
+/* the largest value which falls into a bucket */
+static vx_uint64 vxHistogramBucketLimit(vx_uint32 bucket)
+{
+    vx_uint32 group = bucket >> VX_INT_HISTOGRAM_SUB_BITS;
+    vx_uint64 sub = bucket & ((1u << VX_INT_HISTOGRAM_SUB_BITS) - 1);
+    vx_uint32 e;
+    if (group == 0)
+        return sub;
+    e = group + VX_INT_HISTOGRAM_SUB_BITS - 1;
+    return (((1ull << VX_INT_HISTOGRAM_SUB_BITS) + sub + 1) << (e - VX_INT_HISTOGRAM_SUB_BITS)) - 1;
+}
+
+void vxInitHistogram(vx_histogram_t *h)
+{
+    memset(h, 0, sizeof(vx_histogram_t));
+}
+
+void vxAddToHistogram(vx_histogram_t *h, vx_uint64 value)
+{
+    h->counts[vxHistogramBucket(value)]++;
+    if ((h->num == 0) || (value < h->min))
+        h->min = value;
+    if (value > h->max)
+        h->max = value;
+    h->sum += value;
+    h->num++;
+}
+
+vx_uint64 vxHistogramPercentile(vx_histogram_t *h, vx_uint32 permille)
+{
+    vx_uint64 rank, seen = 0;
+    vx_uint32 b;
+    if (h->num == 0)
+        return 0;
+    rank = (h->num * permille + 999) / 1000;
+    if (rank == 0)
+        rank = 1;
+    for (b = 0; b < VX_INT_HISTOGRAM_BUCKETS; b++)
+    {
+        seen += h->counts[b];
+        if (seen >= rank)
+        {
+            vx_uint64 limit = vxHistogramBucketLimit(b);
+            return (limit < h->max ? limit : h->max);
+        }
+    }
+    return h->max;
+}
+
+void vxComputePerfStats(vx_perf_stats_t *stats, vx_histogram_t *latency, vx_histogram_t *wait, vx_size bytes)
+{
+    memset(stats, 0, sizeof(vx_perf_stats_t));
+    stats->num = latency->num;
+    stats->min = latency->min;
+    stats->avg = (latency->num ? latency->sum / latency->num : 0);
+    stats->p50 = vxHistogramPercentile(latency, 500);
+    stats->p95 = vxHistogramPercentile(latency, 950);
+    stats->p99 = vxHistogramPercentile(latency, 990);
+    stats->max = latency->max;
+    if (wait)
+    {
+        stats->wait_num = wait->num;
+        stats->wait_avg = (wait->num ? wait->sum / wait->num : 0);
+        stats->wait_p99 = vxHistogramPercentile(wait, 990);
+        stats->wait_max = wait->max;
+    }
+    stats->bytes = bytes;
+}
+
 void vxPrintQueue(vx_queue_t *q)
 {
     vx_uint32 i;
@@ -498,6 +809,115 @@ void vxDeinitQueue(vx_queue_t *q)
     }
 }
 
+#if defined(WIN32) || defined(UNDER_CE)
+#define vxMemoryBarrier()                 MemoryBarrier()
+#define vxCompareAndSwap(ptr, old, val)   (InterlockedCompareExchangePointer((PVOID volatile *)(ptr), (PVOID)(val), (PVOID)(old)) == (PVOID)(old))
+#else
+#define vxMemoryBarrier()                 __sync_synchronize()
+#define vxCompareAndSwap(ptr, old, val)   __sync_bool_compare_and_swap((ptr), (old), (val))
+#endif
+
+vx_uint32 vxAtomicAdd(volatile vx_uint32 *ptr, vx_uint32 value)
+{
+#if defined(WIN32) || defined(UNDER_CE)
+    return (vx_uint32)InterlockedExchangeAdd((LONG volatile *)ptr, (LONG)value);
+#else
+    return __sync_fetch_and_add(ptr, value);
+#endif
+}
+
+/* The queue follows the bounded MPMC design of D. Vyukov: each slot carries a
+ * sequence number which tells a writer or reader at a given position whether
+ * the slot is ready for it, so the positions are claimed with a single
+ * compare-and-swap and no lock is ever held. */
+vx_bool vxCreateMPMCQueue(vx_mpmc_queue_t *q, vx_size depth)
+{
+    vx_size size = 1, i;
+    if (q == NULL || depth == 0)
+        return vx_false_e;
+    while (size < depth)
+        size <<= 1;
+    q->cells = (vx_mpmc_cell_t *)calloc(size, sizeof(vx_mpmc_cell_t));
+    if (q->cells == NULL)
+        return vx_false_e;
+    for (i = 0; i < size; i++)
+        q->cells[i].sequence = i;
+    q->mask = size - 1;
+    q->head = 0;
+    q->tail = 0;
+    vxMemoryBarrier();
+    return vx_true_e;
+}
+
+void vxDestroyMPMCQueue(vx_mpmc_queue_t *q)
+{
+    if (q)
+    {
+        free(q->cells);
+        q->cells = NULL;
+        q->mask = 0;
+    }
+}
+
+vx_bool vxTryWriteMPMCQueue(vx_mpmc_queue_t *q, vx_value_t v)
+{
+    vx_mpmc_cell_t *cell;
+    vx_size pos = q->head;
+    for (;;)
+    {
+        vx_size seq;
+        intptr_t dif;
+        cell = &q->cells[pos & q->mask];
+        seq = cell->sequence;
+        vxMemoryBarrier();
+        dif = (intptr_t)seq - (intptr_t)pos;
+        if (dif == 0)
+        {
+            if (vxCompareAndSwap(&q->head, pos, pos + 1))
+                break;
+        }
+        else if (dif < 0)
+        {
+            return vx_false_e; /* full */
+        }
+        pos = q->head;
+    }
+    cell->value = v;
+    vxMemoryBarrier();
+    cell->sequence = pos + 1;
+    return vx_true_e;
+}
+
+vx_bool vxTryReadMPMCQueue(vx_mpmc_queue_t *q, vx_value_t *pv)
+{
+    vx_mpmc_cell_t *cell;
+    vx_size pos = q->tail;
+    for (;;)
+    {
+        vx_size seq;
+        intptr_t dif;
+        cell = &q->cells[pos & q->mask];
+        seq = cell->sequence;
+        vxMemoryBarrier();
+        dif = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (dif == 0)
+        {
+            if (vxCompareAndSwap(&q->tail, pos, pos + 1))
+                break;
+        }
+        else if (dif < 0)
+        {
+            return vx_false_e; /* empty */
+        }
+        pos = q->tail;
+    }
+    if (pv)
+        *pv = cell->value;
+    vxMemoryBarrier();
+    cell->sequence = pos + q->mask + 1;
+    return vx_true_e;
+}
+
 vx_module_handle_t vxLoadModule(vx_char * name)
 {
     vx_module_handle_t mod;
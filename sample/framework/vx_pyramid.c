@@ -70,6 +70,7 @@ vx_pyramid vxCreatePyramid(vx_context c, vx_size levels, vx_float32 scale, vx_ui
         vxIncrementReference(&pyramid->base);
         vxAddReference(context, &pyramid->base);
         pyramid->numLevels = levels;
+        pyramid->scale = scale;
         pyramid->levels = (vx_image *)calloc(levels, sizeof(vx_image_t *));
         if (pyramid->levels)
         {
@@ -43,6 +43,8 @@ vx_bool vxAddReference(vx_context_t *context, vx_reference_t *ref)
 {
     vx_uint32 r;
     vx_bool ret = vx_false_e;
+    /* nodes may create references while executing on worker threads */
+    vxSemWait(&context->base.lock);
     for (r = 0; r < VX_INT_MAX_REF; r++)
     {
         if (context->reftable[r] == NULL)
@@ -53,6 +55,7 @@ vx_bool vxAddReference(vx_context_t *context, vx_reference_t *ref)
             break;
         }
     }
+    vxSemPost(&context->base.lock);
     return ret;
 }
 
@@ -143,16 +146,20 @@ vx_bool vxIsValidSpecificReference(vx_reference_t * ref, vx_enum type)
 vx_bool vxRemoveReference(vx_context_t *context, vx_reference_t *ref)
 {
     vx_uint32 r;
+    vx_bool ret = vx_false_e;
+    vxSemWait(&context->base.lock);
     for (r = 0; r < VX_INT_MAX_REF; r++)
     {
         if (context->reftable[r] == ref)
         {
             context->reftable[r] = NULL;
             context->numRefs--;
-            return vx_true_e;
+            ret = vx_true_e;
+            break;
         }
     }
-    return vx_false_e;
+    vxSemPost(&context->base.lock);
+    return ret;
 }
 
 void vxPrintReference(vx_reference_t *ref)
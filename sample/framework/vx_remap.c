@@ -45,6 +45,11 @@ vx_remap vxCreateRemap(vx_context c, vx_uint32 src_x, vx_uint32 src_y,
             remap->memory.dims[0][VX_DIM_C] = sizeof(vx_float32) * 2;
             remap->memory.dims[0][VX_DIM_X] = dst_x;
             remap->memory.dims[0][VX_DIM_Y] = dst_y;
+            if (vxAllocateMemory(context, &remap->memory) == vx_false_e)
+            {
+                VX_PRINT(VX_ZONE_ERROR, "Failed to allocate a %ux%u remap table\n", dst_x, dst_y);
+                vxReleaseRemap((vx_remap *)&remap);
+            }
         }
     }
     return (vx_remap)remap;
@@ -128,23 +133,26 @@ vx_status vxQueryRemap(vx_remap r, vx_enum attribute, void *ptr, vx_size size)
 vx_status vxSetRemapPoint(vx_remap r, vx_uint32 dst_x, vx_uint32 dst_y,
                                       vx_float32 src_x, vx_float32 src_y)
 {
-    vx_status status = VX_FAILURE;
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
     vx_remap_t *remap = (vx_remap_t *)r;
     if (vxIsValidSpecificReference(&remap->base, VX_TYPE_REMAP) == vx_true_e)
     {
-        vx_uint32 t_src_x = (src_x < 0.0f ? 0 : (vx_uint32)src_x);
-        vx_uint32 t_src_y = (src_y < 0.0f ? 0 : (vx_uint32)src_y);
-        if ((dst_x < remap->dst_x) &&
-            (dst_y < remap->dst_y) &&
-            (t_src_x < remap->src_x) &&
-            (t_src_y && remap->src_y))
+        /* the source may lie outside of the input, where the border applies */
+        if ((dst_x < remap->dst_x) && (dst_y < remap->dst_y))
         {
             vx_int32 offset = (dst_y * remap->memory.strides[0][VX_DIM_Y]) +
-                              (dst_x * remap->memory.strides[0][VX_DIM_X]) +
-                              (0 *     remap->memory.strides[0][VX_DIM_C]);
+                              (dst_x * remap->memory.strides[0][VX_DIM_X]);
             vx_float32 *coord = (vx_float32 *)&remap->memory.ptrs[0][offset];
+            vxSemWait(&remap->base.lock);
             coord[0] = src_x;
             coord[1] = src_y;
+            vxSemPost(&remap->base.lock);
+            vxWroteToReference(&remap->base);
+            status = VX_SUCCESS;
+        }
+        else
+        {
+            status = VX_ERROR_INVALID_PARAMETERS;
         }
     }
     else
@@ -154,22 +162,30 @@ vx_status vxSetRemapPoint(vx_remap r, vx_uint32 dst_x, vx_uint32 dst_y,
     return status;
 }
 
-vx_status vGetRemapPoint(vx_remap r, vx_uint32 dst_x, vx_uint32 dst_y,
-                                     vx_float32 *src_x, vx_float32 *src_y)
+vx_status vxGetRemapPoint(vx_remap r, vx_uint32 dst_x, vx_uint32 dst_y,
+                                      vx_float32 *src_x, vx_float32 *src_y)
 {
-    vx_status status = VX_FAILURE;
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
     vx_remap_t *remap = (vx_remap_t *)r;
     if (vxIsValidSpecificReference(&remap->base, VX_TYPE_REMAP) == vx_true_e)
     {
         if ((dst_x < remap->dst_x) &&
-            (dst_y < remap->dst_y))
+            (dst_y < remap->dst_y) &&
+            (src_x) && (src_y))
         {
             vx_int32 offset = (dst_y * remap->memory.strides[0][VX_DIM_Y]) +
-                              (dst_x * remap->memory.strides[0][VX_DIM_X]) +
-                              (0 *     remap->memory.strides[0][VX_DIM_C]);
+                              (dst_x * remap->memory.strides[0][VX_DIM_X]);
             vx_float32 *coord = (vx_float32 *)&remap->memory.ptrs[0][offset];
+            vxSemWait(&remap->base.lock);
             *src_x = coord[0];
             *src_y = coord[1];
+            vxSemPost(&remap->base.lock);
+            vxReadFromReference(&remap->base);
+            status = VX_SUCCESS;
+        }
+        else
+        {
+            status = VX_ERROR_INVALID_PARAMETERS;
         }
     }
     else
@@ -179,3 +195,117 @@ vx_status vGetRemapPoint(vx_remap r, vx_uint32 dst_x, vx_uint32 dst_y,
     return status;
 }
 
+vx_status vxAccessRemapPatch(vx_remap r, vx_rectangle rect, vx_imagepatch_addressing_t *addr, void **ptr)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    vx_remap_t *remap = (vx_remap_t *)r;
+    vx_uint32 start_x = 0u, start_y = 0u, end_x = 0u, end_y = 0u, y;
+
+    if ((vxIsValidSpecificReference(&remap->base, VX_TYPE_REMAP) == vx_true_e) &&
+        (rect) &&
+        (vxIsValidSpecificReference((vx_reference_t *)rect, VX_TYPE_RECTANGLE) == vx_true_e))
+    {
+        vxAccessRectangleCoordinates(rect, &start_x, &start_y, &end_x, &end_y);
+        if ((start_x >= end_x) || (end_x > remap->dst_x) ||
+            (start_y >= end_y) || (end_y > remap->dst_y) ||
+            (addr == NULL) || (ptr == NULL))
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Invalid patch {%u,%u}-{%u,%u} of a %ux%u remap\n",
+                     start_x, start_y, end_x, end_y, remap->dst_x, remap->dst_y);
+            status = VX_ERROR_INVALID_PARAMETERS;
+        }
+        else
+        {
+            vx_int32 offset = (start_y * remap->memory.strides[0][VX_DIM_Y]) +
+                              (start_x * remap->memory.strides[0][VX_DIM_X]);
+            memset(addr, 0, sizeof(*addr));
+            addr->dim_x = end_x - start_x;
+            addr->dim_y = end_y - start_y;
+            addr->stride_x = remap->memory.strides[0][VX_DIM_X];
+            addr->scale_x = VX_SCALE_UNITY;
+            addr->scale_y = VX_SCALE_UNITY;
+            addr->step_x = 1;
+            addr->step_y = 1;
+            vxSemWait(&remap->base.lock);
+            if (*ptr == NULL)
+            {
+                /* a map of the table itself */
+                addr->stride_y = remap->memory.strides[0][VX_DIM_Y];
+                *ptr = &remap->memory.ptrs[0][offset];
+            }
+            else
+            {
+                /* a copy into the packed rows of the caller */
+                vx_uint8 *tmp = (vx_uint8 *)*ptr;
+                addr->stride_y = addr->dim_x * addr->stride_x;
+                for (y = 0; y < addr->dim_y; y++)
+                    memcpy(&tmp[y * addr->stride_y],
+                           &remap->memory.ptrs[0][offset + y * remap->memory.strides[0][VX_DIM_Y]],
+                           addr->stride_y);
+            }
+            vxSemPost(&remap->base.lock);
+            vxReadFromReference(&remap->base);
+            vxIncrementReference(&remap->base);
+            status = VX_SUCCESS;
+        }
+    }
+    else
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Not a valid object!\n");
+    }
+    return status;
+}
+
+vx_status vxCommitRemapPatch(vx_remap r, vx_rectangle rect, vx_imagepatch_addressing_t *addr, void *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    vx_remap_t *remap = (vx_remap_t *)r;
+    vx_uint32 start_x = 0u, start_y = 0u, end_x = 0u, end_y = 0u, y;
+
+    if (vxIsValidSpecificReference(&remap->base, VX_TYPE_REMAP) == vx_true_e)
+    {
+        /* without a rectangle nothing was written */
+        vxAccessRectangleCoordinates(rect, &start_x, &start_y, &end_x, &end_y);
+        if ((end_x == 0) || (end_y == 0))
+        {
+            vxDecrementReference(&remap->base);
+            status = VX_SUCCESS;
+        }
+        else if ((start_x >= end_x) || (end_x > remap->dst_x) ||
+                 (start_y >= end_y) || (end_y > remap->dst_y) ||
+                 (addr == NULL) || (ptr == NULL) ||
+                 ((end_x - start_x) > addr->dim_x) || ((end_y - start_y) > addr->dim_y))
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Invalid patch {%u,%u}-{%u,%u} of a %ux%u remap\n",
+                     start_x, start_y, end_x, end_y, remap->dst_x, remap->dst_y);
+            /* the patch was still accessed, so its reference is dropped */
+            vxDecrementReference(&remap->base);
+            status = VX_ERROR_INVALID_PARAMETERS;
+        }
+        else
+        {
+            vx_uint8 *beg_ptr = remap->memory.ptrs[0];
+            vx_uint8 *end_ptr = &beg_ptr[remap->memory.strides[0][VX_DIM_Y] * remap->dst_y];
+            vx_int32 offset = (start_y * remap->memory.strides[0][VX_DIM_Y]) +
+                              (start_x * remap->memory.strides[0][VX_DIM_X]);
+            vx_size len = (end_x - start_x) * remap->memory.strides[0][VX_DIM_X];
+            vxSemWait(&remap->base.lock);
+            /* a map was written in place, a copy is copied back */
+            if (!((beg_ptr <= (vx_uint8 *)ptr) && ((vx_uint8 *)ptr < end_ptr)))
+            {
+                for (y = 0; y < end_y - start_y; y++)
+                    memcpy(&beg_ptr[offset + y * remap->memory.strides[0][VX_DIM_Y]],
+                           &((vx_uint8 *)ptr)[y * addr->stride_y], len);
+            }
+            vxSemPost(&remap->base.lock);
+            vxWroteToReference(&remap->base);
+            vxDecrementReference(&remap->base);
+            status = VX_SUCCESS;
+        }
+    }
+    else
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Not a valid object!\n");
+    }
+    return status;
+}
@@ -74,6 +74,9 @@ void vxPrintScalarValue(vx_scalar_t *scalar)
         case VX_TYPE_SIZE:
             VX_PRINT(VX_ZONE_SCALAR, "scalar "VX_FMT_REF" = %zu\n", scalar, scalar->data.size);
             break;
+        case VX_TYPE_BOOL:
+            VX_PRINT(VX_ZONE_SCALAR, "scalar "VX_FMT_REF" = %s\n", scalar, scalar->data.boolean ? "true" : "false");
+            break;
         default:
             VX_PRINT(VX_ZONE_ERROR, "some case is not covered!\n");
             break;
@@ -204,6 +207,9 @@ vx_status vxAccessScalarValue(vx_scalar s, void *ptr)
         case VX_TYPE_SIZE:
             *(vx_size *)ptr = scalar->data.size;
             break;
+        case VX_TYPE_BOOL:
+            *(vx_bool *)ptr = scalar->data.boolean;
+            break;
         default:
             VX_PRINT(VX_ZONE_ERROR, "some case is not covered in %s\n", __FUNCTION__);
             status = VX_ERROR_NOT_SUPPORTED;
@@ -275,6 +281,9 @@ vx_status vxCommitScalarValue(vx_scalar s, void *ptr)
         case VX_TYPE_SIZE:
             scalar->data.size = *(vx_size *)ptr;
             break;
+        case VX_TYPE_BOOL:
+            scalar->data.boolean = *(vx_bool *)ptr;
+            break;
         default:
             VX_PRINT(VX_ZONE_ERROR, "some case is not covered in %s\n", __FUNCTION__);
             status = VX_ERROR_NOT_SUPPORTED;
@@ -86,13 +86,14 @@ vx_status vxLoadTarget(vx_context_t *context, vx_char *name)
             context->targets[index].funcs.verify   = (vx_target_verify_f)  vxGetSymbol(context->targets[index].module.handle, "vxTargetVerify");
             context->targets[index].funcs.addkernel= (vx_target_addkernel_f)vxGetSymbol(context->targets[index].module.handle, "vxTargetAddKernel");
             context->targets[index].funcs.addtilingkernel = (vx_target_addtilingkernel_f)vxGetSymbol(context->targets[index].module.handle, "vxTargetAddTilingKernel");
+            context->targets[index].funcs.fuse     = (vx_target_fuse_f)    vxGetSymbol(context->targets[index].module.handle, "vxTargetFuse");
             if (context->targets[index].funcs.init &&
                 context->targets[index].funcs.deinit &&
                 context->targets[index].funcs.supports &&
                 context->targets[index].funcs.process &&
                 context->targets[index].funcs.verify &&
                 context->targets[index].funcs.addkernel)
-                /* tiling kernel function can be NULL */
+                /* tiling kernel and fuse functions can be NULL */
             {
                 VX_PRINT(VX_ZONE_TARGET, "Loaded target %s\n", module);
                 status = VX_SUCCESS;
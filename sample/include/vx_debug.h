@@ -92,6 +92,26 @@ enum vx_debug_zone_e {
  */
 #define VX_KERNEL_RETURN(status) VX_PRINT(VX_ZONE_API, "returning %d\n", status);
 
+/*! \brief Captures the begin time of a traced interval, or zero when tracing is disabled.
+ * \ingroup group_int_debug
+ */
+#define VX_TRACE_BEGIN() ((vx_trace_enabled == vx_true_e) ? vxCaptureTime() : 0ull)
+
+/*! \brief Records the interval from a \ref VX_TRACE_BEGIN time until now.
+ * \ingroup group_int_debug
+ */
+#define VX_TRACE_END(cat, name, ref, index, beg) do { if (beg) vx_trace_complete(cat, name, ref, index, beg, vxCaptureTime()); } while (0)
+
+/*! \brief Records an interval which has already been timed.
+ * \ingroup group_int_debug
+ */
+#define VX_TRACE_INTERVAL(cat, name, ref, index, beg, end) do { if (vx_trace_enabled == vx_true_e) vx_trace_complete(cat, name, ref, index, beg, end); } while (0)
+
+/*! \brief Records the begin ('b') or end ('e') of an interval which may span threads.
+ * \ingroup group_int_debug
+ */
+#define VX_TRACE_ASYNC(phase, cat, name, ref) do { if (vx_trace_enabled == vx_true_e) vx_trace_async(phase, cat, name, ref); } while (0)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -127,6 +147,52 @@ vx_bool vx_get_debug_zone(vx_enum zone);
  */
 void vx_set_debug_zone_from_env(void);
 
+/*! \brief Set while trace events are recorded. Only test it through the
+ * \ref VX_TRACE_BEGIN family of macros.
+ * \ingroup group_int_debug
+ */
+extern volatile vx_bool vx_trace_enabled;
+
+/*! \brief Starts recording trace events, which are written to the file as
+ * Chrome trace JSON when the trace is stopped. A running trace is stopped first.
+ * \param [in] path The file to write.
+ * \ingroup group_int_debug
+ */
+vx_bool vx_start_trace(const vx_char *path);
+
+/*! \brief Stops recording and writes the trace file. No graph may be executing.
+ * \ingroup group_int_debug
+ */
+void vx_stop_trace(void);
+
+/*! \brief Returns the file of the running trace, or an empty string.
+ * \ingroup group_int_debug
+ */
+const vx_char *vx_get_trace_file(void);
+
+/*! \brief Starts a trace if the VX_TRACE_FILE environment variable names a file.
+ * \ingroup group_int_debug
+ */
+void vx_set_trace_from_env(void);
+
+/*! \brief Records an interval on the calling thread.
+ * \param [in] cat The category, a string which outlives the trace.
+ * \param [in] name The name, a string which outlives the trace.
+ * \param [in] ref The object the interval belongs to, or NULL.
+ * \param [in] index The tile or band within the object, or -1.
+ * \param [in] beg The time the interval began.
+ * \param [in] end The time the interval ended.
+ * \ingroup group_int_debug
+ */
+void vx_trace_complete(const vx_char *cat, const vx_char *name, const void *ref, vx_int32 index, vx_uint64 beg, vx_uint64 end);
+
+/*! \brief Records the begin or end of an interval identified by an object, so
+ * that it may begin on one thread and end on another.
+ * \param [in] phase 'b' at the begin or 'e' at the end.
+ * \ingroup group_int_debug
+ */
+void vx_trace_async(vx_char phase, const vx_char *cat, const vx_char *name, const void *ref);
+
 #ifdef __cplusplus
 }
 #endif
@@ -74,36 +74,6 @@ void vxClearExecution(vx_graph_t *graph);
  * \ingroup group_int_graph
  */
 vx_status vxExecuteNode(vx_graph_t *graph, vx_uint32 index);
-/*!
- * \brief Recursively traverses the graph looking for cycles against the original
- * node.
- * \param [in] graph The graph to traverse.
- * \param [in] parentIndex Originating Node (to check against cycles). We starting
- * from a head node, pass VX_INT_MAX_REF.
- * \param [in] childIndex Subsequent Linked Node Index.
- * \ingroup group_int_graph
- */
-vx_status vxTraverseGraph(vx_graph_t *graph,
-                          vx_uint32 parentIndex,
-                          vx_uint32 childIndex);
-
-/*! \brief Given a set of last nodes, this function will determine the next
- * set of nodes which are capable of being run. Nodes which are encountered but
- * can't be run will be placed in the left nodes list.
- * \param [in] graph The graph structure.
- * \param [in] last_nodes The last list of nodes executed.
- * \param [in] numLast The number of nodes in the last_nodes list which are valid.
- * \param [out] next_nodes The list of nodes next to be executed.
- * \param [in] numNext The number of nodes in the next_nodes list which are valid.
- * \param [out] left_nodes The list of nodes which are next, but can't be executed.
- * \param [in] numLeft The number of nodes in the left_nodes list which are valid.
- * \ingroup group_int_graph
- */
-void vxFindNextNodes(vx_graph_t *graph,
-                      vx_uint32 last_nodes[VX_INT_MAX_REF], vx_uint32 numLast,
-                      vx_uint32 next_nodes[VX_INT_MAX_REF], vx_uint32 *numNext,
-                      vx_uint32 left_nodes[VX_INT_MAX_REF], vx_uint32 *numLeft);
-
 /*! \brief This function finds all graph which contain input or bidirectional
  * access to the reference and marks them as unverified.
  * \param [in] ref The reference structure.
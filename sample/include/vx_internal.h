@@ -137,6 +137,56 @@
  */
 #define VX_INT_FOREVER          (0xFFFFFFFF)
 
+/*! \brief Maximum number of worker threads in the context thread pool.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_WORKERS      (64)
+
+/*! \brief Maximum number of nodes executed together as one fused pass.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_FUSED        (8)
+
+/*! \brief Maximum number of threads which execute scheduled graphs.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_EXECUTORS    (16)
+
+/*! \brief The default number of threads which execute scheduled graphs.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_DEFAULT_EXECUTORS (4)
+
+/*! \brief The default number of graphs which may be scheduled and not yet waited upon.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_DEFAULT_GRAPH_QUEUE_DEPTH (64)
+
+/*! \brief Maximum number of graphs which may be scheduled and not yet waited upon.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_GRAPH_QUEUE_DEPTH (4096)
+
+/*! \brief Maximum number of frames of one graph which may execute concurrently.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_PIPELINE_DEPTH (4)
+
+/*! \brief Maximum number of events recorded by one trace, later events are dropped.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_TRACE_EVENTS (65536)
+
+/*! \brief The number of histogram buckets per power of two, as a shift.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_HISTOGRAM_SUB_BITS (3)
+
+/*! \brief The number of buckets of a \ref vx_histogram_t, covering 64 bit values.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_HISTOGRAM_BUCKETS  (64 << VX_INT_HISTOGRAM_SUB_BITS)
+
 /*! \brief The minimum khronos number of targets.
  * \ingroup group_int_defines
  */
@@ -320,14 +370,113 @@ typedef struct _vx_queue_t {
     vx_bool popped;
 } vx_queue_t;
 
+/*! \brief A log-linear histogram of durations. Each power of two is split
+ * into 1 << \ref VX_INT_HISTOGRAM_SUB_BITS buckets, so a percentile read back
+ * from it is within 1/8th of the true value.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_histogram_t {
+    /*! \brief The number of values in each bucket. */
+    vx_uint32 counts[VX_INT_HISTOGRAM_BUCKETS];
+    /*! \brief The number of values. */
+    vx_uint64 num;
+    /*! \brief The sum of the values. */
+    vx_uint64 sum;
+    /*! \brief The smallest value. */
+    vx_uint64 min;
+    /*! \brief The largest value. */
+    vx_uint64 max;
+} vx_histogram_t;
+
+/*! \brief A slot of a \ref vx_mpmc_queue_t.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_mpmc_cell_t {
+    /*! \brief The position at which this slot may next be written (when equal
+     * to the position) or read (when one past the position). */
+    volatile vx_size sequence;
+    /*! \brief The stored value. */
+    vx_value_t       value;
+} vx_mpmc_cell_t;
+
+/*! \brief A bounded, lock-free queue of values which any number of threads may
+ * write and read concurrently. Writes to a full queue and reads from an empty
+ * queue fail immediately instead of blocking.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_mpmc_queue_t {
+    /*! \brief The ring of slots, a power of two in length. */
+    vx_mpmc_cell_t  *cells;
+    /*! \brief The number of slots minus one. */
+    vx_size          mask;
+    /*! \brief Keeps the write and read positions on separate cache lines. */
+    vx_uint8         pad0[64];
+    /*! \brief The next position to write. */
+    volatile vx_size head;
+    /*! \brief Keeps the write and read positions on separate cache lines. */
+    vx_uint8         pad1[64];
+    /*! \brief The next position to read. */
+    volatile vx_size tail;
+} vx_mpmc_queue_t;
+
+/*! \brief A unit of work function for the thread pool.
+ * \ingroup group_int_osal
+ */
+typedef void (*vx_work_f)(void *arg);
+
+/*! \brief A unit of work for the thread pool. The storage is owned by the
+ * submitter and must remain valid until the work function has been called.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_work_t {
+    /*! \brief The next work item in the pool's queue. */
+    struct _vx_work_t *next;
+    /*! \brief The function to call. */
+    vx_work_f          function;
+    /*! \brief The argument to the function. */
+    void              *arg;
+} vx_work_t;
+
+/*! \brief A pool of worker threads which execute \ref vx_work_t items in FIFO order.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_threadpool_t {
+    /*! \brief The worker threads. */
+    vx_thread_t        workers[VX_INT_MAX_WORKERS];
+    /*! \brief The number of worker threads. */
+    vx_uint32          numWorkers;
+    /*! \brief The oldest queued work item. */
+    vx_work_t         *head;
+    /*! \brief The newest queued work item. */
+    vx_work_t         *tail;
+    /*! \brief Protects the queue of work items. */
+    vx_sem_t           lock;
+    /*! \brief Counts the number of queued work items. */
+    vx_sem_t           count;
+    /*! \brief Wakes the threads sleeping in \ref vxWaitWork. */
+    vx_sem_t           wake;
+    /*! \brief The number of threads sleeping in \ref vxWaitWork, protected by the lock. */
+    vx_uint32          numWaiting;
+    /*! \brief Indicates that the workers should keep running. */
+    vx_bool            running;
+} vx_threadpool_t;
+
 /*! \brief The processor structure which contains the graph queue.
  * \ingroup group_int_context
  */
 typedef struct _vx_processor_t {
-    vx_queue_t input;
-    vx_queue_t output;
-    vx_thread_t thread;
-    vx_bool running;
+    /*! \brief The scheduled graphs which have not yet started. */
+    vx_mpmc_queue_t input;
+    /*! \brief Counts the graphs in \ref vx_processor_t::input, the executors sleep on it. */
+    vx_sem_t        count;
+    /*! \brief The threads which execute scheduled graphs. */
+    vx_thread_t     threads[VX_INT_MAX_EXECUTORS];
+    /*! \brief The number of executor threads. */
+    vx_uint32       numThreads;
+    /*! \brief Indicates that the executors should keep running. */
+    vx_bool         running;
+    /*! \brief The number of scheduled graphs which have not yet finished. */
+    volatile vx_uint32 numScheduled;
 } vx_processor_t;
 
 /*! \brief A log entry contains the graph reference, a status and a message.
@@ -446,6 +595,8 @@ typedef struct _vx_scalar_t {
         vx_enum    enm;
         /*! \brief Architecture depth unsigned value */
         vx_size    size;
+        /*! \brief A boolean */
+        vx_bool    boolean;
     } data;
 } vx_scalar_t;
 
@@ -496,8 +647,10 @@ typedef struct _vx_kernel_attr_t {
     vx_neighborhood_size_t nhbdinfo;
     /*! \brief The tile memory size. */
     vx_size       tileDataSize;
-    /*! \brief The tile memory pointer */
+    /*! \brief The tile memory pointer, one buffer of tileDataSize for each concurrent tile. */
     vx_ptr_t      tileDataPtr;
+    /*! \brief The number of tile memory buffers. */
+    vx_uint32     tileDataCount;
 #endif
 } vx_kernel_attr_t;
 
@@ -578,6 +731,16 @@ typedef vx_action (*vx_target_process_f)(struct _vx_target_t *target, struct _vx
  */
 typedef vx_status (*vx_target_verify_f)(struct _vx_target_t *target, struct _vx_node_t *node);
 
+/*! \brief Asks a target whether it can execute a group of nodes as a single
+ * pass, in which the images written by all but the last node are never stored.
+ * \param [in] target The pointer to the target context.
+ * \param [in] nodes The nodes of the group, in execution order.
+ * \param [in] numNodes The number of nodes in the group.
+ * \note The target interface function is optional and must be exported as "vxTargetFuse"
+ * \ingroup group_int_target
+ */
+typedef vx_status (*vx_target_fuse_f)(struct _vx_target_t *target, struct _vx_node_t *nodes[], vx_size numNodes);
+
 /*! \brief Adds a kernel to a target.
  * \param [in] target The target object.
  * \param [in] name
@@ -629,6 +792,8 @@ typedef struct _vx_target_funcs_t {
     vx_target_addkernel_f addkernel;
     /*! \brief Target function to add a tiling kernel */
     vx_target_addtilingkernel_f addtilingkernel;
+    /*! \brief Target function to accept fused node groups */
+    vx_target_fuse_f     fuse;
 } vx_target_funcs_t;
 
 /*! \brief The priority list of targets.
@@ -639,6 +804,8 @@ enum vx_target_priority_e {
     /*! \brief Defines the priority of the OpenCL Target */
     VX_TARGET_PRIORITY_OPENCL,
 #endif
+    /*! \brief Defines the priority of the SIMD target */
+    VX_TARGET_PRIORITY_SIMD,
     /*! \brief Defines the priority of the C model target */
     VX_TARGET_PRIORITY_C_MODEL,
     /*! \brief Defines the maximum priority */
@@ -697,6 +864,10 @@ typedef struct _vx_context_t {
     vx_uint32           numMods;
     /*! \brief The graph queue processor */
     vx_processor_t      proc;
+    /*! \brief The pool of workers which execute graph nodes */
+    vx_threadpool_t     pool;
+    /*! \brief The number of graph executions and pipelined frames in progress */
+    volatile vx_uint32  numExecuting;
     /*! \brief The combined number of unique kernels in the system */
     vx_uint32           numKernels;
     /*! \brief The number of available targets in the implementation */
@@ -738,8 +909,54 @@ typedef struct _vx_node_t {
     vx_uint32           affinity;
     /*! \brief The child graph of the node. */
     struct _vx_graph_t *child;
+    /*! \brief The index of this node in the graph's node list. */
+    vx_uint32           index;
+    /*! \brief The work item used to dispatch this node to the context's thread pool. */
+    vx_work_t           work;
+    /*! \brief The node which executes this node as part of its fused pass, if any. */
+    struct _vx_node_t  *fusedInto;
+    /*! \brief The nodes executed by this node in a single pass, ending with itself. */
+    struct _vx_node_t  *fused[VX_INT_MAX_FUSED];
+    /*! \brief The number of nodes in \ref vx_node_t::fused, zero when not fused. */
+    vx_uint32           numFused;
+    /*! \brief The sequence number of the frame this node is executing in a pipelined graph. */
+    vx_uint32           frame;
+    /*! \brief The number of frames of a pipelined graph this node has finished. */
+    vx_uint32           framesDone;
+    /*! \brief Indicates that this node has been dispatched for a frame and has not finished it. */
+    vx_bool             busy;
+    /*! \brief The execution times of the node. */
+    vx_histogram_t      latency;
+    /*! \brief The times between the node becoming ready and a worker starting it. */
+    vx_histogram_t      wait;
+    /*! \brief The time at which the node was last dispatched. */
+    vx_uint64           readyTime;
+    /*! \brief The bytes of data objects read and written by one execution. */
+    vx_size             bytes;
 } vx_node_t;
 
+/*! \brief The execution state of one in-flight frame of a pipelined graph.
+ * \ingroup group_int_graph
+ */
+typedef struct _vx_frame_t {
+    /*! \brief The parameters each node uses for this frame, \ref VX_INT_MAX_PARAMS per node. */
+    vx_reference_t    **params;
+    /*! \brief This frame's copies of \ref vx_graph_t::virtuals. The first frame slot uses the originals. */
+    struct _vx_image_t **clones;
+    /*! \brief The graph parameter values held until the frame has been waited upon. */
+    vx_reference_t     *held[VX_INT_MAX_PARAMS];
+    /*! \brief The number of unfinished predecessors of each node. */
+    vx_uint32          *pending;
+    /*! \brief The number of nodes which have not finished this frame. */
+    vx_uint32           remaining;
+    /*! \brief The first non-continue action returned by a node of this frame. */
+    vx_action           action;
+    /*! \brief Signalled when every node has finished this frame. */
+    vx_event_t          done;
+    /*! \brief The time at which the frame was scheduled. */
+    vx_uint64           startTime;
+} vx_frame_t;
+
 /*! \brief The internal representation of a graph.
  * \ingroup group_int_graph
  */
@@ -771,6 +988,64 @@ typedef struct _vx_graph_t {
     } parameters[VX_INT_MAX_PARAMS];
     /*! \brief The number of graph parameters. */
     vx_uint32	   numParams;
+    /*! \brief The offset of each node's successors in \ref vx_graph_t::edges, numNodes + 1 entries. */
+    vx_uint32      edgeStart[VX_INT_MAX_REF + 1];
+    /*! \brief The successor node indexes of all nodes, grouped by node (computed at verification). */
+    vx_uint32     *edges;
+    /*! \brief The number of entries in \ref vx_graph_t::edges. */
+    vx_uint32      numEdges;
+    /*! \brief The number of predecessors of each node. */
+    vx_uint32      indegree[VX_INT_MAX_REF];
+    /*! \brief The node indexes in a topological order (computed at verification). */
+    vx_uint32      schedule[VX_INT_MAX_REF];
+    /*! \brief The memory shared by the virtual images of the graph. */
+    vx_uint8      *arena;
+    /*! \brief The size of \ref vx_graph_t::arena in bytes. */
+    vx_size        arenaSize;
+    /*! \brief The virtual images which are backed by \ref vx_graph_t::arena. */
+    struct _vx_image_t *aliases[VX_INT_MAX_REF];
+    /*! \brief The number of entries in \ref vx_graph_t::aliases. */
+    vx_uint32      numAliases;
+    /*! \brief The number of unfinished predecessors of each node during execution. */
+    vx_uint32      pending[VX_INT_MAX_REF];
+    /*! \brief The number of dispatched nodes which have not yet completed. */
+    vx_uint32      inflight;
+    /*! \brief The first non-continue action returned by a node during execution. */
+    vx_action      action;
+    /*! \brief Protects the execution state of the graph. */
+    vx_sem_t       execlock;
+    /*! \brief Signalled when the last dispatched node of an execution completes. */
+    vx_event_t     complete;
+    /*! \brief Signalled when a scheduled execution of the graph has finished. */
+    vx_event_t     finished;
+    /*! \brief The status of the last scheduled execution of the graph. */
+    vx_status      scheduledStatus;
+    /*! \brief The number of frames which may execute concurrently, see \ref VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH. */
+    vx_uint32      pipelineDepth;
+    /*! \brief The frames of a pipelined graph, indexed by sequence number modulo \ref vx_graph_t::pipelineDepth. */
+    vx_frame_t     frames[VX_INT_MAX_PIPELINE_DEPTH];
+    /*! \brief The sequence number of the oldest frame which has not been waited upon. */
+    vx_uint32      firstFrame;
+    /*! \brief The sequence number of the next frame to be scheduled. */
+    vx_uint32      nextFrame;
+    /*! \brief The node parameters outside of any frame, restored once every frame has been waited upon. */
+    vx_reference_t **bindings;
+    /*! \brief The graph parameter values set while the graph is pipelined, used by each scheduled frame. */
+    vx_reference_t *staged[VX_INT_MAX_PARAMS];
+    /*! \brief The virtual images which each frame replaces with its own copy. */
+    struct _vx_image_t **virtuals;
+    /*! \brief The number of entries in \ref vx_graph_t::virtuals. */
+    vx_uint32      numVirtuals;
+    /*! \brief The offset of each node's entries in \ref vx_graph_t::hazards, numNodes + 1 entries. */
+    vx_uint32     *hazardStart;
+    /*! \brief The nodes which read a shared output of a node, and so must finish a frame before that node starts the next. */
+    vx_uint32     *hazards;
+    /*! \brief The offset of each node's entries in \ref vx_graph_t::gates, numNodes + 1 entries. */
+    vx_uint32     *gateStart;
+    /*! \brief The writers held back by each node, the inverse of \ref vx_graph_t::hazards. */
+    vx_uint32     *gates;
+    /*! \brief The end-to-end execution times of the graph. */
+    vx_histogram_t latency;
 } vx_graph_t;
 
 /*! \brief The dimensions enumeration, also stride enumerations.
@@ -853,6 +1128,8 @@ typedef struct _vx_image_t {
     } region;
     /*! \brief The import type */
     vx_enum        import;
+    /*! \brief Indicates if the image is virtual, in which case a graph may back it with shared memory. */
+    vx_bool        isVirtual;
 } vx_image_t;
 
 /*! \brief The internal representation of a \ref vx_buffer
@@ -44,6 +44,25 @@ vx_bool vxIsValidList(vx_list_t *list);
 
 void vxReleaseListInt(vx_list_t *list);
 
+/*! \brief Replaces the contents of a list of keypoints with an array of keypoints.
+ * \details The keypoints already in the list are rewritten in place when the
+ * list is their only holder, so that a kernel which refills the same list on
+ * every execution does not create a new reference per point.
+ * \param [in] list The list of \ref VX_TYPE_KEYPOINT.
+ * \param [in] points The keypoints, in the order the list should hold them.
+ * \param [in] count The number of points.
+ * \ingroup group_int_list
+ */
+vx_status vxSetListKeypoints(vx_list list, const vx_keypoint_t *points, vx_size count);
+
+/*! \brief Copies the keypoints of a list into an array, in the order of the list.
+ * \param [in] list The list of \ref VX_TYPE_KEYPOINT.
+ * \param [out] points The array which receives the keypoints.
+ * \param [in,out] count The capacity of the array in, the number of points copied out.
+ * \ingroup group_int_list
+ */
+vx_status vxGetListKeypoints(vx_list list, vx_keypoint_t *points, vx_size *count);
+
 #ifdef __cplusplus
 }
 #endif
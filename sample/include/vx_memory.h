@@ -41,6 +41,12 @@ extern "C" {
  */
 vx_bool vxFreeMemory(vx_context_t *context, vx_memory_t *memory);
 
+/*! \brief Computes the strides of a plane of a memory block and returns the
+ * size of the plane in bytes.
+ * \ingroup group_int_memory
+ */
+vx_size vxComputeMemorySize(vx_memory_t *memory, vx_int32 p);
+
 /*! \brief Allocates a memory block.
  * \ingroup group_int_memory
  */
@@ -72,6 +72,31 @@ vx_status vxSetChildGraphOfNode(vx_node n, vx_graph g);
  */
 vx_graph vxGetChildGraphOfNode(vx_node n);
 
+/*! \brief Processes the rows [y0, y1) of band number index.
+ * \ingroup group_int_node
+ */
+typedef void (*vx_band_f)(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1);
+
+/*! \brief The most bands an image is split into, one per pool worker and the caller.
+ * \ingroup group_int_node
+ */
+#define VX_MAX_BANDS (VX_INT_MAX_WORKERS + 1)
+
+/*! \brief Returns how many bands of rows a kernel should split an image into,
+ * from 1 to \ref VX_MAX_BANDS, so that each is large enough to be worth a thread.
+ * \param [in] node The node running the kernel.
+ * \ingroup group_int_node
+ */
+vx_uint32 vxBandCount(vx_node node, vx_uint32 width, vx_uint32 height);
+
+/*! \brief Runs a function on count bands of equal height, in parallel on the
+ * pool of the context of the node. Band i covers the rows from i * height / count
+ * up to (i + 1) * height / count, and this returns after every band is done.
+ * \param [in] node The node running the kernel.
+ * \ingroup group_int_node
+ */
+void vxRunBands(vx_node node, vx_uint32 count, vx_uint32 height, vx_band_f band, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,6 +78,63 @@ vx_thread_t vxCreateThread(vx_thread_f func, void *arg);
  */
 void vxSleepThread(vx_uint32 milliseconds);
 
+/*! \brief Returns the number of online processors, at least 1.
+ * \ingroup group_int_osal
+ */
+vx_uint32 vxGetProcessorCount();
+
+/*! \brief Returns an identifier of the calling thread, as the operating system reports it.
+ * \ingroup group_int_osal
+ */
+vx_uint32 vxGetThreadId();
+
+/*! \brief Atomically adds a value to a counter.
+ * \return The value of the counter before the addition.
+ * \ingroup group_int_osal
+ */
+vx_uint32 vxAtomicAdd(volatile vx_uint32 *ptr, vx_uint32 value);
+
+/*! \brief Creates a thread pool with the given number of workers. A pool with
+ * no workers is valid, its work is then only run by \ref vxTryRunWork.
+ * \ingroup group_int_osal
+ */
+vx_bool vxCreateThreadpool(vx_threadpool_t *pool, vx_uint32 numWorkers);
+
+/*! \brief Stops and joins all workers of an idle thread pool.
+ * \ingroup group_int_osal
+ */
+void vxDestroyThreadpool(vx_threadpool_t *pool);
+
+/*! \brief Changes the number of workers of an idle thread pool, which keeps
+ * its queue if the new workers can not all be created.
+ * \return vx_true_e if every requested worker was created.
+ * \ingroup group_int_osal
+ */
+vx_bool vxResizeThreadpool(vx_threadpool_t *pool, vx_uint32 numWorkers);
+
+/*! \brief Queues a work item on the pool.
+ * \ingroup group_int_osal
+ */
+void vxSubmitWork(vx_threadpool_t *pool, vx_work_t *work);
+
+/*! \brief Runs one queued work item on the calling thread, if there is one.
+ * \return vx_true_e if an item was run.
+ * \ingroup group_int_osal
+ */
+vx_bool vxTryRunWork(vx_threadpool_t *pool);
+
+/*! \brief Runs queued work on the calling thread until the event is set,
+ * sleeping while there is none. Whoever sets the event must then call
+ * \ref vxWakeWaiters.
+ * \ingroup group_int_osal
+ */
+void vxWaitWork(vx_threadpool_t *pool, vx_event_t *done);
+
+/*! \brief Wakes the threads sleeping in \ref vxWaitWork so they check their events.
+ * \ingroup group_int_osal
+ */
+void vxWakeWaiters(vx_threadpool_t *pool);
+
 /*! \brief
  * \ingroup group_int_osal
  */
@@ -103,6 +160,27 @@ void vxStopCapture(vx_perf_t *perf);
  */
 void vxInitPerf(vx_perf_t *perf);
 
+/*! \brief Empties a histogram.
+ * \ingroup group_int_osal
+ */
+void vxInitHistogram(vx_histogram_t *h);
+
+/*! \brief Adds a value to a histogram. Not thread safe.
+ * \ingroup group_int_osal
+ */
+void vxAddToHistogram(vx_histogram_t *h, vx_uint64 value);
+
+/*! \brief Returns the value below which the given permille of the histogram lies.
+ * \ingroup group_int_osal
+ */
+vx_uint64 vxHistogramPercentile(vx_histogram_t *h, vx_uint32 permille);
+
+/*! \brief Summarizes latency and queue wait histograms into a \ref vx_perf_stats_t.
+ * \param [in] wait May be NULL.
+ * \ingroup group_int_osal
+ */
+void vxComputePerfStats(vx_perf_stats_t *stats, vx_histogram_t *latency, vx_histogram_t *wait, vx_size bytes);
+
 /*! \brief
  * \ingroup group_int_osal
  */
@@ -153,6 +231,28 @@ void vxPopQueue(vx_queue_t *q);
  */
 void vxDeinitQueue(vx_queue_t *q);
 
+/*! \brief Creates a lock-free queue holding at least the given number of values.
+ * \ingroup group_int_osal
+ */
+vx_bool vxCreateMPMCQueue(vx_mpmc_queue_t *q, vx_size depth);
+
+/*! \brief Frees the slots of a lock-free queue.
+ * \ingroup group_int_osal
+ */
+void vxDestroyMPMCQueue(vx_mpmc_queue_t *q);
+
+/*! \brief Appends a value to a lock-free queue without blocking.
+ * \return vx_false_e if the queue is full.
+ * \ingroup group_int_osal
+ */
+vx_bool vxTryWriteMPMCQueue(vx_mpmc_queue_t *q, vx_value_t v);
+
+/*! \brief Removes the oldest value from a lock-free queue without blocking.
+ * \return vx_false_e if the queue is empty.
+ * \ingroup group_int_osal
+ */
+vx_bool vxTryReadMPMCQueue(vx_mpmc_queue_t *q, vx_value_t *pv);
+
 /*! \brief
  * \ingroup group_int_osal
  */
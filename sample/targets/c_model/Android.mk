@@ -49,10 +49,22 @@ LOCAL_SRC_FILES := vx_interface.c \
     vx_multiply.c \
     vx_phase.c \
     vx_pyramid.c \
+    vx_remap.c \
     vx_scale.c \
     vx_threshold.c
 LOCAL_C_INCLUDES := $(OPENVX_INC) $(OPENVX_TOP)/$(OPENVX_SRC)/include $(OPENVX_TOP)/$(OPENVX_SRC)/extensions/include
+LOCAL_STATIC_LIBRARIES := libopenvx-c_model-lib
 LOCAL_SHARED_LIBRARIES := libdl libutils libcutils libbinder libhardware libion libgui libui libopenvx
 LOCAL_MODULE := libopenvx-c_model
 include $(BUILD_SHARED_LIBRARY)
 
+include $(CLEAR_VARS)
+LOCAL_MODULE_TAGS := optional
+LOCAL_PRELINK_MODULE := false
+LOCAL_ARM_MODE := arm
+LOCAL_CFLAGS := $(OPENVX_DEFS)
+LOCAL_SRC_FILES := vx_scale_lib.c
+LOCAL_C_INCLUDES := $(OPENVX_INC) $(OPENVX_TOP)/$(OPENVX_SRC)/include
+LOCAL_MODULE := libopenvx-c_model-lib
+include $(BUILD_STATIC_LIBRARY)
+
@@ -20,13 +20,22 @@
 # MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
 
 
+_MODULE := openvx-c_model-lib
+include $(PRELUDE)
+TARGET := openvx-c_model-lib
+TARGETTYPE := library
+CSOURCES := vx_scale_lib.c
+IDIRS += $(HOST_ROOT)/$(OPENVX_SRC)/include
+include $(FINALE)
+
+_MODULE := openvx-c_model
 include $(PRELUDE)
 TARGET := openvx-c_model
 TARGETTYPE := dsmo
 DEFFILE := openvx-target.def
-CSOURCES = $(call all-c-files)
+CSOURCES = $(filter-out vx_scale_lib.c,$(call all-c-files))
 IDIRS += $(HOST_ROOT)/$(OPENVX_SRC)/include 
 SHARED_LIBS := openvx vxu
-STATIC_LIBS := openvx-debug-lib openvx-extras-lib openvx-helper
+STATIC_LIBS := openvx-c_model-lib openvx-debug-lib openvx-extras-lib openvx-helper
 include $(FINALE)
 
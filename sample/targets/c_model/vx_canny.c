@@ -25,31 +25,275 @@
  * \file
  * \brief The Canny Edge Detector Kernel Implementation.
  * \author Erik Rainey <erik.rainey@ti.com>
+ *
+ * The gradients, the non-maximum suppression and the thresholds are computed
+ * in one pass over the input, in bands of rows which run on the context pool.
+ * Each band streams the rows of the Sobel gradients through a ring of three
+ * magnitude rows and writes a compact edge map, which hysteresis then traces
+ * with a stack: first inside each band, then across the seams between bands.
  */
 
 #include <VX/vx.h>
-#include <VX/vx_ext_extras.h>
 #include <VX/vx_helper.h>
 
 #include <vx_internal.h>
-#include <math.h>
 
-/*! \note Look at \ref vxCannyEdgeDetectorNode to see how this pyramid construction works */
+/*! \brief The values of the edge map. */
+enum vx_canny_map_e {
+    VX_CANNY_NONE = 0,
+    /*! \brief A local maximum between the thresholds. */
+    VX_CANNY_WEAK = 1,
+    /*! \brief An edge, which has been or will be traced from. */
+    VX_CANNY_EDGE = 2,
+};
 
-static vx_status vxCannyEdgeKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief The orientation of the gradient, which picks the neighbors compared
+ * by the non-maximum suppression.
+ */
+enum vx_canny_bin_e {
+    VX_CANNY_BIN_0 = 0,     /*!< \brief Compares left and right. */
+    VX_CANNY_BIN_90,        /*!< \brief Compares above and below. */
+    VX_CANNY_BIN_45,        /*!< \brief Compares above left and below right. */
+    VX_CANNY_BIN_135,       /*!< \brief Compares above right and below left. */
+};
+
+/*! \brief tan(22.5 degrees) in 17.15 fixed point. */
+#define VX_CANNY_TAN22 (13573)
+
+/*! \brief The first number of pixels the stack of a band holds. */
+#define VX_CANNY_STACK (4096)
+
+/*! \brief A stack of the edge map pixels to trace from. */
+typedef struct _vx_canny_stack_t {
+    vx_uint8 **items;
+    vx_size count;
+    vx_size capacity;
+} vx_canny_stack_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_canny_t {
+    vx_uint8 *src;
+    vx_imagepatch_addressing_t src_addr;
+    vx_uint8 *dst;
+    vx_imagepatch_addressing_t dst_addr;
+    vx_uint32 width;
+    vx_uint32 height;
+    /*! \brief Half the gradient size. */
+    vx_int32 radius;
+    const vx_int32 *smooth;
+    const vx_int32 *deriv;
+    vx_bool l2;
+    /*! \brief The magnitudes at and above which a maximum is weak or an edge,
+     * squared for VX_NORM_L2.
+     */
+    vx_uint64 lower;
+    vx_uint64 upper;
+    /*! \brief The edge map, with a border of one pixel which is never an edge. */
+    vx_uint8 *map;
+    vx_uint32 stride;
+    /*! \brief The rows of each band, see \ref vxCannyScratchSize. */
+    vx_uint8 *scratch;
+    vx_size scratch_size;
+    vx_uint32 count;
+    vx_canny_stack_t stacks[VX_MAX_BANDS];
+    vx_status status[VX_MAX_BANDS];
+} vx_canny_t;
+
+static const vx_int32 vx_canny_smooth[3][7] = {
+    {1, 2, 1},
+    {1, 4, 6, 4, 1},
+    {1, 6, 15, 20, 15, 6, 1},
+};
+
+static const vx_int32 vx_canny_deriv[3][7] = {
+    {-1, 0, 1},
+    {-1, -2, 0, 2, 1},
+    {-1, -4, -5, 0, 5, 4, 1},
+};
+
+/*! \brief The bytes of the edge map, rounded up to keep the scratch rows aligned. */
+static vx_size vxCannyMapSize(vx_uint32 width, vx_uint32 height)
 {
-    vx_status status = VX_FAILURE;
-    if (num == 5)
+    return ((((vx_size)width + 2) * (height + 2)) + 7) & ~(vx_size)7;
+}
+
+/*! \brief The bytes of the rows of one band: the vertical Sobel sums, then a
+ * ring of three magnitude rows and their orientation bins.
+ */
+static vx_size vxCannyScratchSize(vx_uint32 width)
+{
+    return ((2 * sizeof(vx_int32) + 3 * sizeof(vx_uint64) + 3) * (vx_size)width + 7) & ~(vx_size)7;
+}
+
+static vx_bool vxCannyPush(vx_canny_stack_t *stack, vx_uint8 *pixel)
+{
+    if (stack->count == stack->capacity)
     {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        status = vxProcessGraph(graph);
+        vx_size capacity = stack->capacity ? 2 * stack->capacity : VX_CANNY_STACK;
+        vx_uint8 **items = (vx_uint8 **)realloc(stack->items, capacity * sizeof(vx_uint8 *));
+        if (items == NULL)
+            return vx_false_e;
+        stack->items = items;
+        stack->capacity = capacity;
     }
-    return status;
+    stack->items[stack->count++] = pixel;
+    return vx_true_e;
 }
 
-static vx_status vxCannyEdgeInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief Marks the weak pixels connected to the stacked edges as edges,
+ * without leaving the map bytes [lo, hi).
+ */
+static vx_bool vxCannyTrace(vx_canny_stack_t *stack, vx_uint8 *lo, vx_uint8 *hi, vx_uint32 stride)
 {
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    const vx_int32 s = (vx_int32)stride;
+    const vx_int32 offsets[8] = {-s - 1, -s, -s + 1, -1, 1, s - 1, s, s + 1};
+    while (stack->count > 0)
+    {
+        vx_uint8 *p = stack->items[--stack->count];
+        vx_uint32 n;
+        for (n = 0; n < dimof(offsets); n++)
+        {
+            vx_uint8 *q = p + offsets[n];
+            if ((q >= lo) && (q < hi) && (*q == VX_CANNY_WEAK))
+            {
+                *q = VX_CANNY_EDGE;
+                if (vxCannyPush(stack, q) == vx_false_e)
+                    return vx_false_e;
+            }
+        }
+    }
+    return vx_true_e;
+}
+
+/*! \brief Computes the magnitudes and orientations of the gradients of row y. */
+static void vxCannyGradientRow(vx_canny_t *c, vx_int32 *sx, vx_int32 *dy, vx_uint64 *mag, vx_uint8 *bin, vx_uint32 y)
+{
+    const vx_int32 r = c->radius, k = 2 * r + 1;
+    vx_uint32 x;
+    vx_int32 i;
+
+    /* the vertical halves of the separable Sobel operators */
+    for (x = 0; x < c->width; x++)
+    {
+        sx[x] = 0;
+        dy[x] = 0;
+    }
+    for (i = 0; i < k; i++)
+    {
+        const vx_uint8 *row = c->src + (y + i - r) * c->src_addr.stride_y;
+        const vx_int32 sm = c->smooth[i], dv = c->deriv[i];
+        for (x = 0; x < c->width; x++)
+        {
+            sx[x] += sm * row[x];
+            dy[x] += dv * row[x];
+        }
+    }
+    for (x = 0; x < (vx_uint32)r; x++)
+    {
+        mag[x] = 0;
+        mag[c->width - 1 - x] = 0;
+    }
+    for (x = r; x < c->width - r; x++)
+    {
+        vx_int32 gx = 0, gy = 0;
+        vx_int64 ax, ay;
+        for (i = 0; i < k; i++)
+        {
+            gx += c->deriv[i] * sx[x + i - r];
+            gy += c->smooth[i] * dy[x + i - r];
+        }
+        ax = gx < 0 ? -gx : gx;
+        ay = gy < 0 ? -gy : gy;
+        mag[x] = c->l2 ? (vx_uint64)(ax * ax + ay * ay) : (vx_uint64)(ax + ay);
+        if ((ay << 15) < ax * VX_CANNY_TAN22)
+            bin[x] = VX_CANNY_BIN_0;
+        else if ((ay << 15) > ax * (VX_CANNY_TAN22 + (2 << 15)))
+            bin[x] = VX_CANNY_BIN_90;
+        else if ((gx ^ gy) < 0)
+            bin[x] = VX_CANNY_BIN_135;
+        else
+            bin[x] = VX_CANNY_BIN_45;
+    }
+}
+
+/*! \brief Writes the edge map of the rows [y0, y1) of one band and traces its edges inside it. */
+static void vxCannyBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_canny_t *c = (vx_canny_t *)arg;
+    const vx_uint32 w = c->width, r = (vx_uint32)c->radius;
+    vx_uint8 *scratch = c->scratch + index * c->scratch_size;
+    vx_int32 *sx = (vx_int32 *)scratch;
+    vx_int32 *dy = sx + w;
+    vx_uint64 *mags = (vx_uint64 *)(dy + w);
+    vx_uint8 *bins = (vx_uint8 *)(mags + 3 * w);
+    vx_canny_stack_t *stack = &c->stacks[index];
+    /* the rows whose neighbors all have gradients */
+    vx_uint32 ya = (y0 > r + 1) ? y0 : r + 1;
+    vx_uint32 yb = (y1 < c->height - r - 1) ? y1 : c->height - r - 1;
+    vx_uint32 x, y;
+
+    c->status[index] = VX_SUCCESS;
+    if (ya >= yb)
+        return;
+    vxCannyGradientRow(c, sx, dy, &mags[((ya - 1) % 3) * w], &bins[((ya - 1) % 3) * w], ya - 1);
+    vxCannyGradientRow(c, sx, dy, &mags[(ya % 3) * w], &bins[(ya % 3) * w], ya);
+    for (y = ya; y < yb; y++)
+    {
+        const vx_uint64 *m0 = &mags[((y - 1) % 3) * w];
+        const vx_uint64 *m1 = &mags[(y % 3) * w];
+        const vx_uint64 *m2 = &mags[((y + 1) % 3) * w];
+        const vx_uint8 *bin = &bins[(y % 3) * w];
+        vx_uint8 *map = c->map + (y + 1) * c->stride + 1;
+
+        vxCannyGradientRow(c, sx, dy, (vx_uint64 *)m2, &bins[((y + 1) % 3) * w], y + 1);
+        for (x = r + 1; x < w - r - 1; x++)
+        {
+            vx_uint64 m = m1[x], a, b;
+            vx_uint8 value = VX_CANNY_NONE;
+            switch (bin[x])
+            {
+                case VX_CANNY_BIN_0:   a = m1[x - 1]; b = m1[x + 1]; break;
+                case VX_CANNY_BIN_90:  a = m0[x];     b = m2[x];     break;
+                case VX_CANNY_BIN_45:  a = m0[x - 1]; b = m2[x + 1]; break;
+                default:               a = m0[x + 1]; b = m2[x - 1]; break;
+            }
+            /* ties keep the pixel which comes later along the gradient */
+            if ((m >= c->lower) && (m > a) && (m >= b))
+            {
+                value = VX_CANNY_WEAK;
+                if (m >= c->upper)
+                {
+                    value = VX_CANNY_EDGE;
+                    if (vxCannyPush(stack, &map[x]) == vx_false_e)
+                        c->status[index] = VX_ERROR_NO_MEMORY;
+                }
+            }
+            map[x] = value;
+        }
+    }
+    /* hysteresis stays inside the band, the seams are traced afterwards */
+    if ((c->status[index] == VX_SUCCESS) &&
+        (vxCannyTrace(stack, c->map + (y0 + 1) * c->stride, c->map + (y1 + 1) * c->stride, c->stride) == vx_false_e))
+        c->status[index] = VX_ERROR_NO_MEMORY;
+}
+
+/*! \brief Writes the rows [y0, y1) of the output from the traced edge map. */
+static void vxCannyOutputBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_canny_t *c = (vx_canny_t *)arg;
+    vx_uint32 x, y;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *map = c->map + (y + 1) * c->stride + 1;
+        vx_uint8 *dst = c->dst + y * c->dst_addr.stride_y;
+        for (x = 0; x < c->width; x++)
+            dst[x] = (vx_uint8)((map[x] >> 1) * 255);
+    }
+}
+
+static vx_status vxCannyEdgeKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
     if (num == 5)
     {
         vx_image input = (vx_image)parameters[0];
@@ -57,86 +301,135 @@ static vx_status vxCannyEdgeInitializer(vx_node node, vx_reference *parameters,
         vx_scalar gradient_size = (vx_scalar)parameters[2];
         vx_scalar snorm = (vx_scalar)parameters[3];
         vx_image output = (vx_image)parameters[4];
+        vx_rectangle rect = vxGetValidRegionImage(input);
+        vx_uint8 lower = 0, upper = 0;
+        vx_int32 gs = 3;
+        vx_enum norm = VX_NORM_L1;
+        void *src_base = NULL, *dst_base = NULL, *local = NULL;
+        vx_size local_size = 0, size;
+        vx_uint8 *memory = NULL;
+        vx_canny_t c;
+        vx_uint32 b, i, x;
 
-        vx_context context = vxGetContext(node);
-        vx_graph graph = 0;
-        status = vxLoadKernels(context, "openvx-extras");
-        if (status != VX_SUCCESS)
+        memset(&c, 0, sizeof(c));
+        status = VX_SUCCESS;
+        status |= vxQueryThreshold(hyst, VX_THRESHOLD_ATTRIBUTE_LOWER, &lower, sizeof(lower));
+        status |= vxQueryThreshold(hyst, VX_THRESHOLD_ATTRIBUTE_UPPER, &upper, sizeof(upper));
+        status |= vxAccessScalarValue(gradient_size, &gs);
+        status |= vxAccessScalarValue(snorm, &norm);
+        status |= vxAccessImagePatch(input, rect, 0, &c.src_addr, &src_base);
+        status |= vxAccessImagePatch(output, rect, 0, &c.dst_addr, &dst_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        c.src = (vx_uint8 *)src_base;
+        c.dst = (vx_uint8 *)dst_base;
+        c.width = c.src_addr.dim_x;
+        c.height = c.src_addr.dim_y;
+        c.radius = gs / 2;
+        c.smooth = vx_canny_smooth[c.radius - 1];
+        c.deriv = vx_canny_deriv[c.radius - 1];
+        c.l2 = (norm == VX_NORM_L2) ? vx_true_e : vx_false_e;
+        /* magnitude > threshold, as integers */
+        c.lower = c.l2 ? (vx_uint64)lower * lower + 1 : (vx_uint64)lower + 1;
+        c.upper = c.l2 ? (vx_uint64)upper * upper + 1 : (vx_uint64)upper + 1;
+        c.stride = c.width + 2;
+        c.count = vxBandCount(node, c.width, c.height);
+        c.scratch_size = vxCannyScratchSize(c.width);
+        size = vxCannyMapSize(c.width, c.height) + c.count * c.scratch_size;
+        if ((status == VX_SUCCESS) && (c.width > (vx_uint32)gs) && (c.height > (vx_uint32)gs))
         {
-            return status;
-        }
-        graph = vxCreateGraph(context);
-        if (graph)
-        {
-            vx_uint32 i;
-            vx_convolution conv[] = {
-                vxCreateConvolution(context, 3, 3),
-                vxCreateConvolution(context, 3, 3),
-            };
-            vx_image virts[] = {
-                vxCreateVirtualImage(context),  /* 0: gaussian */
-                vxCreateVirtualImage(context),  /* 1: Gx */
-                vxCreateVirtualImage(context),  /* 2: Gy */
-                vxCreateVirtualImageWithFormat(context, FOURCC_U8),  /* 3: Mag */
-                vxCreateVirtualImage(context),  /* 4: Phase */
-                vxCreateVirtualImageWithFormat(context, FOURCC_U8),  /* 5: Nonmax */
-            };
-            /*! \bug Fix canny graph to be the actual edge tracing features! */
-            vx_node nodes[] = {
-                vxGaussian3x3Node(graph, input, virts[0]),
-                vxConvolveNode(graph, virts[0], conv[0], virts[1]),
-                vxConvolveNode(graph, virts[0], conv[1], virts[2]),
-                vxMagnitudeNode(graph, virts[1], virts[2], virts[3]),
-                vxPhaseNode(graph, virts[1], virts[2], virts[4]),
-                vxNonMaxSuppressionNode(graph, virts[3], virts[4], virts[5]),
-                vxThresholdNode(graph, virts[5], hyst, output),
-            };
-            vx_int16 gx[3][3] = {
-                { 0, 0, 0},
-                {-1, 0, 1},
-                { 0, 0, 0},
-            };
-            vx_int16 gy[3][3] = {
-                { 0,-1, 0},
-                { 0, 0, 0},
-                { 0, 1, 0},
-            };
-            status |= vxAccessConvolutionCoefficients(conv[0], NULL);
-            status |= vxAccessConvolutionCoefficients(conv[1], NULL);
-            status |= vxCommitConvolutionCoefficients(conv[0], (vx_int16 *)gx);
-            status |= vxCommitConvolutionCoefficients(conv[1], (vx_int16 *)gy);
-            status |= vxAddParameterToGraphByIndex(graph, nodes[0], 0); /* input image */
-            status |= vxAddParameterToGraphByIndex(graph, nodes[6], 1); /* threshold */
-            status |= vxAddParameterToGraphByIndex(graph, 0, 0);     /*! \bug add gradient size */
-            status |= vxAddParameterToGraphByIndex(graph, 0, 0);     /*! \bug add norm */
-            status |= vxAddParameterToGraphByIndex(graph, nodes[6], 2); /* output image */
-            status |= vxVerifyGraph(graph);
-            /* release our references, the graph will hold it's own */
-            for (i = 0; i < dimof(nodes); i++) {
-                vxReleaseNode(&nodes[i]);
-            }
-            for (i = 0; i < dimof(virts); i++) {
-                vxReleaseImage(&virts[i]);
+            if (local && (local_size >= size))
+                c.map = (vx_uint8 *)local;
+            else
+                c.map = memory = (vx_uint8 *)calloc(1, size);
+            if (c.map)
+            {
+                /* the bands never write the border, but the map of an earlier
+                 * execution on other dimensions may have left edges in it */
+                if (c.map == (vx_uint8 *)local)
+                {
+                    memset(c.map, 0, c.stride);
+                    memset(c.map + (c.height + 1) * c.stride, 0, c.stride);
+                    for (i = 1; i <= c.height; i++)
+                    {
+                        c.map[i * c.stride] = VX_CANNY_NONE;
+                        c.map[i * c.stride + c.width + 1] = VX_CANNY_NONE;
+                    }
+                }
+                c.scratch = c.map + vxCannyMapSize(c.width, c.height);
+                vxRunBands(node, c.count, c.height, vxCannyBand, &c);
+                for (b = 0; b < c.count; b++)
+                    status |= c.status[b];
+                /* every edge pixel next to a seam may continue in the next band */
+                for (b = 1; (b < c.count) && (status == VX_SUCCESS); b++)
+                {
+                    vx_uint32 seam = (vx_uint32)(((vx_uint64)b * c.height) / c.count);
+                    for (i = seam; i <= seam + 1; i++)
+                    {
+                        vx_uint8 *row = c.map + i * c.stride;
+                        for (x = 1; x <= c.width; x++)
+                        {
+                            if ((row[x] == VX_CANNY_EDGE) && (vxCannyPush(&c.stacks[0], &row[x]) == vx_false_e))
+                                status = VX_ERROR_NO_MEMORY;
+                        }
+                    }
+                }
+                if ((status == VX_SUCCESS) &&
+                    (vxCannyTrace(&c.stacks[0], c.map, c.map + (c.height + 2) * c.stride, c.stride) == vx_false_e))
+                    status = VX_ERROR_NO_MEMORY;
+                if (status == VX_SUCCESS)
+                    vxRunBands(node, c.count, c.height, vxCannyOutputBand, &c);
             }
-            for (i = 0; i < dimof(conv); i++) {
-                vxReleaseConvolution(&conv[i]);
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
             }
-            status = vxSetChildGraphOfNode(node, graph);
-            vxReleaseGraph(&graph);
         }
+        else if (status == VX_SUCCESS)
+        {
+            status = VX_ERROR_INVALID_DIMENSION;
+        }
+        for (b = 0; b < c.count; b++)
+            free(c.stacks[b].items);
+        free(memory);
+        status |= vxCommitImagePatch(input, 0, 0, &c.src_addr, src_base);
+        status |= vxCommitImagePatch(output, rect, 0, &c.dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
     }
     return status;
 }
 
-static vx_status vxCannyEdgeDeinitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief Allocates the edge map and the rows of the bands once, as the local data of the node. */
+static vx_status vxCannyEdgeInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    if (num == 3)
+    if (num == 5)
     {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        vxReleaseGraph(&graph);
-        graph = 0;
-        vxSetChildGraphOfNode(node, graph);
+        vx_image input = (vx_image)parameters[0];
+        vx_uint32 width = 0, height = 0;
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel allocates
+         * for itself if the image has grown since */
+        if (local == NULL)
+        {
+            vx_size size;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            size = vxCannyMapSize(width, height) + vxBandCount(node, width, height) * vxCannyScratchSize(width);
+            local = calloc(1, size);
+            if (local)
+            {
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
     }
     return status;
 }
@@ -280,7 +573,7 @@ vx_kernel_description_t canny_kernel = {
     vxCannyEdgeInputValidator,
     vxCannyEdgeOutputValidator,
     vxCannyEdgeInitializer,
-    vxCannyEdgeDeinitializer,
+    NULL,
 };
 
 
@@ -32,6 +32,66 @@
 
 #include <vx_internal.h>
 
+#include <stdlib.h>
+#include <string.h>
+
+/*! \brief The fraction bits of the color matrices. */
+#define VX_COLOR_BITS (16)
+
+/*! \brief The number of pixels of a row converted at a time, so that the
+ * planar rows between the stages stay in the cache.
+ */
+#define VX_COLOR_CHUNK (256)
+
+/*! \brief A chunk of two rows of planar 4:4:4 pixels, channel by row by pixel.
+ * The channels are R, G, B or Y, U, V.
+ */
+typedef struct _vx_color_rows_t {
+    vx_uint8 c[3][2][VX_COLOR_CHUNK];
+} vx_color_rows_t;
+
+/*! \brief Reads n pixels from x on of the rows of a source into planar rows.
+ * \param [in] row The start of the row of each plane, for the first and the
+ * second row. The rows of subsampled chroma planes hold the row of both.
+ */
+typedef void (*vx_color_unpack_f)(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t);
+
+/*! \brief Writes n pixels from x on of planar rows into the rows of a destination. */
+typedef void (*vx_color_pack_f)(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t);
+
+/*! \brief An entry of the table of the supported conversions. */
+typedef struct _vx_color_pair_t {
+    vx_fourcc src;
+    vx_fourcc dst;
+    vx_color_unpack_f unpack;
+    vx_color_pack_f pack;
+} vx_color_pair_t;
+
+/*! \brief The conversion a node selected, kept as its local data. */
+typedef struct _vx_color_convert_t {
+    vx_fourcc src, dst;
+    vx_uint32 width, height;
+    /*! \brief The color space of the YUV side of the conversion. */
+    vx_enum space;
+    const vx_color_pair_t *pair;
+    /*! \brief Whether the conversion changes between RGB and YUV. */
+    vx_bool matrix;
+    vx_int32 m[3][3];
+    vx_int32 in_offset[3];
+    vx_int32 out_offset[3];
+    /*! \brief The number of bands of row pairs. */
+    vx_uint32 count;
+} vx_color_convert_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_color_run_t {
+    const vx_color_convert_t *cc;
+    void *src_base[3];
+    void *dst_base[3];
+    vx_imagepatch_addressing_t src_addr[3];
+    vx_imagepatch_addressing_t dst_addr[3];
+} vx_color_run_t;
+
 static vx_uint8 usat8(vx_int32 a)
 {
     if (a > 255)
@@ -41,595 +101,491 @@ static vx_uint8 usat8(vx_int32 a)
     return (vx_uint8)a;
 }
 
-static void yuv2rgb_bt601(vx_uint8 y, vx_uint8 cb, vx_uint8 cr,
-                          vx_uint8 *r, vx_uint8 *g, vx_uint8 *b)
+static void vxUnpackRGB(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
 {
-    /*
-    R'= Y' + 0.000*U' + 1.403*V'
-    G'= Y' - 0.344*U' - 0.714*V'
-    B'= Y' + 1.773*U' + 0.000*V'
-    */
-    vx_float64 f_y = (vx_float64)y;
-    vx_float64 f_u = (vx_float64)cb - 128;
-    vx_float64 f_v = (vx_float64)cr - 128;
-    vx_float64 f_r = f_y + 0.000f*f_u + 1.403f*f_v;
-    vx_float64 f_g = f_y - 0.344f*f_u - 0.714f*f_v;
-    vx_float64 f_b = f_y + 1.773f*f_u + 0.000f*f_v;
-    vx_int32 i_r = (vx_int32)f_r;
-    vx_int32 i_g = (vx_int32)f_g;
-    vx_int32 i_b = (vx_int32)f_b;
-    *r = usat8(i_r);
-    *g = usat8(i_g);
-    *b = usat8(i_b);
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        const vx_uint8 *p = row[r][0] + 3 * x;
+        for (i = 0; i < n; i++)
+        {
+            t->c[0][r][i] = p[3 * i + 0];
+            t->c[1][r][i] = p[3 * i + 1];
+            t->c[2][r][i] = p[3 * i + 2];
+        }
+    }
 }
 
-#if 0 /* we don't make 601 yet */
-static void rgb2yuv_bt601(vx_uint8 r, vx_uint8 g, vx_uint8 b,
-                          vx_uint8 *y, vx_uint8 *cb, vx_uint8 *cr)
+static void vxUnpackRGBX(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
 {
-    /*
-    Y'= 0.299*R' + 0.587*G' + 0.114*B'
-    Cb=-0.169*R' - 0.331*G' + 0.500*B'
-    Cr= 0.500*R' - 0.419*G' - 0.081*B'
-    */
-    vx_float64 f_r = (vx_float64)r;
-    vx_float64 f_g = (vx_float64)g;
-    vx_float64 f_b = (vx_float64)b;
-    vx_float64 f_y = 0 + 0.299f*f_r + 0.587f*f_g + 0.114f*f_b;
-    vx_float64 f_u = 0 - 0.169f*f_r - 0.331f*f_g + 0.500f*f_b;
-    vx_float64 f_v = 0 + 0.500f*f_r - 0.419f*f_g - 0.081f*f_b;
-    vx_int32 i_y = (vx_int32)f_y;
-    vx_int32 i_u = (vx_int32)f_u + 128;
-    vx_int32 i_v = (vx_int32)f_v + 128;
-    *y  = usat8(i_y);
-    *cb = usat8(i_u);
-    *cr = usat8(i_v);
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        const vx_uint8 *p = row[r][0] + 4 * x;
+        for (i = 0; i < n; i++)
+        {
+            t->c[0][r][i] = p[4 * i + 0];
+            t->c[1][r][i] = p[4 * i + 1];
+            t->c[2][r][i] = p[4 * i + 2];
+        }
+    }
 }
-#endif
 
-static void yuv2rgb_bt709(vx_uint8 y, vx_uint8 cb, vx_uint8 cr,
-                          vx_uint8 *r, vx_uint8 *g, vx_uint8 *b)
+/*! \brief Reads luma planes and a chroma row of interleaved pairs, either U
+ * first (u = 0) or V first (u = 1), which the rows share. The chroma is
+ * walked by pairs of pixels so that the compiler vectorizes the loop.
+ */
+static void vxUnpackSemiPlanar(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t, vx_uint32 u)
 {
-    /*
-    R'= Y' + 0.0000*Cb + 1.5701*Cr
-    G'= Y' - 0.1870*Cb - 0.4664*Cr
-    B'= Y' - 1.8556*Cb + 0.0000*Cr
-    */
-    vx_float64 f_y = (vx_float64)y;
-    vx_float64 f_u = (vx_float64)cb - 128;
-    vx_float64 f_v = (vx_float64)cr - 128;
-    vx_float64 f_r = f_y + 0.0000f*f_u + 1.5701f*f_v;
-    vx_float64 f_g = f_y - 0.1870f*f_u - 0.4664f*f_v;
-    vx_float64 f_b = f_y - 1.8556f*f_u + 0.0000f*f_v;
-    vx_int32 i_r = (vx_int32)f_r;
-    vx_int32 i_g = (vx_int32)f_g;
-    vx_int32 i_b = (vx_int32)f_b;
-    *r = usat8(i_r);
-    *g = usat8(i_g);
-    *b = usat8(i_b);
+    const vx_uint8 *uv = row[0][1] + x;
+    vx_uint8 *cu = t->c[1][0], *cv = t->c[2][0];
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+        memcpy(t->c[0][r], row[r][0] + x, n);
+    for (i = 0; i < n / 2; i++)
+    {
+        vx_uint8 a = uv[2 * i + u];
+        vx_uint8 b = uv[2 * i + (u ^ 1)];
+        cu[2 * i + 0] = a;
+        cu[2 * i + 1] = a;
+        cv[2 * i + 0] = b;
+        cv[2 * i + 1] = b;
+    }
+    if (n & 1)
+    {
+        cu[n - 1] = uv[n - 1 + u];
+        cv[n - 1] = uv[n - 1 + (u ^ 1)];
+    }
+    if (rows == 2)
+    {
+        memcpy(t->c[1][1], t->c[1][0], n);
+        memcpy(t->c[2][1], t->c[2][0], n);
+    }
 }
 
-static void rgb2yuv_bt709(vx_uint8 r, vx_uint8 g, vx_uint8 b,
-                          vx_uint8 *y, vx_uint8 *cb, vx_uint8 *cr)
+static void vxUnpackNV12(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
 {
-    /*
-    Y'= 0.2215*R' + 0.7154*G' + 0.0721*B'
-    Cb=-0.1145*R' - 0.3855*G' + 0.5000*B'
-    Cr= 0.5016*R' - 0.4556*G' - 0.0459*B'
-    */
-    vx_float64 f_r = (vx_float64)r;
-    vx_float64 f_g = (vx_float64)g;
-    vx_float64 f_b = (vx_float64)b;
-    vx_float64 f_y = 0 + 0.2215f*f_r + 0.7154f*f_g + 0.0721f*f_b;
-    vx_float64 f_u = 0 - 0.1145f*f_r - 0.3855f*f_g + 0.5000f*f_b;
-    vx_float64 f_v = 0 + 0.5016f*f_r - 0.4556f*f_g - 0.0459f*f_b;
-    vx_int32 i_y = (vx_int32)f_y;
-    vx_int32 i_u = (vx_int32)f_u + 128;
-    vx_int32 i_v = (vx_int32)f_v + 128;
-    *y  = usat8(i_y);
-    *cb = usat8(i_u);
-    *cr = usat8(i_v);
+    vxUnpackSemiPlanar(row, x, n, rows, t, 0);
 }
 
-static void yuv2yuv_601to709(vx_uint8 y0, vx_uint8 cb0, vx_uint8 cr0,
-                             vx_uint8 *y1, vx_uint8 *cb1, vx_uint8 *cr1)
+static void vxUnpackNV21(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
 {
-    /*
-    Y' = 1.0090*Y - 0.11826430*Cb - 0.2000311*Cr
-    Cb'= 0.0000*Y + 1.01911200*Cb + 0.1146035*Cr
-    Cr'= 0.0001*Y + 0.07534570*Cb + 1.0290932*Cr
-    */
-    vx_float64 f_y0 = (vx_float64)y0;
-    vx_float64 f_cb0 = (vx_float64)cb0;
-    vx_float64 f_cr0 = (vx_float64)cr0;
-    vx_float64 f_y1  = 1.0090*f_y0 - 0.11826430*f_cb0 - 0.2000311*f_cr0;
-    vx_float64 f_cb1 = 0.0000*f_y0 + 1.01911200*f_cb0 + 0.1146035*f_cr0;
-    vx_float64 f_cr1 = 0.0001*f_y0 + 0.07534570*f_cb0 + 1.0290932*f_cr0;
-    vx_int32 i_y = (vx_int32)f_y1;
-    vx_int32 i_cb = (vx_int32)f_cb1;
-    vx_int32 i_cr = (vx_int32)f_cr1;
-    *y1 = usat8(i_y);
-    *cb1 = usat8(i_cb);
-    *cr1 = usat8(i_cr);
+    vxUnpackSemiPlanar(row, x, n, rows, t, 1);
 }
 
-static vx_status vxColorConvertKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+static void vxUnpackIYUV(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
 {
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    if (num == 2)
+    const vx_uint8 *u = row[0][1] + x / 2;
+    const vx_uint8 *v = row[0][2] + x / 2;
+    vx_uint8 *cu = t->c[1][0], *cv = t->c[2][0];
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+        memcpy(t->c[0][r], row[r][0] + x, n);
+    for (i = 0; i < n / 2; i++)
     {
-        vx_image src = (vx_image)parameters[0];
-        vx_image dst = (vx_image)parameters[1];
-        vx_imagepatch_addressing_t src_addr[4], dst_addr[4];
-        void *src_base[4] = {NULL};
-        void *dst_base[4] = {NULL};
-        vx_uint32 y, x, p;
-        vx_fourcc src_format, dst_format;
-        vx_uint32 src_planes, dst_planes;
-        vx_enum src_space;
-        vx_rectangle rect;
+        cu[2 * i + 0] = u[i];
+        cu[2 * i + 1] = u[i];
+        cv[2 * i + 0] = v[i];
+        cv[2 * i + 1] = v[i];
+    }
+    if (n & 1)
+    {
+        cu[n - 1] = u[n / 2];
+        cv[n - 1] = v[n / 2];
+    }
+    if (rows == 2)
+    {
+        memcpy(t->c[1][1], t->c[1][0], n);
+        memcpy(t->c[2][1], t->c[2][0], n);
+    }
+}
 
-        status = VX_SUCCESS;
-        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &src_format, sizeof(src_format));
-        status |= vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &dst_format, sizeof(dst_format));
-        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_PLANES, &src_planes, sizeof(src_planes));
-        status |= vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_PLANES, &dst_planes, sizeof(dst_planes));
-        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_SPACE, &src_space, sizeof(src_space));
-        rect = vxGetValidRegionImage(src);
-        for (p = 0; p < src_planes; p++)
+static void vxUnpackYUV4(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
+{
+    vx_uint32 r, p;
+    for (r = 0; r < rows; r++)
+        for (p = 0; p < 3; p++)
+            memcpy(t->c[p][r], row[r][p] + x, n);
+}
+
+/*! \brief Reads macro pixels of two pixels in four bytes, with the luma at
+ * bytes y and y + 2 and the chroma at bytes u and u + 2.
+ */
+static void vxUnpackPacked422(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t, vx_uint32 y, vx_uint32 u)
+{
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        const vx_uint8 *p = row[r][0] + 2 * x;
+        for (i = 0; i < n; i++)
         {
-            status |= vxAccessImagePatch(src, rect, p, &src_addr[p], &src_base[p]);
-            vxPrintImageAddressing(&src_addr[p]);
+            t->c[0][r][i] = p[2 * i + y];
+            t->c[1][r][i] = p[2 * (i & ~1u) + u];
+            t->c[2][r][i] = p[2 * (i & ~1u) + u + 2];
         }
-        for (p = 0; p < dst_planes; p++)
+    }
+}
+
+static void vxUnpackYUYV(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
+{
+    vxUnpackPacked422(row, x, n, rows, t, 0, 1);
+}
+
+static void vxUnpackUYVY(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, vx_color_rows_t *t)
+{
+    vxUnpackPacked422(row, x, n, rows, t, 1, 0);
+}
+
+static void vxPackRGB(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t)
+{
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        vx_uint8 *p = row[r][0] + 3 * x;
+        for (i = 0; i < n; i++)
         {
-            status |= vxAccessImagePatch(dst, rect, p, &dst_addr[p], &dst_base[p]);
-            vxPrintImageAddressing(&dst_addr[p]);
+            p[3 * i + 0] = t->c[0][r][i];
+            p[3 * i + 1] = t->c[1][r][i];
+            p[3 * i + 2] = t->c[2][r][i];
         }
-        if (status != VX_SUCCESS)
+    }
+}
+
+static void vxPackRGBX(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t)
+{
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        vx_uint8 *p = row[r][0] + 4 * x;
+        for (i = 0; i < n; i++)
         {
-            VX_PRINT(VX_ZONE_ERROR, "Failed to setup images in Color Convert!\n");
+            p[4 * i + 0] = t->c[0][r][i];
+            p[4 * i + 1] = t->c[1][r][i];
+            p[4 * i + 2] = t->c[2][r][i];
+            p[4 * i + 3] = 255;
         }
+    }
+}
 
-        if ((src_format == FOURCC_RGB) || (src_format == FOURCC_RGBX))
-        {
-            if (dst_format == FOURCC_NV12)
-            {
-                vx_uint8 cb[4];
-                vx_uint8 cr[4];
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *rgb[4] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x+1, y, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x+1, y+1, &src_addr[0])};
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        rgb2yuv_bt709(rgb[0][0],rgb[0][1],rgb[0][2],&luma[0][0],&cb[0],&cr[0]);
-                        rgb2yuv_bt709(rgb[1][0],rgb[1][1],rgb[1][2],&luma[1][0],&cb[1],&cr[1]);
-                        rgb2yuv_bt709(rgb[2][0],rgb[2][1],rgb[2][2],&luma[2][0],&cb[2],&cr[2]);
-                        rgb2yuv_bt709(rgb[3][0],rgb[3][1],rgb[3][2],&luma[3][0],&cb[3],&cr[3]);
-
-                        cbcr[0] = (cb[0] + cb[1] + cb[2] + cb[3])/4;
-                        cbcr[1] = (cr[0] + cr[1] + cr[2] + cr[3])/4;
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_YUV4)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
+/*! \brief Averages the chroma channel c over the blocks of 2x2 pixels, or
+ * of 2x1 pixels if there is one row, rounding to nearest. The last block of
+ * an odd n repeats its pixel.
+ */
+static void vxAverageChroma(const vx_color_rows_t *t, vx_uint32 c, vx_uint32 n, vx_uint32 rows, vx_uint8 *out, vx_uint32 step)
+{
+    const vx_uint8 *a = t->c[c][0];
+    const vx_uint8 *b = t->c[c][rows - 1];
+    vx_uint32 i, pairs = n / 2;
+    for (i = 0; i < pairs; i++)
+    {
+        out[i * step] = (vx_uint8)((a[2 * i] + a[2 * i + 1] + b[2 * i] + b[2 * i + 1] + 2) >> 2);
+    }
+    if (n & 1)
+    {
+        out[pairs * step] = (vx_uint8)((a[n - 1] + b[n - 1] + 1) >> 1);
+    }
+}
 
-                        rgb2yuv_bt709(rgb[0],rgb[1],rgb[2],luma,cb,cr);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_IYUV)
-            {
-                vx_uint8 cb[4];
-                vx_uint8 cr[4];
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *rgb[4] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x+1, y, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0]),
-                                            vxFormatImagePatchAddress2d(src_base[0], x+1, y+1, &src_addr[0])};
-
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-
-                        vx_uint8 *cbp = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *crp = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                        rgb2yuv_bt709(rgb[0][0],rgb[0][1],rgb[0][2],&luma[0][0],&cb[0],&cr[0]);
-                        rgb2yuv_bt709(rgb[1][0],rgb[1][1],rgb[1][2],&luma[1][0],&cb[1],&cr[1]);
-                        rgb2yuv_bt709(rgb[2][0],rgb[2][1],rgb[2][2],&luma[2][0],&cb[2],&cr[2]);
-                        rgb2yuv_bt709(rgb[3][0],rgb[3][1],rgb[3][2],&luma[3][0],&cb[3],&cr[3]);
-
-                        cbp[0] = (uint8_t)(((vx_uint16)cb[0] + (vx_uint16)cb[1] + (vx_uint16)cb[2] + (vx_uint16)cb[3])>>2);
-                        crp[0] = (uint8_t)(((vx_uint16)cr[0] + (vx_uint16)cr[1] + (vx_uint16)cr[2] + (vx_uint16)cr[3])>>2);
-                    }
-                }
-            }
-        }
-        else if (src_format == FOURCC_NV21)
-        {
-            if ((dst_format == FOURCC_RGB) || (dst_format == FOURCC_RGBX))
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                        vx_uint8 *rgb = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                            yuv2rgb_bt601(luma[0],crcb[0],crcb[1],&rgb[0],&rgb[1],&rgb[2]);
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                            yuv2rgb_bt709(luma[0],crcb[0],crcb[1],&rgb[0],&rgb[1],&rgb[2]);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_NV12)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0])};
-                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                        vx_uint8 *crcb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        yuv2yuv_601to709(luma[0][0],cbcr[0],cbcr[1],&luma[1][0],&crcb[1],&crcb[0]);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_YUV4)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *yout = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                        yout[0] = luma[0];
-                        cb[0] = crcb[1];
-                        cr[0] = crcb[0];
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_IYUV)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                        vx_uint8 *yout = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                        yout[0] = luma[0];
-                        cb[0] = crcb[1];
-                        cr[0] = crcb[0];
-                    }
-                }
-            }
-        }
-        else if (src_format == FOURCC_YUYV)
-        {
-            if (dst_format == FOURCC_RGB)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
+static void vxPackNV12(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t)
+{
+    vx_uint8 *uv = row[0][1] + x;
+    vx_uint32 r;
+    for (r = 0; r < rows; r++)
+        memcpy(row[r][0] + x, t->c[0][r], n);
+    vxAverageChroma(t, 1, n, rows, &uv[0], 2);
+    vxAverageChroma(t, 2, n, rows, &uv[1], 2);
+}
 
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                        {
-                            yuv2rgb_bt601(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt601(yuyv[2],yuyv[1],yuyv[3],&rgb[3],&rgb[4],&rgb[5]);
-                        }
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                        {
-                            yuv2rgb_bt709(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt709(yuyv[2],yuyv[1],yuyv[3],&rgb[3],&rgb[4],&rgb[5]);
-                        }
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_RGBX)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
+static void vxPackIYUV(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t)
+{
+    vx_uint32 r;
+    for (r = 0; r < rows; r++)
+        memcpy(row[r][0] + x, t->c[0][r], n);
+    vxAverageChroma(t, 1, n, rows, row[0][1] + x / 2, 1);
+    vxAverageChroma(t, 2, n, rows, row[0][2] + x / 2, 1);
+}
 
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                        {
-                            yuv2rgb_bt601(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt601(yuyv[2],yuyv[1],yuyv[3],&rgb[4],&rgb[5],&rgb[6]);
-                        }
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                        {
-                            yuv2rgb_bt709(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt709(yuyv[2],yuyv[1],yuyv[3],&rgb[4],&rgb[5],&rgb[6]);
-                        }
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_NV12)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *yuyv[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                              vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 cb[4];
-                        vx_uint8 cr[4];
-                        yuv2yuv_601to709(yuyv[0][0], yuyv[0][1], yuyv[0][3], &luma[0][0], &cb[0], &cr[0]);
-                        yuv2yuv_601to709(yuyv[0][2], yuyv[0][1], yuyv[0][3], &luma[1][0], &cb[1], &cr[1]);
-                        yuv2yuv_601to709(yuyv[1][0], yuyv[1][1], yuyv[1][3], &luma[2][0], &cb[2], &cr[2]);
-                        yuv2yuv_601to709(yuyv[1][2], yuyv[1][1], yuyv[1][3], &luma[3][0], &cb[3], &cr[3]);
-                        cbcr[0] = (cb[0] + cb[1] + cr[2] + cr[3])/4;
-                        cbcr[1] = (cr[0] + cr[1] + cr[2] + cr[3])/4;
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_YUV4)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
+static void vxPackYUV4(vx_uint8 *row[2][3], vx_uint32 x, vx_uint32 n, vx_uint32 rows, const vx_color_rows_t *t)
+{
+    vx_uint32 r, p;
+    for (r = 0; r < rows; r++)
+        for (p = 0; p < 3; p++)
+            memcpy(row[r][p] + x, t->c[p][r], n);
+}
 
-                        yuv2yuv_601to709(yuyv[0],yuyv[1],yuyv[3],&luma[0],&cb[0],&cr[0]);
-                        yuv2yuv_601to709(yuyv[2],yuyv[1],yuyv[3],&luma[1],&cb[1],&cr[1]);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_IYUV)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *yuyv[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                              vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                              vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                        vx_uint8 *cb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                        yuv2yuv_601to709(yuyv[0][0],yuyv[0][1],yuyv[0][3],&luma[0][0],&cb[0],&cr[0]);
-                        yuv2yuv_601to709(yuyv[0][2],yuyv[0][1],yuyv[0][3],&luma[1][0],&cb[1],&cr[1]);
-                        yuv2yuv_601to709(yuyv[1][0],yuyv[1][1],yuyv[0][3],&luma[2][0],&cb[0],&cr[0]);
-                        yuv2yuv_601to709(yuyv[1][2],yuyv[1][1],yuyv[0][3],&luma[3][0],&cb[1],&cr[1]);
-                    }
-                }
-            }
+/*! \brief The supported conversions. NV21, UYVY and YUYV can only be read. */
+static const vx_color_pair_t color_pairs[] = {
+    /* {src, dst, unpack, pack} */
+    {FOURCC_RGB, FOURCC_RGBX, vxUnpackRGB,  vxPackRGBX},
+    {FOURCC_RGB, FOURCC_NV12, vxUnpackRGB,  vxPackNV12},
+    {FOURCC_RGB, FOURCC_YUV4, vxUnpackRGB,  vxPackYUV4},
+    {FOURCC_RGB, FOURCC_IYUV, vxUnpackRGB,  vxPackIYUV},
+    {FOURCC_RGBX,FOURCC_RGB,  vxUnpackRGBX, vxPackRGB},
+    {FOURCC_RGBX,FOURCC_NV12, vxUnpackRGBX, vxPackNV12},
+    {FOURCC_RGBX,FOURCC_YUV4, vxUnpackRGBX, vxPackYUV4},
+    {FOURCC_RGBX,FOURCC_IYUV, vxUnpackRGBX, vxPackIYUV},
+    {FOURCC_NV12,FOURCC_RGB,  vxUnpackNV12, vxPackRGB},
+    {FOURCC_NV12,FOURCC_RGBX, vxUnpackNV12, vxPackRGBX},
+    {FOURCC_NV12,FOURCC_YUV4, vxUnpackNV12, vxPackYUV4},
+    {FOURCC_NV12,FOURCC_IYUV, vxUnpackNV12, vxPackIYUV},
+    {FOURCC_NV21,FOURCC_RGB,  vxUnpackNV21, vxPackRGB},
+    {FOURCC_NV21,FOURCC_RGBX, vxUnpackNV21, vxPackRGBX},
+    {FOURCC_NV21,FOURCC_NV12, vxUnpackNV21, vxPackNV12},
+    {FOURCC_NV21,FOURCC_YUV4, vxUnpackNV21, vxPackYUV4},
+    {FOURCC_NV21,FOURCC_IYUV, vxUnpackNV21, vxPackIYUV},
+    {FOURCC_UYVY,FOURCC_RGB,  vxUnpackUYVY, vxPackRGB},
+    {FOURCC_UYVY,FOURCC_RGBX, vxUnpackUYVY, vxPackRGBX},
+    {FOURCC_UYVY,FOURCC_NV12, vxUnpackUYVY, vxPackNV12},
+    {FOURCC_UYVY,FOURCC_YUV4, vxUnpackUYVY, vxPackYUV4},
+    {FOURCC_UYVY,FOURCC_IYUV, vxUnpackUYVY, vxPackIYUV},
+    {FOURCC_YUYV,FOURCC_RGB,  vxUnpackYUYV, vxPackRGB},
+    {FOURCC_YUYV,FOURCC_RGBX, vxUnpackYUYV, vxPackRGBX},
+    {FOURCC_YUYV,FOURCC_NV12, vxUnpackYUYV, vxPackNV12},
+    {FOURCC_YUYV,FOURCC_YUV4, vxUnpackYUYV, vxPackYUV4},
+    {FOURCC_YUYV,FOURCC_IYUV, vxUnpackYUYV, vxPackIYUV},
+    {FOURCC_IYUV,FOURCC_RGB,  vxUnpackIYUV, vxPackRGB},
+    {FOURCC_IYUV,FOURCC_RGBX, vxUnpackIYUV, vxPackRGBX},
+    {FOURCC_IYUV,FOURCC_NV12, vxUnpackIYUV, vxPackNV12},
+    {FOURCC_IYUV,FOURCC_YUV4, vxUnpackIYUV, vxPackYUV4},
+    {FOURCC_YUV4,FOURCC_RGB,  vxUnpackYUV4, vxPackRGB},
+    {FOURCC_YUV4,FOURCC_RGBX, vxUnpackYUV4, vxPackRGBX},
+    {FOURCC_YUV4,FOURCC_NV12, vxUnpackYUV4, vxPackNV12},
+    {FOURCC_YUV4,FOURCC_IYUV, vxUnpackYUV4, vxPackIYUV},
+};
+
+static const vx_color_pair_t *vxColorPair(vx_fourcc src, vx_fourcc dst)
+{
+    vx_uint32 i;
+    for (i = 0; i < dimof(color_pairs); i++)
+    {
+        if ((color_pairs[i].src == src) && (color_pairs[i].dst == dst))
+            return &color_pairs[i];
+    }
+    return NULL;
+}
+
+static vx_bool vxIsRGB(vx_fourcc format)
+{
+    return ((format == FOURCC_RGB) || (format == FOURCC_RGBX)) ? vx_true_e : vx_false_e;
+}
+
+static vx_int32 vxColorFixed(vx_float64 a)
+{
+    vx_float64 f = a * (1 << VX_COLOR_BITS);
+    return (vx_int32)(f < 0 ? f - 0.5 : f + 0.5);
+}
+
+/*! \brief Builds the full range matrix between R'G'B' and Y'CbCr from the luma
+ * weights of the red and the blue of a color space.
+ */
+static void vxColorMatrix(vx_color_convert_t *cc, vx_bool to_yuv, vx_enum space)
+{
+    vx_float64 kr = 0.2126, kb = 0.0722, kg;
+    vx_float64 m[3][3];
+    vx_uint32 i, j;
+
+    if ((space == VX_COLOR_SPACE_BT601_525) ||
+        (space == VX_COLOR_SPACE_BT601_625))
+    {
+        kr = 0.299;
+        kb = 0.114;
+    }
+    kg = 1.0 - kr - kb;
+    if (to_yuv)
+    {
+        /* Y = Kr*R + Kg*G + Kb*B, Cb = (B - Y) / (2 - 2Kb), Cr = (R - Y) / (2 - 2Kr) */
+        m[0][0] = kr;                          m[0][1] = kg;                          m[0][2] = kb;
+        m[1][0] = -kr / (2.0 - 2.0 * kb);      m[1][1] = -kg / (2.0 - 2.0 * kb);      m[1][2] = 0.5;
+        m[2][0] = 0.5;                         m[2][1] = -kg / (2.0 - 2.0 * kr);      m[2][2] = -kb / (2.0 - 2.0 * kr);
+        cc->out_offset[1] = cc->out_offset[2] = 128;
+    }
+    else
+    {
+        m[0][0] = 1.0; m[0][1] = 0.0;                                m[0][2] = 2.0 - 2.0 * kr;
+        m[1][0] = 1.0; m[1][1] = -2.0 * kb * (1.0 - kb) / kg;        m[1][2] = -2.0 * kr * (1.0 - kr) / kg;
+        m[2][0] = 1.0; m[2][1] = 2.0 - 2.0 * kb;                     m[2][2] = 0.0;
+        cc->in_offset[1] = cc->in_offset[2] = 128;
+    }
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+            cc->m[i][j] = vxColorFixed(m[i][j]);
+}
+
+/*! \brief Selects the conversion from the formats and the color spaces of the
+ * images. RGB is converted to YUV in the space of the destination and YUV to
+ * RGB in the space of the source, while YUV is only resampled between YUV
+ * formats.
+ */
+static void vxColorHeader(vx_color_convert_t *cc, vx_node node, vx_image src, vx_image dst)
+{
+    vx_enum space = VX_COLOR_SPACE_BT709;
+    vx_bool src_rgb, dst_rgb;
+
+    memset(cc, 0, sizeof(*cc));
+    vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &cc->src, sizeof(cc->src));
+    vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &cc->dst, sizeof(cc->dst));
+    vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &cc->width, sizeof(cc->width));
+    vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &cc->height, sizeof(cc->height));
+    src_rgb = vxIsRGB(cc->src);
+    dst_rgb = vxIsRGB(cc->dst);
+    if (src_rgb != dst_rgb)
+    {
+        vxQueryImage(src_rgb ? dst : src, VX_IMAGE_ATTRIBUTE_SPACE, &space, sizeof(space));
+        cc->space = space;
+        cc->matrix = vx_true_e;
+        vxColorMatrix(cc, src_rgb, space);
+    }
+    cc->pair = vxColorPair(cc->src, cc->dst);
+    cc->count = vxBandCount(node, cc->width, cc->height);
+    if (cc->count > (cc->height + 1) / 2)
+        cc->count = (cc->height + 1) / 2;
+}
+
+/*! \brief Multiplies n pixels of planar rows with the matrix of the conversion. */
+static void vxColorTransform(const vx_color_convert_t *cc, vx_color_rows_t *t, vx_uint32 n, vx_uint32 rows)
+{
+    const vx_int32 round = 1 << (VX_COLOR_BITS - 1);
+    vx_int32 o0 = (cc->out_offset[0] << VX_COLOR_BITS) + round;
+    vx_int32 o1 = (cc->out_offset[1] << VX_COLOR_BITS) + round;
+    vx_int32 o2 = (cc->out_offset[2] << VX_COLOR_BITS) + round;
+    vx_uint32 r, i;
+    for (r = 0; r < rows; r++)
+    {
+        vx_uint8 *c0 = t->c[0][r], *c1 = t->c[1][r], *c2 = t->c[2][r];
+        for (i = 0; i < n; i++)
+        {
+            vx_int32 a = c0[i] - cc->in_offset[0];
+            vx_int32 b = c1[i] - cc->in_offset[1];
+            vx_int32 c = c2[i] - cc->in_offset[2];
+            vx_int32 d0 = cc->m[0][0] * a + cc->m[0][1] * b + cc->m[0][2] * c + o0;
+            vx_int32 d1 = cc->m[1][0] * a + cc->m[1][1] * b + cc->m[1][2] * c + o1;
+            vx_int32 d2 = cc->m[2][0] * a + cc->m[2][1] * b + cc->m[2][2] * c + o2;
+            c0[i] = usat8(d0 >> VX_COLOR_BITS);
+            c1[i] = usat8(d1 >> VX_COLOR_BITS);
+            c2[i] = usat8(d2 >> VX_COLOR_BITS);
         }
-        else if (src_format == FOURCC_UYVY)
+    }
+}
+
+/*! \brief Finds the rows y and y + 1 of the planes of an image. */
+static void vxColorRows(void *base[3], vx_imagepatch_addressing_t addr[3], vx_uint32 y, vx_uint32 rows, vx_uint8 *row[2][3])
+{
+    vx_uint32 r, p;
+    for (r = 0; r < 2; r++)
+    {
+        for (p = 0; p < 3; p++)
         {
-            if (dst_format == FOURCC_RGB)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
+            row[r][p] = (vx_uint8 *)vxFormatImagePatchAddress2d(base[p], 0, (r < rows) ? y + r : y, &addr[p]);
+        }
+    }
+}
 
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                        {
-                            yuv2rgb_bt601(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt601(uyvy[3],uyvy[0],uyvy[2],&rgb[3],&rgb[4],&rgb[5]);
-                        }
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                        {
-                            yuv2rgb_bt709(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt709(uyvy[3],uyvy[0],uyvy[2],&rgb[3],&rgb[4],&rgb[5]);
-                        }
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_RGBX)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
+static void vxColorBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_color_run_t *run = (vx_color_run_t *)arg;
+    const vx_color_convert_t *cc = run->cc;
+    vx_color_rows_t t;
+    vx_uint32 yp, x;
+    (void)index;
+    /* the bands cover pairs of rows, so that a row of 4:2:0 chroma is read or
+     * written by one band only */
+    for (yp = y0; yp < y1; yp++)
+    {
+        vx_uint32 y = 2 * yp;
+        vx_uint32 rows = (y + 1 < cc->height) ? 2 : 1;
+        vx_uint8 *src_row[2][3], *dst_row[2][3];
 
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                        {
-                            yuv2rgb_bt601(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt601(uyvy[3],uyvy[0],uyvy[2],&rgb[4],&rgb[5],&rgb[6]);
-                        }
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                        {
-                            yuv2rgb_bt709(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                            yuv2rgb_bt709(uyvy[3],uyvy[0],uyvy[2],&rgb[4],&rgb[5],&rgb[6]);
-                        }
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_NV12)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *uyvy[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                             vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 cb[4];
-                        vx_uint8 cr[4];
-
-                        yuv2yuv_601to709(uyvy[0][1],uyvy[0][0],uyvy[0][2],&luma[0][0],&cb[0],&cr[0]);
-                        yuv2yuv_601to709(uyvy[0][3],uyvy[0][0],uyvy[0][2],&luma[1][0],&cb[1],&cr[1]);
-                        yuv2yuv_601to709(uyvy[1][1],uyvy[1][0],uyvy[1][2],&luma[1][0],&cb[2],&cr[2]);
-                        yuv2yuv_601to709(uyvy[1][3],uyvy[1][0],uyvy[1][2],&luma[1][0],&cb[3],&cr[3]);
-                        cbcr[0] = (cb[0] + cb[1] + cb[2] + cb[3])/4;
-                        cbcr[1] = (cr[0] + cr[1] + cr[2] + cr[3])/4;
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_YUV4)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
+        vxColorRows(run->src_base, run->src_addr, y, rows, src_row);
+        vxColorRows(run->dst_base, run->dst_addr, y, rows, dst_row);
+        for (x = 0; x < cc->width; x += VX_COLOR_CHUNK)
+        {
+            vx_uint32 n = (cc->width - x < VX_COLOR_CHUNK) ? cc->width - x : VX_COLOR_CHUNK;
+            cc->pair->unpack(src_row, x, n, rows, &t);
+            if (cc->matrix)
+                vxColorTransform(cc, &t, n, rows);
+            cc->pair->pack(dst_row, x, n, rows, &t);
+        }
+    }
+}
 
-                        yuv2yuv_601to709(uyvy[1],uyvy[0],uyvy[2],&luma[0],&cb[0],&cr[0]);
-                        yuv2yuv_601to709(uyvy[3],uyvy[0],uyvy[2],&luma[1],&cb[1],&cr[1]);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_IYUV)
+static vx_status vxColorConvertKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 2)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[1];
+        vx_uint32 p, src_planes = 0, dst_planes = 0;
+        vx_color_convert_t header, *cc = NULL;
+        void *local = NULL;
+        vx_size local_size = 0;
+        vx_fourcc src_format = 0, dst_format = 0;
+        vx_uint32 width = 0, height = 0;
+        vx_enum space = VX_COLOR_SPACE_BT709;
+        vx_color_run_t run;
+        vx_rectangle rect;
+
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        if (local && (local_size >= sizeof(header)))
+        {
+            /* the conversion of the initializer is trusted unless the images
+             * or the color space have changed since */
+            cc = (vx_color_convert_t *)local;
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &src_format, sizeof(src_format));
+            vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &dst_format, sizeof(dst_format));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            if (cc->matrix)
+                vxQueryImage(vxIsRGB(src_format) ? dst : src, VX_IMAGE_ATTRIBUTE_SPACE, &space, sizeof(space));
+            if ((cc->pair == NULL) ||
+                (cc->src != src_format) || (cc->dst != dst_format) ||
+                (cc->width != width) || (cc->height != height) ||
+                (cc->matrix && (cc->space != space)))
             {
-                for (y = 0; y < dst_addr[0].dim_y; y+=2)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                    {
-                        vx_uint8 *uyvy[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                             vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                        vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                        vx_uint8 *cb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                        vx_uint8 *cr = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-                        vx_uint8 cb1[4], cr1[4];
-
-                        yuv2yuv_601to709(uyvy[0][1],uyvy[0][0],uyvy[0][2], &luma[0][0], &cb1[0], &cr1[0]);
-                        yuv2yuv_601to709(uyvy[0][3],uyvy[0][0],uyvy[0][2], &luma[1][0], &cb1[1], &cr1[1]);
-                        yuv2yuv_601to709(uyvy[1][1],uyvy[1][0],uyvy[1][2], &luma[2][0], &cb1[2], &cr1[2]);
-                        yuv2yuv_601to709(uyvy[1][3],uyvy[1][0],uyvy[1][2], &luma[3][0], &cb1[3], &cr1[3]);
-                        cb[0] = (cb1[0] + cb1[1] + cb1[2] + cb1[3])/4;
-                        cr[0] = (cr1[0] + cr1[1] + cr1[2] + cr1[3])/4;
-                    }
-                }
+                vxColorHeader(cc, node, src, dst);
             }
         }
-        else if (src_format == FOURCC_IYUV)
+        else
         {
-            if (dst_format == FOURCC_RGB || dst_format == FOURCC_RGBX)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]);
-                        vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-
-                        /*! \todo restricted range 601 ? */
-                        if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                            src_space == VX_COLOR_SPACE_BT601_625)
-                            yuv2rgb_bt601(luma[0],cb[0],cr[0],&rgb[0],&rgb[1],&rgb[2]);
-                        else if (src_space == VX_COLOR_SPACE_BT709)
-                            yuv2rgb_bt709(luma[0],cb[0],cr[0],&rgb[0],&rgb[1],&rgb[2]);
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_NV12)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                        vx_uint8 *cb   = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                        vx_uint8 *cr   = vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]);
-                        vx_uint8 *nv12[2] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1])};
-                        nv12[0][0] = luma[0];
-                        nv12[1][0] = cb[0];
-                        nv12[1][1] = cr[1];
-                    }
-                }
-            }
-            else if (dst_format == FOURCC_YUV4)
-            {
-                for (y = 0; y < dst_addr[0].dim_y; y++)
-                {
-                    for (x = 0; x < dst_addr[0].dim_x; x++)
-                    {
-                        vx_uint8 *luma[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                             vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0])};
-                        vx_uint8 *cb[2]   = {vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]),
-                                             vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1])};
-                        vx_uint8 *cr[2]   = {vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]),
-                                             vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2])};
-                        luma[1][0] = luma[0][0];
-                        cb[1][0] = cb[0][0];
-                        cr[1][0] = cr[0][0];
-                    }
-                }
-            }
+            cc = &header;
+            vxColorHeader(cc, node, src, dst);
         }
+        if (cc->pair == NULL)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Color Convert does not support %08x to %08x!\n", cc->src, cc->dst);
+            return VX_ERROR_NOT_SUPPORTED;
+        }
+
         status = VX_SUCCESS;
+        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_PLANES, &src_planes, sizeof(src_planes));
+        status |= vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_PLANES, &dst_planes, sizeof(dst_planes));
+        memset(&run, 0, sizeof(run));
+        run.cc = cc;
+        rect = vxCreateRectangle(vxGetContext(src), 0, 0, cc->width, cc->height);
+        for (p = 0; p < src_planes; p++)
+        {
+            status |= vxAccessImagePatch(src, rect, p, &run.src_addr[p], &run.src_base[p]);
+        }
+        for (p = 0; p < dst_planes; p++)
+        {
+            status |= vxAccessImagePatch(dst, rect, p, &run.dst_addr[p], &run.dst_base[p]);
+        }
+        if (status == VX_SUCCESS)
+        {
+            vxRunBands(node, cc->count, (cc->height + 1) / 2, vxColorBand, &run);
+        }
+        else
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Failed to setup images in Color Convert!\n");
+        }
         for (p = 0; p < src_planes; p++)
         {
-            status |= vxCommitImagePatch(src, 0, p, &src_addr[p], src_base[p]);
+            status |= vxCommitImagePatch(src, 0, p, &run.src_addr[p], run.src_base[p]);
         }
         for (p = 0; p < dst_planes; p++)
         {
-            status |= vxCommitImagePatch(dst, rect, p, &dst_addr[p], dst_base[p]);
+            status |= vxCommitImagePatch(dst, rect, p, &run.dst_addr[p], run.dst_base[p]);
         }
         if (status != VX_SUCCESS)
         {
@@ -640,6 +596,42 @@ static vx_status vxColorConvertKernel(vx_node node, vx_reference *parameters, vx
     return status;
 }
 
+/*! \brief Selects the conversion at each verification, as the local data of the node. */
+static vx_status vxColorConvertInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 2)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[1];
+        void *local = NULL;
+        vx_size size = sizeof(vx_color_convert_t), local_size = 0;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        if (local && (local_size >= size))
+        {
+            /* verified again, the images may have changed */
+            vxColorHeader((vx_color_convert_t *)local, node, src, dst);
+        }
+        else if (local == NULL)
+        {
+            local = calloc(1, size);
+            if (local)
+            {
+                vxColorHeader((vx_color_convert_t *)local, node, src, dst);
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+    }
+    return status;
+}
 static vx_status vxColorConvertInputValidator(vx_node node, vx_uint32 index)
 {
     vx_status status = VX_SUCCESS;
@@ -663,6 +655,8 @@ static vx_status vxColorConvertInputValidator(vx_node node, vx_uint32 index)
                 {
                     case FOURCC_RGB:  /* 8:8:8 interleaved */
                     case FOURCC_RGBX: /* 8:8:8:8 interleaved */
+                    case FOURCC_YUV4: /* 4:4:4 planar */
+                    case FOURCC_NV12: /* 4:2:0 co-planar*/
                     case FOURCC_NV21: /* 4:2:0 co-planar*/
                     case FOURCC_IYUV: /* 4:2:0 planar */
                         if (height & 1)
@@ -701,35 +695,6 @@ static vx_status vxColorConvertInputValidator(vx_node node, vx_uint32 index)
     return status;
 }
 
-static vx_fourcc color_combos[][2] = {
-        /* {src, dst} */
-        {FOURCC_RGB, FOURCC_NV12},
-        {FOURCC_RGB, FOURCC_YUV4},
-        {FOURCC_RGB, FOURCC_IYUV},
-        {FOURCC_RGBX,FOURCC_NV12},
-        {FOURCC_RGBX,FOURCC_YUV4},
-        {FOURCC_RGBX,FOURCC_IYUV},
-        {FOURCC_NV21,FOURCC_RGB},
-        {FOURCC_NV21,FOURCC_RGBX},
-        {FOURCC_NV21,FOURCC_NV12},
-        {FOURCC_NV21,FOURCC_YUV4},
-        {FOURCC_NV21,FOURCC_IYUV},
-        {FOURCC_UYVY,FOURCC_RGB},
-        {FOURCC_UYVY,FOURCC_RGBX},
-        {FOURCC_UYVY,FOURCC_NV12},
-        {FOURCC_UYVY,FOURCC_YUV4},
-        {FOURCC_UYVY,FOURCC_IYUV},
-        {FOURCC_YUYV,FOURCC_RGB},
-        {FOURCC_YUYV,FOURCC_RGBX},
-        {FOURCC_YUYV,FOURCC_NV12},
-        {FOURCC_YUYV,FOURCC_YUV4},
-        {FOURCC_YUYV,FOURCC_IYUV},
-        {FOURCC_IYUV,FOURCC_RGB},
-        {FOURCC_IYUV,FOURCC_RGBX},
-        {FOURCC_IYUV,FOURCC_NV12},
-        {FOURCC_IYUV,FOURCC_YUV4},
-};
-
 static vx_status vxColorConvertOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
@@ -750,19 +715,13 @@ static vx_status vxColorConvertOutputValidator(vx_node node, vx_uint32 index, vx
                 vxQueryImage(output, VX_IMAGE_ATTRIBUTE_FORMAT, &dst, sizeof(dst));
                 if (dst != FOURCC_VIRT) /* can't be a unspecified format */
                 {
-                    vx_uint32 i = 0;
-                    for (i = 0; i < dimof(color_combos); i++)
+                    if (vxColorPair(src, dst))
                     {
-                        if ((color_combos[i][0] == src) &&
-                            (color_combos[i][1] == dst))
-                        {
-                            ptr->type = VX_TYPE_IMAGE;
-                            ptr->dim.image.format = dst;
-                            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &ptr->dim.image.width, sizeof(ptr->dim.image.width));
-                            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &ptr->dim.image.height, sizeof(ptr->dim.image.height));
-                            status = VX_SUCCESS;
-                            break;
-                        }
+                        ptr->type = VX_TYPE_IMAGE;
+                        ptr->dim.image.format = dst;
+                        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &ptr->dim.image.width, sizeof(ptr->dim.image.width));
+                        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &ptr->dim.image.height, sizeof(ptr->dim.image.height));
+                        status = VX_SUCCESS;
                     }
                 }
             }
@@ -791,7 +750,7 @@ vx_kernel_description_t colorconvert_kernel = {
     color_convert_kernel_params, dimof(color_convert_kernel_params),
     vxColorConvertInputValidator,
     vxColorConvertOutputValidator,
-    NULL,
+    vxColorConvertInitializer,
     NULL,
 };
 
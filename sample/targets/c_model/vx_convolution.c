@@ -87,12 +87,14 @@ static vx_status vxConvolveKernel(vx_node node, vx_reference *parameters, vx_uin
                             for (i = 0, x1 = (x - (vx_uint32)dims2[0]); i < (vx_uint32)dims[0]; i++, x1++)
                             {
                                 vx_uint8 *srcp = vxFormatImagePatchAddress2d(src_base, x1, y1, &src_addr);
-                                sum += mat[j*dims[1] + i] * (*srcp);
+                                sum += mat[j*dims[0] + i] * (*srcp);
                             }
                         }
-                        value = sum / div;
+                        value = sum / (vx_int32)div;
                         if (value > UINT8_MAX)
                             value = UINT8_MAX;
+                        else if (value < 0)
+                            value = 0;
                         *dstp = (vx_uint8)value;
                     }
                     else if (format == FOURCC_U8 && format2 == FOURCC_S16)
@@ -104,10 +106,10 @@ static vx_status vxConvolveKernel(vx_node node, vx_reference *parameters, vx_uin
                             for (i = 0, x1 = (x - (vx_uint32)dims2[0]); i < (vx_uint32)dims[0]; i++, x1++)
                             {
                                 vx_uint8 *srcp = vxFormatImagePatchAddress2d(src_base, x1, y1, &src_addr);
-                                sum += mat[j*dims[1] + i] * (*srcp);
+                                sum += mat[j*dims[0] + i] * (*srcp);
                             }
                         }
-                        value = sum / div;
+                        value = sum / (vx_int32)div;
                         if (value > INT16_MAX)
                             value = INT16_MAX;
                         else if (value < INT16_MIN)
@@ -123,10 +125,10 @@ static vx_status vxConvolveKernel(vx_node node, vx_reference *parameters, vx_uin
                             for (i = 0, x1 = (x - (vx_uint32)dims2[0]); i < (vx_uint32)dims[0]; i++, x1++)
                             {
                                 vx_int16 *srcp = vxFormatImagePatchAddress2d(src_base, x1, y1, &src_addr);
-                                sum += mat[j*dims[1] + i] * (*srcp);
+                                sum += mat[j*dims[0] + i] * (*srcp);
                             }
                         }
-                        value = sum / div;
+                        value = sum / (vx_int32)div;
                         if (value > INT16_MAX)
                             value = INT16_MAX;
                         else if (value < INT16_MIN)
@@ -224,7 +226,10 @@ static vx_status vxConvolveOutputValidator(vx_node node, vx_uint32 index, vx_met
                 if (format == FOURCC_U8 || format == FOURCC_S16)
                 {
                     ptr->type = VX_TYPE_IMAGE;
-                    ptr->dim.image.format = FOURCC_S16;
+                    if (format == FOURCC_U8 && format2 == FOURCC_U8)
+                        ptr->dim.image.format = FOURCC_U8;
+                    else
+                        ptr->dim.image.format = FOURCC_S16; /* virtual images, too */
                     ptr->dim.image.width = width;
                     ptr->dim.image.height = height;
                     status = VX_SUCCESS;
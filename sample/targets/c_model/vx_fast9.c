@@ -32,27 +32,14 @@
 
 #include <vx_internal.h>
 
-#define PERMUTATIONS 16
+/*! \brief The radius of the Bresenham circle around each pixel. */
 #define APERTURE 3
 
-static vx_uint8 indexes[PERMUTATIONS][9] = {
-    { 0, 1, 2, 3, 4, 5, 6, 7, 8},
-    {15, 0, 1, 2, 3, 4, 5, 6, 7},
-    {14,15, 0, 1, 2, 3, 4, 5, 6},
-    {13,14,15, 0, 1, 2, 3, 4, 5},
-    {12,13,14,15, 0, 1, 2, 3, 4},
-    {11,12,13,14,15, 0, 1, 2, 3},
-    {10,11,12,13,14,15, 0, 1, 2},
-    { 9,10,11,12,13,14,15, 0, 1},
-    { 8, 9,10,11,12,13,14,15, 0},
-    { 7, 8, 9,10,11,12,13,14,15},
-    { 6, 7, 8, 9,10,11,12,13,14},
-    { 5, 6, 7, 8, 9,10,11,12,13},
-    { 4, 5, 6, 7, 8, 9,10,11,12},
-    { 3, 4, 5, 6, 7, 8, 9,10,11},
-    { 2, 3, 4, 5, 6, 7, 8, 9,10},
-    { 1, 2, 3, 4, 5, 6, 7, 8, 9},
-};
+/*! \brief The number of contiguous pixels of the circle which make a corner. */
+#define VX_FAST9_ARC (9)
+
+/*! \brief The first number of corners the output array holds. */
+#define VX_FAST9_POINTS (1024)
 
 /* offsets from "p" */
 static vx_int32 offsets[16][2] = {
@@ -74,6 +61,102 @@ static vx_int32 offsets[16][2] = {
     { -1, -3},
 };
 
+/*! \brief Tells whether a 16 bit mask of the circle has 9 contiguous bits, wrapping around. */
+static vx_bool vxFast9Arc(vx_uint32 mask)
+{
+    vx_uint32 m = mask | (mask << 16);
+    vx_uint32 a = m & (m >> 1);
+    a &= a >> 2;
+    a &= a >> 4;
+    a &= m >> 8;
+    return (a != 0) ? vx_true_e : vx_false_e;
+}
+
+/*! \brief Computes the score of a pixel, or zero when it is not a corner.
+ * \details The score is the largest difference which all the pixels of some
+ * arc of 9 exceed or reach, in the same direction, so a corner at a threshold
+ * t always scores above t.
+ */
+static vx_uint8 vxFast9Score(const vx_uint8 *ptr, const vx_int32 circle[16], vx_int32 threshold)
+{
+    vx_int32 p = ptr[0], diff[16], best = 0, i, j;
+    vx_uint32 bright = 0, dark = 0;
+
+    /* the high speed test: an arc of 9 covers two neighboring compass points */
+    for (i = 0; i < 16; i += 4)
+    {
+        vx_int32 d = ptr[circle[i]] - p;
+        bright |= (vx_uint32)(d > threshold) << (i / 4);
+        dark |= (vx_uint32)(d < -threshold) << (i / 4);
+    }
+    if (((bright & ((bright >> 1) | (bright << 3))) | (dark & ((dark >> 1) | (dark << 3)))) == 0)
+        return 0;
+    bright = 0;
+    dark = 0;
+    for (i = 0; i < 16; i++)
+    {
+        diff[i] = ptr[circle[i]] - p;
+        bright |= (vx_uint32)(diff[i] > threshold) << i;
+        dark |= (vx_uint32)(diff[i] < -threshold) << i;
+    }
+    if (!vxFast9Arc(bright) && !vxFast9Arc(dark))
+        return 0;
+    for (i = 0; i < 16; i++)
+    {
+        vx_int32 lo = 255, hi = -255;
+        for (j = 0; j < VX_FAST9_ARC; j++)
+        {
+            vx_int32 d = diff[(i + j) & 15];
+            lo = d < lo ? d : lo;
+            hi = d > hi ? d : hi;
+        }
+        best = lo > best ? lo : best;
+        best = -hi > best ? -hi : best;
+    }
+    return (vx_uint8)best;
+}
+
+/*! \brief A growable array of corners. */
+typedef struct _vx_fast9_points_t {
+    vx_keypoint_t *points;
+    vx_size count;
+    vx_size capacity;
+} vx_fast9_points_t;
+
+static vx_bool vxFast9AddPoint(vx_fast9_points_t *out, vx_int32 x, vx_int32 y, vx_uint8 score)
+{
+    if (out->count == out->capacity)
+    {
+        vx_size capacity = out->capacity ? 2 * out->capacity : VX_FAST9_POINTS;
+        vx_keypoint_t *points = (vx_keypoint_t *)realloc(out->points, capacity * sizeof(vx_keypoint_t));
+        if (points == NULL)
+            return vx_false_e;
+        out->points = points;
+        out->capacity = capacity;
+    }
+    memset(&out->points[out->count], 0, sizeof(vx_keypoint_t));
+    out->points[out->count].x = x;
+    out->points[out->count].y = y;
+    out->points[out->count].strength = (vx_float32)score;
+    out->points[out->count].tracking_status = 1;
+    out->count++;
+    return vx_true_e;
+}
+
+/*! \brief Scores row y of the image, which is all zero outside of the rows and columns which may hold corners. */
+static void vxFast9ScoreRow(vx_uint8 *scores, void *base, vx_imagepatch_addressing_t *addr,
+                            const vx_int32 circle[16], vx_int32 threshold, vx_int32 y)
+{
+    vx_int32 x, w = (vx_int32)addr->dim_x;
+    memset(scores, 0, w);
+    if ((y >= APERTURE) && (y < (vx_int32)addr->dim_y - APERTURE))
+    {
+        const vx_uint8 *row = vxFormatImagePatchAddress2d(base, 0, y, addr);
+        for (x = APERTURE; x < w - APERTURE; x++)
+            scores[x] = vxFast9Score(&row[x * addr->stride_x], circle, threshold);
+    }
+}
+
 vx_status vxFast9CornersKernel(vx_node node, vx_reference parameters[], vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
@@ -82,106 +165,80 @@ vx_status vxFast9CornersKernel(vx_node node, vx_reference parameters[], vx_uint3
         vx_image src = (vx_image)parameters[0];
         vx_scalar sens = (vx_scalar)parameters[1];
         vx_scalar nonm = (vx_scalar)parameters[2];
-        vx_list points = (vx_image)parameters[3];
+        vx_list points = (vx_list)parameters[3];
         vx_float32 b = 0.0f;
+        vx_bool nonmax = vx_false_e;
         vx_imagepatch_addressing_t src_addr;
         void *src_base = NULL;
         vx_rectangle rect = 0;
         vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
-        vx_uint8 tolerance = 0;
+        vx_int32 tolerance = 0;
+        vx_fast9_points_t out = {NULL, 0, 0};
 
         status = VX_SUCCESS;
         rect = vxGetValidRegionImage(src);
         status |= vxAccessScalarValue(sens, &b);
-        /* remove any pre-existing points */
-        status |= vxEmptyList(points);
+        status |= vxAccessScalarValue(nonm, &nonmax);
         status |= vxAccessImagePatch(src, rect, 0, &src_addr, &src_base);
         status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
-        tolerance = (vx_uint8)(b * UINT8_MAX);
+        tolerance = (vx_int32)(b * UINT8_MAX);
         if (status == VX_SUCCESS)
         {
             /*! \todo implement other Fast9 Corners border modes */
             if (borders.mode == VX_BORDER_MODE_UNDEFINED)
             {
-                vx_int32 y, x, a, i;
-                for (y = APERTURE; y < (src_addr.dim_y - APERTURE); y++)
+                vx_int32 w = (vx_int32)src_addr.dim_x, h = (vx_int32)src_addr.dim_y;
+                vx_int32 circle[16], x, y, i;
+                /* the scores of three rows, zero outside of the corners' region */
+                vx_uint8 *scores = (vx_uint8 *)calloc(3, w > 0 ? w : 1);
+
+                for (i = 0; i < 16; i++)
+                    circle[i] = offsets[i][1] * src_addr.stride_y + offsets[i][0] * src_addr.stride_x;
+                if (scores == NULL)
+                    status = VX_ERROR_NO_MEMORY;
+                if (status == VX_SUCCESS)
                 {
-                    for (x = APERTURE; x < (src_addr.dim_x - APERTURE); x++)
+                    vxFast9ScoreRow(&scores[((APERTURE - 1) % 3) * w], src_base, &src_addr, circle, tolerance, APERTURE - 1);
+                    vxFast9ScoreRow(&scores[(APERTURE % 3) * w], src_base, &src_addr, circle, tolerance, APERTURE);
+                }
+                for (y = APERTURE; (y < h - APERTURE) && (status == VX_SUCCESS); y++)
+                {
+                    const vx_uint8 *s0 = &scores[((y - 1) % 3) * w];
+                    const vx_uint8 *s1 = &scores[(y % 3) * w];
+                    vx_uint8 *s2 = &scores[((y + 1) % 3) * w];
+
+                    vxFast9ScoreRow(s2, src_base, &src_addr, circle, tolerance, y + 1);
+                    for (x = APERTURE; x < w - APERTURE; x++)
                     {
-                        vx_uint8 *ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                        vx_uint8 p = *ptr;
-                        for (a = 0; a < PERMUTATIONS; a++)
+                        vx_uint8 s = s1[x];
+                        if (s == 0)
+                            continue;
+                        /* ties keep the corner which comes first */
+                        if (nonmax &&
+                            ((s <= s0[x - 1]) || (s <= s0[x]) || (s <= s0[x + 1]) || (s <= s1[x - 1]) ||
+                             (s < s1[x + 1]) || (s < s2[x - 1]) || (s < s2[x]) || (s < s2[x + 1])))
+                            continue;
+                        if (vxFast9AddPoint(&out, x, y, s) == vx_false_e)
                         {
-                            vx_bool isacorner = vx_true_e;
-                            for (i = 0; i < dimof(indexes[a]); i++)
-                            {
-                                vx_uint8 j = indexes[a][i];
-                                vx_uint8 *vptr = vxFormatImagePatchAddress2d(
-                                            src_base,
-                                            x+offsets[j][0],
-                                            y+offsets[j][1],
-                                            &src_addr);
-                                vx_uint8 v = *vptr;
-                                if (v < (p + tolerance))
-                                {
-                                    isacorner = vx_false_e;
-                                }
-                            }
-                            if (isacorner == vx_true_e)
-                            {
-                                vx_keypoint key = vxCreateKeypoint(vxGetContext(node));
-                                vx_keypoint_t kp, *pkp = &kp;
-                                printf("Permutation[%d] is corner at x,y={%d,%d}!\n",a,x,y);
-                                status |= vxAccessKeypoint(key, &pkp);
-                                kp.x = x;
-                                kp.y = y;
-                                /* \todo find the strengh of the keypoint */
-                                status |= vxCommitKeypoint(key, pkp);
-                                status |= vxAddListItem(points, key);
-                                vxReleaseKeypoint(&key);
-                                break;
-                            }
-                            isacorner = vx_true_e;
-                            for (i = 0; i < dimof(indexes[a]); i++)
-                            {
-                                vx_uint8 j = indexes[a][i];
-                                vx_uint8 *vptr = vxFormatImagePatchAddress2d(
-                                            src_base,
-                                            x+offsets[j][0],
-                                            y+offsets[j][1],
-                                            &src_addr);
-                                vx_uint8 v = *vptr;
-                                if (v > (p - tolerance))
-                                {
-                                    isacorner = vx_false_e;
-                                }
-                            }
-                            if (isacorner == vx_true_e)
-                            {
-                                vx_keypoint key = vxCreateKeypoint(vxGetContext(node));
-                                vx_keypoint_t kp, *pkp = &kp;
-                                printf("Permutation[%d] is corner at x,y={%d,%d}!\n",a,x,y);
-                                status |= vxAccessKeypoint(key, &pkp);
-                                kp.x = x;
-                                kp.y = y;
-                                /* \todo find the strengh of the keypoint */
-                                status |= vxCommitKeypoint(key, pkp);
-                                status |= vxAddListItem(points, key);
-                                vxReleaseKeypoint(&key);
-                                break;
-                            }
+                            status = VX_ERROR_NO_MEMORY;
+                            break;
                         }
                     }
                 }
+                free(scores);
+                if (status == VX_SUCCESS)
+                    status = vxSetListKeypoints(points, out.points, out.count);
+                free(out.points);
             }
             else
             {
                 status = VX_ERROR_NOT_IMPLEMENTED;
             }
-            status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
         }
+        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
+        vxReleaseRectangle(&rect);
     }
-    return 0;
+    return status;
 }
 
 
@@ -289,7 +346,7 @@ static vx_status vxFast9OutputValidator(vx_node node, vx_uint32 index, vx_meta_f
             {
                 vx_enum type = 0;
                 status = vxQueryList(list, VX_LIST_ATTRIBUTE_TYPE, &type, sizeof(type));
-                if ((status == VX_SUCCESS) && (type == VX_TYPE_COORDINATES))
+                if ((status == VX_SUCCESS) && (type == VX_TYPE_KEYPOINT))
                 {
                     ptr->type = VX_TYPE_LIST;
                     ptr->dim.list.type = type;
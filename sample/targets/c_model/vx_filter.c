@@ -97,7 +97,7 @@ vx_int32 vx_convolve8with16(void *base, vx_uint32 x, vx_uint32 y, vx_imagepatch_
     vx_int32 stride_y = (addr->stride_y * addr->scale_y)/VX_SCALE_UNITY;
     vx_int32 stride_x = (addr->stride_x * addr->scale_x)/VX_SCALE_UNITY;
     vx_uint8 *ptr = (vx_uint8 *)base;
-    vx_uint32 i = (y * stride_y) + (x + stride_x);
+    vx_uint32 i = (y * stride_y) + (x * stride_x);
     vx_uint32 indexes[3][3] = {
         {i - stride_y - stride_x, i - stride_y, i - stride_y + stride_x},
         {i - stride_x,            i,            i + stride_x},
@@ -23,24 +23,444 @@
 
 /*!
  * \file
- * \brief The Filter Kernels.
+ * \brief The Harris Corners Kernel.
  * \author Erik Rainey <erik.rainey@ti.com>
+ *
+ * The scores are computed in one pass over the input, in bands of rows which
+ * run on the context pool. Each band streams the products of the Sobel
+ * gradients through a ring of block size rows, keeps their running column
+ * sums, and slides the block along each row, so that only three rows of
+ * scores are live for the 3x3 non-maximum suppression. The maxima of all
+ * bands are then sorted by strength and thinned to the minimum distance with
+ * a grid of buckets, the strongest first.
  */
 
 #include <VX/vx.h>
-#include <VX/vxu.h>
 #include <VX/vx_helper.h>
-#include <VX/vx_ext_extras.h>
-#include <VX/vx_ext_debug.h>
+
 #include <vx_internal.h>
+#include <math.h>
+
+/*! \brief The scores are reported in units of 2^16 of \f$ M_c \f$, as by the extras Harris score. */
+#define VX_HARRIS_SCALE (65536.0)
+
+/*! \brief The first number of maxima each band holds. */
+#define VX_HARRIS_POINTS (1024)
+
+/*! \brief A growable array of corners. */
+typedef struct _vx_harris_points_t {
+    vx_keypoint_t *points;
+    vx_size count;
+    vx_size capacity;
+} vx_harris_points_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_harris_t {
+    const vx_uint8 *src;
+    vx_imagepatch_addressing_t src_addr;
+    vx_uint32 width;
+    vx_uint32 height;
+    /*! \brief Half the gradient size and half the block size. */
+    vx_int32 rg;
+    vx_int32 rb;
+    const vx_int32 *smooth;
+    const vx_int32 *deriv;
+    vx_float64 k;
+    vx_float64 threshold;
+    /*! \brief The rows of each band, see \ref vxHarrisScratchSize. */
+    vx_uint8 *scratch;
+    vx_size scratch_size;
+    vx_uint32 count;
+    vx_harris_points_t maxima[VX_MAX_BANDS];
+    vx_status status[VX_MAX_BANDS];
+} vx_harris_t;
+
+static const vx_int32 vx_harris_smooth[3][7] = {
+    {1, 2, 1},
+    {1, 4, 6, 4, 1},
+    {1, 6, 15, 20, 15, 6, 1},
+};
+
+static const vx_int32 vx_harris_deriv[3][7] = {
+    {-1, 0, 1},
+    {-1, -2, 0, 2, 1},
+    {-1, -4, -5, 0, 5, 4, 1},
+};
+
+/*! \brief The bytes of the rows of one band: a ring of block size rows of
+ * the three gradient products and their column sums, then the vertical
+ * Sobel sums and a ring of three score rows.
+ */
+static vx_size vxHarrisScratchSize(vx_uint32 width, vx_int32 block_size)
+{
+    return ((((vx_size)block_size + 1) * 3 * sizeof(vx_int64) + 2 * sizeof(vx_int32) + 3 * sizeof(vx_float32)) *
+            width + 7) & ~(vx_size)7;
+}
+
+/*! \brief The bytes of the buckets which find the neighbors of a corner, one
+ * per cell of the minimum distance, which is only needed above one pixel.
+ */
+static vx_size vxHarrisGridSize(vx_uint32 width, vx_uint32 height, vx_float32 min_distance)
+{
+    vx_uint32 cell = (vx_uint32)ceilf(min_distance);
+    if (min_distance <= 1.0f)
+        return 0;
+    return (((vx_size)width / cell + 1) * (height / cell + 1) * sizeof(vx_int32) + 7) & ~(vx_size)7;
+}
+
+static vx_bool vxHarrisAddPoint(vx_harris_points_t *out, vx_int32 x, vx_int32 y, vx_float32 score)
+{
+    if (out->count == out->capacity)
+    {
+        vx_size capacity = out->capacity ? 2 * out->capacity : VX_HARRIS_POINTS;
+        vx_keypoint_t *points = (vx_keypoint_t *)realloc(out->points, capacity * sizeof(vx_keypoint_t));
+        if (points == NULL)
+            return vx_false_e;
+        out->points = points;
+        out->capacity = capacity;
+    }
+    memset(&out->points[out->count], 0, sizeof(vx_keypoint_t));
+    out->points[out->count].x = x;
+    out->points[out->count].y = y;
+    out->points[out->count].strength = score;
+    out->points[out->count].tracking_status = 1;
+    out->count++;
+    return vx_true_e;
+}
+
+/*! \brief Computes the products of the gradients of row y, which are zero
+ * in the columns without a gradient.
+ */
+static void vxHarrisProductRow(vx_harris_t *h, vx_int32 *sx, vx_int32 *dy,
+                               vx_int64 *pxx, vx_int64 *pxy, vx_int64 *pyy, vx_uint32 y)
+{
+    const vx_int32 r = h->rg, k = 2 * r + 1;
+    vx_uint32 x;
+    vx_int32 i;
+
+    /* the vertical halves of the separable Sobel operators */
+    for (x = 0; x < h->width; x++)
+    {
+        sx[x] = 0;
+        dy[x] = 0;
+    }
+    for (i = 0; i < k; i++)
+    {
+        const vx_uint8 *row = h->src + (y + i - r) * h->src_addr.stride_y;
+        const vx_int32 sm = h->smooth[i], dv = h->deriv[i];
+        for (x = 0; x < h->width; x++)
+        {
+            sx[x] += sm * row[x];
+            dy[x] += dv * row[x];
+        }
+    }
+    for (x = 0; x < (vx_uint32)r; x++)
+    {
+        pxx[x] = pxy[x] = pyy[x] = 0;
+        pxx[h->width - 1 - x] = pxy[h->width - 1 - x] = pyy[h->width - 1 - x] = 0;
+    }
+    for (x = r; x < h->width - r; x++)
+    {
+        vx_int64 gx = 0, gy = 0;
+        for (i = 0; i < k; i++)
+        {
+            gx += h->deriv[i] * sx[x + i - r];
+            gy += h->smooth[i] * dy[x + i - r];
+        }
+        pxx[x] = gx * gx;
+        pxy[x] = gx * gy;
+        pyy[x] = gy * gy;
+    }
+}
+
+/*! \brief Slides the block along the column sums and writes the thresholded
+ * scores \f$ V_c \f$ of one row, which are zero outside of [m, width - m).
+ */
+static void vxHarrisScoreRow(vx_harris_t *h, const vx_int64 *cxx, const vx_int64 *cxy, const vx_int64 *cyy,
+                             vx_float32 *score)
+{
+    const vx_uint32 m = (vx_uint32)(h->rg + h->rb), b = (vx_uint32)h->rb;
+    vx_int64 sxx = 0, sxy = 0, syy = 0;
+    vx_uint32 x;
+
+    for (x = m - b; x < m + b; x++)
+    {
+        sxx += cxx[x];
+        sxy += cxy[x];
+        syy += cyy[x];
+    }
+    for (x = m; x < h->width - m; x++)
+    {
+        vx_float64 det, trace, mc;
+        sxx += cxx[x + b];
+        sxy += cxy[x + b];
+        syy += cyy[x + b];
+        det = (vx_float64)sxx * (vx_float64)syy - (vx_float64)sxy * (vx_float64)sxy;
+        trace = (vx_float64)sxx + (vx_float64)syy;
+        mc = (det - h->k * trace * trace) / VX_HARRIS_SCALE;
+        score[x] = (mc > h->threshold) ? (vx_float32)mc : 0.0f;
+        sxx -= cxx[x - b];
+        sxy -= cxy[x - b];
+        syy -= cyy[x - b];
+    }
+}
+
+/*! \brief Keeps the scores of row y which are 3x3 maxima. The rows above
+ * and below are NULL outside of the scores; ties keep the earliest pixel.
+ */
+static void vxHarrisNonMaxRow(vx_harris_t *h, vx_harris_points_t *out, const vx_float32 *above,
+                              const vx_float32 *row, const vx_float32 *below, vx_uint32 y, vx_status *status)
+{
+    const vx_uint32 m = (vx_uint32)(h->rg + h->rb);
+    vx_uint32 x;
+    for (x = m; x < h->width - m; x++)
+    {
+        vx_float32 s = row[x];
+        if ((s <= 0.0f) ||
+            (above && ((s <= above[x - 1]) || (s <= above[x]) || (s <= above[x + 1]))) ||
+            (s <= row[x - 1]) || (s < row[x + 1]) ||
+            (below && ((s < below[x - 1]) || (s < below[x]) || (s < below[x + 1]))))
+            continue;
+        if (vxHarrisAddPoint(out, (vx_int32)x, (vx_int32)y, s) == vx_false_e)
+            *status = VX_ERROR_NO_MEMORY;
+    }
+}
+
+/*! \brief Finds the scored maxima of the rows [y0, y1) of one band. */
+static void vxHarrisBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_harris_t *h = (vx_harris_t *)arg;
+    const vx_uint32 w = h->width, b = (vx_uint32)(2 * h->rb + 1), m = (vx_uint32)(h->rg + h->rb);
+    vx_int64 *ring = (vx_int64 *)(h->scratch + index * h->scratch_size);
+    vx_int64 *sums = ring + 3 * b * w;
+    vx_int32 *sx = (vx_int32 *)(sums + 3 * w);
+    vx_int32 *dy = sx + w;
+    vx_float32 *scores = (vx_float32 *)(dy + w);
+    vx_uint32 s0, s1, x, y, n = 0;
+
+    h->status[index] = VX_SUCCESS;
+    /* the rows which have a score, and the band's neighbors for the suppression */
+    y0 = (y0 > m) ? y0 : m;
+    y1 = (y1 < h->height - m) ? y1 : h->height - m;
+    if (y0 >= y1)
+        return;
+    s0 = (y0 - 1 > m) ? y0 - 1 : m;
+    s1 = (y1 + 1 < h->height - m) ? y1 + 1 : h->height - m;
+    memset(sums, 0, 3 * w * sizeof(vx_int64));
+    memset(scores, 0, 3 * w * sizeof(vx_float32));
+    for (y = s0 - h->rb; y < s1 + h->rb; y++)
+    {
+        /* the product row y replaces the one which left the block */
+        vx_int64 *pxx = &ring[3 * (y % b) * w], *pxy = pxx + w, *pyy = pxy + w;
+        if (n++ >= b)
+        {
+            for (x = 0; x < w; x++)
+            {
+                sums[x] -= pxx[x];
+                sums[w + x] -= pxy[x];
+                sums[2 * w + x] -= pyy[x];
+            }
+        }
+        vxHarrisProductRow(h, sx, dy, pxx, pxy, pyy, y);
+        for (x = 0; x < w; x++)
+        {
+            sums[x] += pxx[x];
+            sums[w + x] += pxy[x];
+            sums[2 * w + x] += pyy[x];
+        }
+        if (n >= b)
+        {
+            /* the block around row s is complete, its row above may now be suppressed */
+            vx_uint32 s = y - h->rb;
+            vxHarrisScoreRow(h, sums, sums + w, sums + 2 * w, &scores[(s % 3) * w]);
+            if ((s > y0) && (s <= y1))
+            {
+                vxHarrisNonMaxRow(h, &h->maxima[index],
+                                  (s - 1 > s0) ? &scores[((s - 2) % 3) * w] : NULL,
+                                  &scores[((s - 1) % 3) * w], &scores[(s % 3) * w], s - 1, &h->status[index]);
+            }
+        }
+    }
+    /* the last row of the scores has nothing below it */
+    if (s1 == y1)
+    {
+        vxHarrisNonMaxRow(h, &h->maxima[index],
+                          (y1 - 1 > s0) ? &scores[((y1 - 2) % 3) * w] : NULL,
+                          &scores[((y1 - 1) % 3) * w], NULL, y1 - 1, &h->status[index]);
+    }
+}
+
+/*! \brief Orders the corners by falling strength, then in raster order. */
+static int vxHarrisCompare(const void *a, const void *b)
+{
+    const vx_keypoint_t *pa = (const vx_keypoint_t *)a, *pb = (const vx_keypoint_t *)b;
+    if (pa->strength != pb->strength)
+        return (pa->strength > pb->strength) ? -1 : 1;
+    if (pa->y != pb->y)
+        return (pa->y < pb->y) ? -1 : 1;
+    return (pa->x > pb->x) - (pa->x < pb->x);
+}
+
+/*! \brief Keeps, strongest first, the corners which are at least min_distance
+ * from every corner kept before them, and returns how many were kept.
+ * \details The kept corners are chained into the buckets of the grid, which
+ * has one cell per min_distance and starts empty; only the cells which were
+ * used are emptied again.
+ */
+static vx_size vxHarrisMinDistance(vx_keypoint_t *points, vx_size count, vx_int32 *next, vx_int32 *grid,
+                                   vx_uint32 width, vx_uint32 height, vx_float32 min_distance)
+{
+    const vx_uint32 cell = (vx_uint32)ceilf(min_distance);
+    const vx_uint32 gw = width / cell + 1, gh = height / cell + 1;
+    const vx_float32 d2 = min_distance * min_distance;
+    vx_size i, kept = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        vx_uint32 cx = (vx_uint32)points[i].x / cell, cy = (vx_uint32)points[i].y / cell;
+        vx_uint32 gx0 = cx > 0 ? cx - 1 : 0, gx1 = cx + 1 < gw ? cx + 1 : gw - 1;
+        vx_uint32 gy0 = cy > 0 ? cy - 1 : 0, gy1 = cy + 1 < gh ? cy + 1 : gh - 1;
+        vx_bool found = vx_false_e;
+        vx_uint32 gx, gy;
+        for (gy = gy0; (gy <= gy1) && !found; gy++)
+        {
+            for (gx = gx0; (gx <= gx1) && !found; gx++)
+            {
+                vx_int32 j;
+                for (j = grid[gy * gw + gx]; (j > 0) && !found; j = next[j - 1])
+                {
+                    vx_float32 dx = (vx_float32)(points[j - 1].x - points[i].x);
+                    vx_float32 dy = (vx_float32)(points[j - 1].y - points[i].y);
+                    found = (dx * dx + dy * dy < d2) ? vx_true_e : vx_false_e;
+                }
+            }
+        }
+        if (found == vx_false_e)
+        {
+            points[kept] = points[i];
+            next[kept] = grid[cy * gw + cx];
+            grid[cy * gw + cx] = (vx_int32)++kept;
+        }
+    }
+    for (i = 0; i < kept; i++)
+        grid[((vx_uint32)points[i].y / cell) * gw + (vx_uint32)points[i].x / cell] = 0;
+    return kept;
+}
 
 static vx_status vxHarrisCornersKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
     if (num == 7)
     {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        status = vxProcessGraph(graph);
+        vx_image src = (vx_image)parameters[0];
+        vx_scalar str = (vx_scalar)parameters[1];
+        vx_scalar min = (vx_scalar)parameters[2];
+        vx_scalar sen = (vx_scalar)parameters[3];
+        vx_scalar win = (vx_scalar)parameters[4];
+        vx_scalar blk = (vx_scalar)parameters[5];
+        vx_list list = (vx_list)parameters[6];
+        vx_rectangle rect = vxGetValidRegionImage(src);
+        vx_float32 threshold = 0.0f, min_distance = 0.0f, k = 0.0f;
+        vx_int32 gradient_size = 3, block_size = 3;
+        void *src_base = NULL, *local = NULL;
+        vx_size local_size = 0, size, total = 0, kept = 0, grid_size;
+        vx_uint8 *memory = NULL;
+        vx_keypoint_t *points = NULL;
+        vx_int32 *next = NULL;
+        vx_harris_t h;
+        vx_uint32 i;
+
+        memset(&h, 0, sizeof(h));
+        status = VX_SUCCESS;
+        status |= vxAccessScalarValue(str, &threshold);
+        status |= vxAccessScalarValue(min, &min_distance);
+        status |= vxAccessScalarValue(sen, &k);
+        status |= vxAccessScalarValue(win, &gradient_size);
+        status |= vxAccessScalarValue(blk, &block_size);
+        status |= vxAccessImagePatch(src, rect, 0, &h.src_addr, &src_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        h.src = (const vx_uint8 *)src_base;
+        h.width = h.src_addr.dim_x;
+        h.height = h.src_addr.dim_y;
+        h.rg = gradient_size / 2;
+        h.rb = block_size / 2;
+        h.smooth = vx_harris_smooth[h.rg - 1];
+        h.deriv = vx_harris_deriv[h.rg - 1];
+        h.k = k;
+        h.threshold = threshold;
+        h.count = vxBandCount(node, h.width, h.height);
+        h.scratch_size = vxHarrisScratchSize(h.width, block_size);
+        grid_size = vxHarrisGridSize(h.width, h.height, min_distance);
+        size = grid_size + h.count * h.scratch_size;
+        if ((status == VX_SUCCESS) &&
+            (h.width > 2u * (h.rg + h.rb)) && (h.height > 2u * (h.rg + h.rb)))
+        {
+            /* the grid left by the initializer is kept empty between executions */
+            if (local && (local_size >= size))
+                memory = (vx_uint8 *)local;
+            else
+                memory = (vx_uint8 *)calloc(1, size);
+            if (memory)
+            {
+                h.scratch = memory + grid_size;
+                vxRunBands(node, h.count, h.height, vxHarrisBand, &h);
+                for (i = 0; i < h.count; i++)
+                {
+                    status |= h.status[i];
+                    total += h.maxima[i].count;
+                }
+                /* the maxima of the bands are joined in the array of the first */
+                if ((status == VX_SUCCESS) && (total > h.maxima[0].capacity))
+                {
+                    points = (vx_keypoint_t *)realloc(h.maxima[0].points, total * sizeof(vx_keypoint_t));
+                    if (points)
+                        h.maxima[0].points = points;
+                    else
+                        status = VX_ERROR_NO_MEMORY;
+                }
+                if (status == VX_SUCCESS)
+                {
+                    points = h.maxima[0].points;
+                    kept = h.maxima[0].count;
+                    for (i = 1; i < h.count; i++)
+                    {
+                        if (h.maxima[i].count > 0)
+                            memcpy(&points[kept], h.maxima[i].points, h.maxima[i].count * sizeof(vx_keypoint_t));
+                        kept += h.maxima[i].count;
+                    }
+                    if (kept > 1)
+                        qsort(points, kept, sizeof(vx_keypoint_t), vxHarrisCompare);
+                    if ((grid_size > 0) && (kept > 1))
+                    {
+                        next = (vx_int32 *)malloc(kept * sizeof(vx_int32));
+                        if (next)
+                            kept = vxHarrisMinDistance(points, kept, next, (vx_int32 *)memory,
+                                                       h.width, h.height, min_distance);
+                        else
+                            status = VX_ERROR_NO_MEMORY;
+                    }
+                }
+                if (status == VX_SUCCESS)
+                    status = vxSetListKeypoints(list, points, kept);
+                if (memory == (vx_uint8 *)local)
+                    memory = NULL;
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+        else if (status == VX_SUCCESS)
+        {
+            status = VX_ERROR_INVALID_DIMENSION;
+        }
+        for (i = 0; i < h.count; i++)
+            free(h.maxima[i].points);
+        free(next);
+        free(memory);
+        status |= vxCommitImagePatch(src, 0, 0, &h.src_addr, src_base);
+        vxReleaseRectangle(&rect);
     }
     return status;
 }
@@ -222,89 +642,48 @@ static vx_status vxHarrisOutputValidator(vx_node node, vx_uint32 index, vx_meta_
     return status;
 }
 
+/*! \brief Allocates the grid and the rows of the bands once, as the local data of the node. */
 static vx_status vxHarrisInitializer(vx_node node, vx_reference parameters[], vx_uint32 num)
 {
-    vx_status status = VX_FAILURE;
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
     if (num == 7)
     {
         vx_image src = (vx_image)parameters[0];
-        vx_scalar str = (vx_scalar)parameters[1];
         vx_scalar min = (vx_scalar)parameters[2];
-        vx_scalar sen = (vx_scalar)parameters[3];
-        vx_scalar win = (vx_scalar)parameters[4];
         vx_scalar blk = (vx_scalar)parameters[5];
-        vx_list list = (vx_list)parameters[6];
-        vx_context c = vxGetContext(node);
-        vx_graph g = vxCreateGraph(c);
-        vxLoadKernels(c, "openvx-extras");
-        vxLoadKernels(c, "openvx-debug");
-        if (g)
+        vx_uint32 width = 0, height = 0;
+        vx_float32 min_distance = 0.0f;
+        vx_int32 block_size = 0;
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel allocates
+         * for itself if the image or the parameters have grown since */
+        if (local == NULL)
         {
-            vx_uint32 i = 0;
-            vx_int32 ds = 16;
-            vx_scalar shift = vxCreateScalar(c, VX_TYPE_INT32, &ds);
-            vx_image virts[] = {
-                    vxCreateVirtualImage(c), // Gx
-                    vxCreateVirtualImage(c), // Gy
-                    vxCreateVirtualImage(c), // Score
-                    vxCreateVirtualImage(c), // Suppressed
-                    vxCreateVirtualImageWithFormat(c,FOURCC_S16), // Shifted Suppressed
-            };
-            vx_node sobel = 0;
-            vx_node nodes[] = {
-                    vxSobelMxNNode(g, src, win, virts[0], virts[1]),
-                    vxHarrisScoreNode(g, virts[0], virts[1], sen, blk, virts[2]),
-                    vxEuclideanNonMaxNode(g, virts[2], min, str, virts[3]),
-                    vxConvertDepthNode(g,virts[3],virts[4],VX_CONVERT_POLICY_TRUNCATE,shift),
-                    vxFWriteImageNode(g,virts[4],"o_max.pgm"),
-                    vxImageListerNode(g, virts[3], list),
-            };
-            status = VX_SUCCESS;
-            status |= vxAddParameterToGraphByIndex(g, nodes[0], 0); // src
-            status |= vxAddParameterToGraphByIndex(g, nodes[2], 1); // str
-            status |= vxAddParameterToGraphByIndex(g, nodes[2], 2); // min
-            status |= vxAddParameterToGraphByIndex(g, nodes[1], 2); // sen
-            status |= vxAddParameterToGraphByIndex(g, nodes[0], 1); // win
-            status |= vxAddParameterToGraphByIndex(g, nodes[1], 3); // blk
-            status |= vxAddParameterToGraphByIndex(g, nodes[3], 1);
-            for (i = 0; i < dimof(nodes); i++)
-            {
-                vxReleaseNode(&nodes[i]);
-            }
-            vxReleaseNode(&sobel);
-            for (i = 0; i < dimof(virts); i++)
-            {
-                vxReleaseImage(&virts[i]);
-            }
-            vxReleaseScalar(&shift);
-            VX_PRINT(VX_ZONE_INFO, "Status from Child Graph = %d\n", status);
-            if (status == VX_SUCCESS)
+            vx_size size;
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            vxAccessScalarValue(min, &min_distance);
+            vxAccessScalarValue(blk, &block_size);
+            size = vxHarrisGridSize(width, height, min_distance) +
+                   vxBandCount(node, width, height) * vxHarrisScratchSize(width, block_size);
+            local = calloc(1, size);
+            if (local)
             {
-                status = vxSetChildGraphOfNode(node, g);
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
             }
             else
             {
-                vxReleaseGraph(&g);
-                g = 0;
+                status = VX_ERROR_NO_MEMORY;
             }
         }
     }
     return status;
 }
 
-static vx_status vxHarrisDeinitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
-{
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    if (num == 7)
-    {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        vxReleaseGraph(&graph);
-        graph = 0;
-        vxSetChildGraphOfNode(node, graph);
-    }
-    return status;
-}
-
 static vx_param_description_t harris_kernel_params[] = {
     {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED}, // strength_thresh
@@ -323,6 +702,6 @@ vx_kernel_description_t harris_kernel = {
     vxHarrisInputValidator,
     vxHarrisOutputValidator,
     vxHarrisInitializer,
-    vxHarrisDeinitializer,
+    NULL,
 };
 
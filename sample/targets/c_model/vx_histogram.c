@@ -33,6 +33,227 @@
 
 #include <vx_internal.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*! \brief The number of sub-histograms of each band, so that runs of equal
+ * pixels do not wait on the store of the same bin.
+ */
+#define VX_HISTOGRAM_SUBS (4)
+
+/*! \brief The header of the local data of a node, followed by the bin of every
+ * pixel value and the sub-histograms of every band.
+ */
+typedef struct _vx_histogram_bins_t {
+    vx_fourcc format;
+    vx_uint32 bins, offset, range, window;
+    /*! \brief The number of pixel values, 256 or 65536. */
+    vx_uint32 levels;
+    /*! \brief The number of bands. */
+    vx_uint32 count;
+} vx_histogram_bins_t;
+
+/*! \brief The state of one execution of a kernel, shared by its bands. */
+typedef struct _vx_histogram_run_t {
+    const vx_histogram_bins_t *hb;
+    const vx_uint32 *lut;
+    vx_uint32 *counts;
+    void *src_base;
+    void *dst_base;
+    vx_imagepatch_addressing_t src_addr;
+    vx_imagepatch_addressing_t dst_addr;
+    vx_uint8 map[256];
+} vx_histogram_run_t;
+
+static vx_size vxHistogramHeaderSize(void)
+{
+    return (sizeof(vx_histogram_bins_t) + 15) & ~(vx_size)15;
+}
+
+/*! \brief The counters of a band, with a last bin for the pixels out of range. */
+static vx_size vxHistogramBandSize(const vx_histogram_bins_t *hb)
+{
+    return VX_HISTOGRAM_SUBS * ((vx_size)hb->bins + 1);
+}
+
+static vx_size vxHistogramLocalSize(const vx_histogram_bins_t *hb)
+{
+    return vxHistogramHeaderSize() +
+           ((vx_size)hb->levels + hb->count * vxHistogramBandSize(hb)) * sizeof(vx_uint32);
+}
+
+static void vxHistogramHeader(vx_histogram_bins_t *hb, vx_node node, vx_image image,
+                              vx_uint32 bins, vx_uint32 offset, vx_uint32 range, vx_uint32 window)
+{
+    vx_uint32 width = 0, height = 0;
+    memset(hb, 0, sizeof(*hb));
+    vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &hb->format, sizeof(hb->format));
+    vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+    vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+    hb->bins = bins;
+    hb->offset = offset;
+    hb->range = range;
+    hb->window = window;
+    hb->levels = (hb->format == FOURCC_U16) ? 65536 : 256;
+    hb->count = vxBandCount(node, width, height);
+    if (hb->count > height)
+        hb->count = height;
+    if (hb->count == 0)
+        hb->count = 1;
+}
+
+static void vxHistogramDistributionHeader(vx_histogram_bins_t *hb, vx_node node, vx_image image, vx_distribution dist)
+{
+    vx_uint32 bins = 0, offset = 0, range = 0, window = 0;
+    vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_BINS, &bins, sizeof(bins));
+    vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_OFFSET, &offset, sizeof(offset));
+    vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_RANGE, &range, sizeof(range));
+    vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_WINDOW, &window, sizeof(window));
+    vxHistogramHeader(hb, node, image, bins, offset, range, window);
+}
+
+/*! \brief Fills the bin of every pixel value, which for the values out of the
+ * range of the distribution is the last bin of the counters.
+ */
+static void vxHistogramBuild(const vx_histogram_bins_t *hb, vx_uint32 *lut)
+{
+    vx_uint32 v;
+    for (v = 0; v < hb->levels; v++)
+    {
+        vx_uint32 bin = hb->bins;
+        if ((hb->window > 0) && (v >= hb->offset) && (v - hb->offset < hb->range))
+        {
+            bin = (v - hb->offset) / hb->window;
+            if (bin > hb->bins)
+                bin = hb->bins;
+        }
+        lut[v] = bin;
+    }
+}
+
+/*! \brief Finds or builds the local data of a node for the header, or
+ * allocates it if the node has none which fits.
+ * \return The local data, which the caller frees if it is not the one of the node.
+ */
+static vx_histogram_bins_t *vxHistogramLocal(vx_node node, const vx_histogram_bins_t *header)
+{
+    vx_histogram_bins_t *hb = NULL;
+    void *local = NULL;
+    vx_size local_size = 0;
+
+    vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+    vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+    if (local && (local_size >= vxHistogramLocalSize(header)))
+    {
+        hb = (vx_histogram_bins_t *)local;
+        if (memcmp(hb, header, sizeof(*header)) == 0)
+            return hb;
+    }
+    else
+    {
+        hb = (vx_histogram_bins_t *)calloc(1, vxHistogramLocalSize(header));
+    }
+    if (hb)
+    {
+        *hb = *header;
+        vxHistogramBuild(hb, (vx_uint32 *)((vx_uint8 *)hb + vxHistogramHeaderSize()));
+    }
+    return hb;
+}
+
+/*! \brief Allocates and builds the local data of a node once. */
+static vx_status vxHistogramSetLocal(vx_node node, const vx_histogram_bins_t *header)
+{
+    vx_status status = VX_SUCCESS;
+    void *local = NULL;
+
+    vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+    /* a second verification may not alter the node, the kernel builds the
+     * bins again if the distribution has changed since */
+    if (local == NULL)
+    {
+        vx_size size = vxHistogramLocalSize(header);
+        local = calloc(1, size);
+        if (local)
+        {
+            *(vx_histogram_bins_t *)local = *header;
+            vxHistogramBuild(header, (vx_uint32 *)((vx_uint8 *)local + vxHistogramHeaderSize()));
+            status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+            status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        }
+        else
+        {
+            status = VX_ERROR_NO_MEMORY;
+        }
+    }
+    return status;
+}
+
+/*! \brief Counts the pixels of the rows of a band into its own sub-histograms. */
+static void vxHistogramBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_histogram_run_t *run = (vx_histogram_run_t *)arg;
+    const vx_uint32 *lut = run->lut;
+    vx_uint32 stride = run->hb->bins + 1;
+    vx_uint32 *h0 = &run->counts[index * vxHistogramBandSize(run->hb)];
+    vx_uint32 *h1 = h0 + stride, *h2 = h1 + stride, *h3 = h2 + stride;
+    vx_uint32 x, y, w = run->src_addr.dim_x;
+
+    memset(h0, 0, vxHistogramBandSize(run->hb) * sizeof(vx_uint32));
+    for (y = y0; y < y1; y++)
+    {
+        if (run->hb->format == FOURCC_U16)
+        {
+            const vx_uint16 *p = vxFormatImagePatchAddress2d(run->src_base, 0, y, &run->src_addr);
+            for (x = 0; x + 4 <= w; x += 4)
+            {
+                h0[lut[p[x + 0]]]++;
+                h1[lut[p[x + 1]]]++;
+                h2[lut[p[x + 2]]]++;
+                h3[lut[p[x + 3]]]++;
+            }
+            for (; x < w; x++)
+                h0[lut[p[x]]]++;
+        }
+        else
+        {
+            const vx_uint8 *p = vxFormatImagePatchAddress2d(run->src_base, 0, y, &run->src_addr);
+            for (x = 0; x + 4 <= w; x += 4)
+            {
+                h0[lut[p[x + 0]]]++;
+                h1[lut[p[x + 1]]]++;
+                h2[lut[p[x + 2]]]++;
+                h3[lut[p[x + 3]]]++;
+            }
+            for (; x < w; x++)
+                h0[lut[p[x]]]++;
+        }
+    }
+}
+
+/*! \brief Counts the mapped source of a run into the bins of the header over
+ * bands of rows, and sums the sub-histograms of the bands into hist.
+ */
+static void vxHistogramCount(vx_node node, vx_histogram_run_t *run, vx_histogram_bins_t *hb, vx_int32 *hist)
+{
+    vx_uint32 b, i, count = hb->count, height = run->src_addr.dim_y;
+
+    run->hb = hb;
+    run->lut = (const vx_uint32 *)((vx_uint8 *)hb + vxHistogramHeaderSize());
+    run->counts = (vx_uint32 *)run->lut + hb->levels;
+    if (count > height)
+        count = height;
+    memset(hist, 0, hb->bins * sizeof(vx_int32));
+    if (count == 0)
+        return;
+    vxRunBands(node, count, height, vxHistogramBand, run);
+    for (i = 0; i < count * VX_HISTOGRAM_SUBS; i++)
+    {
+        const vx_uint32 *h = &run->counts[i * (hb->bins + 1)];
+        for (b = 0; b < hb->bins; b++)
+            hist[b] += (vx_int32)h[b];
+    }
+}
 
 static vx_status vxHistogramKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
@@ -40,68 +261,72 @@ static vx_status vxHistogramKernel(vx_node node, vx_reference *parameters, vx_ui
     if (num == 2)
     {
         vx_image src_image = (vx_image)parameters[0];
-        vx_distribution dist = (vx_scalar)parameters[1];
+        vx_distribution dist = (vx_distribution)parameters[1];
         vx_rectangle src_rect;
-        vx_imagepatch_addressing_t src_addr;
-        void *src_base = NULL, *dist_ptr = NULL;
-        vx_fourcc format = 0;
-        vx_uint32 y = 0, x = 0;
-        vx_uint32 offset = 0, range = 0, numBins = 0, window_size = 0;
-
-        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
-        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_BINS, &numBins, sizeof(numBins));
-        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_RANGE, &range, sizeof(range));
-        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_OFFSET, &offset, sizeof(offset));
-        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_WINDOW, &window_size, sizeof(window_size));
+        void *dist_ptr = NULL;
+        vx_histogram_bins_t header, *hb = NULL;
+        vx_histogram_run_t run;
+
+        memset(&run, 0, sizeof(run));
+        vxHistogramDistributionHeader(&header, node, src_image, dist);
         src_rect = vxGetValidRegionImage(src_image);
         status = VX_SUCCESS;
-        status |= vxAccessImagePatch(src_image, src_rect, 0, &src_addr, &src_base);
+        status |= vxAccessImagePatch(src_image, src_rect, 0, &run.src_addr, &run.src_base);
         status |= vxAccessDistribution(dist, &dist_ptr);
-        printf("distribution:%p bins:%u off:%u ws:%u range:%u\n", dist_ptr, numBins, offset, window_size, range);
         if (status == VX_SUCCESS)
         {
-            vx_int32 *dist_tmp = dist_ptr;
-
-            /* clear the distribution */
-            for (x = 0; x < numBins; x++)
+            hb = vxHistogramLocal(node, &header);
+            if (hb)
             {
-                dist_tmp[x] = 0;
+                vxHistogramCount(node, &run, hb, (vx_int32 *)dist_ptr);
             }
-
-            for (y = 0; y < src_addr.dim_y; y++)
+            else
             {
-                for (x = 0; x < src_addr.dim_x; x++)
-                {
-                    if (format == FOURCC_U8)
-                    {
-                        vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                        vx_uint8 pixel = *src_ptr;
-                        if ((offset <= (vx_size)pixel) && ((vx_size)pixel < (offset+range)))
-                        {
-                            vx_size index = (pixel - (vx_uint16)offset) / window_size;
-                            dist_tmp[index]++;
-                        }
-                    }
-                    else if (format == FOURCC_U16)
-                    {
-                        vx_uint16 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                        vx_uint16 pixel = *src_ptr;
-                        if ((offset <= (vx_size)pixel) && ((vx_size)pixel < (offset+range)))
-                        {
-                            vx_size index = (pixel - (vx_uint16)offset) / window_size;
-                            dist_tmp[index]++;
-                        }
-                    }
-                }
+                status = VX_ERROR_NO_MEMORY;
             }
         }
         status |= vxCommitDistribution(dist, dist_ptr);
-        status |= vxCommitImagePatch(src_image, 0, 0, &src_addr, src_base);
-        vxReleaseParameter(&src_rect);
+        status |= vxCommitImagePatch(src_image, 0, 0, &run.src_addr, run.src_base);
+        vxReleaseRectangle(&src_rect);
+        if (hb)
+        {
+            void *local = NULL;
+            vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            if ((void *)hb != local)
+                free(hb);
+        }
+    }
+    return status;
+}
+
+/*! \brief Builds the bins of the distribution once, as the local data of the node. */
+static vx_status vxHistogramInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 2)
+    {
+        vx_histogram_bins_t header;
+        vxHistogramDistributionHeader(&header, node, (vx_image)parameters[0], (vx_distribution)parameters[1]);
+        status = vxHistogramSetLocal(node, &header);
     }
     return status;
 }
 
+/*! \brief Maps the pixels of the rows of a band through the equalization. */
+static void vxEqualizeHistBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_histogram_run_t *run = (vx_histogram_run_t *)arg;
+    vx_uint32 x, y, w = run->src_addr.dim_x;
+    (void)index;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *src = vxFormatImagePatchAddress2d(run->src_base, 0, y, &run->src_addr);
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(run->dst_base, 0, y, &run->dst_addr);
+        for (x = 0; x < w; x++)
+            dst[x] = run->map[src[x]];
+    }
+}
+
 static vx_status vxEqualizeHistKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
@@ -109,81 +334,82 @@ static vx_status vxEqualizeHistKernel(vx_node node, vx_reference *parameters, vx
     {
         vx_image src = (vx_image)parameters[0];
         vx_image dst = (vx_image)parameters[1];
-        vx_uint32 y, x, width = 0, height = 0;
-        void *src_base = NULL;
-        void *dst_base = NULL;
-        vx_imagepatch_addressing_t src_addr, dst_addr;
+        vx_uint32 x, width = 0, height = 0;
+        vx_histogram_bins_t header, *hb = NULL;
+        vx_histogram_run_t run;
         vx_rectangle rect;
 
+        memset(&run, 0, sizeof(run));
+        vxHistogramHeader(&header, node, src, 256, 0, 256, 1);
         status = VX_SUCCESS;
         status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
         status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
         rect = vxCreateRectangle(vxGetContext(node), 0, 0, width, height);
-        status |= vxAccessImagePatch(src, rect, 0, &src_addr, &src_base);
-        status |= vxAccessImagePatch(dst, rect, 0, &dst_addr, &dst_base);
+        status |= vxAccessImagePatch(src, rect, 0, &run.src_addr, &run.src_base);
+        status |= vxAccessImagePatch(dst, rect, 0, &run.dst_addr, &run.dst_base);
         if (status == VX_SUCCESS)
         {
-            /* for 16-bit support (U16 or S16), the code can be duplicated with NUM_BINS = 65536 and PIXEL = vx_uint16. */
-            #define NUM_BINS 256
-
-            /* allocate a fixed-size temp array to store the image histogram & cumulative distribution */
-            vx_uint32 hist[NUM_BINS];
-            vx_uint32 cdf[NUM_BINS];
+            hb = vxHistogramLocal(node, &header);
+        }
+        if (hb)
+        {
+            vx_int32 hist[256];
+            vx_uint32 cdf[256];
             vx_uint32 sum = 0;
             vx_uint32 maxVal = 0;
             vx_float32 scaleFactor = 0.0f;
 
-            /* calculate the distribution (histogram) */
-            memset(hist, 0, sizeof(hist));
-            for (y = 0; y < height; y++)
-            {
-                for (x = 0; x < width; x++)
-                {
-                    vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                    vx_uint8 pixel = *src_ptr;
-                    hist[pixel]++;
-                }
-            }
+            vxHistogramCount(node, &run, hb, hist);
 
             /* calculate the cumulative distribution (summed histogram) */
-            for (x = 0; x < NUM_BINS; x++)
+            for (x = 0; x < 256; x++)
             {
                 cdf[x] = sum;
-                sum += hist[x];
+                sum += (vx_uint32)hist[x];
             }
 
-            /* find the scale factor from the max cdf value */
-            maxVal = cdf[0];
-            for (x = 1; x < NUM_BINS; x++)
-            {
-                if (maxVal < cdf[x])
-                {
-                    maxVal = cdf[x];
-                }
-            }
+            /* the cumulative distribution only grows, the last one is the max */
+            maxVal = cdf[255];
             scaleFactor = 255.0f / (float)maxVal;
-            //printf("* maxVal = %d, scaleFactor = %f\n", maxVal, scaleFactor);
 
-            /* map the src pixel values to the equalized pixel values */
-            for (y = 0; y < height; y++)
+            /* map the pixel values to the equalized pixel values once, then the image */
+            for (x = 0; x < 256; x++)
             {
-                for (x = 0; x < width; x++)
-                {
-                    vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                    vx_uint8 *dst_ptr = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
-                    vx_uint32 equalized_int = cdf[(*src_ptr)];
-                    *dst_ptr = (vx_uint8)(equalized_int * scaleFactor + 0.5f);
-                }
+                run.map[x] = (vx_uint8)(cdf[x] * scaleFactor + 0.5f);
             }
+            vxRunBands(node, hb->count, run.src_addr.dim_y, vxEqualizeHistBand, &run);
+        }
+        else if (status == VX_SUCCESS)
+        {
+            status = VX_ERROR_NO_MEMORY;
         }
 
-        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
-        status |= vxCommitImagePatch(dst, rect, 0, &dst_addr, dst_base);
+        status |= vxCommitImagePatch(src, 0, 0, &run.src_addr, run.src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &run.dst_addr, run.dst_base);
         vxReleaseRectangle(&rect);
+        if (hb)
+        {
+            void *local = NULL;
+            vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            if ((void *)hb != local)
+                free(hb);
+        }
     }
     return status;
 }
 
+/*! \brief Builds the bins of the pixel values once, as the local data of the node. */
+static vx_status vxEqualizeHistInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 2)
+    {
+        vx_histogram_bins_t header;
+        vxHistogramHeader(&header, node, (vx_image)parameters[0], 256, 0, 256, 1);
+        status = vxHistogramSetLocal(node, &header);
+    }
+    return status;
+}
 
 static vx_status vxHistogramInputValidator(vx_node node, vx_uint32 index)
 {
@@ -310,7 +536,7 @@ vx_kernel_description_t histogram_kernel = {
     histogram_kernel_params, dimof(histogram_kernel_params),
     vxHistogramInputValidator,
     vxHistogramOutputValidator,
-    NULL,
+    vxHistogramInitializer,
     NULL,
 };
 
@@ -321,7 +547,7 @@ vx_kernel_description_t equalize_hist_kernel = {
     equalize_hist_kernel_params, dimof(equalize_hist_kernel_params),
     vxEqualizeHistInputValidator,
     vxEqualizeHistOutputValidator,
-    NULL,
+    vxEqualizeHistInitializer,
     NULL,
 };
 
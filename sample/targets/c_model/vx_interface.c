@@ -34,6 +34,8 @@
 #include <vx_interface.h>
 
 vx_status vxTilingKernel(vx_node node, vx_reference parameters[], vx_uint32 num);
+static vx_status vxTilingChainSupported(vx_node_t *nodes[], vx_size num);
+static vx_status vxTilingChainKernel(vx_node_t *nodes[], vx_size num);
 
 static const vx_char name[VX_MAX_TARGET_NAME] = "khronos.c_model";
 
@@ -110,6 +112,7 @@ static vx_kernel_description_t *target_kernels[] = {
     &harris_kernel,
     &fast9_kernel,
     &optpyrlk_kernel,
+    &remap_kernel,
 };
 
 /*! \brief Declares the number of base supported kernels.
@@ -169,6 +172,38 @@ vx_action vxTargetProcess(vx_target_t *target, vx_node_t *nodes[], vx_size start
     vx_action action = VX_ACTION_CONTINUE;
     vx_status status = VX_SUCCESS;
     vx_size n = 0;
+    if ((numNodes > 1) && (nodes[startIndex]->fusedInto == nodes[startIndex + numNodes - 1]))
+    {
+        vx_node_t *leader = nodes[startIndex + numNodes - 1];
+
+        VX_PRINT(VX_ZONE_GRAPH,"Executing %u fused Nodes ending in Kernel %s:%d on target %s\n",
+            numNodes,
+            leader->kernel->name,
+            leader->kernel->enumeration,
+            leader->base.context->targets[leader->affinity].name);
+
+        vxStartCapture(&leader->perf);
+        status = vxTilingChainKernel(&nodes[startIndex], numNodes);
+        vxStopCapture(&leader->perf);
+        VX_TRACE_INTERVAL("node", leader->kernel->name, leader, -1, leader->perf.beg, leader->perf.end);
+
+        for (n = startIndex; (n < (startIndex + numNodes)) && (action == VX_ACTION_CONTINUE); n++)
+        {
+            nodes[n]->executed = vx_true_e;
+            nodes[n]->status = status;
+            if (status != VX_SUCCESS)
+            {
+                action = VX_ACTION_ABANDON;
+                VX_PRINT(VX_ZONE_ERROR, "Abandoning Graph due to error (%d)!\n", status);
+            }
+            else if (nodes[n]->callback)
+            {
+                action = nodes[n]->callback((vx_node)nodes[n]);
+                VX_PRINT(VX_ZONE_GRAPH,"callback returned action %d\n", action);
+            }
+        }
+        return action;
+    }
     for (n = startIndex; (n < (startIndex + numNodes)) && (action == VX_ACTION_CONTINUE); n++)
     {
         VX_PRINT(VX_ZONE_GRAPH,"Executing Kernel %s:%d in Nodes[%u] on target %s\n",
@@ -184,6 +219,7 @@ vx_action vxTargetProcess(vx_target_t *target, vx_node_t *nodes[], vx_size start
         nodes[n]->executed = vx_true_e;
         nodes[n]->status = status;
         vxStopCapture(&nodes[n]->perf);
+        VX_TRACE_INTERVAL("node", nodes[n]->kernel->name, nodes[n], -1, nodes[n]->perf.beg, nodes[n]->perf.end);
 
         VX_PRINT(VX_ZONE_GRAPH,"kernel %s returned %d\n", nodes[n]->kernel->name, status);
 
@@ -205,6 +241,11 @@ vx_action vxTargetProcess(vx_target_t *target, vx_node_t *nodes[], vx_size start
     return action;
 }
 
+vx_status vxTargetFuse(vx_target_t *target, vx_node_t *nodes[], vx_size numNodes)
+{
+    return vxTilingChainSupported(nodes, numNodes);
+}
+
 vx_status vxTargetVerify(vx_target_t *target, vx_node_t *node)
 {
     vx_status status = VX_SUCCESS;
@@ -276,168 +317,691 @@ vx_kernel vxTargetAddTilingKernel(vx_target_t *target,
 }
 
 
-static vx_status vxGetPatchToTile(vx_image image, vx_rectangle rect, vx_tile_t *tile)
+/*! \brief The number of tiles each thread should get, to balance uneven tiles. */
+#define VX_TILES_PER_THREAD (4)
+
+/*! \brief The minimum tile height as a multiple of the neighborhood height, to
+ * keep the rows re-read by adjacent tiles a small fraction of each tile.
+ */
+#define VX_TILE_HALO_RATIO  (4)
+
+/*! \brief The state shared by all tile jobs of one execution of a tiling kernel. */
+typedef struct _vx_tiling_state_t {
+    vx_node_t *node;
+    vx_uint32 num;
+    vx_enum types[VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_PARAMS];
+    /*! \brief Each image accessed as a whole, tiles are offsets into these. */
+    vx_tile_t images[VX_INT_MAX_PARAMS];
+    vx_uint32 planes[VX_INT_MAX_PARAMS];
+    vx_uint32 width;
+    vx_uint32 height;
+    vx_uint32 tileHeight;
+    vx_uint32 numTiles;
+    vx_uint32 numJobs;
+    vx_sem_t done;
+} vx_tiling_state_t;
+
+/*! \brief A thread's share of the tiles, with its own tile memory. */
+typedef struct _vx_tiling_job_t {
+    vx_work_t work;
+    vx_tiling_state_t *state;
+    vx_uint32 index;
+    void *memory;
+} vx_tiling_job_t;
+
+/*! \brief Points a tile descriptor at a region of an already accessed image. */
+static void vxSetTile(vx_tile_t *tile, vx_tile_t *image, vx_uint32 planes,
+                      vx_uint32 tx, vx_uint32 ty, vx_uint32 tw, vx_uint32 th)
 {
-    vx_status status = VX_SUCCESS;
-    vx_uint32 p = 0;
-    vx_image_t *img = (vx_image_t *)image;
-    for (p = 0; p < img->planes; p++)
+    vx_uint32 p;
+    for (p = 0; p < planes; p++)
     {
-        tile->base[p] = NULL;
-        status = vxAccessImagePatch(image, rect, 0, &tile->addr[p], (void **)&tile->base[p]);
+        vx_imagepatch_addressing_t *addr = &image->addr[p];
+        tile->base[p] = image->base[p] +
+                        (addr->stride_y * ((ty * addr->scale_y) / VX_SCALE_UNITY)) +
+                        (addr->stride_x * ((tx * addr->scale_x) / VX_SCALE_UNITY));
+        tile->addr[p].dim_x = tw;
+        tile->addr[p].dim_y = th;
     }
-    return status;
+    tile->tile_x = tx;
+    tile->tile_y = ty;
 }
 
-static vx_status vxSetTileToPatch(vx_image image, vx_rectangle rect, vx_tile_t *tile)
+static void vxTilingJob(void *arg)
 {
-    vx_image_t *img = (vx_image_t *)image;
-    vx_uint32 p = 0;
-    vx_status status = VX_SUCCESS;;
-    for (p = 0; p < img->planes; p++)
+    vx_tiling_job_t *job = (vx_tiling_job_t *)arg;
+    vx_tiling_state_t *state = job->state;
+    vx_node_t *node = state->node;
+    vx_tile_t tiles[VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_PARAMS];
+    vx_uint32 t, p;
+
+    memcpy(params, state->params, sizeof(params));
+    for (p = 0u; p < state->num; p++)
     {
-        status = vxCommitImagePatch(image, rect, 0, &tile->addr[p], tile->base[p]);
+        if (state->types[p] == VX_TYPE_IMAGE)
+        {
+            memcpy(&tiles[p], &state->images[p], sizeof(vx_tile_t));
+            params[p] = &tiles[p];
+        }
     }
+    /* the tiles are whole rows, interleaved over the jobs */
+    for (t = job->index; t < state->numTiles; t += state->numJobs)
+    {
+        vx_uint32 ty = t * state->tileHeight;
+        vx_uint32 th = state->height - ty;
+        vx_uint64 beg;
+        if (th > state->tileHeight)
+            th = state->tileHeight;
+        for (p = 0u; p < state->num; p++)
+        {
+            if (state->types[p] == VX_TYPE_IMAGE)
+                vxSetTile(&tiles[p], &state->images[p], state->planes[p], 0, ty, state->width, th);
+        }
+        beg = VX_TRACE_BEGIN();
+        node->kernel->tiling_function(params, job->memory, node->attributes.tileDataSize);
+        VX_TRACE_END("tile", node->kernel->name, node, (vx_int32)t, beg);
+    }
+    if (job->index > 0)
+        vxSemPost(&state->done);
 }
 
 vx_status vxTilingKernel(vx_node node, vx_reference parameters[], vx_uint32 num)
 {
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    vx_image images[VX_INT_MAX_PARAMS];
-    vx_uint32 ty = 0u, tx = 0u, p = 0u;
-    vx_rectangle rect = 0;
-    vx_tile_t tiles[VX_INT_MAX_PARAMS];
-    void *params[VX_INT_MAX_PARAMS] = {NULL};
+    vx_status status = VX_SUCCESS;
+    vx_node_t *pnode = (vx_node_t *)node;
+    vx_threadpool_t *pool = &pnode->base.context->pool;
+    vx_tiling_state_t state;
+    vx_tiling_job_t jobs[VX_INT_MAX_WORKERS + 1];
+    vx_rectangle rects[VX_INT_MAX_PARAMS] = {0};
     vx_enum dirs[VX_INT_MAX_PARAMS];
-    vx_enum types[VX_INT_MAX_PARAMS];
     size_t scalars[VX_INT_MAX_PARAMS];
     vx_uint32 index = UINT32_MAX;
-    vx_uint32 tile_size_y = 0u, tile_size_x = 0u;
-    vx_uint32 block_multiple = 64;
-    vx_uint32 height = 0u, width = 0u;
+    vx_uint32 p = 0u, i = 0u, j = 0u;
+    vx_tile_block_size_t block = {1, 1};
+    vx_neighborhood_size_t nbhd = {0, 0, 0, 0};
     vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
-    vx_neighborhood_size_t nbhd;
-    void *tile_memory = NULL;
-    vx_size size = 0;
+    vx_uint32 tile_size_y = 0u, halo = 0u;
+
+    if (num > VX_INT_MAX_PARAMS)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_OUTPUT_TILE_BLOCK_SIZE, &block, sizeof(block));
+    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &nbhd, sizeof(nbhd));
+    if (status != VX_SUCCESS)
+        return status;
+    if ((borders.mode != VX_BORDER_MODE_UNDEFINED) &&
+        (borders.mode != VX_BORDER_MODE_SELF))
+    {
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+    if (block.width < 1)
+        block.width = 1;
+    if (block.height < 1)
+        block.height = 1;
 
     /* Do the following:
      * \arg find out each parameters direction
-     * \arg assign each image from the parameters
+     * \arg access each image as a whole, once
      * \arg assign the block/neighborhood info
      */
-    for (p = 0u; p < num; p++)
+    memset(&state, 0, sizeof(state));
+    state.node = pnode;
+    state.num = num;
+    for (p = 0u; (p < num) && (status == VX_SUCCESS); p++)
     {
-        vx_parameter param = vxGetParameterByIndex(node, p);
-        if (param)
+        dirs[p] = pnode->kernel->signature.directions[p];
+        state.types[p] = pnode->kernel->signature.types[p];
+        if (parameters[p] == 0)
         {
-            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_DIRECTION, &dirs[p], sizeof(dirs[p]));
-            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_TYPE, &types[p], sizeof(types[p]));
-            vxReleaseParameter(&param);
+            state.types[p] = VX_TYPE_INVALID;
         }
-        //printf("Tiling Kernel Parameter[%u] dir:%d type:0%08x\n", p, dirs[p], types[p]);
-        if (types[p] == VX_TYPE_IMAGE)
+        else if (state.types[p] == VX_TYPE_IMAGE)
         {
-            vxQueryNode(node, VX_NODE_ATTRIBUTE_OUTPUT_TILE_BLOCK_SIZE, &tiles[p].tile_block, sizeof(vx_tile_block_size_t));
-            vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &tiles[p].neighborhood, sizeof(vx_neighborhood_size_t));
-            vxPrintImage((vx_image_t *)parameters[p]);
-            images[p] = (vx_image)parameters[p];
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_WIDTH, &tiles[p].image.width, sizeof(vx_uint32));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_HEIGHT, &tiles[p].image.height, sizeof(vx_uint32));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_FORMAT, &tiles[p].image.format, sizeof(vx_fourcc));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_SPACE, &tiles[p].image.space, sizeof(vx_enum));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_RANGE, &tiles[p].image.range, sizeof(vx_enum));
-            params[p] = &tiles[p];
+            vx_image_t *image = (vx_image_t *)parameters[p];
+            vx_tile_t *tile = &state.images[p];
+            tile->tile_block = block;
+            tile->neighborhood = nbhd;
+            tile->image.width = image->width;
+            tile->image.height = image->height;
+            tile->image.format = image->format;
+            tile->image.space = image->space;
+            tile->image.range = image->range;
+            state.planes[p] = image->planes;
+            rects[p] = vxCreateRectangle(vxGetContext(node), 0, 0, image->width, image->height);
+            for (i = 0u; i < image->planes; i++)
+            {
+                tile->base[i] = NULL;
+                status |= vxAccessImagePatch((vx_image)image, rects[p], i, &tile->addr[i], (void **)&tile->base[i]);
+            }
             if ((dirs[p] == VX_OUTPUT) && (index == UINT32_MAX))
             {
                 index = p;
-                //printf("Using index %u as coordinate basis\n", index);
             }
         }
-        else if (types[p] == VX_TYPE_SCALAR)
+        else if (state.types[p] == VX_TYPE_SCALAR)
         {
             vxAccessScalarValue((vx_scalar)parameters[p], (void *)&scalars[p]);
-            params[p] = &scalars[p];
+            state.params[p] = &scalars[p];
         }
 #if defined(OPENVX_TILING_1_1)
         /*! \todo add addition data types here */
 #endif
     }
+    if (index == UINT32_MAX)
+        status = VX_ERROR_INVALID_PARAMETERS;
 
-    /* choose the index of the first output image to based the tiling on */
-    status |= vxQueryImage(images[index], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
-    status |= vxQueryImage(images[index], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
-    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
-    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &nbhd, sizeof(nbhd));
-    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_SIZE, &size, sizeof(size));
-
-#if 0
-    tile_size_y = (height - (nbhd.y[1] + abs(nbhd.y[0]))) / block_multiple;
-    tile_size_x = (width - (nbhd.x[1] + abs(nbhd.x[0])));
-#else
-    tile_size_y = height / block_multiple;
-    tile_size_x = width;
-#endif
+    if (status == VX_SUCCESS)
+    {
+        /* the first output image is the basis of the tiling, each tile is a
+         * band of whole rows which is a multiple of the block height and tall
+         * enough that the neighborhood rows it shares are a small part of it */
+        state.width = state.images[index].image.width;
+        state.height = state.images[index].image.height;
+        halo = (vx_uint32)(nbhd.bottom - nbhd.top);
+        state.numJobs = pool->numWorkers + 1;
+        if ((pnode->attributes.tileDataSize > 0) && (state.numJobs > pnode->attributes.tileDataCount))
+            state.numJobs = pnode->attributes.tileDataCount;
+        tile_size_y = state.height / (state.numJobs * VX_TILES_PER_THREAD);
+        if (tile_size_y < (halo * VX_TILE_HALO_RATIO))
+            tile_size_y = halo * VX_TILE_HALO_RATIO;
+        if (tile_size_y == 0u)
+            tile_size_y = 1u;
+        tile_size_y = ((tile_size_y + block.height - 1) / block.height) * block.height;
+        state.tileHeight = tile_size_y;
+        state.numTiles = (state.height + tile_size_y - 1) / tile_size_y;
+        if (state.numJobs > state.numTiles)
+            state.numJobs = state.numTiles;
+        VX_PRINT(VX_ZONE_GRAPH, "Tiling %s into %u tiles of %ux%u on %u threads\n",
+                 pnode->kernel->name, state.numTiles, state.width, state.tileHeight, state.numJobs);
+
+        vxCreateSem(&state.done, 0);
+        for (j = 0u; j < state.numJobs; j++)
+        {
+            jobs[j].state = &state;
+            jobs[j].index = j;
+            jobs[j].memory = NULL;
+            if (pnode->attributes.tileDataPtr)
+                jobs[j].memory = (vx_uint8 *)pnode->attributes.tileDataPtr + (j * pnode->attributes.tileDataSize);
+            jobs[j].work.function = vxTilingJob;
+            jobs[j].work.arg = &jobs[j];
+        }
+        for (j = 1u; j < state.numJobs; j++)
+        {
+            vxSubmitWork(pool, &jobs[j].work);
+        }
+        /* the calling thread takes the first share, then helps with queued
+         * work until the other shares are done */
+        vxTilingJob(&jobs[0]);
+        for (j = 1u; j < state.numJobs; j++)
+        {
+            while (vxSemTryWait(&state.done) == vx_false_e)
+            {
+                if (vxTryRunWork(pool) == vx_false_e)
+                {
+                    vxSemWait(&state.done);
+                    break;
+                }
+            }
+        }
+        vxDestroySem(&state.done);
+    }
 
-    if ((borders.mode != VX_BORDER_MODE_UNDEFINED) &&
-        (borders.mode != VX_BORDER_MODE_SELF))
+    for (p = 0u; p < num; p++)
     {
-        return VX_ERROR_NOT_SUPPORTED;
+        if (state.types[p] == VX_TYPE_IMAGE)
+        {
+            vx_image_t *image = (vx_image_t *)parameters[p];
+            for (i = 0u; i < image->planes; i++)
+            {
+                if (state.images[p].base[i] == NULL)
+                    continue;
+                status |= vxCommitImagePatch((vx_image)image, (dirs[p] == VX_INPUT ? 0 : rects[p]), i,
+                                             &state.images[p].addr[i], state.images[p].base[i]);
+            }
+            vxReleaseRectangle(&rects[p]);
+        }
+    }
+    return status;
+}
+
+/*! \brief The index of a parameter which is not an image of a tiling chain. */
+#define VX_CHAIN_NONE   (UINT32_MAX)
+
+/*! \brief The maximum number of distinct images in a tiling chain. */
+#define VX_CHAIN_MAX_IMAGES (VX_INT_MAX_FUSED * VX_INT_MAX_PARAMS)
+
+/*! \brief An image of a tiling chain. External images are accessed as a whole,
+ * the intermediates only exist as a strip of rows in each job.
+ */
+typedef struct _vx_chain_image_t {
+    vx_image_t *image;
+    /*! \brief The stage which writes an intermediate, VX_CHAIN_NONE if external. */
+    vx_uint32 writer;
+    vx_enum dir;
+    vx_rectangle rect;
+    vx_tile_t whole;
+    /*! \brief The most rows the writer produces for one band. */
+    vx_int32 rows;
+    /*! \brief The rows of padding before and after the strip. */
+    vx_int32 pad;
+    vx_size stride;
+    vx_size offset;
+} vx_chain_image_t;
+
+/*! \brief The state shared by all jobs of one execution of a tiling chain. */
+typedef struct _vx_chain_state_t {
+    vx_node_t **nodes;
+    vx_uint32 numStages;
+    vx_chain_image_t images[VX_CHAIN_MAX_IMAGES];
+    vx_uint32 numImages;
+    vx_uint32 imageOf[VX_INT_MAX_FUSED][VX_INT_MAX_PARAMS];
+    size_t scalars[VX_INT_MAX_FUSED][VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_FUSED][VX_INT_MAX_PARAMS];
+    vx_neighborhood_size_t nbhd[VX_INT_MAX_FUSED];
+    vx_tile_block_size_t block[VX_INT_MAX_FUSED];
+    vx_int32 width;
+    vx_int32 height;
+    vx_int32 bandHeight;
+    vx_uint32 numBands;
+    vx_uint32 numJobs;
+    vx_uint8 *strips;
+    vx_size stripSize;
+    vx_sem_t done;
+} vx_chain_state_t;
+
+/*! \brief A thread's share of the bands of a tiling chain. */
+typedef struct _vx_chain_job_t {
+    vx_work_t work;
+    vx_chain_state_t *state;
+    vx_uint32 index;
+} vx_chain_job_t;
+
+/*! \brief Returns VX_SUCCESS when the nodes are tiling kernels which can run
+ * depth first, each intermediate image being read only within the chain.
+ */
+static vx_status vxTilingChainSupported(vx_node_t *nodes[], vx_size num)
+{
+    vx_image_t *first = NULL;
+    vx_uint32 n, p, c, q;
+
+    for (n = 0u; n < num; n++)
+    {
+        vx_node_t *node = nodes[n];
+        if ((node->kernel->tiling_function == NULL) ||
+            ((node->attributes.borders.mode != VX_BORDER_MODE_UNDEFINED) &&
+             (node->attributes.borders.mode != VX_BORDER_MODE_SELF)))
+        {
+            return VX_ERROR_NOT_SUPPORTED;
+        }
+        for (p = 0u; p < node->kernel->signature.numParams; p++)
+        {
+            vx_image_t *image = (vx_image_t *)node->parameters[p];
+            vx_bool read = vx_false_e;
+            if ((image == NULL) || (node->kernel->signature.types[p] != VX_TYPE_IMAGE))
+                continue;
+            if (first == NULL)
+                first = image;
+            /* the bands of every stage are the same rows */
+            if ((image->width != first->width) || (image->height != first->height))
+                return VX_ERROR_NOT_SUPPORTED;
+            if ((n == num - 1) || (node->kernel->signature.directions[p] == VX_INPUT))
+                continue;
+            /* the outputs of the other stages only exist as strips */
+            for (c = n + 1; (c < num) && (read == vx_false_e); c++)
+            {
+                for (q = 0u; q < nodes[c]->kernel->signature.numParams; q++)
+                {
+                    if ((nodes[c]->parameters[q] == &image->base) &&
+                        (nodes[c]->kernel->signature.directions[q] == VX_INPUT))
+                    {
+                        read = vx_true_e;
+                    }
+                }
+            }
+            if ((read == vx_false_e) || (image->planes != 1) || (image->isVirtual == vx_false_e))
+                return VX_ERROR_NOT_SUPPORTED;
+            /* nor may they be read by any node outside of the chain */
+            for (c = 0u; c < node->graph->numNodes; c++)
+            {
+                vx_node_t *other = node->graph->nodes[c];
+                for (q = 0u; q < num; q++)
+                {
+                    if (nodes[q] == other)
+                        break;
+                }
+                if (q < num)
+                    continue;
+                for (q = 0u; q < other->kernel->signature.numParams; q++)
+                {
+                    if (other->parameters[q] == &image->base)
+                        return VX_ERROR_NOT_SUPPORTED;
+                }
+            }
+        }
     }
+    return VX_SUCCESS;
+}
+
+/*! \brief Computes the rows each stage produces so that the last stage can
+ * produce the rows [y0, y1). Each stage covers what its readers need of its
+ * output including their neighborhoods, aligned to its block height.
+ */
+static void vxTilingChainRanges(vx_chain_state_t *state, vx_int32 y0, vx_int32 y1,
+                                vx_int32 start[], vx_int32 end[])
+{
+    vx_int32 s, c;
+    vx_uint32 p;
 
-    status = VX_SUCCESS;
-#if 0
-    for (ty = abs(nbhd.y[0]); (ty < (height - nbhd.y[1])) && (status == VX_SUCCESS); ty += tile_size_y)
+    start[state->numStages - 1] = y0;
+    end[state->numStages - 1] = y1;
+    for (s = (vx_int32)state->numStages - 2; s >= 0; s--)
     {
-        for (tx = abs(nbhd.x[0]); tx < (width - nbhd.x[1]); tx += tile_size_x)
+        vx_int32 bh = state->block[s].height;
+        start[s] = state->height;
+        end[s] = 0;
+        for (c = s + 1; c < (vx_int32)state->numStages; c++)
         {
-#else
-    for (ty = 0u; (ty < height) && (status == VX_SUCCESS); ty += tile_size_y)
+            for (p = 0u; p < state->nodes[c]->kernel->signature.numParams; p++)
+            {
+                vx_uint32 i = state->imageOf[c][p];
+                if ((i == VX_CHAIN_NONE) ||
+                    (state->images[i].writer != (vx_uint32)s) ||
+                    (state->nodes[c]->kernel->signature.directions[p] != VX_INPUT) ||
+                    (start[c] >= end[c]))
+                {
+                    continue;
+                }
+                if (start[s] > start[c] + state->nbhd[c].top)
+                    start[s] = start[c] + state->nbhd[c].top;
+                if (end[s] < end[c] + state->nbhd[c].bottom)
+                    end[s] = end[c] + state->nbhd[c].bottom;
+            }
+        }
+        if (start[s] < 0)
+            start[s] = 0;
+        if (end[s] > state->height)
+            end[s] = state->height;
+        if (start[s] < end[s])
+        {
+            start[s] = (start[s] / bh) * bh;
+            end[s] = ((end[s] + bh - 1) / bh) * bh;
+            if (end[s] > state->height)
+                end[s] = state->height;
+        }
+    }
+}
+
+static void vxTilingChainJob(void *arg)
+{
+    vx_chain_job_t *job = (vx_chain_job_t *)arg;
+    vx_chain_state_t *state = job->state;
+    vx_uint8 *strips = &state->strips[job->index * state->stripSize];
+    vx_int32 start[VX_INT_MAX_FUSED], end[VX_INT_MAX_FUSED];
+    vx_tile_t tiles[VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_PARAMS];
+    vx_uint32 b, s, p;
+
+    for (b = job->index; b < state->numBands; b += state->numJobs)
     {
-        for (tx = 0u; tx < width; tx += tile_size_x)
+        vx_int32 y0 = (vx_int32)b * state->bandHeight;
+        vx_int32 y1 = y0 + state->bandHeight;
+        if (y1 > state->height)
+            y1 = state->height;
+        vxTilingChainRanges(state, y0, y1, start, end);
+        for (s = 0u; s < state->numStages; s++)
         {
-#endif
-            rect = vxCreateRectangle(vxGetContext(node), tx, ty, tx+tile_size_x, ty+tile_size_y);
-            for (p = 0u; p < num; p++)
+            vx_node_t *node = state->nodes[s];
+            vx_uint8 *memory = NULL;
+            vx_uint64 beg = 0ull;
+            if (start[s] >= end[s])
+                continue;
+            for (p = 0u; p < node->kernel->signature.numParams; p++)
             {
-                if (types[p] == VX_TYPE_IMAGE)
+                vx_uint32 i = state->imageOf[s][p];
+                vx_chain_image_t *img = NULL;
+                if (i == VX_CHAIN_NONE)
+                {
+                    params[p] = state->params[s][p];
+                    continue;
+                }
+                img = &state->images[i];
+                memcpy(&tiles[p], &img->whole, sizeof(vx_tile_t));
+                if (img->writer == VX_CHAIN_NONE)
                 {
-                    tiles[p].tile_x = tx;
-                    tiles[p].tile_y = ty;
-                    status |= vxGetPatchToTile(images[p], rect, &tiles[p]);
+                    vxSetTile(&tiles[p], &img->whole, img->image->planes,
+                              0, start[s], state->width, end[s] - start[s]);
                 }
+                else
+                {
+                    /* the strip holds the rows of the writer's range for this band */
+                    vx_int32 row = img->pad + start[s] - start[img->writer];
+                    tiles[p].base[0] = strips + img->offset + (row * img->stride);
+                    tiles[p].addr[0].dim_x = state->width;
+                    tiles[p].addr[0].dim_y = end[s] - start[s];
+                    tiles[p].tile_x = 0;
+                    tiles[p].tile_y = start[s];
+                }
+                params[p] = &tiles[p];
+            }
+            if (node->attributes.tileDataPtr)
+                memory = (vx_uint8 *)node->attributes.tileDataPtr + (job->index * node->attributes.tileDataSize);
+            beg = VX_TRACE_BEGIN();
+            node->kernel->tiling_function(params, memory, node->attributes.tileDataSize);
+            VX_TRACE_END("tile", node->kernel->name, node, (vx_int32)b, beg);
+        }
+    }
+    if (job->index > 0)
+        vxSemPost(&state->done);
+}
+
+/*! \brief Executes a chain of tiling kernels depth first. The last stage is
+ * cut into bands of rows; for each band every stage produces just the rows
+ * its readers need, so the intermediate images only exist as strips.
+ */
+static vx_status vxTilingChainKernel(vx_node_t *nodes[], vx_size num)
+{
+    vx_status status = VX_SUCCESS;
+    vx_node_t *leader = nodes[num - 1];
+    vx_threadpool_t *pool = &leader->base.context->pool;
+    vx_chain_state_t *state = NULL;
+    vx_chain_job_t jobs[VX_INT_MAX_WORKERS + 1];
+    vx_int32 start[VX_INT_MAX_FUSED], end[VX_INT_MAX_FUSED];
+    vx_int32 halo = 0, height = 0;
+    vx_uint32 s, p, i, j, b;
+
+    state = calloc(1, sizeof(vx_chain_state_t));
+    if (state == NULL)
+        return VX_ERROR_NO_MEMORY;
+    state->nodes = nodes;
+    state->numStages = (vx_uint32)num;
+    state->numJobs = pool->numWorkers + 1;
+    for (s = 0u; (s < num) && (status == VX_SUCCESS); s++)
+    {
+        vx_node_t *node = nodes[s];
+        status |= vxQueryNode((vx_node)node, VX_NODE_ATTRIBUTE_OUTPUT_TILE_BLOCK_SIZE, &state->block[s], sizeof(vx_tile_block_size_t));
+        status |= vxQueryNode((vx_node)node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &state->nbhd[s], sizeof(vx_neighborhood_size_t));
+        if (state->block[s].width < 1)
+            state->block[s].width = 1;
+        if (state->block[s].height < 1)
+            state->block[s].height = 1;
+        halo += state->nbhd[s].bottom - state->nbhd[s].top;
+        if ((node->attributes.tileDataSize > 0) && (state->numJobs > node->attributes.tileDataCount))
+            state->numJobs = node->attributes.tileDataCount;
+        for (p = 0u; p < node->kernel->signature.numParams; p++)
+        {
+            vx_image_t *image = (vx_image_t *)node->parameters[p];
+            state->imageOf[s][p] = VX_CHAIN_NONE;
+            if (image == NULL)
+                continue;
+            if (node->kernel->signature.types[p] == VX_TYPE_SCALAR)
+            {
+                vxAccessScalarValue((vx_scalar)image, (void *)&state->scalars[s][p]);
+                state->params[s][p] = &state->scalars[s][p];
+                continue;
             }
-            if (status == VX_SUCCESS)
+            if (node->kernel->signature.types[p] != VX_TYPE_IMAGE)
+                continue;
+            for (i = 0u; i < state->numImages; i++)
             {
-                //printf("Calling Tile{%u,%u} with %s\n", tx, ty, ((vx_node_t *)node)->kernel->name);
-                vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_PTR, &tile_memory, sizeof(void *));
-                ((vx_node_t *)node)->kernel->tiling_function(params, tile_memory, size);
+                if (state->images[i].image == image)
+                    break;
             }
-            else
+            if (i == state->numImages)
+            {
+                vx_chain_image_t *img = &state->images[state->numImages++];
+                img->image = image;
+                img->writer = VX_CHAIN_NONE;
+                img->dir = VX_INPUT;
+                img->whole.tile_block = state->block[s];
+                img->whole.neighborhood = state->nbhd[s];
+                img->whole.image.width = image->width;
+                img->whole.image.height = image->height;
+                img->whole.image.format = image->format;
+                img->whole.image.space = image->space;
+                img->whole.image.range = image->range;
+            }
+            state->imageOf[s][p] = i;
+            if (node->kernel->signature.directions[p] != VX_INPUT)
+            {
+                state->images[i].dir = node->kernel->signature.directions[p];
+                if (s < num - 1)
+                    state->images[i].writer = s;
+            }
+        }
+    }
+    if (state->numImages == 0u)
+        status = VX_ERROR_INVALID_PARAMETERS;
+    else
+    {
+        state->width = (vx_int32)state->images[0].image->width;
+        state->height = (vx_int32)state->images[0].image->height;
+    }
+
+    /* external images are accessed once as a whole */
+    for (i = 0u; (i < state->numImages) && (status == VX_SUCCESS); i++)
+    {
+        vx_chain_image_t *img = &state->images[i];
+        if (img->writer != VX_CHAIN_NONE)
+            continue;
+        img->rect = vxCreateRectangle((vx_context)leader->base.context, 0, 0, img->image->width, img->image->height);
+        for (p = 0u; p < img->image->planes; p++)
+        {
+            img->whole.base[p] = NULL;
+            status |= vxAccessImagePatch((vx_image)img->image, img->rect, p, &img->whole.addr[p], (void **)&img->whole.base[p]);
+        }
+    }
+
+    if (status == VX_SUCCESS)
+    {
+        /* bands tall enough that the recomputed halo rows are a small part */
+        vx_int32 bh = state->block[num - 1].height;
+        height = state->height / (vx_int32)(state->numJobs * VX_TILES_PER_THREAD);
+        if (height < halo * VX_TILE_HALO_RATIO)
+            height = halo * VX_TILE_HALO_RATIO;
+        if (height < 1)
+            height = 1;
+        state->bandHeight = ((height + bh - 1) / bh) * bh;
+        state->numBands = (vx_uint32)((state->height + state->bandHeight - 1) / state->bandHeight);
+        if (state->numJobs > state->numBands)
+            state->numJobs = state->numBands;
+
+        /* size each strip for the largest range its writer has in any band */
+        for (b = 0u; b < state->numBands; b++)
+        {
+            vx_int32 y0 = (vx_int32)b * state->bandHeight;
+            vx_int32 y1 = (y0 + state->bandHeight > state->height ? state->height : y0 + state->bandHeight);
+            vxTilingChainRanges(state, y0, y1, start, end);
+            for (i = 0u; i < state->numImages; i++)
             {
-                //printf("Failed to get tile {%u, %u} (status = %d)\n", tx, ty, status);
+                vx_chain_image_t *img = &state->images[i];
+                if ((img->writer != VX_CHAIN_NONE) && (end[img->writer] - start[img->writer] > img->rows))
+                    img->rows = end[img->writer] - start[img->writer];
             }
-            for (p = 0u; p < num; p++)
+        }
+        state->stripSize = 0;
+        for (i = 0u; i < state->numImages; i++)
+        {
+            vx_chain_image_t *img = &state->images[i];
+            vx_size bpp = (vx_size)img->image->memory.dims[0][VX_DIM_C];
+            if (img->writer == VX_CHAIN_NONE)
+                continue;
+            /* reads beyond the rows of the image stay within the padding */
+            for (s = img->writer + 1; s < num; s++)
             {
-                if (types[p] == VX_TYPE_IMAGE)
+                for (p = 0u; p < nodes[s]->kernel->signature.numParams; p++)
                 {
-                    if (dirs[p] == VX_INPUT)
-                    {
-                        status |= vxSetTileToPatch(images[p], 0, &tiles[p]);
-                    }
-                    else
-                    {
-                        status |= vxSetTileToPatch(images[p], rect, &tiles[p]);
-                    }
+                    if (state->imageOf[s][p] != i)
+                        continue;
+                    if (img->pad < -state->nbhd[s].top + 1)
+                        img->pad = -state->nbhd[s].top + 1;
+                    if (img->pad < state->nbhd[s].bottom + 1)
+                        img->pad = state->nbhd[s].bottom + 1;
                 }
             }
-            vxReleaseRectangle(&rect);
-            rect = 0;
-            if (status != VX_SUCCESS)
+            img->stride = bpp * state->width;
+            img->whole.addr[0].stride_x = (vx_int32)bpp;
+            img->whole.addr[0].stride_y = (vx_int32)img->stride;
+            img->whole.addr[0].scale_x = VX_SCALE_UNITY;
+            img->whole.addr[0].scale_y = VX_SCALE_UNITY;
+            img->whole.addr[0].step_x = 1;
+            img->whole.addr[0].step_y = 1;
+            img->offset = state->stripSize;
+            state->stripSize += (img->rows + (2 * img->pad)) * img->stride;
+        }
+        state->strips = calloc(state->numJobs, state->stripSize ? state->stripSize : 1);
+        if (state->strips == NULL)
+            status = VX_ERROR_NO_MEMORY;
+    }
+
+    if (status == VX_SUCCESS)
+    {
+        VX_PRINT(VX_ZONE_GRAPH, "Tiling %u nodes depth first in %u bands of %d rows on %u threads with "VX_FMT_SIZE" bytes of strips\n",
+                 state->numStages, state->numBands, state->bandHeight, state->numJobs, state->stripSize * state->numJobs);
+        vxCreateSem(&state->done, 0);
+        for (j = 0u; j < state->numJobs; j++)
+        {
+            jobs[j].state = state;
+            jobs[j].index = j;
+            jobs[j].work.function = vxTilingChainJob;
+            jobs[j].work.arg = &jobs[j];
+        }
+        for (j = 1u; j < state->numJobs; j++)
+        {
+            vxSubmitWork(pool, &jobs[j].work);
+        }
+        vxTilingChainJob(&jobs[0]);
+        for (j = 1u; j < state->numJobs; j++)
+        {
+            while (vxSemTryWait(&state->done) == vx_false_e)
             {
-                break;
+                if (vxTryRunWork(pool) == vx_false_e)
+                {
+                    vxSemWait(&state->done);
+                    break;
+                }
             }
         }
+        vxDestroySem(&state->done);
+    }
+
+    for (i = 0u; i < state->numImages; i++)
+    {
+        vx_chain_image_t *img = &state->images[i];
+        if (img->writer != VX_CHAIN_NONE)
+            continue;
+        for (p = 0u; p < img->image->planes; p++)
+        {
+            if (img->whole.base[p] == NULL)
+                continue;
+            status |= vxCommitImagePatch((vx_image)img->image, (img->dir == VX_INPUT ? 0 : img->rect), p,
+                                         &img->whole.addr[p], img->whole.base[p]);
+        }
+        vxReleaseRectangle(&img->rect);
     }
-    //printf("Tiling Kernel returning = %d\n", status);
+    free(state->strips);
+    free(state);
     return status;
 }
@@ -67,5 +67,6 @@ extern vx_kernel_description_t warp_perspective_kernel;
 extern vx_kernel_description_t harris_kernel;
 extern vx_kernel_description_t fast9_kernel;
 extern vx_kernel_description_t optpyrlk_kernel;
+extern vx_kernel_description_t remap_kernel;
 
 #endif
@@ -68,7 +68,7 @@ static vx_status vxMagnitudeKernel(vx_node node, vx_reference *parameters, vx_ui
                 {
                     vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
                     vx_int32 grad[2] = {in_x[0]*in_x[0], in_y[0]*in_y[0]};
-                    vx_float64 sum = grad[0] + grad[1];
+                    vx_float64 sum = (vx_float64)grad[0] + grad[1];
                     value = ((vx_int32)sqrt(sum))/4;
                     *dst = (vx_uint8)(value > UINT8_MAX ? UINT8_MAX : value);
                 }
@@ -76,7 +76,7 @@ static vx_status vxMagnitudeKernel(vx_node node, vx_reference *parameters, vx_ui
                 {
                     vx_int16 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
                     vx_int32 grad[2] = {in_x[0]*in_x[0], in_y[0]*in_y[0]};
-                    vx_float64 sum = grad[0] + grad[1];
+                    vx_float64 sum = (vx_float64)grad[0] + grad[1];
                     value = (vx_int32)sqrt(sum);
                     *dst = (vx_int16)(value > INT16_MAX ? INT16_MAX : value);
                 }
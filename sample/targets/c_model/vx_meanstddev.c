@@ -40,7 +40,9 @@ static vx_status vxMeanStdDevKernel(vx_node node, vx_reference *parameters, vx_u
         vx_image input = (vx_image)parameters[0];
         vx_scalar s_mean = (vx_scalar)parameters[1];
         vx_scalar s_stddev = (vx_scalar)parameters[2];
-        vx_float32 mean = 0.0f, sum = 0.0f, sum_diff_sqrs = 0.0f, stddev = 0.0f;
+        vx_float32 mean = 0.0f, stddev = 0.0f;
+        vx_uint64 sum = 0, sum_sqrs = 0;
+        vx_float64 count, var;
         vx_fourcc format = 0;
         vx_rectangle rect = 0;
         vx_imagepatch_addressing_t addrs;
@@ -51,40 +53,33 @@ static vx_status vxMeanStdDevKernel(vx_node node, vx_reference *parameters, vx_u
         rect = vxGetValidRegionImage(input);
         status  = VX_SUCCESS;
         status |= vxAccessImagePatch(input, rect, 0, &addrs, &base_ptr);
+        /* one pass, with the sums kept exactly */
         for (y = 0; y < addrs.dim_y; y++)
         {
             for (x = 0; x < addrs.dim_x; x++)
             {
+                vx_uint32 value = 0;
                 if (format == FOURCC_U8)
                 {
                     vx_uint8 *pixel = vxFormatImagePatchAddress2d(base_ptr, x, y, &addrs);
-                    sum += (vx_float32)(*pixel);
+                    value = *pixel;
                 }
                 else if (format == FOURCC_U16)
                 {
                     vx_uint16 *pixel = vxFormatImagePatchAddress2d(base_ptr, x, y, &addrs);
-                    sum += (vx_float32)(*pixel);
+                    value = *pixel;
                 }
+                sum += value;
+                sum_sqrs += (vx_uint64)value * value;
             }
         }
-        mean = sum / (addrs.dim_x*addrs.dim_y);
-        for (y = 0; y < addrs.dim_y; y++)
+        count = (vx_float64)addrs.dim_x * addrs.dim_y;
+        if (count > 0)
         {
-            for (x = 0; x < addrs.dim_x; x++)
-            {
-                if (format == FOURCC_U8)
-                {
-                    vx_uint8 *pixel = vxFormatImagePatchAddress2d(base_ptr, x, y, &addrs);
-                    sum_diff_sqrs += (vx_float32)pow((vx_float32)(*pixel) - mean, 2);
-                }
-                else if (format == FOURCC_U16)
-                {
-                    vx_uint16 *pixel = vxFormatImagePatchAddress2d(base_ptr, x, y, &addrs);
-                    sum_diff_sqrs += (vx_float32)pow((vx_float32)(*pixel) - mean, 2);
-                }
-            }
+            mean = (vx_float32)(sum / count);
+            var = ((vx_float64)sum_sqrs - (vx_float64)sum * (sum / count)) / count;
+            stddev = (vx_float32)sqrt(var > 0.0 ? var : 0.0);
         }
-        stddev = (vx_float32)sqrt(sum_diff_sqrs / (addrs.dim_x*addrs.dim_y));
         status |= vxCommitScalarValue(s_mean, &mean);
         status |= vxCommitScalarValue(s_stddev, &stddev);
         status |= vxCommitImagePatch(input, rect, 0, &addrs, base_ptr);
@@ -23,22 +23,444 @@
 
 /*!
  * \file
- * \brief The Absolute Difference Kernel.
+ * \brief The Pyramidal Lucas-Kanade Optical Flow Kernel.
  * \author Erik Rainey <erik.rainey@ti.com>
+ *
+ * The points are tracked from the coarsest level of the pyramids down to the
+ * finest. At each level the Scharr gradients of the old image are computed
+ * once, in bands of rows, and are shared by all of the points, which are then
+ * tracked in bands of points on the context pool. The windows are sampled
+ * bilinearly in fixed point, with the image at 5 fractional bits so that it
+ * has the same gain of 32 as the Scharr gradients, and the normal equations
+ * accumulate as 16 bit products in 32 bits per row, which the compiler turns
+ * into vector multiply-adds.
  */
 
 #include <VX/vx.h>
 #include <VX/vx_helper.h>
 
 #include <vx_internal.h>
+#include <math.h>
+#include <float.h>
+
+/*! \brief The fractional bits of the bilinear weights. */
+#define VX_LK_W_BITS    (14)
+
+/*! \brief The fractional bits of the sampled image. */
+#define VX_LK_I_BITS    (5)
+
+/*! \brief The largest window, which bounds the per row sums to 32 bits. */
+#define VX_LK_MAX_WINDOW    (31)
+
+/*! \brief The most iterations when only epsilon ends them. */
+#define VX_LK_MAX_ITERATIONS    (100)
+
+/*! \brief The smallest eigenvalue of the normal matrix, per pixel of the
+ * window, for which a point can be tracked.
+ */
+#define VX_LK_MIN_EIGEN     (1.0e-4f)
+
+/*! \brief Rounds off the n low bits of a fixed point value. */
+#define VX_LK_DESCALE(x, n) (((x) + (1 << ((n) - 1))) >> (n))
+
+/*! \brief The state of one level of one execution, shared by its bands. */
+typedef struct _vx_lk_t {
+    const vx_uint8 *prev;
+    vx_imagepatch_addressing_t prev_addr;
+    const vx_uint8 *next;
+    vx_imagepatch_addressing_t next_addr;
+    /*! \brief The Scharr gradients of the old image, at its width. */
+    vx_int16 *dx;
+    vx_int16 *dy;
+    /*! \brief The scale from the finest level to this one. */
+    vx_float32 scale;
+    vx_bool finest;
+    const vx_keypoint_t *old_points;
+    /*! \brief The tracked points, in the coordinates of the finest level. */
+    vx_float32 *guess;
+    vx_keypoint_t *points;
+    vx_size count;
+    vx_uint32 window;
+    vx_uint32 iterations;
+    vx_bool use_epsilon;
+    vx_float32 epsilon2;
+} vx_lk_t;
+
+/*! \brief The Scharr gradients of one pixel, from the columns xl, x and xr of three rows. */
+static void vxLKScharr(const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2,
+                       vx_uint32 xl, vx_uint32 x, vx_uint32 xr, vx_int16 *dx, vx_int16 *dy)
+{
+    *dx = (vx_int16)(3 * (r0[xr] - r0[xl]) + 10 * (r1[xr] - r1[xl]) + 3 * (r2[xr] - r2[xl]));
+    *dy = (vx_int16)(3 * (r2[xl] - r0[xl]) + 10 * (r2[x] - r0[x]) + 3 * (r2[xr] - r0[xr]));
+}
+
+/*! \brief Computes the gradients of the rows [y0, y1) of the old image, replicating its border. */
+static void vxLKScharrBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_lk_t *lk = (vx_lk_t *)arg;
+    vx_uint32 w = lk->prev_addr.dim_x, h = lk->prev_addr.dim_y, x, y;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *r0 = lk->prev + (y > 0 ? y - 1 : 0) * lk->prev_addr.stride_y;
+        const vx_uint8 *r1 = lk->prev + y * lk->prev_addr.stride_y;
+        const vx_uint8 *r2 = lk->prev + (y + 1 < h ? y + 1 : h - 1) * lk->prev_addr.stride_y;
+        vx_int16 *dx = lk->dx + y * w;
+        vx_int16 *dy = lk->dy + y * w;
+        vxLKScharr(r0, r1, r2, 0, 0, 1, &dx[0], &dy[0]);
+        for (x = 1; x + 1 < w; x++)
+        {
+            dx[x] = (vx_int16)(3 * (r0[x + 1] - r0[x - 1]) + 10 * (r1[x + 1] - r1[x - 1]) + 3 * (r2[x + 1] - r2[x - 1]));
+            dy[x] = (vx_int16)(3 * (r2[x - 1] - r0[x - 1]) + 10 * (r2[x] - r0[x]) + 3 * (r2[x + 1] - r0[x + 1]));
+        }
+        vxLKScharr(r0, r1, r2, w - 2, w - 1, w - 1, &dx[w - 1], &dy[w - 1]);
+    }
+}
+
+/*! \brief The sum of the products of two rows of 16 bit values. */
+static vx_int32 vxLKDot(const vx_int16 *a, const vx_int16 *b, vx_uint32 n)
+{
+    vx_int32 sum = 0;
+    vx_uint32 i;
+    for (i = 0; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+/*! \brief The bilinear weights of the fraction of a position, which sum to 1 << \ref VX_LK_W_BITS. */
+static void vxLKWeights(vx_float32 a, vx_float32 b, vx_int32 iw[4])
+{
+    iw[0] = (vx_int32)((1.0f - a) * (1.0f - b) * (1 << VX_LK_W_BITS) + 0.5f);
+    iw[1] = (vx_int32)(a * (1.0f - b) * (1 << VX_LK_W_BITS) + 0.5f);
+    iw[2] = (vx_int32)((1.0f - a) * b * (1 << VX_LK_W_BITS) + 0.5f);
+    iw[3] = (1 << VX_LK_W_BITS) - iw[0] - iw[1] - iw[2];
+}
+
+/*! \brief Tracks one point through one level.
+ * \details The window of the old image and its gradients are sampled once,
+ * the window of the new image once per iteration. A point is only lost on
+ * the finest level; a coarser level which cannot refine it leaves its guess.
+ */
+static void vxLKTrackPoint(vx_lk_t *lk, vx_size p, vx_int16 *ival, vx_int16 *idx, vx_int16 *idy, vx_int16 *diff)
+{
+    const vx_float32 FLT_SCALE = 1.0f / (1 << 20);
+    vx_keypoint_t *kp = &lk->points[p];
+    vx_uint32 win = lk->window, r = win / 2, gw = lk->prev_addr.dim_x;
+    vx_float32 fx = lk->old_points[p].x * lk->scale - r;
+    vx_float32 fy = lk->old_points[p].y * lk->scale - r;
+    vx_float32 nx = lk->guess[2 * p + 0] * lk->scale;
+    vx_float32 ny = lk->guess[2 * p + 1] * lk->scale;
+    vx_float32 a11, a12, a22, det, min_eig, err = 0.0f;
+    vx_int64 s11 = 0, s12 = 0, s22 = 0;
+    vx_int32 ix, iy, iw[4];
+    vx_uint32 i, j, k;
+
+    if (kp->tracking_status == 0)
+        return;
+    ix = (vx_int32)floorf(fx);
+    iy = (vx_int32)floorf(fy);
+    if ((ix < 0) || (iy < 0) ||
+        (ix + win >= lk->prev_addr.dim_x) || (iy + win >= lk->prev_addr.dim_y))
+    {
+        if (lk->finest)
+            kp->tracking_status = 0;
+        return;
+    }
+    vxLKWeights(fx - ix, fy - iy, iw);
+    for (j = 0; j < win; j++)
+    {
+        const vx_uint8 *s0 = lk->prev + (iy + j) * lk->prev_addr.stride_y + ix;
+        const vx_uint8 *s1 = s0 + lk->prev_addr.stride_y;
+        const vx_int16 *gx0 = lk->dx + (iy + j) * gw + ix, *gx1 = gx0 + gw;
+        const vx_int16 *gy0 = lk->dy + (iy + j) * gw + ix, *gy1 = gy0 + gw;
+        vx_int16 *iv = &ival[j * win], *ixr = &idx[j * win], *iyr = &idy[j * win];
+        for (i = 0; i < win; i++)
+        {
+            iv[i] = (vx_int16)VX_LK_DESCALE(s0[i] * iw[0] + s0[i + 1] * iw[1] + s1[i] * iw[2] + s1[i + 1] * iw[3],
+                                            VX_LK_W_BITS - VX_LK_I_BITS);
+            ixr[i] = (vx_int16)VX_LK_DESCALE(gx0[i] * iw[0] + gx0[i + 1] * iw[1] + gx1[i] * iw[2] + gx1[i + 1] * iw[3],
+                                             VX_LK_W_BITS);
+            iyr[i] = (vx_int16)VX_LK_DESCALE(gy0[i] * iw[0] + gy0[i + 1] * iw[1] + gy1[i] * iw[2] + gy1[i + 1] * iw[3],
+                                             VX_LK_W_BITS);
+        }
+        s11 += vxLKDot(ixr, ixr, win);
+        s12 += vxLKDot(ixr, iyr, win);
+        s22 += vxLKDot(iyr, iyr, win);
+    }
+    a11 = (vx_float32)s11 * FLT_SCALE;
+    a12 = (vx_float32)s12 * FLT_SCALE;
+    a22 = (vx_float32)s22 * FLT_SCALE;
+    det = a11 * a22 - a12 * a12;
+    min_eig = (a22 + a11 - sqrtf((a11 - a22) * (a11 - a22) + 4.0f * a12 * a12)) / (2 * win * win);
+    if ((min_eig < VX_LK_MIN_EIGEN) || (det < FLT_EPSILON))
+    {
+        if (lk->finest)
+            kp->tracking_status = 0;
+        return;
+    }
+    det = 1.0f / det;
+    for (k = 0; k < lk->iterations; k++)
+    {
+        vx_int64 b1 = 0, b2 = 0, sad = 0;
+        vx_float32 ddx, ddy;
+        fx = nx - r;
+        fy = ny - r;
+        ix = (vx_int32)floorf(fx);
+        iy = (vx_int32)floorf(fy);
+        if ((ix < 0) || (iy < 0) ||
+            (ix + win >= lk->next_addr.dim_x) || (iy + win >= lk->next_addr.dim_y))
+        {
+            if (lk->finest)
+                kp->tracking_status = 0;
+            break;
+        }
+        vxLKWeights(fx - ix, fy - iy, iw);
+        for (j = 0; j < win; j++)
+        {
+            const vx_uint8 *s0 = lk->next + (iy + j) * lk->next_addr.stride_y + ix;
+            const vx_uint8 *s1 = s0 + lk->next_addr.stride_y;
+            const vx_int16 *iv = &ival[j * win];
+            for (i = 0; i < win; i++)
+            {
+                diff[i] = (vx_int16)(VX_LK_DESCALE(s0[i] * iw[0] + s0[i + 1] * iw[1] + s1[i] * iw[2] + s1[i + 1] * iw[3],
+                                                   VX_LK_W_BITS - VX_LK_I_BITS) - iv[i]);
+            }
+            b1 += vxLKDot(diff, &idx[j * win], win);
+            b2 += vxLKDot(diff, &idy[j * win], win);
+            if (lk->finest)
+            {
+                for (i = 0; i < win; i++)
+                    sad += diff[i] < 0 ? -diff[i] : diff[i];
+            }
+        }
+        err = (vx_float32)sad / (vx_float32)((1 << VX_LK_I_BITS) * win * win);
+        ddx = (a12 * b2 * FLT_SCALE - a22 * b1 * FLT_SCALE) * det;
+        ddy = (a12 * b1 * FLT_SCALE - a11 * b2 * FLT_SCALE) * det;
+        nx += ddx;
+        ny += ddy;
+        if (lk->use_epsilon && (ddx * ddx + ddy * ddy <= lk->epsilon2))
+            break;
+    }
+    lk->guess[2 * p + 0] = nx / lk->scale;
+    lk->guess[2 * p + 1] = ny / lk->scale;
+    if (lk->finest)
+        kp->error = err;
+}
+
+/*! \brief Tracks the points [p0, p1) through the current level. */
+static void vxLKTrackBand(void *arg, vx_uint32 index, vx_uint32 p0, vx_uint32 p1)
+{
+    vx_lk_t *lk = (vx_lk_t *)arg;
+    vx_int16 ival[VX_LK_MAX_WINDOW * VX_LK_MAX_WINDOW];
+    vx_int16 idx[VX_LK_MAX_WINDOW * VX_LK_MAX_WINDOW];
+    vx_int16 idy[VX_LK_MAX_WINDOW * VX_LK_MAX_WINDOW];
+    vx_int16 diff[VX_LK_MAX_WINDOW];
+    vx_uint32 p;
+    for (p = p0; p < p1; p++)
+        vxLKTrackPoint(lk, p, ival, idx, idy, diff);
+}
+
+/*! \brief The bytes of the gradients of the finest level. */
+static vx_size vxLKGradientSize(vx_uint32 width, vx_uint32 height)
+{
+    return (vx_size)width * height * 2 * sizeof(vx_int16);
+}
 
 static vx_status vxOpticalFlowPyrLKKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
-    if (num == 4)
+    if (num == 10)
+    {
+        vx_pyramid old_pyramid = (vx_pyramid)parameters[0];
+        vx_pyramid new_pyramid = (vx_pyramid)parameters[1];
+        vx_list old_list = (vx_list)parameters[2];
+        vx_list estimates_list = (vx_list)parameters[3];
+        vx_list new_list = (vx_list)parameters[4];
+        vx_enum termination = VX_TERM_CRITERIA_BOTH;
+        vx_float32 epsilon = 0.0f;
+        vx_uint32 iterations = 0;
+        vx_bool use_estimates = vx_false_e;
+        vx_size window = 0, levels = 0, count = 0, length = 0, local_size = 0;
+        vx_float32 scale = 1.0f, level_scale = 1.0f;
+        vx_keypoint_t *old_points = NULL, *points = NULL;
+        vx_int16 *gradients = NULL;
+        vx_uint8 *memory = NULL;
+        void *local = NULL;
+        vx_image level0 = 0;
+        vx_uint32 width = 0, height = 0;
+        vx_size p, l;
+        vx_lk_t lk;
+
+        memset(&lk, 0, sizeof(lk));
+        status = VX_SUCCESS;
+        status |= vxAccessScalarValue((vx_scalar)parameters[5], &termination);
+        status |= vxAccessScalarValue((vx_scalar)parameters[6], &epsilon);
+        status |= vxAccessScalarValue((vx_scalar)parameters[7], &iterations);
+        status |= vxAccessScalarValue((vx_scalar)parameters[8], &use_estimates);
+        status |= vxAccessScalarValue((vx_scalar)parameters[9], &window);
+        status |= vxQueryPyramid(old_pyramid, VX_PYRAMID_ATTRIBUTE_LEVELS, &levels, sizeof(levels));
+        status |= vxQueryPyramid(old_pyramid, VX_PYRAMID_ATTRIBUTE_SCALE, &scale, sizeof(scale));
+        status |= vxQueryList(old_list, VX_LIST_ATTRIBUTE_LENGTH, &length, sizeof(length));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        level0 = vxGetPyramidLevel(old_pyramid, 0);
+        status |= vxQueryImage(level0, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+        status |= vxQueryImage(level0, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+        vxReleaseImage(&level0);
+        if (status != VX_SUCCESS)
+            return status;
+
+        lk.window = (vx_uint32)window;
+        lk.use_epsilon = (termination != VX_TERM_CRITERIA_ITERATIONS) ? vx_true_e : vx_false_e;
+        lk.epsilon2 = epsilon * epsilon;
+        lk.iterations = (termination != VX_TERM_CRITERIA_EPSILON) ? iterations : VX_LK_MAX_ITERATIONS;
+        old_points = (vx_keypoint_t *)malloc((2 * length + 1) * sizeof(vx_keypoint_t));
+        lk.guess = (vx_float32 *)malloc((2 * length + 1) * sizeof(vx_float32));
+        if (local && (local_size >= vxLKGradientSize(width, height)))
+            gradients = (vx_int16 *)local;
+        else
+            gradients = (vx_int16 *)(memory = (vx_uint8 *)malloc(vxLKGradientSize(width, height)));
+        if (old_points && lk.guess && gradients)
+        {
+            points = &old_points[length];
+            count = length;
+            status = vxGetListKeypoints(old_list, old_points, &count);
+            memcpy(points, old_points, count * sizeof(vx_keypoint_t));
+            if ((status == VX_SUCCESS) && (use_estimates == vx_true_e))
+            {
+                vx_size estimates = length;
+                /* the estimates are read into the output array, which only needs their positions */
+                status = vxGetListKeypoints(estimates_list, points, &estimates);
+                if ((status == VX_SUCCESS) && (estimates != count))
+                {
+                    VX_PRINT(VX_ZONE_ERROR, "There are "VX_FMT_SIZE" estimates for "VX_FMT_SIZE" points!\n", estimates, count);
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+            }
+            for (p = 0; p < count; p++)
+            {
+                lk.guess[2 * p + 0] = (vx_float32)points[p].x;
+                lk.guess[2 * p + 1] = (vx_float32)points[p].y;
+                memcpy(&points[p], &old_points[p], sizeof(vx_keypoint_t));
+                points[p].error = 0.0f;
+            }
+        }
+        else
+        {
+            status = VX_ERROR_NO_MEMORY;
+        }
+        lk.old_points = old_points;
+        lk.points = points;
+        lk.count = count;
+        lk.dx = gradients;
+        lk.dy = gradients ? gradients + (vx_size)width * height : NULL;
+        for (l = 1; l < levels; l++)
+            level_scale *= scale;
+        for (l = levels; (l-- > 0) && (status == VX_SUCCESS) && (count > 0); level_scale /= scale)
+        {
+            vx_image prev = vxGetPyramidLevel(old_pyramid, (vx_uint32)l);
+            vx_image next = vxGetPyramidLevel(new_pyramid, (vx_uint32)l);
+            vx_rectangle prev_rect = vxGetValidRegionImage(prev);
+            vx_rectangle next_rect = vxGetValidRegionImage(next);
+            void *prev_base = NULL, *next_base = NULL;
+
+            status |= vxAccessImagePatch(prev, prev_rect, 0, &lk.prev_addr, &prev_base);
+            status |= vxAccessImagePatch(next, next_rect, 0, &lk.next_addr, &next_base);
+            lk.prev = (const vx_uint8 *)prev_base;
+            lk.next = (const vx_uint8 *)next_base;
+            lk.scale = level_scale;
+            lk.finest = (l == 0) ? vx_true_e : vx_false_e;
+            /* a level too small for one window only fails the points on the finest */
+            if ((status == VX_SUCCESS) &&
+                (lk.prev_addr.dim_x > lk.window + 1) && (lk.prev_addr.dim_y > lk.window + 1))
+            {
+                vxRunBands(node, vxBandCount(node, lk.prev_addr.dim_x, lk.prev_addr.dim_y),
+                           lk.prev_addr.dim_y, vxLKScharrBand, &lk);
+                vxRunBands(node, vxBandCount(node, lk.window * lk.window * lk.iterations, (vx_uint32)count),
+                           (vx_uint32)count, vxLKTrackBand, &lk);
+            }
+            else if (lk.finest)
+            {
+                for (p = 0; p < count; p++)
+                    points[p].tracking_status = 0;
+            }
+            status |= vxCommitImagePatch(prev, 0, 0, &lk.prev_addr, prev_base);
+            status |= vxCommitImagePatch(next, 0, 0, &lk.next_addr, next_base);
+            vxReleaseRectangle(&prev_rect);
+            vxReleaseRectangle(&next_rect);
+            vxReleaseImage(&prev);
+            vxReleaseImage(&next);
+        }
+        if (status == VX_SUCCESS)
+        {
+            for (p = 0; p < count; p++)
+            {
+                points[p].x = (vx_int32)floorf(lk.guess[2 * p + 0] + 0.5f);
+                points[p].y = (vx_int32)floorf(lk.guess[2 * p + 1] + 0.5f);
+            }
+            status = vxSetListKeypoints(new_list, points, count);
+        }
+        free(old_points);
+        free(lk.guess);
+        free(memory);
+    }
+    return status;
+}
+
+/*! \brief Allocates the gradients of the finest level once, as the local data of the node. */
+static vx_status vxOpticalFlowPyrLKInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 10)
+    {
+        vx_image level0 = vxGetPyramidLevel((vx_pyramid)parameters[0], 0);
+        vx_uint32 width = 0, height = 0;
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel allocates
+         * for itself if the pyramid has grown since */
+        if (local == NULL)
+        {
+            vx_size size;
+            vxQueryImage(level0, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(level0, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            size = vxLKGradientSize(width, height);
+            local = malloc(size);
+            if (local)
+            {
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+        vxReleaseImage(&level0);
+    }
+    return status;
+}
+
+/*! \brief Checks that a scalar parameter has the type and returns its value. */
+static vx_status vxLKScalarParameter(vx_node node, vx_uint32 index, vx_enum type, void *value)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    vx_parameter param = vxGetParameterByIndex(node, index);
+    if (param)
     {
-        /*! \todo Implement Optical Flow Pyramid LK. */
-        status = VX_ERROR_NOT_IMPLEMENTED;
+        vx_scalar scalar = 0;
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &scalar, sizeof(scalar));
+        if (scalar)
+        {
+            vx_enum stype = 0;
+            vxQueryScalar(scalar, VX_SCALAR_ATTRIBUTE_TYPE, &stype, sizeof(stype));
+            if (stype == type)
+                status = vxAccessScalarValue(scalar, value);
+            else
+                status = VX_ERROR_INVALID_TYPE;
+        }
+        vxReleaseParameter(&param);
     }
     return status;
 }
@@ -48,20 +470,44 @@ static vx_status vxOpticalFlowPyrLKInputValidator(vx_node node, vx_uint32 index)
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
     if (index == 0 || index == 1)
     {
-        vx_image input = 0;
+        vx_pyramid input = 0, old_input = 0;
         vx_parameter param = vxGetParameterByIndex(node, index);
+        vx_parameter old_param = vxGetParameterByIndex(node, 0);
 
         vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
-        if (input)
+        vxQueryParameter(old_param, VX_PARAMETER_ATTRIBUTE_REF, &old_input, sizeof(old_input));
+        if (input && old_input)
         {
+            vx_image level = vxGetPyramidLevel(input, 0);
+            vx_image old_level = vxGetPyramidLevel(old_input, 0);
+            vx_size levels = 0, old_levels = 0;
+            vx_float32 scale = 0.0f, old_scale = 0.0f;
+            vx_uint32 width = 0, height = 0, old_width = 0, old_height = 0;
             vx_fourcc format = 0;
-            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
-            if (format == FOURCC_U8)
+
+            vxQueryPyramid(input, VX_PYRAMID_ATTRIBUTE_LEVELS, &levels, sizeof(levels));
+            vxQueryPyramid(input, VX_PYRAMID_ATTRIBUTE_SCALE, &scale, sizeof(scale));
+            vxQueryPyramid(old_input, VX_PYRAMID_ATTRIBUTE_LEVELS, &old_levels, sizeof(old_levels));
+            vxQueryPyramid(old_input, VX_PYRAMID_ATTRIBUTE_SCALE, &old_scale, sizeof(old_scale));
+            vxQueryImage(level, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            vxQueryImage(level, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(level, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            vxQueryImage(old_level, VX_IMAGE_ATTRIBUTE_WIDTH, &old_width, sizeof(old_width));
+            vxQueryImage(old_level, VX_IMAGE_ATTRIBUTE_HEIGHT, &old_height, sizeof(old_height));
+            /* the new pyramid has to match the old one level for level */
+            if ((format == FOURCC_U8) && (levels > 0) && (scale > 0.0f) && (scale < 1.0f) &&
+                (levels == old_levels) && (scale == old_scale) &&
+                (width == old_width) && (height == old_height))
+            {
                 status = VX_SUCCESS;
+            }
+            vxReleaseImage(&level);
+            vxReleaseImage(&old_level);
         }
         vxReleaseParameter(&param);
+        vxReleaseParameter(&old_param);
     }
-    else if (index == 2)
+    else if (index == 2 || index == 3)
     {
         vx_parameter param = vxGetParameterByIndex(node, index);
         if (param)
@@ -72,13 +518,53 @@ static vx_status vxOpticalFlowPyrLKInputValidator(vx_node node, vx_uint32 index)
             {
                 vx_enum type = 0;
                 vxQueryList(list, VX_LIST_ATTRIBUTE_TYPE, &type, sizeof(type));
-                if (type == VX_TYPE_COORDINATES)
+                if (type == VX_TYPE_KEYPOINT)
                 {
                     status = VX_SUCCESS;
                 }
             }
+            vxReleaseParameter(&param);
+        }
+    }
+    else if (index == 5)
+    {
+        vx_enum termination = 0;
+        status = vxLKScalarParameter(node, index, VX_TYPE_ENUM, &termination);
+        if ((status == VX_SUCCESS) &&
+            (termination != VX_TERM_CRITERIA_ITERATIONS) &&
+            (termination != VX_TERM_CRITERIA_EPSILON) &&
+            (termination != VX_TERM_CRITERIA_BOTH))
+        {
+            status = VX_ERROR_INVALID_VALUE;
+        }
+    }
+    else if (index == 6)
+    {
+        vx_float32 epsilon = 0.0f;
+        status = vxLKScalarParameter(node, index, VX_TYPE_FLOAT32, &epsilon);
+        if ((status == VX_SUCCESS) && !(epsilon >= 0.0f))
+            status = VX_ERROR_INVALID_VALUE;
+    }
+    else if (index == 7)
+    {
+        vx_uint32 iterations = 0;
+        status = vxLKScalarParameter(node, index, VX_TYPE_UINT32, &iterations);
+    }
+    else if (index == 8)
+    {
+        vx_bool use_estimates = vx_false_e;
+        status = vxLKScalarParameter(node, index, VX_TYPE_BOOL, &use_estimates);
+    }
+    else if (index == 9)
+    {
+        vx_size window = 0;
+        status = vxLKScalarParameter(node, index, VX_TYPE_SIZE, &window);
+        if ((status == VX_SUCCESS) &&
+            ((window < 3) || (window > VX_LK_MAX_WINDOW) || ((window & 1) == 0)))
+        {
+            VX_PRINT(VX_ZONE_ERROR, "The window must be odd and from 3 to %u!\n", VX_LK_MAX_WINDOW);
+            status = VX_ERROR_INVALID_VALUE;
         }
-        vxReleaseParameter(&param);
     }
     return status;
 }
@@ -86,7 +572,7 @@ static vx_status vxOpticalFlowPyrLKInputValidator(vx_node node, vx_uint32 index)
 static vx_status vxOpticalFlowPyrLKOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    if (index == 3)
+    if (index == 4)
     {
         vx_parameter param = vxGetParameterByIndex(node, index);
         if (param)
@@ -97,16 +583,16 @@ static vx_status vxOpticalFlowPyrLKOutputValidator(vx_node node, vx_uint32 index
             {
                 vx_enum type = 0;
                 vxQueryList(list, VX_LIST_ATTRIBUTE_TYPE, &type, sizeof(type));
-                if (type == VX_TYPE_COORDINATES)
+                if (type == VX_TYPE_KEYPOINT)
                 {
                     ptr->type = VX_TYPE_LIST;
                     ptr->dim.list.type = type;
-                    ptr->dim.list.initial = 1000; // guess
+                    ptr->dim.list.initial = 2000; // one per old point, which is a guess
                     status = VX_SUCCESS;
                 }
             }
+            vxReleaseParameter(&param);
         }
-        vxReleaseParameter(&param);
     }
     return status;
 }
@@ -116,11 +602,12 @@ static vx_param_description_t optpyrlk_kernel_params[] = {
     {VX_INPUT, VX_TYPE_PYRAMID, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_LIST, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_LIST, VX_PARAMETER_STATE_REQUIRED},
-    {VX_OUTPUT, VX_TYPE_ENUM, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_LIST, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
     {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
-    {VX_INPUT, VX_TYPE_SIZE, VX_PARAMETER_STATE_REQUIRED},
 };
 
 vx_kernel_description_t optpyrlk_kernel = {
@@ -130,7 +617,6 @@ vx_kernel_description_t optpyrlk_kernel = {
     optpyrlk_kernel_params, dimof(optpyrlk_kernel_params),
     vxOpticalFlowPyrLKInputValidator,
     vxOpticalFlowPyrLKOutputValidator,
-    NULL,
+    vxOpticalFlowPyrLKInitializer,
     NULL,
 };
-
@@ -64,18 +64,14 @@ static vx_status vxPhaseKernel(vx_node node, vx_reference *parameters, vx_uint32
                 vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
                 /* -M_PI to M_PI */
                 double arct = atan2((double)in_y[0],(double)in_x[0]);
-                /* 0.0 - 1.0 */
+                /* 0 - VX_TAU */
                 double norm = arct;
                 if (arct < 0.0)
                 {
                     norm = VX_TAU + arct;
                 }
                 /* 0 - 255 */
-                *dst = (vx_uint8)((vx_uint32)(norm * 255u) & 0xFFu);
-                if (in_y[0] != 0 || in_x[0] != 0)
-                {
-                    VX_PRINT(VX_ZONE_INFO, "atan2(%d,%d) = %lf [norm=%lf] dst=%02x\n", in_y[0], in_x[0], arct, norm, *dst);
-                }
+                *dst = (vx_uint8)((norm * 255.0) / VX_TAU);
             }
         }
         status |= vxCommitImagePatch(grad_x, 0, 0, &src_addr_x, src_base_x);
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Remap Kernel
+ * \details The float coordinates of the remap table are converted once, when
+ * the node is initialized, into a table of 16 bit source pixels and fixed
+ * point fractions kept in its local data. The table is converted again only
+ * when the remap has been written since. Each band of output rows is then
+ * gathered in tiles, so that the source rows a tile reads stay in the cache
+ * while it is filled.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*! \brief The fraction bits of the source coordinates. */
+#define VX_REMAP_BITS (10)
+
+/*! \brief The size of the tiles each band of output rows is gathered in. */
+#define VX_REMAP_TILE_W (64)
+#define VX_REMAP_TILE_H (16)
+
+/*! \brief The largest source image, so that every source pixel fits in 16 bits. */
+#define VX_REMAP_MAX_SIZE (32767)
+
+/*! \brief The source pixel of one output pixel: the pixel at or before the
+ * coordinates and, for bilinear, the fractions towards the next one.
+ */
+typedef struct _vx_remap_entry_t {
+    vx_int16 x, y;
+    vx_uint16 fx, fy;
+} vx_remap_entry_t;
+
+/*! \brief The header of the local data of a node, followed by the entries of
+ * the output pixels row by row.
+ */
+typedef struct _vx_remap_tables_t {
+    vx_enum type;
+    vx_uint32 w1, h1, w2, h2;
+    /*! \brief The write count of the remap the entries were converted from. */
+    vx_uint32 write_count;
+    /*! \brief The number of bands. */
+    vx_uint32 count;
+} vx_remap_tables_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_remap_run_t {
+    vx_remap_tables_t *tables;
+    vx_remap_entry_t *entries;
+    const vx_float32 *map;
+    vx_imagepatch_addressing_t map_addr;
+    vx_uint8 *src;
+    vx_uint8 *dst;
+    vx_imagepatch_addressing_t src_addr;
+    vx_imagepatch_addressing_t dst_addr;
+    vx_uint8 constant;
+} vx_remap_run_t;
+
+static vx_size vxRemapHeaderSize(void)
+{
+    return (sizeof(vx_remap_tables_t) + 15) & ~(vx_size)15;
+}
+
+static vx_size vxRemapLocalSize(const vx_remap_tables_t *t)
+{
+    return vxRemapHeaderSize() + (vx_size)t->w2 * t->h2 * sizeof(vx_remap_entry_t);
+}
+
+static void vxRemapHeader(vx_remap_tables_t *t, vx_node node, vx_enum type, vx_remap table,
+                          vx_uint32 w1, vx_uint32 h1)
+{
+    memset(t, 0, sizeof(*t));
+    t->type = type;
+    t->w1 = w1;
+    t->h1 = h1;
+    vxQueryRemap(table, VX_REMAP_ATTRIBUTE_DESTINATION_WIDTH, &t->w2, sizeof(t->w2));
+    vxQueryRemap(table, VX_REMAP_ATTRIBUTE_DESTINATION_HEIGHT, &t->h2, sizeof(t->h2));
+    t->write_count = ((vx_reference_t *)table)->write_count;
+    t->count = vxBandCount(node, t->w2, t->h2);
+    if (t->count > t->h2)
+        t->count = t->h2;
+}
+
+/*! \brief Converts a source coordinate into a pixel and a fraction. Coordinates
+ * which are not finite or lie far outside of the n pixels of the source are
+ * moved to -2, from where neither the pixel nor the next one is inside, so
+ * that every pixel fits in 16 bits.
+ */
+static vx_int16 vxRemapCoordinate(vx_enum type, vx_float32 c, vx_uint32 n, vx_uint16 *f)
+{
+    vx_float64 p;
+    *f = 0;
+    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+    {
+        p = floor((vx_float64)c + 0.5);
+    }
+    else
+    {
+        vx_float64 s = floor((vx_float64)c * (1 << VX_REMAP_BITS) + 0.5);
+        p = floor(s / (1 << VX_REMAP_BITS));
+        *f = (vx_uint16)(s - p * (1 << VX_REMAP_BITS));
+    }
+    /* written as a negation so that NaN takes the sentinel too */
+    if (!((p >= -2.0) && (p <= (vx_float64)n)))
+    {
+        p = -2.0;
+        *f = 0;
+    }
+    return (vx_int16)p;
+}
+
+static void vxRemapBuildBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_remap_run_t *r = (vx_remap_run_t *)arg;
+    const vx_remap_tables_t *t = r->tables;
+    vx_uint32 x, y;
+    (void)index;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_float32 *coord = (const vx_float32 *)((const vx_uint8 *)r->map + y * r->map_addr.stride_y);
+        vx_remap_entry_t *e = &r->entries[(vx_size)y * t->w2];
+        for (x = 0; x < t->w2; x++)
+        {
+            e[x].x = vxRemapCoordinate(t->type, coord[2 * x + 0], t->w1, &e[x].fx);
+            e[x].y = vxRemapCoordinate(t->type, coord[2 * x + 1], t->h1, &e[x].fy);
+        }
+    }
+}
+
+/*! \brief Converts the coordinates of the remap into the entries which follow a header. */
+static vx_status vxRemapBuild(vx_node node, vx_remap_tables_t *t, vx_remap table)
+{
+    vx_status status = VX_SUCCESS;
+    vx_rectangle rect = vxCreateRectangle(vxGetContext(node), 0, 0, t->w2, t->h2);
+    void *base = NULL;
+    vx_remap_run_t r;
+
+    memset(&r, 0, sizeof(r));
+    status = vxAccessRemapPatch(table, rect, &r.map_addr, &base);
+    if (status == VX_SUCCESS)
+    {
+        r.tables = t;
+        r.entries = (vx_remap_entry_t *)((vx_uint8 *)t + vxRemapHeaderSize());
+        r.map = (const vx_float32 *)base;
+        vxRunBands(node, t->count, t->h2, vxRemapBuildBand, &r);
+        status = vxCommitRemapPatch(table, 0, &r.map_addr, base);
+    }
+    vxReleaseRectangle(&rect);
+    return status;
+}
+
+/*! \brief Reads a source pixel, or the constant of the border outside of the image. */
+static vx_uint8 vxRemapPixel(const vx_remap_run_t *r, vx_int32 x, vx_int32 y)
+{
+    if (((vx_uint32)x < r->tables->w1) && ((vx_uint32)y < r->tables->h1))
+        return r->src[y * r->src_addr.stride_y + x * r->src_addr.stride_x];
+    return r->constant;
+}
+
+/*! \brief Blends four pixels by the fractions of an entry. Each step multiplies
+ * by weights which add up to 1 << VX_REMAP_BITS, so the sum fits in 28 bits.
+ */
+static vx_uint8 vxRemapBlend(vx_int32 p00, vx_int32 p01, vx_int32 p10, vx_int32 p11, vx_int32 fx, vx_int32 fy)
+{
+    const vx_int32 one = 1 << VX_REMAP_BITS;
+    vx_int32 top = p00 * (one - fx) + p01 * fx;
+    vx_int32 bot = p10 * (one - fx) + p11 * fx;
+    return (vx_uint8)((top * (one - fy) + bot * fy + (1 << (2 * VX_REMAP_BITS - 1))) >> (2 * VX_REMAP_BITS));
+}
+
+static void vxRemapTile(const vx_remap_run_t *r, vx_uint32 x0, vx_uint32 x1, vx_uint32 y0, vx_uint32 y1)
+{
+    const vx_remap_tables_t *t = r->tables;
+    const vx_int32 sx = r->src_addr.stride_x, sy = r->src_addr.stride_y, dx = r->dst_addr.stride_x;
+    vx_uint32 x, y;
+
+    for (y = y0; y < y1; y++)
+    {
+        const vx_remap_entry_t *e = &r->entries[(vx_size)y * t->w2];
+        vx_uint8 *dst = r->dst + y * r->dst_addr.stride_y;
+        if (t->type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+        {
+            for (x = x0; x < x1; x++)
+            {
+                if (((vx_uint32)e[x].x < t->w1) && ((vx_uint32)e[x].y < t->h1))
+                    dst[x * dx] = r->src[e[x].y * sy + e[x].x * sx];
+                else
+                    dst[x * dx] = r->constant;
+            }
+        }
+        else
+        {
+            for (x = x0; x < x1; x++)
+            {
+                vx_int32 ex = e[x].x, ey = e[x].y;
+                /* the four pixels are inside, away from the right and bottom edges */
+                if (((vx_uint32)ex < t->w1 - 1) && ((vx_uint32)ey < t->h1 - 1))
+                {
+                    const vx_uint8 *p = &r->src[ey * sy + ex * sx];
+                    dst[x * dx] = vxRemapBlend(p[0], p[sx], p[sy], p[sy + sx], e[x].fx, e[x].fy);
+                }
+                else
+                {
+                    dst[x * dx] = vxRemapBlend(vxRemapPixel(r, ex, ey), vxRemapPixel(r, ex + 1, ey),
+                                               vxRemapPixel(r, ex, ey + 1), vxRemapPixel(r, ex + 1, ey + 1),
+                                               e[x].fx, e[x].fy);
+                }
+            }
+        }
+    }
+}
+
+static void vxRemapBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_remap_run_t *r = (vx_remap_run_t *)arg;
+    vx_uint32 tx, ty, w2 = r->tables->w2;
+    (void)index;
+    for (ty = y0; ty < y1; ty += VX_REMAP_TILE_H)
+    {
+        vx_uint32 ey = (ty + VX_REMAP_TILE_H < y1) ? ty + VX_REMAP_TILE_H : y1;
+        for (tx = 0; tx < w2; tx += VX_REMAP_TILE_W)
+        {
+            vx_uint32 ex = (tx + VX_REMAP_TILE_W < w2) ? tx + VX_REMAP_TILE_W : w2;
+            vxRemapTile(r, tx, ex, ty, ey);
+        }
+    }
+}
+
+static vx_status vxRemapKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 4)
+    {
+        vx_image src_image = (vx_image)parameters[0];
+        vx_remap table = (vx_remap)parameters[1];
+        vx_scalar stype = (vx_scalar)parameters[2];
+        vx_image dst_image = (vx_image)parameters[3];
+        vx_enum type = VX_INTERPOLATION_TYPE_BILINEAR;
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+        vx_uint32 w1 = 0, h1 = 0;
+        void *src_base = NULL, *dst_base = NULL, *local = NULL;
+        vx_size local_size = 0;
+        vx_remap_tables_t header, *tables = NULL;
+        vx_remap_run_t r;
+
+        if (stype)
+            vxAccessScalarValue(stype, &type);
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        if ((borders.mode != VX_BORDER_MODE_UNDEFINED) &&
+            (borders.mode != VX_BORDER_MODE_CONSTANT))
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Remap supports only undefined or constant borders\n");
+            return VX_ERROR_NOT_SUPPORTED;
+        }
+        /* the interpolation may have changed since the validator saw it */
+        if ((type != VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) &&
+            (type != VX_INTERPOLATION_TYPE_BILINEAR))
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Remap supports only nearest neighbor or bilinear interpolation\n");
+            return VX_ERROR_NOT_SUPPORTED;
+        }
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        vxRemapHeader(&header, node, type, table, w1, h1);
+
+        /* the entries of the initializer are converted again only if the
+         * interpolation or the remap have changed since */
+        status = VX_SUCCESS;
+        if (local && (local_size >= vxRemapLocalSize(&header)))
+        {
+            tables = (vx_remap_tables_t *)local;
+            if (memcmp(tables, &header, sizeof(header)) != 0)
+            {
+                *tables = header;
+                status = vxRemapBuild(node, tables, table);
+            }
+        }
+        else
+        {
+            tables = (vx_remap_tables_t *)calloc(1, vxRemapLocalSize(&header));
+            if (tables)
+            {
+                *tables = header;
+                status = vxRemapBuild(node, tables, table);
+            }
+        }
+
+        if (tables && (status == VX_SUCCESS))
+        {
+            vx_rectangle src_rect = vxCreateRectangle(vxGetContext(src_image), 0, 0, w1, h1);
+            vx_rectangle dst_rect = vxCreateRectangle(vxGetContext(dst_image), 0, 0, header.w2, header.h2);
+
+            memset(&r, 0, sizeof(r));
+            status |= vxAccessImagePatch(src_image, src_rect, 0, &r.src_addr, &src_base);
+            status |= vxAccessImagePatch(dst_image, dst_rect, 0, &r.dst_addr, &dst_base);
+            if (status == VX_SUCCESS)
+            {
+                r.tables = tables;
+                r.entries = (vx_remap_entry_t *)((vx_uint8 *)tables + vxRemapHeaderSize());
+                r.src = (vx_uint8 *)src_base;
+                r.dst = (vx_uint8 *)dst_base;
+                /* the undefined border reads zeros */
+                r.constant = (borders.mode == VX_BORDER_MODE_CONSTANT) ? (vx_uint8)borders.constant_value : 0;
+                vxRunBands(node, tables->count, tables->h2, vxRemapBand, &r);
+            }
+            status |= vxCommitImagePatch(src_image, 0, 0, &r.src_addr, src_base);
+            status |= vxCommitImagePatch(dst_image, dst_rect, 0, &r.dst_addr, dst_base);
+            vxReleaseRectangle(&src_rect);
+            vxReleaseRectangle(&dst_rect);
+        }
+        else if (tables == NULL)
+        {
+            status = VX_ERROR_NO_MEMORY;
+        }
+        if (tables != (vx_remap_tables_t *)local)
+            free(tables);
+    }
+    return status;
+}
+
+/*! \brief Converts the remap once, as the local data of the node. */
+static vx_status vxRemapInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 4)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_remap table = (vx_remap)parameters[1];
+        vx_scalar stype = (vx_scalar)parameters[2];
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel converts
+         * the remap again if it has changed since */
+        if (local == NULL)
+        {
+            vx_enum type = VX_INTERPOLATION_TYPE_BILINEAR;
+            vx_uint32 w1 = 0, h1 = 0;
+            vx_remap_tables_t header;
+            vx_size size;
+
+            if (stype)
+                vxAccessScalarValue(stype, &type);
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+            vxRemapHeader(&header, node, type, table, w1, h1);
+            size = vxRemapLocalSize(&header);
+            local = calloc(1, size);
+            if (local)
+            {
+                *(vx_remap_tables_t *)local = header;
+                status |= vxRemapBuild(node, (vx_remap_tables_t *)local, table);
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+    }
+    return status;
+}
+
+static vx_status vxRemapInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vx_uint32 width = 0, height = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            if ((format == FOURCC_U8) &&
+                (width <= VX_REMAP_MAX_SIZE) && (height <= VX_REMAP_MAX_SIZE))
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 1)
+    {
+        vx_parameter src_param = vxGetParameterByIndex(node, 0);
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        vx_image input = 0;
+        vx_remap table = 0;
+
+        vxQueryParameter(src_param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &table, sizeof(table));
+        if (input && table)
+        {
+            vx_uint32 w1 = 0, h1 = 0, src_w = 0, src_h = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+            vxQueryRemap(table, VX_REMAP_ATTRIBUTE_SOURCE_WIDTH, &src_w, sizeof(src_w));
+            vxQueryRemap(table, VX_REMAP_ATTRIBUTE_SOURCE_HEIGHT, &src_h, sizeof(src_h));
+            if ((w1 == src_w) && (h1 == src_h))
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&src_param);
+        vxReleaseParameter(&param);
+    }
+    else if (index == 2)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar scalar = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &scalar, sizeof(scalar));
+            if (scalar)
+            {
+                vx_enum stype = 0;
+                vxQueryScalar(scalar, VX_SCALAR_ATTRIBUTE_TYPE, &stype, sizeof(stype));
+                if (stype == VX_TYPE_ENUM)
+                {
+                    vx_enum interp = 0;
+                    vxAccessScalarValue(scalar, &interp);
+                    if ((interp == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ||
+                        (interp == VX_INTERPOLATION_TYPE_BILINEAR))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                    else
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_TYPE;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_status vxRemapOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 3)
+    {
+        vx_parameter table_param = vxGetParameterByIndex(node, 1);
+        vx_parameter dst_param = vxGetParameterByIndex(node, index);
+        if (table_param && dst_param)
+        {
+            vx_remap table = 0;
+            vx_image dst = 0;
+            vxQueryParameter(table_param, VX_PARAMETER_ATTRIBUTE_REF, &table, sizeof(table));
+            vxQueryParameter(dst_param, VX_PARAMETER_ATTRIBUTE_REF, &dst, sizeof(dst));
+            if ((table) && (dst))
+            {
+                vx_uint32 w2 = 0, h2 = 0;
+
+                vxQueryRemap(table, VX_REMAP_ATTRIBUTE_DESTINATION_WIDTH, &w2, sizeof(w2));
+                vxQueryRemap(table, VX_REMAP_ATTRIBUTE_DESTINATION_HEIGHT, &h2, sizeof(h2));
+                if ((w2 != 0) && (h2 != 0))
+                {
+                    /* fill in the meta data with the attributes so that the checker will pass */
+                    ptr->type = VX_TYPE_IMAGE;
+                    ptr->dim.image.format = FOURCC_U8;
+                    ptr->dim.image.width = w2;
+                    ptr->dim.image.height = h2;
+                    status = VX_SUCCESS;
+                }
+            }
+        }
+        if (table_param)
+            vxReleaseParameter(&table_param);
+        if (dst_param)
+            vxReleaseParameter(&dst_param);
+    }
+    return status;
+}
+
+static vx_param_description_t remap_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_REMAP, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t remap_kernel = {
+    VX_KERNEL_REMAP,
+    "org.khronos.openvx.remap",
+    vxRemapKernel,
+    remap_kernel_params, dimof(remap_kernel_params),
+    vxRemapInputValidator,
+    vxRemapOutputValidator,
+    vxRemapInitializer,
+    NULL,
+};
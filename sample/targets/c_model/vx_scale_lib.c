@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The tables, local data and validation of the Image Scale Kernel.
+ * \author Erik Rainey <erik.rainey@ti.com>
+ */
+
+#include <vx_scale_lib.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static vx_size vxScaleAlign(vx_size size)
+{
+    return (size + 15) & ~(vx_size)15;
+}
+
+/*! \brief The number of source pixels each output pixel is filtered from, along
+ * an axis of n1 pixels scaled to n2.
+ */
+static vx_uint32 vxScaleTaps(vx_enum type, vx_uint32 n1, vx_uint32 n2)
+{
+    vx_uint32 taps = 2;
+    /* a box of n1 / n2 pixels may straddle one more */
+    if (type == VX_INTERPOLATION_TYPE_AREA)
+        taps = (n1 + n2 - 1) / n2 + 1;
+    return (taps < n1) ? taps : n1;
+}
+
+/*! \brief The scratch of a band: the source row held by each row of the ring,
+ * the rows of the ring in the order of the weights, and the ring.
+ */
+static vx_size vxScaleScratchSize(vx_uint32 w2, vx_uint32 taps_y)
+{
+    return vxScaleAlign(taps_y * sizeof(vx_int32)) +
+           vxScaleAlign(taps_y * sizeof(vx_int16 *)) +
+           vxScaleAlign((vx_size)taps_y * w2 * sizeof(vx_int16));
+}
+
+/*! \brief Splits the output rows by the larger of the two images, which sets the work. */
+static vx_uint32 vxScaleBandCount(vx_node node, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2)
+{
+    vx_uint32 count = vxBandCount(node, (w1 > w2) ? w1 : w2, (h1 > h2) ? h1 : h2);
+    return (count < h2) ? count : h2;
+}
+
+static void vxScaleHeader(vx_scale_tables_t *t, vx_node node, vx_enum type,
+                          vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2)
+{
+    memset(t, 0, sizeof(*t));
+    t->type = type;
+    t->w1 = w1;
+    t->h1 = h1;
+    t->w2 = w2;
+    t->h2 = h2;
+    t->count = vxScaleBandCount(node, w1, h1, w2, h2);
+    if ((w1 == w2) && (h1 == h2))
+        t->path = VX_SCALE_PATH_COPY;
+    else if ((w1 == 2 * w2) && (h1 == 2 * h2))
+        t->path = VX_SCALE_PATH_HALF;
+    else if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+        t->path = VX_SCALE_PATH_NEAREST;
+    else
+    {
+        t->path = VX_SCALE_PATH_FILTER;
+        t->taps_x = vxScaleTaps(type, w1, w2);
+        t->taps_y = vxScaleTaps(type, h1, h2);
+    }
+}
+
+static vx_size vxScaleLocalSize(const vx_scale_tables_t *t)
+{
+    return vxScaleAlign(sizeof(vx_scale_tables_t)) +
+           vxScaleAlign(t->w2 * sizeof(vx_uint32)) +
+           vxScaleAlign(t->h2 * sizeof(vx_uint32)) +
+           vxScaleAlign((vx_size)t->w2 * t->taps_x * sizeof(vx_int16)) +
+           vxScaleAlign((vx_size)t->h2 * t->taps_y * sizeof(vx_int16)) +
+           t->count * vxScaleScratchSize(t->w2, t->taps_y);
+}
+
+/*! \brief Points the state at the tables and the scratch which follow the header. */
+static void vxScaleLayout(vx_scale_t *s, vx_scale_tables_t *t)
+{
+    vx_uint8 *p = (vx_uint8 *)t + vxScaleAlign(sizeof(vx_scale_tables_t));
+    s->tables = t;
+    s->start_x = (vx_uint32 *)p;
+    p += vxScaleAlign(t->w2 * sizeof(vx_uint32));
+    s->start_y = (vx_uint32 *)p;
+    p += vxScaleAlign(t->h2 * sizeof(vx_uint32));
+    s->weights_x = (vx_int16 *)p;
+    p += vxScaleAlign((vx_size)t->w2 * t->taps_x * sizeof(vx_int16));
+    s->weights_y = (vx_int16 *)p;
+    p += vxScaleAlign((vx_size)t->h2 * t->taps_y * sizeof(vx_int16));
+    s->scratch = p;
+    s->scratch_size = vxScaleScratchSize(t->w2, t->taps_y);
+}
+
+/*! \brief Computes the first source pixel of each of the n2 output pixels along
+ * an axis and, unless taps is zero for nearest neighbor, their weights. The
+ * center of output pixel i maps to (i + 0.5) * n1 / n2 in the source.
+ */
+static void vxScaleAxis(vx_enum type, vx_uint32 n1, vx_uint32 n2, vx_uint32 taps, vx_uint32 *start, vx_int16 *weights)
+{
+    const vx_int32 one = 1 << VX_SCALE_BITS;
+    vx_uint32 i, j;
+    for (i = 0; i < n2; i++)
+    {
+        vx_int16 *w = &weights[(vx_size)i * taps];
+        if (taps == 0)
+        {
+            vx_uint64 c = ((2 * (vx_uint64)i + 1) * n1) / (2 * (vx_uint64)n2);
+            start[i] = (c < n1) ? (vx_uint32)c : n1 - 1;
+        }
+        else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
+        {
+            /* between the centers of source pixels i0 and i0 + 1, at ((2i + 1) n1 - n2) / 2 n2 */
+            vx_int64 num = (2 * (vx_int64)i + 1) * n1 - n2, den = 2 * (vx_int64)n2;
+            vx_int64 i0 = 0, f = 0;
+            if (num > 0)
+            {
+                i0 = num / den;
+                f = ((num - i0 * den) * one + den / 2) / den;
+                if (f == one)
+                {
+                    i0++;
+                    f = 0;
+                }
+            }
+            if (i0 >= (vx_int64)n1 - 1)
+            {
+                i0 = n1 - 1;
+                f = 0;
+            }
+            start[i] = ((vx_uint32)i0 + taps <= n1) ? (vx_uint32)i0 : n1 - taps;
+            memset(w, 0, taps * sizeof(vx_int16));
+            w[i0 - start[i]] = (vx_int16)(one - f);
+            if (f > 0)
+                w[i0 + 1 - start[i]] = (vx_int16)f;
+        }
+        else
+        {
+            /* the box [i n1, (i + 1) n1) over the pixels [j n2, (j + 1) n2), in units of 1 / n2 */
+            vx_uint64 b0 = (vx_uint64)i * n1, b1 = b0 + n1;
+            vx_uint32 lo = (vx_uint32)(b0 / n2), hi = (vx_uint32)((b1 - 1) / n2), big;
+            vx_int32 sum = 0;
+            start[i] = (lo + taps <= n1) ? lo : n1 - taps;
+            big = lo - start[i];
+            memset(w, 0, taps * sizeof(vx_int16));
+            for (j = lo; j <= hi; j++)
+            {
+                vx_uint64 p0 = (vx_uint64)j * n2, p1 = p0 + n2;
+                vx_uint64 overlap = ((b1 < p1) ? b1 : p1) - ((b0 > p0) ? b0 : p0);
+                vx_int16 v = (vx_int16)((overlap * one + n1 / 2) / n1);
+                w[j - start[i]] = v;
+                sum += v;
+                if (v > w[big])
+                    big = j - start[i];
+            }
+            /* the largest weight takes the rounding, so that the weights add up to one */
+            w[big] = (vx_int16)(w[big] + one - sum);
+        }
+    }
+}
+
+/*! \brief Fills the tables which follow a header. */
+static void vxScaleBuild(vx_scale_tables_t *t)
+{
+    vx_scale_t s;
+    vxScaleLayout(&s, t);
+    if (t->path >= VX_SCALE_PATH_NEAREST)
+    {
+        vxScaleAxis(t->type, t->w1, t->w2, t->taps_x, s.start_x, s.weights_x);
+        vxScaleAxis(t->type, t->h1, t->h2, t->taps_y, s.start_y, s.weights_y);
+    }
+}
+
+void vxScaleFilterBand(vx_scale_t *s, vx_uint32 index, vx_uint32 y0, vx_uint32 y1,
+                       vx_scale_row_x_f row_x, vx_scale_row_y_f row_y)
+{
+    const vx_scale_tables_t *t = s->tables;
+    vx_uint8 *scratch = s->scratch + index * s->scratch_size;
+    vx_int32 *held = (vx_int32 *)scratch;
+    const vx_int16 **rows = (const vx_int16 **)(scratch + vxScaleAlign(t->taps_y * sizeof(vx_int32)));
+    vx_int16 *ring = (vx_int16 *)((vx_uint8 *)rows + vxScaleAlign(t->taps_y * sizeof(vx_int16 *)));
+    vx_uint32 y, k;
+
+    /* the source rows of each output row follow those of the row above,
+     * so each is filtered along x once per band */
+    for (k = 0; k < t->taps_y; k++)
+        held[k] = -1;
+    for (y = y0; y < y1; y++)
+    {
+        for (k = 0; k < t->taps_y; k++)
+        {
+            vx_uint32 r = s->start_y[y] + k, slot = r % t->taps_y;
+            vx_int16 *row = &ring[slot * t->w2];
+            if (held[slot] != (vx_int32)r)
+            {
+                row_x(s, row, r);
+                held[slot] = (vx_int32)r;
+            }
+            rows[k] = row;
+        }
+        row_y(s, y, rows);
+    }
+}
+
+vx_status vxScaleImage(vx_node node, vx_reference *parameters, vx_uint32 num,
+                       vx_scale_access_f access, vx_band_f band)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 3)
+    {
+        vx_image src_image = (vx_image)parameters[0];
+        vx_image dst_image = (vx_image)parameters[1];
+        vx_scalar stype = (vx_scalar)parameters[2];
+        vx_enum type = VX_INTERPOLATION_TYPE_BILINEAR;
+        vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
+        void *src_base = NULL, *dst_base = NULL, *local = NULL;
+        vx_size local_size = 0;
+        vx_scale_tables_t header, *tables = NULL;
+        vx_scale_t s;
+
+        /*! \bug Should ScaleImage use the valid region of the image
+         * as the scaling information or the width,height? If it uses the valid
+         * region, should is scale the valid region within bounds of the
+         * image?
+         */
+        if (stype)
+            vxAccessScalarValue(stype, &type);
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+        vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
+        vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        vxScaleHeader(&header, node, type, w1, h1, w2, h2);
+
+        /* the tables of the initializer are rebuilt only if the interpolation
+         * or the images have changed since */
+        if (local && (local_size >= vxScaleLocalSize(&header)))
+        {
+            tables = (vx_scale_tables_t *)local;
+            if (memcmp(tables, &header, sizeof(header)) != 0)
+            {
+                *tables = header;
+                vxScaleBuild(tables);
+            }
+        }
+        else
+        {
+            tables = (vx_scale_tables_t *)calloc(1, vxScaleLocalSize(&header));
+            if (tables)
+            {
+                *tables = header;
+                vxScaleBuild(tables);
+            }
+        }
+
+        if (tables)
+        {
+            vx_rectangle src_rect = vxCreateRectangle(vxGetContext(src_image), 0, 0, w1, h1);
+            vx_rectangle dst_rect = vxCreateRectangle(vxGetContext(dst_image), 0, 0, w2, h2);
+
+            memset(&s, 0, sizeof(s));
+            status = VX_SUCCESS;
+            status |= access(src_image, src_rect, &s.src_addr, &src_base);
+            status |= access(dst_image, dst_rect, &s.dst_addr, &dst_base);
+            if (status == VX_SUCCESS)
+            {
+                vxScaleLayout(&s, tables);
+                s.src = (vx_uint8 *)src_base;
+                s.dst = (vx_uint8 *)dst_base;
+                vxRunBands(node, tables->count, h2, band, &s);
+            }
+            status |= vxCommitImagePatch(src_image, 0, 0, &s.src_addr, src_base);
+            status |= vxCommitImagePatch(dst_image, dst_rect, 0, &s.dst_addr, dst_base);
+            vxReleaseRectangle(&src_rect);
+            vxReleaseRectangle(&dst_rect);
+            if (tables != (vx_scale_tables_t *)local)
+                free(tables);
+        }
+        else
+        {
+            status = VX_ERROR_NO_MEMORY;
+        }
+    }
+    return status;
+}
+
+/*! \brief Builds the tables and allocates the scratch of the bands once, as the local data of the node. */
+vx_status vxScaleImageInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 3)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[1];
+        vx_scalar stype = (vx_scalar)parameters[2];
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel rebuilds
+         * the tables if the interpolation or the images have changed since */
+        if (local == NULL)
+        {
+            vx_enum type = VX_INTERPOLATION_TYPE_BILINEAR;
+            vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
+            vx_scale_tables_t header;
+            vx_size size;
+
+            if (stype)
+                vxAccessScalarValue(stype, &type);
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+            vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
+            vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+            vxScaleHeader(&header, node, type, w1, h1, w2, h2);
+            size = vxScaleLocalSize(&header);
+            local = calloc(1, size);
+            if (local)
+            {
+                *(vx_scale_tables_t *)local = header;
+                vxScaleBuild((vx_scale_tables_t *)local);
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+    }
+    return status;
+}
+
+vx_status vxScaleImageInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8)
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 2)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar scalar = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &scalar, sizeof(scalar));
+            if (scalar)
+            {
+                vx_enum stype = 0;
+                vxQueryScalar(scalar, VX_SCALAR_ATTRIBUTE_TYPE, &stype, sizeof(stype));
+                if (stype == VX_TYPE_ENUM)
+                {
+                    vx_enum interp = 0;
+                    vxAccessScalarValue(scalar, &interp);
+                    if ((interp == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ||
+                        (interp == VX_INTERPOLATION_TYPE_BILINEAR) ||
+                        (interp == VX_INTERPOLATION_TYPE_AREA))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                    else
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_TYPE;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+vx_status vxScaleImageOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 1)
+    {
+        vx_parameter src_param = vxGetParameterByIndex(node, 0);
+        vx_parameter dst_param = vxGetParameterByIndex(node, index);
+        if (src_param && dst_param)
+        {
+            vx_image src = 0;
+            vx_image dst = 0;
+            vxQueryParameter(src_param, VX_PARAMETER_ATTRIBUTE_REF, &src, sizeof(src));
+            vxQueryParameter(dst_param, VX_PARAMETER_ATTRIBUTE_REF, &dst, sizeof(dst));
+            if ((src) && (dst))
+            {
+                vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
+                vx_fourcc f1 = FOURCC_VIRT, f2 = FOURCC_VIRT;
+
+                vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
+                vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
+                vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
+                vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+                vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &f1, sizeof(f1));
+                vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &f2, sizeof(f2));
+                /* output can not be virtual */
+                if ((w2 != 0) && (h2 != 0) && (f2 != FOURCC_VIRT) && (f1 == f2))
+                {
+                    /* fill in the meta data with the attributes so that the checker will pass */
+                    ptr->type = VX_TYPE_IMAGE;
+                    ptr->dim.image.format = f2;
+                    ptr->dim.image.width = w2;
+                    ptr->dim.image.height = h2;
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&src_param);
+            vxReleaseParameter(&dst_param);
+        }
+    }
+    return status;
+}
+
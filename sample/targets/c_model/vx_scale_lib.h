@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+#ifndef _OPENVX_SCALE_LIB_H_
+#define _OPENVX_SCALE_LIB_H_
+
+/*!
+ * \file
+ * \brief The tables, local data and validation of the Image Scale Kernel,
+ * shared by the targets which implement it.
+ * \details The scaler is separable: each output pixel is a weighted sum of a
+ * few source pixels along x and then along y. The first source pixel and the
+ * fixed point weights of every output column and row are computed once, when
+ * the node is initialized, and kept in its local data. Each band of output rows
+ * filters the source rows it needs along x into a ring of 16 bit rows, and then
+ * filters the ring along y. A target provides the bands, and so the row loops.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+
+/*! \brief The fraction bits of the weights, which add up to 1 << VX_SCALE_BITS along each axis. */
+#define VX_SCALE_BITS (14)
+
+/*! \brief The bits dropped after filtering along x, which leaves 7 fraction bits
+ * in the rows of the ring, at most 255 << 7.
+ */
+#define VX_SCALE_SHIFT_X (7)
+
+/*! \brief The bits dropped after filtering along y. */
+#define VX_SCALE_SHIFT_Y (2 * VX_SCALE_BITS - VX_SCALE_SHIFT_X)
+
+/*! \brief The ways to scale an image, fastest first. */
+enum vx_scale_path_e {
+    /*! \brief The sizes match, and every interpolation copies the image. */
+    VX_SCALE_PATH_COPY = 0,
+    /*! \brief Exactly 2:1 in both directions, from blocks of 2x2 pixels. */
+    VX_SCALE_PATH_HALF,
+    /*! \brief Nearest neighbor, from the source pixel of each column and row. */
+    VX_SCALE_PATH_NEAREST,
+    /*! \brief Bilinear or area, from the weights of each column and row. */
+    VX_SCALE_PATH_FILTER,
+};
+
+/*! \brief The header of the local data of a node. The first source pixel of
+ * each output column and row, their weights and the scratch of each band follow it.
+ */
+typedef struct _vx_scale_tables_t {
+    vx_enum type;
+    vx_enum path;
+    vx_uint32 w1, h1, w2, h2;
+    /*! \brief The number of weights of each column and of each row. */
+    vx_uint32 taps_x, taps_y;
+    /*! \brief The number of bands. */
+    vx_uint32 count;
+} vx_scale_tables_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_scale_t {
+    vx_scale_tables_t *tables;
+    vx_uint32 *start_x;
+    vx_uint32 *start_y;
+    vx_int16 *weights_x;
+    vx_int16 *weights_y;
+    vx_uint8 *scratch;
+    vx_size scratch_size;
+    vx_uint8 *src;
+    vx_uint8 *dst;
+    vx_imagepatch_addressing_t src_addr;
+    vx_imagepatch_addressing_t dst_addr;
+} vx_scale_t;
+
+/*! \brief Filters source row y along x into a row of the ring. */
+typedef void (*vx_scale_row_x_f)(const vx_scale_t *s, vx_int16 *out, vx_uint32 y);
+
+/*! \brief Filters rows of the ring along y into output row y. */
+typedef void (*vx_scale_row_y_f)(const vx_scale_t *s, vx_uint32 y, const vx_int16 *const *rows);
+
+/*! \brief Gives access to the pixels of plane 0 of an image. */
+typedef vx_status (*vx_scale_access_f)(vx_image image, vx_rectangle rect, vx_imagepatch_addressing_t *addr, void **base);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Filters the output rows [y0, y1) of band index through its ring. */
+void vxScaleFilterBand(vx_scale_t *s, vx_uint32 index, vx_uint32 y0, vx_uint32 y1,
+                       vx_scale_row_x_f row_x, vx_scale_row_y_f row_y);
+
+/*! \brief Executes the kernel: selects the tables, accesses the images and runs the bands.
+ * \param [in] access Accesses the images for the bands, committed with \ref vxCommitImagePatch.
+ * \param [in] band Scales the output rows [y0, y1) of a band, with the \ref vx_scale_t as arg.
+ */
+vx_status vxScaleImage(vx_node node, vx_reference *parameters, vx_uint32 num,
+                       vx_scale_access_f access, vx_band_f band);
+
+/*! \brief Builds the tables and allocates the scratch of the bands, as the local data of the node. */
+vx_status vxScaleImageInitializer(vx_node node, vx_reference *parameters, vx_uint32 num);
+
+vx_status vxScaleImageInputValidator(vx_node node, vx_uint32 index);
+
+vx_status vxScaleImageOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,86 +23,229 @@
 
 /*!
  * \file
- * \brief The Image Scale Kernel
+ * \brief The Affine and Perspective Warp Kernels
+ * \details Output pixel (x, y) is read from the input at the coordinates the
+ * matrix maps it to. The output is filled in tiles, so that the source rows a
+ * tile reads stay in the cache. Along each row of a tile the affine
+ * coordinates are stepped in 16.16 fixed point from the start of the row,
+ * and the perspective ones are stepped before the division. Matrices which
+ * only translate and scale map every column and every row on their own, so
+ * their coordinates are computed once per column and once per row.
  * \author Erik Rainey <erik.rainey@ti.com>
  */
 
 #include <VX/vx.h>
 #include <VX/vx_helper.h>
+
 #include <vx_internal.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
-static vx_status vxWarpPerspectiveKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief The fraction bits of the stepped coordinates. */
+#define VX_WARP_SHIFT (16)
+
+/*! \brief The fraction bits of the bilinear weights. */
+#define VX_WARP_BITS (10)
+
+/*! \brief The coordinates are clamped to this many pixels, far outside of any
+ * image, so that they and their steps fit in 64 bits.
+ */
+#define VX_WARP_LIMIT (1073741824.0)
+
+/*! \brief The size of the tiles each band of output rows is filled in. */
+#define VX_WARP_TILE_W (64)
+#define VX_WARP_TILE_H (16)
+
+/*! \brief A source pixel along one axis and, for bilinear, the fraction towards the next. */
+typedef struct _vx_warp_axis_t {
+    vx_int32 p;
+    vx_int32 f;
+} vx_warp_axis_t;
+
+/*! \brief The state of one execution of a warp, shared by its bands. */
+typedef struct _vx_warp_t {
+    /*! \brief The source x, y and z are m[0][i] * x + m[1][i] * y + m[2][i]. */
+    vx_float64 m[3][3];
+    vx_bool perspective;
+    /*! \brief The source x depends only on x, and the source y only on y. */
+    vx_bool separable;
+    vx_enum type;
+    vx_border_mode_t borders;
+    vx_uint32 w1, h1, w2, h2;
+    /*! \brief The source of each column and of each row, when separable. */
+    vx_warp_axis_t *cols;
+    vx_warp_axis_t *rows;
+    vx_uint8 *src;
+    vx_uint8 *dst;
+    vx_imagepatch_addressing_t src_addr;
+    vx_imagepatch_addressing_t dst_addr;
+} vx_warp_t;
+
+/*! \brief Converts a coordinate to fixed point. NaN and infinities, from
+ * perspective divisions by zero, go out of the image with the rest.
+ */
+static vx_int64 vxWarpFixed(vx_float64 v)
 {
-    vx_status status = VX_FAILURE;
-    if (num == 4)
+    if (!(v > -VX_WARP_LIMIT))
+        v = -VX_WARP_LIMIT;
+    else if (v > VX_WARP_LIMIT)
+        v = VX_WARP_LIMIT;
+    return (vx_int64)floor(v * (1 << VX_WARP_SHIFT) + 0.5);
+}
+
+/*! \brief Splits a fixed point coordinate into the nearest pixel or, for
+ * bilinear, the pixel at or before it and the fraction towards the next.
+ */
+static void vxWarpSplit(vx_enum type, vx_int64 c, vx_warp_axis_t *a)
+{
+    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
     {
-        vx_image src_image = (vx_image)parameters[0];
-        vx_matrix matrix = (vx_matrix)parameters[1];
-        vx_scalar stype = (vx_scalar)parameters[2];
-        vx_image dst_image = (vx_image)parameters[3];
-        vx_enum type = 0;
-        void *src_base = NULL;
-        void *dst_base = NULL;
-        vx_imagepatch_addressing_t src_addr, dst_addr;
-        vx_uint32 y = 0u, x = 0u;
-        vx_float32 m[3][3];
-        vx_rectangle rect = 0;
-
-        memset(m, 0, sizeof(m));
-        rect = vxGetValidRegionImage(src_image);
-        status = VX_SUCCESS;
-        status |= vxAccessMatrix(matrix, m);
-        status |= vxAccessScalarValue(stype, &type);
-        /*! \todo you don't necessarily get the valid region? */
-        status |= vxAccessImagePatch(src_image, rect, 0, &src_addr, &src_base);
-        status |= vxAccessImagePatch(dst_image, rect, 0, &dst_addr, &dst_base);
-        /*! \todo get border mode */
-        if (status == VX_SUCCESS)
+        a->p = (vx_int32)((c + (1 << (VX_WARP_SHIFT - 1))) >> VX_WARP_SHIFT);
+        a->f = 0;
+    }
+    else
+    {
+        c += 1 << (VX_WARP_SHIFT - VX_WARP_BITS - 1);
+        a->p = (vx_int32)(c >> VX_WARP_SHIFT);
+        a->f = (vx_int32)(c >> (VX_WARP_SHIFT - VX_WARP_BITS)) & ((1 << VX_WARP_BITS) - 1);
+    }
+}
+
+/*! \brief Reads a source pixel, or the border outside of the image. The
+ * undefined border reads zeros.
+ */
+static vx_uint8 vxWarpPixel(const vx_warp_t *w, vx_int32 x, vx_int32 y)
+{
+    if (w->borders.mode == VX_BORDER_MODE_REPLICATE)
+    {
+        x = (x < 0) ? 0 : (((vx_uint32)x >= w->w1) ? (vx_int32)w->w1 - 1 : x);
+        y = (y < 0) ? 0 : (((vx_uint32)y >= w->h1) ? (vx_int32)w->h1 - 1 : y);
+    }
+    else if (((vx_uint32)x >= w->w1) || ((vx_uint32)y >= w->h1))
+    {
+        return (w->borders.mode == VX_BORDER_MODE_CONSTANT) ? (vx_uint8)w->borders.constant_value : 0;
+    }
+    return w->src[y * w->src_addr.stride_y + x * w->src_addr.stride_x];
+}
+
+/*! \brief Blends four pixels by two fractions. Each step multiplies by weights
+ * which add up to 1 << VX_WARP_BITS, so the sum fits in 28 bits.
+ */
+static vx_uint8 vxWarpBlend(vx_int32 p00, vx_int32 p01, vx_int32 p10, vx_int32 p11, vx_int32 fx, vx_int32 fy)
+{
+    const vx_int32 one = 1 << VX_WARP_BITS;
+    vx_int32 top = p00 * (one - fx) + p01 * fx;
+    vx_int32 bot = p10 * (one - fx) + p11 * fx;
+    return (vx_uint8)((top * (one - fy) + bot * fy + (1 << (2 * VX_WARP_BITS - 1))) >> (2 * VX_WARP_BITS));
+}
+
+/*! \brief Samples the input at a split coordinate. */
+static vx_uint8 vxWarpSample(const vx_warp_t *w, const vx_warp_axis_t *ax, const vx_warp_axis_t *ay)
+{
+    const vx_int32 sx = w->src_addr.stride_x, sy = w->src_addr.stride_y;
+    if (w->type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+    {
+        if (((vx_uint32)ax->p < w->w1) && ((vx_uint32)ay->p < w->h1))
+            return w->src[ay->p * sy + ax->p * sx];
+        return vxWarpPixel(w, ax->p, ay->p);
+    }
+    /* the four pixels are inside, away from the right and bottom edges */
+    if (((vx_uint32)ax->p < w->w1 - 1) && ((vx_uint32)ay->p < w->h1 - 1))
+    {
+        const vx_uint8 *p = &w->src[ay->p * sy + ax->p * sx];
+        return vxWarpBlend(p[0], p[sx], p[sy], p[sy + sx], ax->f, ay->f);
+    }
+    return vxWarpBlend(vxWarpPixel(w, ax->p, ay->p), vxWarpPixel(w, ax->p + 1, ay->p),
+                       vxWarpPixel(w, ax->p, ay->p + 1), vxWarpPixel(w, ax->p + 1, ay->p + 1),
+                       ax->f, ay->f);
+}
+
+/*! \brief Fills output pixels x0 to x1 of row y. */
+static void vxWarpRow(const vx_warp_t *w, vx_uint32 x0, vx_uint32 x1, vx_uint32 y)
+{
+    const vx_int32 dx = w->dst_addr.stride_x;
+    vx_uint8 *dst = w->dst + y * w->dst_addr.stride_y;
+    vx_warp_axis_t ax, ay;
+    vx_uint32 x;
+
+    if (w->separable == vx_true_e)
+    {
+        const vx_warp_axis_t *row = &w->rows[y];
+        for (x = x0; x < x1; x++)
+            dst[x * dx] = vxWarpSample(w, &w->cols[x], row);
+    }
+    else if (w->perspective == vx_false_e)
+    {
+        /* exact at the start of the row, then stepped */
+        vx_int64 cx = vxWarpFixed(w->m[0][0] * x0 + w->m[1][0] * y + w->m[2][0]);
+        vx_int64 cy = vxWarpFixed(w->m[0][1] * x0 + w->m[1][1] * y + w->m[2][1]);
+        vx_int64 sx = vxWarpFixed(w->m[0][0]);
+        vx_int64 sy = vxWarpFixed(w->m[0][1]);
+        for (x = x0; x < x1; x++, cx += sx, cy += sy)
         {
-            for (y = 0u; y < src_addr.dim_y; y++)
-            {
-                for (x = 0u; x < src_addr.dim_x; x++)
-                {
-                    vx_uint32 x0 = 0u, y0 = 0u;
-                    vx_float32 z0 = 0.0f;
-                    vx_uint8 *src = NULL, *dst = NULL;
-                    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
-                    {
-                        /* this truncates the floats to uint32's) */
-                        z0 = (m[0][2] * x) + (m[1][2] * y) + m[2][2];
-                        x0 = (vx_uint32)(x * m[0][0]) + (vx_uint32)(y * m[1][0]) + (vx_uint32)m[2][0];
-                        y0 = (vx_uint32)(x * m[0][1]) + (vx_uint32)(y * m[1][1]) + (vx_uint32)m[2][1];
-                        x0 = (vx_uint32)((vx_float32)x0 / z0);
-                        y0 = (vx_uint32)((vx_float32)y0 / z0);
-                    }
-                    else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
-                    {
-                        /*! \todo implement bilinear perspective warp */
-                    }
-                    else if (type == VX_INTERPOLATION_TYPE_AREA)
-                    {
-                        /*! \todo implement area perspective warp */
-                    }
-                    src = vxFormatImagePatchAddress2d(src_base, x0, y0, &src_addr);
-                    dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
-                    if ((src) && (dst))
-                    {
-                        *dst = *src;
-                    }
-                }
-            }
-            /*! \todo compute maximum area rectangle */
+            vxWarpSplit(w->type, cx, &ax);
+            vxWarpSplit(w->type, cy, &ay);
+            dst[x * dx] = vxWarpSample(w, &ax, &ay);
+        }
+    }
+    else
+    {
+        vx_float64 X = w->m[0][0] * x0 + w->m[1][0] * y + w->m[2][0];
+        vx_float64 Y = w->m[0][1] * x0 + w->m[1][1] * y + w->m[2][1];
+        vx_float64 Z = w->m[0][2] * x0 + w->m[1][2] * y + w->m[2][2];
+        for (x = x0; x < x1; x++, X += w->m[0][0], Y += w->m[0][1], Z += w->m[0][2])
+        {
+            vxWarpSplit(w->type, vxWarpFixed(X / Z), &ax);
+            vxWarpSplit(w->type, vxWarpFixed(Y / Z), &ay);
+            dst[x * dx] = vxWarpSample(w, &ax, &ay);
         }
-        vxCommitMatrix(matrix, m);
-        status |= vxCommitImagePatch(src_image, 0, 0, &src_addr, src_base);
-        status |= vxCommitImagePatch(dst_image, rect, 0, &dst_addr, dst_base);
-        vxReleaseRectangle(&rect);
-        status = VX_SUCCESS;
     }
-    return status;
 }
 
-static vx_status vxWarpAffineKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+static void vxWarpBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    const vx_warp_t *w = (const vx_warp_t *)arg;
+    vx_uint32 tx, ty, y;
+    (void)index;
+    for (ty = y0; ty < y1; ty += VX_WARP_TILE_H)
+    {
+        vx_uint32 ey = (ty + VX_WARP_TILE_H < y1) ? ty + VX_WARP_TILE_H : y1;
+        for (tx = 0; tx < w->w2; tx += VX_WARP_TILE_W)
+        {
+            vx_uint32 ex = (tx + VX_WARP_TILE_W < w->w2) ? tx + VX_WARP_TILE_W : w->w2;
+            for (y = ty; y < ey; y++)
+                vxWarpRow(w, tx, ex, y);
+        }
+    }
+}
+
+/*! \brief Reads a 2x3 or 3x3 matrix, and recognizes perspective matrices which
+ * are affine, and affine matrices which only translate and scale.
+ */
+static void vxWarpMatrix(vx_warp_t *w, const vx_float32 *mf, vx_size columns)
+{
+    vx_uint32 i, j;
+    for (j = 0; j < 3; j++)
+        for (i = 0; i < 3; i++)
+            w->m[j][i] = (i < columns) ? mf[j * columns + i] : ((j == 2) ? 1.0 : 0.0);
+    w->perspective = vx_false_e;
+    if ((w->m[0][2] != 0.0) || (w->m[1][2] != 0.0) || (w->m[2][2] == 0.0))
+    {
+        w->perspective = vx_true_e;
+    }
+    else if (w->m[2][2] != 1.0)
+    {
+        for (j = 0; j < 3; j++)
+            for (i = 0; i < 2; i++)
+                w->m[j][i] /= w->m[2][2];
+        w->m[2][2] = 1.0;
+    }
+    w->separable = ((w->perspective == vx_false_e) &&
+                    (w->m[1][0] == 0.0) && (w->m[0][1] == 0.0)) ? vx_true_e : vx_false_e;
+}
+
+static vx_status vxWarpKernel(vx_node node, vx_reference *parameters, vx_uint32 num, vx_size columns)
 {
     vx_status status = VX_FAILURE;
     if (num == 4)
@@ -111,68 +254,83 @@ static vx_status vxWarpAffineKernel(vx_node node, vx_reference *parameters, vx_u
         vx_matrix matrix = (vx_matrix)parameters[1];
         vx_scalar stype = (vx_scalar)parameters[2];
         vx_image dst_image = (vx_image)parameters[3];
-        vx_enum type = 0;
-        void *src_base = NULL;
-        void *dst_base = NULL;
-        vx_imagepatch_addressing_t src_addr, dst_addr;
-        vx_uint32 y = 0u, x = 0u, width = 0u, height = 0u;
-        vx_float32 m[3][2];
-        vx_rectangle rect = 0;
-
-        memset(m, 0, sizeof(m));
-        vxAccessScalarValue(stype, &type);
-        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
-        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
-        rect = vxCreateRectangle(vxGetContext(src_image), 0, 0, width, height);
-        vxAccessMatrix(matrix, m);
-        status = VX_SUCCESS;
-        status |= vxAccessImagePatch(src_image, rect, 0, &src_addr, &src_base);
-        status |= vxAccessImagePatch(dst_image, rect, 0, &dst_addr, &dst_base);
+        void *src_base = NULL, *dst_base = NULL;
+        vx_float32 mf[9];
+        vx_uint32 i;
+        vx_warp_t w;
+
+        memset(&w, 0, sizeof(w));
+        memset(mf, 0, sizeof(mf));
+        w.type = VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR;
+        w.borders.mode = VX_BORDER_MODE_UNDEFINED;
+        if (stype)
+            vxAccessScalarValue(stype, &w.type);
+        /* area has no meaning for a single point of the source, it is taken as bilinear */
+        if (w.type == VX_INTERPOLATION_TYPE_AREA)
+            w.type = VX_INTERPOLATION_TYPE_BILINEAR;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &w.borders, sizeof(w.borders));
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w.w1, sizeof(w.w1));
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &w.h1, sizeof(w.h1));
+        vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w.w2, sizeof(w.w2));
+        vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &w.h2, sizeof(w.h2));
+        status = vxAccessMatrix(matrix, mf);
         if (status == VX_SUCCESS)
         {
-            for (y = 0u; y < height; y++)
+            vxWarpMatrix(&w, mf, columns);
+            status = vxCommitMatrix(matrix, NULL);
+        }
+        if ((status == VX_SUCCESS) && (w.separable == vx_true_e))
+        {
+            w.cols = (vx_warp_axis_t *)calloc(w.w2 + w.h2, sizeof(vx_warp_axis_t));
+            if (w.cols)
             {
-                for (x = 0u; x < width; x++)
-                {
-                    vx_uint32 x0 = 0;
-                    vx_uint32 y0 = 0;
-                    vx_uint8 *src = NULL, *dst = NULL;
-                    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
-                    {
-                        /* this truncates the floats to uint32's */
-                        x0 = (vx_uint32)(x * m[0][0]) + (vx_uint32)(y * m[1][0]) + (vx_uint32)m[2][0];
-                        y0 = (vx_uint32)(x * m[0][1]) + (vx_uint32)(y * m[1][1]) + (vx_uint32)m[2][1];
-                    }
-                    else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
-                    {
-                        /*! \todo implement bilinear affine warp */
-                    }
-                    else if (type == VX_INTERPOLATION_TYPE_AREA)
-                    {
-                        /*! \todo implement area affine warp */
-                    }
-                    /* printf("x0 = %u y0 = %u, x = %u, y = %u\n", x0, y0, x, y);
-                    fflush(stdout); */
-                    src = vxFormatImagePatchAddress2d(src_base, x0, y0, &src_addr);
-                    dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
-                    if ((src) && (dst))
-                    {
-                        *dst = *src;
-                    }
-                }
+                w.rows = &w.cols[w.w2];
+                for (i = 0; i < w.w2; i++)
+                    vxWarpSplit(w.type, vxWarpFixed(w.m[0][0] * i + w.m[2][0]), &w.cols[i]);
+                for (i = 0; i < w.h2; i++)
+                    vxWarpSplit(w.type, vxWarpFixed(w.m[1][1] * i + w.m[2][1]), &w.rows[i]);
+            }
+            else
+            {
+                /* the general path gives the same results */
+                w.separable = vx_false_e;
             }
         }
-        vxCommitMatrix(matrix, m);
-        status |= vxCommitImagePatch(src_image, 0, 0, &src_addr, src_base);
-        status |= vxCommitImagePatch(dst_image, rect, 0, &dst_addr, dst_base);
-        vxReleaseRectangle(&rect);
-        status = VX_SUCCESS;
+        if (status == VX_SUCCESS)
+        {
+            vx_rectangle src_rect = vxCreateRectangle(vxGetContext(src_image), 0, 0, w.w1, w.h1);
+            vx_rectangle dst_rect = vxCreateRectangle(vxGetContext(dst_image), 0, 0, w.w2, w.h2);
+            vx_uint32 count = vxBandCount(node, w.w2, w.h2);
+
+            status |= vxAccessImagePatch(src_image, src_rect, 0, &w.src_addr, &src_base);
+            status |= vxAccessImagePatch(dst_image, dst_rect, 0, &w.dst_addr, &dst_base);
+            if (status == VX_SUCCESS)
+            {
+                w.src = (vx_uint8 *)src_base;
+                w.dst = (vx_uint8 *)dst_base;
+                vxRunBands(node, (count < w.h2) ? count : w.h2, w.h2, vxWarpBand, &w);
+            }
+            status |= vxCommitImagePatch(src_image, 0, 0, &w.src_addr, src_base);
+            status |= vxCommitImagePatch(dst_image, dst_rect, 0, &w.dst_addr, dst_base);
+            vxReleaseRectangle(&src_rect);
+            vxReleaseRectangle(&dst_rect);
+        }
+        free(w.cols);
     }
     return status;
 }
 
+static vx_status vxWarpPerspectiveKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxWarpKernel(node, parameters, num, 3);
+}
+
+static vx_status vxWarpAffineKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxWarpKernel(node, parameters, num, 2);
+}
 
-static vx_status vxWarpInputValidator(vx_node node, vx_uint32 index)
+static vx_status vxWarpInputValidator(vx_node node, vx_uint32 index, vx_size matrix_columns)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
     if (index == 0)
@@ -195,18 +353,21 @@ static vx_status vxWarpInputValidator(vx_node node, vx_uint32 index)
     else if (index == 1)
     {
         vx_parameter param = vxGetParameterByIndex(node, index);
-        vx_matrix matrix;
+        vx_matrix matrix = 0;
         vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &matrix, sizeof(matrix));
         if (matrix)
         {
+            vx_enum type = 0;
             vx_size rows = 0ul, columns = 0ul;
+            vxQueryMatrix(matrix, VX_MATRIX_ATTRIBUTE_TYPE, &type, sizeof(type));
             vxQueryMatrix(matrix, VX_MATRIX_ATTRIBUTE_ROWS, &rows, sizeof(rows));
             vxQueryMatrix(matrix, VX_MATRIX_ATTRIBUTE_COLUMNS, &columns, sizeof(columns));
-            if (((columns == 2) || (columns == 3)) && (rows == 3))
+            if ((type == VX_TYPE_FLOAT32) && (columns == matrix_columns) && (rows == 3))
             {
                 status = VX_SUCCESS;
             }
         }
+        vxReleaseParameter(&param);
     }
     else if (index == 2)
     {
@@ -245,6 +406,16 @@ static vx_status vxWarpInputValidator(vx_node node, vx_uint32 index)
     return status;
 }
 
+static vx_status vxWarpAffineInputValidator(vx_node node, vx_uint32 index)
+{
+    return vxWarpInputValidator(node, index, 2);
+}
+
+static vx_status vxWarpPerspectiveInputValidator(vx_node node, vx_uint32 index)
+{
+    return vxWarpInputValidator(node, index, 3);
+}
+
 static vx_status vxWarpOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
@@ -260,26 +431,35 @@ static vx_status vxWarpOutputValidator(vx_node node, vx_uint32 index, vx_meta_fo
             vxQueryParameter(dst_param, VX_PARAMETER_ATTRIBUTE_REF, &dst, sizeof(dst));
             if ((src) && (dst))
             {
-                vx_uint32 w1 = 0, h1 = 0;
+                vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
                 vx_fourcc f1 = FOURCC_VIRT;
 
                 vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
                 vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
                 vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &f1, sizeof(f1));
-                /* output can not be virtual */
+                vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
+                vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+                /* the output may have its own size, a virtual one takes that of the input */
+                if ((w2 == 0) || (h2 == 0))
+                {
+                    w2 = w1;
+                    h2 = h1;
+                }
                 if ((w1 != 0) && (h1 != 0) && (f1 == FOURCC_U8))
                 {
                     /* fill in the meta data with the attributes so that the checker will pass */
                     ptr->type = VX_TYPE_IMAGE;
                     ptr->dim.image.format = FOURCC_U8;
-                    ptr->dim.image.width = w1;
-                    ptr->dim.image.height = h1;
+                    ptr->dim.image.width = w2;
+                    ptr->dim.image.height = h2;
                     status = VX_SUCCESS;
                 }
             }
+        }
+        if (src_param)
             vxReleaseParameter(&src_param);
+        if (dst_param)
             vxReleaseParameter(&dst_param);
-        }
     }
     return status;
 }
@@ -296,7 +476,7 @@ vx_kernel_description_t warp_affine_kernel = {
     "org.khronos.openvx.warp_affine",
     vxWarpAffineKernel,
     warp_kernel_params, dimof(warp_kernel_params),
-    vxWarpInputValidator,
+    vxWarpAffineInputValidator,
     vxWarpOutputValidator,
     NULL,
     NULL,
@@ -307,9 +487,8 @@ vx_kernel_description_t warp_perspective_kernel = {
     "org.khronos.openvx.warp_perspective",
     vxWarpPerspectiveKernel,
     warp_kernel_params, dimof(warp_kernel_params),
-    vxWarpInputValidator,
+    vxWarpPerspectiveInputValidator,
     vxWarpOutputValidator,
     NULL,
     NULL,
 };
-
@@ -683,6 +683,7 @@ vx_action vxTargetProcess(vx_target_t *target, vx_node_t *nodes[], vx_size start
         nodes[n]->executed = vx_true_e;
         nodes[n]->status = status;
         vxStopCapture(&nodes[n]->perf);
+        VX_TRACE_INTERVAL("node", nodes[n]->kernel->name, nodes[n], -1, nodes[n]->perf.beg, nodes[n]->perf.end);
 
         VX_PRINT(VX_ZONE_GRAPH,"kernel %s returned %d\n", nodes[n]->kernel->name, status);
 
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Absolute Difference Kernel of the SIMD target.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+static vx_status vxAbsDiffKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 3)
+    {
+        status = vxArithmeticKernel(node, (vx_image)parameters[0], (vx_image)parameters[1],
+                                    (vx_image)parameters[2], 0.0f, 0);
+    }
+    return status;
+}
+
+static vx_status vxAbsDiffInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 3)
+    {
+        vx_fourcc format = 0;
+        vx_arith_row_f row;
+        vxQueryImage((vx_image)parameters[0], VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+        row = (format == FOURCC_U8) ? vx_rows->pointwise->absdiff_u8 : vx_rows->pointwise->absdiff_u16;
+        status = vxSetNodeRows(node, row, row);
+    }
+    return status;
+}
+
+static vx_status vxAbsDiffInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0 )
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8 || format == FOURCC_S16 || format == FOURCC_U16)
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 1)
+    {
+        vx_image images[2];
+        vx_parameter param[2] = {
+            vxGetParameterByIndex(node, 0),
+            vxGetParameterByIndex(node, 1),
+        };
+        vxQueryParameter(param[0], VX_PARAMETER_ATTRIBUTE_REF, &images[0], sizeof(images[0]));
+        vxQueryParameter(param[1], VX_PARAMETER_ATTRIBUTE_REF, &images[1], sizeof(images[1]));
+        if (images[0] && images[1])
+        {
+            vx_uint32 width[2], height[2];
+            vx_fourcc format[2];
+
+            vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_WIDTH, &width[0], sizeof(width[0]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_WIDTH, &width[1], sizeof(width[1]));
+            vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[0], sizeof(height[0]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[1], sizeof(height[1]));
+            vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_FORMAT, &format[0], sizeof(format[0]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_FORMAT, &format[1], sizeof(format[1]));
+            if (width[0] == width[1] && height[0] == height[1] && format[0] == format[1])
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param[0]);
+        vxReleaseParameter(&param[1]);
+    }
+    return status;
+}
+
+static vx_status vxAbsDiffOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 2)
+    {
+        vx_parameter param[2] = {
+            vxGetParameterByIndex(node, 0),
+            vxGetParameterByIndex(node, 1),
+        };
+        if (param[0] && param[1])
+        {
+            vx_image images[2];
+            vxQueryParameter(param[0], VX_PARAMETER_ATTRIBUTE_REF, &images[0], sizeof(images[0]));
+            vxQueryParameter(param[1], VX_PARAMETER_ATTRIBUTE_REF, &images[1], sizeof(images[1]));
+            if (images[0] && images[1])
+            {
+                vx_uint32 width[2], height[2];
+                vx_fourcc format = 0;
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_WIDTH, &width[0], sizeof(width[0]));
+                vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_WIDTH, &width[1], sizeof(width[1]));
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[0], sizeof(height[0]));
+                vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[1], sizeof(height[1]));
+                if (width[0] == width[1] && height[0] == height[1] &&
+                    (format == FOURCC_U8 || format == FOURCC_U16))
+                {
+                    ptr->type = VX_TYPE_IMAGE;
+                    ptr->dim.image.format = format;
+                    ptr->dim.image.width = width[0];
+                    ptr->dim.image.height = height[1];
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&param[0]);
+            vxReleaseParameter(&param[1]);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t absdiff_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t absdiff_kernel = {
+    VX_KERNEL_ABSDIFF,
+    "org.khronos.openvx.absdiff",
+    vxAbsDiffKernel,
+    absdiff_kernel_params, dimof(absdiff_kernel_params),
+    vxAbsDiffInputValidator,
+    vxAbsDiffOutputValidator,
+    vxAbsDiffInitializer,
+    NULL,
+};
+
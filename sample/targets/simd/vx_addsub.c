@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Add and Subtract Kernels of the SIMD target. The row functions
+ * for the formats and the policies are picked when the node is initialized.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+static vx_status vxAddSubtractInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8 || format == FOURCC_S16)
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 1)
+    {
+        vx_image images[2];
+        vx_parameter param[2] = {
+            vxGetParameterByIndex(node, 0),
+            vxGetParameterByIndex(node, 1),
+        };
+        vxQueryParameter(param[0], VX_PARAMETER_ATTRIBUTE_REF, &images[0], sizeof(images[0]));
+        vxQueryParameter(param[1], VX_PARAMETER_ATTRIBUTE_REF, &images[1], sizeof(images[1]));
+        if (images[0] && images[1])
+        {
+            vx_uint32 width[2], height[2];
+            vx_fourcc format1;
+
+            vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_WIDTH, &width[0], sizeof(width[0]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_WIDTH, &width[1], sizeof(width[1]));
+            vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[0], sizeof(height[0]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[1], sizeof(height[1]));
+            vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_FORMAT, &format1, sizeof(format1));
+            if (width[0] == width[1] && height[0] == height[1] &&
+                (format1 == FOURCC_U8 || format1 == FOURCC_S16))
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param[0]);
+        vxReleaseParameter(&param[1]);
+    }
+    else if (index == 2)        /* overflow_policy: truncate or saturate. */
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar scalar = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &scalar, sizeof(scalar));
+            if (scalar)
+            {
+                vx_enum stype = 0;
+                vxQueryScalar(scalar, VX_SCALAR_ATTRIBUTE_TYPE, &stype, sizeof(stype));
+                if (stype == VX_TYPE_ENUM)
+                {
+                    vx_enum overflow_policy = 0;
+                    vxAccessScalarValue(scalar, &overflow_policy);
+                    if ((overflow_policy == VX_CONVERT_POLICY_TRUNCATE) ||
+                        (overflow_policy == VX_CONVERT_POLICY_SATURATE))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                    else
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_TYPE;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_status vxAddSubtractOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 3)
+    {
+        /*
+         * We need to look at both input images, but only for the format:
+         * if either is S16 or the output type is not U8, then it's S16.
+         * The geometry of the output image is copied from the first parameter:
+         * the input images are known to match from input parameters validation.
+         */
+        vx_parameter param[] = {
+            vxGetParameterByIndex(node, 0),
+            vxGetParameterByIndex(node, 1),
+            vxGetParameterByIndex(node, index),
+        };
+        if ((param[0]) && (param[1]) && (param[2]))
+        {
+            vx_image images[3];
+            vxQueryParameter(param[0], VX_PARAMETER_ATTRIBUTE_REF, &images[0], sizeof(images[0]));
+            vxQueryParameter(param[1], VX_PARAMETER_ATTRIBUTE_REF, &images[1], sizeof(images[1]));
+            vxQueryParameter(param[2], VX_PARAMETER_ATTRIBUTE_REF, &images[2], sizeof(images[2]));
+            if (images[0] && images[1] && images[2])
+            {
+                vx_uint32 width = 0, height = 0;
+                vx_fourcc informat[2] = {FOURCC_VIRT, FOURCC_VIRT};
+                vx_fourcc outformat = FOURCC_VIRT;
+
+                /*
+                 * When passing on the geometry to the output image, we only look at
+                 * image 0, as both input images are verified to match, at input
+                 * validation.
+                 */
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+                vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_FORMAT, &informat[0], sizeof(informat[0]));
+                vxQueryImage(images[1], VX_IMAGE_ATTRIBUTE_FORMAT, &informat[1], sizeof(informat[1]));
+                vxQueryImage(images[2], VX_IMAGE_ATTRIBUTE_FORMAT, &outformat, sizeof(outformat));
+
+                if (informat[0] == FOURCC_U8 && informat[1] == FOURCC_U8)
+                {
+                    if ((outformat == FOURCC_U8) ||
+                        (outformat == FOURCC_S16))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                }
+                else
+                {
+                    outformat = FOURCC_S16;
+                    status = VX_SUCCESS;
+                }
+                ptr->type = VX_TYPE_IMAGE;
+                ptr->dim.image.format = outformat;
+                ptr->dim.image.width = width;
+                ptr->dim.image.height = height;
+            }
+            vxReleaseParameter(&param[0]);
+            vxReleaseParameter(&param[1]);
+        }
+    }
+
+    return status;
+}
+
+vx_status vxBinaryRows(vx_image in0, vx_image in1, vx_image output, vx_float32 scale, vx_arith_row_f row)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 y;
+    void *dst_base   = NULL;
+    void *src_base[2] = {NULL, NULL};
+    vx_imagepatch_addressing_t dst_addr, src_addr[2];
+    vx_rectangle rect = vxGetValidRegionImage(in0);
+
+    status |= vxAccessImageRows(in0, rect, &src_addr[0], &src_base[0]);
+    status |= vxAccessImageRows(in1, rect, &src_addr[1], &src_base[1]);
+    status |= vxAccessImageRows(output, rect, &dst_addr, &dst_base);
+    for (y = 0; (y < src_addr[0].dim_y) && (status == VX_SUCCESS); y++)
+    {
+        row((vx_uint8 *)dst_base + (y * dst_addr.stride_y),
+            (vx_uint8 *)src_base[0] + (y * src_addr[0].stride_y),
+            (vx_uint8 *)src_base[1] + (y * src_addr[1].stride_y),
+            scale, src_addr[0].dim_x);
+    }
+    status |= vxCommitImagePatch(in0, 0, 0, &src_addr[0], src_base[0]);
+    status |= vxCommitImagePatch(in1, 0, 0, &src_addr[1], src_base[1]);
+    status |= vxCommitImagePatch(output, rect, 0, &dst_addr, dst_base);
+    vxReleaseRectangle(&rect);
+    return status;
+}
+
+vx_status vxSetNodeRows(vx_node node, vx_arith_row_f truncate, vx_arith_row_f saturate)
+{
+    vx_status status = VX_SUCCESS;
+    vx_arith_row_f *local = NULL;
+
+    /* the rows survive a second verification, when the node may no longer be altered */
+    vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+    if (local == NULL)
+    {
+        vx_size size = 2 * sizeof(vx_arith_row_f);
+        local = (vx_arith_row_f *)calloc(1, size);
+        if (local)
+        {
+            status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+            status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        }
+        else
+        {
+            status = VX_ERROR_NO_MEMORY;
+        }
+    }
+    if (status == VX_SUCCESS)
+    {
+        local[0] = truncate;
+        local[1] = saturate;
+    }
+    return status;
+}
+
+vx_status vxArithmeticInitializer(vx_node node, vx_image in0, vx_image in1, vx_image output,
+                                  const vx_arith_row_f rows[VX_ARITH_FORMATS][2])
+{
+    vx_fourcc format[3] = {0, 0, 0};
+    vx_enum formats = VX_ARITH_FORMATS;
+
+    vxQueryImage(in0, VX_IMAGE_ATTRIBUTE_FORMAT, &format[0], sizeof(format[0]));
+    vxQueryImage(in1, VX_IMAGE_ATTRIBUTE_FORMAT, &format[1], sizeof(format[1]));
+    vxQueryImage(output, VX_IMAGE_ATTRIBUTE_FORMAT, &format[2], sizeof(format[2]));
+    if (format[0] == FOURCC_U8 && format[1] == FOURCC_U8)
+        formats = (format[2] == FOURCC_U8) ? VX_ARITH_U8_U8_U8 : VX_ARITH_U8_U8_S16;
+    else if (format[0] == FOURCC_U8)
+        formats = VX_ARITH_U8_S16_S16;
+    else if (format[1] == FOURCC_U8)
+        formats = VX_ARITH_S16_U8_S16;
+    else
+        formats = VX_ARITH_S16_S16_S16;
+    VX_PRINT(VX_ZONE_INFO, "Using %s rows for formats %d\n", vx_rows->isa, formats);
+    return vxSetNodeRows(node, rows[formats][0], rows[formats][1]);
+}
+
+vx_arith_row_f vxArithmeticRow(vx_node node, vx_scalar policy_param)
+{
+    vx_arith_row_f *rows = NULL;
+    vx_enum overflow_policy = VX_CONVERT_POLICY_TRUNCATE;
+
+    vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &rows, sizeof(rows));
+    /* the policy is a scalar whose value may change between executions */
+    if (policy_param)
+        vxAccessScalarValue(policy_param, &overflow_policy);
+    if (rows == NULL)
+        return NULL;
+    return rows[(overflow_policy == VX_CONVERT_POLICY_SATURATE) ? 1 : 0];
+}
+
+vx_status vxArithmeticKernel(vx_node node, vx_image in0, vx_image in1, vx_image output,
+                             vx_float32 scale, vx_scalar policy_param)
+{
+    vx_status status = VX_ERROR_INVALID_NODE;
+    vx_arith_row_f row = vxArithmeticRow(node, policy_param);
+    if (row)
+        status = vxBinaryRows(in0, in1, output, scale, row);
+    return status;
+}
+
+static vx_param_description_t add_subtract_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+/* There's already a "vxAddKernel"; we have to use a slightly different name. */
+static vx_status vxAdditionKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 4)
+    {
+        status = vxArithmeticKernel(node, (vx_image)parameters[0], (vx_image)parameters[1],
+                                    (vx_image)parameters[3], 0.0f, (vx_scalar)parameters[2]);
+    }
+    return status;
+}
+
+static vx_status vxAdditionInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 4)
+    {
+        status = vxArithmeticInitializer(node, (vx_image)parameters[0], (vx_image)parameters[1],
+                                         (vx_image)parameters[3], vx_rows->pointwise->add);
+    }
+    return status;
+}
+
+vx_kernel_description_t add_kernel = {
+    VX_KERNEL_ADD,
+    "org.khronos.openvx.add",
+    vxAdditionKernel,
+    add_subtract_kernel_params, dimof(add_subtract_kernel_params),
+    vxAddSubtractInputValidator,
+    vxAddSubtractOutputValidator,
+    vxAdditionInitializer,
+    NULL,
+};
+
+static vx_status vxSubtractionKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 4)
+    {
+        status = vxArithmeticKernel(node, (vx_image)parameters[0], (vx_image)parameters[1],
+                                    (vx_image)parameters[3], 0.0f, (vx_scalar)parameters[2]);
+    }
+    return status;
+}
+
+static vx_status vxSubtractionInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 4)
+    {
+        status = vxArithmeticInitializer(node, (vx_image)parameters[0], (vx_image)parameters[1],
+                                         (vx_image)parameters[3], vx_rows->pointwise->subtract);
+    }
+    return status;
+}
+
+vx_kernel_description_t subtract_kernel = {
+    VX_KERNEL_SUBTRACT,
+    "org.khronos.openvx.subtract",
+    vxSubtractionKernel,
+    add_subtract_kernel_params, dimof(add_subtract_kernel_params),
+    vxAddSubtractInputValidator,
+    vxAddSubtractOutputValidator,
+    vxSubtractionInitializer,
+    NULL,
+};
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Custom Convolution Kernel of the SIMD target.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief How a node runs its convolution, decided when the graph is verified. */
+typedef struct _vx_convolution_plan_t {
+    /*! \brief The coefficients the plan was made for. */
+    vx_int16 mat[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+    vx_size columns;
+    vx_size rows;
+    /*! \brief Whether mat is the outer product of column and row, so that it
+     * may run as a pass over the rows into 16 bit sums and a pass down the columns.
+     */
+    vx_bool separable;
+    vx_int16 row[VX_CONVOLUTION_MAX_DIM];
+    vx_int16 column[VX_CONVOLUTION_MAX_DIM];
+} vx_convolution_plan_t;
+
+static vx_int32 vxGreatestCommonDivisor(vx_int32 a, vx_int32 b)
+{
+    while (b != 0)
+    {
+        vx_int32 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*! \brief Makes the plan for a matrix, factoring it into integer vectors when it
+ * has rank 1 and the sums of the first pass fit 16 bits.
+ */
+static void vxPlanConvolution(vx_convolution_plan_t *plan, const vx_int16 *mat, vx_size columns, vx_size rows, vx_fourcc format)
+{
+    vx_uint32 i, j, k = 0, first = 0;
+    vx_int32 g = 0, sum = 0;
+
+    memcpy(plan->mat, mat, columns * rows * sizeof(vx_int16));
+    plan->columns = columns;
+    plan->rows = rows;
+    plan->separable = vx_false_e;
+    /* the sums of S16 pixels do not fit 16 bits */
+    if (format != FOURCC_U8)
+        return;
+    /* the row is the first nonzero row divided by the divisor of its coefficients */
+    while ((first < columns * rows) && (mat[first] == 0))
+        first++;
+    if (first == columns * rows)
+        return;
+    j = first / (vx_uint32)columns;
+    for (i = 0; i < columns; i++)
+        g = vxGreatestCommonDivisor(g, abs(mat[j * columns + i]));
+    if (mat[first] < 0)
+        g = -g;
+    for (i = 0; i < columns; i++)
+    {
+        plan->row[i] = (vx_int16)(mat[j * columns + i] / g);
+        sum += abs(plan->row[i]);
+    }
+    /* every row must be a whole multiple of it */
+    k = first % (vx_uint32)columns;
+    for (j = 0; j < rows; j++)
+    {
+        plan->column[j] = (vx_int16)(mat[j * columns + k] / plan->row[k]);
+        for (i = 0; i < columns; i++)
+        {
+            if (plan->column[j] * plan->row[i] != mat[j * columns + i])
+                return;
+        }
+    }
+    plan->separable = (sum * UINT8_MAX <= INT16_MAX) ? vx_true_e : vx_false_e;
+}
+
+/*! \brief Lists the nonzero coefficients of a matrix of columns x rows with the
+ * offset of the pixel each one multiplies, in units of pitch per row.
+ * \return The number of taps.
+ */
+static vx_uint32 vxConvolutionTaps(const vx_int16 *mat, vx_size columns, vx_size rows, vx_int32 pitch, vx_int32 size,
+                                   vx_int16 *coeffs, vx_int32 *offsets)
+{
+    vx_uint32 i, j, count = 0;
+    for (j = 0; j < rows; j++)
+    {
+        for (i = 0; i < columns; i++)
+        {
+            if (mat[j * columns + i] != 0)
+            {
+                coeffs[count] = mat[j * columns + i];
+                offsets[count] = (vx_int32)j * pitch + (vx_int32)i * size;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static vx_status vxConvolveInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 3)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_convolution conv = (vx_convolution)parameters[1];
+        vx_convolution_plan_t *plan = NULL;
+        vx_int16 mat[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+        vx_size dims[2] = {0, 0};
+        vx_fourcc format = 0;
+
+        status = VX_SUCCESS;
+        /* the plan survives a second verification, when the node may no longer be altered */
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &plan, sizeof(plan));
+        if (plan == NULL)
+        {
+            vx_size size = sizeof(vx_convolution_plan_t);
+            plan = (vx_convolution_plan_t *)calloc(1, size);
+            if (plan)
+            {
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &plan, sizeof(plan));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+        status |= vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_COLUMNS, &dims[0], sizeof(dims[0]));
+        status |= vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_ROWS, &dims[1], sizeof(dims[1]));
+        if (status == VX_SUCCESS)
+        {
+            status |= vxAccessConvolutionCoefficients(conv, mat);
+            vxPlanConvolution(plan, mat, dims[0], dims[1], format);
+            status |= vxCommitConvolutionCoefficients(conv, NULL);
+            VX_PRINT(VX_ZONE_INFO, "Convolution of "VX_FMT_SIZE"x"VX_FMT_SIZE" is %s\n", dims[0], dims[1],
+                     plan->separable == vx_true_e ? "separable" : "not separable");
+        }
+    }
+    return status;
+}
+
+static vx_status vxConvolveKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 3)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_convolution conv = (vx_convolution)parameters[1];
+        vx_image dst = (vx_image)parameters[2];
+        vx_convolution_plan_t *plan = NULL;
+        vx_uint32 y, k, count, shift = 0;
+        void *src_base = NULL;
+        void *dst_base = NULL;
+        vx_imagepatch_addressing_t src_addr, dst_addr;
+        vx_rectangle rect;
+        vx_size dims[2] = {0,0};
+        vx_size dims2[2] = {0,0};
+        vx_int16 mat[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+        vx_int16 coeffs[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+        vx_int32 offsets[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+        const void *taps[VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM];
+        vx_uint32 div = 1;
+        vx_fourcc format = 0;
+        vx_fourcc format2 = 0;
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+        vx_convolve_row_f row;
+
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &plan, sizeof(plan));
+        if (plan == NULL)
+            return VX_ERROR_INVALID_NODE;
+        status  = VX_SUCCESS;
+        status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+        status |= vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &format2, sizeof(format2));
+        status |= vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_COLUMNS, &dims[0], sizeof(dims[0]));
+        status |= vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_ROWS, &dims[1], sizeof(dims[1]));
+        status |= vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_SCALE, &div, sizeof(div));
+        dims2[0] = (vx_uint32)dims[0] / 2;
+        dims2[1] = (vx_uint32)dims[1] / 2;
+        /* the scale is a power of two */
+        while ((1u << shift) < div)
+            shift++;
+        status |= vxAccessConvolutionCoefficients(conv, mat);
+        /* the coefficients may have been changed since the graph was verified */
+        if ((plan->columns != dims[0]) || (plan->rows != dims[1]) ||
+            (memcmp(plan->mat, mat, dims[0] * dims[1] * sizeof(vx_int16)) != 0))
+        {
+            VX_PRINT(VX_ZONE_INFO, "Convolution coefficients have changed, planning again\n");
+            vxPlanConvolution(plan, mat, dims[0], dims[1], format);
+        }
+        row = vx_rows->convolve[format == FOURCC_S16][format2 == FOURCC_S16];
+        rect = vxGetValidRegionImage(src);
+        status |= vxAccessImageRows(src, rect, &src_addr, &src_base);
+        status |= vxAccessImageRows(dst, rect, &dst_addr, &dst_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        /*! \todo Implement other border modes */
+        if (borders.mode == VX_BORDER_MODE_UNDEFINED)
+        {
+            vx_int32 pitch = src_addr.stride_y;
+            vx_uint32 width = src_addr.dim_x - 2 * (vx_uint32)dims2[0];
+
+            /* shrink the image by 1 */
+            vxAlterRectangle(rect, dims2[0], dims2[1], -dims2[0], -dims2[1]);
+
+            if ((src_addr.dim_x < dims[0]) || (src_addr.dim_y < dims[1]) || (status != VX_SUCCESS))
+            {
+                /* nothing to compute */
+            }
+            else if (plan->separable == vx_true_e)
+            {
+                /* keep the first pass of the last rows of the matrix in a ring */
+                vx_int16 *ring = (vx_int16 *)malloc(dims[1] * width * sizeof(vx_int16));
+                vx_int16 column[VX_CONVOLUTION_MAX_DIM];
+                vx_uint32 columns = vxConvolutionTaps(plan->row, dims[0], 1, 0, sizeof(vx_uint8), coeffs, offsets);
+                vx_uint32 input = 0;
+
+                if (ring == NULL)
+                    status = VX_ERROR_NO_MEMORY;
+                for (y = (vx_uint32)dims2[1]; (y < (src_addr.dim_y - (vx_uint32)dims2[1])) && (status == VX_SUCCESS); y++)
+                {
+                    /* the pass over the rows, once for each input row */
+                    for (; input <= y + (vx_uint32)dims2[1]; input++)
+                    {
+                        const vx_uint8 *s = (const vx_uint8 *)src_base + input * src_addr.stride_y;
+                        for (k = 0; k < columns; k++)
+                            taps[k] = s + offsets[k];
+                        vx_rows->convolve[0][1](&ring[(input % dims[1]) * width], taps, coeffs, columns, 0, width);
+                    }
+                    /* the pass down the columns, skipping the zeros */
+                    for (k = 0, count = 0; k < dims[1]; k++)
+                    {
+                        if (plan->column[k] != 0)
+                        {
+                            column[count] = plan->column[k];
+                            taps[count++] = &ring[((y - dims2[1] + k) % dims[1]) * width];
+                        }
+                    }
+                    vx_rows->convolve[1][format2 == FOURCC_S16](
+                        (vx_uint8 *)dst_base + y * dst_addr.stride_y + dims2[0] * dst_addr.stride_x,
+                        taps, column, count, shift, width);
+                }
+                free(ring);
+            }
+            else
+            {
+                count = vxConvolutionTaps(plan->mat, dims[0], dims[1], pitch, src_addr.stride_x, coeffs, offsets);
+                for (y = (vx_uint32)dims2[1]; (y < (src_addr.dim_y - (vx_uint32)dims2[1])) && (status == VX_SUCCESS); y++)
+                {
+                    const vx_uint8 *s = (const vx_uint8 *)src_base + (y - dims2[1]) * src_addr.stride_y;
+                    for (k = 0; k < count; k++)
+                        taps[k] = s + offsets[k];
+                    row((vx_uint8 *)dst_base + y * dst_addr.stride_y + dims2[0] * dst_addr.stride_x,
+                        taps, coeffs, count, shift, width);
+                }
+            }
+        }
+        else
+        {
+            status = VX_ERROR_NOT_IMPLEMENTED;
+        }
+        status |= vxCommitConvolutionCoefficients(conv, NULL);
+        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+static vx_status vxConvolveInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vx_uint32 width = 0, height = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if ((width > VX_CONVOLUTION_MAX_DIM) &&
+                (height > VX_CONVOLUTION_MAX_DIM) &&
+                ((format == FOURCC_U8) ||
+                 (format == FOURCC_S16)))
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    if (index == 1)
+    {
+        vx_convolution conv = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &conv, sizeof(conv));
+        if (conv)
+        {
+            vx_fourcc dims[2] = {0,0};
+            vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_COLUMNS, &dims[0], sizeof(dims[0]));
+            vxQueryConvolution(conv, VX_CONVOLUTION_ATTRIBUTE_ROWS, &dims[1], sizeof(dims[1]));
+            if ((dims[0] <= VX_CONVOLUTION_MAX_DIM) &&
+                (dims[1] <= VX_CONVOLUTION_MAX_DIM))
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+static vx_status vxConvolveOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 2)
+    {
+        vx_parameter params[2] = {
+            vxGetParameterByIndex(node, 0),
+            vxGetParameterByIndex(node, index),
+        };
+        if (params[0] && params[1])
+        {
+            vx_image input = 0;
+            vx_image output = 0;
+            vxQueryParameter(params[0], VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+            vxQueryParameter(params[1], VX_PARAMETER_ATTRIBUTE_REF, &output, sizeof(output));
+            if (input && output)
+            {
+                vx_uint32 width = 0, height = 0;
+                vx_fourcc format = 0;
+                vx_fourcc format2 = 0;
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+
+                vxQueryImage(output, VX_IMAGE_ATTRIBUTE_FORMAT, &format2, sizeof(format2));
+                if (format == FOURCC_U8 || format == FOURCC_S16)
+                {
+                    ptr->type = VX_TYPE_IMAGE;
+                    if (format == FOURCC_U8 && format2 == FOURCC_U8)
+                        ptr->dim.image.format = FOURCC_U8;
+                    else
+                        ptr->dim.image.format = FOURCC_S16; /* virtual images, too */
+                    ptr->dim.image.width = width;
+                    ptr->dim.image.height = height;
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&params[0]);
+            vxReleaseParameter(&params[1]);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t convolution_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_CONVOLUTION, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t convolution_kernel = {
+    VX_KERNEL_CUSTOM_CONVOLUTION,
+    "org.khronos.openvx.custom_convolution",
+    vxConvolveKernel,
+    convolution_kernel_params, dimof(convolution_kernel_params),
+    vxConvolveInputValidator,
+    vxConvolveOutputValidator,
+    vxConvolveInitializer,
+    NULL,
+};
+
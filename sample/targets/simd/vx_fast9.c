@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The FAST-9 Corners Kernel of the SIMD target.
+ * \details Each band of rows scores its pixels a row at a time, rejecting most
+ * of them with a vector test of the four compass points of the circle, and
+ * keeps a ring of three rows of scores for the non-maximum suppression. The
+ * corners go into flat arrays of keypoints in the local data of the node, which
+ * are joined in order and copied into the output list at the end.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief The radius of the circle around each pixel. */
+#define VX_FAST9_RADIUS (3)
+
+/*! \brief The corners reserved for each band, on top of one per 32 pixels of the image. */
+#define VX_FAST9_POINTS (1024)
+
+/* offsets from the pixel, clockwise from the top */
+static const vx_int32 vx_fast9_circle[16][2] = {
+    { 0, -3}, { 1, -3}, { 2, -2}, { 3, -1}, { 3,  0}, { 3,  1}, { 2,  2}, { 1,  3},
+    { 0,  3}, {-1,  3}, {-2,  2}, {-3,  1}, {-3,  0}, {-3, -1}, {-2, -2}, {-1, -3},
+};
+
+/*! \brief The corners of one band, in the local data until they overflow it. */
+typedef struct _vx_fast9_points_t {
+    vx_keypoint_t *points;
+    vx_size count;
+    vx_size capacity;
+    /*! \brief Whether the points have moved to the heap. */
+    vx_bool heap;
+} vx_fast9_points_t;
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_fast9_t {
+    vx_uint8 *base;
+    vx_imagepatch_addressing_t addr;
+    vx_int32 circle[16];
+    vx_uint8 threshold;
+    vx_bool nonmax;
+    /*! \brief The three rows of scores of each band. */
+    vx_uint8 *scores;
+    vx_fast9_points_t bands[VX_MAX_BANDS];
+    vx_status status[VX_MAX_BANDS];
+} vx_fast9_t;
+
+/*! \brief The layout of the local data: the corners of all the bands, then their rows of scores. */
+static vx_size vxFast9PointsPerBand(vx_uint32 width, vx_uint32 height, vx_uint32 count)
+{
+    return (((vx_size)width * height) / 32) / count + VX_FAST9_POINTS;
+}
+
+static vx_size vxFast9LocalSize(vx_uint32 width, vx_uint32 height, vx_uint32 count)
+{
+    return count * (vxFast9PointsPerBand(width, height, count) * sizeof(vx_keypoint_t) + 3 * (vx_size)width);
+}
+
+static vx_bool vxFast9AddPoint(vx_fast9_points_t *out, vx_int32 x, vx_int32 y, vx_uint8 score)
+{
+    vx_keypoint_t *kp;
+    if (out->count == out->capacity)
+    {
+        vx_size capacity = 2 * out->capacity;
+        vx_keypoint_t *points = (vx_keypoint_t *)(out->heap ? realloc(out->points, capacity * sizeof(vx_keypoint_t))
+                                                            : malloc(capacity * sizeof(vx_keypoint_t)));
+        if (points == NULL)
+            return vx_false_e;
+        if (out->heap == vx_false_e)
+            memcpy(points, out->points, out->count * sizeof(vx_keypoint_t));
+        out->points = points;
+        out->capacity = capacity;
+        out->heap = vx_true_e;
+    }
+    kp = &out->points[out->count++];
+    memset(kp, 0, sizeof(*kp));
+    kp->x = x;
+    kp->y = y;
+    kp->strength = (vx_float32)score;
+    kp->tracking_status = 1;
+    return vx_true_e;
+}
+
+/*! \brief Scores row y, or zeroes it when it is too close to the top or the bottom. */
+static void vxFast9ScoreRow(vx_fast9_t *f, vx_uint8 *scores, vx_uint32 y)
+{
+    if ((y >= VX_FAST9_RADIUS) && (y + VX_FAST9_RADIUS < f->addr.dim_y))
+        vx_rows->fast9(scores, f->base + y * f->addr.stride_y, f->circle, f->threshold, f->addr.dim_x);
+    else
+        memset(scores, 0, f->addr.dim_x);
+}
+
+static void vxFast9Band(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_fast9_t *f = (vx_fast9_t *)arg;
+    const vx_uint32 w = f->addr.dim_x, h = f->addr.dim_y;
+    vx_uint8 *ring = f->scores + index * 3 * (vx_size)w;
+    vx_fast9_points_t *out = &f->bands[index];
+    vx_uint32 ya = (y0 > VX_FAST9_RADIUS) ? y0 : VX_FAST9_RADIUS;
+    vx_uint32 yb = (y1 + VX_FAST9_RADIUS < h) ? y1 : h - VX_FAST9_RADIUS;
+    vx_uint32 x, y;
+
+    f->status[index] = VX_SUCCESS;
+    if (ya >= yb)
+        return;
+    vxFast9ScoreRow(f, &ring[((ya - 1) % 3) * w], ya - 1);
+    vxFast9ScoreRow(f, &ring[(ya % 3) * w], ya);
+    for (y = ya; y < yb; y++)
+    {
+        const vx_uint8 *s0 = &ring[((y - 1) % 3) * w];
+        const vx_uint8 *s1 = &ring[(y % 3) * w];
+        const vx_uint8 *s2 = &ring[((y + 1) % 3) * w];
+
+        vxFast9ScoreRow(f, (vx_uint8 *)s2, y + 1);
+        for (x = VX_FAST9_RADIUS; x + VX_FAST9_RADIUS < w; x++)
+        {
+            vx_uint8 s = s1[x];
+            if (s == 0)
+                continue;
+            /* ties keep the corner which comes first */
+            if (f->nonmax &&
+                ((s <= s0[x - 1]) || (s <= s0[x]) || (s <= s0[x + 1]) || (s <= s1[x - 1]) ||
+                 (s < s1[x + 1]) || (s < s2[x - 1]) || (s < s2[x]) || (s < s2[x + 1])))
+                continue;
+            if (vxFast9AddPoint(out, (vx_int32)x, (vx_int32)y, s) == vx_false_e)
+            {
+                f->status[index] = VX_ERROR_NO_MEMORY;
+                return;
+            }
+        }
+    }
+}
+
+static vx_status vxFast9CornersKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 4)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_scalar sens = (vx_scalar)parameters[1];
+        vx_scalar nonm = (vx_scalar)parameters[2];
+        vx_list corners = (vx_list)parameters[3];
+        vx_rectangle rect = vxGetValidRegionImage(src);
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+        vx_float32 b = 0.0f;
+        vx_size local_size = 0, size, per_band;
+        void *base = NULL, *local = NULL, *memory = NULL;
+        vx_uint32 count = 0, i;
+        vx_fast9_t f;
+
+        memset(&f, 0, sizeof(f));
+        status = VX_SUCCESS;
+        status |= vxAccessScalarValue(sens, &b);
+        status |= vxAccessScalarValue(nonm, &f.nonmax);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &local_size, sizeof(local_size));
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        status |= vxAccessImageRows(src, rect, &f.addr, &base);
+        f.base = (vx_uint8 *)base;
+        f.threshold = (vx_uint8)(b * UINT8_MAX);
+        for (i = 0; i < dimof(vx_fast9_circle); i++)
+            f.circle[i] = vx_fast9_circle[i][1] * f.addr.stride_y + vx_fast9_circle[i][0];
+        if ((status == VX_SUCCESS) && (borders.mode != VX_BORDER_MODE_UNDEFINED))
+            status = VX_ERROR_NOT_IMPLEMENTED;
+        if (status == VX_SUCCESS)
+        {
+            count = vxBandCount(node, f.addr.dim_x, f.addr.dim_y);
+            per_band = vxFast9PointsPerBand(f.addr.dim_x, f.addr.dim_y, count);
+            size = vxFast9LocalSize(f.addr.dim_x, f.addr.dim_y, count);
+            if ((local == NULL) || (local_size < size))
+                local = memory = malloc(size);
+            if (local)
+            {
+                vx_keypoint_t *points = (vx_keypoint_t *)local, *joined = points;
+                vx_bool overflow = vx_false_e;
+                vx_size total = 0;
+
+                for (i = 0; i < count; i++)
+                {
+                    f.bands[i].points = &points[i * per_band];
+                    f.bands[i].capacity = per_band;
+                }
+                f.scores = (vx_uint8 *)&points[count * per_band];
+                vxRunBands(node, count, f.addr.dim_y, vxFast9Band, &f);
+                for (i = 0; i < count; i++)
+                {
+                    status |= f.status[i];
+                    overflow |= f.bands[i].heap;
+                    total += f.bands[i].count;
+                }
+                /* join the bands behind the first, on the heap if any has left the local data */
+                if ((status == VX_SUCCESS) && overflow)
+                {
+                    joined = (vx_keypoint_t *)malloc(total * sizeof(vx_keypoint_t));
+                    if (joined == NULL)
+                        status = VX_ERROR_NO_MEMORY;
+                }
+                if (status == VX_SUCCESS)
+                {
+                    vx_size at = 0;
+                    for (i = 0; i < count; i++)
+                    {
+                        memmove(&joined[at], f.bands[i].points, f.bands[i].count * sizeof(vx_keypoint_t));
+                        at += f.bands[i].count;
+                    }
+                    status = vxSetListKeypoints(corners, joined, total);
+                }
+                if (joined != points)
+                    free(joined);
+                for (i = 0; i < count; i++)
+                {
+                    if (f.bands[i].heap)
+                        free(f.bands[i].points);
+                }
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+        free(memory);
+        status |= vxCommitImagePatch(src, 0, 0, &f.addr, base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+/*! \brief Reserves the corners and the rows of scores of the bands once, as the local data of the node. */
+static vx_status vxFast9CornersInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (num == 4)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_uint32 width = 0, height = 0;
+        void *local = NULL;
+
+        status = VX_SUCCESS;
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+        /* a second verification may not alter the node, the kernel allocates
+         * for itself if the image has grown since */
+        if (local == NULL)
+        {
+            vx_size size;
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            size = vxFast9LocalSize(width, height, vxBandCount(node, width, height));
+            local = malloc(size);
+            if (local)
+            {
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+                status |= vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &local, sizeof(local));
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+        }
+    }
+    return status;
+}
+
+static vx_status vxFast9InputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_image input = 0;
+            status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+            if ((status == VX_SUCCESS) && (input))
+            {
+                vx_fourcc format = 0;
+                status = vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+                if ((status == VX_SUCCESS) && (format == FOURCC_U8))
+                {
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    if (index == 1)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar sens = 0;
+            status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &sens, sizeof(sens));
+            if ((status == VX_SUCCESS) && (sens))
+            {
+                vx_enum type = VX_TYPE_INVALID;
+                vxQueryScalar(sens, VX_SCALAR_ATTRIBUTE_TYPE, &type, sizeof(type));
+                if (type == VX_TYPE_FLOAT32)
+                {
+                    vx_float32 k = 0.0f;
+                    status = vxAccessScalarValue(sens, &k);
+                    if ((status == VX_SUCCESS) && (k >= 0.003) && (k <= 0.5))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                    else
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_TYPE;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    if (index == 2)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar sens = 0;
+            status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &sens, sizeof(sens));
+            if ((status == VX_SUCCESS) && (sens))
+            {
+                vx_enum type = VX_TYPE_INVALID;
+                vxQueryScalar(sens, VX_SCALAR_ATTRIBUTE_TYPE, &type, sizeof(type));
+                if (type == VX_TYPE_BOOL)
+                {
+                    vx_bool nonmax;
+                    status = vxAccessScalarValue(sens, &nonmax);
+                    if ((status == VX_SUCCESS) && ((nonmax == vx_false_e) ||
+                                                   (nonmax == vx_true_e)))
+                    {
+                        status = VX_SUCCESS;
+                    }
+                    else
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_TYPE;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_status vxFast9OutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 3)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index); /* we reference the input image */
+        if (param)
+        {
+            vx_list list = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &list, sizeof(list));
+            if (list)
+            {
+                vx_enum type = 0;
+                status = vxQueryList(list, VX_LIST_ATTRIBUTE_TYPE, &type, sizeof(type));
+                if ((status == VX_SUCCESS) && (type == VX_TYPE_KEYPOINT))
+                {
+                    ptr->type = VX_TYPE_LIST;
+                    ptr->dim.list.type = type;
+                    /*! \note there's no hard reason for this number,
+                     * just an estimate
+                     */
+                    ptr->dim.list.initial = 2000;
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t fast9_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_LIST, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t fast9_kernel = {
+    VX_KERNEL_FAST_CORNERS,
+    "org.khronos.openvx.fast_corners",
+    vxFast9CornersKernel,
+    fast9_kernel_params, dimof(fast9_kernel_params),
+    vxFast9InputValidator,
+    vxFast9OutputValidator,
+    vxFast9CornersInitializer,
+    NULL,
+};
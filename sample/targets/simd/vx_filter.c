@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Filter Kernels of the SIMD target.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+vx_status vxFilter3x3(vx_node node, vx_reference *parameters, vx_uint32 num, vx_filter_row_f row)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 2)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[1];
+        vx_uint32 y;
+        void *src_base = NULL;
+        void *dst_base = NULL;
+        vx_imagepatch_addressing_t src_addr, dst_addr;
+        vx_rectangle rect;
+        vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
+        vx_uint16 *tmp = NULL;
+
+        status = VX_SUCCESS;
+        rect = vxGetValidRegionImage(src);
+        status |= vxAccessImagePatch(src, rect, 0, &src_addr, &src_base);
+        status |= vxAccessImagePatch(dst, rect, 0, &dst_addr, &dst_base);
+        status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
+        /*! \todo Implement other border modes */
+        if (borders.mode == VX_BORDER_MODE_UNDEFINED)
+        {
+            /* shrink the image by 1 */
+            vxAlterRectangle(rect, 1, 1, -1, -1);
+
+            /* the row functions need packed rows */
+            if ((src_addr.stride_x != 1) || (dst_addr.stride_x != 1))
+            {
+                status = VX_ERROR_NOT_SUPPORTED;
+            }
+            else if ((src_addr.dim_x >= 3) && (src_addr.dim_y >= 3))
+            {
+                tmp = (vx_uint16 *)malloc(src_addr.dim_x * sizeof(vx_uint16));
+                if (tmp == NULL)
+                    status = VX_ERROR_NO_MEMORY;
+            }
+            for (y = 1; (y < (src_addr.dim_y - 1)) && (tmp != NULL) && (status == VX_SUCCESS); y++)
+            {
+                vx_uint8 *s = (vx_uint8 *)src_base + (y * src_addr.stride_y);
+                vx_uint8 *d = (vx_uint8 *)dst_base + (y * dst_addr.stride_y);
+                row(d, s - src_addr.stride_y, s, s + src_addr.stride_y, src_addr.dim_x, tmp);
+            }
+            free(tmp);
+        }
+        else
+        {
+            status = VX_ERROR_NOT_IMPLEMENTED;
+        }
+        status |= vxCommitImagePatch(src, 0, 0, &src_addr, src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+static vx_status vxBox3x3Kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxFilter3x3(node, parameters, num, vx_rows->box);
+}
+
+static vx_status vxGaussian3x3Kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxFilter3x3(node, parameters, num, vx_rows->gaussian);
+}
+
+static vx_status vxMedian3x3Kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxFilter3x3(node, parameters, num, vx_rows->median);
+}
+
+vx_status vxFilter3x3InputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8)
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+vx_status vxFilter3x3OutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 1)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, 0); /* we reference the input image */
+        if (param)
+        {
+            vx_image input = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+            if (input)
+            {
+                vx_uint32 width = 0, height = 0;
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+                ptr->type = VX_TYPE_IMAGE;
+                ptr->dim.image.format = FOURCC_U8;
+                ptr->dim.image.width = width;
+                ptr->dim.image.height = height;
+                status = VX_SUCCESS;
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t filter_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t box3x3_kernel = {
+    VX_KERNEL_BOX_3x3,
+    "org.khronos.openvx.box3x3",
+    vxBox3x3Kernel,
+    filter_kernel_params, dimof(filter_kernel_params),
+    vxFilter3x3InputValidator,
+    vxFilter3x3OutputValidator,
+};
+
+vx_kernel_description_t median3x3_kernel = {
+    VX_KERNEL_MEDIAN_3x3,
+    "org.khronos.openvx.median3x3",
+    vxMedian3x3Kernel,
+    filter_kernel_params, dimof(filter_kernel_params),
+    vxFilter3x3InputValidator,
+    vxFilter3x3OutputValidator,
+};
+
+vx_kernel_description_t gaussian3x3_kernel = {
+    VX_KERNEL_GAUSSIAN_3x3,
+    "org.khronos.openvx.gaussian3x3",
+    vxGaussian3x3Kernel,
+    filter_kernel_params, dimof(filter_kernel_params),
+    vxFilter3x3InputValidator,
+    vxFilter3x3OutputValidator,
+};
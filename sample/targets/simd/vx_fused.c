@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The fused execution of groups of per-pixel kernels of the SIMD target.
+ * \details Each row is passed through every kernel of the group before the
+ * next row is started, so the images between the kernels of the group only
+ * ever exist as a single row. Convert Depth runs on the C model target, so a
+ * chain through it is fused on either side of it.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief The image parameters of a per-pixel kernel, -1 when unused. */
+typedef struct _vx_fused_layout_t {
+    vx_enum kernel;
+    vx_int32 src[2];
+    vx_int32 dst;
+} vx_fused_layout_t;
+
+static const vx_fused_layout_t layouts[] = {
+    {VX_KERNEL_ADD,                 {0,  1}, 3},
+    {VX_KERNEL_SUBTRACT,            {0,  1}, 3},
+    {VX_KERNEL_MULTIPLY,            {0,  1}, 4},
+    {VX_KERNEL_ABSDIFF,             {0,  1}, 2},
+    {VX_KERNEL_AND,                 {0,  1}, 2},
+    {VX_KERNEL_OR,                  {0,  1}, 2},
+    {VX_KERNEL_XOR,                 {0,  1}, 2},
+    {VX_KERNEL_NOT,                 {0, -1}, 1},
+    {VX_KERNEL_THRESHOLD,           {0, -1}, 2},
+    {VX_KERNEL_TABLE_LOOKUP,        {0, -1}, 2},
+    {VX_KERNEL_ACCUMULATE,          {0, -1}, 1},
+    {VX_KERNEL_ACCUMULATE_WEIGHTED, {0, -1}, 2},
+    {VX_KERNEL_ACCUMULATE_SQUARE,   {0, -1}, 1},
+};
+
+/*! \brief An image used by the group, either accessed as packed rows or a row buffer. */
+typedef struct _vx_fused_operand_t {
+    vx_image image;
+    vx_bool internal;
+    vx_bool written;
+    vx_imagepatch_addressing_t addr;
+    void *base;
+    vx_uint8 *row;
+} vx_fused_operand_t;
+
+/*! \brief A kernel of the group with its operands and the row function of the
+ * kernel, with the arguments it takes from the non-image parameters.
+ */
+typedef struct _vx_fused_stage_t {
+    vx_enum kernel;
+    vx_uint32 numSrc;
+    vx_uint32 src[2];
+    vx_uint32 dst;
+    vx_arith_row_f arith;
+    vx_accumulate_row_f accumulate;
+    vx_float32 scale;
+    vx_uint8 lower;
+    vx_uint8 upper;
+    vx_lut lut;
+    void *table;
+    vx_size count;
+} vx_fused_stage_t;
+
+static const vx_fused_layout_t *vxFusedLayout(vx_enum kernel)
+{
+    vx_uint32 i;
+    for (i = 0; i < dimof(layouts); i++)
+    {
+        if (layouts[i].kernel == kernel)
+            return &layouts[i];
+    }
+    return NULL;
+}
+
+/*! \brief Computes one row of a stage with the row function of its kernel. */
+static void vxFusedStageRow(vx_fused_stage_t *stage, vx_fused_operand_t ops[], vx_uint32 width)
+{
+    vx_uint8 *a = ops[stage->src[0]].row;
+    vx_uint8 *b = ops[stage->src[stage->numSrc - 1]].row;
+    vx_uint8 *d = ops[stage->dst].row;
+
+    switch (stage->kernel)
+    {
+        case VX_KERNEL_NOT:
+            vx_rows->pointwise->not_u8(d, a, width);
+            break;
+        case VX_KERNEL_THRESHOLD:
+            vx_rows->pointwise->threshold(d, a, stage->lower, stage->upper, width);
+            break;
+        case VX_KERNEL_TABLE_LOOKUP:
+            vxTableLookupRowU8(d, a, stage->table, stage->count, width);
+            break;
+        case VX_KERNEL_ACCUMULATE:
+        case VX_KERNEL_ACCUMULATE_WEIGHTED:
+        case VX_KERNEL_ACCUMULATE_SQUARE:
+            stage->accumulate((vx_uint16 *)d, a, stage->scale, width);
+            break;
+        default:
+            stage->arith(d, a, b, stage->scale, width);
+            break;
+    }
+}
+
+/*! \brief Finds or adds the operand for an image. */
+static vx_uint32 vxFusedOperand(vx_fused_operand_t ops[], vx_uint32 *numOps, vx_image image)
+{
+    vx_uint32 o;
+    for (o = 0; o < *numOps; o++)
+    {
+        if (ops[o].image == image)
+            return o;
+    }
+    memset(&ops[o], 0, sizeof(ops[o]));
+    ops[o].image = image;
+    (*numOps)++;
+    return o;
+}
+
+vx_status vxFusedSupported(vx_node_t *nodes[], vx_size num)
+{
+    vx_status status = VX_SUCCESS;
+    vx_image_t *first = NULL;
+    vx_size n;
+    vx_uint32 i;
+
+    for (n = 0; (n < num) && (status == VX_SUCCESS); n++)
+    {
+        const vx_fused_layout_t *layout = vxFusedLayout(nodes[n]->kernel->enumeration);
+        vx_int32 index[3];
+        /* the accumulators are read back, so they can only be the last of the group */
+        if ((layout == NULL) ||
+            (((layout->kernel == VX_KERNEL_ACCUMULATE) ||
+              (layout->kernel == VX_KERNEL_ACCUMULATE_WEIGHTED) ||
+              (layout->kernel == VX_KERNEL_ACCUMULATE_SQUARE)) && (n < num - 1)))
+        {
+            status = VX_ERROR_NOT_SUPPORTED;
+            break;
+        }
+        index[0] = layout->src[0];
+        index[1] = layout->src[1];
+        index[2] = layout->dst;
+        for (i = 0; i < dimof(index); i++)
+        {
+            vx_image_t *image = NULL;
+            if (index[i] < 0)
+                continue;
+            image = (vx_image_t *)nodes[n]->parameters[index[i]];
+            if (first == NULL)
+                first = image;
+            if ((image == NULL) ||
+                ((image->format != FOURCC_U8) && (image->format != FOURCC_S16)) ||
+                (image->width != first->width) ||
+                (image->height != first->height))
+            {
+                status = VX_ERROR_NOT_SUPPORTED;
+                break;
+            }
+        }
+        if ((status == VX_SUCCESS) &&
+            (nodes[n]->kernel->enumeration == VX_KERNEL_TABLE_LOOKUP))
+        {
+            vx_enum type = VX_TYPE_INVALID;
+            vxQueryLUT((vx_lut)nodes[n]->parameters[1], VX_LUT_ATTRIBUTE_TYPE, &type, sizeof(type));
+            if ((type != VX_TYPE_UINT8) ||
+                (((vx_image_t *)nodes[n]->parameters[0])->format != FOURCC_U8))
+            {
+                status = VX_ERROR_NOT_SUPPORTED;
+            }
+        }
+    }
+    return status;
+}
+
+vx_status vxFusedKernel(vx_node_t *nodes[], vx_size num)
+{
+    vx_status status = VX_SUCCESS;
+    vx_fused_operand_t ops[VX_INT_MAX_FUSED * 3];
+    vx_fused_stage_t stages[VX_INT_MAX_FUSED];
+    vx_uint32 numOps = 0, o, s, y, width = 0, height = 0;
+    vx_uint8 *rows = NULL;
+    vx_rectangle rect = 0;
+    vx_size n;
+
+    if ((num == 0) || (num > VX_INT_MAX_FUSED))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    /* wire the stages to their operands, the outputs of all but the last node stay internal */
+    memset(stages, 0, sizeof(stages));
+    for (n = 0; n < num; n++)
+    {
+        vx_node_t *node = nodes[n];
+        vx_reference_t **params = node->parameters;
+        const vx_fused_layout_t *layout = vxFusedLayout(node->kernel->enumeration);
+        vx_fused_stage_t *stage = &stages[n];
+
+        stage->kernel = layout->kernel;
+        for (s = 0; s < 2; s++)
+        {
+            if (layout->src[s] >= 0)
+                stage->src[stage->numSrc++] = vxFusedOperand(ops, &numOps, (vx_image)params[layout->src[s]]);
+        }
+        stage->dst = vxFusedOperand(ops, &numOps, (vx_image)params[layout->dst]);
+        ops[stage->dst].written = vx_true_e;
+        ops[stage->dst].internal = (n < num - 1) ? vx_true_e : vx_false_e;
+
+        switch (stage->kernel)
+        {
+            case VX_KERNEL_ADD:
+            case VX_KERNEL_SUBTRACT:
+                stage->arith = vxArithmeticRow((vx_node)node, (vx_scalar)params[2]);
+                break;
+            case VX_KERNEL_MULTIPLY:
+                status |= vxAccessScalarValue((vx_scalar)params[2], &stage->scale);
+                stage->arith = vxArithmeticRow((vx_node)node, (vx_scalar)params[3]);
+                break;
+            case VX_KERNEL_ABSDIFF:
+                stage->arith = vxArithmeticRow((vx_node)node, 0);
+                break;
+            case VX_KERNEL_AND:
+                stage->arith = vx_rows->pointwise->and_u8;
+                break;
+            case VX_KERNEL_OR:
+                stage->arith = vx_rows->pointwise->or_u8;
+                break;
+            case VX_KERNEL_XOR:
+                stage->arith = vx_rows->pointwise->xor_u8;
+                break;
+            case VX_KERNEL_THRESHOLD:
+                vxThresholdRange((vx_threshold)params[1], &stage->lower, &stage->upper);
+                break;
+            case VX_KERNEL_TABLE_LOOKUP:
+                stage->lut = (vx_lut)params[1];
+                vxQueryLUT(stage->lut, VX_LUT_ATTRIBUTE_COUNT, &stage->count, sizeof(stage->count));
+                status |= vxAccessLUT(stage->lut, &stage->table);
+                break;
+            case VX_KERNEL_ACCUMULATE:
+                stage->accumulate = vx_rows->pointwise->accumulate;
+                break;
+            case VX_KERNEL_ACCUMULATE_WEIGHTED:
+                status |= vxAccessScalarValue((vx_scalar)params[1], &stage->scale);
+                stage->accumulate = vx_rows->pointwise->accumulate_weighted;
+                break;
+            case VX_KERNEL_ACCUMULATE_SQUARE:
+                stage->accumulate = vx_rows->pointwise->accumulate_square;
+                break;
+            default:
+                break;
+        }
+        /* the arithmetic rows are picked by the initializer of the node */
+        if ((stage->numSrc == 2) && (stage->arith == NULL))
+            status = VX_ERROR_INVALID_NODE;
+    }
+
+    /* the group covers the valid region of its first input */
+    rect = vxGetValidRegionImage(ops[stages[0].src[0]].image);
+    for (o = 0; o < numOps; o++)
+    {
+        if (ops[o].internal == vx_false_e)
+        {
+            status |= vxAccessImageRows(ops[o].image, rect, &ops[o].addr, &ops[o].base);
+            if (width == 0)
+            {
+                width = ops[o].addr.dim_x;
+                height = ops[o].addr.dim_y;
+            }
+        }
+    }
+    rows = malloc(numOps * width * sizeof(vx_int16));
+    if (rows == NULL)
+        status = VX_ERROR_NO_MEMORY;
+    for (o = 0; (o < numOps) && (status == VX_SUCCESS); o++)
+    {
+        if (ops[o].internal == vx_true_e)
+        {
+            ops[o].row = &rows[o * width * sizeof(vx_int16)];
+        }
+    }
+
+    for (y = 0; (y < height) && (status == VX_SUCCESS); y++)
+    {
+        for (o = 0; o < numOps; o++)
+        {
+            if (ops[o].internal == vx_false_e)
+                ops[o].row = vxFormatImagePatchAddress2d(ops[o].base, 0, y, &ops[o].addr);
+        }
+        for (n = 0; n < num; n++)
+        {
+            vxFusedStageRow(&stages[n], ops, width);
+        }
+    }
+
+    for (o = 0; o < numOps; o++)
+    {
+        if ((ops[o].internal == vx_false_e) && (ops[o].base != NULL))
+        {
+            status |= vxCommitImagePatch(ops[o].image, (ops[o].written ? rect : 0), 0, &ops[o].addr, ops[o].base);
+        }
+    }
+    for (n = 0; n < num; n++)
+    {
+        if (stages[n].table)
+            status |= vxCommitLUT(stages[n].lut, stages[n].table);
+    }
+    free(rows);
+    vxReleaseRectangle(&rect);
+    return status;
+}
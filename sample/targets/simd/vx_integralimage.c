@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Integral Image Kernel of the SIMD target.
+ * \details The image is split into bands of rows. A first parallel pass sums
+ * the columns of each band, which gives every band the integral of the row
+ * above it. A second parallel pass then scans each band row by row, so the
+ * U32 output is written only once.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_integral_t {
+    vx_uint8 *src;
+    vx_uint8 *dst;
+    vx_imagepatch_addressing_t src_addr;
+    vx_imagepatch_addressing_t dst_addr;
+    /*! \brief For each band, the sums of its columns and then the integral of the row above it. */
+    vx_uint32 *above;
+    /*! \brief The number of bands. */
+    vx_uint32 count;
+} vx_integral_t;
+
+static void vxColumnSumsBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_integral_t *it = (vx_integral_t *)arg;
+    vx_uint32 width = it->src_addr.dim_x;
+    vx_uint32 *sums = &it->above[index * width];
+    vx_uint32 x, y;
+    /* nothing is below the last band */
+    if (index + 1 == it->count)
+        return;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *src = it->src + (y * it->src_addr.stride_y);
+        for (x = 0; x < width; x++)
+            sums[x] += src[x];
+    }
+}
+
+static void vxIntegralBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_integral_t *it = (vx_integral_t *)arg;
+    const vx_uint32 *prev = &it->above[index * it->src_addr.dim_x];
+    vx_uint32 y;
+    for (y = y0; y < y1; y++)
+    {
+        vx_uint32 *dst = (vx_uint32 *)(it->dst + (y * it->dst_addr.stride_y));
+        vx_rows->integral(dst, prev, it->src + (y * it->src_addr.stride_y), it->src_addr.dim_x);
+        prev = dst;
+    }
+}
+
+static vx_status vxIntegralImageKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 2)
+    {
+        vx_image src = (vx_image)parameters[0];
+        vx_image dst = (vx_image)parameters[1];
+        vx_rectangle rect = vxGetValidRegionImage(src);
+        void *src_base = NULL, *dst_base = NULL;
+        vx_integral_t it;
+
+        status = VX_SUCCESS;
+        status |= vxAccessImageRows(src, rect, &it.src_addr, &src_base);
+        status |= vxAccessImageRows(dst, rect, &it.dst_addr, &dst_base);
+        it.src = (vx_uint8 *)src_base;
+        it.dst = (vx_uint8 *)dst_base;
+        it.above = NULL;
+        if (status == VX_SUCCESS)
+        {
+            vx_uint32 width = it.src_addr.dim_x;
+            vx_uint32 b, x, count = vxBandCount(node, width, it.src_addr.dim_y);
+
+            it.count = count;
+            it.above = (vx_uint32 *)calloc(count * width, sizeof(vx_uint32));
+            if (it.above)
+            {
+                if (count > 1)
+                {
+                    vx_uint32 run;
+                    vxRunBands(node, count, it.src_addr.dim_y, vxColumnSumsBand, &it);
+                    /* the sums above each band are those of the bands before it,
+                     * and their prefix along the row is the integral of its top */
+                    for (x = 0; x < width; x++)
+                    {
+                        vx_uint32 col = 0;
+                        for (b = 0; b < count; b++)
+                        {
+                            vx_uint32 band = it.above[b * width + x];
+                            it.above[b * width + x] = col;
+                            col += band;
+                        }
+                    }
+                    for (b = 1; b < count; b++)
+                    {
+                        vx_uint32 *row = &it.above[b * width];
+                        for (x = 0, run = 0; x < width; x++)
+                        {
+                            run += row[x];
+                            row[x] = run;
+                        }
+                    }
+                }
+                vxRunBands(node, count, it.src_addr.dim_y, vxIntegralBand, &it);
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+            free(it.above);
+        }
+        status |= vxCommitImagePatch(src, 0, 0, &it.src_addr, src_base);
+        status |= vxCommitImagePatch(dst, rect, 0, &it.dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+static vx_status vxIntegralInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8)
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+static vx_status vxIntegralOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 1)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, 0); /* we reference the input image */
+        if (param)
+        {
+            vx_image input = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+            if (input)
+            {
+                vx_uint32 width = 0, height = 0;
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+                vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+                ptr->type = VX_TYPE_IMAGE;
+                ptr->dim.image.format = FOURCC_U32;
+                ptr->dim.image.width = width;
+                ptr->dim.image.height = height;
+                status = VX_SUCCESS;
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t integral_image_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t integral_image_kernel = {
+    VX_KERNEL_INTEGRAL_IMAGE,
+    "org.khronos.openvx.integral_image",
+    vxIntegralImageKernel,
+    integral_image_kernel_params, dimof(integral_image_kernel_params),
+    vxIntegralInputValidator,
+    vxIntegralOutputValidator,
+    NULL,
+    NULL,
+};
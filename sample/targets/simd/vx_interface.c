@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The SIMD Target Interface
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+#if defined(VX_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static const vx_char name[VX_MAX_TARGET_NAME] = "khronos.simd";
+
+const vx_rows_t *vx_rows = &vx_rows_c;
+
+/*! \brief Declares the kernels of this target, which take precedence over the
+ * C model kernels with the same enumerations.
+ */
+static vx_kernel_description_t *target_kernels[] = {
+    &box3x3_kernel,
+    &gaussian3x3_kernel,
+    &median3x3_kernel,
+    &erode3x3_kernel,
+    &dilate3x3_kernel,
+    &add_kernel,
+    &subtract_kernel,
+    &multiply_kernel,
+    &absdiff_kernel,
+    &and_kernel,
+    &or_kernel,
+    &xor_kernel,
+    &not_kernel,
+    &lut_kernel,
+    &threshold_kernel,
+    &accumulate_kernel,
+    &accumulate_weighted_kernel,
+    &accumulate_square_kernel,
+    &magnitude_kernel,
+    &phase_kernel,
+    &convolution_kernel,
+    &mean_stddev_kernel,
+    &integral_image_kernel,
+    &fast9_kernel,
+    &scale_image_kernel,
+};
+
+/*! \brief Declares the number of kernels of this target. */
+static vx_uint32 num_target_kernels = dimof(target_kernels);
+
+/*! \brief The row function tables which may be used on this processor, best first. */
+static const vx_rows_t *vxSupportedRows(const vx_rows_t *rows[])
+{
+    vx_uint32 n = 0;
+#if defined(VX_SIMD_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    /* AVX2 also needs the OS to save the YMM registers */
+    if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6))
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+            rows[n++] = &vx_rows_avx2;
+    }
+    rows[n++] = &vx_rows_sse2;
+#elif defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        rows[n++] = &vx_rows_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        rows[n++] = &vx_rows_sse2;
+#endif
+#elif defined(VX_SIMD_NEON)
+    rows[n++] = &vx_rows_neon;
+#endif
+    rows[n++] = &vx_rows_c;
+    return rows[0];
+}
+
+/*! \brief Picks the best row functions for the processor. The VX_SIMD_ISA
+ * environment variable may name a lesser supported instruction set instead.
+ */
+static const vx_rows_t *vxPickRows(void)
+{
+    const vx_rows_t *rows[4] = {NULL};
+    const vx_rows_t *best = vxSupportedRows(rows);
+    char *str = getenv("VX_SIMD_ISA");
+    vx_uint32 r;
+    for (r = 0; str && (r < dimof(rows)) && rows[r]; r++)
+    {
+        if (strcmp(str, rows[r]->isa) == 0)
+            return rows[r];
+    }
+    return best;
+}
+
+vx_status vxAccessImageRows(vx_image image, vx_rectangle rect, vx_imagepatch_addressing_t *addr, void **base)
+{
+    vx_fourcc format = 0;
+    vx_int32 size = 0;
+    vx_status status = vxAccessImagePatch(image, rect, 0, addr, base);
+    vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+    if (format == FOURCC_U8)
+        size = sizeof(vx_uint8);
+    else if ((format == FOURCC_U16) || (format == FOURCC_S16))
+        size = sizeof(vx_uint16);
+    else if ((format == FOURCC_U32) || (format == FOURCC_S32))
+        size = sizeof(vx_uint32);
+    if ((status == VX_SUCCESS) && (addr->stride_x != size))
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Image "VX_FMT_REF" does not have packed rows\n", image);
+        status = VX_ERROR_NOT_SUPPORTED;
+    }
+    return status;
+}
+
+/******************************************************************************/
+/* EXPORTED FUNCTIONS */
+/******************************************************************************/
+
+vx_status vxTargetInit(vx_target_t *target)
+{
+    if (target)
+    {
+        strncpy(target->name, name, VX_MAX_TARGET_NAME);
+        target->priority = VX_TARGET_PRIORITY_SIMD;
+    }
+    vx_rows = vxPickRows();
+    VX_PRINT(VX_ZONE_TARGET, "Using %s row functions\n", vx_rows->isa);
+    return vxInitializeTarget(target, target_kernels, num_target_kernels);
+}
+
+vx_status vxTargetDeinit(vx_target_t *target)
+{
+    vx_uint32 k;
+    for (k = 0u; k < target->numKernels; k++)
+    {
+        vx_kernel_t *kern = &target->kernels[k];
+        vxReleaseKernel((vx_kernel *)&kern);
+    }
+    target->numKernels = 0;
+    return VX_SUCCESS;
+}
+
+vx_status vxTargetSupports(vx_target_t *target,
+                           vx_char targetName[VX_MAX_TARGET_NAME],
+                           vx_char kernelName[VX_MAX_KERNEL_NAME])
+{
+    vx_status status = VX_FAILURE;
+    if (strncmp(targetName, name, VX_MAX_TARGET_NAME) == 0)
+    {
+        vx_uint32 k = 0u;
+        for (k = 0u; k < target->numKernels; k++)
+        {
+            if (strncmp(kernelName, target->kernels[k].name, VX_MAX_KERNEL_NAME) == 0)
+            {
+                status = VX_SUCCESS;
+                break;
+            }
+        }
+    }
+    return status;
+}
+
+vx_action vxTargetProcess(vx_target_t *target, vx_node_t *nodes[], vx_size startIndex, vx_size numNodes)
+{
+    vx_action action = VX_ACTION_CONTINUE;
+    vx_status status = VX_SUCCESS;
+    vx_size n = 0;
+    if ((numNodes > 1) && (nodes[startIndex]->fusedInto == nodes[startIndex + numNodes - 1]))
+    {
+        vx_node_t *leader = nodes[startIndex + numNodes - 1];
+
+        VX_PRINT(VX_ZONE_GRAPH,"Executing %u fused Nodes ending in Kernel %s:%d on target %s\n",
+            numNodes,
+            leader->kernel->name,
+            leader->kernel->enumeration,
+            leader->base.context->targets[leader->affinity].name);
+
+        vxStartCapture(&leader->perf);
+        status = vxFusedKernel(&nodes[startIndex], numNodes);
+        vxStopCapture(&leader->perf);
+        VX_TRACE_INTERVAL("node", leader->kernel->name, leader, -1, leader->perf.beg, leader->perf.end);
+
+        for (n = startIndex; (n < (startIndex + numNodes)) && (action == VX_ACTION_CONTINUE); n++)
+        {
+            nodes[n]->executed = vx_true_e;
+            nodes[n]->status = status;
+            if (status != VX_SUCCESS)
+            {
+                action = VX_ACTION_ABANDON;
+                VX_PRINT(VX_ZONE_ERROR, "Abandoning Graph due to error (%d)!\n", status);
+            }
+            else if (nodes[n]->callback)
+            {
+                action = nodes[n]->callback((vx_node)nodes[n]);
+                VX_PRINT(VX_ZONE_GRAPH,"callback returned action %d\n", action);
+            }
+        }
+        return action;
+    }
+    for (n = startIndex; (n < (startIndex + numNodes)) && (action == VX_ACTION_CONTINUE); n++)
+    {
+        VX_PRINT(VX_ZONE_GRAPH,"Executing Kernel %s:%d in Nodes[%u] on target %s\n",
+            nodes[n]->kernel->name,
+            nodes[n]->kernel->enumeration,
+            n,
+            nodes[n]->base.context->targets[nodes[n]->affinity].name);
+
+        vxStartCapture(&nodes[n]->perf);
+        status = nodes[n]->kernel->function((vx_node)nodes[n],
+                                            (vx_reference *)nodes[n]->parameters,
+                                            nodes[n]->kernel->signature.numParams);
+        nodes[n]->executed = vx_true_e;
+        nodes[n]->status = status;
+        vxStopCapture(&nodes[n]->perf);
+        VX_TRACE_INTERVAL("node", nodes[n]->kernel->name, nodes[n], -1, nodes[n]->perf.beg, nodes[n]->perf.end);
+
+        VX_PRINT(VX_ZONE_GRAPH,"kernel %s returned %d\n", nodes[n]->kernel->name, status);
+
+        if (status == VX_SUCCESS)
+        {
+            /* call the callback if it is attached */
+            if (nodes[n]->callback)
+            {
+                action = nodes[n]->callback((vx_node)nodes[n]);
+                VX_PRINT(VX_ZONE_GRAPH,"callback returned action %d\n", action);
+            }
+        }
+        else
+        {
+            action = VX_ACTION_ABANDON;
+            VX_PRINT(VX_ZONE_ERROR, "Abandoning Graph due to error (%d)!\n", status);
+        }
+    }
+    return action;
+}
+
+vx_status vxTargetFuse(vx_target_t *target, vx_node_t *nodes[], vx_size numNodes)
+{
+    return vxFusedSupported(nodes, numNodes);
+}
+
+vx_status vxTargetVerify(vx_target_t *target, vx_node_t *node)
+{
+    vx_status status = VX_SUCCESS;
+    return status;
+}
+
+vx_kernel vxTargetAddKernel(vx_target_t *target,
+                            vx_char name[VX_MAX_KERNEL_NAME],
+                            vx_enum enumeration,
+                            vx_kernel_f func_ptr,
+                            vx_uint32 numParams,
+                            vx_kernel_input_validate_f input,
+                            vx_kernel_output_validate_f output,
+                            vx_kernel_initialize_f initialize,
+                            vx_kernel_deinitialize_f deinitialize)
+{
+    vx_uint32 k = 0u;
+    vx_kernel_t *kernel = NULL;
+    for (k = target->numKernels; k < VX_INT_MAX_KERNELS; k++)
+    {
+        kernel = &(target->kernels[k]);
+        if ((kernel->enabled == vx_false_e) &&
+            (kernel->enumeration == VX_KERNEL_INVALID))
+        {
+            vxInitializeKernel(target->base.context,
+                               kernel,
+                               enumeration, func_ptr, name,
+                               NULL, numParams,
+                               input, output, initialize, deinitialize);
+            VX_PRINT(VX_ZONE_KERNEL, "Reserving %s Kernel[%u] for %s\n", target->name, k, kernel->name);
+            target->numKernels++;
+            break;
+        }
+        kernel = NULL;
+    }
+    return (vx_kernel)kernel;
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+#ifndef _OPENVX_SIMD_INTERFACE_H_
+#define _OPENVX_SIMD_INTERFACE_H_
+
+/*!
+ * \file
+ * \brief The OpenVX SIMD Target Interface
+ * \details The kernels of this target are built from row functions. Each
+ * instruction set provides a table of them and the table for the processor
+ * is picked once, when the target is initialized.
+ */
+
+#include <VX/vx_helper.h>
+#include <vx_scale_lib.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+/*! \brief SSE2 and AVX2 row functions are built and picked at run time. */
+#define VX_SIMD_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+/*! \brief NEON row functions are built. */
+#define VX_SIMD_NEON
+#endif
+
+/*! \brief Computes the interior pixels [1, width - 1) of one row of a 3x3 filter.
+ * \param [out] dst The output row.
+ * \param [in] r0 The input row above.
+ * \param [in] r1 The input row at the output row.
+ * \param [in] r2 The input row below.
+ * \param [in] width The width of the rows, at least 3.
+ * \param [in] tmp Scratch space for width intermediate values.
+ */
+typedef void (*vx_filter_row_f)(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp);
+
+/*! \brief Computes one row of a convolution from a list of taps, with
+ * dst[x] = saturate((sum of coeffs[k] * src[k][x]) / (1 << shift)), where the
+ * division rounds toward zero as C does.
+ * \param [out] dst The output row, U8 or S16.
+ * \param [in] src The input row of each tap, U8 or S16, already offset by the tap.
+ * \param [in] coeffs The coefficient of each tap.
+ * \param [in] count The number of taps, at most VX_CONVOLUTION_MAX_DIM squared.
+ * \param [in] shift The log2 of the scale of the convolution.
+ * \param [in] width The number of pixels.
+ */
+typedef void (*vx_convolve_row_f)(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width);
+
+/*! \brief The formats of the first input, second input and output of the
+ * arithmetic kernels, which pick their row functions by them.
+ */
+enum vx_arith_formats_e {
+    VX_ARITH_U8_U8_U8 = 0,
+    VX_ARITH_U8_U8_S16,
+    VX_ARITH_U8_S16_S16,
+    VX_ARITH_S16_U8_S16,
+    VX_ARITH_S16_S16_S16,
+    /*! \brief The number of format combinations. */
+    VX_ARITH_FORMATS,
+};
+
+/*! \brief Computes one row of an elementwise operation on two images.
+ * \param [out] dst The output row.
+ * \param [in] src0 The first input row.
+ * \param [in] src1 The second input row.
+ * \param [in] scale The scale of Multiply, unused by the other operations.
+ * \param [in] width The number of pixels.
+ */
+typedef void (*vx_arith_row_f)(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width);
+
+/*! \brief Computes one row of an elementwise operation on one image. */
+typedef void (*vx_unary_row_f)(vx_uint8 *dst, const vx_uint8 *src, vx_uint32 width);
+
+/*! \brief Sets dst to 255 where lower <= src <= upper and to 0 elsewhere. */
+typedef void (*vx_threshold_row_f)(vx_uint8 *dst, const vx_uint8 *src, vx_uint8 lower, vx_uint8 upper, vx_uint32 width);
+
+/*! \brief Accumulates one row of an image. Only the weighted accumulation uses alpha. */
+typedef void (*vx_accumulate_row_f)(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width);
+
+/*! \brief Adds the sum and the sum of squares of one row of pixels to sum and sumsq. */
+typedef void (*vx_moments_row_f)(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq);
+
+/*! \brief Computes one row of an integral image, dst[x] = prev[x] + src[0] + ... + src[x].
+ * \param [in] prev The integral of the row above, or the sums of the rows above a band.
+ */
+typedef void (*vx_integral_row_f)(vx_uint32 *dst, const vx_uint32 *prev, const vx_uint8 *src, vx_uint32 width);
+
+/*! \brief Scores the FAST-9 corners of a row, given the offsets of the 16 pixels
+ * of the circle, and writes zero for the pixels which are not corners and for
+ * the 3 pixels on either side.
+ */
+typedef void (*vx_fast9_row_f)(vx_uint8 *scores, const vx_uint8 *src, const vx_int32 *circle, vx_uint8 threshold, vx_uint32 width);
+
+/*! \brief Filters rows along y for the image scaler, with
+ * dst[x] = (sum of weights[k] * rows[k][x] + rounding) >> VX_SCALE_SHIFT_Y.
+ * \param [out] dst The output row.
+ * \param [in] rows The rows already filtered along x, at most 255 << VX_SCALE_SHIFT_X.
+ * \param [in] weights The weight of each row, which add up to 1 << VX_SCALE_BITS.
+ * \param [in] taps The number of rows.
+ * \param [in] width The number of pixels.
+ */
+typedef void (*vx_scale_row_f)(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 width);
+
+/*! \brief Halves two rows of an image into one row of width pixels. */
+typedef void (*vx_half_row_f)(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width);
+
+/*! \brief The row functions of the pointwise kernels for one instruction set.
+ * The arithmetic rows are indexed by \ref vx_arith_formats_e and then by 0 to
+ * truncate or 1 to saturate.
+ */
+typedef struct _vx_pointwise_rows_t {
+    vx_arith_row_f add[VX_ARITH_FORMATS][2];
+    vx_arith_row_f subtract[VX_ARITH_FORMATS][2];
+    vx_arith_row_f multiply[VX_ARITH_FORMATS][2];
+    vx_arith_row_f absdiff_u8;
+    vx_arith_row_f absdiff_u16;
+    vx_arith_row_f and_u8;
+    vx_arith_row_f or_u8;
+    vx_arith_row_f xor_u8;
+    vx_unary_row_f not_u8;
+    vx_threshold_row_f threshold;
+    vx_accumulate_row_f accumulate;
+    vx_accumulate_row_f accumulate_weighted;
+    vx_accumulate_row_f accumulate_square;
+} vx_pointwise_rows_t;
+
+/*! \brief The row functions of one instruction set. */
+typedef struct _vx_rows_t {
+    /*! \brief The name of the instruction set. */
+    const vx_char *isa;
+    vx_filter_row_f box;
+    vx_filter_row_f gaussian;
+    vx_filter_row_f median;
+    vx_filter_row_f erode;
+    vx_filter_row_f dilate;
+    /*! \brief The pointwise rows, which may be shared with another instruction set. */
+    const vx_pointwise_rows_t *pointwise;
+    /*! \brief The gradient rows take the S16 gradients in x and y as src0 and src1. */
+    vx_arith_row_f magnitude_u8;
+    vx_arith_row_f magnitude_s16;
+    vx_arith_row_f phase;
+    /*! \brief The convolution rows, indexed by whether the input and then the output are S16. */
+    vx_convolve_row_f convolve[2][2];
+    vx_moments_row_f moments_u8;
+    vx_moments_row_f moments_u16;
+    vx_integral_row_f integral;
+    vx_fast9_row_f fast9;
+    vx_scale_row_f scale;
+    /*! \brief Halving rounds the mean of each 2x2 block, or picks its bottom right pixel for nearest neighbor. */
+    vx_half_row_f half_mean;
+    vx_half_row_f half_nearest;
+} vx_rows_t;
+
+/*! \brief The 19 exchanges which leave the median of p[0..8] in p[4]. OP(a,b)
+ * must order the pair so that p[a] <= p[b].
+ */
+#define VX_MEDIAN9_NETWORK(OP) \
+    OP(1,2) OP(4,5) OP(7,8) OP(0,1) OP(3,4) OP(6,7) OP(1,2) OP(4,5) OP(7,8) \
+    OP(0,3) OP(5,8) OP(4,7) OP(3,6) OP(1,4) OP(2,5) OP(4,7) OP(4,2) OP(6,4) OP(4,2)
+
+/*! \brief The reciprocal of 9 in 0.16 fixed point, (s * 7282) >> 16 equals s / 9
+ * for every sum s of nine 8 bit values.
+ */
+#define VX_DIV9_Q16 (7282)
+
+/*! \brief The coefficients of the odd polynomial which approximates atan(t)
+ * for 0 <= t <= 1 to within 2e-6 radians.
+ */
+#define VX_ATAN_C1 ( 0.99997726f)
+#define VX_ATAN_C3 (-0.33262347f)
+#define VX_ATAN_C5 ( 0.19354346f)
+#define VX_ATAN_C7 (-0.11643287f)
+#define VX_ATAN_C9 ( 0.05265332f)
+#define VX_ATAN_C11 (-0.01172120f)
+
+/*! \brief The phase rows approximate the unquantized phase to well within this
+ * distance. A pixel whose approximation is closer to a step of the
+ * quantization is computed again with \ref vxPhaseExact.
+ */
+#define VX_PHASE_EPSILON (1.0f/1024)
+
+/*! \brief Computes the quantized phase of one pixel in double precision, as the
+ * reference does.
+ */
+vx_uint8 vxPhaseExact(vx_int16 gx, vx_int16 gy);
+
+/*! \brief The portable gradient rows, which are also the tails of the vector ones. */
+void vxMagnitudeRowU8(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width);
+void vxMagnitudeRowS16(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width);
+void vxPhaseRow(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width);
+
+/*! \brief The portable convolution rows, which are also used for rows too short for a vector. */
+void vxConvolveRowU8U8(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width);
+void vxConvolveRowU8S16(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width);
+void vxConvolveRowS16U8(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width);
+void vxConvolveRowS16S16(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width);
+
+/*! \brief The portable statistics rows, which are also the tails of the vector ones. */
+void vxMomentsRowU8(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq);
+void vxMomentsRowU16(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq);
+void vxIntegralRow(vx_uint32 *dst, const vx_uint32 *prev, const vx_uint8 *src, vx_uint32 width);
+
+vx_uint8 vxFast9Score(const vx_uint8 *ptr, const vx_int32 *circle, vx_uint8 threshold);
+void vxFast9Row(vx_uint8 *scores, const vx_uint8 *src, const vx_int32 *circle, vx_uint8 threshold, vx_uint32 width);
+
+/*! \brief The portable scaler rows. The vector rows finish their tails with these from an offset x. */
+void vxScaleRow(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 width);
+void vxScaleRowFrom(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 x, vx_uint32 width);
+void vxHalfMeanRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width);
+void vxHalfNearestRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width);
+
+extern const vx_rows_t vx_rows_c;
+extern const vx_pointwise_rows_t vx_pointwise_c;
+#if defined(VX_SIMD_X86)
+extern const vx_rows_t vx_rows_sse2;
+extern const vx_rows_t vx_rows_avx2;
+extern const vx_pointwise_rows_t vx_pointwise_sse2;
+#elif defined(VX_SIMD_NEON)
+extern const vx_rows_t vx_rows_neon;
+#endif
+
+/*! \brief The row functions picked when the target was initialized. */
+extern const vx_rows_t *vx_rows;
+
+/*! \brief Runs a 3x3 filter row function over the interior of an image. */
+vx_status vxFilter3x3(vx_node node, vx_reference *parameters, vx_uint32 num, vx_filter_row_f row);
+
+vx_status vxFilter3x3InputValidator(vx_node node, vx_uint32 index);
+vx_status vxFilter3x3OutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr);
+
+/*! \brief Accesses an image whose pixels must be packed, so that the pointwise
+ * kernels may hand whole rows to their row functions.
+ * \return VX_ERROR_NOT_SUPPORTED if the pixels are not packed.
+ */
+vx_status vxAccessImageRows(vx_image image, vx_rectangle rect, vx_imagepatch_addressing_t *addr, void **base);
+
+/*! \brief Runs a row function over the valid region of two input images. */
+vx_status vxBinaryRows(vx_image in0, vx_image in1, vx_image output, vx_float32 scale, vx_arith_row_f row);
+
+/*! \brief Keeps the row functions to truncate and to saturate in the local data of a node. */
+vx_status vxSetNodeRows(vx_node node, vx_arith_row_f truncate, vx_arith_row_f saturate);
+
+/*! \brief Picks the row functions for the formats of an arithmetic node. */
+vx_status vxArithmeticInitializer(vx_node node, vx_image in0, vx_image in1, vx_image output,
+                                  const vx_arith_row_f rows[VX_ARITH_FORMATS][2]);
+
+/*! \brief Returns the row function picked for a node with the current policy,
+ * or NULL before the node is initialized.
+ * \param [in] policy_param The overflow policy, or 0 when the node has none.
+ */
+vx_arith_row_f vxArithmeticRow(vx_node node, vx_scalar policy_param);
+
+/*! \brief Runs the row function picked for a node with the current policy.
+ * \param [in] policy_param The overflow policy, or 0 when the node has none.
+ */
+vx_status vxArithmeticKernel(vx_node node, vx_image in0, vx_image in1, vx_image output,
+                             vx_float32 scale, vx_scalar policy_param);
+
+/*! \brief Looks up one row of U8 pixels, leaving the pixels past the table unchanged. */
+void vxTableLookupRowU8(void *dst, const void *src, const void *lut, vx_size count, vx_uint32 width);
+
+/*! \brief Gets the range of the pixels which a threshold sets to 255. */
+void vxThresholdRange(vx_threshold threshold, vx_uint8 *lower, vx_uint8 *upper);
+
+/*! \brief Returns VX_SUCCESS when the nodes can be executed as one fused pass. */
+vx_status vxFusedSupported(struct _vx_node_t *nodes[], vx_size num);
+
+/*! \brief Executes a group of per-pixel nodes row by row in a single pass. */
+vx_status vxFusedKernel(struct _vx_node_t *nodes[], vx_size num);
+
+extern vx_kernel_description_t box3x3_kernel;
+extern vx_kernel_description_t gaussian3x3_kernel;
+extern vx_kernel_description_t median3x3_kernel;
+extern vx_kernel_description_t erode3x3_kernel;
+extern vx_kernel_description_t dilate3x3_kernel;
+extern vx_kernel_description_t add_kernel;
+extern vx_kernel_description_t subtract_kernel;
+extern vx_kernel_description_t multiply_kernel;
+extern vx_kernel_description_t absdiff_kernel;
+extern vx_kernel_description_t and_kernel;
+extern vx_kernel_description_t or_kernel;
+extern vx_kernel_description_t xor_kernel;
+extern vx_kernel_description_t not_kernel;
+extern vx_kernel_description_t lut_kernel;
+extern vx_kernel_description_t threshold_kernel;
+extern vx_kernel_description_t accumulate_kernel;
+extern vx_kernel_description_t accumulate_weighted_kernel;
+extern vx_kernel_description_t accumulate_square_kernel;
+extern vx_kernel_description_t magnitude_kernel;
+extern vx_kernel_description_t phase_kernel;
+extern vx_kernel_description_t convolution_kernel;
+extern vx_kernel_description_t mean_stddev_kernel;
+extern vx_kernel_description_t integral_image_kernel;
+extern vx_kernel_description_t fast9_kernel;
+extern vx_kernel_description_t scale_image_kernel;
+
+#endif
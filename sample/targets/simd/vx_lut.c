@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Table Lookup Kernel of the SIMD target. There is no byte
+ * gather before AVX-512, so the rows are looked up by scalar code which only
+ * differs from the C model by working on whole rows of one type.
+ */
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+#include <math.h>
+
+typedef void (*vx_lut_row_f)(void *dst, const void *src, const void *lut, vx_size count, vx_uint32 width);
+
+void vxTableLookupRowU8(void *dst, const void *src, const void *lut, vx_size count, vx_uint32 width)
+{
+    const vx_uint8 *s = (const vx_uint8 *)src;
+    const vx_uint8 *l = (const vx_uint8 *)lut;
+    vx_uint8 *d = (vx_uint8 *)dst;
+    vx_uint32 x = 0;
+    if (count >= 256)
+    {
+        for (; x + 4 <= width; x += 4)
+        {
+            d[x + 0] = l[s[x + 0]];
+            d[x + 1] = l[s[x + 1]];
+            d[x + 2] = l[s[x + 2]];
+            d[x + 3] = l[s[x + 3]];
+        }
+    }
+    for (; x < width; x++)
+    {
+        if (s[x] < count)
+            d[x] = l[s[x]];
+    }
+}
+
+static void vxTableLookupRowS16(void *dst, const void *src, const void *lut, vx_size count, vx_uint32 width)
+{
+    const vx_int16 *s = (const vx_int16 *)src;
+    const vx_int16 *l = (const vx_int16 *)lut;
+    vx_int16 *d = (vx_int16 *)dst;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        if ((s[x] >= 0) && ((vx_size)s[x] < count))
+            d[x] = l[s[x]];
+    }
+}
+
+static vx_status vxTableLookupKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 3)
+    {
+        vx_image src_image = (vx_image)parameters[0];
+        vx_lut lut = (vx_scalar)parameters[1];
+        vx_image dst_image = (vx_image)parameters[2];
+        vx_enum type = 0;
+        vx_rectangle rect;
+        vx_imagepatch_addressing_t src_addr, dst_addr;
+        void *src_base = NULL, *dst_base = NULL, *lut_ptr = NULL;
+        vx_uint32 y = 0;
+        vx_size count = 0;
+        vx_lut_row_f row = NULL;
+
+        vxQueryLUT(lut, VX_LUT_ATTRIBUTE_TYPE, &type, sizeof(type));
+        vxQueryLUT(lut, VX_LUT_ATTRIBUTE_COUNT, &count, sizeof(count));
+        if (type == VX_TYPE_UINT8)
+            row = vxTableLookupRowU8;
+        else if (type == VX_TYPE_INT16)
+            row = vxTableLookupRowS16;
+        rect = vxGetValidRegionImage(src_image);
+        status = VX_SUCCESS;
+        status |= vxAccessImageRows(src_image, rect, &src_addr, &src_base);
+        status |= vxAccessImageRows(dst_image, rect, &dst_addr, &dst_base);
+        status |= vxAccessLUT(lut, &lut_ptr);
+
+        for (y = 0; (y < src_addr.dim_y) && (status == VX_SUCCESS) && (row != NULL); y++)
+        {
+            row((vx_uint8 *)dst_base + (y * dst_addr.stride_y),
+                (vx_uint8 *)src_base + (y * src_addr.stride_y),
+                lut_ptr, count, src_addr.dim_x);
+        }
+
+        status |= vxCommitLUT(lut, lut_ptr);
+        status |= vxCommitImagePatch(src_image, 0, 0, &src_addr, src_base);
+        status |= vxCommitImagePatch(dst_image, rect, 0, &dst_addr, dst_base);
+        vxReleaseRectangle(&rect);
+    }
+    return status;
+}
+
+static vx_status vxTableLookupInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_image input = 0;
+        vx_parameter param = vxGetParameterByIndex(node, index);
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(input));
+        if (input)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8 || format == FOURCC_S16)
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    else if (index == 1)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        vx_lut lut = 0;
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &lut, sizeof(lut));
+        if (lut)
+        {
+            vx_enum type = 0;
+            vxQueryLUT(lut, VX_LUT_ATTRIBUTE_TYPE, &type, sizeof(type));
+            if (type == VX_TYPE_UINT8 || type == VX_TYPE_INT16)
+            {
+                status = VX_SUCCESS;
+            }
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+static vx_status vxTableLookupOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 2)
+    {
+        vx_parameter src_param = vxGetParameterByIndex(node, 0);
+        if (src_param)
+        {
+            vx_image src = 0;
+            vxQueryParameter(src_param, VX_PARAMETER_ATTRIBUTE_REF, &src, sizeof(src));
+            if (src)
+            {
+                vx_uint32 width = 0, height = 0;
+
+                vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(height));
+                vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+                /* output is equal type and size */
+                ptr->type = VX_TYPE_IMAGE;
+                ptr->dim.image.format = FOURCC_U8;
+                ptr->dim.image.width = width;
+                ptr->dim.image.height = height;
+                status = VX_SUCCESS;
+            }
+            vxReleaseParameter(&src_param);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t lut_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_LUT,   VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT,VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t lut_kernel = {
+    VX_KERNEL_TABLE_LOOKUP,
+    "org.khronos.openvx.table_lookup",
+    vxTableLookupKernel,
+    lut_kernel_params, dimof(lut_kernel_params),
+    vxTableLookupInputValidator,
+    vxTableLookupOutputValidator,
+    NULL,
+    NULL,
+};
+
+
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Mean and Standard Deviation Kernel of the SIMD target.
+ * \details The sum and the sum of squares are kept exactly in 64 bit integers
+ * and gathered in one pass, split into bands of rows which run on the pool and
+ * are added together at the end.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief The state of one execution of the kernel, shared by its bands. */
+typedef struct _vx_moments_t {
+    vx_uint8 *base;
+    vx_imagepatch_addressing_t addr;
+    vx_moments_row_f row;
+    vx_uint64 sum[VX_MAX_BANDS];
+    vx_uint64 sumsq[VX_MAX_BANDS];
+} vx_moments_t;
+
+static void vxMomentsBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_moments_t *m = (vx_moments_t *)arg;
+    vx_uint64 sum = 0, sumsq = 0;
+    vx_uint32 y;
+    for (y = y0; y < y1; y++)
+        m->row(m->base + (y * m->addr.stride_y), m->addr.dim_x, &sum, &sumsq);
+    m->sum[index] = sum;
+    m->sumsq[index] = sumsq;
+}
+
+static vx_status vxMeanStdDevKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_FAILURE;
+    if (num == 3)
+    {
+        vx_image input = (vx_image)parameters[0];
+        vx_scalar s_mean = (vx_scalar)parameters[1];
+        vx_scalar s_stddev = (vx_scalar)parameters[2];
+        vx_fourcc format = 0;
+        vx_rectangle rect = vxGetValidRegionImage(input);
+        vx_moments_t m;
+        void *base = NULL;
+
+        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+        m.row = (format == FOURCC_U16) ? vx_rows->moments_u16 : vx_rows->moments_u8;
+        status = vxAccessImageRows(input, rect, &m.addr, &base);
+        m.base = (vx_uint8 *)base;
+        if (status == VX_SUCCESS)
+        {
+            vx_uint32 b, count = vxBandCount(node, m.addr.dim_x, m.addr.dim_y);
+            vx_uint64 sum = 0, sumsq = 0;
+            vx_float64 n = (vx_float64)m.addr.dim_x * m.addr.dim_y;
+            vx_float64 mean, var;
+            vx_float32 mean32 = 0.0f, stddev32 = 0.0f;
+
+            vxRunBands(node, count, m.addr.dim_y, vxMomentsBand, &m);
+            for (b = 0; b < count; b++)
+            {
+                sum += m.sum[b];
+                sumsq += m.sumsq[b];
+            }
+            if (n > 0)
+            {
+                mean = (vx_float64)sum / n;
+                var = ((vx_float64)sumsq - (vx_float64)sum * mean) / n;
+                mean32 = (vx_float32)mean;
+                stddev32 = (vx_float32)sqrt(var > 0.0 ? var : 0.0);
+            }
+            status |= vxCommitScalarValue(s_mean, &mean32);
+            status |= vxCommitScalarValue(s_stddev, &stddev32);
+        }
+        status |= vxCommitImagePatch(input, 0, 0, &m.addr, base);
+        vxReleaseRectangle(&rect);
+    }
+    else
+    {
+        status = VX_ERROR_INVALID_PARAMETERS;
+    }
+    return status;
+}
+
+static vx_status vxMeanStdDevInputValidator(vx_node node, vx_uint32 index)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 0)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        vx_image image = 0;
+
+        vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &image, sizeof(image));
+        if (image)
+        {
+            vx_fourcc format = 0;
+            vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+            if (format == FOURCC_U8 || format == FOURCC_U16)
+                status = VX_SUCCESS;
+        }
+        vxReleaseParameter(&param);
+    }
+    return status;
+}
+
+static vx_status vxMeanStdDevOutputValidator(vx_node node, vx_uint32 index, vx_meta_format_t *ptr)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    if (index == 1 || index == 2)
+    {
+        vx_parameter param = vxGetParameterByIndex(node, index);
+        if (param)
+        {
+            vx_scalar output = 0;
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &output, sizeof(output));
+            if (output)
+            {
+                vx_enum type = 0;
+                vxQueryScalar(output, VX_SCALAR_ATTRIBUTE_TYPE, &type, sizeof(type));
+                if (type == VX_TYPE_FLOAT32)
+                {
+                    ptr->type = VX_TYPE_SCALAR;
+                    ptr->dim.scalar.type = type;
+                    status = VX_SUCCESS;
+                }
+            }
+            vxReleaseParameter(&param);
+        }
+    }
+    return status;
+}
+
+static vx_param_description_t mean_stddev_kernel_params[] = {
+    {VX_INPUT,  VX_TYPE_IMAGE,  VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t mean_stddev_kernel = {
+    VX_KERNEL_MEAN_STDDEV,
+    "org.khronos.openvx.mean_stddev",
+    vxMeanStdDevKernel,
+    mean_stddev_kernel_params, dimof(mean_stddev_kernel_params),
+    vxMeanStdDevInputValidator,
+    vxMeanStdDevOutputValidator,
+    NULL,
+    NULL,
+};
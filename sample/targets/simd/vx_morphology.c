@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Morphology Kernels of the SIMD target.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+static vx_status vxErode3x3Kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxFilter3x3(node, parameters, num, vx_rows->erode);
+}
+
+static vx_status vxDilate3x3Kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxFilter3x3(node, parameters, num, vx_rows->dilate);
+}
+
+static vx_param_description_t morphology_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+};
+
+vx_kernel_description_t erode3x3_kernel = {
+    VX_KERNEL_ERODE_3x3,
+    "org.khronos.openvx.erode3x3",
+    vxErode3x3Kernel,
+    morphology_kernel_params, dimof(morphology_kernel_params),
+    vxFilter3x3InputValidator,
+    vxFilter3x3OutputValidator,
+    NULL,
+    NULL,
+};
+
+vx_kernel_description_t dilate3x3_kernel = {
+    VX_KERNEL_DILATE_3x3,
+    "org.khronos.openvx.dilate3x3",
+    vxDilate3x3Kernel,
+    morphology_kernel_params, dimof(morphology_kernel_params),
+    vxFilter3x3InputValidator,
+    vxFilter3x3OutputValidator,
+    NULL,
+    NULL,
+};
@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The AVX2 row functions, 32 pixels at a time. They are compiled for
+ * AVX2 whatever the flags of the build, and only called when the processor
+ * reports AVX2 support.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+#if defined(VX_SIMD_X86)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC target("avx2")
+#endif
+#include <immintrin.h>
+
+/*! \brief Packs 16 unsigned 16 bit values, at most 255, into 16 bytes. */
+#define VX_PACK16(v) _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1))
+
+/*! \brief Loads 16 pixels widened to 16 bits. */
+#define VX_LOAD16(p) _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(p)))
+
+static void vxBoxRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    const __m256i div9 = _mm256_set1_epi16(VX_DIV9_Q16);
+    vx_uint32 x;
+    /* the sums of the columns */
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m256i s = _mm256_add_epi16(_mm256_add_epi16(VX_LOAD16(&r0[x]), VX_LOAD16(&r1[x])), VX_LOAD16(&r2[x]));
+        _mm256_storeu_si256((__m256i *)&tmp[x], s);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + r1[x] + r2[x]);
+    /* the sums of three columns, divided by 9 */
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m256i s = _mm256_add_epi16(_mm256_add_epi16(_mm256_loadu_si256((const __m256i *)&tmp[x - 1]),
+                                                      _mm256_loadu_si256((const __m256i *)&tmp[x])),
+                                                      _mm256_loadu_si256((const __m256i *)&tmp[x + 1]));
+        s = _mm256_mulhi_epu16(s, div9);
+        _mm_storeu_si128((__m128i *)&dst[x], VX_PACK16(s));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + tmp[x] + tmp[x + 1]) / 9);
+}
+
+static void vxGaussianRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    /* the columns weighted 1 2 1 */
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m256i s = _mm256_add_epi16(_mm256_add_epi16(VX_LOAD16(&r0[x]), VX_LOAD16(&r2[x])),
+                                     _mm256_slli_epi16(VX_LOAD16(&r1[x]), 1));
+        _mm256_storeu_si256((__m256i *)&tmp[x], s);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + 2 * r1[x] + r2[x]);
+    /* the rows weighted 1 2 1, divided by 16 */
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m256i s = _mm256_add_epi16(_mm256_add_epi16(_mm256_loadu_si256((const __m256i *)&tmp[x - 1]),
+                                                      _mm256_loadu_si256((const __m256i *)&tmp[x + 1])),
+                                     _mm256_slli_epi16(_mm256_loadu_si256((const __m256i *)&tmp[x]), 1));
+        s = _mm256_srli_epi16(s, 4);
+        _mm_storeu_si128((__m128i *)&dst[x], VX_PACK16(s));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + 2 * tmp[x] + tmp[x + 1]) >> 4);
+}
+
+#define VX_SORT(a,b) { __m256i t = _mm256_min_epu8(p[a], p[b]); p[b] = _mm256_max_epu8(p[a], p[b]); p[a] = t; }
+
+static void vxMedianRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 32 <= width - 1; x += 32)
+    {
+        __m256i p[9];
+        p[0] = _mm256_loadu_si256((const __m256i *)&r0[x - 1]);
+        p[1] = _mm256_loadu_si256((const __m256i *)&r0[x]);
+        p[2] = _mm256_loadu_si256((const __m256i *)&r0[x + 1]);
+        p[3] = _mm256_loadu_si256((const __m256i *)&r1[x - 1]);
+        p[4] = _mm256_loadu_si256((const __m256i *)&r1[x]);
+        p[5] = _mm256_loadu_si256((const __m256i *)&r1[x + 1]);
+        p[6] = _mm256_loadu_si256((const __m256i *)&r2[x - 1]);
+        p[7] = _mm256_loadu_si256((const __m256i *)&r2[x]);
+        p[8] = _mm256_loadu_si256((const __m256i *)&r2[x + 1]);
+        VX_MEDIAN9_NETWORK(VX_SORT)
+        _mm256_storeu_si256((__m256i *)&dst[x], p[4]);
+    }
+    vx_rows_c.median(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+/*! \brief Loads the minimum (or maximum) of a column of three pixels. */
+#define VX_COLUMN(op, x) op(op(_mm256_loadu_si256((const __m256i *)&r0[x]), \
+                               _mm256_loadu_si256((const __m256i *)&r1[x])), \
+                               _mm256_loadu_si256((const __m256i *)&r2[x]))
+
+static void vxErodeRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 32 <= width - 1; x += 32)
+    {
+        __m256i m = _mm256_min_epu8(_mm256_min_epu8(VX_COLUMN(_mm256_min_epu8, x - 1), VX_COLUMN(_mm256_min_epu8, x)), VX_COLUMN(_mm256_min_epu8, x + 1));
+        _mm256_storeu_si256((__m256i *)&dst[x], m);
+    }
+    vx_rows_c.erode(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+static void vxDilateRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 32 <= width - 1; x += 32)
+    {
+        __m256i m = _mm256_max_epu8(_mm256_max_epu8(VX_COLUMN(_mm256_max_epu8, x - 1), VX_COLUMN(_mm256_max_epu8, x)), VX_COLUMN(_mm256_max_epu8, x + 1));
+        _mm256_storeu_si256((__m256i *)&dst[x], m);
+    }
+    vx_rows_c.dilate(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+/*! \brief Computes the integer square roots of eight unsigned sums of squares
+ * of 16 bit gradients, as vxSqrtSSE2 does.
+ */
+static VX_INLINE __m256i vxSqrtAVX2(__m256i sum)
+{
+    const __m256i sign = _mm256_set1_epi32((vx_int32)0x80000000);
+    __m256 f = _mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(sum, 1)), _mm256_set1_ps(2.0f)), _mm256_set1_ps(1.0f));
+    __m256 r = _mm256_rsqrt_ps(f);
+    __m256i m, m1;
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), f), _mm256_mul_ps(r, r))));
+    m = _mm256_cvttps_epi32(_mm256_mul_ps(f, r));
+    sum = _mm256_xor_si256(sum, sign);
+    m = _mm256_add_epi32(m, _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_mullo_epi32(m, m), sign), sum));
+    m1 = _mm256_add_epi32(m, _mm256_set1_epi32(1));
+    return _mm256_add_epi32(m1, _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_mullo_epi32(m1, m1), sign), sum));
+}
+
+/*! \brief Loads 8 gradients widened to 32 bits. */
+#define VX_LOAD_S16(p) _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(p)))
+
+/*! \brief Packs 8 signed 32 bit values into 8 saturated 16 bit values. */
+#define VX_PACK_S32(v) _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1))
+
+static void vxMagnitudeRowU8AVX2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m256i a = VX_LOAD_S16(&gx[x]);
+        __m256i b = VX_LOAD_S16(&gy[x]);
+        __m256i m = vxSqrtAVX2(_mm256_add_epi32(_mm256_mullo_epi32(a, a), _mm256_mullo_epi32(b, b)));
+        __m128i v = VX_PACK_S32(_mm256_srli_epi32(m, 2));
+        _mm_storel_epi64((__m128i *)&d[x], _mm_packus_epi16(v, v));
+    }
+    vxMagnitudeRowU8(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+static void vxMagnitudeRowS16AVX2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_int16 *d = (vx_int16 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m256i a = VX_LOAD_S16(&gx[x]);
+        __m256i b = VX_LOAD_S16(&gy[x]);
+        __m256i m = vxSqrtAVX2(_mm256_add_epi32(_mm256_mullo_epi32(a, a), _mm256_mullo_epi32(b, b)));
+        _mm_storeu_si128((__m128i *)&d[x], VX_PACK_S32(m));
+    }
+    vxMagnitudeRowS16(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+static void vxPhaseRowAVX2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    const __m256 abs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 zero = _mm256_setzero_ps();
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x, i;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m256 fx = _mm256_cvtepi32_ps(VX_LOAD_S16(&gx[x]));
+        __m256 fy = _mm256_cvtepi32_ps(VX_LOAD_S16(&gy[x]));
+        __m256 ax = _mm256_and_ps(fx, abs);
+        __m256 ay = _mm256_and_ps(fy, abs);
+        __m256 t = _mm256_div_ps(_mm256_min_ps(ax, ay), _mm256_max_ps(_mm256_max_ps(ax, ay), _mm256_set1_ps(1.0f)));
+        __m256 s = _mm256_mul_ps(t, t);
+        __m256 a = _mm256_add_ps(_mm256_mul_ps(s, _mm256_set1_ps(VX_ATAN_C11)), _mm256_set1_ps(VX_ATAN_C9));
+        __m256 frac;
+        __m256i q;
+        __m128i v;
+        vx_int32 flags;
+        a = _mm256_add_ps(_mm256_mul_ps(s, a), _mm256_set1_ps(VX_ATAN_C7));
+        a = _mm256_add_ps(_mm256_mul_ps(s, a), _mm256_set1_ps(VX_ATAN_C5));
+        a = _mm256_add_ps(_mm256_mul_ps(s, a), _mm256_set1_ps(VX_ATAN_C3));
+        a = _mm256_add_ps(_mm256_mul_ps(s, a), _mm256_set1_ps(VX_ATAN_C1));
+        a = _mm256_mul_ps(t, a);
+        /* unfold the octant to the angle from the positive x axis, 0 to pi */
+        a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps((vx_float32)(VX_TAU / 4)), a), _mm256_cmp_ps(ax, ay, _CMP_LT_OQ));
+        a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps((vx_float32)(VX_TAU / 2)), a), _mm256_cmp_ps(fx, zero, _CMP_LT_OQ));
+        a = _mm256_mul_ps(a, _mm256_set1_ps((vx_float32)(255.0 / VX_TAU)));
+        a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(255.0f), a), _mm256_cmp_ps(fy, zero, _CMP_LT_OQ));
+        q = _mm256_cvttps_epi32(a);
+        frac = _mm256_sub_ps(a, _mm256_cvtepi32_ps(q));
+        flags = _mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(frac, _mm256_set1_ps(VX_PHASE_EPSILON), _CMP_LT_OQ),
+                                                _mm256_cmp_ps(frac, _mm256_set1_ps(1.0f - VX_PHASE_EPSILON), _CMP_GT_OQ)));
+        v = VX_PACK_S32(q);
+        _mm_storel_epi64((__m128i *)&d[x], _mm_packus_epi16(v, v));
+        for (i = 0; (flags >> i) != 0; i++)
+        {
+            if (flags & (1 << i))
+                d[x + i] = vxPhaseExact(gx[x + i], gy[x + i]);
+        }
+    }
+    vxPhaseRow(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+/*! \brief Defines a convolution row as VX_CONVOLVE_ROW_SSE2 does, 16 pixels
+ * in one vector at a time. Within each 128 bit lane the unpacks interleave the
+ * same pixels, so the packs put the sums back in order.
+ */
+#define VX_CONVOLVE_ROW_AVX2(name, LOAD, STORE, tail) \
+static void name(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width) \
+{ \
+    __m256i pairs[(VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM + 1) / 2]; \
+    const __m256i bias = _mm256_set1_epi32((1 << shift) - 1); \
+    const __m128i sh = _mm_cvtsi32_si128(shift); \
+    vx_uint32 x, k; \
+    if (width < 16) \
+    { \
+        tail(dst, src, coeffs, count, shift, width); \
+        return; \
+    } \
+    for (k = 0; k < count; k += 2) \
+    { \
+        vx_uint32 c1 = (k + 1 < count) ? (vx_uint16)coeffs[k + 1] : 0; \
+        pairs[k / 2] = _mm256_set1_epi32((vx_int32)((vx_uint16)coeffs[k] | (c1 << 16))); \
+    } \
+    for (x = 0; x < width; x += 16) \
+    { \
+        __m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256(); \
+        __m256i a, b = _mm256_setzero_si256(); \
+        if (x + 16 > width) \
+            x = width - 16; \
+        for (k = 0; k < count; k += 2) \
+        { \
+            a = LOAD(src[k], x); \
+            if (k + 1 < count) \
+                b = LOAD(src[k + 1], x); \
+            lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), pairs[k / 2])); \
+            hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), pairs[k / 2])); \
+        } \
+        lo = _mm256_sra_epi32(_mm256_add_epi32(lo, _mm256_and_si256(_mm256_srai_epi32(lo, 31), bias)), sh); \
+        hi = _mm256_sra_epi32(_mm256_add_epi32(hi, _mm256_and_si256(_mm256_srai_epi32(hi, 31), bias)), sh); \
+        STORE(dst, x, _mm256_packs_epi32(lo, hi)); \
+    } \
+}
+
+/*! \brief Loads 16 S16 pixels. */
+#define VX_LOAD16_S16(p, x) _mm256_loadu_si256((const __m256i *)((const vx_int16 *)(p) + (x)))
+
+/*! \brief Loads 16 U8 pixels widened to 16 bits. */
+#define VX_LOAD16_U8(p, x) VX_LOAD16((const vx_uint8 *)(p) + (x))
+
+/*! \brief Stores 16 saturated 16 bit values as U8. */
+#define VX_STORE16_U8(p, x, v) _mm_storeu_si128((__m128i *)((vx_uint8 *)(p) + (x)), \
+    _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)))
+
+/*! \brief Stores 16 16 bit values as S16. */
+#define VX_STORE16_S16(p, x, v) _mm256_storeu_si256((__m256i *)((vx_int16 *)(p) + (x)), v)
+
+VX_CONVOLVE_ROW_AVX2(vxConvolveRowU8U8AVX2, VX_LOAD16_U8, VX_STORE16_U8, vxConvolveRowU8U8)
+VX_CONVOLVE_ROW_AVX2(vxConvolveRowU8S16AVX2, VX_LOAD16_U8, VX_STORE16_S16, vxConvolveRowU8S16)
+VX_CONVOLVE_ROW_AVX2(vxConvolveRowS16U8AVX2, VX_LOAD16_S16, VX_STORE16_U8, vxConvolveRowS16U8)
+VX_CONVOLVE_ROW_AVX2(vxConvolveRowS16S16AVX2, VX_LOAD16_S16, VX_STORE16_S16, vxConvolveRowS16S16)
+
+/*! \brief The number of 32 pixel blocks whose squares may be summed in 32 bit
+ * lanes before they are widened, each lane gaining at most 4 * 255 * 255 per block.
+ */
+#define VX_MOMENTS_BLOCKS (1024)
+
+static void vxMomentsRowU8AVX2(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq)
+{
+    const vx_uint8 *s = (const vx_uint8 *)src;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i s1 = zero, s2 = zero;
+    vx_uint64 lanes[4];
+    vx_uint32 x = 0;
+    while (x + 32 <= width)
+    {
+        __m256i sq = zero;
+        vx_uint32 b;
+        for (b = 0; (b < VX_MOMENTS_BLOCKS) && (x + 32 <= width); b++, x += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)&s[x]);
+            __m256i lo = _mm256_unpacklo_epi8(v, zero);
+            __m256i hi = _mm256_unpackhi_epi8(v, zero);
+            s1 = _mm256_add_epi64(s1, _mm256_sad_epu8(v, zero));
+            sq = _mm256_add_epi32(sq, _mm256_add_epi32(_mm256_madd_epi16(lo, lo), _mm256_madd_epi16(hi, hi)));
+        }
+        s2 = _mm256_add_epi64(s2, _mm256_add_epi64(_mm256_unpacklo_epi32(sq, zero), _mm256_unpackhi_epi32(sq, zero)));
+    }
+    _mm256_storeu_si256((__m256i *)lanes, s1);
+    *sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i *)lanes, s2);
+    *sumsq += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    vxMomentsRowU8(&s[x], width - x, sum, sumsq);
+}
+
+static void vxIntegralRowAVX2(vx_uint32 *dst, const vx_uint32 *prev, const vx_uint8 *src, vx_uint32 width)
+{
+    vx_uint32 x, run = 0;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        /* the prefix sums within each half, then the first half carries into the second */
+        __m256i v = VX_LOAD16(&src[x]);
+        __m256i r = _mm256_set1_epi32((vx_int32)run);
+        __m128i lo, hi;
+        v = _mm256_add_epi16(v, _mm256_slli_si256(v, 2));
+        v = _mm256_add_epi16(v, _mm256_slli_si256(v, 4));
+        v = _mm256_add_epi16(v, _mm256_slli_si256(v, 8));
+        lo = _mm256_castsi256_si128(v);
+        hi = _mm_add_epi16(_mm256_extracti128_si256(v, 1), _mm_set1_epi16((vx_int16)_mm_extract_epi16(lo, 7)));
+        _mm256_storeu_si256((__m256i *)&dst[x], _mm256_add_epi32(_mm256_add_epi32(_mm256_cvtepu16_epi32(lo), r),
+                                                                 _mm256_loadu_si256((const __m256i *)&prev[x])));
+        _mm256_storeu_si256((__m256i *)&dst[x + 8], _mm256_add_epi32(_mm256_add_epi32(_mm256_cvtepu16_epi32(hi), r),
+                                                                     _mm256_loadu_si256((const __m256i *)&prev[x + 8])));
+        run += (vx_uint32)_mm_extract_epi16(hi, 7);
+    }
+    for (; x < width; x++)
+    {
+        run += src[x];
+        dst[x] = prev[x] + run;
+    }
+}
+
+/*! \brief Marks the bytes of c which are not above hi, or not below lo. */
+#define VX_NOT_ABOVE(c, hi) _mm256_cmpeq_epi8(_mm256_subs_epu8(c, hi), zero)
+#define VX_NOT_BELOW(c, lo) _mm256_cmpeq_epi8(_mm256_subs_epu8(lo, c), zero)
+
+static void vxFast9RowAVX2(vx_uint8 *scores, const vx_uint8 *src, const vx_int32 *circle, vx_uint8 threshold, vx_uint32 width)
+{
+    const __m256i t = _mm256_set1_epi8((char)threshold);
+    const __m256i zero = _mm256_setzero_si256();
+    vx_uint32 x = 3, i;
+    memset(scores, 0, width);
+    for (; x + 32 + 3 <= width; x += 32)
+    {
+        __m256i p = _mm256_loadu_si256((const __m256i *)&src[x]);
+        __m256i hi = _mm256_adds_epu8(p, t), lo = _mm256_subs_epu8(p, t);
+        __m256i c0 = _mm256_loadu_si256((const __m256i *)(&src[x] + circle[0]));
+        __m256i c4 = _mm256_loadu_si256((const __m256i *)(&src[x] + circle[4]));
+        __m256i c8 = _mm256_loadu_si256((const __m256i *)(&src[x] + circle[8]));
+        __m256i c12 = _mm256_loadu_si256((const __m256i *)(&src[x] + circle[12]));
+        __m256i b0 = VX_NOT_ABOVE(c0, hi), b4 = VX_NOT_ABOVE(c4, hi), b8 = VX_NOT_ABOVE(c8, hi), b12 = VX_NOT_ABOVE(c12, hi);
+        __m256i d0 = VX_NOT_BELOW(c0, lo), d4 = VX_NOT_BELOW(c4, lo), d8 = VX_NOT_BELOW(c8, lo), d12 = VX_NOT_BELOW(c12, lo);
+        /* no two neighboring compass points brighter, nor two darker */
+        __m256i none = _mm256_and_si256(
+            _mm256_and_si256(_mm256_and_si256(_mm256_or_si256(b0, b4), _mm256_or_si256(b4, b8)),
+                             _mm256_and_si256(_mm256_or_si256(b8, b12), _mm256_or_si256(b12, b0))),
+            _mm256_and_si256(_mm256_and_si256(_mm256_or_si256(d0, d4), _mm256_or_si256(d4, d8)),
+                             _mm256_and_si256(_mm256_or_si256(d8, d12), _mm256_or_si256(d12, d0))));
+        vx_uint32 mask = ~(vx_uint32)_mm256_movemask_epi8(none);
+        for (i = 0; mask != 0; i++, mask >>= 1)
+        {
+            if (mask & 1)
+                scores[x + i] = vxFast9Score(&src[x + i], circle, threshold);
+        }
+    }
+    for (; x + 3 < width; x++)
+        scores[x] = vxFast9Score(&src[x], circle, threshold);
+}
+
+/*! \brief Adds the products of two rows and their weights to the sums of 16
+ * pixels, which the multiply-adds leave as pixels 0-3 and 8-11 in a and 4-7 and
+ * 12-15 in b.
+ */
+#define VX_MADD_ROWS(a, b, p, q, w) \
+    a = _mm256_add_epi32(a, _mm256_madd_epi16(_mm256_unpacklo_epi16(p, q), w)); \
+    b = _mm256_add_epi32(b, _mm256_madd_epi16(_mm256_unpackhi_epi16(p, q), w))
+
+static void vxScaleRowAVX2(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 width)
+{
+    const __m256i round = _mm256_set1_epi32(1 << (VX_SCALE_SHIFT_Y - 1));
+    const __m256i zero = _mm256_setzero_si256();
+    vx_uint32 x, k;
+    for (x = 0; x + 32 <= width; x += 32)
+    {
+        __m256i a0 = round, a1 = round, a2 = round, a3 = round;
+        /* the rows go through the multiply-adds in pairs, and the last one with zeros */
+        for (k = 0; k < taps; k += 2)
+        {
+            const vx_int16 *p = &rows[k][x];
+            vx_int16 wq = (k + 1 < taps) ? weights[k + 1] : 0;
+            __m256i w = _mm256_set1_epi32((vx_int32)(((vx_uint32)(vx_uint16)wq << 16) | (vx_uint16)weights[k]));
+            __m256i p0 = _mm256_loadu_si256((const __m256i *)p);
+            __m256i p1 = _mm256_loadu_si256((const __m256i *)(p + 16));
+            __m256i q0 = zero, q1 = zero;
+            if (k + 1 < taps)
+            {
+                q0 = _mm256_loadu_si256((const __m256i *)&rows[k + 1][x]);
+                q1 = _mm256_loadu_si256((const __m256i *)&rows[k + 1][x + 16]);
+            }
+            VX_MADD_ROWS(a0, a1, p0, q0, w);
+            VX_MADD_ROWS(a2, a3, p1, q1, w);
+        }
+        /* the packs within the lanes restore the order of the pixels, but for
+         * the 8 byte quarters of the row, which the permute swaps back */
+        a0 = _mm256_packs_epi32(_mm256_srai_epi32(a0, VX_SCALE_SHIFT_Y), _mm256_srai_epi32(a1, VX_SCALE_SHIFT_Y));
+        a2 = _mm256_packs_epi32(_mm256_srai_epi32(a2, VX_SCALE_SHIFT_Y), _mm256_srai_epi32(a3, VX_SCALE_SHIFT_Y));
+        _mm256_storeu_si256((__m256i *)&dst[x], _mm256_permute4x64_epi64(_mm256_packus_epi16(a0, a2), 0xD8));
+    }
+    vxScaleRowFrom(dst, rows, weights, taps, x, width);
+}
+
+static void vxHalfMeanRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    const __m256i even = _mm256_set1_epi16(0x00FF);
+    const __m256i two = _mm256_set1_epi16(2);
+    vx_uint32 x;
+    for (x = 0; x + 32 <= width; x += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&r0[2 * x]);
+        __m256i b = _mm256_loadu_si256((const __m256i *)&r0[2 * x + 32]);
+        __m256i c = _mm256_loadu_si256((const __m256i *)&r1[2 * x]);
+        __m256i d = _mm256_loadu_si256((const __m256i *)&r1[2 * x + 32]);
+        __m256i lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_and_si256(a, even), _mm256_srli_epi16(a, 8)),
+                                      _mm256_add_epi16(_mm256_and_si256(c, even), _mm256_srli_epi16(c, 8)));
+        __m256i hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_and_si256(b, even), _mm256_srli_epi16(b, 8)),
+                                      _mm256_add_epi16(_mm256_and_si256(d, even), _mm256_srli_epi16(d, 8)));
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, two), 2);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, two), 2);
+        _mm256_storeu_si256((__m256i *)&dst[x], _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+    }
+    vxHalfMeanRow(&dst[x], &r0[2 * x], &r1[2 * x], width - x);
+}
+
+static void vxHalfNearestRowAVX2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x + 32 <= width; x += 32)
+    {
+        __m256i a = _mm256_srli_epi16(_mm256_loadu_si256((const __m256i *)&r1[2 * x]), 8);
+        __m256i b = _mm256_srli_epi16(_mm256_loadu_si256((const __m256i *)&r1[2 * x + 32]), 8);
+        _mm256_storeu_si256((__m256i *)&dst[x], _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+    }
+    vxHalfNearestRow(&dst[x], &r0[2 * x], &r1[2 * x], width - x);
+}
+
+const vx_rows_t vx_rows_avx2 = {
+    "avx2",
+    vxBoxRowAVX2,
+    vxGaussianRowAVX2,
+    vxMedianRowAVX2,
+    vxErodeRowAVX2,
+    vxDilateRowAVX2,
+    /* the pointwise kernels are bound by memory, which SSE2 already keeps busy */
+    &vx_pointwise_sse2,
+    vxMagnitudeRowU8AVX2,
+    vxMagnitudeRowS16AVX2,
+    vxPhaseRowAVX2,
+    {{vxConvolveRowU8U8AVX2, vxConvolveRowU8S16AVX2}, {vxConvolveRowS16U8AVX2, vxConvolveRowS16S16AVX2}},
+    vxMomentsRowU8AVX2,
+    vxMomentsRowU16,
+    vxIntegralRowAVX2,
+    vxFast9RowAVX2,
+    vxScaleRowAVX2,
+    vxHalfMeanRowAVX2,
+    vxHalfNearestRowAVX2,
+};
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The portable row functions, also used for the ends of rows which
+ * are too short for a vector.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+#include <math.h>
+
+static void vxBoxRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + r1[x] + r2[x]);
+    for (x = 1; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + tmp[x] + tmp[x + 1]) / 9);
+}
+
+static void vxGaussianRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + 2 * r1[x] + r2[x]);
+    for (x = 1; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + 2 * tmp[x] + tmp[x + 1]) >> 4);
+}
+
+#define VX_SORT(a,b) if (p[a] > p[b]) { vx_uint8 t = p[a]; p[a] = p[b]; p[b] = t; }
+
+static void vxMedianRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x < width - 1; x++)
+    {
+        vx_uint8 p[9] = {r0[x - 1], r0[x], r0[x + 1],
+                         r1[x - 1], r1[x], r1[x + 1],
+                         r2[x - 1], r2[x], r2[x + 1]};
+        VX_MEDIAN9_NETWORK(VX_SORT)
+        dst[x] = p[4];
+    }
+}
+
+#define VX_MIN3(a,b,c) (((a) < (b)) ? (((a) < (c)) ? (a) : (c)) : (((b) < (c)) ? (b) : (c)))
+#define VX_MAX3(a,b,c) (((a) > (b)) ? (((a) > (c)) ? (a) : (c)) : (((b) > (c)) ? (b) : (c)))
+
+static void vxErodeRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        tmp[x] = VX_MIN3(r0[x], r1[x], r2[x]);
+    for (x = 1; x < width - 1; x++)
+        dst[x] = (vx_uint8)VX_MIN3(tmp[x - 1], tmp[x], tmp[x + 1]);
+}
+
+static void vxDilateRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        tmp[x] = VX_MAX3(r0[x], r1[x], r2[x]);
+    for (x = 1; x < width - 1; x++)
+        dst[x] = (vx_uint8)VX_MAX3(tmp[x - 1], tmp[x], tmp[x + 1]);
+}
+
+#define VX_SATURATE_U8(v)   (((v) < 0) ? 0 : (((v) > UINT8_MAX) ? UINT8_MAX : (v)))
+#define VX_SATURATE_S16(v)  (((v) < INT16_MIN) ? INT16_MIN : (((v) > INT16_MAX) ? INT16_MAX : (v)))
+#define VX_TRUNCATE(v)      (v)
+
+#define VX_ADD(a,b) ((a) + (b))
+#define VX_SUB(a,b) ((a) - (b))
+/* the same float arithmetic as the C model, so the results are identical */
+#define VX_MUL(a,b) ((vx_int32)(scale * (vx_float32)((a) * (b))))
+
+/*! \brief Defines the row function of one operation, format and policy. */
+#define VX_ARITH_ROW(name, TA, TB, TD, OP, CONVERT) \
+static void name(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width) \
+{ \
+    const TA *a = (const TA *)src0; \
+    const TB *b = (const TB *)src1; \
+    TD *d = (TD *)dst; \
+    vx_uint32 x; \
+    for (x = 0; x < width; x++) \
+    { \
+        vx_int32 v = OP((vx_int32)a[x], (vx_int32)b[x]); \
+        d[x] = (TD)CONVERT(v); \
+    } \
+}
+
+/*! \brief Defines the row functions of one operation for every format and policy. */
+#define VX_ARITH_ROWS(name, OP) \
+    VX_ARITH_ROW(name##U8U8U8Truncate,    vx_uint8, vx_uint8, vx_uint8, OP, VX_TRUNCATE) \
+    VX_ARITH_ROW(name##U8U8U8Saturate,    vx_uint8, vx_uint8, vx_uint8, OP, VX_SATURATE_U8) \
+    VX_ARITH_ROW(name##U8U8S16Truncate,   vx_uint8, vx_uint8, vx_int16, OP, VX_TRUNCATE) \
+    VX_ARITH_ROW(name##U8U8S16Saturate,   vx_uint8, vx_uint8, vx_int16, OP, VX_SATURATE_S16) \
+    VX_ARITH_ROW(name##U8S16S16Truncate,  vx_uint8, vx_int16, vx_int16, OP, VX_TRUNCATE) \
+    VX_ARITH_ROW(name##U8S16S16Saturate,  vx_uint8, vx_int16, vx_int16, OP, VX_SATURATE_S16) \
+    VX_ARITH_ROW(name##S16U8S16Truncate,  vx_int16, vx_uint8, vx_int16, OP, VX_TRUNCATE) \
+    VX_ARITH_ROW(name##S16U8S16Saturate,  vx_int16, vx_uint8, vx_int16, OP, VX_SATURATE_S16) \
+    VX_ARITH_ROW(name##S16S16S16Truncate, vx_int16, vx_int16, vx_int16, OP, VX_TRUNCATE) \
+    VX_ARITH_ROW(name##S16S16S16Saturate, vx_int16, vx_int16, vx_int16, OP, VX_SATURATE_S16)
+
+/*! \brief Lists the row functions of one operation in the order of \ref vx_arith_formats_e. */
+#define VX_ARITH_TABLE(name) { \
+    {name##U8U8U8Truncate,    name##U8U8U8Saturate}, \
+    {name##U8U8S16Truncate,   name##U8U8S16Saturate}, \
+    {name##U8S16S16Truncate,  name##U8S16S16Saturate}, \
+    {name##S16U8S16Truncate,  name##S16U8S16Saturate}, \
+    {name##S16S16S16Truncate, name##S16S16S16Saturate}, \
+}
+
+VX_ARITH_ROWS(vxAddRow, VX_ADD)
+VX_ARITH_ROWS(vxSubtractRow, VX_SUB)
+VX_ARITH_ROWS(vxMultiplyRow, VX_MUL)
+
+#define VX_ABSDIFF(a,b) (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+#define VX_AND(a,b) ((a) & (b))
+#define VX_OR(a,b)  ((a) | (b))
+#define VX_XOR(a,b) ((a) ^ (b))
+
+VX_ARITH_ROW(vxAbsDiffRowU8,  vx_uint8,  vx_uint8,  vx_uint8,  VX_ABSDIFF, VX_TRUNCATE)
+VX_ARITH_ROW(vxAbsDiffRowU16, vx_uint16, vx_uint16, vx_uint16, VX_ABSDIFF, VX_TRUNCATE)
+VX_ARITH_ROW(vxAndRow, vx_uint8, vx_uint8, vx_uint8, VX_AND, VX_TRUNCATE)
+VX_ARITH_ROW(vxOrRow,  vx_uint8, vx_uint8, vx_uint8, VX_OR,  VX_TRUNCATE)
+VX_ARITH_ROW(vxXorRow, vx_uint8, vx_uint8, vx_uint8, VX_XOR, VX_TRUNCATE)
+
+static void vxNotRow(vx_uint8 *dst, const vx_uint8 *src, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        dst[x] = (vx_uint8)~src[x];
+}
+
+static void vxThresholdRow(vx_uint8 *dst, const vx_uint8 *src, vx_uint8 lower, vx_uint8 upper, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        dst[x] = ((src[x] >= lower) && (src[x] <= upper)) ? 255 : 0;
+}
+
+static void vxAccumulateRow(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        accum[x] += (vx_uint16)src[x];
+}
+
+static void vxAccumulateWeightedRow(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        accum[x] = (vx_uint16)(((1 - alpha) * accum[x]) + (alpha * (vx_uint16)src[x]));
+}
+
+static void vxAccumulateSquareRow(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        accum[x] += ((vx_uint16)src[x] * (vx_uint16)src[x]);
+}
+
+/*! \brief Computes the integer square root of gx^2 + gy^2. */
+static VX_INLINE vx_uint32 vxMagnitude(vx_int16 gx, vx_int16 gy)
+{
+    vx_uint32 sum = (vx_uint32)(gx * gx) + (vx_uint32)(gy * gy);
+    vx_uint32 m = (vx_uint32)sqrtf((vx_float32)sum);
+    /* the rounding of the sum to a float may leave m one off */
+    if (m * m > sum)
+        m--;
+    else if ((m + 1) * (m + 1) <= sum)
+        m++;
+    return m;
+}
+
+void vxMagnitudeRowU8(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        vx_uint32 m = vxMagnitude(gx[x], gy[x]) / 4;
+        d[x] = (vx_uint8)(m > UINT8_MAX ? UINT8_MAX : m);
+    }
+}
+
+void vxMagnitudeRowS16(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_int16 *d = (vx_int16 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        vx_uint32 m = vxMagnitude(gx[x], gy[x]);
+        d[x] = (vx_int16)(m > INT16_MAX ? INT16_MAX : m);
+    }
+}
+
+vx_uint8 vxPhaseExact(vx_int16 gx, vx_int16 gy)
+{
+    /* -pi to pi */
+    vx_float64 arct = atan2((vx_float64)gy, (vx_float64)gx);
+    /* 0 to tau */
+    vx_float64 norm = (arct < 0.0) ? VX_TAU + arct : arct;
+    /* 0 to 255 */
+    return (vx_uint8)((norm * 255.0) / VX_TAU);
+}
+
+void vxPhaseRow(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        vx_float32 ax = (vx_float32)(gx[x] < 0 ? -gx[x] : gx[x]);
+        vx_float32 ay = (vx_float32)(gy[x] < 0 ? -gy[x] : gy[x]);
+        vx_float32 t = (ax < ay) ? ax / ay : (ax > 0.0f ? ay / ax : 0.0f);
+        vx_float32 s = t * t;
+        vx_float32 a = t * (VX_ATAN_C1 + s * (VX_ATAN_C3 + s * (VX_ATAN_C5 + s * (VX_ATAN_C7 + s * (VX_ATAN_C9 + s * VX_ATAN_C11)))));
+        vx_float32 q;
+        vx_int32 i;
+        /* unfold the octant to the angle from the positive x axis, 0 to pi */
+        if (ax < ay)
+            a = (vx_float32)(VX_TAU / 4) - a;
+        if (gx[x] < 0)
+            a = (vx_float32)(VX_TAU / 2) - a;
+        q = a * (vx_float32)(255.0 / VX_TAU);
+        if (gy[x] < 0)
+            q = 255.0f - q;
+        i = (vx_int32)q;
+        if ((q - (vx_float32)i < VX_PHASE_EPSILON) || (q - (vx_float32)i > 1.0f - VX_PHASE_EPSILON))
+            d[x] = vxPhaseExact(gx[x], gy[x]);
+        else
+            d[x] = (vx_uint8)i;
+    }
+}
+
+/*! \brief Defines a convolution row from inputs of type ST to outputs of type
+ * DT, saturated to [MIN, MAX].
+ */
+#define VX_CONVOLVE_ROW(name, ST, DT, MIN, MAX) \
+void name(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width) \
+{ \
+    DT *d = (DT *)dst; \
+    vx_uint32 x, k; \
+    for (x = 0; x < width; x++) \
+    { \
+        vx_int32 sum = 0; \
+        for (k = 0; k < count; k++) \
+            sum += coeffs[k] * ((const ST *)src[k])[x]; \
+        sum /= (vx_int32)(1 << shift); \
+        d[x] = (DT)(sum < MIN ? MIN : (sum > MAX ? MAX : sum)); \
+    } \
+}
+
+VX_CONVOLVE_ROW(vxConvolveRowU8U8, vx_uint8, vx_uint8, 0, UINT8_MAX)
+VX_CONVOLVE_ROW(vxConvolveRowU8S16, vx_uint8, vx_int16, INT16_MIN, INT16_MAX)
+VX_CONVOLVE_ROW(vxConvolveRowS16U8, vx_int16, vx_uint8, 0, UINT8_MAX)
+VX_CONVOLVE_ROW(vxConvolveRowS16S16, vx_int16, vx_int16, INT16_MIN, INT16_MAX)
+
+void vxMomentsRowU8(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq)
+{
+    const vx_uint8 *s = (const vx_uint8 *)src;
+    vx_uint64 s1 = 0, s2 = 0;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        s1 += s[x];
+        s2 += (vx_uint32)s[x] * s[x];
+    }
+    *sum += s1;
+    *sumsq += s2;
+}
+
+void vxMomentsRowU16(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq)
+{
+    const vx_uint16 *s = (const vx_uint16 *)src;
+    vx_uint64 s1 = 0, s2 = 0;
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+    {
+        s1 += s[x];
+        s2 += (vx_uint64)((vx_uint32)s[x] * s[x]);
+    }
+    *sum += s1;
+    *sumsq += s2;
+}
+
+void vxIntegralRow(vx_uint32 *dst, const vx_uint32 *prev, const vx_uint8 *src, vx_uint32 width)
+{
+    vx_uint32 x, run = 0;
+    for (x = 0; x < width; x++)
+    {
+        run += src[x];
+        dst[x] = prev[x] + run;
+    }
+}
+
+/*! \brief Tells whether a 16 bit mask of the circle has 9 contiguous bits, wrapping around. */
+static vx_bool vxFast9Arc(vx_uint32 mask)
+{
+    vx_uint32 m = mask | (mask << 16);
+    vx_uint32 a = m & (m >> 1);
+    a &= a >> 2;
+    a &= a >> 4;
+    a &= m >> 8;
+    return (a != 0) ? vx_true_e : vx_false_e;
+}
+
+/*! \brief Computes the score of a pixel, or zero when it is not a corner.
+ * \details The score is the largest difference which all the pixels of some
+ * arc of 9 exceed or reach, in the same direction, so a corner at a threshold
+ * t always scores above t.
+ */
+vx_uint8 vxFast9Score(const vx_uint8 *ptr, const vx_int32 *circle, vx_uint8 threshold)
+{
+    vx_int32 p = ptr[0], t = threshold, diff[16], best = 0, i, j;
+    vx_uint32 bright = 0, dark = 0;
+
+    /* the high speed test: an arc of 9 covers two neighboring compass points */
+    for (i = 0; i < 16; i += 4)
+    {
+        vx_int32 d = ptr[circle[i]] - p;
+        bright |= (vx_uint32)(d > t) << (i / 4);
+        dark |= (vx_uint32)(d < -t) << (i / 4);
+    }
+    if (((bright & ((bright >> 1) | (bright << 3))) | (dark & ((dark >> 1) | (dark << 3)))) == 0)
+        return 0;
+    bright = 0;
+    dark = 0;
+    for (i = 0; i < 16; i++)
+    {
+        diff[i] = ptr[circle[i]] - p;
+        bright |= (vx_uint32)(diff[i] > t) << i;
+        dark |= (vx_uint32)(diff[i] < -t) << i;
+    }
+    if (!vxFast9Arc(bright) && !vxFast9Arc(dark))
+        return 0;
+    for (i = 0; i < 16; i++)
+    {
+        vx_int32 lo = 255, hi = -255;
+        for (j = 0; j < 9; j++)
+        {
+            vx_int32 d = diff[(i + j) & 15];
+            lo = d < lo ? d : lo;
+            hi = d > hi ? d : hi;
+        }
+        best = lo > best ? lo : best;
+        best = -hi > best ? -hi : best;
+    }
+    return (vx_uint8)best;
+}
+
+void vxFast9Row(vx_uint8 *scores, const vx_uint8 *src, const vx_int32 *circle, vx_uint8 threshold, vx_uint32 width)
+{
+    vx_uint32 x;
+    memset(scores, 0, width);
+    for (x = 3; x + 3 < width; x++)
+        scores[x] = vxFast9Score(&src[x], circle, threshold);
+}
+
+void vxScaleRowFrom(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 x, vx_uint32 width)
+{
+    vx_uint32 k;
+    /* the weights add up to one, so the sums never pass 255 */
+    for (; x < width; x++)
+    {
+        vx_int32 sum = 1 << (VX_SCALE_SHIFT_Y - 1);
+        for (k = 0; k < taps; k++)
+            sum += rows[k][x] * weights[k];
+        dst[x] = (vx_uint8)(sum >> VX_SCALE_SHIFT_Y);
+    }
+}
+
+void vxScaleRow(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 width)
+{
+    vxScaleRowFrom(dst, rows, weights, taps, 0, width);
+}
+
+void vxHalfMeanRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        dst[x] = (vx_uint8)((r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1] + 2) >> 2);
+}
+
+void vxHalfNearestRow(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x < width; x++)
+        dst[x] = r1[2 * x + 1];
+}
+
+const vx_pointwise_rows_t vx_pointwise_c = {
+    VX_ARITH_TABLE(vxAddRow),
+    VX_ARITH_TABLE(vxSubtractRow),
+    VX_ARITH_TABLE(vxMultiplyRow),
+    vxAbsDiffRowU8,
+    vxAbsDiffRowU16,
+    vxAndRow,
+    vxOrRow,
+    vxXorRow,
+    vxNotRow,
+    vxThresholdRow,
+    vxAccumulateRow,
+    vxAccumulateWeightedRow,
+    vxAccumulateSquareRow,
+};
+
+const vx_rows_t vx_rows_c = {
+    "c",
+    vxBoxRow,
+    vxGaussianRow,
+    vxMedianRow,
+    vxErodeRow,
+    vxDilateRow,
+    &vx_pointwise_c,
+    vxMagnitudeRowU8,
+    vxMagnitudeRowS16,
+    vxPhaseRow,
+    {{vxConvolveRowU8U8, vxConvolveRowU8S16}, {vxConvolveRowS16U8, vxConvolveRowS16S16}},
+    vxMomentsRowU8,
+    vxMomentsRowU16,
+    vxIntegralRow,
+    vxFast9Row,
+    vxScaleRow,
+    vxHalfMeanRow,
+    vxHalfNearestRow,
+};
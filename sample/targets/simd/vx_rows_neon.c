@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The NEON row functions, 16 pixels at a time.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+#if defined(VX_SIMD_NEON)
+
+#include <arm_neon.h>
+
+static void vxBoxRowNEON(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    /* the sums of the columns */
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        uint16x8_t s = vaddw_u8(vaddl_u8(vld1_u8(&r0[x]), vld1_u8(&r1[x])), vld1_u8(&r2[x]));
+        vst1q_u16(&tmp[x], s);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + r1[x] + r2[x]);
+    /* the sums of three columns, divided by 9 */
+    for (x = 1; x + 8 <= width - 1; x += 8)
+    {
+        uint16x8_t s = vaddq_u16(vaddq_u16(vld1q_u16(&tmp[x - 1]), vld1q_u16(&tmp[x])), vld1q_u16(&tmp[x + 1]));
+        uint16x4_t lo = vshrn_n_u32(vmull_n_u16(vget_low_u16(s), VX_DIV9_Q16), 16);
+        uint16x4_t hi = vshrn_n_u32(vmull_n_u16(vget_high_u16(s), VX_DIV9_Q16), 16);
+        vst1_u8(&dst[x], vmovn_u16(vcombine_u16(lo, hi)));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + tmp[x] + tmp[x + 1]) / 9);
+}
+
+static void vxGaussianRowNEON(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    /* the columns weighted 1 2 1 */
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        uint16x8_t s = vaddq_u16(vaddl_u8(vld1_u8(&r0[x]), vld1_u8(&r2[x])), vshll_n_u8(vld1_u8(&r1[x]), 1));
+        vst1q_u16(&tmp[x], s);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + 2 * r1[x] + r2[x]);
+    /* the rows weighted 1 2 1, divided by 16 */
+    for (x = 1; x + 8 <= width - 1; x += 8)
+    {
+        uint16x8_t s = vaddq_u16(vaddq_u16(vld1q_u16(&tmp[x - 1]), vld1q_u16(&tmp[x + 1])), vshlq_n_u16(vld1q_u16(&tmp[x]), 1));
+        vst1_u8(&dst[x], vshrn_n_u16(s, 4));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + 2 * tmp[x] + tmp[x + 1]) >> 4);
+}
+
+#define VX_SORT(a,b) { uint8x16_t t = vminq_u8(p[a], p[b]); p[b] = vmaxq_u8(p[a], p[b]); p[a] = t; }
+
+static void vxMedianRowNEON(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        uint8x16_t p[9];
+        p[0] = vld1q_u8(&r0[x - 1]);
+        p[1] = vld1q_u8(&r0[x]);
+        p[2] = vld1q_u8(&r0[x + 1]);
+        p[3] = vld1q_u8(&r1[x - 1]);
+        p[4] = vld1q_u8(&r1[x]);
+        p[5] = vld1q_u8(&r1[x + 1]);
+        p[6] = vld1q_u8(&r2[x - 1]);
+        p[7] = vld1q_u8(&r2[x]);
+        p[8] = vld1q_u8(&r2[x + 1]);
+        VX_MEDIAN9_NETWORK(VX_SORT)
+        vst1q_u8(&dst[x], p[4]);
+    }
+    vx_rows_c.median(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+/*! \brief Loads the minimum (or maximum) of a column of three pixels. */
+#define VX_COLUMN(op, x) op(op(vld1q_u8(&r0[x]), vld1q_u8(&r1[x])), vld1q_u8(&r2[x]))
+
+static void vxErodeRowNEON(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        uint8x16_t m = vminq_u8(vminq_u8(VX_COLUMN(vminq_u8, x - 1), VX_COLUMN(vminq_u8, x)), VX_COLUMN(vminq_u8, x + 1));
+        vst1q_u8(&dst[x], m);
+    }
+    vx_rows_c.erode(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+static void vxDilateRowNEON(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        uint8x16_t m = vmaxq_u8(vmaxq_u8(VX_COLUMN(vmaxq_u8, x - 1), VX_COLUMN(vmaxq_u8, x)), VX_COLUMN(vmaxq_u8, x + 1));
+        vst1q_u8(&dst[x], m);
+    }
+    vx_rows_c.dilate(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+const vx_rows_t vx_rows_neon = {
+    "neon",
+    vxBoxRowNEON,
+    vxGaussianRowNEON,
+    vxMedianRowNEON,
+    vxErodeRowNEON,
+    vxDilateRowNEON,
+    /* the pointwise rows are simple enough for the compiler to vectorize */
+    &vx_pointwise_c,
+    vxMagnitudeRowU8,
+    vxMagnitudeRowS16,
+    vxPhaseRow,
+    {{vxConvolveRowU8U8, vxConvolveRowU8S16}, {vxConvolveRowS16U8, vxConvolveRowS16S16}},
+    vxMomentsRowU8,
+    vxMomentsRowU16,
+    vxIntegralRow,
+    vxFast9Row,
+    vxScaleRow,
+    vxHalfMeanRow,
+    vxHalfNearestRow,
+};
+
+#endif
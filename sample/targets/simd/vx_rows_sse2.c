@@ -0,0 +1,840 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The SSE2 row functions, 16 pixels at a time.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+#if defined(VX_SIMD_X86)
+
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__SSE2__)
+#pragma GCC target("sse2")
+#endif
+#include <emmintrin.h>
+
+static void vxBoxRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div9 = _mm_set1_epi16(VX_DIV9_Q16);
+    vx_uint32 x;
+    /* the sums of the columns */
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&r0[x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&r1[x]);
+        __m128i c = _mm_loadu_si128((const __m128i *)&r2[x]);
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)), _mm_unpacklo_epi8(c, zero));
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)), _mm_unpackhi_epi8(c, zero));
+        _mm_storeu_si128((__m128i *)&tmp[x], lo);
+        _mm_storeu_si128((__m128i *)&tmp[x + 8], hi);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + r1[x] + r2[x]);
+    /* the sums of three columns, divided by 9 */
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_loadu_si128((const __m128i *)&tmp[x - 1]),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x])),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x + 1]));
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_loadu_si128((const __m128i *)&tmp[x + 7]),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x + 8])),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x + 9]));
+        lo = _mm_mulhi_epu16(lo, div9);
+        hi = _mm_mulhi_epu16(hi, div9);
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(lo, hi));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + tmp[x] + tmp[x + 1]) / 9);
+}
+
+static void vxGaussianRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    const __m128i zero = _mm_setzero_si128();
+    vx_uint32 x;
+    /* the columns weighted 1 2 1 */
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&r0[x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&r1[x]);
+        __m128i c = _mm_loadu_si128((const __m128i *)&r2[x]);
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(c, zero)),
+                                   _mm_slli_epi16(_mm_unpacklo_epi8(b, zero), 1));
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(c, zero)),
+                                   _mm_slli_epi16(_mm_unpackhi_epi8(b, zero), 1));
+        _mm_storeu_si128((__m128i *)&tmp[x], lo);
+        _mm_storeu_si128((__m128i *)&tmp[x + 8], hi);
+    }
+    for (; x < width; x++)
+        tmp[x] = (vx_uint16)(r0[x] + 2 * r1[x] + r2[x]);
+    /* the rows weighted 1 2 1, divided by 16 */
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_loadu_si128((const __m128i *)&tmp[x - 1]),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x + 1])),
+                                   _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&tmp[x]), 1));
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_loadu_si128((const __m128i *)&tmp[x + 7]),
+                                                 _mm_loadu_si128((const __m128i *)&tmp[x + 9])),
+                                   _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&tmp[x + 8]), 1));
+        lo = _mm_srli_epi16(lo, 4);
+        hi = _mm_srli_epi16(hi, 4);
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(lo, hi));
+    }
+    for (; x < width - 1; x++)
+        dst[x] = (vx_uint8)((tmp[x - 1] + 2 * tmp[x] + tmp[x + 1]) >> 4);
+}
+
+#define VX_SORT(a,b) { __m128i t = _mm_min_epu8(p[a], p[b]); p[b] = _mm_max_epu8(p[a], p[b]); p[a] = t; }
+
+static void vxMedianRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m128i p[9];
+        p[0] = _mm_loadu_si128((const __m128i *)&r0[x - 1]);
+        p[1] = _mm_loadu_si128((const __m128i *)&r0[x]);
+        p[2] = _mm_loadu_si128((const __m128i *)&r0[x + 1]);
+        p[3] = _mm_loadu_si128((const __m128i *)&r1[x - 1]);
+        p[4] = _mm_loadu_si128((const __m128i *)&r1[x]);
+        p[5] = _mm_loadu_si128((const __m128i *)&r1[x + 1]);
+        p[6] = _mm_loadu_si128((const __m128i *)&r2[x - 1]);
+        p[7] = _mm_loadu_si128((const __m128i *)&r2[x]);
+        p[8] = _mm_loadu_si128((const __m128i *)&r2[x + 1]);
+        VX_MEDIAN9_NETWORK(VX_SORT)
+        _mm_storeu_si128((__m128i *)&dst[x], p[4]);
+    }
+    vx_rows_c.median(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+/*! \brief Loads the minimum (or maximum) of a column of three pixels. */
+#define VX_COLUMN(op, x) op(op(_mm_loadu_si128((const __m128i *)&r0[x]), \
+                               _mm_loadu_si128((const __m128i *)&r1[x])), \
+                               _mm_loadu_si128((const __m128i *)&r2[x]))
+
+static void vxErodeRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m128i m = _mm_min_epu8(_mm_min_epu8(VX_COLUMN(_mm_min_epu8, x - 1), VX_COLUMN(_mm_min_epu8, x)), VX_COLUMN(_mm_min_epu8, x + 1));
+        _mm_storeu_si128((__m128i *)&dst[x], m);
+    }
+    vx_rows_c.erode(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+static void vxDilateRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint16 *tmp)
+{
+    vx_uint32 x;
+    for (x = 1; x + 16 <= width - 1; x += 16)
+    {
+        __m128i m = _mm_max_epu8(_mm_max_epu8(VX_COLUMN(_mm_max_epu8, x - 1), VX_COLUMN(_mm_max_epu8, x)), VX_COLUMN(_mm_max_epu8, x + 1));
+        _mm_storeu_si128((__m128i *)&dst[x], m);
+    }
+    vx_rows_c.dilate(&dst[x - 1], &r0[x - 1], &r1[x - 1], &r2[x - 1], width - x + 1, tmp);
+}
+
+/*! \brief Loads 16 pixels of a U8 row as two vectors of 16 bit values. */
+#define VX_LOAD_U8(v, p, x) { \
+    __m128i t = _mm_loadu_si128((const __m128i *)((const vx_uint8 *)(p) + (x))); \
+    v[0] = _mm_unpacklo_epi8(t, _mm_setzero_si128()); \
+    v[1] = _mm_unpackhi_epi8(t, _mm_setzero_si128()); \
+}
+
+/*! \brief Loads 16 pixels of a S16 row as two vectors. */
+#define VX_LOAD_S16(v, p, x) { \
+    v[0] = _mm_loadu_si128((const __m128i *)((const vx_int16 *)(p) + (x))); \
+    v[1] = _mm_loadu_si128((const __m128i *)((const vx_int16 *)(p) + (x) + 8)); \
+}
+
+/* Add and Subtract of U8 images into a U8 image work on bytes directly. */
+#define VX_ARITH_U8_ROW(name, OP, tail) \
+static void name(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width) \
+{ \
+    const vx_uint8 *a = (const vx_uint8 *)src0; \
+    const vx_uint8 *b = (const vx_uint8 *)src1; \
+    vx_uint8 *d = (vx_uint8 *)dst; \
+    vx_uint32 x; \
+    for (x = 0; x + 16 <= width; x += 16) \
+    { \
+        __m128i r = OP(_mm_loadu_si128((const __m128i *)&a[x]), _mm_loadu_si128((const __m128i *)&b[x])); \
+        _mm_storeu_si128((__m128i *)&d[x], r); \
+    } \
+    tail(&d[x], &a[x], &b[x], scale, width - x); \
+}
+
+VX_ARITH_U8_ROW(vxAddRowU8U8U8TruncateSSE2, _mm_add_epi8, vx_pointwise_c.add[VX_ARITH_U8_U8_U8][0])
+VX_ARITH_U8_ROW(vxAddRowU8U8U8SaturateSSE2, _mm_adds_epu8, vx_pointwise_c.add[VX_ARITH_U8_U8_U8][1])
+VX_ARITH_U8_ROW(vxSubtractRowU8U8U8TruncateSSE2, _mm_sub_epi8, vx_pointwise_c.subtract[VX_ARITH_U8_U8_U8][0])
+VX_ARITH_U8_ROW(vxSubtractRowU8U8U8SaturateSSE2, _mm_subs_epu8, vx_pointwise_c.subtract[VX_ARITH_U8_U8_U8][1])
+
+static VX_INLINE __m128i vxAbsDiffU8(__m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+}
+
+static VX_INLINE __m128i vxAbsDiffU16(__m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_subs_epu16(a, b), _mm_subs_epu16(b, a));
+}
+
+VX_ARITH_U8_ROW(vxAbsDiffRowU8SSE2, vxAbsDiffU8, vx_pointwise_c.absdiff_u8)
+VX_ARITH_U8_ROW(vxAndRowSSE2, _mm_and_si128, vx_pointwise_c.and_u8)
+VX_ARITH_U8_ROW(vxOrRowSSE2, _mm_or_si128, vx_pointwise_c.or_u8)
+VX_ARITH_U8_ROW(vxXorRowSSE2, _mm_xor_si128, vx_pointwise_c.xor_u8)
+
+static void vxAbsDiffRowU16SSE2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    const vx_uint16 *a = (const vx_uint16 *)src0;
+    const vx_uint16 *b = (const vx_uint16 *)src1;
+    vx_uint16 *d = (vx_uint16 *)dst;
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i r = vxAbsDiffU16(_mm_loadu_si128((const __m128i *)&a[x]), _mm_loadu_si128((const __m128i *)&b[x]));
+        _mm_storeu_si128((__m128i *)&d[x], r);
+    }
+    vx_pointwise_c.absdiff_u16(&d[x], &a[x], &b[x], scale, width - x);
+}
+
+/*
+ * The other formats of Add and Subtract have a S16 output, so they are done
+ * on 16 bit values, where the policy is just the choice of instruction.
+ */
+#define VX_ARITH_S16_ROW(name, TA, LOADA, TB, LOADB, OP, tail) \
+static void name(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width) \
+{ \
+    const TA *a = (const TA *)src0; \
+    const TB *b = (const TB *)src1; \
+    vx_int16 *d = (vx_int16 *)dst; \
+    vx_uint32 x; \
+    for (x = 0; x + 16 <= width; x += 16) \
+    { \
+        __m128i va[2], vb[2]; \
+        LOADA(va, a, x); \
+        LOADB(vb, b, x); \
+        _mm_storeu_si128((__m128i *)&d[x], OP(va[0], vb[0])); \
+        _mm_storeu_si128((__m128i *)&d[x + 8], OP(va[1], vb[1])); \
+    } \
+    tail(&d[x], &a[x], &b[x], scale, width - x); \
+}
+
+#define VX_ARITH_S16_ROWS(name, fmt, TA, LOADA, TB, LOADB) \
+    VX_ARITH_S16_ROW(vxAddRow##name##TruncateSSE2, TA, LOADA, TB, LOADB, _mm_add_epi16, vx_pointwise_c.add[fmt][0]) \
+    VX_ARITH_S16_ROW(vxAddRow##name##SaturateSSE2, TA, LOADA, TB, LOADB, _mm_adds_epi16, vx_pointwise_c.add[fmt][1]) \
+    VX_ARITH_S16_ROW(vxSubtractRow##name##TruncateSSE2, TA, LOADA, TB, LOADB, _mm_sub_epi16, vx_pointwise_c.subtract[fmt][0]) \
+    VX_ARITH_S16_ROW(vxSubtractRow##name##SaturateSSE2, TA, LOADA, TB, LOADB, _mm_subs_epi16, vx_pointwise_c.subtract[fmt][1])
+
+VX_ARITH_S16_ROWS(U8U8S16,   VX_ARITH_U8_U8_S16,   vx_uint8, VX_LOAD_U8,  vx_uint8, VX_LOAD_U8)
+VX_ARITH_S16_ROWS(U8S16S16,  VX_ARITH_U8_S16_S16,  vx_uint8, VX_LOAD_U8,  vx_int16, VX_LOAD_S16)
+VX_ARITH_S16_ROWS(S16U8S16,  VX_ARITH_S16_U8_S16,  vx_int16, VX_LOAD_S16, vx_uint8, VX_LOAD_U8)
+VX_ARITH_S16_ROWS(S16S16S16, VX_ARITH_S16_S16_S16, vx_int16, VX_LOAD_S16, vx_int16, VX_LOAD_S16)
+
+/*! \brief Multiplies 8 pairs of 16 bit values into 32 bits and scales them
+ * in single precision, truncating like the C conversion does.
+ */
+static VX_INLINE void vxScaledProducts(__m128i a, __m128i b, __m128 scale, __m128i r[2])
+{
+    __m128i lo = _mm_mullo_epi16(a, b);
+    __m128i hi = _mm_mulhi_epi16(a, b);
+    r[0] = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, hi)), scale));
+    r[1] = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, hi)), scale));
+}
+
+/*! \brief Keeps the low 16 bits of each 32 bit value, sign extended. */
+#define VX_LOW16(v) _mm_srai_epi32(_mm_slli_epi32(v, 16), 16)
+
+/*! \brief Stores 16 values of 32 bits as U8, wrapping around. */
+#define VX_STORE_U8_TRUNCATE(d, x, r) { \
+    const __m128i mask = _mm_set1_epi32(0xFF); \
+    __m128i lo = _mm_packs_epi32(_mm_and_si128(r[0], mask), _mm_and_si128(r[1], mask)); \
+    __m128i hi = _mm_packs_epi32(_mm_and_si128(r[2], mask), _mm_and_si128(r[3], mask)); \
+    _mm_storeu_si128((__m128i *)((vx_uint8 *)(d) + (x)), _mm_packus_epi16(lo, hi)); \
+}
+
+/*! \brief Stores 16 values of 32 bits as U8, clamped to [0, 255]. */
+#define VX_STORE_U8_SATURATE(d, x, r) { \
+    __m128i lo = _mm_packs_epi32(r[0], r[1]); \
+    __m128i hi = _mm_packs_epi32(r[2], r[3]); \
+    _mm_storeu_si128((__m128i *)((vx_uint8 *)(d) + (x)), _mm_packus_epi16(lo, hi)); \
+}
+
+/*! \brief Stores 16 values of 32 bits as S16, wrapping around. */
+#define VX_STORE_S16_TRUNCATE(d, x, r) { \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(d) + (x)), _mm_packs_epi32(VX_LOW16(r[0]), VX_LOW16(r[1]))); \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(d) + (x) + 8), _mm_packs_epi32(VX_LOW16(r[2]), VX_LOW16(r[3]))); \
+}
+
+/*! \brief Stores 16 values of 32 bits as S16, clamped to the range of S16. */
+#define VX_STORE_S16_SATURATE(d, x, r) { \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(d) + (x)), _mm_packs_epi32(r[0], r[1])); \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(d) + (x) + 8), _mm_packs_epi32(r[2], r[3])); \
+}
+
+#define VX_MULTIPLY_ROW(name, TA, LOADA, TB, LOADB, TD, STORE, tail) \
+static void name(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width) \
+{ \
+    const TA *a = (const TA *)src0; \
+    const TB *b = (const TB *)src1; \
+    TD *d = (TD *)dst; \
+    const __m128 s = _mm_set1_ps(scale); \
+    vx_uint32 x; \
+    for (x = 0; x + 16 <= width; x += 16) \
+    { \
+        __m128i va[2], vb[2], r[4]; \
+        LOADA(va, a, x); \
+        LOADB(vb, b, x); \
+        vxScaledProducts(va[0], vb[0], s, &r[0]); \
+        vxScaledProducts(va[1], vb[1], s, &r[2]); \
+        STORE(d, x, r); \
+    } \
+    tail(&d[x], &a[x], &b[x], scale, width - x); \
+}
+
+#define VX_MULTIPLY_ROWS(name, fmt, TA, LOADA, TB, LOADB, TD, OUT) \
+    VX_MULTIPLY_ROW(vxMultiplyRow##name##TruncateSSE2, TA, LOADA, TB, LOADB, TD, VX_STORE_##OUT##_TRUNCATE, vx_pointwise_c.multiply[fmt][0]) \
+    VX_MULTIPLY_ROW(vxMultiplyRow##name##SaturateSSE2, TA, LOADA, TB, LOADB, TD, VX_STORE_##OUT##_SATURATE, vx_pointwise_c.multiply[fmt][1])
+
+VX_MULTIPLY_ROWS(U8U8U8,    VX_ARITH_U8_U8_U8,    vx_uint8, VX_LOAD_U8,  vx_uint8, VX_LOAD_U8,  vx_uint8, U8)
+VX_MULTIPLY_ROWS(U8U8S16,   VX_ARITH_U8_U8_S16,   vx_uint8, VX_LOAD_U8,  vx_uint8, VX_LOAD_U8,  vx_int16, S16)
+VX_MULTIPLY_ROWS(U8S16S16,  VX_ARITH_U8_S16_S16,  vx_uint8, VX_LOAD_U8,  vx_int16, VX_LOAD_S16, vx_int16, S16)
+VX_MULTIPLY_ROWS(S16U8S16,  VX_ARITH_S16_U8_S16,  vx_int16, VX_LOAD_S16, vx_uint8, VX_LOAD_U8,  vx_int16, S16)
+VX_MULTIPLY_ROWS(S16S16S16, VX_ARITH_S16_S16_S16, vx_int16, VX_LOAD_S16, vx_int16, VX_LOAD_S16, vx_int16, S16)
+
+#define VX_ARITH_TABLE_SSE2(name) { \
+    {name##U8U8U8TruncateSSE2,    name##U8U8U8SaturateSSE2}, \
+    {name##U8U8S16TruncateSSE2,   name##U8U8S16SaturateSSE2}, \
+    {name##U8S16S16TruncateSSE2,  name##U8S16S16SaturateSSE2}, \
+    {name##S16U8S16TruncateSSE2,  name##S16U8S16SaturateSSE2}, \
+    {name##S16S16S16TruncateSSE2, name##S16S16S16SaturateSSE2}, \
+}
+
+static void vxNotRowSSE2(vx_uint8 *dst, const vx_uint8 *src, vx_uint32 width)
+{
+    const __m128i ones = _mm_set1_epi8(-1);
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_xor_si128(_mm_loadu_si128((const __m128i *)&src[x]), ones));
+    vx_pointwise_c.not_u8(&dst[x], &src[x], width - x);
+}
+
+static void vxThresholdRowSSE2(vx_uint8 *dst, const vx_uint8 *src, vx_uint8 lower, vx_uint8 upper, vx_uint32 width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_set1_epi8((char)lower);
+    const __m128i hi = _mm_set1_epi8((char)upper);
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[x]);
+        /* the unsigned differences are zero only where the value is within the bound */
+        __m128i above = _mm_cmpeq_epi8(_mm_subs_epu8(lo, s), zero);
+        __m128i below = _mm_cmpeq_epi8(_mm_subs_epu8(s, hi), zero);
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_and_si128(above, below));
+    }
+    vx_pointwise_c.threshold(&dst[x], &src[x], lower, upper, width - x);
+}
+
+static void vxAccumulateRowSSE2(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i v[2];
+        VX_LOAD_U8(v, src, x);
+        _mm_storeu_si128((__m128i *)&accum[x], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&accum[x]), v[0]));
+        _mm_storeu_si128((__m128i *)&accum[x + 8], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&accum[x + 8]), v[1]));
+    }
+    vx_pointwise_c.accumulate(&accum[x], &src[x], alpha, width - x);
+}
+
+static void vxAccumulateSquareRowSSE2(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i v[2];
+        VX_LOAD_U8(v, src, x);
+        v[0] = _mm_mullo_epi16(v[0], v[0]);
+        v[1] = _mm_mullo_epi16(v[1], v[1]);
+        _mm_storeu_si128((__m128i *)&accum[x], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&accum[x]), v[0]));
+        _mm_storeu_si128((__m128i *)&accum[x + 8], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&accum[x + 8]), v[1]));
+    }
+    vx_pointwise_c.accumulate_square(&accum[x], &src[x], alpha, width - x);
+}
+
+/*! \brief Weighs 4 accumulator and input values as the C expression does. */
+static VX_INLINE __m128i vxWeighted(__m128i acc, __m128i in, __m128 beta, __m128 alpha)
+{
+    __m128 r = _mm_add_ps(_mm_mul_ps(beta, _mm_cvtepi32_ps(acc)), _mm_mul_ps(alpha, _mm_cvtepi32_ps(in)));
+    return _mm_cvttps_epi32(r);
+}
+
+static void vxAccumulateWeightedRowSSE2(vx_uint16 *accum, const vx_uint8 *src, vx_float32 alpha, vx_uint32 width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+    const __m128 a = _mm_set1_ps(alpha);
+    const __m128 b = _mm_set1_ps(1 - alpha);
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i acc = _mm_loadu_si128((const __m128i *)&accum[x]);
+        __m128i in = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&src[x]), zero);
+        __m128i lo = vxWeighted(_mm_unpacklo_epi16(acc, zero), _mm_unpacklo_epi16(in, zero), b, a);
+        __m128i hi = vxWeighted(_mm_unpackhi_epi16(acc, zero), _mm_unpackhi_epi16(in, zero), b, a);
+        /* there is no unsigned pack in SSE2, so pack around the middle of the range */
+        __m128i r = _mm_packs_epi32(_mm_sub_epi32(lo, bias32), _mm_sub_epi32(hi, bias32));
+        _mm_storeu_si128((__m128i *)&accum[x], _mm_xor_si128(r, bias16));
+    }
+    vx_pointwise_c.accumulate_weighted(&accum[x], &src[x], alpha, width - x);
+}
+
+const vx_pointwise_rows_t vx_pointwise_sse2 = {
+    VX_ARITH_TABLE_SSE2(vxAddRow),
+    VX_ARITH_TABLE_SSE2(vxSubtractRow),
+    VX_ARITH_TABLE_SSE2(vxMultiplyRow),
+    vxAbsDiffRowU8SSE2,
+    vxAbsDiffRowU16SSE2,
+    vxAndRowSSE2,
+    vxOrRowSSE2,
+    vxXorRowSSE2,
+    vxNotRowSSE2,
+    vxThresholdRowSSE2,
+    vxAccumulateRowSSE2,
+    vxAccumulateWeightedRowSSE2,
+    vxAccumulateSquareRowSSE2,
+};
+
+/*! \brief Squares four unsigned values below 2^16, keeping the low 32 bits. */
+static VX_INLINE __m128i vxSquareSSE2(__m128i m)
+{
+    __m128i odd = _mm_srli_epi64(m, 32);
+    __m128i even = _mm_mul_epu32(m, m);
+    odd = _mm_mul_epu32(odd, odd);
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+}
+
+/*! \brief Computes the integer square roots of four unsigned sums of squares
+ * of 16 bit gradients, which reach 2^31.
+ */
+static VX_INLINE __m128i vxSqrtSSE2(__m128i sum)
+{
+    const __m128i sign = _mm_set1_epi32((vx_int32)0x80000000);
+    const __m128i one = _mm_set1_epi32(1);
+    /* halving keeps the largest sum positive, a sum of 0 is raised to 1 to
+     * keep the reciprocal finite, and the correction below absorbs both */
+    __m128 f = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(sum, 1)), _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f));
+    __m128 r = _mm_rsqrt_ps(f);
+    __m128i m, m1;
+    /* one Newton step takes the 12 bit estimate to nearly full precision */
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), f), _mm_mul_ps(r, r))));
+    m = _mm_cvttps_epi32(_mm_mul_ps(f, r));
+    /* m is now at most one off the integer root, compare the squares unsigned */
+    sum = _mm_xor_si128(sum, sign);
+    m = _mm_add_epi32(m, _mm_cmpgt_epi32(_mm_xor_si128(vxSquareSSE2(m), sign), sum));
+    m1 = _mm_add_epi32(m, one);
+    return _mm_add_epi32(m1, _mm_cmpgt_epi32(_mm_xor_si128(vxSquareSSE2(m1), sign), sum));
+}
+
+static void vxMagnitudeRowU8SSE2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&gx[x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&gy[x]);
+        __m128i lo = _mm_unpacklo_epi16(a, b);
+        __m128i hi = _mm_unpackhi_epi16(a, b);
+        /* gx * gx + gy * gy, which wraps to 2^31 as an unsigned value */
+        lo = vxSqrtSSE2(_mm_madd_epi16(lo, lo));
+        hi = vxSqrtSSE2(_mm_madd_epi16(hi, hi));
+        lo = _mm_packs_epi32(_mm_srli_epi32(lo, 2), _mm_srli_epi32(hi, 2));
+        _mm_storel_epi64((__m128i *)&d[x], _mm_packus_epi16(lo, lo));
+    }
+    vxMagnitudeRowU8(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+static void vxMagnitudeRowS16SSE2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_int16 *d = (vx_int16 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&gx[x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&gy[x]);
+        __m128i lo = _mm_unpacklo_epi16(a, b);
+        __m128i hi = _mm_unpackhi_epi16(a, b);
+        lo = vxSqrtSSE2(_mm_madd_epi16(lo, lo));
+        hi = vxSqrtSSE2(_mm_madd_epi16(hi, hi));
+        _mm_storeu_si128((__m128i *)&d[x], _mm_packs_epi32(lo, hi));
+    }
+    vxMagnitudeRowS16(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+/*! \brief Selects a where mask is set and b elsewhere. */
+#define VX_SELECT_PS(mask, a, b) _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b))
+
+/*! \brief Computes the unquantized phase of four pixels, 0 to 255, from their 32 bit gradients. */
+static VX_INLINE __m128 vxPhaseSSE2(__m128i gx, __m128i gy)
+{
+    const __m128 abs = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 zero = _mm_setzero_ps();
+    __m128 fx = _mm_cvtepi32_ps(gx);
+    __m128 fy = _mm_cvtepi32_ps(gy);
+    __m128 ax = _mm_and_ps(fx, abs);
+    __m128 ay = _mm_and_ps(fy, abs);
+    __m128 steep = _mm_cmplt_ps(ax, ay);
+    /* the gradients are integers, so a nonzero denominator is at least 1 */
+    __m128 t = _mm_div_ps(_mm_min_ps(ax, ay), _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(1.0f)));
+    __m128 s = _mm_mul_ps(t, t);
+    __m128 a = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(VX_ATAN_C11)), _mm_set1_ps(VX_ATAN_C9));
+    a = _mm_add_ps(_mm_mul_ps(s, a), _mm_set1_ps(VX_ATAN_C7));
+    a = _mm_add_ps(_mm_mul_ps(s, a), _mm_set1_ps(VX_ATAN_C5));
+    a = _mm_add_ps(_mm_mul_ps(s, a), _mm_set1_ps(VX_ATAN_C3));
+    a = _mm_add_ps(_mm_mul_ps(s, a), _mm_set1_ps(VX_ATAN_C1));
+    a = _mm_mul_ps(t, a);
+    /* unfold the octant to the angle from the positive x axis, 0 to pi */
+    a = VX_SELECT_PS(steep, _mm_sub_ps(_mm_set1_ps((vx_float32)(VX_TAU / 4)), a), a);
+    a = VX_SELECT_PS(_mm_cmplt_ps(fx, zero), _mm_sub_ps(_mm_set1_ps((vx_float32)(VX_TAU / 2)), a), a);
+    a = _mm_mul_ps(a, _mm_set1_ps((vx_float32)(255.0 / VX_TAU)));
+    return VX_SELECT_PS(_mm_cmplt_ps(fy, zero), _mm_sub_ps(_mm_set1_ps(255.0f), a), a);
+}
+
+/*! \brief Truncates four phases and flags those too close to a step of the quantization. */
+static VX_INLINE __m128i vxQuantizePhaseSSE2(__m128 q, vx_int32 *flags)
+{
+    __m128i i = _mm_cvttps_epi32(q);
+    __m128 frac = _mm_sub_ps(q, _mm_cvtepi32_ps(i));
+    *flags = _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(frac, _mm_set1_ps(VX_PHASE_EPSILON)),
+                                       _mm_cmpgt_ps(frac, _mm_set1_ps(1.0f - VX_PHASE_EPSILON))));
+    return i;
+}
+
+static void vxPhaseRowSSE2(void *dst, const void *src0, const void *src1, vx_float32 scale, vx_uint32 width)
+{
+    vx_uint8 *d = (vx_uint8 *)dst;
+    const vx_int16 *gx = (const vx_int16 *)src0, *gy = (const vx_int16 *)src1;
+    vx_uint32 x, i;
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&gx[x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&gy[x]);
+        vx_int32 flags_lo, flags_hi, flags;
+        /* sign extend to 32 bits */
+        __m128i lo = vxQuantizePhaseSSE2(vxPhaseSSE2(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16),
+                                                     _mm_srai_epi32(_mm_unpacklo_epi16(b, b), 16)), &flags_lo);
+        __m128i hi = vxQuantizePhaseSSE2(vxPhaseSSE2(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16),
+                                                     _mm_srai_epi32(_mm_unpackhi_epi16(b, b), 16)), &flags_hi);
+        lo = _mm_packs_epi32(lo, hi);
+        _mm_storel_epi64((__m128i *)&d[x], _mm_packus_epi16(lo, lo));
+        flags = flags_lo | (flags_hi << 4);
+        for (i = 0; (flags >> i) != 0; i++)
+        {
+            if (flags & (1 << i))
+                d[x + i] = vxPhaseExact(gx[x + i], gy[x + i]);
+        }
+    }
+    vxPhaseRow(&d[x], &gx[x], &gy[x], scale, width - x);
+}
+
+/*! \brief Multiplies 8 pixels of two taps by their coefficients, packed in c, and adds them to acc. */
+#define VX_CONVOLVE_PAIR(acc, a, b, c) { \
+    acc[0] = _mm_add_epi32(acc[0], _mm_madd_epi16(_mm_unpacklo_epi16(a, b), c)); \
+    acc[1] = _mm_add_epi32(acc[1], _mm_madd_epi16(_mm_unpackhi_epi16(a, b), c)); \
+}
+
+/*! \brief Divides four sums by 1 << shift, rounding toward zero. */
+#define VX_CONVOLVE_SHIFT(v, bias, shift) _mm_sra_epi32(_mm_add_epi32(v, _mm_and_si128(_mm_srai_epi32(v, 31), bias)), shift)
+
+/*! \brief Defines a convolution row, 16 pixels at a time. The taps are taken
+ * in pairs so that _mm_madd_epi16 multiplies and adds two of them at once
+ * into 32 bit sums, and the scale is applied before the saturating packs.
+ */
+#define VX_CONVOLVE_ROW_SSE2(name, LOAD, STORE, tail) \
+static void name(void *dst, const void *const *src, const vx_int16 *coeffs, vx_uint32 count, vx_uint32 shift, vx_uint32 width) \
+{ \
+    __m128i pairs[(VX_CONVOLUTION_MAX_DIM * VX_CONVOLUTION_MAX_DIM + 1) / 2]; \
+    const __m128i bias = _mm_set1_epi32((1 << shift) - 1); \
+    const __m128i sh = _mm_cvtsi32_si128(shift); \
+    vx_uint32 x, k; \
+    if (width < 16) \
+    { \
+        tail(dst, src, coeffs, count, shift, width); \
+        return; \
+    } \
+    for (k = 0; k < count; k += 2) \
+    { \
+        vx_uint32 c1 = (k + 1 < count) ? (vx_uint16)coeffs[k + 1] : 0; \
+        pairs[k / 2] = _mm_set1_epi32((vx_int32)((vx_uint16)coeffs[k] | (c1 << 16))); \
+    } \
+    for (x = 0; x < width; x += 16) \
+    { \
+        __m128i acc[4] = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()}; \
+        __m128i a[2], b[2] = {_mm_setzero_si128(), _mm_setzero_si128()}; \
+        /* the last block overlaps the one before rather than going past the row */ \
+        if (x + 16 > width) \
+            x = width - 16; \
+        for (k = 0; k < count; k += 2) \
+        { \
+            LOAD(a, src[k], x); \
+            if (k + 1 < count) \
+                LOAD(b, src[k + 1], x); \
+            VX_CONVOLVE_PAIR((&acc[0]), a[0], b[0], pairs[k / 2]); \
+            VX_CONVOLVE_PAIR((&acc[2]), a[1], b[1], pairs[k / 2]); \
+        } \
+        a[0] = _mm_packs_epi32(VX_CONVOLVE_SHIFT(acc[0], bias, sh), VX_CONVOLVE_SHIFT(acc[1], bias, sh)); \
+        a[1] = _mm_packs_epi32(VX_CONVOLVE_SHIFT(acc[2], bias, sh), VX_CONVOLVE_SHIFT(acc[3], bias, sh)); \
+        STORE(dst, x, a); \
+    } \
+}
+
+/*! \brief Stores 16 saturated 16 bit values as U8. */
+#define VX_STORE_U8(p, x, v) _mm_storeu_si128((__m128i *)((vx_uint8 *)(p) + (x)), _mm_packus_epi16(v[0], v[1]))
+
+/*! \brief Stores 16 16 bit values as S16. */
+#define VX_STORE_S16(p, x, v) { \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(p) + (x)), v[0]); \
+    _mm_storeu_si128((__m128i *)((vx_int16 *)(p) + (x) + 8), v[1]); \
+}
+
+VX_CONVOLVE_ROW_SSE2(vxConvolveRowU8U8SSE2, VX_LOAD_U8, VX_STORE_U8, vxConvolveRowU8U8)
+VX_CONVOLVE_ROW_SSE2(vxConvolveRowU8S16SSE2, VX_LOAD_U8, VX_STORE_S16, vxConvolveRowU8S16)
+VX_CONVOLVE_ROW_SSE2(vxConvolveRowS16U8SSE2, VX_LOAD_S16, VX_STORE_U8, vxConvolveRowS16U8)
+VX_CONVOLVE_ROW_SSE2(vxConvolveRowS16S16SSE2, VX_LOAD_S16, VX_STORE_S16, vxConvolveRowS16S16)
+
+/*! \brief The number of 16 pixel blocks whose squares may be summed in 32 bit
+ * lanes before they are widened, each lane gaining at most 4 * 255 * 255 per block.
+ */
+#define VX_MOMENTS_BLOCKS (1024)
+
+static void vxMomentsRowU8SSE2(const void *src, vx_uint32 width, vx_uint64 *sum, vx_uint64 *sumsq)
+{
+    const vx_uint8 *s = (const vx_uint8 *)src;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i s1 = zero, s2 = zero;
+    vx_uint64 lanes[2];
+    vx_uint32 x = 0;
+    while (x + 16 <= width)
+    {
+        __m128i sq = zero;
+        vx_uint32 b;
+        for (b = 0; (b < VX_MOMENTS_BLOCKS) && (x + 16 <= width); b++, x += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)&s[x]);
+            __m128i lo = _mm_unpacklo_epi8(v, zero);
+            __m128i hi = _mm_unpackhi_epi8(v, zero);
+            s1 = _mm_add_epi64(s1, _mm_sad_epu8(v, zero));
+            sq = _mm_add_epi32(sq, _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi)));
+        }
+        s2 = _mm_add_epi64(s2, _mm_add_epi64(_mm_unpacklo_epi32(sq, zero), _mm_unpackhi_epi32(sq, zero)));
+    }
+    _mm_storeu_si128((__m128i *)lanes, s1);
+    *sum += lanes[0] + lanes[1];
+    _mm_storeu_si128((__m128i *)lanes, s2);
+    *sumsq += lanes[0] + lanes[1];
+    vxMomentsRowU8(&s[x], width - x, sum, sumsq);
+}
+
+/*! \brief Computes the prefix sums of 8 16 bit lanes. */
+#define VX_PREFIX_EPI16(v) { \
+    v = _mm_add_epi16(v, _mm_slli_si128(v, 2)); \
+    v = _mm_add_epi16(v, _mm_slli_si128(v, 4)); \
+    v = _mm_add_epi16(v, _mm_slli_si128(v, 8)); \
+}
+
+/*! \brief Widens 8 16 bit prefix sums, adds the running sum and the row above and stores them. */
+#define VX_STORE_INTEGRAL(d, p, v, run) { \
+    _mm_storeu_si128((__m128i *)(d), _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(v, zero), run), \
+                                                   _mm_loadu_si128((const __m128i *)(p)))); \
+    _mm_storeu_si128((__m128i *)(d) + 1, _mm_add_epi32(_mm_add_epi32(_mm_unpackhi_epi16(v, zero), run), \
+                                                       _mm_loadu_si128((const __m128i *)(p) + 1))); \
+}
+
+static void vxIntegralRowSSE2(vx_uint32 *dst, const vx_uint32 *prev, const vx_uint8 *src, vx_uint32 width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    vx_uint32 x, run = 0;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i r = _mm_set1_epi32((vx_int32)run);
+        VX_PREFIX_EPI16(lo);
+        VX_PREFIX_EPI16(hi);
+        /* the sums of the first 8 pixels carry into the last 8, at most 16 * 255 */
+        hi = _mm_add_epi16(hi, _mm_set1_epi16((vx_int16)_mm_extract_epi16(lo, 7)));
+        VX_STORE_INTEGRAL(&dst[x], &prev[x], lo, r);
+        VX_STORE_INTEGRAL(&dst[x + 8], &prev[x + 8], hi, r);
+        run += (vx_uint32)_mm_extract_epi16(hi, 7);
+    }
+    for (; x < width; x++)
+    {
+        run += src[x];
+        dst[x] = prev[x] + run;
+    }
+}
+
+static void vxFast9RowSSE2(vx_uint8 *scores, const vx_uint8 *src, const vx_int32 *circle, vx_uint8 threshold, vx_uint32 width)
+{
+    const __m128i t = _mm_set1_epi8((char)threshold);
+    const __m128i zero = _mm_setzero_si128();
+    vx_uint32 x = 3, i;
+    memset(scores, 0, width);
+    for (; x + 16 + 3 <= width; x += 16)
+    {
+        /* the compass points which are neither brighter nor darker, reject in bulk */
+        __m128i p = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i hi = _mm_adds_epu8(p, t), lo = _mm_subs_epu8(p, t);
+        __m128i c0 = _mm_loadu_si128((const __m128i *)(&src[x] + circle[0]));
+        __m128i c4 = _mm_loadu_si128((const __m128i *)(&src[x] + circle[4]));
+        __m128i c8 = _mm_loadu_si128((const __m128i *)(&src[x] + circle[8]));
+        __m128i c12 = _mm_loadu_si128((const __m128i *)(&src[x] + circle[12]));
+        __m128i b0 = _mm_cmpeq_epi8(_mm_subs_epu8(c0, hi), zero), d0 = _mm_cmpeq_epi8(_mm_subs_epu8(lo, c0), zero);
+        __m128i b4 = _mm_cmpeq_epi8(_mm_subs_epu8(c4, hi), zero), d4 = _mm_cmpeq_epi8(_mm_subs_epu8(lo, c4), zero);
+        __m128i b8 = _mm_cmpeq_epi8(_mm_subs_epu8(c8, hi), zero), d8 = _mm_cmpeq_epi8(_mm_subs_epu8(lo, c8), zero);
+        __m128i b12 = _mm_cmpeq_epi8(_mm_subs_epu8(c12, hi), zero), d12 = _mm_cmpeq_epi8(_mm_subs_epu8(lo, c12), zero);
+        /* no two neighboring compass points brighter, nor two darker */
+        __m128i none = _mm_and_si128(
+            _mm_and_si128(_mm_and_si128(_mm_or_si128(b0, b4), _mm_or_si128(b4, b8)),
+                          _mm_and_si128(_mm_or_si128(b8, b12), _mm_or_si128(b12, b0))),
+            _mm_and_si128(_mm_and_si128(_mm_or_si128(d0, d4), _mm_or_si128(d4, d8)),
+                          _mm_and_si128(_mm_or_si128(d8, d12), _mm_or_si128(d12, d0))));
+        vx_uint32 mask = 0xFFFFu ^ (vx_uint32)_mm_movemask_epi8(none);
+        for (i = 0; mask != 0; i++, mask >>= 1)
+        {
+            if (mask & 1)
+                scores[x + i] = vxFast9Score(&src[x + i], circle, threshold);
+        }
+    }
+    for (; x + 3 < width; x++)
+        scores[x] = vxFast9Score(&src[x], circle, threshold);
+}
+
+/*! \brief Adds the products of two rows and their weights to the sums of 8 pixels. */
+#define VX_MADD_ROWS(a, b, p, q, w) \
+    a = _mm_add_epi32(a, _mm_madd_epi16(_mm_unpacklo_epi16(p, q), w)); \
+    b = _mm_add_epi32(b, _mm_madd_epi16(_mm_unpackhi_epi16(p, q), w))
+
+static void vxScaleRowSSE2(vx_uint8 *dst, const vx_int16 *const *rows, const vx_int16 *weights, vx_uint32 taps, vx_uint32 width)
+{
+    const __m128i round = _mm_set1_epi32(1 << (VX_SCALE_SHIFT_Y - 1));
+    const __m128i zero = _mm_setzero_si128();
+    vx_uint32 x, k;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i a0 = round, a1 = round, a2 = round, a3 = round;
+        /* the rows go in pairs through the multiply-adds, the last one with zeros */
+        /* the rows go through the multiply-adds in pairs, and the last one with zeros */
+        for (k = 0; k < taps; k += 2)
+        {
+            const vx_int16 *p = &rows[k][x];
+            vx_int16 wq = (k + 1 < taps) ? weights[k + 1] : 0;
+            __m128i w = _mm_set1_epi32((vx_int32)(((vx_uint32)(vx_uint16)wq << 16) | (vx_uint16)weights[k]));
+            __m128i p0 = _mm_loadu_si128((const __m128i *)p);
+            __m128i p1 = _mm_loadu_si128((const __m128i *)(p + 8));
+            __m128i q0 = zero, q1 = zero;
+            if (k + 1 < taps)
+            {
+                q0 = _mm_loadu_si128((const __m128i *)&rows[k + 1][x]);
+                q1 = _mm_loadu_si128((const __m128i *)&rows[k + 1][x + 8]);
+            }
+            VX_MADD_ROWS(a0, a1, p0, q0, w);
+            VX_MADD_ROWS(a2, a3, p1, q1, w);
+        }
+        a0 = _mm_packs_epi32(_mm_srai_epi32(a0, VX_SCALE_SHIFT_Y), _mm_srai_epi32(a1, VX_SCALE_SHIFT_Y));
+        a2 = _mm_packs_epi32(_mm_srai_epi32(a2, VX_SCALE_SHIFT_Y), _mm_srai_epi32(a3, VX_SCALE_SHIFT_Y));
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(a0, a2));
+    }
+    vxScaleRowFrom(dst, rows, weights, taps, x, width);
+}
+
+static void vxHalfMeanRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    const __m128i even = _mm_set1_epi16(0x00FF);
+    const __m128i two = _mm_set1_epi16(2);
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)&r0[2 * x]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&r0[2 * x + 16]);
+        __m128i c = _mm_loadu_si128((const __m128i *)&r1[2 * x]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&r1[2 * x + 16]);
+        /* the sums of the pairs of each row, then of the two rows */
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(a, even), _mm_srli_epi16(a, 8)),
+                                   _mm_add_epi16(_mm_and_si128(c, even), _mm_srli_epi16(c, 8)));
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(b, even), _mm_srli_epi16(b, 8)),
+                                   _mm_add_epi16(_mm_and_si128(d, even), _mm_srli_epi16(d, 8)));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(lo, hi));
+    }
+    vxHalfMeanRow(&dst[x], &r0[2 * x], &r1[2 * x], width - x);
+}
+
+static void vxHalfNearestRowSSE2(vx_uint8 *dst, const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        __m128i a = _mm_srli_epi16(_mm_loadu_si128((const __m128i *)&r1[2 * x]), 8);
+        __m128i b = _mm_srli_epi16(_mm_loadu_si128((const __m128i *)&r1[2 * x + 16]), 8);
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(a, b));
+    }
+    vxHalfNearestRow(&dst[x], &r0[2 * x], &r1[2 * x], width - x);
+}
+
+const vx_rows_t vx_rows_sse2 = {
+    "sse2",
+    vxBoxRowSSE2,
+    vxGaussianRowSSE2,
+    vxMedianRowSSE2,
+    vxErodeRowSSE2,
+    vxDilateRowSSE2,
+    &vx_pointwise_sse2,
+    vxMagnitudeRowU8SSE2,
+    vxMagnitudeRowS16SSE2,
+    vxPhaseRowSSE2,
+    {{vxConvolveRowU8U8SSE2, vxConvolveRowU8S16SSE2}, {vxConvolveRowS16U8SSE2, vxConvolveRowS16S16SSE2}},
+    vxMomentsRowU8SSE2,
+    /* the squares of U16 pixels do not fit the signed 16 bit multiplies */
+    vxMomentsRowU16,
+    vxIntegralRowSSE2,
+    vxFast9RowSSE2,
+    vxScaleRowSSE2,
+    vxHalfMeanRowSSE2,
+    vxHalfNearestRowSSE2,
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2012-2013 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The Image Scale Kernel of the SIMD target.
+ * \details The tables, the local data and the validation are those of the C
+ * model, from vx_scale_lib.c. The rows are filtered along y and halved with
+ * vector row functions, while the filtering along x and nearest neighbor
+ * gather their pixels one at a time.
+ */
+
+#include <VX/vx.h>
+#include <VX/vx_helper.h>
+
+#include <vx_internal.h>
+#include <vx_interface.h>
+
+/*! \brief Filters source row y along x into a row of the ring. */
+static void vxScaleRowX(const vx_scale_t *s, vx_int16 *out, vx_uint32 y)
+{
+    const vx_uint8 *src = s->src + y * s->src_addr.stride_y;
+    const vx_uint32 taps = s->tables->taps_x;
+    const vx_int32 round = 1 << (VX_SCALE_SHIFT_X - 1);
+    vx_uint32 x, k;
+    if (taps == 2)
+    {
+        /* bilinear */
+        for (x = 0; x < s->tables->w2; x++)
+        {
+            const vx_uint8 *p = &src[s->start_x[x]];
+            const vx_int16 *w = &s->weights_x[2 * x];
+            out[x] = (vx_int16)((p[0] * w[0] + p[1] * w[1] + round) >> VX_SCALE_SHIFT_X);
+        }
+        return;
+    }
+    for (x = 0; x < s->tables->w2; x++)
+    {
+        const vx_uint8 *p = &src[s->start_x[x]];
+        const vx_int16 *w = &s->weights_x[x * taps];
+        vx_int32 sum = round;
+        for (k = 0; k < taps; k++)
+            sum += p[k] * w[k];
+        out[x] = (vx_int16)(sum >> VX_SCALE_SHIFT_X);
+    }
+}
+
+/*! \brief Filters rows of the ring along y into output row y. */
+static void vxScaleRowY(const vx_scale_t *s, vx_uint32 y, const vx_int16 *const *rows)
+{
+    const vx_uint32 taps = s->tables->taps_y;
+    vx_rows->scale(s->dst + y * s->dst_addr.stride_y, rows, &s->weights_y[y * taps], taps, s->tables->w2);
+}
+
+static void vxScaleBand(void *arg, vx_uint32 index, vx_uint32 y0, vx_uint32 y1)
+{
+    vx_scale_t *s = (vx_scale_t *)arg;
+    const vx_scale_tables_t *t = s->tables;
+    const vx_int32 src_stride = s->src_addr.stride_y, dst_stride = s->dst_addr.stride_y;
+    vx_uint32 x, y;
+
+    if (t->path == VX_SCALE_PATH_COPY)
+    {
+        for (y = y0; y < y1; y++)
+            memcpy(s->dst + y * dst_stride, s->src + y * src_stride, t->w2);
+    }
+    else if (t->path == VX_SCALE_PATH_HALF)
+    {
+        vx_half_row_f half = (t->type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ? vx_rows->half_nearest
+                                                                                 : vx_rows->half_mean;
+        for (y = y0; y < y1; y++)
+            half(s->dst + y * dst_stride, s->src + 2 * y * src_stride, s->src + (2 * y + 1) * src_stride, t->w2);
+    }
+    else if (t->path == VX_SCALE_PATH_NEAREST)
+    {
+        for (y = y0; y < y1; y++)
+        {
+            const vx_uint8 *src = s->src + s->start_y[y] * src_stride;
+            vx_uint8 *dst = s->dst + y * dst_stride;
+            /* rows from the same source row are copies of each other */
+            if ((y > y0) && (s->start_y[y] == s->start_y[y - 1]))
+                memcpy(dst, dst - dst_stride, t->w2);
+            else
+            {
+                for (x = 0; x < t->w2; x++)
+                    dst[x] = src[s->start_x[x]];
+            }
+        }
+    }
+    else
+    {
+        vxScaleFilterBand(s, index, y0, y1, vxScaleRowX, vxScaleRowY);
+    }
+}
+
+static vx_status vxScaleImageKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    return vxScaleImage(node, parameters, num, vxAccessImageRows, vxScaleBand);
+}
+
+static vx_param_description_t scale_kernel_params[] = {
+    {VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED},
+    {VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL},
+};
+
+vx_kernel_description_t scale_image_kernel = {
+    VX_KERNEL_SCALE_IMAGE,
+    "org.khronos.openvx.scale_image",
+    vxScaleImageKernel,
+    scale_kernel_params, dimof(scale_kernel_params),
+    vxScaleImageInputValidator,
+    vxScaleImageOutputValidator,
+    vxScaleImageInitializer,
+    NULL,
+};
+
@@ -2208,7 +2208,7 @@ vx_status vx_test_graph_corners(int argc, char *argv[])
 
                 status = vxProcessGraph(graph);
 #ifdef OPENVX_KHR_LIST
-                if (vxSortList(harris_list, vxHarrisScoreSorter) == VX_SUCCESS)
+                if ((status == VX_SUCCESS) && (vxSortList(harris_list, vxHarrisScoreSorter) == VX_SUCCESS))
                 {
                     vx_iterator hit = 0, lit = 0;
                     vx_keypoint hi = (vx_keypoint)vxGetListItem(harris_list, &hit, VX_LIST_LAST);
@@ -2252,6 +2252,3387 @@ exit:
     return status;
 }
 
+/*!
+ * \brief Test that a graph with independent branches computes the same result
+ * on the context's worker threads as it does on the calling thread alone.
+ * \ingroup group_tests
+ */
+vx_status vx_test_graph_workers(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, r, y, w = 640, h = 480;
+        vx_uint32 workers[] = {4, 0};
+        vx_uint8 *results[dimof(workers)] = {NULL, NULL};
+        vx_image input = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 3, 7);
+        vx_image images[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 0: Box */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 1: Gaussian */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 2: Median */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 3: Or */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 4: Xor */
+        };
+        vx_graph graph = vxCreateGraph(context);
+
+        if (input == 0 || graph == 0)
+        {
+            ALARM("failed to create input or graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        CHECK_ALL_ITEMS(images, i, status, exit);
+        {
+            vx_node nodes[] = {
+                vxBox3x3Node(graph, input, images[0]),
+                vxGaussian3x3Node(graph, input, images[1]),
+                vxMedian3x3Node(graph, input, images[2]),
+                vxOrNode(graph, images[0], images[1], images[3]),
+                vxXorNode(graph, images[3], images[2], images[4]),
+            };
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            for (r = 0; r < dimof(workers) && status == VX_SUCCESS; r++)
+            {
+                vx_uint32 query = 0;
+                status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &workers[r], sizeof(workers[r]));
+                if (status == VX_SUCCESS)
+                    status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &query, sizeof(query));
+                if (status != VX_SUCCESS || query != workers[r])
+                {
+                    VALARM("failed to set %u workers (got %u)", workers[r], query);
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                    break;
+                }
+                status = vxProcessGraph(graph);
+                if (status == VX_SUCCESS)
+                {
+                    vx_rectangle rect = vxCreateRectangle(context, 0, 0, w, h);
+                    vx_imagepatch_addressing_t addr;
+                    void *base = NULL;
+                    results[r] = (vx_uint8 *)malloc(w * h);
+                    status = vxAccessImagePatch(images[4], rect, 0, &addr, &base);
+                    if (status == VX_SUCCESS && results[r])
+                    {
+                        for (y = 0; y < h; y++)
+                            memcpy(&results[r][y * w], vxFormatImagePatchAddress2d(base, 0, y, &addr), w);
+                        vxCommitImagePatch(images[4], 0, 0, &addr, base);
+                    }
+                    vxReleaseRectangle(&rect);
+                }
+            }
+            if (status == VX_SUCCESS && results[0] && results[1] &&
+                memcmp(results[0], results[1], w * h) != 0)
+            {
+                ALARM("results differ between worker counts");
+                status = VX_FAILURE;
+            }
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+exit:
+        for (r = 0; r < dimof(workers); r++)
+        {
+            free(results[r]);
+        }
+        vxReleaseGraph(&graph);
+        for (i = 0; i < dimof(images); i++)
+        {
+            vxReleaseImage(&images[i]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*!
+ * \brief Test that a chain of virtual images which share memory within the
+ * graph still produces the right result, with and without worker threads.
+ * \ingroup group_tests
+ */
+vx_status vx_test_graph_virtual_aliasing(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, r, w = 640, h = 480;
+        vx_uint32 workers[] = {4, 0};
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image output = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image virts[] = {
+            vxCreateVirtualImage(context),                      /* 0: Not */
+            vxCreateVirtualImage(context),                      /* 1: Not */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 2: Not */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 3: Or */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 4: Not */
+        };
+        vx_graph graph = vxCreateGraph(context);
+
+        if (input == 0 || output == 0 || graph == 0)
+        {
+            ALARM("failed to create images or graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        CHECK_ALL_ITEMS(virts, i, status, exit);
+        status = vxLoadKernels(context, "openvx-debug");
+        if (status != VX_SUCCESS)
+            FAIL(exit, "can't load debug extensions");
+        {
+            vx_node nodes[] = {
+                vxNotNode(graph, input, virts[0]),
+                vxNotNode(graph, virts[0], virts[1]),
+                vxNotNode(graph, virts[0], virts[2]),
+                vxOrNode(graph, virts[1], virts[2], virts[3]),
+                vxNotNode(graph, virts[3], virts[4]),
+                vxNotNode(graph, virts[4], output),
+            };
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            for (r = 0; r < dimof(workers) && status == VX_SUCCESS; r++)
+            {
+                vx_uint32 errors = 0u;
+                status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &workers[r], sizeof(workers[r]));
+                status |= vxuFillImage(0x5A, input);
+                status |= vxuFillImage(0x00, output);
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graph);
+                if (status == VX_SUCCESS)
+                    status = vxuCheckImage(output, 0x5A, &errors);
+                if (status != VX_SUCCESS)
+                {
+                    VALARM("output had %u errors with %u workers", errors, workers[r]);
+                }
+            }
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+exit:
+        vxReleaseGraph(&graph);
+        for (i = 0; i < dimof(virts); i++)
+        {
+            vxReleaseImage(&virts[i]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseImage(&output);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief Copies a packed buffer of w * h pixels of size bytes into an image. */
+static vx_status vx_write_image(vx_image image, vx_uint32 w, vx_uint32 h, vx_size size, const void *buffer)
+{
+    vx_rectangle rect = vxCreateRectangle(vxGetContext(image), 0, 0, w, h);
+    vx_imagepatch_addressing_t addr;
+    void *base = NULL;
+    vx_uint32 y;
+    vx_status status = vxAccessImagePatch(image, rect, 0, &addr, &base);
+    if (status == VX_SUCCESS)
+    {
+        for (y = 0; y < h; y++)
+            memcpy(vxFormatImagePatchAddress2d(base, 0, y, &addr), (const vx_uint8 *)buffer + y * w * size, w * size);
+        status = vxCommitImagePatch(image, rect, 0, &addr, base);
+    }
+    vxReleaseRectangle(&rect);
+    return status;
+}
+
+/*! \brief Copies an image into a packed buffer of w * h pixels of size bytes. */
+static vx_status vx_read_image(vx_image image, vx_uint32 w, vx_uint32 h, vx_size size, void *buffer)
+{
+    vx_rectangle rect = vxCreateRectangle(vxGetContext(image), 0, 0, w, h);
+    vx_imagepatch_addressing_t addr;
+    void *base = NULL;
+    vx_uint32 y;
+    vx_status status = vxAccessImagePatch(image, rect, 0, &addr, &base);
+    if (status == VX_SUCCESS)
+    {
+        for (y = 0; y < h; y++)
+            memcpy((vx_uint8 *)buffer + y * w * size, vxFormatImagePatchAddress2d(base, 0, y, &addr), w * size);
+        status = vxCommitImagePatch(image, 0, 0, &addr, base);
+    }
+    vxReleaseRectangle(&rect);
+    return status;
+}
+
+/*! \brief Creates a node of a loaded kernel with one input and one output image. */
+static vx_node vx_create_filter_node(vx_graph graph, const vx_char *name, vx_image in, vx_image out)
+{
+    vx_node node = 0;
+    vx_kernel kernel = vxGetKernelByName(vxGetContext(graph), (vx_char *)name);
+    if (kernel)
+    {
+        node = vxCreateNode(graph, kernel);
+        if (node && ((vxSetParameterByIndex(node, 0, VX_INPUT, (vx_reference)in) != VX_SUCCESS) ||
+                     (vxSetParameterByIndex(node, 1, VX_OUTPUT, (vx_reference)out) != VX_SUCCESS)))
+            vxReleaseNode(&node);
+        vxReleaseKernel(&kernel);
+    }
+    return node;
+}
+
+/*!
+ * \brief Test that a chain of tiling kernels through a virtual image runs depth
+ * first, as one pass, and computes what the same chain computes node by node
+ * through a real image.
+ * \ingroup group_tests
+ */
+vx_status vx_test_graph_tiling_chain(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, x, y, w = 640, h = 480, border = 4;
+        vx_uint8 *results[2] = {malloc(w * h), malloc(w * h)};
+        vx_image input = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 3, 7);
+        vx_image images[] = {
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8),     /* 0: Gaussian */
+            vxCreateImage(context, w, h, FOURCC_U8),                /* 1: Gaussian */
+        };
+        vx_image outputs[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 0: depth first */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 1: node by node */
+        };
+        vx_graph graph = vxCreateGraph(context);
+
+        if (input == 0 || graph == 0 || results[0] == NULL || results[1] == NULL)
+        {
+            ALARM("failed to create input or graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        CHECK_ALL_ITEMS(images, i, status, exit);
+        CHECK_ALL_ITEMS(outputs, i, status, exit);
+        status = vxLoadKernels(context, "openvx-tiling");
+        if (status != VX_SUCCESS)
+            FAIL(exit, "can't load tiling extensions");
+        {
+            vx_node nodes[] = {
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_gaussian_3x3", input, images[0]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_box_MxN", images[0], outputs[0]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_gaussian_3x3", input, images[1]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_box_MxN", images[1], outputs[1]),
+            };
+            vx_perf_t perf;
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            status = vxProcessGraph(graph);
+            for (i = 0; i < dimof(outputs) && status == VX_SUCCESS; i++)
+                status = vx_read_image(outputs[i], w, h, sizeof(vx_uint8), results[i]);
+            /* the head of the chain runs inside the pass of its last node */
+            if (status == VX_SUCCESS)
+                status = vxQueryNode(nodes[0], VX_NODE_ATTRIBUTE_PERFORMANCE, &perf, sizeof(perf));
+            if (status == VX_SUCCESS && perf.num != 0)
+            {
+                ALARM("the chain was not run depth first");
+                status = VX_FAILURE;
+            }
+            /* the borders of the tiling kernels are undefined */
+            for (y = border; y < h - border && status == VX_SUCCESS; y++)
+            {
+                for (x = border; x < w - border; x++)
+                {
+                    if (results[0][y * w + x] != results[1][y * w + x])
+                    {
+                        VALARM("depth first output differs at {%u, %u}", x, y);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                }
+            }
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+exit:
+        vxReleaseGraph(&graph);
+        for (i = 0; i < dimof(images); i++)
+        {
+            vxReleaseImage(&images[i]);
+            vxReleaseImage(&outputs[i]);
+            free(results[i]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_fusion(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, r, w = 640, h = 480;
+        vx_uint32 workers[] = {4, 0};
+        vx_float32 scale = 1.0f/64;
+        vx_int32 shift = 1;
+        vx_uint8 value = 30;
+        vx_enum sat = VX_CONVERT_POLICY_SATURATE, wrap = VX_CONVERT_POLICY_TRUNCATE;
+        vx_uint8 *results[2] = {malloc(w * h), malloc(w * h)};
+        vx_image in0 = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 3, 7);
+        vx_image in1 = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 11, 3);
+        vx_image outputs[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),    /* fused */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* reference */
+        };
+        vx_image virts[] = {
+            vxCreateVirtualImageWithFormat(context, FOURCC_S16), /* 0: Add */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 1: ConvertDepth */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 2: Multiply */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 3: Threshold */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8), /* 4: And */
+        };
+        vx_image images[] = {
+            vxCreateImage(context, w, h, FOURCC_S16),   /* 0: Add */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 1: ConvertDepth */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 2: Multiply */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 3: Threshold */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 4: And */
+        };
+        vx_scalar sscale = vxCreateScalar(context, VX_TYPE_FLOAT32, &scale);
+        vx_scalar sshift = vxCreateScalar(context, VX_TYPE_INT32, &shift);
+        vx_threshold thresh = vxCreateThreshold(context, VX_THRESHOLD_TYPE_BINARY);
+        vx_graph graphs[] = {vxCreateGraph(context), vxCreateGraph(context)};
+
+        if (in0 == 0 || in1 == 0 || sscale == 0 || sshift == 0 || thresh == 0 ||
+            results[0] == NULL || results[1] == NULL)
+        {
+            ALARM("failed to create inputs");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        CHECK_ALL_ITEMS(outputs, i, status, exit);
+        CHECK_ALL_ITEMS(virts, i, status, exit);
+        CHECK_ALL_ITEMS(images, i, status, exit);
+        CHECK_ALL_ITEMS(graphs, i, status, exit);
+        status = vxSetThresholdAttribute(thresh, VX_THRESHOLD_ATTRIBUTE_VALUE, &value, sizeof(value));
+        if (status != VX_SUCCESS)
+            FAIL(exit, "can't set the threshold");
+        {
+            /* the same chain twice, through virtual images it can be fused */
+            vx_node nodes[] = {
+                vxAddNode(graphs[0], in0, in1, sat, virts[0]),
+                vxConvertDepthNode(graphs[0], virts[0], virts[1], sat, sshift),
+                vxMultiplyNode(graphs[0], virts[1], in1, sscale, wrap, virts[2]),
+                vxThresholdNode(graphs[0], virts[2], thresh, virts[3]),
+                vxAndNode(graphs[0], virts[3], in0, virts[4]),
+                vxNotNode(graphs[0], virts[4], outputs[0]),
+
+                vxAddNode(graphs[1], in0, in1, sat, images[0]),
+                vxConvertDepthNode(graphs[1], images[0], images[1], sat, sshift),
+                vxMultiplyNode(graphs[1], images[1], in1, sscale, wrap, images[2]),
+                vxThresholdNode(graphs[1], images[2], thresh, images[3]),
+                vxAndNode(graphs[1], images[3], in0, images[4]),
+                vxNotNode(graphs[1], images[4], outputs[1]),
+            };
+            vx_perf_t perf;
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            status = vxProcessGraph(graphs[1]);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(outputs[1], w, h, sizeof(vx_uint8), results[1]);
+            for (r = 0; r < dimof(workers) && status == VX_SUCCESS; r++)
+            {
+                status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &workers[r], sizeof(workers[r]));
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graphs[0]);
+                if (status == VX_SUCCESS)
+                    status = vx_read_image(outputs[0], w, h, sizeof(vx_uint8), results[0]);
+                if (status == VX_SUCCESS && memcmp(results[0], results[1], w * h) != 0)
+                {
+                    VALARM("fused results differ with %u workers", workers[r]);
+                    status = VX_FAILURE;
+                }
+            }
+            /* Convert Depth splits the chain, Multiply is the head of the group after it */
+            if (status == VX_SUCCESS)
+                status = vxQueryNode(nodes[2], VX_NODE_ATTRIBUTE_PERFORMANCE, &perf, sizeof(perf));
+            if (status == VX_SUCCESS && perf.num != 0)
+            {
+                ALARM("the chain was not fused");
+                status = VX_FAILURE;
+            }
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+exit:
+        for (i = 0; i < dimof(graphs); i++)
+        {
+            vxReleaseGraph(&graphs[i]);
+        }
+        for (i = 0; i < dimof(virts); i++)
+        {
+            vxReleaseImage(&virts[i]);
+            vxReleaseImage(&images[i]);
+        }
+        for (i = 0; i < dimof(outputs); i++)
+        {
+            vxReleaseImage(&outputs[i]);
+            free(results[i]);
+        }
+        vxReleaseThreshold(&thresh);
+        vxReleaseScalar(&sscale);
+        vxReleaseScalar(&sshift);
+        vxReleaseImage(&in0);
+        vxReleaseImage(&in1);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*!
+ * \brief Test that tiling kernels compute the same result when their tiles and
+ * strips are spread over worker threads as they do on the calling thread alone,
+ * both node by node through real images and depth first through a virtual one.
+ * \ingroup group_tests
+ */
+vx_status vx_test_graph_tiling(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, r, x, y, w = 640, h = 480, border = 4;
+        vx_uint32 workers[] = {0, 4};
+        vx_uint8 *results[dimof(workers)][2] = {{NULL, NULL}, {NULL, NULL}};
+        vx_image input = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 3, 7);
+        vx_image images[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),                /* 0: Gaussian */
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8),     /* 1: Gaussian */
+        };
+        vx_image outputs[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 0: node by node */
+            vxCreateImage(context, w, h, FOURCC_U8),    /* 1: depth first */
+        };
+        vx_graph graph = vxCreateGraph(context);
+
+        if (input == 0 || graph == 0)
+        {
+            ALARM("failed to create input or graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        CHECK_ALL_ITEMS(images, i, status, exit);
+        CHECK_ALL_ITEMS(outputs, i, status, exit);
+        status = vxLoadKernels(context, "openvx-tiling");
+        if (status != VX_SUCCESS)
+            FAIL(exit, "can't load tiling extensions");
+        {
+            vx_node nodes[] = {
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_gaussian_3x3", input, images[0]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_box_MxN", images[0], outputs[0]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_gaussian_3x3", input, images[1]),
+                vx_create_filter_node(graph, "org.khronos.openvx.tiling_box_MxN", images[1], outputs[1]),
+            };
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            for (r = 0; r < dimof(workers) && status == VX_SUCCESS; r++)
+            {
+                status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &workers[r], sizeof(workers[r]));
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graph);
+                for (i = 0; i < dimof(outputs) && status == VX_SUCCESS; i++)
+                {
+                    results[r][i] = (vx_uint8 *)malloc(w * h);
+                    if (results[r][i] == NULL)
+                        status = VX_ERROR_NO_MEMORY;
+                    else
+                        status = vx_read_image(outputs[i], w, h, sizeof(vx_uint8), results[r][i]);
+                }
+            }
+            /* the borders of the tiling kernels are undefined */
+            for (i = 0; i < dimof(outputs) && status == VX_SUCCESS; i++)
+            {
+                for (y = border; y < h - border && status == VX_SUCCESS; y++)
+                {
+                    for (x = border; x < w - border; x++)
+                    {
+                        if (results[0][i][y * w + x] != results[1][i][y * w + x])
+                        {
+                            VALARM("output %u differs at {%u, %u} with %u workers", i, x, y, workers[1]);
+                            status = VX_FAILURE;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+exit:
+        for (r = 0; r < dimof(workers); r++)
+        {
+            for (i = 0; i < dimof(outputs); i++)
+                free(results[r][i]);
+        }
+        vxReleaseGraph(&graph);
+        for (i = 0; i < dimof(images); i++)
+        {
+            vxReleaseImage(&images[i]);
+            vxReleaseImage(&outputs[i]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_schedule(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, w = 64, h = 48, executors = 3, qexecutors = 0;
+        vx_size depth = 16, qdepth = 0;
+        vx_image inputs[16], virts[dimof(inputs)], outputs[dimof(inputs)];
+        vx_graph graphs[dimof(inputs)];
+        vx_uint8 *expected = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *result = (vx_uint8 *)malloc(w * h);
+
+        memset(inputs, 0, sizeof(inputs));
+        memset(virts, 0, sizeof(virts));
+        memset(outputs, 0, sizeof(outputs));
+        memset(graphs, 0, sizeof(graphs));
+        status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_EXECUTORS, &executors, sizeof(executors));
+        if (status == VX_SUCCESS)
+            status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_GRAPH_QUEUE_DEPTH, &depth, sizeof(depth));
+        if (status == VX_SUCCESS)
+            status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_NUM_EXECUTORS, &qexecutors, sizeof(qexecutors));
+        if (status == VX_SUCCESS)
+            status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_GRAPH_QUEUE_DEPTH, &qdepth, sizeof(qdepth));
+        if (status != VX_SUCCESS || qexecutors != executors || qdepth != depth || !expected || !result)
+        {
+            VALARM("failed to configure %u executors and depth " VX_FMT_SIZE, executors, depth);
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        /* each graph inverts its input twice, so its output equals its input. */
+        for (i = 0; i < dimof(graphs) && status == VX_SUCCESS; i++)
+        {
+            vx_node nodes[2];
+            inputs[i] = vx_create_image_valuecovering(context, FOURCC_U8, w, h, i, 5 + i);
+            virts[i] = vxCreateVirtualImageWithFormat(context, FOURCC_U8);
+            outputs[i] = vxCreateImage(context, w, h, FOURCC_U8);
+            graphs[i] = vxCreateGraph(context);
+            if (!inputs[i] || !virts[i] || !outputs[i] || !graphs[i])
+            {
+                status = VX_ERROR_NOT_SUFFICIENT;
+                break;
+            }
+            nodes[0] = vxNotNode(graphs[i], inputs[i], virts[i]);
+            nodes[1] = vxNotNode(graphs[i], virts[i], outputs[i]);
+            if (!nodes[0] || !nodes[1])
+                status = VX_ERROR_NOT_SUFFICIENT;
+            vxReleaseNode(&nodes[0]);
+            vxReleaseNode(&nodes[1]);
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graphs[i]);
+        }
+        /* more graphs are outstanding than there are executors. */
+        for (i = 0; i < dimof(graphs) && status == VX_SUCCESS; i++)
+        {
+            status = vxScheduleGraph(graphs[i]);
+        }
+        if (status == VX_SUCCESS && vxScheduleGraph(graphs[0]) != VX_ERROR_GRAPH_SCHEDULED)
+        {
+            ALARM("graph was scheduled twice");
+            status = VX_FAILURE;
+        }
+        for (i = dimof(graphs); i > 0; i--)
+        {
+            vx_status s = vxWaitGraph(graphs[i - 1]);
+            if (status == VX_SUCCESS)
+                status = s;
+        }
+        for (i = 0; i < dimof(graphs) && status == VX_SUCCESS; i++)
+        {
+            status = vx_read_image(inputs[i], w, h, sizeof(vx_uint8), expected);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(outputs[i], w, h, sizeof(vx_uint8), result);
+            if (status == VX_SUCCESS && memcmp(expected, result, w * h) != 0)
+            {
+                VALARM("graph %u produced the wrong output", i);
+                status = VX_FAILURE;
+            }
+        }
+exit:
+        for (i = 0; i < dimof(graphs); i++)
+        {
+            vxReleaseGraph(&graphs[i]);
+            vxReleaseImage(&inputs[i]);
+            vxReleaseImage(&virts[i]);
+            vxReleaseImage(&outputs[i]);
+        }
+        free(expected);
+        free(result);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief Creates Box3x3, Not and Gaussian3x3 in a row with the input and output as graph parameters. */
+static vx_graph vx_create_pipeline_graph(vx_context context, vx_image input, vx_image output)
+{
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_image virts[] = {
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8),
+            vxCreateVirtualImageWithFormat(context, FOURCC_U8),
+        };
+        vx_node nodes[] = {
+            vxBox3x3Node(graph, input, virts[0]),
+            vxNotNode(graph, virts[0], virts[1]),
+            vxGaussian3x3Node(graph, virts[1], output),
+        };
+        vx_status status = VX_SUCCESS;
+        vx_uint32 i;
+        for (i = 0; i < dimof(nodes); i++)
+        {
+            if (nodes[i] == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+        }
+        if (status == VX_SUCCESS)
+        {
+            status |= vxAddParameterToGraphByIndex(graph, nodes[0], 0);
+            status |= vxAddParameterToGraphByIndex(graph, nodes[2], 1);
+        }
+        for (i = 0; i < dimof(nodes); i++)
+            vxReleaseNode(&nodes[i]);
+        for (i = 0; i < dimof(virts); i++)
+            vxReleaseImage(&virts[i]);
+        if (status != VX_SUCCESS)
+            vxReleaseGraph(&graph);
+    }
+    return graph;
+}
+
+/*! \brief Creates Box3x3 into a real image and a chain of two ConvertDepths
+ * from it, which the target fuses, with the input and output as graph parameters.
+ */
+static vx_graph vx_create_pipeline_fused_graph(vx_context context, vx_image input, vx_image output)
+{
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_uint32 w = 0, h = 0;
+        vx_int32 shift = 1;
+        vx_image shared, virt;
+        vx_scalar sshift = vxCreateScalar(context, VX_TYPE_INT32, &shift);
+        vx_status status = VX_SUCCESS;
+        vx_uint32 i;
+
+        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &w, sizeof(w));
+        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &h, sizeof(h));
+        shared = vxCreateImage(context, w, h, FOURCC_U8);
+        virt = vxCreateVirtualImageWithFormat(context, FOURCC_S16);
+        {
+            vx_node nodes[] = {
+                vxBox3x3Node(graph, input, shared),
+                vxConvertDepthNode(graph, shared, virt, VX_CONVERT_POLICY_SATURATE, sshift),
+                vxConvertDepthNode(graph, virt, output, VX_CONVERT_POLICY_SATURATE, sshift),
+            };
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                if (nodes[i] == 0)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+            }
+            if (status == VX_SUCCESS)
+            {
+                status |= vxAddParameterToGraphByIndex(graph, nodes[0], 0);
+                status |= vxAddParameterToGraphByIndex(graph, nodes[2], 1);
+            }
+            for (i = 0; i < dimof(nodes); i++)
+                vxReleaseNode(&nodes[i]);
+        }
+        vxReleaseImage(&shared);
+        vxReleaseImage(&virt);
+        vxReleaseScalar(&sshift);
+        if (status != VX_SUCCESS)
+            vxReleaseGraph(&graph);
+    }
+    return graph;
+}
+
+/*! \brief Streams frames through a pipelined graph and compares each one
+ * with the same graph processed without pipelining.
+ */
+static vx_status vx_run_pipeline(vx_graph (*create)(vx_context, vx_image, vx_image), vx_uint32 w, vx_uint32 h)
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 f, depth = 3, query = 0, workers = 4;
+        vx_image inputs[8], outputs[dimof(inputs)], expected[dimof(inputs)];
+        vx_graph graph = 0, reference = 0;
+        vx_uint8 *a = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *b = (vx_uint8 *)malloc(w * h);
+
+        for (f = 0; f < dimof(inputs); f++)
+        {
+            inputs[f] = vx_create_image_valuecovering(context, FOURCC_U8, w, h, f * 11, 13 + f);
+            outputs[f] = vxCreateImage(context, w, h, FOURCC_U8);
+            expected[f] = vxCreateImage(context, w, h, FOURCC_U8);
+        }
+        CHECK_ALL_ITEMS(inputs, f, status, exit);
+        CHECK_ALL_ITEMS(outputs, f, status, exit);
+        CHECK_ALL_ITEMS(expected, f, status, exit);
+        graph = create(context, inputs[0], outputs[0]);
+        reference = create(context, inputs[0], expected[0]);
+        if (graph == 0 || reference == 0 || a == NULL || b == NULL)
+        {
+            ALARM("failed to create the graphs");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        /* frames only overlap with workers, whatever the processors of the host */
+        status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_NUM_WORKERS, &workers, sizeof(workers));
+        if (status == VX_SUCCESS)
+            status = vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH, &depth, sizeof(depth));
+        if (status == VX_SUCCESS)
+            status = vxQueryGraph(graph, VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH, &query, sizeof(query));
+        if (status == VX_SUCCESS)
+            status = vxVerifyGraph(graph);
+        if (status != VX_SUCCESS || query != depth)
+        {
+            VALARM("failed to pipeline the graph %u deep", depth);
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        /* stream the frames, keeping the pipeline full */
+        for (f = 0; f < dimof(inputs) && status == VX_SUCCESS; f++)
+        {
+            status |= vxSetGraphParameterByIndex(graph, 0, VX_INPUT, (vx_reference)inputs[f]);
+            status |= vxSetGraphParameterByIndex(graph, 1, VX_OUTPUT, (vx_reference)outputs[f]);
+            if (status == VX_SUCCESS)
+                status = vxScheduleGraph(graph);
+            if (status == VX_SUCCESS && f == depth - 1 &&
+                vxScheduleGraph(graph) != VX_ERROR_GRAPH_SCHEDULED)
+            {
+                ALARM("more frames were scheduled than the pipeline depth");
+                status = VX_FAILURE;
+            }
+            if (status == VX_SUCCESS && f + 1 >= depth)
+                status = vxWaitGraph(graph);
+        }
+        for (f = 0; f < depth - 1; f++)
+        {
+            vx_status s = vxWaitGraph(graph);
+            if (status == VX_SUCCESS)
+                status = s;
+        }
+        for (f = 0; f < dimof(inputs) && status == VX_SUCCESS; f++)
+        {
+            status |= vxSetGraphParameterByIndex(reference, 0, VX_INPUT, (vx_reference)inputs[f]);
+            status |= vxSetGraphParameterByIndex(reference, 1, VX_OUTPUT, (vx_reference)expected[f]);
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(reference);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(expected[f], w, h, sizeof(vx_uint8), a);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(outputs[f], w, h, sizeof(vx_uint8), b);
+            if (status == VX_SUCCESS && memcmp(a, b, w * h) != 0)
+            {
+                VALARM("frame %u differs from the unpipelined graph", f);
+                status = VX_FAILURE;
+            }
+        }
+exit:
+        vxReleaseGraph(&graph);
+        vxReleaseGraph(&reference);
+        for (f = 0; f < dimof(inputs); f++)
+        {
+            vxReleaseImage(&inputs[f]);
+            vxReleaseImage(&outputs[f]);
+            vxReleaseImage(&expected[f]);
+        }
+        free(a);
+        free(b);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_pipeline(int argc, char *argv[])
+{
+    return vx_run_pipeline(vx_create_pipeline_graph, 160, 120);
+}
+
+/*! \brief The Box3x3 of the next frame may only overwrite its output once the
+ * fused chain reading it has finished the previous frame.
+ */
+vx_status vx_test_graph_pipeline_fused(int argc, char *argv[])
+{
+    return vx_run_pipeline(vx_create_pipeline_fused_graph, 640, 480);
+}
+
+/*! \brief Checks that the statistics describe a consistent distribution of the given number of values. */
+static vx_bool vx_check_perf_stats(vx_perf_stats_t *stats, vx_uint64 num)
+{
+    return (vx_bool)((stats->num == num) &&
+                     (stats->min <= stats->p50) &&
+                     (stats->p50 <= stats->p95) &&
+                     (stats->p95 <= stats->p99) &&
+                     (stats->p99 <= stats->max) &&
+                     (stats->avg >= stats->min) &&
+                     (stats->avg <= stats->max));
+}
+
+vx_status vx_test_graph_performance(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 i, r, runs = 20, w = 320, h = 240;
+        vx_perf_stats_t gstats, query;
+        vx_image input = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 1, 9);
+        vx_image output = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image virt = vxCreateVirtualImageWithFormat(context, FOURCC_U8);
+        vx_graph graph = vxCreateGraph(context);
+        vx_node nodes[] = {
+            vxBox3x3Node(graph, input, virt),
+            vxGaussian3x3Node(graph, virt, output),
+        };
+        vx_perf_stats_t nstats[dimof(nodes)];
+
+        if (input == 0 || output == 0 || graph == 0 || nodes[0] == 0 || nodes[1] == 0)
+        {
+            ALARM("failed to create the graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        status = VX_SUCCESS;
+        for (r = 0; r < runs && status == VX_SUCCESS; r++)
+        {
+            status = vxProcessGraph(graph);
+        }
+        if (status == VX_SUCCESS)
+            status = vxGetGraphPerformanceStats(graph, &gstats, nstats, dimof(nstats));
+        if (status == VX_SUCCESS && vx_check_perf_stats(&gstats, runs) == vx_false_e)
+        {
+            VALARM("graph stats are inconsistent, num="VX_FMT_SIZE, (vx_size)gstats.num);
+            status = VX_FAILURE;
+        }
+        for (i = 0; i < dimof(nstats) && status == VX_SUCCESS; i++)
+        {
+            /* a node fused into another has no executions of its own */
+            if ((nstats[i].num != 0 && vx_check_perf_stats(&nstats[i], runs) == vx_false_e) ||
+                (nstats[i].num == 0 && i == dimof(nstats) - 1) ||
+                (nstats[i].bytes < 2 * w * h))
+            {
+                VALARM("node %u stats are inconsistent, num="VX_FMT_SIZE" bytes="VX_FMT_SIZE, i, (vx_size)nstats[i].num, (vx_size)nstats[i].bytes);
+                status = VX_FAILURE;
+            }
+        }
+        if (status == VX_SUCCESS && gstats.bytes < nstats[0].bytes)
+        {
+            ALARM("graph bytes do not include its nodes");
+            status = VX_FAILURE;
+        }
+        if (status == VX_SUCCESS)
+            status = vxResetGraphPerformance(graph);
+        if (status == VX_SUCCESS)
+            status = vxQueryGraph(graph, VX_GRAPH_ATTRIBUTE_PERFORMANCE_STATS, &query, sizeof(query));
+        if (status == VX_SUCCESS && query.num != 0)
+        {
+            ALARM("graph stats were not reset");
+            status = VX_FAILURE;
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        if (status == VX_SUCCESS)
+        {
+            /* the last node is never fused into another */
+            status = vxQueryNode(nodes[dimof(nodes) - 1], VX_NODE_ATTRIBUTE_PERFORMANCE_STATS, &query, sizeof(query));
+        }
+        if (status == VX_SUCCESS && vx_check_perf_stats(&query, 1) == vx_false_e)
+        {
+            VALARM("node stats after reset are inconsistent, num="VX_FMT_SIZE, (vx_size)query.num);
+            status = VX_FAILURE;
+        }
+exit:
+        for (i = 0; i < dimof(nodes); i++)
+        {
+            vxReleaseNode(&nodes[i]);
+        }
+        vxReleaseGraph(&graph);
+        vxReleaseImage(&virt);
+        vxReleaseImage(&input);
+        vxReleaseImage(&output);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_trace(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_char path[] = "vx_test_trace.json";
+        vx_char empty[] = "";
+        vx_char query[256];
+        vx_uint32 i, w = 320, h = 240;
+        vx_image input = vx_create_image_valuecovering(context, FOURCC_U8, w, h, 1, 9);
+        vx_image output = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image virt = vxCreateVirtualImageWithFormat(context, FOURCC_U8);
+        vx_graph graph = vxCreateGraph(context);
+        vx_node nodes[] = {
+            vxBox3x3Node(graph, input, virt),
+            vxGaussian3x3Node(graph, virt, output),
+        };
+        FILE *fp = NULL;
+        char *trace = NULL;
+        long size = 0;
+
+        if (input == 0 || output == 0 || graph == 0 || nodes[0] == 0 || nodes[1] == 0)
+        {
+            ALARM("failed to create the graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_TRACE_FILE, path, sizeof(path));
+        if (status == VX_SUCCESS)
+            status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_TRACE_FILE, query, sizeof(query));
+        if (status == VX_SUCCESS && strcmp(query, path) != 0)
+        {
+            VALARM("trace file is %s", query);
+            status = VX_FAILURE;
+        }
+        if (status == VX_SUCCESS)
+            status = vxScheduleGraph(graph);
+        if (status == VX_SUCCESS)
+            status = vxWaitGraph(graph);
+        if (status == VX_SUCCESS)
+            status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_TRACE_FILE, empty, sizeof(empty));
+        if (status == VX_SUCCESS)
+            status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_TRACE_FILE, query, sizeof(query));
+        if (status == VX_SUCCESS && query[0] != '\0')
+        {
+            ALARM("trace was not stopped");
+            status = VX_FAILURE;
+        }
+        if (status == VX_SUCCESS)
+        {
+            fp = fopen(path, "rb");
+            if (fp)
+            {
+                fseek(fp, 0, SEEK_END);
+                size = ftell(fp);
+                fseek(fp, 0, SEEK_SET);
+                trace = calloc(1, size + 1);
+                if (trace && fread(trace, 1, size, fp) != (size_t)size)
+                    size = 0;
+                fclose(fp);
+                remove(path);
+            }
+            /* the queueing, the graph and the last node must all be on the timeline */
+            if (trace == NULL || size == 0 ||
+                strstr(trace, "\"traceEvents\"") == NULL ||
+                strstr(trace, "\"ph\":\"b\"") == NULL ||
+                strstr(trace, "\"ph\":\"e\"") == NULL ||
+                strstr(trace, "\"cat\":\"graph\",\"ph\":\"X\"") == NULL ||
+                strstr(trace, "\"cat\":\"node\",\"ph\":\"X\"") == NULL)
+            {
+                ALARM("trace file is missing events");
+                status = VX_FAILURE;
+            }
+            free(trace);
+        }
+exit:
+        for (i = 0; i < dimof(nodes); i++)
+        {
+            vxReleaseNode(&nodes[i]);
+        }
+        vxReleaseGraph(&graph);
+        vxReleaseImage(&virt);
+        vxReleaseImage(&input);
+        vxReleaseImage(&output);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+static int vx_compare_u8(const void *p1, const void *p2)
+{
+    return (int)*(const vx_uint8 *)p1 - (int)*(const vx_uint8 *)p2;
+}
+
+/*! \brief Computes a 3x3 filter at one pixel the slow and obvious way. */
+static vx_uint8 vx_reference_filter3x3(vx_enum kernel, const vx_uint8 *in, vx_uint32 w, vx_uint32 x, vx_uint32 y)
+{
+    static const vx_int32 gaussian[9] = {1, 2, 1, 2, 4, 2, 1, 2, 1};
+    vx_uint8 p[9];
+    vx_int32 sum = 0, weighted = 0;
+    vx_uint32 i, j;
+    for (j = 0; j < 3; j++)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            p[j * 3 + i] = in[(y + j - 1) * w + (x + i - 1)];
+            sum += p[j * 3 + i];
+            weighted += gaussian[j * 3 + i] * p[j * 3 + i];
+        }
+    }
+    qsort(p, dimof(p), sizeof(vx_uint8), vx_compare_u8);
+    switch (kernel)
+    {
+        case VX_KERNEL_BOX_3x3:      return (vx_uint8)(sum / 9);
+        case VX_KERNEL_GAUSSIAN_3x3: return (vx_uint8)(weighted / 16);
+        case VX_KERNEL_MEDIAN_3x3:   return p[4];
+        case VX_KERNEL_ERODE_3x3:    return p[0];
+        default:                     return p[8];
+    }
+}
+
+vx_status vx_test_graph_filters(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        /* an odd size leaves ends of rows which are shorter than a vector */
+        vx_uint32 i, x, y, w = 67, h = 35;
+        vx_enum kernels[] = {
+            VX_KERNEL_BOX_3x3,
+            VX_KERNEL_GAUSSIAN_3x3,
+            VX_KERNEL_MEDIAN_3x3,
+            VX_KERNEL_ERODE_3x3,
+            VX_KERNEL_DILATE_3x3,
+        };
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image outputs[] = {
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_U8),
+        };
+        vx_graph graph = vxCreateGraph(context);
+        vx_node nodes[] = {
+            vxBox3x3Node(graph, input, outputs[0]),
+            vxGaussian3x3Node(graph, input, outputs[1]),
+            vxMedian3x3Node(graph, input, outputs[2]),
+            vxErode3x3Node(graph, input, outputs[3]),
+            vxDilate3x3Node(graph, input, outputs[4]),
+        };
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *out = (vx_uint8 *)malloc(w * h);
+        vx_rectangle rect = vxCreateRectangle(context, 0, 0, w, h);
+        vx_imagepatch_addressing_t addr;
+        void *base = NULL;
+
+        status = VX_SUCCESS;
+        for (i = 0; i < dimof(nodes); i++)
+        {
+            if (nodes[i] == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+        }
+        if (in == NULL || out == NULL || input == 0 || graph == 0 || status != VX_SUCCESS)
+        {
+            ALARM("failed to create the graph");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        srand(3);
+        for (i = 0; i < w * h; i++)
+            in[i] = (vx_uint8)rand();
+        status = vxAccessImagePatch(input, rect, 0, &addr, &base);
+        if (status == VX_SUCCESS)
+        {
+            for (y = 0; y < h; y++)
+                memcpy(vxFormatImagePatchAddress2d(base, 0, y, &addr), &in[y * w], w);
+            status = vxCommitImagePatch(input, rect, 0, &addr, base);
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        for (i = 0; (i < dimof(kernels)) && (status == VX_SUCCESS); i++)
+        {
+            status = vx_read_image(outputs[i], w, h, sizeof(vx_uint8), out);
+            for (y = 1; (y < h - 1) && (status == VX_SUCCESS); y++)
+            {
+                for (x = 1; x < w - 1; x++)
+                {
+                    vx_uint8 expected = vx_reference_filter3x3(kernels[i], in, w, x, y);
+                    if (out[y * w + x] != expected)
+                    {
+                        VALARM("filter %u differs at %u,%u: %u != %u", i, x, y, out[y * w + x], expected);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                }
+            }
+        }
+exit:
+        for (i = 0; i < dimof(nodes); i++)
+        {
+            vxReleaseNode(&nodes[i]);
+            vxReleaseImage(&outputs[i]);
+        }
+        vxReleaseRectangle(&rect);
+        vxReleaseGraph(&graph);
+        vxReleaseImage(&input);
+        free(in);
+        free(out);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+typedef struct _vx_pointwise_case_t {
+    vx_enum kernel;
+    vx_fourcc formats[3];
+    vx_enum policy;
+    vx_float32 scale;
+} vx_pointwise_case_t;
+
+/*! \brief Computes a pointwise kernel at one pixel the slow and obvious way. */
+static vx_int32 vx_reference_pointwise(const vx_pointwise_case_t *c, vx_int32 a, vx_int32 b)
+{
+    vx_int32 v = 0;
+    switch (c->kernel)
+    {
+        case VX_KERNEL_ADD:       v = a + b; break;
+        case VX_KERNEL_SUBTRACT:  v = a - b; break;
+        case VX_KERNEL_MULTIPLY:  v = (vx_int32)(c->scale * (vx_float32)(a * b)); break;
+        case VX_KERNEL_ABSDIFF:   return (a > b) ? a - b : b - a;
+        case VX_KERNEL_AND:       return a & b;
+        case VX_KERNEL_OR:        return a | b;
+        case VX_KERNEL_XOR:       return a ^ b;
+        case VX_KERNEL_NOT:       return (vx_uint8)~a;
+        case VX_KERNEL_THRESHOLD: return ((a >= 50) && (a <= 180)) ? 255 : 0;
+        default:                  return 255 - a;
+    }
+    if (c->formats[2] == FOURCC_U8)
+    {
+        if (c->policy == VX_CONVERT_POLICY_SATURATE)
+            return (v < 0) ? 0 : ((v > UINT8_MAX) ? UINT8_MAX : v);
+        return (vx_uint8)v;
+    }
+    if (c->policy == VX_CONVERT_POLICY_SATURATE)
+        return (v < INT16_MIN) ? INT16_MIN : ((v > INT16_MAX) ? INT16_MAX : v);
+    return (vx_int16)v;
+}
+
+vx_status vx_test_graph_pointwise(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_enum wrap = VX_CONVERT_POLICY_TRUNCATE, sat = VX_CONVERT_POLICY_SATURATE;
+        const vx_pointwise_case_t cases[] = {
+            {VX_KERNEL_ADD,         {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_ADD,         {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  sat,  0.0f},
+            {VX_KERNEL_ADD,         {FOURCC_S16, FOURCC_U8,  FOURCC_S16}, sat,  0.0f},
+            {VX_KERNEL_ADD,         {FOURCC_S16, FOURCC_S16, FOURCC_S16}, wrap, 0.0f},
+            {VX_KERNEL_SUBTRACT,    {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  sat,  0.0f},
+            {VX_KERNEL_SUBTRACT,    {FOURCC_U8,  FOURCC_U8,  FOURCC_S16}, wrap, 0.0f},
+            {VX_KERNEL_SUBTRACT,    {FOURCC_U8,  FOURCC_S16, FOURCC_S16}, wrap, 0.0f},
+            {VX_KERNEL_SUBTRACT,    {FOURCC_S16, FOURCC_S16, FOURCC_S16}, sat,  0.0f},
+            {VX_KERNEL_MULTIPLY,    {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  sat,  0.1f},
+            {VX_KERNEL_MULTIPLY,    {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.5f},
+            {VX_KERNEL_MULTIPLY,    {FOURCC_U8,  FOURCC_S16, FOURCC_S16}, sat,  0.25f},
+            {VX_KERNEL_MULTIPLY,    {FOURCC_S16, FOURCC_S16, FOURCC_S16}, wrap, 1.0f},
+            {VX_KERNEL_ABSDIFF,     {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_AND,         {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_OR,          {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_XOR,         {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_NOT,         {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_THRESHOLD,   {FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+            {VX_KERNEL_TABLE_LOOKUP,{FOURCC_U8,  FOURCC_U8,  FOURCC_U8},  wrap, 0.0f},
+        };
+        /* an odd width leaves ends of rows which are shorter than a vector */
+        vx_uint32 c, i, w = 67, h = 9;
+        vx_uint8 lower = 50, upper = 180;
+        vx_uint8 *u8[2] = {(vx_uint8 *)malloc(w * h), (vx_uint8 *)malloc(w * h)};
+        vx_int16 *s16[2] = {(vx_int16 *)malloc(w * h * sizeof(vx_int16)), (vx_int16 *)malloc(w * h * sizeof(vx_int16))};
+        vx_int16 *out = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_image images[2][2] = {
+            {vxCreateImage(context, w, h, FOURCC_U8), vxCreateImage(context, w, h, FOURCC_U8)},
+            {vxCreateImage(context, w, h, FOURCC_S16), vxCreateImage(context, w, h, FOURCC_S16)},
+        };
+        vx_image outputs[dimof(cases)];
+        vx_scalar scales[dimof(cases)];
+        vx_threshold thresh = vxCreateThreshold(context, VX_THRESHOLD_TYPE_RANGE);
+        vx_lut lut = vxCreateLUT(context, VX_TYPE_UINT8, 256);
+        vx_uint8 *table = NULL;
+        vx_graph graph = vxCreateGraph(context);
+
+        memset(outputs, 0, sizeof(outputs));
+        memset(scales, 0, sizeof(scales));
+        if (!u8[0] || !u8[1] || !s16[0] || !s16[1] || !out || !graph || !thresh || !lut)
+        {
+            ALARM("failed to allocate the test");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        srand(5);
+        for (i = 0; i < w * h; i++)
+        {
+            u8[0][i] = (vx_uint8)rand();
+            u8[1][i] = (vx_uint8)rand();
+            s16[0][i] = (vx_int16)rand();
+            s16[1][i] = (vx_int16)rand();
+        }
+        status = VX_SUCCESS;
+        status |= vx_write_image(images[0][0], w, h, sizeof(vx_uint8), u8[0]);
+        status |= vx_write_image(images[0][1], w, h, sizeof(vx_uint8), u8[1]);
+        status |= vx_write_image(images[1][0], w, h, sizeof(vx_int16), s16[0]);
+        status |= vx_write_image(images[1][1], w, h, sizeof(vx_int16), s16[1]);
+        status |= vxSetThresholdAttribute(thresh, VX_THRESHOLD_ATTRIBUTE_LOWER, &lower, sizeof(lower));
+        status |= vxSetThresholdAttribute(thresh, VX_THRESHOLD_ATTRIBUTE_UPPER, &upper, sizeof(upper));
+        status |= vxAccessLUT(lut, (void **)&table);
+        if (status == VX_SUCCESS)
+        {
+            for (i = 0; i < 256; i++)
+                table[i] = (vx_uint8)(255 - i);
+            status = vxCommitLUT(lut, table);
+        }
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            const vx_pointwise_case_t *pc = &cases[c];
+            vx_image a = images[pc->formats[0] == FOURCC_S16][0];
+            vx_image b = images[pc->formats[1] == FOURCC_S16][1];
+            vx_node node = 0;
+            outputs[c] = vxCreateImage(context, w, h, pc->formats[2]);
+            scales[c] = vxCreateScalar(context, VX_TYPE_FLOAT32, (void *)&pc->scale);
+            switch (pc->kernel)
+            {
+                case VX_KERNEL_ADD:       node = vxAddNode(graph, a, b, pc->policy, outputs[c]); break;
+                case VX_KERNEL_SUBTRACT:  node = vxSubtractNode(graph, a, b, pc->policy, outputs[c]); break;
+                case VX_KERNEL_MULTIPLY:  node = vxMultiplyNode(graph, a, b, scales[c], pc->policy, outputs[c]); break;
+                case VX_KERNEL_ABSDIFF:   node = vxAbsDiffNode(graph, a, b, outputs[c]); break;
+                case VX_KERNEL_AND:       node = vxAndNode(graph, a, b, outputs[c]); break;
+                case VX_KERNEL_OR:        node = vxOrNode(graph, a, b, outputs[c]); break;
+                case VX_KERNEL_XOR:       node = vxXorNode(graph, a, b, outputs[c]); break;
+                case VX_KERNEL_NOT:       node = vxNotNode(graph, a, outputs[c]); break;
+                case VX_KERNEL_THRESHOLD: node = vxThresholdNode(graph, a, thresh, outputs[c]); break;
+                default:                  node = vxTableLookupNode(graph, a, lut, outputs[c]); break;
+            }
+            if (node == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            vxReleaseNode(&node);
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            const vx_pointwise_case_t *pc = &cases[c];
+            status = vx_read_image(outputs[c], w, h, (pc->formats[2] == FOURCC_U8) ? sizeof(vx_uint8) : sizeof(vx_int16), out);
+            for (i = 0; (i < w * h) && (status == VX_SUCCESS); i++)
+            {
+                vx_int32 a = (pc->formats[0] == FOURCC_U8) ? u8[0][i] : s16[0][i];
+                vx_int32 b = (pc->formats[1] == FOURCC_U8) ? u8[1][i] : s16[1][i];
+                vx_int32 result = (pc->formats[2] == FOURCC_U8) ? ((vx_uint8 *)out)[i] : out[i];
+                vx_int32 expected = vx_reference_pointwise(pc, a, b);
+                if (result != expected)
+                {
+                    VALARM("case %u differs at %u,%u: %d != %d", c, i % w, i / w, result, expected);
+                    status = VX_FAILURE;
+                }
+            }
+        }
+exit:
+        for (c = 0; c < dimof(cases); c++)
+        {
+            vxReleaseImage(&outputs[c]);
+            vxReleaseScalar(&scales[c]);
+        }
+        for (i = 0; i < 4; i++)
+            vxReleaseImage(&images[i / 2][i % 2]);
+        vxReleaseThreshold(&thresh);
+        vxReleaseLUT(&lut);
+        vxReleaseGraph(&graph);
+        free(u8[0]);
+        free(u8[1]);
+        free(s16[0]);
+        free(s16[1]);
+        free(out);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_gradients(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        /* an odd width leaves ends of rows which are shorter than a vector */
+        vx_uint32 i, w = 131, h = 17;
+        const vx_int16 extremes[] = {INT16_MIN, INT16_MIN + 1, -1, 0, 1, INT16_MAX};
+        vx_int16 *gx = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_int16 *gy = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_int16 *mag16 = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_uint8 *mag8 = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *phase = (vx_uint8 *)malloc(w * h);
+        vx_image images[] = {
+            vxCreateImage(context, w, h, FOURCC_S16),
+            vxCreateImage(context, w, h, FOURCC_S16),
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_S16),
+            vxCreateImage(context, w, h, FOURCC_U8),
+        };
+        vx_graph graph = vxCreateGraph(context);
+        if (!gx || !gy || !mag16 || !mag8 || !phase || !graph)
+        {
+            ALARM("failed to allocate the test");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        srand(7);
+        for (i = 0; i < w * h; i++)
+        {
+            switch (i / w % 3)
+            {
+                case 0: /* the full range */
+                    gx[i] = (vx_int16)rand();
+                    gy[i] = (vx_int16)rand();
+                    break;
+                case 1: /* the angles between small gradients are far apart */
+                    gx[i] = (vx_int16)(rand() % 9 - 4);
+                    gy[i] = (vx_int16)(rand() % 9 - 4);
+                    break;
+                default:
+                    gx[i] = extremes[rand() % dimof(extremes)];
+                    gy[i] = extremes[rand() % dimof(extremes)];
+                    break;
+            }
+        }
+        status = VX_SUCCESS;
+        status |= vx_write_image(images[0], w, h, sizeof(vx_int16), gx);
+        status |= vx_write_image(images[1], w, h, sizeof(vx_int16), gy);
+        if (status == VX_SUCCESS)
+        {
+            vx_node nodes[] = {
+                vxMagnitudeNode(graph, images[0], images[1], images[2]),
+                vxMagnitudeNode(graph, images[0], images[1], images[3]),
+                vxPhaseNode(graph, images[0], images[1], images[4]),
+            };
+            for (i = 0; i < dimof(nodes); i++)
+            {
+                if (nodes[i] == 0)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                vxReleaseNode(&nodes[i]);
+            }
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        if (status == VX_SUCCESS)
+        {
+            status |= vx_read_image(images[2], w, h, sizeof(vx_uint8), mag8);
+            status |= vx_read_image(images[3], w, h, sizeof(vx_int16), mag16);
+            status |= vx_read_image(images[4], w, h, sizeof(vx_uint8), phase);
+        }
+        for (i = 0; (i < w * h) && (status == VX_SUCCESS); i++)
+        {
+            vx_float64 sum = (vx_float64)gx[i] * gx[i] + (vx_float64)gy[i] * gy[i];
+            vx_int32 m = (vx_int32)sqrt(sum);
+            vx_float64 angle = atan2((vx_float64)gy[i], (vx_float64)gx[i]);
+            vx_uint8 p = (vx_uint8)(((angle < 0.0 ? VX_TAU + angle : angle) * 255.0) / VX_TAU);
+            if ((mag8[i] != (m / 4 > UINT8_MAX ? UINT8_MAX : m / 4)) ||
+                (mag16[i] != (m > INT16_MAX ? INT16_MAX : m)) ||
+                (phase[i] != p))
+            {
+                VALARM("gradient %d,%d gives magnitudes %u,%d and phase %u, not %d and %u",
+                       gx[i], gy[i], mag8[i], mag16[i], phase[i], m, p);
+                status = VX_FAILURE;
+            }
+        }
+exit:
+        for (i = 0; i < dimof(images); i++)
+            vxReleaseImage(&images[i]);
+        vxReleaseGraph(&graph);
+        free(gx);
+        free(gy);
+        free(mag16);
+        free(mag8);
+        free(phase);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+typedef struct _vx_convolve_case_t {
+    vx_size columns;
+    vx_size rows;
+    vx_uint32 scale;
+    vx_fourcc formats[2];
+    vx_int16 mat[7*7];
+} vx_convolve_case_t;
+
+/*! \brief Compares a convolution with the sum over its matrix, away from the borders. */
+static vx_status vx_compare_convolution(const vx_convolve_case_t *cc, const vx_uint8 *u8, const vx_int16 *s16,
+                                        const void *output, vx_uint32 w, vx_uint32 h)
+{
+    vx_uint32 x, y, i, j, c = (vx_uint32)cc->columns / 2, r = (vx_uint32)cc->rows / 2;
+    for (y = r; y < h - r; y++)
+    {
+        for (x = c; x < w - c; x++)
+        {
+            vx_int32 sum = 0, result;
+            for (j = 0; j < cc->rows; j++)
+            {
+                for (i = 0; i < cc->columns; i++)
+                {
+                    vx_uint32 p = (y - r + j) * w + (x - c + i);
+                    sum += cc->mat[j * cc->columns + i] * (cc->formats[0] == FOURCC_U8 ? u8[p] : s16[p]);
+                }
+            }
+            sum /= (vx_int32)cc->scale;
+            if (cc->formats[1] == FOURCC_U8)
+            {
+                sum = (sum < 0) ? 0 : ((sum > UINT8_MAX) ? UINT8_MAX : sum);
+                result = ((const vx_uint8 *)output)[y * w + x];
+            }
+            else
+            {
+                sum = (sum < INT16_MIN) ? INT16_MIN : ((sum > INT16_MAX) ? INT16_MAX : sum);
+                result = ((const vx_int16 *)output)[y * w + x];
+            }
+            if (result != sum)
+            {
+                VALARM(VX_FMT_SIZE"x"VX_FMT_SIZE" differs at %u,%u: %d != %d",
+                       (vx_size)cc->columns, (vx_size)cc->rows, x, y, result, sum);
+                return VX_FAILURE;
+            }
+        }
+    }
+    return VX_SUCCESS;
+}
+
+vx_status vx_test_graph_convolutions(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_convolve_case_t cases[] = {
+            /* a binomial, which factors */
+            {5, 5, 256, {FOURCC_U8, FOURCC_U8}, {1, 4, 6, 4, 1,  4,16,24,16, 4,  6,24,36,24, 6,  4,16,24,16, 4,  1, 4, 6, 4, 1}},
+            /* a derivative of a binomial, which factors with negative coefficients */
+            {7, 7, 1, {FOURCC_U8, FOURCC_S16}, {0}},
+            /* does not factor */
+            {5, 5, 16, {FOURCC_U8, FOURCC_U8}, {0}},
+            /* is not square */
+            {5, 3, 4, {FOURCC_U8, FOURCC_S16}, {1, 2, 0,-2,-1,  2, 4, 0,-4,-2,  1, 2, 0,-2,-1}},
+            /* factors but the sums of the rows would overflow 16 bits */
+            {3, 3, 32, {FOURCC_U8, FOURCC_S16}, {127, 128, 127,  254, 256, 254,  127, 128, 127}},
+            /* factors but takes S16 pixels */
+            {3, 3, 2, {FOURCC_S16, FOURCC_S16}, {-1, 0, 1, -2, 0, 2, -1, 0, 1}},
+        };
+        const vx_int16 binomial[7] = {1, 6, 15, 20, 15, 6, 1}, derivative[7] = {-1, -4, -5, 0, 5, 4, 1};
+        vx_uint32 c, i, w = 83, h = 41;
+        vx_uint8 *u8 = (vx_uint8 *)malloc(w * h);
+        vx_int16 *s16 = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_int16 *out = (vx_int16 *)malloc(w * h * sizeof(vx_int16));
+        vx_image inputs[2] = {
+            vxCreateImage(context, w, h, FOURCC_U8),
+            vxCreateImage(context, w, h, FOURCC_S16),
+        };
+        vx_image outputs[dimof(cases)];
+        vx_convolution convs[dimof(cases)];
+        vx_graph graph = vxCreateGraph(context);
+
+        memset(outputs, 0, sizeof(outputs));
+        memset(convs, 0, sizeof(convs));
+        for (i = 0; i < 7 * 7; i++)
+            cases[1].mat[i] = binomial[i / 7] * derivative[i % 7];
+        srand(11);
+        for (i = 0; i < 5 * 5; i++)
+            cases[2].mat[i] = (vx_int16)(rand() % 21 - 10);
+        if (!u8 || !s16 || !out || !graph)
+        {
+            ALARM("failed to allocate the test");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        for (i = 0; i < w * h; i++)
+        {
+            u8[i] = (vx_uint8)rand();
+            s16[i] = (vx_int16)(rand() % 20001 - 10000);
+        }
+        status = VX_SUCCESS;
+        status |= vx_write_image(inputs[0], w, h, sizeof(vx_uint8), u8);
+        status |= vx_write_image(inputs[1], w, h, sizeof(vx_int16), s16);
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            vx_node node = 0;
+            outputs[c] = vxCreateImage(context, w, h, cases[c].formats[1]);
+            convs[c] = vxCreateConvolution(context, cases[c].columns, cases[c].rows);
+            status |= vxAccessConvolutionCoefficients(convs[c], NULL);
+            status |= vxCommitConvolutionCoefficients(convs[c], cases[c].mat);
+            status |= vxSetConvolutionAttribute(convs[c], VX_CONVOLUTION_ATTRIBUTE_SCALE, &cases[c].scale, sizeof(cases[c].scale));
+            node = vxConvolveNode(graph, inputs[cases[c].formats[0] == FOURCC_S16], convs[c], outputs[c]);
+            if (node == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            vxReleaseNode(&node);
+        }
+        /* the second time, the binomial is changed after verification into one which does not factor */
+        for (i = 0; (i < 2) && (status == VX_SUCCESS); i++)
+        {
+            if (i == 1)
+            {
+                cases[0].mat[0] = 3;
+                status |= vxAccessConvolutionCoefficients(convs[0], NULL);
+                status |= vxCommitConvolutionCoefficients(convs[0], cases[0].mat);
+            }
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+            {
+                vx_size size = (cases[c].formats[1] == FOURCC_U8) ? sizeof(vx_uint8) : sizeof(vx_int16);
+                status = vx_read_image(outputs[c], w, h, size, out);
+                if (status == VX_SUCCESS)
+                    status = vx_compare_convolution(&cases[c], u8, s16, out, w, h);
+            }
+        }
+exit:
+        for (c = 0; c < dimof(cases); c++)
+        {
+            vxReleaseImage(&outputs[c]);
+            vxReleaseConvolution(&convs[c]);
+        }
+        vxReleaseImage(&inputs[0]);
+        vxReleaseImage(&inputs[1]);
+        vxReleaseGraph(&graph);
+        free(u8);
+        free(s16);
+        free(out);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief Computes a rank of a window the slow way, by sorting.
+ * \param [in] rank 0 for the minimum, columns*rows/2 for the median, columns*rows-1 for the maximum.
+ */
+static vx_uint8 vx_rank_reference(vx_uint8 *img, vx_uint32 w, vx_uint32 x, vx_uint32 y,
+                                  vx_uint32 columns, vx_uint32 rows, vx_uint32 rank)
+{
+    vx_uint32 count[256] = {0};
+    vx_uint32 i, j, sum = 0, v = 0;
+    for (j = 0; j < rows; j++)
+        for (i = 0; i < columns; i++)
+            count[img[(y + j - rows/2) * w + (x + i - columns/2)]]++;
+    while (sum + count[v] <= rank)
+        sum += count[v++];
+    return (vx_uint8)v;
+}
+
+vx_status vx_test_graph_rank_filters(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        typedef struct _rank_case_t {
+            vx_enum kernel;
+            vx_uint32 columns;
+            vx_uint32 rows;
+        } rank_case_t;
+        rank_case_t cases[] = {
+            {VX_KERNEL_EXTRAS_MEDIAN_MxN, 3, 3},
+            {VX_KERNEL_EXTRAS_MEDIAN_MxN, 5, 5},
+            {VX_KERNEL_EXTRAS_MEDIAN_MxN, 7, 3},
+            {VX_KERNEL_EXTRAS_MEDIAN_MxN, 15, 15},
+            {VX_KERNEL_EXTRAS_ERODE_MxN, 5, 5},
+            {VX_KERNEL_EXTRAS_ERODE_MxN, 9, 3},
+            {VX_KERNEL_EXTRAS_ERODE_MxN, 15, 15},
+            {VX_KERNEL_EXTRAS_DILATE_MxN, 7, 7},
+            {VX_KERNEL_EXTRAS_DILATE_MxN, 3, 11},
+        };
+        vx_uint32 c, x, y, w = 97, h = 53;
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *out = (vx_uint8 *)malloc(w * h);
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image outputs[dimof(cases)];
+        vx_scalar scalars[dimof(cases)][2];
+        vx_graph graph = vxCreateGraph(context);
+
+        memset(outputs, 0, sizeof(outputs));
+        memset(scalars, 0, sizeof(scalars));
+        status = vxLoadKernels(context, "openvx-extras");
+        if (!in || !out || !graph)
+        {
+            ALARM("failed to allocate the test");
+            status = VX_ERROR_NOT_SUFFICIENT;
+            goto exit;
+        }
+        /* smooth gradients with salt noise give runs of equal values as well as outliers */
+        srand(15);
+        for (y = 0; y < h; y++)
+            for (x = 0; x < w; x++)
+                in[y * w + x] = (rand() % 8 == 0) ? (vx_uint8)rand() : (vx_uint8)((x * 5 + y * 3) / 4);
+        status |= vx_write_image(input, w, h, sizeof(vx_uint8), in);
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            vx_node node = 0;
+            outputs[c] = vxCreateImage(context, w, h, FOURCC_U8);
+            scalars[c][0] = vxCreateScalar(context, VX_TYPE_UINT32, &cases[c].columns);
+            scalars[c][1] = vxCreateScalar(context, VX_TYPE_UINT32, &cases[c].rows);
+            if (cases[c].kernel == VX_KERNEL_EXTRAS_MEDIAN_MxN)
+                node = vxMedianMxNNode(graph, input, scalars[c][0], scalars[c][1], outputs[c]);
+            else if (cases[c].kernel == VX_KERNEL_EXTRAS_ERODE_MxN)
+                node = vxErodeMxNNode(graph, input, scalars[c][0], scalars[c][1], outputs[c]);
+            else
+                node = vxDilateMxNNode(graph, input, scalars[c][0], scalars[c][1], outputs[c]);
+            if (node == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            vxReleaseNode(&node);
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            vx_uint32 cx = cases[c].columns / 2, cy = cases[c].rows / 2;
+            vx_uint32 rank = (cases[c].columns * cases[c].rows) / 2;
+            if (cases[c].kernel == VX_KERNEL_EXTRAS_ERODE_MxN)
+                rank = 0;
+            else if (cases[c].kernel == VX_KERNEL_EXTRAS_DILATE_MxN)
+                rank = cases[c].columns * cases[c].rows - 1;
+            status = vx_read_image(outputs[c], w, h, sizeof(vx_uint8), out);
+            for (y = cy; (y < h - cy) && (status == VX_SUCCESS); y++)
+            {
+                for (x = cx; x < w - cx; x++)
+                {
+                    vx_uint8 expected = vx_rank_reference(in, w, x, y, cases[c].columns, cases[c].rows, rank);
+                    if (out[y * w + x] != expected)
+                    {
+                        printf("case %u (%ux%u) at {%u,%u} got %u, expected %u\n",
+                               c, cases[c].columns, cases[c].rows, x, y, out[y * w + x], expected);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                }
+            }
+        }
+exit:
+        for (c = 0; c < dimof(cases); c++)
+        {
+            vxReleaseImage(&outputs[c]);
+            vxReleaseScalar(&scalars[c][0]);
+            vxReleaseScalar(&scalars[c][1]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseGraph(&graph);
+        free(in);
+        free(out);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief Checks a float32 result against a double reference to within a relative error. */
+static vx_bool vx_close_to(vx_float32 value, vx_float64 expected)
+{
+    vx_float64 tolerance = 1e-5 * (fabs(expected) > 1.0 ? fabs(expected) : 1.0);
+    return (fabs((vx_float64)value - expected) <= tolerance) ? vx_true_e : vx_false_e;
+}
+
+vx_status vx_test_graph_statistics(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        /* the large images are split into several bands, the small one is not */
+        vx_uint32 sizes[][2] = {{1283, 517}, {83, 41}};
+        vx_uint32 c, i, x, y, w, h;
+
+        status = VX_SUCCESS;
+        for (c = 0; (c < dimof(sizes)) && (status == VX_SUCCESS); c++)
+        {
+            vx_float32 mean[2] = {0.0f, 0.0f}, stddev[2] = {0.0f, 0.0f};
+            vx_uint8 *u8;
+            vx_uint16 *u16;
+            vx_uint32 *sums;
+            vx_image images[3];
+            vx_scalar scalars[4];
+            vx_graph graph = vxCreateGraph(context);
+
+            w = sizes[c][0];
+            h = sizes[c][1];
+            u8 = (vx_uint8 *)malloc(w * h);
+            u16 = (vx_uint16 *)malloc(w * h * sizeof(vx_uint16));
+            sums = (vx_uint32 *)malloc(w * h * sizeof(vx_uint32));
+            images[0] = vxCreateImage(context, w, h, FOURCC_U8);
+            images[1] = vxCreateImage(context, w, h, FOURCC_U16);
+            images[2] = vxCreateImage(context, w, h, FOURCC_U32);
+            for (i = 0; i < 2; i++)
+            {
+                scalars[2 * i] = vxCreateScalar(context, VX_TYPE_FLOAT32, &mean[i]);
+                scalars[2 * i + 1] = vxCreateScalar(context, VX_TYPE_FLOAT32, &stddev[i]);
+            }
+            if (!u8 || !u16 || !sums || !graph)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            if (status == VX_SUCCESS)
+            {
+                vx_node nodes[] = {
+                    vxMeanStdDevNode(graph, images[0], scalars[0], scalars[1]),
+                    vxMeanStdDevNode(graph, images[1], scalars[2], scalars[3]),
+                    vxIntegralImageNode(graph, images[0], images[2]),
+                };
+                srand(16 + c);
+                for (i = 0; i < w * h; i++)
+                {
+                    u8[i] = (vx_uint8)rand();
+                    u16[i] = (vx_uint16)(rand() ^ (rand() << 8));
+                }
+                status |= vx_write_image(images[0], w, h, sizeof(vx_uint8), u8);
+                status |= vx_write_image(images[1], w, h, sizeof(vx_uint16), u16);
+                for (i = 0; i < dimof(nodes); i++)
+                {
+                    if (nodes[i] == 0)
+                        status = VX_ERROR_NOT_SUFFICIENT;
+                    vxReleaseNode(&nodes[i]);
+                }
+            }
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            for (i = 0; (i < 2) && (status == VX_SUCCESS); i++)
+            {
+                vx_uint64 sum = 0, sumsq = 0;
+                vx_float64 n = (vx_float64)w * h, m, sd;
+                for (y = 0; y < w * h; y++)
+                {
+                    vx_uint64 v = (i == 0) ? u8[y] : u16[y];
+                    sum += v;
+                    sumsq += v * v;
+                }
+                m = (vx_float64)sum / n;
+                sd = sqrt((vx_float64)sumsq / n - m * m);
+                vxAccessScalarValue(scalars[2 * i], &mean[i]);
+                vxAccessScalarValue(scalars[2 * i + 1], &stddev[i]);
+                if (!vx_close_to(mean[i], m) || !vx_close_to(stddev[i], sd))
+                {
+                    printf("%ux%u %s: mean %f stddev %f, expected %f %f\n", w, h,
+                           i == 0 ? "U8" : "U16", mean[i], stddev[i], m, sd);
+                    status = VX_FAILURE;
+                }
+            }
+            if (status == VX_SUCCESS)
+                status = vx_read_image(images[2], w, h, sizeof(vx_uint32), sums);
+            for (y = 0; (y < h) && (status == VX_SUCCESS); y++)
+            {
+                vx_uint32 run = 0;
+                for (x = 0; x < w; x++)
+                {
+                    vx_uint32 expected = (run += u8[y * w + x]) + (y > 0 ? sums[(y - 1) * w + x] : 0);
+                    if (sums[y * w + x] != expected)
+                    {
+                        printf("%ux%u integral at {%u,%u} is %u, expected %u\n", w, h, x, y, sums[y * w + x], expected);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                }
+            }
+            for (i = 0; i < dimof(images); i++)
+                vxReleaseImage(&images[i]);
+            for (i = 0; i < dimof(scalars); i++)
+                vxReleaseScalar(&scalars[i]);
+            vxReleaseGraph(&graph);
+            free(u8);
+            free(u16);
+            free(sums);
+        }
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief A direct Canny edge detector: the same Sobel gradients, orientations,
+ * suppression and thresholds as the kernel, traced over the whole image at once.
+ */
+static void vx_canny_reference(const vx_uint8 *in, vx_uint32 w, vx_uint32 h, vx_int32 gs, vx_enum norm,
+                               vx_uint8 lower, vx_uint8 upper, vx_uint8 *out)
+{
+    static const vx_int32 smooth[3][7] = {{1, 2, 1}, {1, 4, 6, 4, 1}, {1, 6, 15, 20, 15, 6, 1}};
+    static const vx_int32 deriv[3][7] = {{-1, 0, 1}, {-1, -2, 0, 2, 1}, {-1, -4, -5, 0, 5, 4, 1}};
+    vx_int32 r = gs / 2, i, j, x, y, n;
+    vx_int64 *gx = (vx_int64 *)calloc(w * h, sizeof(vx_int64));
+    vx_int64 *gy = (vx_int64 *)calloc(w * h, sizeof(vx_int64));
+    vx_int64 *mag = (vx_int64 *)calloc(w * h, sizeof(vx_int64));
+    vx_int32 *stack = (vx_int32 *)malloc(w * h * sizeof(vx_int32));
+    vx_int64 lo = (norm == VX_NORM_L2) ? (vx_int64)lower * lower : lower;
+    vx_int64 hi = (norm == VX_NORM_L2) ? (vx_int64)upper * upper : upper;
+    vx_int32 top = 0;
+
+    memset(out, 0, w * h);
+    for (y = r; y < (vx_int32)h - r; y++)
+    {
+        for (x = r; x < (vx_int32)w - r; x++)
+        {
+            vx_int64 sx = 0, sy = 0;
+            for (i = 0; i < gs; i++)
+            {
+                for (j = 0; j < gs; j++)
+                {
+                    vx_int32 v = in[(y + i - r) * w + (x + j - r)];
+                    sx += smooth[r - 1][i] * deriv[r - 1][j] * v;
+                    sy += deriv[r - 1][i] * smooth[r - 1][j] * v;
+                }
+            }
+            gx[y * w + x] = sx;
+            gy[y * w + x] = sy;
+            mag[y * w + x] = (norm == VX_NORM_L2) ? sx * sx + sy * sy : llabs(sx) + llabs(sy);
+        }
+    }
+    for (y = r + 1; y < (vx_int32)h - r - 1; y++)
+    {
+        for (x = r + 1; x < (vx_int32)w - r - 1; x++)
+        {
+            vx_int64 ax = llabs(gx[y * w + x]), ay = llabs(gy[y * w + x]), m = mag[y * w + x], a, b;
+            /* tan(22.5) and tan(67.5) in 17.15 fixed point */
+            if (ay * 32768 < ax * 13573)
+            {
+                a = mag[y * w + x - 1];
+                b = mag[y * w + x + 1];
+            }
+            else if (ay * 32768 > ax * 79109)
+            {
+                a = mag[(y - 1) * w + x];
+                b = mag[(y + 1) * w + x];
+            }
+            else if ((gx[y * w + x] < 0) == (gy[y * w + x] < 0))
+            {
+                a = mag[(y - 1) * w + x - 1];
+                b = mag[(y + 1) * w + x + 1];
+            }
+            else
+            {
+                a = mag[(y - 1) * w + x + 1];
+                b = mag[(y + 1) * w + x - 1];
+            }
+            if ((m > lo) && (m > a) && (m >= b))
+            {
+                out[y * w + x] = 1;
+                if (m > hi)
+                {
+                    out[y * w + x] = 255;
+                    stack[top++] = y * w + x;
+                }
+            }
+        }
+    }
+    while (top > 0)
+    {
+        vx_int32 p = stack[--top];
+        for (n = 0; n < 9; n++)
+        {
+            vx_int32 q = p + (n / 3 - 1) * (vx_int32)w + (n % 3 - 1);
+            if (out[q] == 1)
+            {
+                out[q] = 255;
+                stack[top++] = q;
+            }
+        }
+    }
+    for (i = 0; i < (vx_int32)(w * h); i++)
+        out[i] = (out[i] == 255) ? 255 : 0;
+    free(gx);
+    free(gy);
+    free(mag);
+    free(stack);
+}
+
+vx_status vx_test_graph_canny(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        /* the image is split into several bands, with edges crossing the seams */
+        struct {
+            vx_int32 gradient_size;
+            vx_enum norm;
+            vx_uint8 lower, upper;
+        } cases[] = {
+            {3, VX_NORM_L1, 60, 180},
+            {3, VX_NORM_L2, 40, 120},
+            {5, VX_NORM_L2, 150, 250},
+            {7, VX_NORM_L2, 250, 255},
+        };
+        vx_uint32 w = 1283, h = 517, c, x, y;
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *out = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *expected = (vx_uint8 *)malloc(w * h);
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image outputs[dimof(cases)];
+        vx_threshold thresholds[dimof(cases)];
+        vx_graph graph = vxCreateGraph(context);
+
+        status = VX_SUCCESS;
+        if (!in || !out || !expected || !input || !graph)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        for (c = 0; c < dimof(cases); c++)
+        {
+            outputs[c] = vxCreateImage(context, w, h, FOURCC_U8);
+            thresholds[c] = vxCreateThreshold(context, VX_THRESHOLD_TYPE_RANGE);
+            status |= vxSetThresholdAttribute(thresholds[c], VX_THRESHOLD_ATTRIBUTE_LOWER, &cases[c].lower, sizeof(vx_uint8));
+            status |= vxSetThresholdAttribute(thresholds[c], VX_THRESHOLD_ATTRIBUTE_UPPER, &cases[c].upper, sizeof(vx_uint8));
+        }
+        if (status == VX_SUCCESS)
+        {
+            /* rings and stripes over a noisy background */
+            srand(17);
+            for (y = 0; y < h; y++)
+            {
+                for (x = 0; x < w; x++)
+                {
+                    vx_int32 dx = (vx_int32)x - 640, dy = (vx_int32)y - 258;
+                    vx_int32 v = 60 + rand() % 2;
+                    if (((dx * dx + dy * dy) / 20000) % 2)
+                        v += 80;
+                    if ((x + y / 2) % 97 < 9)
+                        v += 40;
+                    in[y * w + x] = (vx_uint8)v;
+                }
+            }
+            status = vx_write_image(input, w, h, sizeof(vx_uint8), in);
+            for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+            {
+                vx_node node = vxCannyEdgeDetectorNode(graph, input, thresholds[c],
+                                                       cases[c].gradient_size, cases[c].norm, outputs[c]);
+                if (node == 0)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                vxReleaseNode(&node);
+            }
+        }
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            vx_uint32 edges = 0;
+            vx_canny_reference(in, w, h, cases[c].gradient_size, cases[c].norm, cases[c].lower, cases[c].upper, expected);
+            status = vx_read_image(outputs[c], w, h, sizeof(vx_uint8), out);
+            for (y = 0; (y < h) && (status == VX_SUCCESS); y++)
+            {
+                for (x = 0; x < w; x++)
+                {
+                    if (out[y * w + x] != expected[y * w + x])
+                    {
+                        printf("case %u (%d, L%d) at {%u,%u} got %u, expected %u\n", c, cases[c].gradient_size,
+                               cases[c].norm == VX_NORM_L1 ? 1 : 2, x, y, out[y * w + x], expected[y * w + x]);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                    edges += expected[y * w + x] ? 1 : 0;
+                }
+            }
+            /* an empty or a full map would not test much */
+            if ((status == VX_SUCCESS) && ((edges == 0) || (edges > w * h / 4)))
+            {
+                printf("case %u has %u edges\n", c, edges);
+                status = VX_FAILURE;
+            }
+        }
+        for (c = 0; c < dimof(cases); c++)
+        {
+            vxReleaseImage(&outputs[c]);
+            vxReleaseThreshold(&thresholds[c]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseGraph(&graph);
+        free(in);
+        free(out);
+        free(expected);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief A direct FAST-9 scorer: every arc of 9 is tried, zero when none is a corner. */
+static vx_uint8 vx_fast9_reference(const vx_uint8 *in, vx_uint32 w, vx_uint32 x, vx_uint32 y, vx_int32 t)
+{
+    static const vx_int32 circle[16][2] = {
+        { 0, -3}, { 1, -3}, { 2, -2}, { 3, -1}, { 3,  0}, { 3,  1}, { 2,  2}, { 1,  3},
+        { 0,  3}, {-1,  3}, {-2,  2}, {-3,  1}, {-3,  0}, {-3, -1}, {-2, -2}, {-1, -3},
+    };
+    vx_int32 p = in[y * w + x], score = 0, s, i;
+    vx_bool corner = vx_false_e;
+    for (s = 0; s < 16; s++)
+    {
+        vx_int32 lo = 255, hi = -255;
+        for (i = 0; i < 9; i++)
+        {
+            const vx_int32 *o = circle[(s + i) % 16];
+            vx_int32 d = in[(y + o[1]) * w + (x + o[0])] - p;
+            lo = d < lo ? d : lo;
+            hi = d > hi ? d : hi;
+        }
+        if ((lo > t) || (hi < -t))
+            corner = vx_true_e;
+        score = lo > score ? lo : score;
+        score = -hi > score ? -hi : score;
+    }
+    return corner ? (vx_uint8)score : 0;
+}
+
+vx_status vx_test_graph_fast_corners(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        /* the image is split into several bands, the second pass refills the lists */
+        vx_float32 thresholds[] = {0.08f, 0.2f};
+        vx_bool nonmax[] = {vx_false_e, vx_true_e};
+        vx_uint32 w = 1283, h = 517, x, y, c, pass;
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *scores = (vx_uint8 *)calloc(w * h, 1);
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_scalar strength = vxCreateScalar(context, VX_TYPE_FLOAT32, &thresholds[0]);
+        vx_list lists[dimof(nonmax)];
+        vx_graph graph = vxCreateGraph(context);
+
+        status = VX_SUCCESS;
+        if (!in || !scores || !input || !strength || !graph)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        for (c = 0; c < dimof(nonmax); c++)
+            lists[c] = vxCreateList(context, VX_TYPE_KEYPOINT, 1000);
+        if (status == VX_SUCCESS)
+        {
+            /* blocks of scattered gray levels over some noise */
+            srand(18);
+            for (y = 0; y < h; y++)
+                for (x = 0; x < w; x++)
+                    in[y * w + x] = (vx_uint8)((((x / 9) * 73856093u) ^ ((y / 7) * 19349663u)) % 200 + rand() % 24);
+            status = vx_write_image(input, w, h, sizeof(vx_uint8), in);
+            for (c = 0; (c < dimof(nonmax)) && (status == VX_SUCCESS); c++)
+            {
+                vx_node node = vxFastCornersNode(graph, input, strength, nonmax[c], lists[c]);
+                if (node == 0)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                vxReleaseNode(&node);
+            }
+        }
+        for (pass = 0; (pass < dimof(thresholds)) && (status == VX_SUCCESS); pass++)
+        {
+            vx_int32 t = (vx_int32)(thresholds[pass] * UINT8_MAX);
+            status = vxCommitScalarValue(strength, &thresholds[pass]);
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            for (y = 3; y < h - 3; y++)
+                for (x = 3; x < w - 3; x++)
+                    scores[y * w + x] = vx_fast9_reference(in, w, x, y, t);
+            for (c = 0; (c < dimof(nonmax)) && (status == VX_SUCCESS); c++)
+            {
+                vx_iterator it = 0;
+                vx_enum iter = VX_LIST_FRONT;
+                vx_size length = 0, found = 0;
+                vxQueryList(lists[c], VX_LIST_ATTRIBUTE_LENGTH, &length, sizeof(length));
+                for (y = 3; (y < h - 3) && (status == VX_SUCCESS); y++)
+                {
+                    for (x = 3; x < w - 3; x++)
+                    {
+                        const vx_uint8 *s = &scores[y * w + x];
+                        vx_keypoint kp;
+                        vx_keypoint_t *pkp = NULL;
+                        if ((*s == 0) ||
+                            (nonmax[c] && ((*s <= s[-(vx_int32)w - 1]) || (*s <= s[-(vx_int32)w]) || (*s <= s[-(vx_int32)w + 1]) ||
+                                           (*s <= s[-1]) || (*s < s[1]) ||
+                                           (*s < s[w - 1]) || (*s < s[w]) || (*s < s[w + 1]))))
+                            continue;
+                        /* the corners come in raster order */
+                        kp = (vx_keypoint)vxGetListItem(lists[c], &it, iter);
+                        iter = VX_LIST_NEXT;
+                        found++;
+                        if ((kp == 0) || (vxAccessKeypoint(kp, &pkp) != VX_SUCCESS))
+                        {
+                            printf("pass %u nonmax %d: missing corner {%u,%u}\n", pass, nonmax[c], x, y);
+                            status = VX_FAILURE;
+                            break;
+                        }
+                        if ((pkp->x != (vx_int32)x) || (pkp->y != (vx_int32)y) || (pkp->strength != (vx_float32)*s))
+                        {
+                            printf("pass %u nonmax %d: got {%d,%d} %f, expected {%u,%u} %u\n",
+                                   pass, nonmax[c], pkp->x, pkp->y, pkp->strength, x, y, *s);
+                            status = VX_FAILURE;
+                        }
+                        vxCommitKeypoint(kp, pkp);
+                        if (status != VX_SUCCESS)
+                            break;
+                    }
+                }
+                if ((status == VX_SUCCESS) && ((found != length) || (found == 0)))
+                {
+                    printf("pass %u nonmax %d: "VX_FMT_SIZE" corners, expected "VX_FMT_SIZE"\n", pass, nonmax[c], length, found);
+                    status = VX_FAILURE;
+                }
+            }
+        }
+        for (c = 0; c < dimof(nonmax); c++)
+            vxReleaseList(&lists[c]);
+        vxReleaseScalar(&strength);
+        vxReleaseImage(&input);
+        vxReleaseGraph(&graph);
+        free(in);
+        free(scores);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief A smooth texture which varies in both directions, defined between pixels. */
+static vx_uint8 vx_flow_texture(vx_float32 x, vx_float32 y)
+{
+    vx_float32 v = 128.0f + 55.0f * sinf(0.11f * x + 0.05f * y) + 45.0f * sinf(0.13f * y - 0.03f * x) +
+                   20.0f * sinf(0.07f * x * 0.9f + 0.17f * y * 0.4f);
+    return (vx_uint8)(v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v + 0.5f));
+}
+
+/*! \brief Writes every level of a pyramid from the texture, moved by (mx, my) at the finest level. */
+static vx_status vx_write_flow_pyramid(vx_pyramid pyramid, vx_uint32 levels, vx_uint32 w, vx_uint32 h, vx_int32 mx, vx_int32 my)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint8 *buffer = (vx_uint8 *)malloc(w * h);
+    vx_float32 scale = 1.0f;
+    vx_uint32 l, x, y;
+    if (buffer == NULL)
+        return VX_ERROR_NO_MEMORY;
+    for (l = 0; (l < levels) && (status == VX_SUCCESS); l++, scale *= VX_SCALE_PYRAMID_HALF)
+    {
+        vx_image level = vxGetPyramidLevel(pyramid, l);
+        vx_uint32 lw = 0, lh = 0;
+        vxQueryImage(level, VX_IMAGE_ATTRIBUTE_WIDTH, &lw, sizeof(lw));
+        vxQueryImage(level, VX_IMAGE_ATTRIBUTE_HEIGHT, &lh, sizeof(lh));
+        for (y = 0; y < lh; y++)
+            for (x = 0; x < lw; x++)
+                buffer[y * lw + x] = vx_flow_texture(x / scale - mx, y / scale - my);
+        status = vx_write_image(level, lw, lh, sizeof(vx_uint8), buffer);
+        vxReleaseImage(&level);
+    }
+    free(buffer);
+    return status;
+}
+
+/*! \brief Adds a point to the old points, and its motion, two pixels off, to the estimates. */
+static vx_status vx_add_flow_point(vx_context context, vx_list old_points, vx_list estimates,
+                                   vx_int32 x, vx_int32 y, vx_int32 tracking, vx_int32 mx, vx_int32 my)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 c;
+    for (c = 0; (c < 2) && (status == VX_SUCCESS); c++)
+    {
+        vx_keypoint kp = vxCreateKeypoint(context);
+        vx_keypoint_t *pkp = NULL;
+        status = vxAccessKeypoint(kp, &pkp);
+        if (status == VX_SUCCESS)
+        {
+            pkp->x = x + (c ? mx + 2 : 0);
+            pkp->y = y + (c ? my - 2 : 0);
+            pkp->strength = (vx_float32)(x + y);
+            pkp->tracking_status = tracking;
+            vxCommitKeypoint(kp, pkp);
+            status = vxAddListItem(c ? estimates : old_points, (vx_reference)kp);
+        }
+        vxReleaseKeypoint(&kp);
+    }
+    return status;
+}
+
+/*!
+ * \brief Test that Lucas-Kanade finds a known motion of a texture through the
+ * pyramids, with and without the initial estimates, and loses the points
+ * which leave the image or arrive lost.
+ */
+vx_status vx_test_graph_optical_flow(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_int32 mx = 5, my = -3;
+        vx_uint32 w = 640, h = 480, levels = 4, x, y, c;
+        vx_pyramid old_pyramid = vxCreatePyramid(context, levels, VX_SCALE_PYRAMID_HALF, w, h, FOURCC_U8);
+        vx_pyramid new_pyramid = vxCreatePyramid(context, levels, VX_SCALE_PYRAMID_HALF, w, h, FOURCC_U8);
+        vx_list old_points = vxCreateList(context, VX_TYPE_KEYPOINT, 1000);
+        vx_list estimates = vxCreateList(context, VX_TYPE_KEYPOINT, 1000);
+        vx_list new_points[2] = {vxCreateList(context, VX_TYPE_KEYPOINT, 1000),
+                                 vxCreateList(context, VX_TYPE_KEYPOINT, 1000)};
+        vx_float32 epsilon = 0.01f;
+        vx_uint32 iterations = 20;
+        vx_bool use_estimates[2] = {vx_false_e, vx_true_e};
+        vx_enum termination[2] = {VX_TERM_CRITERIA_BOTH, VX_TERM_CRITERIA_EPSILON};
+        vx_size windows[2] = {9, 21};
+        vx_scalar seps = vxCreateScalar(context, VX_TYPE_FLOAT32, &epsilon);
+        vx_scalar siter = vxCreateScalar(context, VX_TYPE_UINT32, &iterations);
+        vx_scalar sestimates[2] = {vxCreateScalar(context, VX_TYPE_BOOL, &use_estimates[0]),
+                                   vxCreateScalar(context, VX_TYPE_BOOL, &use_estimates[1])};
+        vx_graph graph = vxCreateGraph(context);
+        vx_size count = 0;
+
+        status = VX_SUCCESS;
+        if (!old_pyramid || !new_pyramid || !old_points || !estimates || !new_points[0] || !new_points[1] ||
+            !seps || !siter || !sestimates[0] || !sestimates[1] || !graph)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        if (status == VX_SUCCESS)
+            status = vx_write_flow_pyramid(old_pyramid, levels, w, h, 0, 0);
+        if (status == VX_SUCCESS)
+            status = vx_write_flow_pyramid(new_pyramid, levels, w, h, mx, my);
+        /* a grid of points, then one which leaves the image and one which arrives lost */
+        for (y = 32; y < h - 32; y += 16)
+            for (x = 32; x < w - 32; x += 16)
+                status |= vx_add_flow_point(context, old_points, estimates, x, y, 1, mx, my);
+        status |= vx_add_flow_point(context, old_points, estimates, 2, 3, 1, mx, my);
+        status |= vx_add_flow_point(context, old_points, estimates, 320, 3, 0, mx, my);
+        vxQueryList(old_points, VX_LIST_ATTRIBUTE_LENGTH, &count, sizeof(count));
+        for (c = 0; (c < dimof(new_points)) && (status == VX_SUCCESS); c++)
+        {
+            vx_node node = vxOpticalFlowPyrLKNode(graph, old_pyramid, new_pyramid, old_points, estimates, new_points[c],
+                                                  termination[c], seps, siter, sestimates[c], windows[c]);
+            if (node == 0)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            vxReleaseNode(&node);
+        }
+        if (status == VX_SUCCESS)
+            status = vxVerifyGraph(graph);
+        if (status == VX_SUCCESS)
+            status = vxProcessGraph(graph);
+        for (c = 0; (c < dimof(new_points)) && (status == VX_SUCCESS); c++)
+        {
+            vx_iterator it = 0, old_it = 0;
+            vx_size length = 0, p;
+            vxQueryList(new_points[c], VX_LIST_ATTRIBUTE_LENGTH, &length, sizeof(length));
+            if (length != count)
+            {
+                printf("pass %u: "VX_FMT_SIZE" points, expected "VX_FMT_SIZE"\n", c, length, count);
+                status = VX_FAILURE;
+            }
+            for (p = 0; (p < length) && (status == VX_SUCCESS); p++)
+            {
+                vx_keypoint okp = (vx_keypoint)vxGetListItem(old_points, &old_it, p ? VX_LIST_NEXT : VX_LIST_FRONT);
+                vx_keypoint nkp = (vx_keypoint)vxGetListItem(new_points[c], &it, p ? VX_LIST_NEXT : VX_LIST_FRONT);
+                vx_keypoint_t o, n, *po = &o, *pn = &n;
+                vx_bool lost;
+                vxAccessKeypoint(okp, &po);
+                vxCommitKeypoint(okp, NULL);
+                vxAccessKeypoint(nkp, &pn);
+                vxCommitKeypoint(nkp, NULL);
+                lost = (o.y == 3) ? vx_true_e : vx_false_e;
+                if (lost ? (n.tracking_status != 0)
+                         : ((n.tracking_status == 0) || (abs(n.x - (o.x + mx)) > 1) || (abs(n.y - (o.y + my)) > 1) ||
+                            (n.strength != o.strength)))
+                {
+                    printf("pass %u: {%d,%d} went to {%d,%d} status %d, expected {%d,%d}\n",
+                           c, o.x, o.y, n.x, n.y, n.tracking_status, lost ? -1 : o.x + mx, lost ? -1 : o.y + my);
+                    status = VX_FAILURE;
+                }
+            }
+        }
+        vxReleaseList(&new_points[0]);
+        vxReleaseList(&new_points[1]);
+        vxReleaseList(&old_points);
+        vxReleaseList(&estimates);
+        vxReleaseScalar(&seps);
+        vxReleaseScalar(&siter);
+        vxReleaseScalar(&sestimates[0]);
+        vxReleaseScalar(&sestimates[1]);
+        vxReleasePyramid(&old_pyramid);
+        vxReleasePyramid(&new_pyramid);
+        vxReleaseGraph(&graph);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief A direct Harris scorer: the Sobel and the block sums of every pixel on their own. */
+static void vx_harris_reference(const vx_uint8 *in, vx_uint32 w, vx_uint32 h, vx_int32 gs, vx_int32 bs,
+                                vx_float32 k, vx_float32 t, vx_float32 *scores)
+{
+    static const vx_int32 smooth[3][7] = {{1, 2, 1}, {1, 4, 6, 4, 1}, {1, 6, 15, 20, 15, 6, 1}};
+    static const vx_int32 deriv[3][7] = {{-1, 0, 1}, {-1, -2, 0, 2, 1}, {-1, -4, -5, 0, 5, 4, 1}};
+    vx_int32 rg = gs / 2, rb = bs / 2, m = rg + rb, x, y, i, j, u, v;
+    memset(scores, 0, w * h * sizeof(vx_float32));
+    for (y = m; y < (vx_int32)h - m; y++)
+    {
+        for (x = m; x < (vx_int32)w - m; x++)
+        {
+            vx_int64 sxx = 0, sxy = 0, syy = 0;
+            vx_float64 det, trace, mc;
+            for (v = -rb; v <= rb; v++)
+            {
+                for (u = -rb; u <= rb; u++)
+                {
+                    vx_int64 gx = 0, gy = 0;
+                    for (j = 0; j < gs; j++)
+                    {
+                        for (i = 0; i < gs; i++)
+                        {
+                            vx_int32 p = in[(y + v + j - rg) * w + (x + u + i - rg)];
+                            gx += smooth[rg - 1][j] * deriv[rg - 1][i] * p;
+                            gy += deriv[rg - 1][j] * smooth[rg - 1][i] * p;
+                        }
+                    }
+                    sxx += gx * gx;
+                    sxy += gx * gy;
+                    syy += gy * gy;
+                }
+            }
+            det = (vx_float64)sxx * (vx_float64)syy - (vx_float64)sxy * (vx_float64)sxy;
+            trace = (vx_float64)sxx + (vx_float64)syy;
+            mc = (det - (vx_float64)k * trace * trace) / 65536.0;
+            scores[y * w + x] = (mc > (vx_float64)t) ? (vx_float32)mc : 0.0f;
+        }
+    }
+}
+
+/*! \brief Orders keypoints by falling strength, then in raster order. */
+static int vx_harris_compare(const void *a, const void *b)
+{
+    const vx_keypoint_t *pa = (const vx_keypoint_t *)a, *pb = (const vx_keypoint_t *)b;
+    if (pa->strength != pb->strength)
+        return (pa->strength > pb->strength) ? -1 : 1;
+    if (pa->y != pb->y)
+        return (pa->y < pb->y) ? -1 : 1;
+    return (pa->x > pb->x) - (pa->x < pb->x);
+}
+
+/*!
+ * \brief Test the Harris corners against a direct scorer, with the 3x3
+ * suppression and then the minimum distance applied strongest first, over
+ * two thresholds so that the lists are refilled.
+ */
+vx_status vx_test_graph_harris_corners(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        struct {
+            vx_int32 gs, bs;
+            vx_float32 min_distance, k, thresholds[2];
+        } cases[] = {
+            {3, 3, 2.5f, 0.04f, {1.0e5f, 1.0e6f}},
+            {5, 3, 3.5f, 0.06f, {1.0e8f, 1.0e9f}},
+            {7, 7, 5.0f, 0.15f, {1.0e12f, 1.0e13f}},
+            {3, 5, 1.0f, 0.10f, {1.0e6f, 1.0e7f}},
+        };
+        vx_uint32 w = 1283, h = 517, x, y, c, pass;
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_float32 *scores = (vx_float32 *)malloc(w * h * sizeof(vx_float32));
+        vx_keypoint_t *expected = (vx_keypoint_t *)malloc(w * h * sizeof(vx_keypoint_t));
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_scalar thresholds[dimof(cases)], distances[dimof(cases)], sensitivities[dimof(cases)];
+        vx_list lists[dimof(cases)];
+        vx_graph graph = vxCreateGraph(context);
+
+        status = VX_SUCCESS;
+        if (!in || !scores || !expected || !input || !graph)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        for (c = 0; c < dimof(cases); c++)
+        {
+            thresholds[c] = vxCreateScalar(context, VX_TYPE_FLOAT32, &cases[c].thresholds[0]);
+            distances[c] = vxCreateScalar(context, VX_TYPE_FLOAT32, &cases[c].min_distance);
+            sensitivities[c] = vxCreateScalar(context, VX_TYPE_FLOAT32, &cases[c].k);
+            lists[c] = vxCreateList(context, VX_TYPE_KEYPOINT, 1000);
+        }
+        if (status == VX_SUCCESS)
+        {
+            /* blocks of scattered gray levels over some noise */
+            srand(20);
+            for (y = 0; y < h; y++)
+                for (x = 0; x < w; x++)
+                    in[y * w + x] = (vx_uint8)((((x / 11) * 73856093u) ^ ((y / 8) * 19349663u)) % 200 + rand() % 16);
+            status = vx_write_image(input, w, h, sizeof(vx_uint8), in);
+            for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+            {
+                vx_node node = vxHarrisCornersNode(graph, input, thresholds[c], distances[c], sensitivities[c],
+                                                   cases[c].gs, cases[c].bs, lists[c]);
+                if (node == 0)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                vxReleaseNode(&node);
+            }
+        }
+        for (pass = 0; (pass < 2) && (status == VX_SUCCESS); pass++)
+        {
+            for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+                status = vxCommitScalarValue(thresholds[c], &cases[c].thresholds[pass]);
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+            {
+                vx_float32 d2 = cases[c].min_distance * cases[c].min_distance;
+                vx_size count = 0, kept = 0, length = 0, i, j;
+                vx_iterator it = 0;
+
+                vx_harris_reference(in, w, h, cases[c].gs, cases[c].bs, cases[c].k, cases[c].thresholds[pass], scores);
+                for (y = 1; y < h - 1; y++)
+                {
+                    for (x = 1; x < w - 1; x++)
+                    {
+                        const vx_float32 *s = &scores[y * w + x];
+                        if ((*s <= 0.0f) ||
+                            (*s <= s[-(vx_int32)w - 1]) || (*s <= s[-(vx_int32)w]) || (*s <= s[-(vx_int32)w + 1]) ||
+                            (*s <= s[-1]) || (*s < s[1]) || (*s < s[w - 1]) || (*s < s[w]) || (*s < s[w + 1]))
+                            continue;
+                        memset(&expected[count], 0, sizeof(vx_keypoint_t));
+                        expected[count].x = (vx_int32)x;
+                        expected[count].y = (vx_int32)y;
+                        expected[count].strength = *s;
+                        count++;
+                    }
+                }
+                qsort(expected, count, sizeof(vx_keypoint_t), vx_harris_compare);
+                for (i = 0; i < count; i++)
+                {
+                    for (j = 0; j < kept; j++)
+                    {
+                        vx_float32 dx = (vx_float32)(expected[j].x - expected[i].x);
+                        vx_float32 dy = (vx_float32)(expected[j].y - expected[i].y);
+                        if (dx * dx + dy * dy < d2)
+                            break;
+                    }
+                    if (j == kept)
+                        expected[kept++] = expected[i];
+                }
+                vxQueryList(lists[c], VX_LIST_ATTRIBUTE_LENGTH, &length, sizeof(length));
+                if ((length != kept) || (kept == 0))
+                {
+                    printf("pass %u case %u: "VX_FMT_SIZE" corners, expected "VX_FMT_SIZE"\n", pass, c, length, kept);
+                    status = VX_FAILURE;
+                }
+                for (i = 0; (i < kept) && (status == VX_SUCCESS); i++)
+                {
+                    vx_keypoint kp = (vx_keypoint)vxGetListItem(lists[c], &it, i ? VX_LIST_NEXT : VX_LIST_FRONT);
+                    vx_keypoint_t *pkp = NULL;
+                    if ((kp == 0) || (vxAccessKeypoint(kp, &pkp) != VX_SUCCESS))
+                    {
+                        status = VX_FAILURE;
+                        break;
+                    }
+                    /* the corners come strongest first */
+                    if ((pkp->x != expected[i].x) || (pkp->y != expected[i].y) ||
+                        (pkp->strength != expected[i].strength) || (pkp->tracking_status != 1))
+                    {
+                        printf("pass %u case %u: got {%d,%d} %e, expected {%d,%d} %e\n", pass, c,
+                               pkp->x, pkp->y, pkp->strength, expected[i].x, expected[i].y, expected[i].strength);
+                        status = VX_FAILURE;
+                    }
+                    vxCommitKeypoint(kp, pkp);
+                }
+            }
+        }
+        for (c = 0; c < dimof(cases); c++)
+        {
+            vxReleaseList(&lists[c]);
+            vxReleaseScalar(&thresholds[c]);
+            vxReleaseScalar(&distances[c]);
+            vxReleaseScalar(&sensitivities[c]);
+        }
+        vxReleaseImage(&input);
+        vxReleaseGraph(&graph);
+        free(in);
+        free(scores);
+        free(expected);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief A direct scaler in double precision. The center of output pixel x
+ * falls on (x + 0.5) * w1 / w2 in the source, and an area pixel averages the
+ * box from x * w1 / w2 to (x + 1) * w1 / w2.
+ */
+static vx_float64 vx_scale_reference(const vx_uint8 *in, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2,
+                                     vx_enum type, vx_uint32 x, vx_uint32 y)
+{
+    vx_float64 sum = 0.0, fx, fy, ax, ay;
+    vx_uint32 x0, y0, x1, y1, i, j;
+    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+    {
+        x0 = (vx_uint32)(((2 * (vx_uint64)x + 1) * w1) / (2 * (vx_uint64)w2));
+        y0 = (vx_uint32)(((2 * (vx_uint64)y + 1) * h1) / (2 * (vx_uint64)h2));
+        return in[(y0 < h1 ? y0 : h1 - 1) * w1 + (x0 < w1 ? x0 : w1 - 1)];
+    }
+    else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
+    {
+        fx = (x + 0.5) * w1 / w2 - 0.5;
+        fy = (y + 0.5) * h1 / h2 - 0.5;
+        fx = (fx < 0.0) ? 0.0 : ((fx > w1 - 1) ? w1 - 1 : fx);
+        fy = (fy < 0.0) ? 0.0 : ((fy > h1 - 1) ? h1 - 1 : fy);
+        x0 = (vx_uint32)fx;
+        y0 = (vx_uint32)fy;
+        x1 = (x0 + 1 < w1) ? x0 + 1 : x0;
+        y1 = (y0 + 1 < h1) ? y0 + 1 : y0;
+        ax = fx - x0;
+        ay = fy - y0;
+        return (1.0 - ay) * ((1.0 - ax) * in[y0 * w1 + x0] + ax * in[y0 * w1 + x1]) +
+               ay * ((1.0 - ax) * in[y1 * w1 + x0] + ax * in[y1 * w1 + x1]);
+    }
+    else
+    {
+        vx_float64 bx0 = (vx_float64)x * w1 / w2, bx1 = (vx_float64)(x + 1) * w1 / w2;
+        vx_float64 by0 = (vx_float64)y * h1 / h2, by1 = (vx_float64)(y + 1) * h1 / h2;
+        for (j = (vx_uint32)by0; (j < h1) && (j < by1); j++)
+        {
+            fy = ((by1 < j + 1) ? by1 : j + 1) - ((by0 > j) ? by0 : j);
+            for (i = (vx_uint32)bx0; (i < w1) && (i < bx1); i++)
+            {
+                fx = ((bx1 < i + 1) ? bx1 : i + 1) - ((bx0 > i) ? bx0 : i);
+                sum += fx * fy * in[j * w1 + i];
+            }
+        }
+        return sum / ((bx1 - bx0) * (by1 - by0));
+    }
+}
+
+/*!
+ * \brief Test the image scaler against a direct one, for each interpolation
+ * over copies, exact halving, ordinary and large ratios and enlarging. The
+ * interpolation of each node changes between executions, so that the tables
+ * built by the initializer are rebuilt.
+ */
+vx_status vx_test_graph_scale_image(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 sizes[][4] = {
+            {300, 200, 300, 200},
+            {640, 480, 320, 240},
+            {1920, 1080, 1280, 720},
+            {641, 479, 97, 61},
+            {640, 480, 1000, 701},
+            {123, 77, 1, 1},
+        };
+        vx_enum types[] = {
+            VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR,
+            VX_INTERPOLATION_TYPE_BILINEAR,
+            VX_INTERPOLATION_TYPE_AREA,
+        };
+        vx_uint32 c, t, x, y;
+
+        status = VX_SUCCESS;
+        srand(21);
+        for (c = 0; (c < dimof(sizes)) && (status == VX_SUCCESS); c++)
+        {
+            vx_uint32 w1 = sizes[c][0], h1 = sizes[c][1], w2 = sizes[c][2], h2 = sizes[c][3];
+            vx_uint8 *in = (vx_uint8 *)malloc(w1 * h1);
+            vx_uint8 *out = (vx_uint8 *)malloc(w2 * h2);
+            vx_image input = vxCreateImage(context, w1, h1, FOURCC_U8);
+            vx_image output = vxCreateImage(context, w2, h2, FOURCC_U8);
+            vx_graph graph = vxCreateGraph(context);
+            vx_node node = vxScaleImageNode(graph, input, output, types[0]);
+            vx_parameter param = vxGetParameterByIndex(node, 2);
+            vx_scalar stype = 0;
+
+            if (!in || !out || !input || !output || !graph || !node || !param)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            if (status == VX_SUCCESS)
+                status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &stype, sizeof(stype));
+            if (status == VX_SUCCESS)
+            {
+                /* smooth gradients under some noise */
+                for (y = 0; y < h1; y++)
+                    for (x = 0; x < w1; x++)
+                        in[y * w1 + x] = (vx_uint8)(((x * 3 + y * 5) % 224) + rand() % 32);
+                status = vx_write_image(input, w1, h1, sizeof(vx_uint8), in);
+            }
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            for (t = 0; (t < dimof(types)) && (status == VX_SUCCESS); t++)
+            {
+                /* nearest and copies are exact, halving rounds the mean of 2x2 pixels */
+                vx_bool exact = ((types[t] == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ||
+                                 ((w1 == w2) && (h1 == h2))) ? vx_true_e : vx_false_e;
+                vx_bool half = ((w1 == 2 * w2) && (h1 == 2 * h2)) ? vx_true_e : vx_false_e;
+                status = vxCommitScalarValue(stype, &types[t]);
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graph);
+                if (status == VX_SUCCESS)
+                    status = vx_read_image(output, w2, h2, sizeof(vx_uint8), out);
+                for (y = 0; (y < h2) && (status == VX_SUCCESS); y++)
+                {
+                    for (x = 0; x < w2; x++)
+                    {
+                        vx_float64 ref = vx_scale_reference(in, w1, h1, w2, h2, types[t], x, y);
+                        vx_float64 err = fabs(out[y * w2 + x] - ref);
+                        if (exact ? (err != 0.0) : (half ? (out[y * w2 + x] != (vx_uint8)(ref + 0.5)) : (err > 1.0)))
+                        {
+                            printf("%ux%u to %ux%u type %d: {%u,%u} is %u, expected %.3f\n",
+                                   w1, h1, w2, h2, types[t], x, y, out[y * w2 + x], ref);
+                            status = VX_FAILURE;
+                            break;
+                        }
+                    }
+                }
+            }
+            vxReleaseParameter(&param);
+            vxReleaseNode(&node);
+            vxReleaseGraph(&graph);
+            vxReleaseImage(&input);
+            vxReleaseImage(&output);
+            free(in);
+            free(out);
+        }
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+static vx_float64 vx_remap_reference(const vx_uint8 *in, vx_uint32 w1, vx_uint32 h1, vx_enum type,
+                                     vx_float32 sx, vx_float32 sy, vx_uint8 constant)
+{
+    vx_float64 x0, y0, ax, ay, p[2][2];
+    vx_uint32 i, j;
+    if (!isfinite(sx) || !isfinite(sy))
+        return constant;
+    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+    {
+        x0 = floor((vx_float64)sx + 0.5);
+        y0 = floor((vx_float64)sy + 0.5);
+        if ((x0 < 0.0) || (x0 >= w1) || (y0 < 0.0) || (y0 >= h1))
+            return constant;
+        return in[(vx_uint32)y0 * w1 + (vx_uint32)x0];
+    }
+    x0 = floor(sx);
+    y0 = floor(sy);
+    ax = sx - x0;
+    ay = sy - y0;
+    for (j = 0; j < 2; j++)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            vx_float64 x = x0 + i, y = y0 + j;
+            if ((x < 0.0) || (x >= w1) || (y < 0.0) || (y >= h1))
+                p[j][i] = constant;
+            else
+                p[j][i] = in[(vx_uint32)y * w1 + (vx_uint32)x];
+        }
+    }
+    return (1.0 - ay) * ((1.0 - ax) * p[0][0] + ax * p[0][1]) +
+           ay * ((1.0 - ax) * p[1][0] + ax * p[1][1]);
+}
+
+/*! \brief Checks an output of the remap against the reference, exactly for
+ * nearest neighbor and within 1 for bilinear. Under an undefined border only
+ * the pixels from inside of the input are checked.
+ */
+static vx_status vx_remap_check(const vx_uint8 *in, vx_uint32 w1, vx_uint32 h1, const vx_float32 *map,
+                                const vx_uint8 *out, vx_uint32 w2, vx_uint32 h2, vx_enum type,
+                                vx_bool defined, vx_uint8 constant)
+{
+    vx_uint32 x, y;
+    for (y = 0; y < h2; y++)
+    {
+        for (x = 0; x < w2; x++)
+        {
+            vx_float32 sx = map[2 * (y * w2 + x) + 0], sy = map[2 * (y * w2 + x) + 1];
+            vx_float64 ref = vx_remap_reference(in, w1, h1, type, sx, sy, constant);
+            vx_float64 err = fabs(out[y * w2 + x] - ref);
+            if ((defined == vx_false_e) &&
+                !((sx >= 0.0f) && (sx + 1.0f < w1) && (sy >= 0.0f) && (sy + 1.0f < h1)))
+                continue;
+            if ((type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ? (err != 0.0) : (err > 1.0))
+            {
+                printf("type %d: {%u,%u} from {%f,%f} is %u, expected %.3f\n",
+                       type, x, y, sx, sy, out[y * w2 + x], ref);
+                return VX_FAILURE;
+            }
+        }
+    }
+    return VX_SUCCESS;
+}
+
+vx_status vx_test_graph_remap(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_uint32 w1 = 300, h1 = 200, w2 = 333, h2 = 251;
+        vx_enum types[] = {
+            VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR,
+            VX_INTERPOLATION_TYPE_BILINEAR,
+        };
+        vx_enum area = VX_INTERPOLATION_TYPE_AREA;
+        vx_border_mode_t border = {VX_BORDER_MODE_CONSTANT, 77};
+        vx_uint8 *in = (vx_uint8 *)malloc(w1 * h1);
+        vx_uint8 *out = (vx_uint8 *)malloc(w2 * h2);
+        vx_float32 *map = (vx_float32 *)malloc(w2 * h2 * 2 * sizeof(vx_float32));
+        vx_float32 patch[10 * 20 * 2];
+        vx_image input = vxCreateImage(context, w1, h1, FOURCC_U8);
+        vx_image output = vxCreateImage(context, w2, h2, FOURCC_U8);
+        vx_remap table = vxCreateRemap(context, w1, h1, w2, h2);
+        vx_rectangle rect = vxCreateRectangle(context, 0, 0, w2, h2);
+        vx_rectangle sub = vxCreateRectangle(context, 40, 100, 50, 120);
+        vx_graph graph = vxCreateGraph(context);
+        vx_graph bad = vxCreateGraph(context);
+        vx_node node = vxRemapNode(graph, input, table, types[0], output);
+        vx_parameter param = vxGetParameterByIndex(node, 2);
+        vx_scalar stype = 0;
+        vx_imagepatch_addressing_t addr;
+        void *base = NULL;
+        vx_uint32 t, x, y;
+
+        status = VX_SUCCESS;
+        if (!in || !out || !map || !input || !output || !table || !rect || !sub || !graph || !bad || !node || !param)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        if (status == VX_SUCCESS)
+            status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &stype, sizeof(stype));
+        if (status == VX_SUCCESS)
+        {
+            srand(22);
+            for (y = 0; y < h1; y++)
+                for (x = 0; x < w1; x++)
+                    in[y * w1 + x] = (vx_uint8)(((x * 3 + y * 5) % 224) + rand() % 32);
+            status = vx_write_image(input, w1, h1, sizeof(vx_uint8), in);
+        }
+        if (status == VX_SUCCESS)
+            status = vxAccessRemapPatch(table, rect, &addr, &base);
+        if (status == VX_SUCCESS)
+        {
+            /* a barrel distortion, whose corners fall outside of the input */
+            for (y = 0; y < h2; y++)
+            {
+                vx_float32 *coord = (vx_float32 *)((vx_uint8 *)base + y * addr.stride_y);
+                for (x = 0; x < w2; x++)
+                {
+                    vx_float32 dx = (x - w2 / 2.0f) / w2, dy = (y - h2 / 2.0f) / h2;
+                    vx_float32 k = 1.0f + 0.9f * (dx * dx + dy * dy);
+                    coord[2 * x + 0] = w1 / 2.0f + dx * k * w1;
+                    coord[2 * x + 1] = h1 / 2.0f + dy * k * h1;
+                }
+            }
+            memcpy(map, base, w2 * h2 * 2 * sizeof(vx_float32));
+            status = vxCommitRemapPatch(table, rect, &addr, base);
+        }
+        if (status == VX_SUCCESS)
+            status = vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &border, sizeof(border));
+        if (status == VX_SUCCESS)
+            status = vxVerifyGraph(graph);
+        for (t = 0; (t < dimof(types)) && (status == VX_SUCCESS); t++)
+        {
+            status = vxCommitScalarValue(stype, &types[t]);
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(output, w2, h2, sizeof(vx_uint8), out);
+            if (status == VX_SUCCESS)
+                status = vx_remap_check(in, w1, h1, map, out, w2, h2, types[t], vx_true_e, 77);
+        }
+        if (status == VX_SUCCESS)
+        {
+            /* a copied patch moves by a fraction, and single points move far away */
+            base = patch;
+            status = vxAccessRemapPatch(table, sub, &addr, &base);
+            for (y = 0; (y < addr.dim_y) && (status == VX_SUCCESS); y++)
+            {
+                for (x = 0; x < addr.dim_x; x++)
+                {
+                    vx_float32 *coord = &patch[2 * (y * addr.dim_x + x)];
+                    if ((coord[0] != map[2 * ((100 + y) * w2 + 40 + x) + 0]) ||
+                        (coord[1] != map[2 * ((100 + y) * w2 + 40 + x) + 1]))
+                    {
+                        printf("The patch copy differs at {%u,%u}\n", x, y);
+                        status = VX_FAILURE;
+                        break;
+                    }
+                    coord[0] += 5.25f;
+                    coord[1] -= 3.75f;
+                    map[2 * ((100 + y) * w2 + 40 + x) + 0] = coord[0];
+                    map[2 * ((100 + y) * w2 + 40 + x) + 1] = coord[1];
+                }
+            }
+            if (status == VX_SUCCESS)
+                status = vxCommitRemapPatch(table, sub, &addr, patch);
+        }
+        if (status == VX_SUCCESS)
+        {
+            vx_float32 points[][4] = {
+                {0, 0, -1e9f, 5.0f},
+                {1, 0, 299.5f, 199.5f},
+                {2, 0, -0.5f, -0.5f},
+                {w2 - 1, h2 - 1, 1e20f, -1e20f},
+                {200, 10, NAN, 3.0f},
+                {201, 10, 17.125f, 33.875f},
+            };
+            vx_uint32 p;
+            for (p = 0; (p < dimof(points)) && (status == VX_SUCCESS); p++)
+            {
+                vx_uint32 px = (vx_uint32)points[p][0], py = (vx_uint32)points[p][1];
+                vx_float32 sx = 0.0f, sy = 0.0f;
+                status = vxSetRemapPoint(table, px, py, points[p][2], points[p][3]);
+                if (status == VX_SUCCESS)
+                    status = vxGetRemapPoint(table, px, py, &sx, &sy);
+                if ((status == VX_SUCCESS) &&
+                    ((memcmp(&sx, &points[p][2], sizeof(sx)) != 0) || (memcmp(&sy, &points[p][3], sizeof(sy)) != 0)))
+                    status = VX_FAILURE;
+                map[2 * (py * w2 + px) + 0] = points[p][2];
+                map[2 * (py * w2 + px) + 1] = points[p][3];
+            }
+            if ((status == VX_SUCCESS) && (vxSetRemapPoint(table, w2, 0, 0.0f, 0.0f) != VX_ERROR_INVALID_PARAMETERS))
+                status = VX_FAILURE;
+        }
+        /* the node converts the written remap again before it runs */
+        for (t = 0; (t < dimof(types)) && (status == VX_SUCCESS); t++)
+        {
+            status = vxCommitScalarValue(stype, &types[t]);
+            if (status == VX_SUCCESS)
+                status = vxProcessGraph(graph);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(output, w2, h2, sizeof(vx_uint8), out);
+            if (status == VX_SUCCESS)
+                status = vx_remap_check(in, w1, h1, map, out, w2, h2, types[t], vx_true_e, 77);
+        }
+        if (status == VX_SUCCESS)
+        {
+            status = vxuRemap(input, table, VX_INTERPOLATION_TYPE_BILINEAR, output);
+            if (status == VX_SUCCESS)
+                status = vx_read_image(output, w2, h2, sizeof(vx_uint8), out);
+            if (status == VX_SUCCESS)
+                status = vx_remap_check(in, w1, h1, map, out, w2, h2, types[1], vx_false_e, 0);
+        }
+        if (status == VX_SUCCESS)
+        {
+            /* area is not a remap interpolation */
+            vx_node area_node = vxRemapNode(bad, input, table, area, output);
+            if ((vxVerifyGraph(bad) == VX_SUCCESS) && (vxProcessGraph(bad) == VX_SUCCESS))
+            {
+                printf("A remap with area interpolation was processed\n");
+                status = VX_FAILURE;
+            }
+            vxReleaseNode(&area_node);
+        }
+        vxReleaseParameter(&param);
+        vxReleaseNode(&node);
+        vxReleaseGraph(&graph);
+        vxReleaseGraph(&bad);
+        vxReleaseRectangle(&rect);
+        vxReleaseRectangle(&sub);
+        vxReleaseRemap(&table);
+        vxReleaseImage(&input);
+        vxReleaseImage(&output);
+        free(in);
+        free(out);
+        free(map);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+static vx_float64 vx_warp_pixel(const vx_uint8 *in, vx_uint32 w1, vx_uint32 h1, vx_border_mode_t *border,
+                                 vx_float64 x, vx_float64 y)
+{
+    if (border->mode == VX_BORDER_MODE_REPLICATE)
+    {
+        x = (x < 0.0) ? 0.0 : ((x > w1 - 1) ? w1 - 1 : x);
+        y = (y < 0.0) ? 0.0 : ((y > h1 - 1) ? h1 - 1 : y);
+    }
+    else if ((x < 0.0) || (x >= w1) || (y < 0.0) || (y >= h1))
+    {
+        return (border->mode == VX_BORDER_MODE_CONSTANT) ? border->constant_value : 0;
+    }
+    return in[(vx_uint32)y * w1 + (vx_uint32)x];
+}
+
+vx_status vx_test_graph_warps(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_uint32 w1 = 300, h1 = 200;
+        /* the columns of the matrix are the x, y and z of the source, 2x3 for affine */
+        struct {
+            vx_size columns;
+            vx_uint32 w2, h2;
+            vx_enum border;
+            vx_float32 m[3][3];
+        } cases[] = {
+            /* rotation and scale */
+            {2, 320, 240, VX_BORDER_MODE_CONSTANT,  {{0.8f, -0.35f}, {0.35f, 0.8f}, {-20.5f, 40.25f}}},
+            /* translation and scale, then a mirror */
+            {2, 257, 199, VX_BORDER_MODE_CONSTANT,  {{0.75f, 0.0f}, {0.0f, 1.25f}, {10.3f, -5.6f}}},
+            {2, 300, 200, VX_BORDER_MODE_REPLICATE, {{-1.0f, 0.0f}, {0.0f, 1.0f}, {299.0f, -3.0f}}},
+            /* a perspective which is affine, and a true one */
+            {3, 150, 100, VX_BORDER_MODE_CONSTANT,  {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {3.5f, 7.0f, 0.5f}}},
+            {3, 320, 240, VX_BORDER_MODE_REPLICATE, {{0.9f, 0.05f, 0.0004f}, {-0.1f, 1.1f, 0.0009f}, {12.0f, -8.0f, 1.0f}}},
+            {3, 320, 240, VX_BORDER_MODE_UNDEFINED, {{0.9f, 0.05f, 0.0004f}, {-0.1f, 1.1f, -0.003f}, {12.0f, -8.0f, 0.6f}}},
+        };
+        vx_enum types[] = {
+            VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR,
+            VX_INTERPOLATION_TYPE_BILINEAR,
+        };
+        vx_uint8 *in = (vx_uint8 *)malloc(w1 * h1);
+        vx_image input = vxCreateImage(context, w1, h1, FOURCC_U8);
+        vx_uint32 c, t, x, y, i, j;
+
+        status = VX_SUCCESS;
+        if (!in || !input)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        if (status == VX_SUCCESS)
+        {
+            srand(23);
+            for (y = 0; y < h1; y++)
+                for (x = 0; x < w1; x++)
+                    in[y * w1 + x] = (vx_uint8)(((x * 3 + y * 5) % 224) + rand() % 32);
+            status = vx_write_image(input, w1, h1, sizeof(vx_uint8), in);
+        }
+        for (c = 0; (c < dimof(cases)) && (status == VX_SUCCESS); c++)
+        {
+            vx_uint32 w2 = cases[c].w2, h2 = cases[c].h2;
+            vx_size n = cases[c].columns;
+            vx_float32 packed[9];
+            vx_border_mode_t border = {cases[c].border, 33};
+            vx_uint8 *out = (vx_uint8 *)malloc(w2 * h2);
+            vx_image output = vxCreateImage(context, w2, h2, FOURCC_U8);
+            vx_matrix matrix = vxCreateMatrix(context, VX_TYPE_FLOAT32, n, 3);
+            vx_graph graph = vxCreateGraph(context);
+            vx_node node = 0;
+            vx_parameter param = 0;
+            vx_scalar stype = 0;
+
+            for (j = 0; j < 3; j++)
+                for (i = 0; i < n; i++)
+                    packed[j * n + i] = cases[c].m[j][i];
+            if (matrix)
+            {
+                vxAccessMatrix(matrix, NULL);
+                vxCommitMatrix(matrix, packed);
+            }
+            if (graph)
+                node = (n == 2) ? vxWarpAffineNode(graph, input, matrix, types[0], output)
+                                : vxWarpPerspectiveNode(graph, input, matrix, types[0], output);
+            if (node)
+                param = vxGetParameterByIndex(node, 2);
+            if (!out || !output || !matrix || !graph || !node || !param)
+                status = VX_ERROR_NOT_SUFFICIENT;
+            if (status == VX_SUCCESS)
+                status = vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_REF, &stype, sizeof(stype));
+            if (status == VX_SUCCESS)
+                status = vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &border, sizeof(border));
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            for (t = 0; (t < dimof(types)) && (status == VX_SUCCESS); t++)
+            {
+                status = vxCommitScalarValue(stype, &types[t]);
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graph);
+                if (status == VX_SUCCESS)
+                    status = vx_read_image(output, w2, h2, sizeof(vx_uint8), out);
+                for (y = 0; (y < h2) && (status == VX_SUCCESS); y++)
+                {
+                    for (x = 0; x < w2; x++)
+                    {
+                        vx_float64 sx = (vx_float64)cases[c].m[0][0] * x + (vx_float64)cases[c].m[1][0] * y + cases[c].m[2][0];
+                        vx_float64 sy = (vx_float64)cases[c].m[0][1] * x + (vx_float64)cases[c].m[1][1] * y + cases[c].m[2][1];
+                        vx_float64 ref, err, x0, y0;
+                        if (n == 3)
+                        {
+                            vx_float64 sz = (vx_float64)cases[c].m[0][2] * x + (vx_float64)cases[c].m[1][2] * y + cases[c].m[2][2];
+                            sx /= sz;
+                            sy /= sz;
+                        }
+                        if (types[t] == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+                        {
+                            /* a coordinate half way between two pixels may round either way */
+                            if ((fabs(sx - floor(sx) - 0.5) < 1e-3) || (fabs(sy - floor(sy) - 0.5) < 1e-3))
+                                continue;
+                            ref = vx_warp_pixel(in, w1, h1, &border, floor(sx + 0.5), floor(sy + 0.5));
+                        }
+                        else
+                        {
+                            x0 = floor(sx);
+                            y0 = floor(sy);
+                            ref = (1.0 - (sy - y0)) * ((1.0 - (sx - x0)) * vx_warp_pixel(in, w1, h1, &border, x0, y0) +
+                                                       (sx - x0) * vx_warp_pixel(in, w1, h1, &border, x0 + 1, y0)) +
+                                  (sy - y0) * ((1.0 - (sx - x0)) * vx_warp_pixel(in, w1, h1, &border, x0, y0 + 1) +
+                                               (sx - x0) * vx_warp_pixel(in, w1, h1, &border, x0 + 1, y0 + 1));
+                        }
+                        /* an undefined border is checked only inside of the input */
+                        if ((border.mode == VX_BORDER_MODE_UNDEFINED) &&
+                            !((sx >= 0.0) && (sx + 1.0 < w1) && (sy >= 0.0) && (sy + 1.0 < h1)))
+                            continue;
+                        err = fabs(out[y * w2 + x] - ref);
+                        if ((types[t] == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) ? (err != 0.0) : (err > 1.0))
+                        {
+                            printf("case %u type %d: {%u,%u} from {%f,%f} is %u, expected %.3f\n",
+                                   c, types[t], x, y, sx, sy, out[y * w2 + x], ref);
+                            status = VX_FAILURE;
+                            break;
+                        }
+                    }
+                }
+            }
+            vxReleaseParameter(&param);
+            vxReleaseNode(&node);
+            vxReleaseGraph(&graph);
+            vxReleaseMatrix(&matrix);
+            vxReleaseImage(&output);
+            free(out);
+        }
+        vxReleaseImage(&input);
+        free(in);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*! \brief The mapped planes of an image. */
+typedef struct _vx_color_planes_t {
+    vx_fourcc format;
+    vx_uint32 planes;
+    void *base[3];
+    vx_imagepatch_addressing_t addr[3];
+} vx_color_planes_t;
+
+static vx_status vx_color_map(vx_image image, vx_rectangle rect, vx_color_planes_t *cp)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 p;
+    memset(cp, 0, sizeof(*cp));
+    status |= vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &cp->format, sizeof(cp->format));
+    status |= vxQueryImage(image, VX_IMAGE_ATTRIBUTE_PLANES, &cp->planes, sizeof(cp->planes));
+    for (p = 0; (p < cp->planes) && (status == VX_SUCCESS); p++)
+        status = vxAccessImagePatch(image, rect, p, &cp->addr[p], &cp->base[p]);
+    return status;
+}
+
+static vx_status vx_color_unmap(vx_image image, vx_rectangle rect, vx_color_planes_t *cp)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 p;
+    for (p = 0; p < cp->planes; p++)
+        if (cp->base[p])
+            status |= vxCommitImagePatch(image, rect, p, &cp->addr[p], cp->base[p]);
+    return status;
+}
+
+/*! \brief Reads the R, G, B or Y, U, V of a pixel, with the nearest chroma. */
+static void vx_color_get(vx_color_planes_t *cp, vx_uint32 x, vx_uint32 y, vx_uint8 c[3])
+{
+    vx_uint8 *p0 = vxFormatImagePatchAddress2d(cp->base[0], x, y, &cp->addr[0]);
+    vx_uint8 *p1 = vxFormatImagePatchAddress2d(cp->base[1], x, y, &cp->addr[1]);
+    vx_uint8 *p2 = vxFormatImagePatchAddress2d(cp->base[2], x, y, &cp->addr[2]);
+    vx_uint8 *m = vxFormatImagePatchAddress2d(cp->base[0], x & ~1u, y, &cp->addr[0]);
+    switch (cp->format)
+    {
+        case FOURCC_RGB:
+        case FOURCC_RGBX:
+            c[0] = p0[0]; c[1] = p0[1]; c[2] = p0[2];
+            break;
+        case FOURCC_NV12:
+            c[0] = p0[0]; c[1] = p1[0]; c[2] = p1[1];
+            break;
+        case FOURCC_NV21:
+            c[0] = p0[0]; c[1] = p1[1]; c[2] = p1[0];
+            break;
+        case FOURCC_YUYV:
+            c[0] = m[(x & 1) * 2]; c[1] = m[1]; c[2] = m[3];
+            break;
+        case FOURCC_UYVY:
+            c[0] = m[(x & 1) * 2 + 1]; c[1] = m[0]; c[2] = m[2];
+            break;
+        default: /* IYUV, YUV4 */
+            c[0] = p0[0]; c[1] = p1[0]; c[2] = p2[0];
+            break;
+    }
+}
+
+/*! \brief Converts a pixel between full range RGB and YUV of a color space. */
+static void vx_color_reference(vx_bool src_rgb, vx_bool dst_rgb, vx_enum space, const vx_uint8 in[3], vx_float64 out[3])
+{
+    vx_float64 kr = 0.2126, kb = 0.0722, kg, y;
+    vx_uint32 i;
+    if ((space == VX_COLOR_SPACE_BT601_525) || (space == VX_COLOR_SPACE_BT601_625))
+    {
+        kr = 0.299;
+        kb = 0.114;
+    }
+    kg = 1.0 - kr - kb;
+    if (src_rgb && !dst_rgb)
+    {
+        y = kr * in[0] + kg * in[1] + kb * in[2];
+        out[0] = y;
+        out[1] = 128.0 + (in[2] - y) / (2.0 - 2.0 * kb);
+        out[2] = 128.0 + (in[0] - y) / (2.0 - 2.0 * kr);
+    }
+    else if (!src_rgb && dst_rgb)
+    {
+        vx_float64 u = in[1] - 128.0, v = in[2] - 128.0;
+        out[0] = in[0] + (2.0 - 2.0 * kr) * v;
+        out[2] = in[0] + (2.0 - 2.0 * kb) * u;
+        out[1] = (in[0] - kr * out[0] - kb * out[2]) / kg;
+    }
+    else
+    {
+        for (i = 0; i < 3; i++)
+            out[i] = in[i];
+    }
+    for (i = 0; i < 3; i++)
+        out[i] = (out[i] < 0.0) ? 0.0 : ((out[i] > 255.0) ? 255.0 : floor(out[i] + 0.5));
+}
+
+vx_status vx_test_graph_color_convert(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_uint32 w = 300, h = 34;
+        vx_fourcc srcs[] = {FOURCC_RGB, FOURCC_RGBX, FOURCC_NV12, FOURCC_NV21,
+                            FOURCC_UYVY, FOURCC_YUYV, FOURCC_IYUV, FOURCC_YUV4};
+        vx_fourcc dsts[] = {FOURCC_RGB, FOURCC_RGBX, FOURCC_NV12, FOURCC_IYUV, FOURCC_YUV4};
+        vx_enum spaces[] = {VX_COLOR_SPACE_BT709, VX_COLOR_SPACE_BT601_625};
+        vx_rectangle rect = vxCreateRectangle(context, 0, 0, w, h);
+        vx_uint32 s, d, k, x, y, p, i, pairs = 0;
+
+        status = rect ? VX_SUCCESS : VX_ERROR_NOT_SUFFICIENT;
+        srand(24);
+        for (s = 0; (s < dimof(srcs)) && (status == VX_SUCCESS); s++)
+        {
+            for (d = 0; (d < dimof(dsts)) && (status == VX_SUCCESS); d++)
+            {
+                vx_image src = 0, dst = 0;
+                vx_graph graph = 0;
+                vx_node node = 0;
+                vx_bool src_rgb = (srcs[s] == FOURCC_RGB) || (srcs[s] == FOURCC_RGBX);
+                vx_bool dst_rgb = (dsts[d] == FOURCC_RGB) || (dsts[d] == FOURCC_RGBX);
+                vx_bool sub = (dsts[d] == FOURCC_NV12) || (dsts[d] == FOURCC_IYUV);
+                vx_color_planes_t in, out;
+
+                if (srcs[s] == dsts[d])
+                    continue;
+                src = vxCreateImage(context, w, h, srcs[s]);
+                dst = vxCreateImage(context, w, h, dsts[d]);
+                graph = vxCreateGraph(context);
+                if (graph)
+                    node = vxColorConvertNode(graph, src, dst);
+                if (!src || !dst || !graph || !node)
+                    status = VX_ERROR_NOT_SUFFICIENT;
+                /* fill every byte of every plane with a gradient and noise */
+                if (status == VX_SUCCESS)
+                    status = vx_color_map(src, rect, &in);
+                for (p = 0; (p < in.planes) && (status == VX_SUCCESS); p++)
+                    for (y = 0; y < in.addr[p].dim_y; y += in.addr[p].step_y)
+                        for (x = 0; x < in.addr[p].dim_x; x += in.addr[p].step_x)
+                        {
+                            vx_uint8 *ptr = vxFormatImagePatchAddress2d(in.base[p], x, y, &in.addr[p]);
+                            for (i = 0; i < (vx_uint32)in.addr[p].stride_x; i++)
+                                ptr[i] = (vx_uint8)((x + y * 7 + i * 50) % 192 + rand() % 64);
+                        }
+                if (status == VX_SUCCESS)
+                    status = vx_color_unmap(src, rect, &in);
+                if (status == VX_SUCCESS)
+                    status = vxVerifyGraph(graph);
+                /* a second color space checks that the node selects its conversion again */
+                for (k = 0; (k < dimof(spaces)) && (status == VX_SUCCESS); k++)
+                {
+                    if (!src_rgb)
+                        status |= vxSetImageAttribute(src, VX_IMAGE_ATTRIBUTE_SPACE, &spaces[k], sizeof(spaces[k]));
+                    if (!dst_rgb)
+                        status |= vxSetImageAttribute(dst, VX_IMAGE_ATTRIBUTE_SPACE, &spaces[k], sizeof(spaces[k]));
+                    if (status == VX_SUCCESS)
+                        status = vxProcessGraph(graph);
+                    if (status == VX_SUCCESS)
+                        status = vx_color_map(src, rect, &in);
+                    if (status == VX_SUCCESS)
+                        status = vx_color_map(dst, rect, &out);
+                    for (y = 0; (y < h) && (status == VX_SUCCESS); y++)
+                    {
+                        for (x = 0; (x < w) && (status == VX_SUCCESS); x++)
+                        {
+                            vx_uint8 c[3], o[3];
+                            vx_float64 ref[3], blk[3];
+                            vx_uint32 n = 1, bx, by;
+                            vx_color_get(&in, x, y, c);
+                            vx_color_reference(src_rgb, dst_rgb, spaces[k], c, ref);
+                            vx_color_get(&out, x, y, o);
+                            /* 4:2:0 chroma is the average of its block, checked at its first pixel */
+                            if (sub && (((x | y) & 1) == 0))
+                            {
+                                for (by = y; (by < y + 2) && (by < h); by++)
+                                    for (bx = x; (bx < x + 2) && (bx < w); bx++)
+                                    {
+                                        if ((bx == x) && (by == y))
+                                            continue;
+                                        vx_color_get(&in, bx, by, c);
+                                        vx_color_reference(src_rgb, dst_rgb, spaces[k], c, blk);
+                                        ref[1] += blk[1];
+                                        ref[2] += blk[2];
+                                        n++;
+                                    }
+                                ref[1] /= n;
+                                ref[2] /= n;
+                            }
+                            for (i = 0; i < 3; i++)
+                            {
+                                if (sub && (i > 0) && (((x | y) & 1) != 0))
+                                    continue;
+                                if (fabs(o[i] - ref[i]) > 1.0)
+                                {
+                                    printf("%08x to %08x space %d: {%u,%u}[%u] is %u, expected %.2f\n",
+                                           srcs[s], dsts[d], spaces[k], x, y, i, o[i], ref[i]);
+                                    status = VX_FAILURE;
+                                }
+                            }
+                        }
+                    }
+                    status |= vx_color_unmap(src, 0, &in);
+                    status |= vx_color_unmap(dst, 0, &out);
+                }
+                if (status == VX_SUCCESS)
+                    pairs++;
+                vxReleaseNode(&node);
+                vxReleaseGraph(&graph);
+                vxReleaseImage(&src);
+                vxReleaseImage(&dst);
+            }
+        }
+        printf("Converted %u pairs of formats\n", pairs);
+        vxReleaseRectangle(&rect);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+vx_status vx_test_graph_histogram(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        const vx_uint32 w = 641, h = 481, w16 = 301, h16 = 77;
+        vx_uint8 *in = (vx_uint8 *)malloc(w * h);
+        vx_uint8 *out = (vx_uint8 *)malloc(w * h);
+        vx_uint16 *in16 = (vx_uint16 *)malloc(w16 * h16 * sizeof(vx_uint16));
+        vx_image input = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_image input16 = vxCreateImage(context, w16, h16, FOURCC_U16);
+        vx_image output = vxCreateImage(context, w, h, FOURCC_U8);
+        vx_distribution dist = vxCreateDistribution(context, 25, 10, 200);
+        vx_distribution dist16 = vxCreateDistribution(context, 40, 100, 4000);
+        vx_graph graph = vxCreateGraph(context);
+        vx_uint32 i, b, k, x, y;
+
+        status = VX_SUCCESS;
+        if (!in || !out || !in16 || !input || !input16 || !output || !dist || !dist16 || !graph)
+            status = VX_ERROR_NOT_SUFFICIENT;
+        if (status == VX_SUCCESS)
+        {
+            vx_node nodes[] = {
+                vxHistogramNode(graph, input, dist),
+                vxHistogramNode(graph, input16, dist16),
+                vxEqualizeHistNode(graph, input, output),
+            };
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            /* the second frame runs on the bins the nodes kept */
+            srand(25);
+            for (k = 0; (k < 2) && (status == VX_SUCCESS); k++)
+            {
+                vx_int32 ref[40], ref16[40], *hist = NULL;
+                vx_uint32 cnt[256], cdf[256], sum = 0;
+                vx_float32 scale;
+
+                memset(ref, 0, sizeof(ref));
+                memset(ref16, 0, sizeof(ref16));
+                memset(cnt, 0, sizeof(cnt));
+                for (i = 0; i < w * h; i++)
+                {
+                    in[i] = (vx_uint8)((k == 0) ? rand() % 256 : 60 + (rand() % 40) * (rand() % 3));
+                    if ((in[i] >= 10) && (in[i] < 210))
+                        ref[(in[i] - 10) / 8]++;
+                    cnt[in[i]]++;
+                }
+                for (i = 0; i < w16 * h16; i++)
+                {
+                    in16[i] = (vx_uint16)(rand() % 5000);
+                    if ((in16[i] >= 100) && (in16[i] < 4100))
+                        ref16[(in16[i] - 100) / 100]++;
+                }
+                status |= vx_write_image(input, w, h, sizeof(vx_uint8), in);
+                status |= vx_write_image(input16, w16, h16, sizeof(vx_uint16), in16);
+                if (status == VX_SUCCESS)
+                    status = vxProcessGraph(graph);
+                if (status == VX_SUCCESS)
+                    status = vxAccessDistribution(dist, (void **)&hist);
+                for (b = 0; (b < 25) && (status == VX_SUCCESS); b++)
+                {
+                    if (hist[b] != ref[b])
+                    {
+                        printf("frame %u: U8 bin %u is %d, expected %d\n", k, b, hist[b], ref[b]);
+                        status = VX_FAILURE;
+                    }
+                }
+                if (hist)
+                    status |= vxCommitDistribution(dist, hist);
+                hist = NULL;
+                if (status == VX_SUCCESS)
+                    status = vxAccessDistribution(dist16, (void **)&hist);
+                for (b = 0; (b < 40) && (status == VX_SUCCESS); b++)
+                {
+                    if (hist[b] != ref16[b])
+                    {
+                        printf("frame %u: U16 bin %u is %d, expected %d\n", k, b, hist[b], ref16[b]);
+                        status = VX_FAILURE;
+                    }
+                }
+                if (hist)
+                    status |= vxCommitDistribution(dist16, hist);
+
+                /* the equalization maps through the scaled exclusive cumulative distribution */
+                for (i = 0; i < 256; i++)
+                {
+                    cdf[i] = sum;
+                    sum += cnt[i];
+                }
+                scale = 255.0f / (float)cdf[255];
+                if (status == VX_SUCCESS)
+                    status = vx_read_image(output, w, h, sizeof(vx_uint8), out);
+                for (y = 0; (y < h) && (status == VX_SUCCESS); y++)
+                {
+                    for (x = 0; x < w; x++)
+                    {
+                        vx_uint8 e = (vx_uint8)(cdf[in[y * w + x]] * scale + 0.5f);
+                        if (out[y * w + x] != e)
+                        {
+                            printf("frame %u: equalized {%u,%u} is %u, expected %u\n", k, x, y, out[y * w + x], e);
+                            status = VX_FAILURE;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (i = 0; i < dimof(nodes); i++)
+                vxReleaseNode(&nodes[i]);
+        }
+exit:
+        vxReleaseGraph(&graph);
+        vxReleaseDistribution(&dist);
+        vxReleaseDistribution(&dist16);
+        vxReleaseImage(&input);
+        vxReleaseImage(&input16);
+        vxReleaseImage(&output);
+        free(in);
+        free(out);
+        free(in16);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
 /*! The array of supported unit tests */
 vx_unittest unittests[] = {
     {VX_FAILURE, "Framework: Load XYZ Extension",   vx_test_framework_load_extension},
@@ -2276,6 +5657,31 @@ vx_unittest unittests[] = {
     {VX_FAILURE, "Graph: Bitwise",              vx_test_graph_bitwise},
     {VX_FAILURE, "Graph: Arithmetic",           vx_test_graph_arit},
     {VX_FAILURE, "Graph: Corners",              vx_test_graph_corners},
+    {VX_FAILURE, "Graph: Tiling Chain",         vx_test_graph_tiling_chain},
+    {VX_FAILURE, "Graph: Workers",              vx_test_graph_workers},
+    {VX_FAILURE, "Graph: Virtual Aliasing",     vx_test_graph_virtual_aliasing},
+    {VX_FAILURE, "Graph: Fusion",               vx_test_graph_fusion},
+    {VX_FAILURE, "Graph: Tiling",               vx_test_graph_tiling},
+    {VX_FAILURE, "Graph: Schedule",             vx_test_graph_schedule},
+    {VX_FAILURE, "Graph: Pipeline",             vx_test_graph_pipeline},
+    {VX_FAILURE, "Graph: Pipeline Fused",       vx_test_graph_pipeline_fused},
+    {VX_FAILURE, "Graph: Performance",          vx_test_graph_performance},
+    {VX_FAILURE, "Graph: Trace",                vx_test_graph_trace},
+    {VX_FAILURE, "Graph: 3x3 Filters",          vx_test_graph_filters},
+    {VX_FAILURE, "Graph: Pointwise",            vx_test_graph_pointwise},
+    {VX_FAILURE, "Graph: Gradients",            vx_test_graph_gradients},
+    {VX_FAILURE, "Graph: Convolutions",         vx_test_graph_convolutions},
+    {VX_FAILURE, "Graph: Rank Filters",         vx_test_graph_rank_filters},
+    {VX_FAILURE, "Graph: Statistics",           vx_test_graph_statistics},
+    {VX_FAILURE, "Graph: Canny",                vx_test_graph_canny},
+    {VX_FAILURE, "Graph: FAST Corners",         vx_test_graph_fast_corners},
+    {VX_FAILURE, "Graph: Optical Flow",         vx_test_graph_optical_flow},
+    {VX_FAILURE, "Graph: Harris Corners",       vx_test_graph_harris_corners},
+    {VX_FAILURE, "Graph: Scale Image",          vx_test_graph_scale_image},
+    {VX_FAILURE, "Graph: Remap",                vx_test_graph_remap},
+    {VX_FAILURE, "Graph: Warps",                vx_test_graph_warps},
+    {VX_FAILURE, "Graph: Color Convert",        vx_test_graph_color_convert},
+    {VX_FAILURE, "Graph: Histogram",            vx_test_graph_histogram},
 };
 
 /*! \brief The main unit test.
@@ -988,3 +988,26 @@ vx_status vxuOpticalFlowPyrLK(vx_pyramid old_images,
     vxClearLog(context);
     return status;
 }
+
+vx_status vxuRemap(vx_image input, vx_remap table, vx_enum policy, vx_image output)
+{
+    vx_context context = vxGetContext(input);
+    vx_status status = VX_FAILURE;
+    vx_graph graph = vxCreateGraph(context);
+    if (graph)
+    {
+        vx_node node = vxRemapNode(graph, input, table, policy, output);
+        if (node)
+        {
+            status = vxVerifyGraph(graph);
+            if (status == VX_SUCCESS)
+            {
+                status = vxProcessGraph(graph);
+            }
+            vxReleaseNode(&node);
+        }
+        vxReleaseGraph(&graph);
+    }
+    vxClearLog(context);
+    return status;
+}